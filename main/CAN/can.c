@@ -8,6 +8,9 @@ Written by Cole Perera for Sheffield Formula Racing 2025
 #include <stdio.h>
 #include <stdlib.h>
 #include "can.h"
+#include "canflash.h"
+#include "./../sdcard.h"
+#include "./../calibration.h"
 
 /* --------------------------- Global Variables ----------------------------- */
 #ifdef GPIO_CAN0_TX
@@ -18,8 +21,10 @@ twai_node_handle_t stCANBus1;
 #endif
 
 QueueHandle_t xCANRingBuffer = NULL;
-extern QueueHandle_t xESPNOWRingBuffer;
+extern QueueHandle_t xESPNOWPriorityBuffer;
+extern QueueHandle_t xESPNOWTelemBuffer;
 dword dwNDroppedCANFrames = 0;
+dword dwNDroppedTelemFrames = 0;
 
 /* --------------------------- Definitions ---------------------------------- */
 #define CAN0_BITRATE 1000000  // 1000kbps
@@ -41,7 +46,6 @@ typedef struct {
 extern dword adwMaxTaskTime[eTASK_TOTAL];
 static can_tx_buffer_t astCANTxPool[MAX_CAN_TXS_PER_CALL];
 static uint8_t byCANTxPoolIndex = 0;
-extern qword dwFirmwareSize;
 
 /* --------------------------- Functions ------------------------------------ */
 esp_err_t CAN_init(boolean bEnableRx)
@@ -190,8 +194,7 @@ esp_err_t CAN_transmit(twai_node_handle_t stCANBus, const CAN_frame_t *stFrame)
         return ESP_ERR_INVALID_ARG;
     }
 
-    /* Allocate memory location for this message in the pool. Wraps after MAX_CAN_TXS_PER_CALL. */
-    can_tx_buffer_t *stTxBuf = &astCANTxPool[byCANTxPoolIndex];
+    /* stCANTxBuffer holds this message, move on to the next slot in the pool. Wraps after MAX_CAN_TXS_PER_CALL. */
     byCANTxPoolIndex++;
     if (byCANTxPoolIndex >= MAX_CAN_TXS_PER_CALL) 
     {
@@ -339,7 +342,8 @@ bool CAN_receive_callback(twai_node_handle_t stCANBus, const twai_rx_done_event_
     *   Returns: 1 if successful, 0 not.
     * 
     *   The callback for CAN Rx, adds the message to the ring buffer. 
-    *   If the ring buffer is full it drops the message.
+    *   If the ring buffer is full it drops the message. When ESP-NOW
+    *   telemetry is sending a copy goes in its queue too.
     * 
     *=========================================================================== 
     *   Revision History:
@@ -349,18 +353,29 @@ bool CAN_receive_callback(twai_node_handle_t stCANBus, const twai_rx_done_event_
     *   16/11/25 CP Respond to Command message
     *   23/11/25 CP Changed to use FreeRTOS queue instead of ring buffer, refactored
     *   03/01/26 CP Added reflash over CAN functionality.
+    *   18/10/26 CP Frames stamped with their Rx time for telemetry
+    *   18/10/26 CP Priority frames to the ESP-NOW priority lane
+    *   18/10/26 CP Frames logged to the SD card
+    *   18/10/26 CP SD log gets the us Rx time
+    *   18/10/26 CP Frames kept in the SD capture ring
+    *   18/10/26 CP Calibration table chunks taken
+    *   18/10/26 CP Telemetry gets a copy in its own queue
     *
     *===========================================================================
     */
 
     esp_err_t stState;
     CAN_frame_t stRxedFrame;
+    qword qwtRx;
+    QueueHandle_t xTelemQueue = xESPNOWTelemBuffer;
     uint8_t abyRxBuffer[8];
     twai_frame_t stRxFrame = {
         .buffer = abyRxBuffer,
         .buffer_len = sizeof(abyRxBuffer),
     };
-    
+
+    (void)edata;
+    (void)stRxCallback;
     stState = twai_node_receive_from_isr(stCANBus, &stRxFrame);
     if (stState != ESP_OK) 
     {
@@ -368,6 +383,7 @@ bool CAN_receive_callback(twai_node_handle_t stCANBus, const twai_rx_done_event_
     }
 
     CAN_CMD_response(stRxFrame);
+    CAL_receive((dword)stRxFrame.header.id, stRxFrame.buffer, (byte)stRxFrame.header.dlc);
 
     if (!xCANRingBuffer) 
     {
@@ -381,8 +397,29 @@ bool CAN_receive_callback(twai_node_handle_t stCANBus, const twai_rx_done_event_
     {
         memcpy(stRxedFrame.abData, stRxFrame.buffer, stRxFrame.header.dlc);
     }
+    qwtRx = (qword)esp_timer_get_time();
+    CAN_set_rx_time(&stRxedFrame, qwtRx);
+
+    /* Only copied into a RAM block, does nothing unless the SD card is logging */
+    (void)SD_card_write_CAN(&stRxedFrame, qwtRx);
+
+    /* Kept in the pre-trigger ring too, a kill frame here triggers a capture */
+    (void)SD_capture_CAN(&stRxedFrame, qwtRx);
 
+    /* ESP-NOW telemetry, safety frames go in its priority lane */
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    if (xTelemQueue != NULL)
+    {
+        if (xESPNOWPriorityBuffer != NULL && ESPNOW_IS_PRIORITY_ID(stRxedFrame.dwID))
+        {
+            xTelemQueue = xESPNOWPriorityBuffer;
+        }
+        if (xQueueSendFromISR(xTelemQueue, &stRxedFrame, &xHigherPriorityTaskWoken) != pdTRUE)
+        {
+            dwNDroppedTelemFrames++;
+        }
+    }
+
     if (xQueueSendFromISR(xCANRingBuffer, &stRxedFrame, &xHigherPriorityTaskWoken) != pdTRUE) {
         /* Queue Full */
         dwNDroppedCANFrames++;
@@ -404,12 +441,13 @@ bool CAN_receive_callback_no_queue(twai_node_handle_t stCANBus, const twai_rx_do
     *   Returns: 1 if successful, 0 not.
     * 
     *   The callback for CAN Rx when the ring buffer is not used. Only responds
-    *   to command messages.
+    *   to command messages and calibration table chunks.
     * 
     *=========================================================================== 
     *   Revision History:
     *   16/11/25 CP Initial Version
     *   23/11/25 CP Changed to use FreeRTOS queue instead of ring buffer, refactored
+    *   18/10/26 CP Calibration table chunks taken
     *
     *===========================================================================
     */
@@ -420,7 +458,9 @@ bool CAN_receive_callback_no_queue(twai_node_handle_t stCANBus, const twai_rx_do
         .buffer = abyRxBuffer,
         .buffer_len = sizeof(abyRxBuffer),
     };
-    
+
+    (void)edata;
+    (void)stRxCallback;
     stState = twai_node_receive_from_isr(stCANBus, &stRxFrame);
     if (stState != ESP_OK)
     {
@@ -428,6 +468,7 @@ bool CAN_receive_callback_no_queue(twai_node_handle_t stCANBus, const twai_rx_do
     }
 
     CAN_CMD_response(stRxFrame);
+    CAL_receive((dword)stRxFrame.header.id, stRxFrame.buffer, (byte)stRxFrame.header.dlc);
 
     return TRUE;
 }
@@ -441,37 +482,44 @@ esp_err_t CAN_empty_ESPNOW_buffer(twai_node_handle_t stCANBus)
     * 
     *   Returns: ESP_OK if successful, error code if not.
     * 
-    *   Empties the CAN ring buffer by transmitting messages until the buffer is
-    *   empty or the max number of messages per call is reached.
+    *   Empties the ESP-NOW Rx frame ring by transmitting messages until it is
+    *   empty or the max number of messages per call is reached. Frames are
+    *   taken in runs straight from the ring, one that fails to transmit stays
+    *   for the next call.
     *=========================================================================== 
     *   Revision History:
     *   15/10/25 CP Initial Version
     *   23/11/25 CP Changed to use FreeRTOS queue, refactored
+    *   18/10/26 CP Takes runs of frames from the ESP-NOW Rx frame ring
     *
     *===========================================================================
     */
 
     esp_err_t eStatus = ESP_OK;
     word wCounter = 0;
-    CAN_frame_t stCANFrame;   
+    word wNFrames;
+    word wNSent;
+    const CAN_frame_t *astFrames;
 
-    if (!xESPNOWRingBuffer) 
+    /* Until the ring is empty or the max number of messages is reached, send CAN messages */ 
+    while (wCounter < MAX_CAN_TXS_PER_CALL && (wNFrames = ESPNOW_rx_frames_peek(&astFrames)) > 0)
     {
-        ESP_LOGE("CAN", "ESPNOW ring buffer not initialized");
-        return ESP_ERR_INVALID_STATE;
-    }
-
-    /* Until the queue is empty or the max number of messages is reached, send CAN messages */ 
-    while (wCounter < MAX_CAN_TXS_PER_CALL && 
-            xQueueReceive(xESPNOWRingBuffer, &stCANFrame, 0) == pdTRUE) 
-    {    
-        eStatus = CAN_transmit(stCANBus, &stCANFrame);  
-        if (eStatus != ESP_OK) 
+        if (wNFrames > MAX_CAN_TXS_PER_CALL - wCounter)
         {
-            ESP_LOGI("CAN", "Failed to transmit CAN frame : %s", esp_err_to_name(eStatus));
-            return eStatus;
+            wNFrames = MAX_CAN_TXS_PER_CALL - wCounter;
         }
-        wCounter++;
+        for (wNSent = 0; wNSent < wNFrames; wNSent++)
+        {
+            eStatus = CAN_transmit(stCANBus, &astFrames[wNSent]);
+            if (eStatus != ESP_OK)
+            {
+                ESPNOW_rx_frames_release(wNSent);
+                ESP_LOGI("CAN", "Failed to transmit CAN frame : %s", esp_err_to_name(eStatus));
+                return eStatus;
+            }
+        }
+        ESPNOW_rx_frames_release(wNFrames);
+        wCounter += wNFrames;
     }
     
     return eStatus;
@@ -491,6 +539,8 @@ void CAN_CMD_response(twai_frame_t stRxFrame)
     *=========================================================================== 
     *   Revision History:
     *   03/01/26 CP Initial Version
+    *   18/10/26 CP Added multicast reflash and reflash status commands
+    *   18/10/26 CP Added SD capture command
     *
     *===========================================================================
     */
@@ -521,11 +571,38 @@ void CAN_CMD_response(twai_frame_t stRxFrame)
                                  ((dword)stRxFrame.buffer[3] << 16) |
                                  ((dword)stRxFrame.buffer[4] << 8)  |
                                  ((dword)stRxFrame.buffer[5]);
+                bMulticastReflash = FALSE;
+                eReflashTransport = eREFLASH_TRANSPORT_CAN;
                 set_device_mode(eREFLASH);
                 break;
             case eCMD_NORMAL_MODE:
                 set_device_mode(eNORMAL);
                 break;
+            case eCMD_REFLASH_MULTICAST:
+                /* Data: [Cmd, NodeMask1, NodeMask0, Size3, Size2, Size1, Size0] */
+                if (stRxFrame.header.dlc < 7 ||
+                    !CAN_flash_node_in_mask(((word)stRxFrame.buffer[1] << 8) | stRxFrame.buffer[2]))
+                {
+                    /* Not enough data or not addressed to this node, ignore */
+                    break;
+                }
+                dwFirmwareSize = ((dword)stRxFrame.buffer[3] << 24) |
+                                 ((dword)stRxFrame.buffer[4] << 16) |
+                                 ((dword)stRxFrame.buffer[5] << 8)  |
+                                 ((dword)stRxFrame.buffer[6]);
+                bMulticastReflash = TRUE;
+                eReflashTransport = eREFLASH_TRANSPORT_CAN;
+                set_device_mode(eREFLASH);
+                break;
+            case eCMD_REFLASH_STATUS:
+                /* Handled from the reflash background task, only latch it here */
+                CAN_flash_status_request(stRxFrame.buffer, stRxFrame.header.dlc);
+                break;
+            case eCMD_CAPTURE:
+                /* Data: [Cmd, Source], dumped to the SD card from the writer task */
+                (void)SD_capture_trigger(eSD_CAPTURE_COMMAND,
+                                         stRxFrame.header.dlc > 1 ? stRxFrame.buffer[1] : 0);
+                break;
             default:
                 /* Unknown command, ignore */
                 break;
@@ -554,6 +631,52 @@ void CAN_clear_rx_buffer(void)
     }
 }
 
+void CAN_set_rx_time(CAN_frame_t *stFrame, qword qwtRx)
+{
+    /*
+    *===========================================================================
+    *   CAN_set_rx_time
+    *   Takes:   stFrame: The frame to stamp
+    *            qwtRx: Time the frame was received in us
+    * 
+    *   Returns: None
+    * 
+    *   Stores the low 24 bits of the Rx time in the padding of the frame.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    stFrame->abyRxTime[0] = (byte)(qwtRx >> 16);
+    stFrame->abyRxTime[1] = (byte)(qwtRx >> 8);
+    stFrame->abyRxTime[2] = (byte)qwtRx;
+}
+
+qword CAN_get_rx_time(const CAN_frame_t *stFrame, qword qwtNow)
+{
+    /*
+    *===========================================================================
+    *   CAN_get_rx_time
+    *   Takes:   stFrame: A frame stamped by CAN_set_rx_time
+    *            qwtNow: The current time in us
+    * 
+    *   Returns: The full Rx time of the frame in us.
+    * 
+    *   Rebuilds the Rx time from its low 24 bits, the frame must have been
+    *   received less than 16.7 s ago.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    dword dwRxTime = ((dword)stFrame->abyRxTime[0] << 16) |
+                     ((dword)stFrame->abyRxTime[1] << 8)  |
+                     ((dword)stFrame->abyRxTime[2]);
+    return qwtNow - ((qwtNow - dwRxTime) & CAN_RX_TIME_MASK);
+}
+
 esp_err_t CAN_Tx_killlevel(KillLevel_t eKillLevel, KillSource_t eKillSource)
 {
     /*
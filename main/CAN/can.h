@@ -19,6 +19,9 @@ typedef enum {
     eCMD_CLEAR_ERRORS   = 0b00000100,
     eCMD_REFLASH_MODE   = 0b00001000,
     eCMD_NORMAL_MODE    = 0b00010000,
+    eCMD_REFLASH_MULTICAST = 0b00100000,
+    eCMD_REFLASH_STATUS = 0b01000000,
+    eCMD_CAPTURE        = 0b10000000,
 } eCAN_CMD_t;
 
 esp_err_t CAN_init(boolean bEnableRx);
@@ -31,6 +34,10 @@ esp_err_t CAN_empty_ESPNOW_buffer(twai_node_handle_t stCANBus);
 bool CAN_receive_callback_no_queue(twai_node_handle_t stCANBus, const twai_rx_done_event_data_t *edata, void *stRxCallback);
 void CAN_CMD_response(twai_frame_t stRxFrame);
 void CAN_clear_rx_buffer(void);
+void CAN_set_rx_time(CAN_frame_t *stFrame, qword qwtRx);
+qword CAN_get_rx_time(const CAN_frame_t *stFrame, qword qwtNow);
+
+#define CAN_RX_TIME_MASK 0x00FFFFFF // Rx time wraps every 16.7 s, frames never wait that long
 
 #define KILL_MSG_ID 0x001
 
@@ -73,7 +80,10 @@ typedef enum {
     KILL_SOURCE_APPS_2,
 } KillSource_t;
 
-static const char *KILL_DISCRIPTION[] = {
+esp_err_t CAN_Tx_killlevel(KillLevel_t eKillLevel, KillSource_t eKillSource);
+
+/* Only apps.c logs these, the rest of the units including this would warn it is unused */
+static const char *KILL_DISCRIPTION[] __attribute__((unused)) = {
     "None",
     "HVIL is broken!",
     "BMS Unhappy!",
@@ -4119,3 +4119,78 @@ void CANRxCheck100ms(void)
     tSinceTempMonAddressCast += 100; if (tSinceTempMonAddressCast > 1000) BTempMonAddressCastInError = true;
 }
 
+/* ESP-NOW telemetry max rates - autogenerated */
+
+const CAN_telem_rate_t astCANTelemRates[CAN_TELEM_RATES_LENGTH] =
+{
+    { 0x10, 0 },
+    { 0x11, 0 },
+    { 0x12, 0 },
+    { 0x13, 0 },
+    { 0x14, 0 },
+    { 0x15, 0 },
+    { 0x16, 0 },
+    { 0x17, 0 },
+    { 0x18, 0 },
+    { 0x19, 0 },
+    { 0x1A, 0 },
+    { 0x24, 0 },
+    { 0x36, 0 },
+    { 0x40, 0 },
+    { 0x44, 0 },
+    { 0x64, 0 },
+    { 0x81, 0 },
+    { 0x84, 0 },
+    { 0x90, 0 },
+    { 0x91, 0 },
+    { 0x92, 0 },
+    { 0x93, 0 },
+    { 0x94, 0 },
+    { 0xA4, 0 },
+    { 0xB0, 0 },
+    { 0xB1, 0 },
+    { 0xB2, 0 },
+    { 0xC4, 0 },
+    { 0xE4, 0 },
+    { 0x104, 0 },
+    { 0x124, 0 },
+    { 0x144, 0 },
+    { 0x164, 0 },
+    { 0x184, 0 },
+    { 0x200, 0 },
+    { 0x201, 0 },
+    { 0x202, 0 },
+    { 0x203, 0 },
+    { 0x204, 0 },
+    { 0x205, 0 },
+    { 0x206, 0 },
+    { 0x207, 0 },
+    { 0x208, 0 },
+    { 0x209, 0 },
+    { 0x20A, 0 },
+    { 0x20B, 0 },
+    { 0x20C, 0 },
+    { 0x20D, 0 },
+    { 0x20E, 0 },
+    { 0x20F, 0 },
+    { 0x3E4, 0 },
+    { 0x404, 0 },
+    { 0x424, 0 },
+    { 0x444, 0 },
+    { 0x464, 0 },
+    { 0x484, 0 },
+    { 0x4A4, 0 },
+    { 0x4C4, 0 },
+    { 0x6A0, 0 },
+    { 0x6B0, 0 },
+    { 0x6B1, 0 },
+    { 0x6B2, 0 },
+    { 0x6B3, 0 },
+    { 0x1806E5F4, 0 },
+    { 0x1806E7F4, 0 },
+    { 0x1806E9F4, 0 },
+    { 0x1838F380, 0 },
+    { 0x1839F380, 0 },
+    { 0x18EEFF80, 0 },
+};
+
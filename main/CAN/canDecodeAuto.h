@@ -389,210 +389,279 @@ extern bool BTempMonAddressCastInError;
 #define ESPCONTROL_ID 0x10
 #define ESPCONTROL_PERIOD_MS 100
 #define ESPCONTROL_THRESH_MS 500
+#define ESPCONTROL_TELEM_PERIOD_MS 0
 #define MCUSTATUSTELEMCAR_ID 0x11
 #define MCUSTATUSTELEMCAR_PERIOD_MS 1000
 #define MCUSTATUSTELEMCAR_THRESH_MS 5000
+#define MCUSTATUSTELEMCAR_TELEM_PERIOD_MS 0
 #define MCUSTATUSTELEMPITS_ID 0x12
 #define MCUSTATUSTELEMPITS_PERIOD_MS 1000
 #define MCUSTATUSTELEMPITS_THRESH_MS 5000
+#define MCUSTATUSTELEMPITS_TELEM_PERIOD_MS 0
 #define MCUSTATUSIMDMONITOR_ID 0x13
 #define MCUSTATUSIMDMONITOR_PERIOD_MS 1000
 #define MCUSTATUSIMDMONITOR_THRESH_MS 5000
+#define MCUSTATUSIMDMONITOR_TELEM_PERIOD_MS 0
 #define MCUSTATUSLOGGER_ID 0x14
 #define MCUSTATUSLOGGER_PERIOD_MS 1000
 #define MCUSTATUSLOGGER_THRESH_MS 5000
+#define MCUSTATUSLOGGER_TELEM_PERIOD_MS 0
 #define MCUSTATUSPDU_ID 0x15
 #define MCUSTATUSPDU_PERIOD_MS 1000
 #define MCUSTATUSPDU_THRESH_MS 5000
+#define MCUSTATUSPDU_TELEM_PERIOD_MS 0
 #define STATUSAPPS_ID 0x16
 #define STATUSAPPS_PERIOD_MS 1000
 #define STATUSAPPS_THRESH_MS 5000
+#define STATUSAPPS_TELEM_PERIOD_MS 0
 #define MCUSTATUSSCREEN_ID 0x17
 #define MCUSTATUSSCREEN_PERIOD_MS 1000
 #define MCUSTATUSSCREEN_THRESH_MS 5000
+#define MCUSTATUSSCREEN_TELEM_PERIOD_MS 0
 #define MCUSTATUSDASH_ID 0x18
 #define MCUSTATUSDASH_PERIOD_MS 1000
 #define MCUSTATUSDASH_THRESH_MS 5000
+#define MCUSTATUSDASH_TELEM_PERIOD_MS 0
 #define MCUSTATUSDYNO_ID 0x19
 #define MCUSTATUSDYNO_PERIOD_MS 1000
 #define MCUSTATUSDYNO_THRESH_MS 5000
+#define MCUSTATUSDYNO_TELEM_PERIOD_MS 0
 #define MCUSTATUSTEMPMON_ID 0x1A
 #define MCUSTATUSTEMPMON_PERIOD_MS 1000
 #define MCUSTATUSTEMPMON_THRESH_MS 5000
+#define MCUSTATUSTEMPMON_TELEM_PERIOD_MS 0
 #define SETACCURRENT_ID 0x24
 #define SETACCURRENT_PERIOD_MS 100
 #define SETACCURRENT_THRESH_MS 500
+#define SETACCURRENT_TELEM_PERIOD_MS 0
 #define CELLVOLTAGES_ID 0x36
 #define CELLVOLTAGES_PERIOD_MS 8
 #define CELLVOLTAGES_THRESH_MS 40
+#define CELLVOLTAGES_TELEM_PERIOD_MS 0
 #define IMDDATA_ID 0x40
 #define IMDDATA_PERIOD_MS 100
 #define IMDDATA_THRESH_MS 500
+#define IMDDATA_TELEM_PERIOD_MS 0
 #define SETBRAKECURRENT_ID 0x44
 #define SETBRAKECURRENT_PERIOD_MS 100
 #define SETBRAKECURRENT_THRESH_MS 500
+#define SETBRAKECURRENT_TELEM_PERIOD_MS 0
 #define SETERPM_ID 0x64
 #define SETERPM_PERIOD_MS 100
 #define SETERPM_THRESH_MS 500
+#define SETERPM_TELEM_PERIOD_MS 0
 #define STATUSAPPSSENSOR_ID 0x81
 #define STATUSAPPSSENSOR_PERIOD_MS 100
 #define STATUSAPPSSENSOR_THRESH_MS 500
+#define STATUSAPPSSENSOR_TELEM_PERIOD_MS 0
 #define SETPOSITION_ID 0x84
 #define SETPOSITION_PERIOD_MS 100
 #define SETPOSITION_THRESH_MS 500
+#define SETPOSITION_TELEM_PERIOD_MS 0
 #define DYNOPRESSURESRAW_ID 0x90
 #define DYNOPRESSURESRAW_PERIOD_MS 100
 #define DYNOPRESSURESRAW_THRESH_MS 500
+#define DYNOPRESSURESRAW_TELEM_PERIOD_MS 0
 #define DYNOTEMPSRAW_ID 0x91
 #define DYNOTEMPSRAW_PERIOD_MS 100
 #define DYNOTEMPSRAW_THRESH_MS 500
+#define DYNOTEMPSRAW_TELEM_PERIOD_MS 0
 #define DYNOPRESSURES_ID 0x92
 #define DYNOPRESSURES_PERIOD_MS 100
 #define DYNOPRESSURES_THRESH_MS 500
+#define DYNOPRESSURES_TELEM_PERIOD_MS 0
 #define DYNOTEMPS_ID 0x93
 #define DYNOTEMPS_PERIOD_MS 100
 #define DYNOTEMPS_THRESH_MS 500
+#define DYNOTEMPS_TELEM_PERIOD_MS 0
 #define DYNOCOOLING_ID 0x94
 #define DYNOCOOLING_PERIOD_MS 100
 #define DYNOCOOLING_THRESH_MS 500
+#define DYNOCOOLING_TELEM_PERIOD_MS 0
 #define SETRELCURRENT_ID 0xA4
 #define SETRELCURRENT_PERIOD_MS 1
 #define SETRELCURRENT_THRESH_MS 5
+#define SETRELCURRENT_TELEM_PERIOD_MS 0
 #define PDUSTATS1_ID 0xB0
 #define PDUSTATS1_PERIOD_MS 100
 #define PDUSTATS1_THRESH_MS 500
+#define PDUSTATS1_TELEM_PERIOD_MS 0
 #define PDUSTATS2_ID 0xB1
 #define PDUSTATS2_PERIOD_MS 100
 #define PDUSTATS2_THRESH_MS 500
+#define PDUSTATS2_TELEM_PERIOD_MS 0
 #define PDUSTATS3_ID 0xB2
 #define PDUSTATS3_PERIOD_MS 100
 #define PDUSTATS3_THRESH_MS 500
+#define PDUSTATS3_TELEM_PERIOD_MS 0
 #define SETRELBRAKECURRENT_ID 0xC4
 #define SETRELBRAKECURRENT_PERIOD_MS 100
 #define SETRELBRAKECURRENT_THRESH_MS 500
+#define SETRELBRAKECURRENT_TELEM_PERIOD_MS 0
 #define SETDIGOUTPUT_ID 0xE4
 #define SETDIGOUTPUT_PERIOD_MS 100
 #define SETDIGOUTPUT_THRESH_MS 500
+#define SETDIGOUTPUT_TELEM_PERIOD_MS 0
 #define SETMAXACCURRENT_ID 0x104
 #define SETMAXACCURRENT_PERIOD_MS 100
 #define SETMAXACCURRENT_THRESH_MS 500
+#define SETMAXACCURRENT_TELEM_PERIOD_MS 0
 #define SETMAXACBRAKECURRENT_ID 0x124
 #define SETMAXACBRAKECURRENT_PERIOD_MS 100
 #define SETMAXACBRAKECURRENT_THRESH_MS 500
+#define SETMAXACBRAKECURRENT_TELEM_PERIOD_MS 0
 #define SETMAXDCCURRENT_ID 0x144
 #define SETMAXDCCURRENT_PERIOD_MS 100
 #define SETMAXDCCURRENT_THRESH_MS 500
+#define SETMAXDCCURRENT_TELEM_PERIOD_MS 0
 #define SETMAXDCBRAKECURRENT_ID 0x164
 #define SETMAXDCBRAKECURRENT_PERIOD_MS 100
 #define SETMAXDCBRAKECURRENT_THRESH_MS 500
+#define SETMAXDCBRAKECURRENT_TELEM_PERIOD_MS 0
 #define SETDRIVEENABLE_ID 0x184
 #define SETDRIVEENABLE_PERIOD_MS 100
 #define SETDRIVEENABLE_THRESH_MS 500
+#define SETDRIVEENABLE_TELEM_PERIOD_MS 0
 #define FRTIRETEMP1_ID 0x200
 #define FRTIRETEMP1_PERIOD_MS 30
 #define FRTIRETEMP1_THRESH_MS 150
+#define FRTIRETEMP1_TELEM_PERIOD_MS 0
 #define FRTIRETEMP2_ID 0x201
 #define FRTIRETEMP2_PERIOD_MS 30
 #define FRTIRETEMP2_THRESH_MS 150
+#define FRTIRETEMP2_TELEM_PERIOD_MS 0
 #define FRTIRETEMP3_ID 0x202
 #define FRTIRETEMP3_PERIOD_MS 30
 #define FRTIRETEMP3_THRESH_MS 150
+#define FRTIRETEMP3_TELEM_PERIOD_MS 0
 #define FRTIRETEMP4_ID 0x203
 #define FRTIRETEMP4_PERIOD_MS 30
 #define FRTIRETEMP4_THRESH_MS 150
+#define FRTIRETEMP4_TELEM_PERIOD_MS 0
 #define FLTIRETEMP1_ID 0x204
 #define FLTIRETEMP1_PERIOD_MS 30
 #define FLTIRETEMP1_THRESH_MS 150
+#define FLTIRETEMP1_TELEM_PERIOD_MS 0
 #define FLTIRETEMP2_ID 0x205
 #define FLTIRETEMP2_PERIOD_MS 30
 #define FLTIRETEMP2_THRESH_MS 150
+#define FLTIRETEMP2_TELEM_PERIOD_MS 0
 #define FLTIRETEMP3_ID 0x206
 #define FLTIRETEMP3_PERIOD_MS 30
 #define FLTIRETEMP3_THRESH_MS 150
+#define FLTIRETEMP3_TELEM_PERIOD_MS 0
 #define FLTIRETEMP4_ID 0x207
 #define FLTIRETEMP4_PERIOD_MS 30
 #define FLTIRETEMP4_THRESH_MS 150
+#define FLTIRETEMP4_TELEM_PERIOD_MS 0
 #define RRTIRETEMP1_ID 0x208
 #define RRTIRETEMP1_PERIOD_MS 30
 #define RRTIRETEMP1_THRESH_MS 150
+#define RRTIRETEMP1_TELEM_PERIOD_MS 0
 #define RRTIRETEMP2_ID 0x209
 #define RRTIRETEMP2_PERIOD_MS 30
 #define RRTIRETEMP2_THRESH_MS 150
+#define RRTIRETEMP2_TELEM_PERIOD_MS 0
 #define RRTIRETEMP3_ID 0x20A
 #define RRTIRETEMP3_PERIOD_MS 30
 #define RRTIRETEMP3_THRESH_MS 150
+#define RRTIRETEMP3_TELEM_PERIOD_MS 0
 #define RRTIRETEMP4_ID 0x20B
 #define RRTIRETEMP4_PERIOD_MS 30
 #define RRTIRETEMP4_THRESH_MS 150
+#define RRTIRETEMP4_TELEM_PERIOD_MS 0
 #define RLTIRETEMP1_ID 0x20C
 #define RLTIRETEMP1_PERIOD_MS 30
 #define RLTIRETEMP1_THRESH_MS 150
+#define RLTIRETEMP1_TELEM_PERIOD_MS 0
 #define RLTIRETEMP2_ID 0x20D
 #define RLTIRETEMP2_PERIOD_MS 30
 #define RLTIRETEMP2_THRESH_MS 150
+#define RLTIRETEMP2_TELEM_PERIOD_MS 0
 #define RLTIRETEMP3_ID 0x20E
 #define RLTIRETEMP3_PERIOD_MS 30
 #define RLTIRETEMP3_THRESH_MS 150
+#define RLTIRETEMP3_TELEM_PERIOD_MS 0
 #define RLTIRETEMP4_ID 0x20F
 #define RLTIRETEMP4_PERIOD_MS 30
 #define RLTIRETEMP4_THRESH_MS 150
+#define RLTIRETEMP4_TELEM_PERIOD_MS 0
 #define TARGETIQINFO_ID 0x3E4
 #define TARGETIQINFO_PERIOD_MS 25
 #define TARGETIQINFO_THRESH_MS 125
+#define TARGETIQINFO_TELEM_PERIOD_MS 0
 #define ERPM_DUTY_VOLTAGE_ID 0x404
 #define ERPM_DUTY_VOLTAGE_PERIOD_MS 25
 #define ERPM_DUTY_VOLTAGE_THRESH_MS 125
+#define ERPM_DUTY_VOLTAGE_TELEM_PERIOD_MS 0
 #define AC_DC_CURRENT_ID 0x424
 #define AC_DC_CURRENT_PERIOD_MS 25
 #define AC_DC_CURRENT_THRESH_MS 125
+#define AC_DC_CURRENT_TELEM_PERIOD_MS 0
 #define TEMPERATURES_ID 0x444
 #define TEMPERATURES_PERIOD_MS 25
 #define TEMPERATURES_THRESH_MS 125
+#define TEMPERATURES_TELEM_PERIOD_MS 0
 #define FOC_ID 0x464
 #define FOC_PERIOD_MS 25
 #define FOC_THRESH_MS 125
+#define FOC_TELEM_PERIOD_MS 0
 #define INVERTER_MISC_ID 0x484
 #define INVERTER_MISC_PERIOD_MS 25
 #define INVERTER_MISC_THRESH_MS 125
+#define INVERTER_MISC_TELEM_PERIOD_MS 0
 #define MINMAXACCURRENT_ID 0x4A4
 #define MINMAXACCURRENT_PERIOD_MS 25
 #define MINMAXACCURRENT_THRESH_MS 125
+#define MINMAXACCURRENT_TELEM_PERIOD_MS 0
 #define MINMAXDCCURRENT_ID 0x4C4
 #define MINMAXDCCURRENT_PERIOD_MS 25
 #define MINMAXDCCURRENT_THRESH_MS 125
+#define MINMAXDCCURRENT_TELEM_PERIOD_MS 0
 #define CELLTEMPSTATS_ID 0x6A0
 #define CELLTEMPSTATS_PERIOD_MS 100
 #define CELLTEMPSTATS_THRESH_MS 500
+#define CELLTEMPSTATS_TELEM_PERIOD_MS 0
 #define CELLSTATS1_ID 0x6B0
 #define CELLSTATS1_PERIOD_MS 8
 #define CELLSTATS1_THRESH_MS 40
+#define CELLSTATS1_TELEM_PERIOD_MS 0
 #define CELLSTATS2_ID 0x6B1
 #define CELLSTATS2_PERIOD_MS 8
 #define CELLSTATS2_THRESH_MS 40
+#define CELLSTATS2_TELEM_PERIOD_MS 0
 #define CELLSTATS3_ID 0x6B2
 #define CELLSTATS3_PERIOD_MS 8
 #define CELLSTATS3_THRESH_MS 40
+#define CELLSTATS3_TELEM_PERIOD_MS 0
 #define CELLSTATS4_ID 0x6B3
 #define CELLSTATS4_PERIOD_MS 8
 #define CELLSTATS4_THRESH_MS 40
+#define CELLSTATS4_TELEM_PERIOD_MS 0
 #define ELCONINTERFACE2_ID 0x1806E5F4
 #define ELCONINTERFACE2_PERIOD_MS 808
 #define ELCONINTERFACE2_THRESH_MS 4040
+#define ELCONINTERFACE2_TELEM_PERIOD_MS 0
 #define ELCONINTERFACE1_ID 0x1806E7F4
 #define ELCONINTERFACE1_PERIOD_MS 808
 #define ELCONINTERFACE1_THRESH_MS 4040
+#define ELCONINTERFACE1_TELEM_PERIOD_MS 0
 #define ELCONINTERFACE3_ID 0x1806E9F4
 #define ELCONINTERFACE3_PERIOD_MS 808
 #define ELCONINTERFACE3_THRESH_MS 4040
+#define ELCONINTERFACE3_TELEM_PERIOD_MS 0
 #define CELLTEMPGENERAL_ID 0x1838F380
 #define CELLTEMPGENERAL_PERIOD_MS 100
 #define CELLTEMPGENERAL_THRESH_MS 500
+#define CELLTEMPGENERAL_TELEM_PERIOD_MS 0
 #define BMSCELLTEMP_ID 0x1839F380
 #define BMSCELLTEMP_PERIOD_MS 100
 #define BMSCELLTEMP_THRESH_MS 500
+#define BMSCELLTEMP_TELEM_PERIOD_MS 0
 #define TEMPMONADDRESSCAST_ID 0x18EEFF80
 #define TEMPMONADDRESSCAST_PERIOD_MS 200
 #define TEMPMONADDRESSCAST_THRESH_MS 1000
+#define TEMPMONADDRESSCAST_TELEM_PERIOD_MS 0
 
 esp_err_t ESPControlRx(CAN_frame_t stFrame);
 esp_err_t ESPControlTx(twai_node_handle_t stCANBus);
@@ -736,5 +805,7 @@ esp_err_t TempMonAddressCastTx(twai_node_handle_t stCANBus);
 void CANRxCheck1ms(void);
 void CANRxCheck100ms(void);
 
+#define CAN_TELEM_RATES_LENGTH 69
+extern const CAN_telem_rate_t astCANTelemRates[CAN_TELEM_RATES_LENGTH];
 
 #endif
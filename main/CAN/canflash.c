@@ -4,25 +4,85 @@ File contains functions to update firmware over CAN bus for esp32c6.
 
 Written by Cole Perera for Sheffield Formula Racing 2026
 */
+#include <stdlib.h>
 #include "canflash.h"
+#include "./../espnowflash.h"
 
 /* --------------------------- Global Variables ----------------------------- */
 dword dwBytesWrittenReflash = 0;
 word dwErrorCountReflash = 0;
 dword dwFirmwareSize = 0;
+boolean bMulticastReflash = FALSE;
+qword qwtLastReflashActivity = 0;
+eReflashTransport_t eReflashTransport = eREFLASH_TRANSPORT_CAN;
 
 /* --------------------------- Definitions ---------------------------------- */
 #define CRC8_POLYNOMIAL 0x12F  //CRC-8-AUTOSTAR polynomial
-#define REFLASH_QUEUE_LENGTH 23
+#define REFLASH_BITMAP_WORD_BITS 32
+#define REFLASH_MAX_REPORT_FRAMES 64        // MISSING frames per status query, host re-queries after repair
+#define REFLASH_REPORT_INTERVAL_US 250      // us between report frames so the Tx queue never overflows
+#define REFLASH_READ_BLOCK_SIZE 256         // bytes read back per call when checking the image digest
+#define REFLASH_RESTART_DELAY_MS 50         // ms to let the COMMIT reply leave before restarting
+#define REFLASH_ERASE_STEP 0x10000          // bytes erased between watchdog resets, one flash block
+#define REFLASH_NVS_NAMESPACE "reflash"
+#define REFLASH_NVS_KEY "checkpoint"
 
 /* --------------------------- Local Types ---------------------------------- */
-
+typedef struct {
+    dword dwDigest;             // CRC32 of the image from the host, 0 if the host did not send one
+    dword dwFirmwareSize;
+    dword dwBytesCommitted;     // Bytes in flash counted from the start of the image
+    byte abySectorDone[REFLASH_MAX_SECTORS / 8];
+} stReflashCheckpoint_t;
 
 /* --------------------------- Local Variables ------------------------------ */
-QueueHandle_t xReflashRingBuffer = NULL;
+static stReflashCheckpoint_t stCheckpoint;
+static boolean bImagePrepared = FALSE;
+static dword dwImageDigest = 0;
+static dword dwNSectors = 0;
+static qword qwtReflashStart = 0;
+
+/* Unicast state, data is collected a sector at a time so each sector is erased just before it is written */
+static byte *abySectorBuffer = NULL;
+static word wNSectorBytes = 0;
+static dword dwNRepeatedFrames = 0;
+
+/* Multicast state, bit set = chunk received */
+static dword *adwChunkReceived = NULL;
+static word *awSectorChunks = NULL;
+static dword dwNChunks = 0;
+static dword dwNChunksReceived = 0;
+
+/* Status request latched from the CAN Rx callback */
+static volatile boolean bStatusRequested = FALSE;
+static volatile byte byStatusOp = REFLASH_OP_QUERY;
+static volatile dword dwStatusDigest = 0;
+
+/* Report progress */
+static boolean bReportActive = FALSE;
+static boolean bResumeSent = FALSE;
+static dword dwReportWord = 0;
+static word wNReportFrames = 0;
+static qword qwtLastReportFrame = 0;
 
 /* Local Function Prototypes */
-void reflash_enqueue_frame(const CAN_frame_t *stFrame, word wNBytes);
+static esp_err_t reflash_append(esp_partition_t *stOTAPartition, const byte *abyData, word wNBytes);
+static esp_err_t reflash_flush_sector(esp_partition_t *stOTAPartition);
+static esp_err_t reflash_prepare(esp_partition_t *stOTAPartition, dword dwDigest);
+static esp_err_t reflash_erase_sectors(esp_partition_t *stOTAPartition);
+static esp_err_t reflash_write_chunk(esp_partition_t *stOTAPartition, const CAN_frame_t *stFrame);
+static esp_err_t reflash_write_unicast(esp_partition_t *stOTAPartition, const CAN_frame_t *stFrame);
+static void reflash_mark_chunk(dword dwNChunk);
+static dword reflash_sector_chunks(dword dwNSector);
+static boolean reflash_sector_done(dword dwNSector);
+static dword reflash_committed_bytes(void);
+static dword reflash_missing_mask(dword dwNWord);
+static dword reflash_count_missing(void);
+static esp_err_t reflash_send_report_frame(void);
+static esp_err_t reflash_commit(esp_partition_t *stOTAPartition, dword dwDigest);
+static void reflash_load_checkpoint(void);
+static esp_err_t reflash_save_checkpoint(void);
+static void reflash_clear_checkpoint(void);
 
 /* --------------------------- Functions ------------------------------------ */
 esp_err_t CAN_flash_init()
@@ -38,19 +98,118 @@ esp_err_t CAN_flash_init()
     *=========================================================================== 
     *   Revision History:
     *   09/01/26 CP Initial Version
+    *   18/10/26 CP Byte queue replaced by the sector buffer, NVS needed for the checkpoint
+    *===========================================================================
+    */
+    esp_err_t eState;
+
+    eState = NVS_init();
+    if (eState != ESP_OK)
+    {
+        ESP_LOGE("CANFLASH", "Failed to initialise NVS, reflash can not resume: %s", esp_err_to_name(eState));
+        return eState;
+    }
+    return ESP_OK;
+}
+
+esp_err_t CAN_flash_start(esp_partition_t *stOTAPartition)
+{
+    /*
+    *===========================================================================
+    *   CAN_flash_start
+    *   Takes:   Target partition to write to.
+    * 
+    *   Returns: ESP_OK if successful, error code if not.
+    * 
+    *   Called on entry to reflash mode. Loads the checkpoint from NVS and
+    *   allocates the state for the reflash type. Nothing is erased here, the
+    *   host's first query decides what can be kept.
+    *   Multicast needs one bit per 7 byte chunk, about 18 KB for a 1 MB binary.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
     *   
     *===========================================================================
     */
+    dword dwNWords;
+
+    CAN_flash_stop();
+    if (stOTAPartition == NULL || dwFirmwareSize == 0 || dwFirmwareSize > stOTAPartition->size)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    dwNSectors = (dwFirmwareSize + REFLASH_SECTOR_SIZE - 1) / REFLASH_SECTOR_SIZE;
+    if (dwNSectors > REFLASH_MAX_SECTORS)
+    {
+        ESP_LOGE("CANFLASH", "Binary of %d bytes is too large for the checkpoint", (int)dwFirmwareSize);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    qwtReflashStart = (qword)esp_timer_get_time();
+    qwtLastReflashActivity = qwtReflashStart;
+    reflash_load_checkpoint();
+
+    if (!bMulticastReflash)
+    {
+        abySectorBuffer = malloc(REFLASH_SECTOR_SIZE);
+        if (abySectorBuffer == NULL)
+        {
+            ESP_LOGE("CANFLASH", "Failed to allocate sector buffer");
+            return ESP_ERR_NO_MEM;
+        }
+        return ESP_OK;
+    }
 
-    /* Allocate Ring Buffer */
-    xReflashRingBuffer = xQueueCreate(REFLASH_QUEUE_LENGTH, sizeof(byte));
-    if (xReflashRingBuffer == NULL) {
-        ESP_LOGE("CAN", "Failed to create CAN Queue");
+    dwNChunks = (dwFirmwareSize + REFLASH_CHUNK_SIZE - 1) / REFLASH_CHUNK_SIZE;
+    dwNWords = (dwNChunks + REFLASH_BITMAP_WORD_BITS - 1) / REFLASH_BITMAP_WORD_BITS;
+    adwChunkReceived = calloc(dwNWords, sizeof(dword));
+    awSectorChunks = calloc(dwNSectors, sizeof(word));
+    if (adwChunkReceived == NULL || awSectorChunks == NULL)
+    {
+        ESP_LOGE("CANFLASH", "Failed to allocate multicast bitmap (%d chunks)", (int)dwNChunks);
+        CAN_flash_stop();
         return ESP_ERR_NO_MEM;
-    } 
+    }
+    ESP_LOGI("CANFLASH", "Multicast reflash, %d chunks expected", (int)dwNChunks);
     return ESP_OK;
 }
 
+void CAN_flash_stop(void)
+{
+    /*
+    *===========================================================================
+    *   CAN_flash_stop
+    *   Takes:   None
+    * 
+    *   Returns: Nothing.
+    * 
+    *   Frees the reflash state. Anything not yet in a full sector is lost, the
+    *   checkpoint in NVS is kept for the next attempt.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   
+    *===========================================================================
+    */
+    free(abySectorBuffer);
+    free(adwChunkReceived);
+    free(awSectorChunks);
+    abySectorBuffer = NULL;
+    adwChunkReceived = NULL;
+    awSectorChunks = NULL;
+    wNSectorBytes = 0;
+    dwNRepeatedFrames = 0;
+    dwNChunks = 0;
+    dwNChunksReceived = 0;
+    dwNSectors = 0;
+    dwBytesWrittenReflash = 0;
+    dwErrorCountReflash = 0;
+    bImagePrepared = FALSE;
+    dwImageDigest = 0;
+    bReportActive = FALSE;
+    bStatusRequested = FALSE;
+}
+
 esp_err_t CAN_flash_empty_queue(esp_partition_t *stOTAPartition)
 {
     /*
@@ -61,18 +220,17 @@ esp_err_t CAN_flash_empty_queue(esp_partition_t *stOTAPartition)
     *   Returns: None
     * 
     *   Empties the can rx buffer and writes the data into the ota partition.
-    *   Flash likes to be written in 16 byte chunks.
     *=========================================================================== 
     *   Revision History:
     *   03/01/26 CP Initial Version
     *   09/01/26 CP Added CRC check and ACK/NACK response
+    *   18/10/26 CP Accept multicast data frames
+    *   18/10/26 CP Data goes to the sector buffer, NACK if it could not be written
+    *   18/10/26 CP Unicast frames carry their offset, see reflash_write_unicast
     *===========================================================================
     */
     CAN_frame_t stCANFrame;
-    CAN_frame_t stCANTxFrame;
-    stCANTxFrame.dwID = DEVICE_ID;
     esp_err_t eState = ESP_OK;
-    qword qwCANData = 0;
 
     if (!xCANRingBuffer) 
     {
@@ -82,30 +240,20 @@ esp_err_t CAN_flash_empty_queue(esp_partition_t *stOTAPartition)
     /* Read CAN messages and fill reflash buffer */
     while(xQueueReceive(xCANRingBuffer, &stCANFrame, 0) == pdTRUE)
     {
-        if(stCANFrame.dwID != DEVICE_ID)
+        if (bMulticastReflash && (stCANFrame.dwID & ~REFLASH_SEQ_MASK) == REFLASH_MULTICAST_ID)
         {
+            /* No ACK/NACK in multicast, lost or corrupt chunks are reported on request */
+            qwtLastReflashActivity = (qword)esp_timer_get_time();
+            (void)reflash_write_chunk(stOTAPartition, &stCANFrame);
             continue;
         }
-        memcpy(&qwCANData, stCANFrame.abData, stCANFrame.byDLC);
-        if (crc8(qwCANData) == 0)
-        {
-            /* Valid CRC */
-            reflash_enqueue_frame(&stCANFrame, stCANFrame.byDLC - 1);
-
-            /* Send ACK */
-            stCANTxFrame.byDLC = 1;
-            stCANTxFrame.abData[0] = 0xFF;
-            eState = CAN_transmit(stCANBus0, &stCANTxFrame);
-        } else
+        if ((stCANFrame.dwID & ~(REFLASH_OFFSET_MASK | 0xFF << REFLASH_NODE_SHIFT)) != REFLASH_UNICAST_ID ||
+            ((stCANFrame.dwID >> REFLASH_NODE_SHIFT) & 0xFF) != (DEVICE_ID & 0xFF) || stCANFrame.byDLC == 0)
         {
-            /* Invalid CRC - Send NACK and error count */
-            stCANTxFrame.byDLC = 3;
-            stCANTxFrame.abData[0] = 0x00;
-            stCANTxFrame.abData[1] = (byte)(dwErrorCountReflash & 0xFF);
-            stCANTxFrame.abData[2] = (byte)((dwErrorCountReflash >> 8) & 0xFF);
-            eState = CAN_transmit(stCANBus0, &stCANTxFrame);
-            dwErrorCountReflash++;
+            continue;
         }
+        qwtLastReflashActivity = (qword)esp_timer_get_time();
+        eState = reflash_write_unicast(stOTAPartition, &stCANFrame);
     }
     return eState;
 }
@@ -119,77 +267,138 @@ esp_err_t CAN_flash_write(esp_partition_t *stOTAPartition)
     * 
     *   Returns: None
     * 
-    *   Empties the can rx buffer and writes the data into the ota partition.
-    *   Flash likes to be written in 16 byte chunks.
+    *   Writes the last part sector of a unicast image and commits it once the
+    *   whole binary has been received. Full sectors are written as they fill.
     *=========================================================================== 
     *   Revision History:
     *   03/01/26 CP Initial Version
     *   09/01/26 CP Added CRC check and ACK/NACK response
+    *   18/10/26 CP Sector buffered, commits the image when complete
     *===========================================================================
     */
    static qword qwTime = 0;
-   byte abyFlashBuffer[16];
    esp_err_t eState = ESP_OK;
 
     if (stOTAPartition == NULL)
     {
         return ESP_ERR_INVALID_ARG;
     }
-    if (xReflashRingBuffer == NULL)
+
+    /* Debug Reporting */
+    if (esp_timer_get_time() - qwTime >= 500000) //Every 0.5s
     {
-        return ESP_ERR_INVALID_STATE;
+        qwTime = esp_timer_get_time();
+        ESP_LOGI("CANFLASH", "Reflash Progress: %d / %d bytes written, %d buffered",
+            (uint32_t)dwBytesWrittenReflash, (uint32_t)dwFirmwareSize, wNSectorBytes);
     }
 
-    /* Write reflash buffer to flash in 16 byte chunks */
-    if (uxQueueMessagesWaiting(xReflashRingBuffer) >= 16)
+    if (bMulticastReflash || !bImagePrepared || dwBytesWrittenReflash + wNSectorBytes < dwFirmwareSize)
     {
-        /* Get 16 bytes from reflash buffer */
-        for (word wNCounter = 0; wNCounter < 16; wNCounter++)
-        {
-            xQueueReceive(xReflashRingBuffer, &abyFlashBuffer[wNCounter], 0);
-        }
+        return ESP_OK;
+    }
 
-        /* Write to flash */
-        eState = esp_partition_write(stOTAPartition, dwBytesWrittenReflash, abyFlashBuffer, 16);
-        
+    /* Whole binary received, write the last part sector */
+    if (wNSectorBytes > 0)
+    {
+        eState = reflash_flush_sector(stOTAPartition);
         if (eState != ESP_OK)
         {
-            ESP_LOGE("CANFLASH", "Failed to write to OTA partition: %s", esp_err_to_name(eState));
             return eState;
         }
-        dwBytesWrittenReflash += 16;
     }
+    ESP_LOGI("CANFLASH", "Reflash complete, written %d bytes in %d s, %d frames repeated", (int)dwBytesWrittenReflash,
+        (int)((esp_timer_get_time() - qwtReflashStart) / 1000000), (int)dwNRepeatedFrames);
+    return reflash_commit(stOTAPartition, dwImageDigest);
+}
+
+esp_err_t CAN_flash_resume(esp_partition_t *stOTAPartition, dword dwDigest, dword *pdwNBytesReceived)
+{
+    /*
+    *===========================================================================
+    *   CAN_flash_resume
+    *   Takes:   stOTAPartition: Target partition to write to.
+    *            dwDigest: CRC32 of the image the host is sending.
+    *            pdwNBytesReceived: Set to the offset the host should send next.
+    * 
+    *   Returns: ESP_OK if successful, error code if not.
+    * 
+    *   Unicast resume for transports other than CAN, same as a status query.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   
+    *===========================================================================
+    */
+    esp_err_t eState = ESP_OK;
 
-    /* Detect if there are less then 16 bytes till the end of the binary. (would get stuck otherwise) */
-    if (dwBytesWrittenReflash + 16 > dwFirmwareSize && dwFirmwareSize > 0)
+    if (stOTAPartition == NULL || dwNSectors == 0)
     {
-        word wNCounter = 0;
-        while (xQueueReceive(xReflashRingBuffer, &abyFlashBuffer[wNCounter], 0) == pdTRUE)
-        {
-            wNCounter++;
-        }
-        /* Write to flash */
-        eState = esp_partition_write(stOTAPartition, dwBytesWrittenReflash, abyFlashBuffer, wNCounter+1);
-        
+        return ESP_ERR_INVALID_STATE;
+    }
+    qwtLastReflashActivity = (qword)esp_timer_get_time();
+    if (!bImagePrepared || dwDigest != dwImageDigest)
+    {
+        eState = reflash_prepare(stOTAPartition, dwDigest);
+    }
+    *pdwNBytesReceived = CAN_flash_bytes_received();
+    return eState;
+}
+
+esp_err_t CAN_flash_append(esp_partition_t *stOTAPartition, const byte *abyData, word wNBytes)
+{
+    /*
+    *===========================================================================
+    *   CAN_flash_append
+    *   Takes:   stOTAPartition: Target partition to write to.
+    *            abyData: Next bytes of the binary, in order.
+    *            wNBytes: Number of bytes.
+    * 
+    *   Returns: ESP_OK if the data was taken, error code if not.
+    * 
+    *   Feeds the unicast sector writer from another transport. Any length is
+    *   accepted, it is split into frame sized pieces.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   
+    *===========================================================================
+    */
+    esp_err_t eState;
+    word wNCopy;
+
+    qwtLastReflashActivity = (qword)esp_timer_get_time();
+    while (wNBytes > 0)
+    {
+        /* reflash_append handles at most one sector boundary per call */
+        wNCopy = (wNBytes > REFLASH_SECTOR_SIZE) ? REFLASH_SECTOR_SIZE : wNBytes;
+        eState = reflash_append(stOTAPartition, abyData, wNCopy);
         if (eState != ESP_OK)
         {
-            ESP_LOGE("CANFLASH", "Failed to write to OTA partition: %s", esp_err_to_name(eState));
             return eState;
         }
-        dwBytesWrittenReflash += wNCounter+1;
-    }
-
-    /* Debug Reporting */
-    if (esp_timer_get_time() - qwTime >= 500000) //Every 0.5s
-    {
-        qwTime = esp_timer_get_time();
-        ESP_LOGI("CANFLASH", "Reflash Progress: %d / %d bytes written, %d waiting in queue",
-            (uint32_t)dwBytesWrittenReflash, (uint32_t)dwFirmwareSize, uxQueueMessagesWaiting(xReflashRingBuffer));
+        abyData += wNCopy;
+        wNBytes -= wNCopy;
     }
-    
     return ESP_OK;
 }
 
+dword CAN_flash_bytes_received(void)
+{
+    /*
+    *===========================================================================
+    *   CAN_flash_bytes_received
+    *   Takes:   None
+    * 
+    *   Returns: Bytes of a unicast image received so far, written or buffered.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   
+    *===========================================================================
+    */
+    return dwBytesWrittenReflash + wNSectorBytes;
+}
+
 word crc8(qword dwData)
 {
     /*
@@ -220,34 +429,965 @@ word crc8(qword dwData)
     return (word)(dwData & 0xFF);
 }
 
-void reflash_enqueue_frame(const CAN_frame_t *stFrame, word wNBytes)
+boolean CAN_flash_node_in_mask(word wNodeMask)
+{
+    /*
+    *===========================================================================
+    *   CAN_flash_node_in_mask
+    *   Takes:   wNodeMask: Bit n selects the node REFLASH_NODE_ID_BASE + n.
+    * 
+    *   Returns: TRUE if this device is selected by the mask.
+    * 
+    *   Nodes without an ID in the MCUStatus range (0x10-0x1F) are only
+    *   selected by REFLASH_ALL_NODES.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Added REFLASH_ALL_NODES
+    *===========================================================================
+    */
+    dword dwNNode = (dword)DEVICE_ID - REFLASH_NODE_ID_BASE;
+
+    if (wNodeMask == REFLASH_ALL_NODES)
+    {
+        return TRUE;
+    }
+
+    /* Also catches IDs below the base as the subtraction wraps */
+    if (dwNNode >= 16)
+    {
+        return FALSE;
+    }
+    return (wNodeMask >> dwNNode) & 0x1;
+}
+
+void CAN_flash_status_request(const byte *abyData, byte byDLC)
 {
     /*
     *===========================================================================
-    *   reflash_enqueue_frame
-    *   Takes:   Pointer to CAN frame to enqueue.
-    *            Number of bytes to include.   
+    *   CAN_flash_status_request
+    *   Takes:   abyData: Data of the eCMD_REFLASH_STATUS command frame
+    *            byDLC: Length of the data
     * 
     *   Returns: Nothing.
     * 
-    *   Enqueues the data bytes of the given CAN frame into the reflash queue.
+    *   Called from the CAN Rx callback. Only latches the request, the reply is
+    *   built by CAN_flash_service_status from the reflash background task.
     *=========================================================================== 
     *   Revision History:
-    *   09/01/26 CP Initial Version
+    *   18/10/26 CP Initial Version
     *   
     *===========================================================================
     */
-    if (!xReflashRingBuffer) 
+    if (byDLC < 4 || !CAN_flash_node_in_mask(((word)abyData[1] << 8) | abyData[2]))
     {
         return;
     }
-    if (wNBytes > stFrame->byDLC)
+
+    byStatusOp = abyData[3];
+    dwStatusDigest = 0;
+    if (byDLC >= 8)
+    {
+        dwStatusDigest = ((dword)abyData[4] << 24) |
+                         ((dword)abyData[5] << 16) |
+                         ((dword)abyData[6] << 8)  |
+                         ((dword)abyData[7]);
+    }
+    bStatusRequested = TRUE;
+}
+
+esp_err_t CAN_flash_service_status(esp_partition_t *stOTAPartition)
+{
+    /*
+    *===========================================================================
+    *   CAN_flash_service_status
+    *   Takes:   Target partition being written.
+    * 
+    *   Returns: ESP_OK if successful, error code if not.
+    * 
+    *   Answers latched status requests. A query prepares the partition for
+    *   the image digest it carries, then starts a report which is sent one
+    *   frame per call, paced so the Tx queue is never overrun. A commit checks
+    *   the image and boots it.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Unicast queries, resume from the checkpoint
+    *===========================================================================
+    */
+    esp_err_t eState = ESP_OK;
+
+    if (stOTAPartition == NULL || dwNSectors == 0)
+    {
+        bStatusRequested = FALSE;
+        return ESP_OK;
+    }
+
+    if (bStatusRequested)
+    {
+        bStatusRequested = FALSE;
+        qwtLastReflashActivity = (qword)esp_timer_get_time();
+        if (byStatusOp == REFLASH_OP_COMMIT)
+        {
+            bReportActive = FALSE;
+            return reflash_commit(stOTAPartition, dwStatusDigest);
+        }
+        /* A new digest means a new image, anything already received is for the old one */
+        if (!bImagePrepared || dwStatusDigest != dwImageDigest)
+        {
+            eState = reflash_prepare(stOTAPartition, dwStatusDigest);
+            if (eState != ESP_OK)
+            {
+                return eState;
+            }
+        }
+        /* Start a new report, any report in progress is restarted */
+        bReportActive = TRUE;
+        bResumeSent = FALSE;
+        dwReportWord = 0;
+        wNReportFrames = 0;
+    }
+
+    if (bReportActive && (qword)esp_timer_get_time() - qwtLastReportFrame >= REFLASH_REPORT_INTERVAL_US)
+    {
+        qwtLastReportFrame = (qword)esp_timer_get_time();
+        eState = reflash_send_report_frame();
+    }
+    return eState;
+}
+
+static esp_err_t reflash_write_chunk(esp_partition_t *stOTAPartition, const CAN_frame_t *stFrame)
+{
+    /*
+    *===========================================================================
+    *   reflash_write_chunk
+    *   Takes:   stOTAPartition: Target partition to write to.
+    *            stFrame: Multicast data frame, chunk index in the ID.
+    * 
+    *   Returns: ESP_OK if successful, error code if not.
+    * 
+    *   Checks the CRC and writes one 7 byte chunk straight to its offset in the
+    *   partition. Repeated chunks are ignored so repair rounds can be sent to
+    *   every node even if only one of them missed the chunk. Chunks sent before
+    *   the first query are dropped as the partition is not erased yet.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Checkpoint each sector as it completes
+    *===========================================================================
+    */
+    dword dwNChunk = stFrame->dwID & REFLASH_SEQ_MASK;
+    dword dwOffset;
+    dword dwNBytes;
+    qword qwCANData = 0;
+    esp_err_t eState;
+
+    if (stOTAPartition == NULL || adwChunkReceived == NULL || !bImagePrepared ||
+        dwNChunk >= dwNChunks || stFrame->byDLC != 8)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (adwChunkReceived[dwNChunk / REFLASH_BITMAP_WORD_BITS] & ((dword)1 << (dwNChunk % REFLASH_BITMAP_WORD_BITS)))
+    {
+        return ESP_OK;
+    }
+
+    memcpy(&qwCANData, stFrame->abData, stFrame->byDLC);
+    if (crc8(qwCANData) != 0)
+    {
+        dwErrorCountReflash++;
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    dwOffset = dwNChunk * REFLASH_CHUNK_SIZE;
+    dwNBytes = dwFirmwareSize - dwOffset;
+    if (dwNBytes > REFLASH_CHUNK_SIZE)
+    {
+        dwNBytes = REFLASH_CHUNK_SIZE;
+    }
+    eState = esp_partition_write(stOTAPartition, dwOffset, stFrame->abData, dwNBytes);
+    if (eState != ESP_OK)
+    {
+        ESP_LOGE("CANFLASH", "Failed to write chunk %d: %s", (int)dwNChunk, esp_err_to_name(eState));
+        return eState;
+    }
+
+    reflash_mark_chunk(dwNChunk);
+    dwBytesWrittenReflash += dwNBytes;
+    return ESP_OK;
+}
+
+static esp_err_t reflash_write_unicast(esp_partition_t *stOTAPartition, const CAN_frame_t *stFrame)
+{
+    /*
+    *===========================================================================
+    *   reflash_write_unicast
+    *   Takes:   stOTAPartition: Target partition to write to.
+    *            stFrame: Unicast data frame, offset in the ID.
+    * 
+    *   Returns: The ACK or NACK's transmit status.
+    * 
+    *   Writes the frame if it is the next one and ACKs it. A frame from
+    *   behind the next offset is one the host resent as it did not see the
+    *   ACK, so it is ACKed again and not written twice. A bad CRC, a frame
+    *   from ahead or a failed write is NACKed. Both replies carry the bytes
+    *   received so the host carries on from there.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   
+    *===========================================================================
+    */
+    CAN_frame_t stCANTxFrame;
+    qword qwCANData = 0;
+    dword dwBehind;
+    dword dwNReceived;
+    boolean bACK = FALSE;
+
+    memcpy(&qwCANData, stFrame->abData, stFrame->byDLC);
+    dwBehind = (CAN_flash_bytes_received() - (stFrame->dwID & REFLASH_OFFSET_MASK)) & REFLASH_OFFSET_MASK;
+    if (crc8(qwCANData) == 0)
+    {
+        if (dwBehind == 0)
+        {
+            bACK = reflash_append(stOTAPartition, stFrame->abData, stFrame->byDLC - 1) == ESP_OK;
+        }
+        else if (dwBehind <= REFLASH_OFFSET_MASK / 2)
+        {
+            /* Already written */
+            dwNRepeatedFrames++;
+            bACK = TRUE;
+        }
+    }
+
+    dwNReceived = CAN_flash_bytes_received();
+    memset(&stCANTxFrame, 0, sizeof(stCANTxFrame));
+    stCANTxFrame.dwID = DEVICE_ID;
+    if (bACK)
+    {
+        stCANTxFrame.byDLC = 5;
+        stCANTxFrame.abData[0] = REFLASH_RESP_ACK;
+        stCANTxFrame.abData[1] = (byte)(dwNReceived >> 24);
+        stCANTxFrame.abData[2] = (byte)(dwNReceived >> 16);
+        stCANTxFrame.abData[3] = (byte)(dwNReceived >> 8);
+        stCANTxFrame.abData[4] = (byte)dwNReceived;
+    }
+    else
+    {
+        stCANTxFrame.byDLC = 7;
+        stCANTxFrame.abData[0] = REFLASH_RESP_NACK;
+        stCANTxFrame.abData[1] = (byte)(dwErrorCountReflash & 0xFF);
+        stCANTxFrame.abData[2] = (byte)((dwErrorCountReflash >> 8) & 0xFF);
+        stCANTxFrame.abData[3] = (byte)(dwNReceived >> 24);
+        stCANTxFrame.abData[4] = (byte)(dwNReceived >> 16);
+        stCANTxFrame.abData[5] = (byte)(dwNReceived >> 8);
+        stCANTxFrame.abData[6] = (byte)dwNReceived;
+        dwErrorCountReflash++;
+    }
+    return CAN_transmit(stCANBus0, &stCANTxFrame);
+}
+
+static dword reflash_missing_mask(dword dwNWord)
+{
+    /*
+    *===========================================================================
+    *   reflash_missing_mask
+    *   Takes:   dwNWord: Index of the bitmap word.
+    * 
+    *   Returns: Bitmap of missing chunks in the word, bit n = chunk 32*word + n.
+    * 
+    *   Bits past the last chunk of the binary are never reported as missing.
+    *   Only the low 32 bits are used so the host simulator, where dword is 64
+    *   bits, sees the same bitmap.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Mask to the bitmap word width
+    *===========================================================================
+    */
+    dword dwValid = 0xFFFFFFFF;
+    dword dwNValid = dwNChunks - dwNWord * REFLASH_BITMAP_WORD_BITS;
+
+    if (dwNValid < REFLASH_BITMAP_WORD_BITS)
     {
-        wNBytes = stFrame->byDLC;
+        dwValid = ((dword)1 << dwNValid) - 1;
     }
+    return ~adwChunkReceived[dwNWord] & dwValid;
+}
+
+static dword reflash_count_missing(void)
+{
+    /*
+    *===========================================================================
+    *   reflash_count_missing
+    *   Takes:   None
+    * 
+    *   Returns: Number of chunks not yet received.
+    * 
+    *   Unicast counts the 7 byte frames still to come.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Unicast count
+    *===========================================================================
+    */
+    dword dwNReceived;
 
-    for (byte byNCounter = 0; byNCounter < wNBytes; byNCounter++)
+    if (!bMulticastReflash)
     {
-        xQueueSend(xReflashRingBuffer, &stFrame->abData[byNCounter], 0);
+        dwNReceived = dwBytesWrittenReflash + wNSectorBytes;
+        if (dwNReceived >= dwFirmwareSize)
+        {
+            return 0;
+        }
+        return (dwFirmwareSize - dwNReceived + REFLASH_CHUNK_SIZE - 1) / REFLASH_CHUNK_SIZE;
     }
-}
\ No newline at end of file
+    return dwNChunks - dwNChunksReceived;
+}
+
+static esp_err_t reflash_send_report_frame(void)
+{
+    /*
+    *===========================================================================
+    *   reflash_send_report_frame
+    *   Takes:   None
+    * 
+    *   Returns: ESP_OK if successful, error code if not.
+    * 
+    *   Sends the RESUME frame, then the next MISSING frame of the report, or
+    *   the DONE frame once the bitmap has been walked or
+    *   REFLASH_MAX_REPORT_FRAMES have been sent. If the transmit fails the same
+    *   frame is retried on the next call. Unicast has no bitmap so goes
+    *   straight from RESUME to DONE.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Added RESUME frame
+    *===========================================================================
+    */
+    dword dwNWords = (dwNChunks + REFLASH_BITMAP_WORD_BITS - 1) / REFLASH_BITMAP_WORD_BITS;
+    dword dwMissing = 0;
+    dword dwNBase;
+    esp_err_t eState;
+    CAN_frame_t stCANTxFrame;
+    stCANTxFrame.dwID = DEVICE_ID;
+    stCANTxFrame.byDLC = 8;
+
+    if (!bResumeSent)
+    {
+        dwNBase = reflash_committed_bytes();
+        stCANTxFrame.byDLC = 5;
+        stCANTxFrame.abData[0] = REFLASH_RESP_RESUME;
+        stCANTxFrame.abData[1] = (byte)((dwNBase >> 24) & 0xFF);
+        stCANTxFrame.abData[2] = (byte)((dwNBase >> 16) & 0xFF);
+        stCANTxFrame.abData[3] = (byte)((dwNBase >> 8) & 0xFF);
+        stCANTxFrame.abData[4] = (byte)(dwNBase & 0xFF);
+        eState = CAN_transmit(stCANBus0, &stCANTxFrame);
+        if (eState == ESP_OK)
+        {
+            bResumeSent = TRUE;
+        }
+        return eState;
+    }
+
+    /* Skip to the next word with a missing chunk */
+    while (dwReportWord < dwNWords && (dwMissing = reflash_missing_mask(dwReportWord)) == 0)
+    {
+        dwReportWord++;
+    }
+
+    if (dwReportWord < dwNWords && wNReportFrames < REFLASH_MAX_REPORT_FRAMES)
+    {
+        dwNBase = dwReportWord * REFLASH_BITMAP_WORD_BITS;
+        stCANTxFrame.abData[0] = REFLASH_RESP_MISSING;
+        stCANTxFrame.abData[1] = (byte)((dwNBase >> 16) & 0xFF);
+        stCANTxFrame.abData[2] = (byte)((dwNBase >> 8) & 0xFF);
+        stCANTxFrame.abData[3] = (byte)(dwNBase & 0xFF);
+        stCANTxFrame.abData[4] = (byte)((dwMissing >> 24) & 0xFF);
+        stCANTxFrame.abData[5] = (byte)((dwMissing >> 16) & 0xFF);
+        stCANTxFrame.abData[6] = (byte)((dwMissing >> 8) & 0xFF);
+        stCANTxFrame.abData[7] = (byte)(dwMissing & 0xFF);
+        eState = CAN_transmit(stCANBus0, &stCANTxFrame);
+        if (eState == ESP_OK)
+        {
+            dwReportWord++;
+            wNReportFrames++;
+        }
+        return eState;
+    }
+
+    /* Report finished */
+    dwMissing = reflash_count_missing();
+    stCANTxFrame.byDLC = 5;
+    stCANTxFrame.abData[0] = REFLASH_RESP_DONE;
+    stCANTxFrame.abData[1] = (byte)((dwMissing >> 24) & 0xFF);
+    stCANTxFrame.abData[2] = (byte)((dwMissing >> 16) & 0xFF);
+    stCANTxFrame.abData[3] = (byte)((dwMissing >> 8) & 0xFF);
+    stCANTxFrame.abData[4] = (byte)(dwMissing & 0xFF);
+    eState = CAN_transmit(stCANBus0, &stCANTxFrame);
+    if (eState == ESP_OK)
+    {
+        bReportActive = FALSE;
+    }
+    return eState;
+}
+
+static esp_err_t reflash_commit(esp_partition_t *stOTAPartition, dword dwDigest)
+{
+    /*
+    *===========================================================================
+    *   reflash_commit
+    *   Takes:   stOTAPartition: Partition holding the new image.
+    *            dwDigest: Expected CRC32 of the whole image.
+    * 
+    *   Returns: Error code if the image could not be committed, does not return
+    *            on success.
+    * 
+    *   Reads the image back and checks it against the digest from the host.
+    *   If it matches the partition is set as the boot partition and the device
+    *   restarts. The result is always reported with a COMMIT frame.
+    *   A unicast host that never sent a digest (0) is trusted as before. A bad
+    *   image clears the checkpoint so the next attempt starts from scratch.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Unicast commit, clear the checkpoint
+    *   18/10/26 CP Reply on the transport the reflash came in on
+    *===========================================================================
+    */
+    byte abyReadBuffer[REFLASH_READ_BLOCK_SIZE];
+    eReflashCommit_t eResult = eREFLASH_COMMIT_OK;
+    esp_err_t eState = ESP_OK;
+    dword dwCRC = 0;
+    dword dwOffset = 0;
+    dword dwNBytes;
+    CAN_frame_t stCANTxFrame;
+
+    if (reflash_count_missing() > 0)
+    {
+        eResult = eREFLASH_COMMIT_INCOMPLETE;
+    }
+
+    while (eResult == eREFLASH_COMMIT_OK && dwOffset < dwFirmwareSize)
+    {
+        dwNBytes = dwFirmwareSize - dwOffset;
+        if (dwNBytes > REFLASH_READ_BLOCK_SIZE)
+        {
+            dwNBytes = REFLASH_READ_BLOCK_SIZE;
+        }
+        eState = esp_partition_read(stOTAPartition, dwOffset, abyReadBuffer, dwNBytes);
+        if (eState != ESP_OK)
+        {
+            eResult = eREFLASH_COMMIT_FLASH_ERROR;
+            break;
+        }
+        dwCRC = esp_rom_crc32_le(dwCRC, abyReadBuffer, dwNBytes);
+        dwOffset += dwNBytes;
+    }
+
+    if (eResult == eREFLASH_COMMIT_OK && (bMulticastReflash || dwDigest != 0) && dwCRC != dwDigest)
+    {
+        ESP_LOGE("CANFLASH", "Image digest mismatch, got 0x%08X expected 0x%08X", (unsigned)dwCRC, (unsigned)dwDigest);
+        eResult = eREFLASH_COMMIT_BAD_DIGEST;
+    }
+    if (eResult == eREFLASH_COMMIT_OK)
+    {
+        eState = esp_ota_set_boot_partition(stOTAPartition);
+        if (eState != ESP_OK)
+        {
+            ESP_LOGE("CANFLASH", "Failed to set boot partition: %s", esp_err_to_name(eState));
+            eResult = eREFLASH_COMMIT_FLASH_ERROR;
+        }
+    }
+
+    switch (eReflashTransport)
+    {
+        case eREFLASH_TRANSPORT_ESPNOW:
+            (void)ESPNOW_flash_send_commit(eResult);
+            break;
+        case eREFLASH_TRANSPORT_CAN:
+        default:
+            stCANTxFrame.dwID = DEVICE_ID;
+            stCANTxFrame.byDLC = 2;
+            stCANTxFrame.abData[0] = REFLASH_RESP_COMMIT;
+            stCANTxFrame.abData[1] = (byte)eResult;
+            (void)CAN_transmit(stCANBus0, &stCANTxFrame);
+            break;
+    }
+
+    if (eResult == eREFLASH_COMMIT_OK)
+    {
+        ESP_LOGI("CANFLASH", "Reflash committed, %d CRC errors", (int)dwErrorCountReflash);
+        reflash_clear_checkpoint();
+        vTaskDelay(pdMS_TO_TICKS(REFLASH_RESTART_DELAY_MS));
+        esp_restart();
+    }
+    if (eResult == eREFLASH_COMMIT_BAD_DIGEST)
+    {
+        /* Flash holds a bad image, the next query erases it all again */
+        reflash_clear_checkpoint();
+        memset(&stCheckpoint, 0, sizeof(stCheckpoint));
+        bImagePrepared = FALSE;
+        dwBytesWrittenReflash = 0;
+        wNSectorBytes = 0;
+    }
+    return (eState != ESP_OK) ? eState : ESP_ERR_INVALID_STATE;
+}
+
+static esp_err_t reflash_append(esp_partition_t *stOTAPartition, const byte *abyData, word wNBytes)
+{
+    /*
+    *===========================================================================
+    *   reflash_append
+    *   Takes:   stOTAPartition: Target partition to write to.
+    *            abyData: Binary data from a unicast frame.
+    *            wNBytes: Number of bytes of binary in the frame.
+    * 
+    *   Returns: ESP_OK if the data was taken, error code if not. Nothing is
+    *            kept on an error so the frame can be NACKed and resent.
+    * 
+    *   Adds the data to the sector buffer, a full sector is written to flash
+    *   before any more data is added.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   
+    *===========================================================================
+    */
+    dword dwNReceived;
+    word wNCopy;
+    esp_err_t eState;
+
+    if (stOTAPartition == NULL || abySectorBuffer == NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    /* Host did not query the resume point, start from the beginning of the image */
+    if (!bImagePrepared)
+    {
+        eState = reflash_prepare(stOTAPartition, 0);
+        if (eState != ESP_OK)
+        {
+            return eState;
+        }
+    }
+
+    /* The last frame is padded, drop anything past the end of the binary */
+    dwNReceived = dwBytesWrittenReflash + wNSectorBytes;
+    if (dwNReceived >= dwFirmwareSize)
+    {
+        return ESP_OK;
+    }
+    if (wNBytes > dwFirmwareSize - dwNReceived)
+    {
+        wNBytes = (word)(dwFirmwareSize - dwNReceived);
+    }
+
+    if (wNSectorBytes == REFLASH_SECTOR_SIZE)
+    {
+        eState = reflash_flush_sector(stOTAPartition);
+        if (eState != ESP_OK)
+        {
+            return eState;
+        }
+    }
+
+    /* A frame can straddle two sectors */
+    wNCopy = REFLASH_SECTOR_SIZE - wNSectorBytes;
+    if (wNCopy > wNBytes)
+    {
+        wNCopy = wNBytes;
+    }
+    memcpy(&abySectorBuffer[wNSectorBytes], abyData, wNCopy);
+    wNSectorBytes += wNCopy;
+    if (wNCopy < wNBytes)
+    {
+        eState = reflash_flush_sector(stOTAPartition);
+        if (eState != ESP_OK)
+        {
+            wNSectorBytes -= wNCopy;
+            return eState;
+        }
+        memcpy(abySectorBuffer, &abyData[wNCopy], wNBytes - wNCopy);
+        wNSectorBytes = wNBytes - wNCopy;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t reflash_flush_sector(esp_partition_t *stOTAPartition)
+{
+    /*
+    *===========================================================================
+    *   reflash_flush_sector
+    *   Takes:   Target partition to write to.
+    * 
+    *   Returns: ESP_OK if successful, error code if not.
+    * 
+    *   Erases the next sector of the image, writes the sector buffer to it and
+    *   checkpoints the progress. The buffer is kept if the flash fails.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   
+    *===========================================================================
+    */
+    dword dwOffset = dwBytesWrittenReflash;
+    dword dwNSector = dwOffset / REFLASH_SECTOR_SIZE;
+    esp_err_t eState;
+
+    eState = esp_partition_erase_range(stOTAPartition, dwOffset, REFLASH_SECTOR_SIZE);
+    if (eState != ESP_OK)
+    {
+        ESP_LOGE("CANFLASH", "Failed to erase sector %d: %s", (int)dwNSector, esp_err_to_name(eState));
+        return eState;
+    }
+    eState = esp_partition_write(stOTAPartition, dwOffset, abySectorBuffer, wNSectorBytes);
+    if (eState != ESP_OK)
+    {
+        ESP_LOGE("CANFLASH", "Failed to write to OTA partition: %s", esp_err_to_name(eState));
+        return eState;
+    }
+    dwBytesWrittenReflash += wNSectorBytes;
+    wNSectorBytes = 0;
+
+    stCheckpoint.abySectorDone[dwNSector / 8] |= (byte)(1 << (dwNSector % 8));
+    stCheckpoint.dwBytesCommitted = dwBytesWrittenReflash;
+    (void)reflash_save_checkpoint();
+    return ESP_OK;
+}
+
+static esp_err_t reflash_prepare(esp_partition_t *stOTAPartition, dword dwDigest)
+{
+    /*
+    *===========================================================================
+    *   reflash_prepare
+    *   Takes:   stOTAPartition: Target partition to write to.
+    *            dwDigest: CRC32 of the image the host is sending, 0 if unknown.
+    * 
+    *   Returns: ESP_OK if successful, error code if not.
+    * 
+    *   Keeps the sectors the checkpoint has for the same image and starts a
+    *   new checkpoint otherwise. Unicast writes in order so only the leading
+    *   run of sectors is kept, later sectors are erased as they are written.
+    *   Multicast erases every sector still needed and marks the chunks inside
+    *   kept sectors as received.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   
+    *===========================================================================
+    */
+    boolean bResume = (dwDigest != 0 && stCheckpoint.dwDigest == dwDigest &&
+                       stCheckpoint.dwFirmwareSize == dwFirmwareSize);
+    dword dwNWords;
+    dword dwNSector;
+    dword dwOffset;
+    dword dwLast;
+    esp_err_t eState;
+
+    if (!bResume)
+    {
+        memset(&stCheckpoint, 0, sizeof(stCheckpoint));
+        stCheckpoint.dwDigest = dwDigest;
+        stCheckpoint.dwFirmwareSize = dwFirmwareSize;
+    }
+    dwImageDigest = dwDigest;
+    wNSectorBytes = 0;
+    bImagePrepared = FALSE;
+
+    if (!bMulticastReflash)
+    {
+        dwBytesWrittenReflash = reflash_committed_bytes();
+        for (dwNSector = dwBytesWrittenReflash / REFLASH_SECTOR_SIZE; dwNSector < dwNSectors; dwNSector++)
+        {
+            stCheckpoint.abySectorDone[dwNSector / 8] &= (byte)~(1 << (dwNSector % 8));
+        }
+    } else
+    {
+        dwNWords = (dwNChunks + REFLASH_BITMAP_WORD_BITS - 1) / REFLASH_BITMAP_WORD_BITS;
+        memset(adwChunkReceived, 0, dwNWords * sizeof(dword));
+        memset(awSectorChunks, 0, dwNSectors * sizeof(word));
+        dwNChunksReceived = 0;
+        dwBytesWrittenReflash = 0;
+
+        eState = reflash_erase_sectors(stOTAPartition);
+        if (eState != ESP_OK)
+        {
+            return eState;
+        }
+        for (dword dwNChunk = 0; dwNChunk < dwNChunks; dwNChunk++)
+        {
+            dwOffset = dwNChunk * REFLASH_CHUNK_SIZE;
+            dwLast = dwOffset + REFLASH_CHUNK_SIZE - 1;
+            if (dwLast >= dwFirmwareSize)
+            {
+                dwLast = dwFirmwareSize - 1;
+            }
+            if (reflash_sector_done(dwOffset / REFLASH_SECTOR_SIZE) && reflash_sector_done(dwLast / REFLASH_SECTOR_SIZE))
+            {
+                reflash_mark_chunk(dwNChunk);
+                dwBytesWrittenReflash += dwLast - dwOffset + 1;
+            }
+        }
+    }
+    stCheckpoint.dwBytesCommitted = reflash_committed_bytes();
+    bImagePrepared = TRUE;
+
+    if (bResume)
+    {
+        ESP_LOGI("CANFLASH", "Resuming image 0x%08X, %d bytes already in flash",
+            (unsigned)dwDigest, (int)dwBytesWrittenReflash);
+    }
+    return reflash_save_checkpoint();
+}
+
+static esp_err_t reflash_erase_sectors(esp_partition_t *stOTAPartition)
+{
+    /*
+    *===========================================================================
+    *   reflash_erase_sectors
+    *   Takes:   Target partition to erase.
+    * 
+    *   Returns: ESP_OK if successful, error code if not.
+    * 
+    *   Erases every sector of the image not marked done in the checkpoint,
+    *   a block at a time to keep the watchdog fed.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   
+    *===========================================================================
+    */
+    dword dwNSector = 0;
+    dword dwNRunEnd;
+    esp_err_t eState;
+
+    while (dwNSector < dwNSectors)
+    {
+        if (reflash_sector_done(dwNSector))
+        {
+            dwNSector++;
+            continue;
+        }
+        dwNRunEnd = dwNSector;
+        while (dwNRunEnd < dwNSectors && !reflash_sector_done(dwNRunEnd) &&
+               (dwNRunEnd - dwNSector) * REFLASH_SECTOR_SIZE < REFLASH_ERASE_STEP)
+        {
+            dwNRunEnd++;
+        }
+        eState = esp_partition_erase_range(stOTAPartition, dwNSector * REFLASH_SECTOR_SIZE,
+                                           (dwNRunEnd - dwNSector) * REFLASH_SECTOR_SIZE);
+        (void)esp_task_wdt_reset();
+        if (eState != ESP_OK)
+        {
+            ESP_LOGE("CANFLASH", "Failed to erase OTA partition: %s", esp_err_to_name(eState));
+            return eState;
+        }
+        dwNSector = dwNRunEnd;
+    }
+    return ESP_OK;
+}
+
+static void reflash_mark_chunk(dword dwNChunk)
+{
+    /*
+    *===========================================================================
+    *   reflash_mark_chunk
+    *   Takes:   dwNChunk: Index of the multicast chunk now in flash.
+    * 
+    *   Returns: Nothing.
+    * 
+    *   Sets the chunk's bit and counts it against the sectors it covers. A
+    *   sector with all its chunks is marked done and checkpointed.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   
+    *===========================================================================
+    */
+    dword dwOffset = dwNChunk * REFLASH_CHUNK_SIZE;
+    dword dwLast = dwOffset + REFLASH_CHUNK_SIZE - 1;
+
+    if (dwLast >= dwFirmwareSize)
+    {
+        dwLast = dwFirmwareSize - 1;
+    }
+    adwChunkReceived[dwNChunk / REFLASH_BITMAP_WORD_BITS] |= (dword)1 << (dwNChunk % REFLASH_BITMAP_WORD_BITS);
+    dwNChunksReceived++;
+
+    for (dword dwNSector = dwOffset / REFLASH_SECTOR_SIZE; dwNSector <= dwLast / REFLASH_SECTOR_SIZE; dwNSector++)
+    {
+        awSectorChunks[dwNSector]++;
+        if (!reflash_sector_done(dwNSector) && awSectorChunks[dwNSector] == reflash_sector_chunks(dwNSector))
+        {
+            stCheckpoint.abySectorDone[dwNSector / 8] |= (byte)(1 << (dwNSector % 8));
+            stCheckpoint.dwBytesCommitted = reflash_committed_bytes();
+            (void)reflash_save_checkpoint();
+        }
+    }
+}
+
+static dword reflash_sector_chunks(dword dwNSector)
+{
+    /*
+    *===========================================================================
+    *   reflash_sector_chunks
+    *   Takes:   dwNSector: Index of the sector in the image.
+    * 
+    *   Returns: Number of multicast chunks with at least one byte in the sector.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   
+    *===========================================================================
+    */
+    dword dwFirst = dwNSector * REFLASH_SECTOR_SIZE;
+    dword dwLast = dwFirst + REFLASH_SECTOR_SIZE - 1;
+
+    if (dwLast >= dwFirmwareSize)
+    {
+        dwLast = dwFirmwareSize - 1;
+    }
+    return dwLast / REFLASH_CHUNK_SIZE - dwFirst / REFLASH_CHUNK_SIZE + 1;
+}
+
+static boolean reflash_sector_done(dword dwNSector)
+{
+    /*
+    *===========================================================================
+    *   reflash_sector_done
+    *   Takes:   dwNSector: Index of the sector in the image.
+    * 
+    *   Returns: TRUE if the checkpoint has the sector fully written.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   
+    *===========================================================================
+    */
+    return (stCheckpoint.abySectorDone[dwNSector / 8] >> (dwNSector % 8)) & 0x1;
+}
+
+static dword reflash_committed_bytes(void)
+{
+    /*
+    *===========================================================================
+    *   reflash_committed_bytes
+    *   Takes:   None
+    * 
+    *   Returns: Bytes from the start of the image covered by done sectors,
+    *            this is the resume point reported to the host.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   
+    *===========================================================================
+    */
+    dword dwNSector = 0;
+    dword dwNBytes;
+
+    while (dwNSector < dwNSectors && reflash_sector_done(dwNSector))
+    {
+        dwNSector++;
+    }
+    dwNBytes = dwNSector * REFLASH_SECTOR_SIZE;
+    return (dwNBytes > dwFirmwareSize) ? dwFirmwareSize : dwNBytes;
+}
+
+static void reflash_load_checkpoint(void)
+{
+    /*
+    *===========================================================================
+    *   reflash_load_checkpoint
+    *   Takes:   None
+    * 
+    *   Returns: Nothing.
+    * 
+    *   Reads the checkpoint from NVS, an empty checkpoint is used if there is
+    *   none or it is from a build with a different layout.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   
+    *===========================================================================
+    */
+    nvs_handle_t stNVSHandle;
+    size_t NSize = sizeof(stCheckpoint);
+
+    memset(&stCheckpoint, 0, sizeof(stCheckpoint));
+    if (nvs_open(REFLASH_NVS_NAMESPACE, NVS_READONLY, &stNVSHandle) != ESP_OK)
+    {
+        return;
+    }
+    if (nvs_get_blob(stNVSHandle, REFLASH_NVS_KEY, &stCheckpoint, &NSize) != ESP_OK || NSize != sizeof(stCheckpoint))
+    {
+        memset(&stCheckpoint, 0, sizeof(stCheckpoint));
+    }
+    nvs_close(stNVSHandle);
+}
+
+static esp_err_t reflash_save_checkpoint(void)
+{
+    /*
+    *===========================================================================
+    *   reflash_save_checkpoint
+    *   Takes:   None
+    * 
+    *   Returns: ESP_OK if successful, error code if not.
+    * 
+    *   Writes the checkpoint to NVS. Called once per sector so the NVS wear is
+    *   a few hundred small writes per reflash.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   
+    *===========================================================================
+    */
+    nvs_handle_t stNVSHandle;
+    esp_err_t eState;
+
+    eState = nvs_open(REFLASH_NVS_NAMESPACE, NVS_READWRITE, &stNVSHandle);
+    if (eState == ESP_OK)
+    {
+        eState = nvs_set_blob(stNVSHandle, REFLASH_NVS_KEY, &stCheckpoint, sizeof(stCheckpoint));
+        if (eState == ESP_OK)
+        {
+            eState = nvs_commit(stNVSHandle);
+        }
+        nvs_close(stNVSHandle);
+    }
+    if (eState != ESP_OK)
+    {
+        ESP_LOGW("CANFLASH", "Failed to save reflash checkpoint: %s", esp_err_to_name(eState));
+    }
+    return eState;
+}
+
+static void reflash_clear_checkpoint(void)
+{
+    /*
+    *===========================================================================
+    *   reflash_clear_checkpoint
+    *   Takes:   None
+    * 
+    *   Returns: Nothing.
+    * 
+    *   Removes the checkpoint from NVS once the image is committed or found to
+    *   be bad.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   
+    *===========================================================================
+    */
+    nvs_handle_t stNVSHandle;
+
+    if (nvs_open(REFLASH_NVS_NAMESPACE, NVS_READWRITE, &stNVSHandle) != ESP_OK)
+    {
+        return;
+    }
+    (void)nvs_erase_key(stNVSHandle, REFLASH_NVS_KEY);
+    (void)nvs_commit(stNVSHandle);
+    nvs_close(stNVSHandle);
+}
@@ -3,20 +3,107 @@
 #define CANflashH
 #include "esp_partition.h"
 #include "esp_ota_ops.h"
+#include "esp_rom_crc.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
+#include "freertos/task.h"
 #include "esp_timer.h"
+#include "esp_task_wdt.h"
+#include "nvs_flash.h"
+#include "nvs.h"
 #include "./../main.h"
 #include "can.h"
 
+/*  Multicast Reflash
+    Enter:  ID: CAN_CMD_ID, Data: [eCMD_REFLASH_MULTICAST, NodeMask1, NodeMask0, Size3..Size0]
+            Bit n of the node mask selects the node with DEVICE_ID REFLASH_NODE_ID_BASE + n,
+            REFLASH_ALL_NODES selects every node including those outside the range.
+    Data:   ID: REFLASH_MULTICAST_ID | Seq, Data: [7 bytes of binary, CRC8]
+            Seq is the 7 byte chunk index, frames may arrive in any order.
+    Status: ID: CAN_CMD_ID, Data: [eCMD_REFLASH_STATUS, NodeMask1, NodeMask0, Op, Digest3..Digest0]
+            Op REFLASH_OP_QUERY:  Node replies with a RESUME frame, MISSING frames then a DONE
+                                  frame. The first query with a digest erases what is not
+                                  already in the checkpoint for that digest, so it may take
+                                  a few seconds to be answered.
+            Op REFLASH_OP_COMMIT: Node checks the CRC32 of the image against Digest,
+                                  replies with a COMMIT frame and boots the new image.
+    Replies are sent on DEVICE_ID:
+            RESUME:  [REFLASH_RESP_RESUME, Offset3..Offset0] bytes already in flash from the start
+            MISSING: [REFLASH_RESP_MISSING, Base2..Base0, Mask3..Mask0] bit n = chunk Base + n missing
+            DONE:    [REFLASH_RESP_DONE, NMissing3..NMissing0]
+            COMMIT:  [REFLASH_RESP_COMMIT, eReflashCommit_t]
+
+    Unicast Reflash
+    The same QUERY (Mask REFLASH_ALL_NODES if the ID is out of range) gives the resume point,
+    data frames then continue from that offset. A unicast image is committed once the last
+    byte is written, checked against the digest of the last query if one was sent.
+    Data:   ID: REFLASH_UNICAST_ID | DEVICE_ID << REFLASH_NODE_SHIFT | Offset, Data: [7 bytes of binary, CRC8]
+            Offset is the low bits of the byte offset of the first byte, REFLASH_OFFSET_MASK. Only
+            the frame at the next offset is written, one the node already has, resent as its ACK
+            was lost, is ACKed again and dropped.
+    Replies are sent on DEVICE_ID, Offset the bytes received so far:
+            ACK:     [REFLASH_RESP_ACK, Offset3..Offset0]
+            NACK:    [REFLASH_RESP_NACK, ErrorCount0, ErrorCount1, Offset3..Offset0] bad CRC, a
+                     gap or a write that failed, the host continues from Offset
+
+    The unicast reflash can also run over ESP-NOW, see espnowflash.h.
+
+    Progress is checkpointed to NVS every flash sector, so a reflash cut short by a power loss
+    or a dropped link resumes from the last full sector if the same image is sent again.
+*/
+#define REFLASH_MULTICAST_ID     0x1FE00000
+#define REFLASH_SEQ_MASK         0x001FFFFF
+#define REFLASH_UNICAST_ID       0x1F800000
+#define REFLASH_NODE_SHIFT       14
+#define REFLASH_OFFSET_MASK      0x00003FFF
+#define REFLASH_NODE_ID_BASE     0x10
+#define REFLASH_CHUNK_SIZE       7
+#define REFLASH_ALL_NODES        0xFFFF
+#define REFLASH_SECTOR_SIZE      4096
+#define REFLASH_MAX_SECTORS      1024       // 4 MB image, sets the size of the NVS checkpoint
+#define REFLASH_IDLE_TIMEOUT_US  10000000   // us without a reflash frame before giving up
+
+#define REFLASH_OP_QUERY         0x00
+#define REFLASH_OP_COMMIT        0x01
+
+#define REFLASH_RESP_MISSING     0x4D
+#define REFLASH_RESP_DONE        0x44
+#define REFLASH_RESP_COMMIT      0x43
+#define REFLASH_RESP_RESUME      0x52
+#define REFLASH_RESP_ACK         0xFF
+#define REFLASH_RESP_NACK        0x00
+
+typedef enum {
+    eREFLASH_TRANSPORT_CAN = 0,
+    eREFLASH_TRANSPORT_ESPNOW,
+} eReflashTransport_t;
+
+typedef enum {
+    eREFLASH_COMMIT_OK = 0,
+    eREFLASH_COMMIT_BAD_DIGEST,
+    eREFLASH_COMMIT_INCOMPLETE,
+    eREFLASH_COMMIT_FLASH_ERROR,
+} eReflashCommit_t;
+
 esp_err_t CAN_flash_empty_queue(esp_partition_t *stOTAPartition);
 esp_err_t CAN_flash_write(esp_partition_t *stOTAPartition);
 dword CAN_flash_get_size();
 esp_err_t CAN_flash_init();
 word crc8(qword dwData);
+boolean CAN_flash_node_in_mask(word wNodeMask);
+esp_err_t CAN_flash_start(esp_partition_t *stOTAPartition);
+void CAN_flash_stop(void);
+esp_err_t CAN_flash_resume(esp_partition_t *stOTAPartition, dword dwDigest, dword *pdwNBytesReceived);
+esp_err_t CAN_flash_append(esp_partition_t *stOTAPartition, const byte *abyData, word wNBytes);
+dword CAN_flash_bytes_received(void);
+void CAN_flash_status_request(const byte *abyData, byte byDLC);
+esp_err_t CAN_flash_service_status(esp_partition_t *stOTAPartition);
 
 extern dword dwBytesWrittenReflash;
 extern word dwErrorCountReflash;
 extern dword dwFirmwareSize;
+extern boolean bMulticastReflash;
+extern qword qwtLastReflashActivity;
+extern eReflashTransport_t eReflashTransport;
 
-#endif
\ No newline at end of file
+#endif
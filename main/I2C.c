@@ -6,6 +6,7 @@ over I2C. Timer is a TBC (MCP7940M?)
 Written by Cole Perera for Sheffield Formula Racing 2025
 */
 
+#include <string.h>
 #include "I2C.h"
 
 /* --------------------------- Global Variables ----------------------------- */
@@ -16,7 +17,7 @@ i2c_master_dev_handle_t stI2C0Dev0Handle;
 esp_err_t I2C_init(void);
 esp_err_t I2C_write( uint8_t *abyData, size_t NDataLength);
 esp_err_t I2C_read( uint8_t *abyData, size_t NDataLength);
-esp_err_t eternal_clock_read_time(void);
+esp_err_t eternal_clock_read_time(uint8_t *abyTime);
 esp_err_t eternal_clock_write_time(int year, int month, int day, int hour, int min, int sec);
 
 /* --------------------------- Definitions ---------------------------------- */
@@ -87,16 +88,29 @@ esp_err_t I2C_read(uint8_t *abyData, size_t NDataLength)
     return ESP_OK;
 }
 
-esp_err_t eternal_clock_read_time(void)
+esp_err_t eternal_clock_read_time(uint8_t *abyTime)
 {
+    /* abyTime, if not NULL, gets the 7 BCD time registers in 24 hour mode */
     uint8_t byStartReg = 0x00;
     uint8_t abyTimeData[7];
     char achTime[20];
     esp_err_t eStatus = ESP_OK;
 
+    if (stI2C0Dev0Handle == NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
     /* Set register pointer in slave */
     eStatus = I2C_write(&byStartReg, sizeof(byStartReg));
-    eStatus = I2C_read(abyTimeData, sizeof(abyTimeData));
+    if (eStatus == ESP_OK)
+    {
+        eStatus = I2C_read(abyTimeData, sizeof(abyTimeData));
+    }
+    if (eStatus != ESP_OK)
+    {
+        return eStatus;
+    }
     
     /* if in 12 hour mode, convert to 24 hour mode */
     if (abyTimeData[2] & 0x40)
@@ -132,7 +146,11 @@ esp_err_t eternal_clock_read_time(void)
              abyTimeData[6] & 0x3F); // Year
 
     ESP_LOGI("I2C", "%s", achTime);
-    
+    if (abyTime != NULL)
+    {
+        memcpy(abyTime, abyTimeData, sizeof(abyTimeData));
+    }
+
     return eStatus;
 }
 
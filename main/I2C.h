@@ -10,7 +10,7 @@
 esp_err_t I2C_init(void);
 esp_err_t I2C_write( uint8_t *abyData, size_t NDataLength);
 esp_err_t I2C_read( uint8_t *abyData, size_t NDataLength);
-esp_err_t eternal_clock_read_time(void);
+esp_err_t eternal_clock_read_time(uint8_t *abyTime);
 esp_err_t eternal_clock_write_time(int year, int month, int day, int hour, int min, int sec);
 
 #define SFRTIMER
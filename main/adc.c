@@ -6,9 +6,47 @@ Written by Cole Perera for Sheffield Formula Racing 2025
 
 #include "adc.h"
 
+/* --------------------------- Local Types ----------------------------- */
+typedef struct {
+    dword dwNRaw;
+    qword qwRawSum;
+    qword qwRawSquares;
+    dword dwNFiltered;
+    qword qwFilteredSum;
+    qword qwFilteredSquares;
+} stADCSums_t;
+
+struct stADCChannel {
+    stADCHandles_t *stADCHandle;
+    adc_atten_t eNAtten;
+    eADCFilter_t eFilter;
+    byte byOversampleShift;
+    byte byIIRShift;
+    boolean BPrimed;                        // Filter has had its first value
+    byte byMedianNext;
+    byte byNMedian;
+    word wNSummed;
+    dword dwSum;                            // Raw counts towards the next oversampled value
+    int32_t nIIR;                           // Filtered << ADC_IIR_BITS
+    dword adwMedian[ADC_MEDIAN_SIZE];
+    volatile dword dwFiltered;              // Counts << ADC_FRACTION_BITS
+    stADCSums_t stFrameSums;                // This frame's, only touched by adc_conv_done
+    stADCSums_t stSums;                     // Noise since the last adc_get_noise, under stADCLock
+    int awCurvemV[ADC_CURVE_POINTS];        // Calibrated mV every 2^ADC_CURVE_SHIFT counts
+};
+typedef struct stADCChannel stADCChannel_t;
+
 /* --------------------------- Local Variables ------------------------- */
 static adc_oneshot_unit_handle_t sADCUnit1 = NULL;
 static adc_oneshot_unit_handle_t sADCUnit2 = NULL;
+static adc_continuous_handle_t stADCContinuous = NULL;
+static stADCChannel_t astADCChannels[ADC_MAX_CHANNELS];
+static stADCChannel_t *apstADCByChannel[SOC_ADC_CHANNEL_NUM(0)];  // By adc_channel_t, NULL if not added
+static byte byNADCChannels = 0;
+static stADCStats_t stADCStats;
+static qword qwtADCReport = 0;              // Last adc_report, or adc_continuous_init
+static portMUX_TYPE stADCLock = portMUX_INITIALIZER_UNLOCKED;
+static boolean BOneshotConflictLogged = FALSE;
 
 /* --------------------------- Global Variables ------------------------ */
 stADCHandles_t stADCHandle0 =
@@ -26,6 +64,13 @@ stADCHandles_t stADCHandle1 =
 /* --------------------------- Definitions ----------------------------- */
 
 
+/* --------------------------- Function prototypes --------------------- */
+static bool adc_conv_done(adc_continuous_handle_t stHandle, const adc_continuous_evt_data_t *pstEvent, void *pvArg);
+static void adc_sample(stADCChannel_t *pstChannel, dword dwRaw);
+static void adc_publish_sums(stADCChannel_t *pstChannel);
+static dword adc_median(const dword *adwValues, byte byN);
+static float adc_std(dword dwN, qword qwSum, qword qwSquares);
+
 /* --------------------------- Functions ------------------------------- */
 esp_err_t adc_register(adc_atten_t eNAtten, adc_unit_t eNUnit, stADCHandles_t *stADCHandle)
 {
@@ -136,14 +181,52 @@ float adc_read_voltage(stADCHandles_t *stADCHandle)
 *=========================================================================== 
 *   Revision History:
 *   31/10/25 CP Initial Version
+*   18/10/26 CP Channels sampled continuously read their filtered value and
+*               its curve, oneshot reads are timed
+*   18/10/26 CP SENSOR_INVALID for an ADC1 channel left out of continuous sampling
 *
 *===========================================================================
 */
 {
     int NVADCRaw = 0;
     int NVADC = 0;
+    stADCChannel_t *pstChannel = stADCHandle->pstContinuous;
+    dword dwFiltered;
+    dword dwPoint;
+    int32_t nFraction;
+    int32_t nuV;
+    dword dwtStart;
+
+    if (pstChannel != NULL)
+    {
+        /* Straight line between the two curve points either side, in uV so float only multiplies */
+        dwFiltered = pstChannel->dwFiltered;
+        dwPoint = dwFiltered >> (ADC_FRACTION_BITS + ADC_CURVE_SHIFT);
+        nFraction = (int32_t)(dwFiltered & ((1UL << (ADC_FRACTION_BITS + ADC_CURVE_SHIFT)) - 1));
+        nuV = pstChannel->awCurvemV[dwPoint] * 1000 +
+              (((pstChannel->awCurvemV[dwPoint + 1] - pstChannel->awCurvemV[dwPoint]) * 1000 * nFraction)
+               >> (ADC_FRACTION_BITS + ADC_CURVE_SHIFT));
+        return (float)nuV * 0.000001f;
+    }
+    if (stADCContinuous != NULL && stADCHandle->stADCUnit == sADCUnit1)
+    {
+        /* ADC1 is the DMA's now, a oneshot read would fail, out of every map's limits */
+        if (!BOneshotConflictLogged)
+        {
+            BOneshotConflictLogged = TRUE;
+            ESP_LOGE("ADC", "Channel %d is not in continuous sampling, ADC1 can not read it", (int)stADCHandle->eNChannel);
+        }
+        return SENSOR_INVALID;
+    }
+
+    dwtStart = esp_cpu_get_cycle_count();
     adc_oneshot_read(stADCHandle->stADCUnit, stADCHandle->eNChannel, &NVADCRaw);
     adc_cali_raw_to_voltage(stADCHandle->stCalibration, NVADCRaw, &NVADC);
+    dwtStart = esp_cpu_get_cycle_count() - dwtStart;
+    portENTER_CRITICAL(&stADCLock);
+    stADCStats.dwNOneshotReads++;
+    stADCStats.qwNOneshotCycles += dwtStart;
+    portEXIT_CRITICAL(&stADCLock);
     return (float)NVADC / 1000.0f; // Convert mV to V
 }
 
@@ -162,32 +245,16 @@ float read_sensor(stADCHandles_t *stADCHandle, stSensorMap_t *stSensorMap)
 *=========================================================================== 
 *   Revision History:
 *   16/11/25 CP Initial Version
+*   18/10/26 CP Lookup shared with convert_sensor
 *
 *===========================================================================
 */
 {
-    uint8_t NCounter;
+    float fOutput;
     float fVSensor = adc_read_voltage(stADCHandle);
-    /* If outside plauseable range throw error (SCS Requirement) */
-    if (fVSensor < stSensorMap->fLowerLimit || fVSensor > stSensorMap->fUpperLimit)
-    {
-        return -999.0f;
-    }
 
-    /* Lookup Sensor Value */
-    for (NCounter = 0; NCounter < sizeof(stSensorMap->afLookupTable[0])/sizeof(stSensorMap->afLookupTable[0][0]) - 1; NCounter++)
-    {
-        if (fVSensor >= stSensorMap->afLookupTable[0][NCounter] && fVSensor < stSensorMap->afLookupTable[0][NCounter + 1])
-        { 
-            float fSlope = (stSensorMap->afLookupTable[1][NCounter + 1] - stSensorMap->afLookupTable[1][NCounter]) /
-                           (stSensorMap->afLookupTable[0][NCounter + 1] - stSensorMap->afLookupTable[0][NCounter]);
-            float fOutput = stSensorMap->afLookupTable[1][NCounter] +
-                            fSlope * (fVSensor - stSensorMap->afLookupTable[0][NCounter]);
-            return fOutput;
-        }
-    }
-    
-    return -999.0f;
+    convert_sensor_batch(&fVSensor, &fOutput, 1, stSensorMap);
+    return fOutput;
 }
 
 float convert_sensor(float fVSensor, stSensorMap_t *stSensorMap)
@@ -205,29 +272,694 @@ float convert_sensor(float fVSensor, stSensorMap_t *stSensorMap)
 *=========================================================================== 
 *   Revision History:
 *   16/11/25 CP Initial Version
+*   18/10/26 CP Lookup shared with read_sensor
 *
 *===========================================================================
 */
 {
-    uint8_t NCounter;
-    /* If outside plauseable range throw error (SCS Requirement) */
-    if (fVSensor < stSensorMap->fLowerLimit || fVSensor > stSensorMap->fUpperLimit)
+    float fOutput;
+
+    convert_sensor_batch(&fVSensor, &fOutput, 1, stSensorMap);
+    return fOutput;
+}
+
+esp_err_t sensor_map_init(stSensorMap_t *stSensorMap)
+{
+    /*
+    *===========================================================================
+    *   sensor_map_init
+    *   Takes:   stSensorMap: Map with its limits and afLookupTable filled in
+    *
+    *   Returns: ESP_OK, or ESP_ERR_INVALID_ARG if the breakpoints do not
+    *            rise, when the map is left uncompiled and converts nothing.
+    *
+    *   Works out each segment's slope and whether the breakpoints are evenly
+    *   spaced. Call once at boot for each map, and again if its table
+    *   changes. A map used before this is compiled on its first conversion.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    const float *afVolts = stSensorMap->afLookupTable[0];
+    const float *afValues = stSensorMap->afLookupTable[1];
+    float fStep = (afVolts[SENSOR_MAP_POINTS - 1] - afVolts[0]) / (SENSOR_MAP_POINTS - 1);
+    boolean BEven = TRUE;
+    byte byPoint;
+
+    stSensorMap->BCompiled = FALSE;
+    for (byPoint = 0; byPoint < SENSOR_MAP_POINTS - 1; byPoint++)
     {
-        return -999.0f;
+        if (!(afVolts[byPoint + 1] > afVolts[byPoint]))
+        {
+            ESP_LOGE("ADC", "Sensor map breakpoint %d does not rise", byPoint + 1);
+            return ESP_ERR_INVALID_ARG;
+        }
+        stSensorMap->afSlope[byPoint] = (afValues[byPoint + 1] - afValues[byPoint]) /
+                                        (afVolts[byPoint + 1] - afVolts[byPoint]);
+        if (fabsf(afVolts[byPoint] - (afVolts[0] + fStep * byPoint)) > fStep * SENSOR_MAP_EVEN)
+        {
+            BEven = FALSE;
+        }
     }
+    stSensorMap->fStepInverse = BEven ? 1.0f / fStep : 0.0f;
+    stSensorMap->BCompiled = TRUE;
+    return ESP_OK;
+}
 
-    /* Lookup Sensor Value */
-    for (NCounter = 0; NCounter < sizeof(stSensorMap->afLookupTable[0])/sizeof(stSensorMap->afLookupTable[0][0]) - 1; NCounter++)
+void convert_sensor_batch(const float *afVSensor, float *afOutput, word wNSamples, stSensorMap_t *stSensorMap)
+{
+    /*
+    *===========================================================================
+    *   convert_sensor_batch
+    *   Takes:   afVSensor: Voltages read from the sensor
+    *            afOutput: Filled with their values, or SENSOR_INVALID if
+    *            outside the map's limits or table, may be afVSensor
+    *            wNSamples: How many
+    *            stSensorMap: Map to convert them with, compiled here if
+    *            sensor_map_init has not been called
+    *
+    *   Returns: None
+    *
+    *   Converts each voltage by the straight line through the segment it is
+    *   in, see Sensor maps in adc.h. Includes plausibility check based on
+    *   sensor map limits for SCS compliance.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version, from read_sensor and convert_sensor
+    *
+    *===========================================================================
+    */
+    const float *afVolts = stSensorMap->afLookupTable[0];
+    const float *afValues = stSensorMap->afLookupTable[1];
+    float fFirst = afVolts[0];
+    float fLast = afVolts[SENSOR_MAP_POINTS - 1];
+    float fLower = stSensorMap->fLowerLimit > fFirst ? stSensorMap->fLowerLimit : fFirst;
+    float fUpper = stSensorMap->fUpperLimit < fLast ? stSensorMap->fUpperLimit : fLast;
+    float fVSensor;
+    int32_t nSegment;
+    byte byLow;
+    byte byHigh;
+    byte byMiddle;
+    word wSample;
+
+    if (!stSensorMap->BCompiled && sensor_map_init(stSensorMap) != ESP_OK)
+    {
+        fLower = 1.0f;      // Nothing passes
+        fUpper = 0.0f;
+    }
+
+    for (wSample = 0; wSample < wNSamples; wSample++)
     {
-        if (fVSensor >= stSensorMap->afLookupTable[0][NCounter] && fVSensor < stSensorMap->afLookupTable[0][NCounter + 1])
-        { 
-            float fSlope = (stSensorMap->afLookupTable[1][NCounter + 1] - stSensorMap->afLookupTable[1][NCounter]) /
-                           (stSensorMap->afLookupTable[0][NCounter + 1] - stSensorMap->afLookupTable[0][NCounter]);
-            float fOutput = stSensorMap->afLookupTable[1][NCounter] +
-                            fSlope * (fVSensor - stSensorMap->afLookupTable[0][NCounter]);
-            return fOutput;
+        fVSensor = afVSensor[wSample];
+        /* If outside plauseable range throw error (SCS Requirement), NaN included */
+        if (!(fVSensor >= fLower && fVSensor <= fUpper))
+        {
+            afOutput[wSample] = SENSOR_INVALID;
+            continue;
+        }
+
+        if (stSensorMap->fStepInverse != 0.0f)
+        {
+            /* Even, rounding can land a breakpoint on the segment either side so check it */
+            nSegment = (int32_t)((fVSensor - fFirst) * stSensorMap->fStepInverse);
+            if (nSegment > SENSOR_MAP_POINTS - 2)
+            {
+                nSegment = SENSOR_MAP_POINTS - 2;
+            }
+            if (nSegment > 0 && fVSensor < afVolts[nSegment])
+            {
+                nSegment--;
+            }
+            else if (nSegment < SENSOR_MAP_POINTS - 2 && fVSensor >= afVolts[nSegment + 1])
+            {
+                nSegment++;
+            }
+        }
+        else
+        {
+            /* Last breakpoint at or below the voltage */
+            byLow = 0;
+            byHigh = SENSOR_MAP_POINTS - 2;
+            while (byLow < byHigh)
+            {
+                byMiddle = (byte)((byLow + byHigh + 1) / 2);
+                if (afVolts[byMiddle] <= fVSensor)
+                {
+                    byLow = byMiddle;
+                }
+                else
+                {
+                    byHigh = (byte)(byMiddle - 1);
+                }
+            }
+            nSegment = byLow;
         }
+        afOutput[wSample] = afValues[nSegment] + stSensorMap->afSlope[nSegment] * (fVSensor - afVolts[nSegment]);
     }
-    
-    return -999.0f;
-}
\ No newline at end of file
+}
+
+esp_err_t adc_continuous_add(stADCHandles_t *stADCHandle, adc_atten_t eNAtten, byte byOversampleShift,
+                             eADCFilter_t eFilter, byte byIIRShift)
+{
+    /*
+    *===========================================================================
+    *   adc_continuous_add
+    *   Takes:   stADCHandle: ADC1 channel to sample, its eNChannel is used
+    *            eNAtten: ADC attenuation setting
+    *            byOversampleShift: 2^byOversampleShift samples are averaged
+    *            into each value, 0 to ADC_MAX_OVERSAMPLE
+    *            eFilter: Filter the averaged values go through
+    *            byIIRShift: eADC_FILTER_IIR only, each value moves the output
+    *            1/2^byIIRShift of the way, 1 to 15
+    *
+    *   Returns: ESP_OK if the channel will be sampled, ESP_ERR_INVALID_STATE
+    *            if sampling has started or the channel was already added,
+    *            ESP_ERR_INVALID_ARG if a setting is out of range, or the
+    *            calibration's error.
+    *
+    *   Adds a channel to the continuous sampling started by
+    *   adc_continuous_init, which must not have been called yet. Its
+    *   calibration curve is worked out here so reads never call it. Replaces
+    *   adc_register for the channel.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    esp_err_t eStatus;
+    stADCChannel_t *pstChannel;
+    adc_cali_handle_t stCalibration = stADCHandle->stCalibration;
+    word wPoint;
+    int NRaw;
+
+    if (stADCContinuous != NULL || byNADCChannels >= ADC_MAX_CHANNELS || stADCHandle->pstContinuous != NULL ||
+        (dword)stADCHandle->eNChannel >= SOC_ADC_CHANNEL_NUM(0) || apstADCByChannel[stADCHandle->eNChannel] != NULL)
+    {
+        ESP_LOGE("ADC", "Cannot add channel %d to continuous sampling", (int)stADCHandle->eNChannel);
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (byOversampleShift > ADC_MAX_OVERSAMPLE || eFilter > eADC_FILTER_MEDIAN ||
+        (eFilter == eADC_FILTER_IIR && (byIIRShift < 1 || byIIRShift > 15)))
+    {
+        ESP_LOGE("ADC", "Invalid continuous settings for channel %d", (int)stADCHandle->eNChannel);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (stCalibration == NULL)
+    {
+        adc_cali_curve_fitting_config_t stCalibrationConfig = {
+            .unit_id = ADC_UNIT_1,
+            .chan = stADCHandle->eNChannel,
+            .atten = eNAtten,
+            .bitwidth = ADC_BITWIDTH_12,
+        };
+        eStatus = adc_cali_create_scheme_curve_fitting(&stCalibrationConfig, &stCalibration);
+        if (eStatus != ESP_OK)
+        {
+            ESP_LOGE("ADC", "Failed to create calibration handle: %s", esp_err_to_name(eStatus));
+            return eStatus;
+        }
+        stADCHandle->stCalibration = stCalibration;
+    }
+
+    pstChannel = &astADCChannels[byNADCChannels];
+    memset(pstChannel, 0, sizeof(*pstChannel));
+    for (wPoint = 0; wPoint < ADC_CURVE_POINTS; wPoint++)
+    {
+        NRaw = wPoint << ADC_CURVE_SHIFT;
+        eStatus = adc_cali_raw_to_voltage(stCalibration, NRaw > 4095 ? 4095 : NRaw, &pstChannel->awCurvemV[wPoint]);
+        if (eStatus != ESP_OK)
+        {
+            ESP_LOGE("ADC", "Failed to calibrate channel %d: %s", (int)stADCHandle->eNChannel, esp_err_to_name(eStatus));
+            return eStatus;
+        }
+    }
+    pstChannel->stADCHandle = stADCHandle;
+    pstChannel->eNAtten = eNAtten;
+    pstChannel->eFilter = eFilter;
+    pstChannel->byOversampleShift = byOversampleShift;
+    pstChannel->byIIRShift = byIIRShift;
+    apstADCByChannel[stADCHandle->eNChannel] = pstChannel;
+    stADCHandle->pstContinuous = pstChannel;
+    byNADCChannels++;
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_init(dword dwSampleHz)
+{
+    /*
+    *===========================================================================
+    *   adc_continuous_init
+    *   Takes:   dwSampleHz: Conversions per second across every channel,
+    *            ADC_SAMPLE_HZ unless there is a reason
+    *
+    *   Returns: ESP_OK if sampling has started, ESP_ERR_INVALID_STATE if no
+    *            channels were added or it already had, or the driver's error.
+    *
+    *   Starts the DMA sampling the channels added by adc_continuous_add, each
+    *   gets dwSampleHz / the number added. Their values are only valid once
+    *   the first frame is in, ADC_FRAME_SAMPLES conversions later.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    esp_err_t eStatus;
+    adc_digi_pattern_config_t astPattern[ADC_MAX_CHANNELS];
+    byte byChannel;
+
+    if (stADCContinuous != NULL || byNADCChannels == 0)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    adc_continuous_handle_cfg_t stHandleConfig = {
+        .max_store_buf_size = ADC_POOL_SIZE,
+        .conv_frame_size = ADC_FRAME_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES,
+        .flags.flush_pool = 1,
+    };
+    eStatus = adc_continuous_new_handle(&stHandleConfig, &stADCContinuous);
+    if (eStatus != ESP_OK)
+    {
+        ESP_LOGE("ADC", "Failed to create continuous handle: %s", esp_err_to_name(eStatus));
+        stADCContinuous = NULL;
+        return eStatus;
+    }
+
+    for (byChannel = 0; byChannel < byNADCChannels; byChannel++)
+    {
+        astPattern[byChannel].atten = astADCChannels[byChannel].eNAtten;
+        astPattern[byChannel].channel = astADCChannels[byChannel].stADCHandle->eNChannel;
+        astPattern[byChannel].unit = ADC_UNIT_1;
+        astPattern[byChannel].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    }
+    adc_continuous_config_t stConfig = {
+        .pattern_num = byNADCChannels,
+        .adc_pattern = astPattern,
+        .sample_freq_hz = dwSampleHz,
+        .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+        .format = ADC_DIGI_OUTPUT_FORMAT_TYPE2,
+    };
+    adc_continuous_evt_cbs_t stCallbacks = {
+        .on_conv_done = adc_conv_done,
+    };
+
+    memset(&stADCStats, 0, sizeof(stADCStats));
+    qwtADCReport = esp_timer_get_time();
+    eStatus = adc_continuous_config(stADCContinuous, &stConfig);
+    if (eStatus == ESP_OK)
+    {
+        eStatus = adc_continuous_register_event_callbacks(stADCContinuous, &stCallbacks, NULL);
+    }
+    if (eStatus == ESP_OK)
+    {
+        eStatus = adc_continuous_start(stADCContinuous);
+    }
+    if (eStatus != ESP_OK)
+    {
+        ESP_LOGE("ADC", "Failed to start continuous sampling: %s", esp_err_to_name(eStatus));
+        adc_continuous_deinit(stADCContinuous);
+        stADCContinuous = NULL;
+    }
+    return eStatus;
+}
+
+dword adc_read_filtered(stADCHandles_t *stADCHandle)
+{
+    /*
+    *===========================================================================
+    *   adc_read_filtered
+    *   Takes:   stADCHandle: Channel added by adc_continuous_add
+    *
+    *   Returns: Its latest filtered value in counts << ADC_FRACTION_BITS, 0
+    *            if it is not sampled continuously.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    return stADCHandle->pstContinuous == NULL ? 0 : stADCHandle->pstContinuous->dwFiltered;
+}
+
+void adc_get_stats(stADCStats_t *pstStats)
+{
+    /*
+    *===========================================================================
+    *   adc_get_stats
+    *   Takes:   pstStats: Filled with the counts since adc_continuous_init
+    *
+    *   Returns: None
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    portENTER_CRITICAL(&stADCLock);
+    *pstStats = stADCStats;
+    portEXIT_CRITICAL(&stADCLock);
+}
+
+void adc_get_noise(stADCHandles_t *stADCHandle, stADCNoise_t *pstNoise)
+{
+    /*
+    *===========================================================================
+    *   adc_get_noise
+    *   Takes:   stADCHandle: Channel added by adc_continuous_add
+    *            pstNoise: Filled with its spread since the last call
+    *
+    *   Returns: None
+    *
+    *   Standard deviation of the raw samples and of the filtered values, in
+    *   counts, and starts counting again. All zero for a oneshot channel.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    stADCChannel_t *pstChannel = stADCHandle->pstContinuous;
+    stADCSums_t stCopy;
+
+    memset(pstNoise, 0, sizeof(*pstNoise));
+    if (pstChannel == NULL)
+    {
+        return;
+    }
+    portENTER_CRITICAL(&stADCLock);
+    stCopy = pstChannel->stSums;
+    memset(&pstChannel->stSums, 0, sizeof(pstChannel->stSums));
+    portEXIT_CRITICAL(&stADCLock);
+
+    pstNoise->dwNRaw = stCopy.dwNRaw;
+    pstNoise->dwNFiltered = stCopy.dwNFiltered;
+    pstNoise->fRawStd = adc_std(stCopy.dwNRaw, stCopy.qwRawSum, stCopy.qwRawSquares);
+    pstNoise->fFilteredStd = adc_std(stCopy.dwNFiltered, stCopy.qwFilteredSum, stCopy.qwFilteredSquares) /
+                             (1 << ADC_FRACTION_BITS);
+    if (stCopy.dwNFiltered > 0)
+    {
+        pstNoise->fMean = (float)((double)stCopy.qwFilteredSum / stCopy.dwNFiltered / (1 << ADC_FRACTION_BITS));
+    }
+}
+
+void adc_report(void)
+{
+    /*
+    *===========================================================================
+    *   adc_report
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Logs the sample rate and CPU time in us per ms spent in the conversion
+    *   done callback and in oneshot reads since the last call, and each
+    *   continuous channel's noise before and after its filter.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    static stADCStats_t stLast;
+    stADCStats_t stStats;
+    stADCNoise_t stNoise;
+    qword qwtNow = esp_timer_get_time();
+    dword dwElapsedms = (dword)((qwtNow - qwtADCReport) / 1000);
+    byte byChannel;
+
+    adc_get_stats(&stStats);
+    if (dwElapsedms == 0)
+    {
+        return;
+    }
+    ESP_LOGI("ADC", "%lu samples/s, %lu frames, %lu unknown, callback %lu.%02lu us/ms, max %lu cycles",
+        (dword)((qword)(stStats.dwNSamples - stLast.dwNSamples) * 1000 / dwElapsedms),
+        stStats.dwNFrames - stLast.dwNFrames, stStats.dwNUnknown - stLast.dwNUnknown,
+        (dword)((stStats.qwNISRCycles - stLast.qwNISRCycles) / ADC_CPU_MHZ / dwElapsedms),
+        (dword)((stStats.qwNISRCycles - stLast.qwNISRCycles) * 100 / ADC_CPU_MHZ / dwElapsedms % 100),
+        stStats.dwISRMaxCycles);
+    if (stStats.dwNOneshotReads != stLast.dwNOneshotReads)
+    {
+        ESP_LOGI("ADC", "%lu oneshot reads, %lu cycles each, %lu.%02lu us/ms",
+            stStats.dwNOneshotReads - stLast.dwNOneshotReads,
+            (dword)((stStats.qwNOneshotCycles - stLast.qwNOneshotCycles) /
+                    (stStats.dwNOneshotReads - stLast.dwNOneshotReads)),
+            (dword)((stStats.qwNOneshotCycles - stLast.qwNOneshotCycles) / ADC_CPU_MHZ / dwElapsedms),
+            (dword)((stStats.qwNOneshotCycles - stLast.qwNOneshotCycles) * 100 / ADC_CPU_MHZ / dwElapsedms % 100));
+    }
+    for (byChannel = 0; byChannel < byNADCChannels; byChannel++)
+    {
+        adc_get_noise(astADCChannels[byChannel].stADCHandle, &stNoise);
+        ESP_LOGI("ADC", "Channel %d: mean %.1f counts, std %.2f raw, %.2f filtered",
+            (int)astADCChannels[byChannel].stADCHandle->eNChannel, stNoise.fMean, stNoise.fRawStd,
+            stNoise.fFilteredStd);
+    }
+    stLast = stStats;
+    qwtADCReport = qwtNow;
+}
+
+/* --------------------------- Local Functions ------------------------- */
+static bool IRAM_ATTR adc_conv_done(adc_continuous_handle_t stHandle, const adc_continuous_evt_data_t *pstEvent, void *pvArg)
+{
+    /*
+    *===========================================================================
+    *   adc_conv_done
+    *   Takes:   stHandle: Unused
+    *            pstEvent: The frame of type 2 samples the DMA has filled
+    *            pvArg: Unused
+    *
+    *   Returns: false, no task needs waking
+    *
+    *   Conversion done callback, in the ADC's interrupt. Hands each sample to
+    *   its channel and counts the cycles taken. The samples go into each
+    *   channel's frame sums outside the lock, which is only held to add
+    *   them to the sums adc_get_noise reads, so it still sees whole frames.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Only the finished sums are published inside the lock
+    *
+    *===========================================================================
+    */
+    const adc_digi_output_data_t *pstSample;
+    stADCChannel_t *pstChannel;
+    dword dwtStart = esp_cpu_get_cycle_count();
+    dword dwOffset;
+    dword dwNUnknown = 0;
+    dword dwCycles;
+    byte byChannel;
+
+    (void)stHandle;
+    (void)pvArg;
+    for (dwOffset = 0; dwOffset + SOC_ADC_DIGI_RESULT_BYTES <= pstEvent->size; dwOffset += SOC_ADC_DIGI_RESULT_BYTES)
+    {
+        pstSample = (const adc_digi_output_data_t *)&pstEvent->conv_frame_buffer[dwOffset];
+        if (pstSample->type2.unit != 0 || pstSample->type2.channel >= SOC_ADC_CHANNEL_NUM(0) ||
+            (pstChannel = apstADCByChannel[pstSample->type2.channel]) == NULL)
+        {
+            dwNUnknown++;
+            continue;
+        }
+        adc_sample(pstChannel, pstSample->type2.data);
+    }
+
+    portENTER_CRITICAL_ISR(&stADCLock);
+    for (byChannel = 0; byChannel < byNADCChannels; byChannel++)
+    {
+        adc_publish_sums(&astADCChannels[byChannel]);
+    }
+    dwCycles = esp_cpu_get_cycle_count() - dwtStart;
+    stADCStats.dwNFrames++;
+    stADCStats.dwNSamples += pstEvent->size / SOC_ADC_DIGI_RESULT_BYTES;
+    stADCStats.dwNUnknown += dwNUnknown;
+    stADCStats.qwNISRCycles += dwCycles;
+    if (dwCycles > stADCStats.dwISRMaxCycles)
+    {
+        stADCStats.dwISRMaxCycles = dwCycles;
+    }
+    portEXIT_CRITICAL_ISR(&stADCLock);
+    return false;
+}
+
+static void IRAM_ATTR adc_sample(stADCChannel_t *pstChannel, dword dwRaw)
+{
+    /*
+    *===========================================================================
+    *   adc_sample
+    *   Takes:   pstChannel: Channel the sample is from
+    *            dwRaw: 12 bit count
+    *
+    *   Returns: None
+    *
+    *   Adds the sample to the channel's sum, and once 2^byOversampleShift are
+    *   in runs their average through the filter and publishes it.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    dword dwValue;
+
+    pstChannel->stFrameSums.dwNRaw++;
+    pstChannel->stFrameSums.qwRawSum += dwRaw;
+    pstChannel->stFrameSums.qwRawSquares += dwRaw * dwRaw;
+    pstChannel->dwSum += dwRaw;
+    if (++pstChannel->wNSummed < (1U << pstChannel->byOversampleShift))
+    {
+        return;
+    }
+    dwValue = (pstChannel->dwSum << ADC_FRACTION_BITS) >> pstChannel->byOversampleShift;
+    pstChannel->dwSum = 0;
+    pstChannel->wNSummed = 0;
+
+    switch (pstChannel->eFilter)
+    {
+        case eADC_FILTER_IIR:
+            if (!pstChannel->BPrimed)
+            {
+                pstChannel->nIIR = (int32_t)(dwValue << ADC_IIR_BITS);
+            }
+            else
+            {
+                pstChannel->nIIR += ((int32_t)(dwValue << ADC_IIR_BITS) - pstChannel->nIIR) >> pstChannel->byIIRShift;
+            }
+            dwValue = (dword)pstChannel->nIIR >> ADC_IIR_BITS;
+            break;
+
+        case eADC_FILTER_MEDIAN:
+            pstChannel->adwMedian[pstChannel->byMedianNext] = dwValue;
+            pstChannel->byMedianNext = (pstChannel->byMedianNext + 1) % ADC_MEDIAN_SIZE;
+            if (pstChannel->byNMedian < ADC_MEDIAN_SIZE)
+            {
+                pstChannel->byNMedian++;
+            }
+            dwValue = adc_median(pstChannel->adwMedian, pstChannel->byNMedian);
+            break;
+
+        default:
+            break;
+    }
+    pstChannel->BPrimed = TRUE;
+    pstChannel->dwFiltered = dwValue;
+    pstChannel->stFrameSums.dwNFiltered++;
+    pstChannel->stFrameSums.qwFilteredSum += dwValue;
+    pstChannel->stFrameSums.qwFilteredSquares += (qword)dwValue * dwValue;
+}
+
+static void IRAM_ATTR adc_publish_sums(stADCChannel_t *pstChannel)
+{
+    /*
+    *===========================================================================
+    *   adc_publish_sums
+    *   Takes:   pstChannel: Channel the frame's samples were added to
+    *
+    *   Returns: None
+    *
+    *   Adds the frame's sums to the ones adc_get_noise reads and clears them
+    *   for the next frame. Called inside stADCLock.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    stADCSums_t *pstFrame = &pstChannel->stFrameSums;
+    stADCSums_t *pstSums = &pstChannel->stSums;
+
+    pstSums->dwNRaw += pstFrame->dwNRaw;
+    pstSums->qwRawSum += pstFrame->qwRawSum;
+    pstSums->qwRawSquares += pstFrame->qwRawSquares;
+    pstSums->dwNFiltered += pstFrame->dwNFiltered;
+    pstSums->qwFilteredSum += pstFrame->qwFilteredSum;
+    pstSums->qwFilteredSquares += pstFrame->qwFilteredSquares;
+    pstFrame->dwNRaw = 0;
+    pstFrame->qwRawSum = 0;
+    pstFrame->qwRawSquares = 0;
+    pstFrame->dwNFiltered = 0;
+    pstFrame->qwFilteredSum = 0;
+    pstFrame->qwFilteredSquares = 0;
+}
+
+static dword IRAM_ATTR adc_median(const dword *adwValues, byte byN)
+{
+    /*
+    *===========================================================================
+    *   adc_median
+    *   Takes:   adwValues: Values, not changed
+    *            byN: How many, up to ADC_MEDIAN_SIZE
+    *
+    *   Returns: The middle one once sorted, the upper if byN is even
+    *
+    *   Insertion sort of a copy, five values is quicker than anything clever.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    dword adwSorted[ADC_MEDIAN_SIZE];
+    dword dwValue;
+    byte byI;
+    byte byJ;
+
+    for (byI = 0; byI < byN; byI++)
+    {
+        dwValue = adwValues[byI];
+        for (byJ = byI; byJ > 0 && adwSorted[byJ - 1] > dwValue; byJ--)
+        {
+            adwSorted[byJ] = adwSorted[byJ - 1];
+        }
+        adwSorted[byJ] = dwValue;
+    }
+    return adwSorted[byN / 2];
+}
+
+static float adc_std(dword dwN, qword qwSum, qword qwSquares)
+{
+    /*
+    *===========================================================================
+    *   adc_std
+    *   Takes:   dwN: Number of values
+    *            qwSum: Their sum
+    *            qwSquares: Sum of their squares
+    *
+    *   Returns: Their standard deviation, 0 if there are fewer than two
+    *
+    *   In double as the sums are too big for a float's mantissa, only called
+    *   from adc_report so the C6's soft double does not matter.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    double dMean;
+    double dVariance;
+
+    if (dwN < 2)
+    {
+        return 0.0f;
+    }
+    dMean = (double)qwSum / dwN;
+    dVariance = (double)qwSquares / dwN - dMean * dMean;
+    return dVariance > 0.0 ? (float)sqrt(dVariance) : 0.0f;
+}
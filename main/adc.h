@@ -2,16 +2,95 @@
 #define ADC_H
 
 #include "esp_adc/adc_oneshot.h"
+#include "esp_adc/adc_continuous.h"
 #include "esp_adc/adc_cali.h"
 #include "esp_adc/adc_cali_scheme.h"
+#include "esp_cpu.h"
+#include <math.h>
 
 #include "pin.h"
 #include "main.h"
 
+/*  Continuous sampling
+    Channels added with adc_continuous_add are sampled by the ADC's DMA at ADC_SAMPLE_HZ between
+    them, in the order they were added, once adc_continuous_init starts it. Each frame of
+    ADC_FRAME_SAMPLES is processed in the driver's conversion done callback, so nothing polls:
+        - 2^byOversampleShift samples are summed into one, kept to 1/16 count.
+        - That goes through the channel's filter: none, a first order IIR that moves 1/2^byIIRShift
+          of the way each sample, or the median of the last ADC_MEDIAN_SIZE, which drops spikes.
+        - The result is published as one 32 bit word, so adc_read_voltage for the channel is a
+          read and a lookup in ADC_CURVE_POINTS points of its calibration curve, worked out once,
+          and never touches the ADC.
+    The C6 has one ADC unit, so once it is sampling continuously every channel on it should be
+    added, adc_read_voltage on one that was not returns SENSOR_INVALID. The driver's own pool of frames is not
+    read and is flushed when it fills.
+    CPU cycles in the callback, samples, and the spread of each channel's raw samples and filtered
+    values are counted, as are oneshot reads and their cycles, and logged by adc_report so the two
+    can be compared. The spread is the noise while the input is steady.
+*/
+#define ADC_SAMPLE_HZ           20000   // Conversions/s across every channel
+#define ADC_FRAME_SAMPLES       64      // Per conversion done callback
+#define ADC_POOL_SIZE           1024    // Driver's pool, bytes, only ever flushed
+#define ADC_MAX_CHANNELS        10      // Per unit, see adc_register
+#define ADC_FRACTION_BITS       4       // Filtered values are counts * 16
+#define ADC_IIR_BITS            8       // More fraction kept in the IIR state
+#define ADC_MEDIAN_SIZE         5
+#define ADC_MAX_OVERSAMPLE      8       // Shift, 256 samples
+#define ADC_CURVE_SHIFT         7       // Counts between calibration curve points
+#define ADC_CURVE_POINTS        ((4096 >> ADC_CURVE_SHIFT) + 1)
+#define ADC_CPU_MHZ             160     // C6 default, only used to turn cycles into us by adc_report
+
+/*  Sensor maps
+    A stSensorMap_t turns volts into a value by straight lines between its SENSOR_MAP_POINTS
+    breakpoints. sensor_map_init works out each segment's slope once, so a conversion is a
+    multiply and an add, and whether the breakpoints are evenly spaced. If they are the segment is
+    found from the volts with one multiply, if not by binary search, 7 compares for 101 points.
+    Volts outside fLowerLimit to fUpperLimit, or outside the table, give SENSOR_INVALID (SCS).
+    The last breakpoint itself is inside the table.
+*/
+#define SENSOR_INVALID          -999.0f
+#define SENSOR_MAP_EVEN         0.001f  // Breakpoints within this fraction of a step count as even
+
+typedef enum {
+    eADC_FILTER_NONE = 0,
+    eADC_FILTER_IIR,
+    eADC_FILTER_MEDIAN,
+} eADCFilter_t;
+
+typedef struct {
+    dword dwNFrames;            // Conversion done callbacks
+    dword dwNSamples;
+    dword dwNUnknown;           // Samples of a channel that was not added
+    qword qwNISRCycles;
+    dword dwISRMaxCycles;
+    dword dwNOneshotReads;
+    qword qwNOneshotCycles;
+} stADCStats_t;
+
+typedef struct {
+    dword dwNRaw;               // Since the last adc_get_noise
+    dword dwNFiltered;
+    float fRawStd;              // Counts
+    float fFilteredStd;
+    float fMean;                // Counts, of the filtered values
+} stADCNoise_t;
+
+extern stADCHandles_t stADCHandle0;     // APPS1_IN
+extern stADCHandles_t stADCHandle1;     // APPS2_IN
+
 /* --------------------------- Function prototypes --------------------- */
 esp_err_t adc_register(adc_atten_t eNAtten, adc_unit_t eNUnit, stADCHandles_t *stADCHandle);
 float adc_read_voltage(stADCHandles_t *stADCHandle);
 float read_sensor(stADCHandles_t *stADCHandle, stSensorMap_t *stSensorMap);
 float convert_sensor(float fVSensor, stSensorMap_t *stSensorMap);
+esp_err_t sensor_map_init(stSensorMap_t *stSensorMap);
+void convert_sensor_batch(const float *afVSensor, float *afOutput, word wNSamples, stSensorMap_t *stSensorMap);
+esp_err_t adc_continuous_add(stADCHandles_t *stADCHandle, adc_atten_t eNAtten, byte byOversampleShift,
+                             eADCFilter_t eFilter, byte byIIRShift);
+esp_err_t adc_continuous_init(dword dwSampleHz);
+dword adc_read_filtered(stADCHandles_t *stADCHandle);
+void adc_get_stats(stADCStats_t *pstStats);
+void adc_get_noise(stADCHandles_t *stADCHandle, stADCNoise_t *pstNoise);
+void adc_report(void);
 
-#endif // ADC_H
\ No newline at end of file
+#endif // ADC_H
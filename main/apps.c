@@ -0,0 +1,358 @@
+/*
+apps.c
+File contains the APPS plausibility checks and the throttle they send, see apps.h.
+
+Written by Cole Perera for Sheffield Formula Racing 2026
+*/
+
+#include "apps.h"
+
+/* --------------------------- Local Types ---------------------------- */
+
+
+/* --------------------------- Local Variables ------------------------ */
+static boolean BAPPSInit = FALSE;
+static qword aqwtRangeSince[2];         // First of the reads out of range, 0 while in range
+static qword qwtDriftSince = 0;
+static KillSource_t eAPPSFault = KILL_SOURCE_NONE;
+static qword qwtFaultSince = 0;         // First implausible read of the standing fault
+static qword qwtLastCycle = 0;
+static qword qwtLastKill = 0;
+static qword qwtLastStatus = 0;
+static stAPPSStats_t stAPPSStats;
+static qword qwtAPPSReport = 0;
+static portMUX_TYPE stAPPSLock = portMUX_INITIALIZER_UNLOCKED;
+
+/* --------------------------- Global Variables ----------------------- */
+stSensorMap_t astAPPSMap[2];            // Volts to % of pedal travel, from APPS_map
+
+/* --------------------------- Definitions ---------------------------- */
+
+
+/* --------------------------- Function prototypes -------------------- */
+static boolean APPS_window(boolean BImplausible, qword *pqwtSince, qword qwtRead);
+static esp_err_t APPS_kill(KillLevel_t eKillLevel, qword qwtRead);
+
+
+/* --------------------------- Functions ------------------------------ */
+esp_err_t APPS_map(stSensorMap_t *stSensorMap, float fVRest, float fVFull)
+{
+    /*
+    *===========================================================================
+    *   APPS_map
+    *   Takes:   stSensorMap: Filled with volts to % of pedal travel
+    *            fVRest: Sensor volts with the pedal released
+    *            fVFull: Sensor volts with the pedal fully pressed
+    *
+    *   Returns: sensor_map_init's result, ESP_ERR_INVALID_ARG if the two are
+    *            not inside APPS_V_MIN to APPS_V_MAX.
+    *
+    *   Builds a straight line from fVRest to fVFull, either way round, with
+    *   breakpoints at both so it is exact, flat at 0 and 100 % out to
+    *   APPS_V_MIN and APPS_V_MAX, which are its limits.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    float fVLow = fVRest < fVFull ? fVRest : fVFull;
+    float fVHigh = fVRest < fVFull ? fVFull : fVRest;
+    float fVolts;
+    float fTravel;
+    byte byPoint;
+
+    if (fVLow <= APPS_V_MIN || fVHigh >= APPS_V_MAX || fVHigh - fVLow < 0.1f)
+    {
+        ESP_LOGE("APPS", "Map %.2f V to %.2f V not inside %.2f V to %.2f V", fVRest, fVFull, APPS_V_MIN, APPS_V_MAX);
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(stSensorMap, 0, sizeof(*stSensorMap));
+    for (byPoint = 0; byPoint < SENSOR_MAP_POINTS; byPoint++)
+    {
+        if (byPoint == 0)
+        {
+            fVolts = APPS_V_MIN;
+        }
+        else if (byPoint == SENSOR_MAP_POINTS - 1)
+        {
+            fVolts = APPS_V_MAX;
+        }
+        else
+        {
+            fVolts = fVLow + (fVHigh - fVLow) * (byPoint - 1) / (SENSOR_MAP_POINTS - 3);
+        }
+        fTravel = 100.0f * (fVolts - fVRest) / (fVFull - fVRest);
+        stSensorMap->afLookupTable[0][byPoint] = fVolts;
+        stSensorMap->afLookupTable[1][byPoint] = fTravel < 0.0f ? 0.0f : fTravel > 100.0f ? 100.0f : fTravel;
+    }
+    stSensorMap->fLowerLimit = APPS_V_MIN;
+    stSensorMap->fUpperLimit = APPS_V_MAX;
+    return sensor_map_init(stSensorMap);
+}
+
+esp_err_t APPS_init(void)
+{
+    /*
+    *===========================================================================
+    *   APPS_init
+    *   Takes:   None
+    *
+    *   Returns: ESP_OK if successful, error code if not.
+    *
+    *   Builds both sensors' maps from APPS1_V_* and APPS2_V_* and starts the
+    *   checks with the throttle at 0. The ADC channels are set up by
+    *   adc_continuous_add first, see main_init.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    esp_err_t eStatus;
+
+    eStatus = APPS_map(&astAPPSMap[0], APPS1_V_REST, APPS1_V_FULL);
+    if (eStatus == ESP_OK)
+    {
+        eStatus = APPS_map(&astAPPSMap[1], APPS2_V_REST, APPS2_V_FULL);
+    }
+    if (eStatus != ESP_OK)
+    {
+        return eStatus;
+    }
+    aqwtRangeSince[0] = 0;
+    aqwtRangeSince[1] = 0;
+    qwtDriftSince = 0;
+    eAPPSFault = KILL_SOURCE_NONE;
+    rAPPsFinal = 0.0f;
+    CMD_TargetRelativeCurrent = 0.0f;
+    BThrottleOK = TRUE;
+    memset(&stAPPSStats, 0, sizeof(stAPPSStats));
+    qwtAPPSReport = esp_timer_get_time();
+    BAPPSInit = TRUE;
+    return ESP_OK;
+}
+
+esp_err_t APPS_task_1ms(void)
+{
+    /*
+    *===========================================================================
+    *   APPS_task_1ms
+    *   Takes:   None
+    *
+    *   Returns: ESP_OK, ESP_ERR_INVALID_STATE before APPS_init, or the first
+    *            CAN_transmit error.
+    *
+    *   Reads both sensors, runs the range and drift checks, trips or clears
+    *   a fault and sends the throttle, status and kill as apps.h sets out.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    esp_err_t eStatus = ESP_OK;
+    esp_err_t eTxStatus;
+    float afVolts[2];
+    float afTravel[2];
+    boolean abRangeFail[2];
+    boolean BValid;
+    boolean BStatusNow = FALSE;
+    qword qwtRead;
+    qword qwtDone;
+    byte byN;
+
+    if (!BAPPSInit)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    /* Both sensors together, then their maps */
+    qwtRead = esp_timer_get_time();
+    afVolts[0] = adc_read_voltage(&stADCHandle0);
+    afVolts[1] = adc_read_voltage(&stADCHandle1);
+    afTravel[0] = convert_sensor(afVolts[0], &astAPPSMap[0]);
+    afTravel[1] = convert_sensor(afVolts[1], &astAPPSMap[1]);
+
+    /* Range, then drift while both are in range */
+    for (byN = 0; byN < 2; byN++)
+    {
+        abRangeFail[byN] = APPS_window(afTravel[byN] == SENSOR_INVALID, &aqwtRangeSince[byN], qwtRead);
+        BAPPSFail[byN] = abRangeFail[byN];
+        rAPPs[byN] = afTravel[byN] == SENSOR_INVALID ? 0.0f : afTravel[byN];
+    }
+    BValid = afTravel[0] != SENSOR_INVALID && afTravel[1] != SENSOR_INVALID;
+    BAPPSDrift = APPS_window(BValid && fabsf(afTravel[0] - afTravel[1]) > APPS_DRIFT_PERCENT, &qwtDriftSince, qwtRead);
+
+    /* Trip on the first check past its window, the sensor's own failure before drift */
+    if (eAPPSFault == KILL_SOURCE_NONE && (abRangeFail[0] || abRangeFail[1] || BAPPSDrift))
+    {
+        eAPPSFault = abRangeFail[0] ? KILL_SOURCE_APPS_1 : abRangeFail[1] ? KILL_SOURCE_APPS_2 : KILL_SOURCE_APPS_DRIFT;
+        qwtFaultSince = eAPPSFault == KILL_SOURCE_APPS_1 ? aqwtRangeSince[0] :
+                        eAPPSFault == KILL_SOURCE_APPS_2 ? aqwtRangeSince[1] : qwtDriftSince;
+        qwtLastKill = 0;
+        BStatusNow = TRUE;
+        ESP_LOGW("APPS", "%s %.2f V %.2f V", KILL_DISCRIPTION[eAPPSFault], afVolts[0], afVolts[1]);
+    }
+    /* Clear once all is plausible and the pedal is back */
+    else if (eAPPSFault != KILL_SOURCE_NONE && aqwtRangeSince[0] == 0 && aqwtRangeSince[1] == 0 &&
+             qwtDriftSince == 0 && afTravel[0] < APPS_RESET_PERCENT && afTravel[1] < APPS_RESET_PERCENT)
+    {
+        (void)APPS_kill(KILL_NONE, qwtRead);
+        eAPPSFault = KILL_SOURCE_NONE;
+        BStatusNow = TRUE;
+        ESP_LOGI("APPS", "Plausible, throttle back");
+    }
+
+    /* Throttle, the lower of the sensors in range, 0 with a fault standing */
+    BThrottleOK = eAPPSFault == KILL_SOURCE_NONE;
+    if (!BThrottleOK || (afTravel[0] == SENSOR_INVALID && afTravel[1] == SENSOR_INVALID))
+    {
+        rAPPsFinal = 0.0f;
+    }
+    else if (afTravel[0] == SENSOR_INVALID || afTravel[1] == SENSOR_INVALID)
+    {
+        rAPPsFinal = afTravel[0] == SENSOR_INVALID ? afTravel[1] : afTravel[0];
+    }
+    else
+    {
+        rAPPsFinal = afTravel[0] < afTravel[1] ? afTravel[0] : afTravel[1];
+    }
+    CMD_TargetRelativeCurrent = rAPPsFinal;
+    eTxStatus = SetRelCurrentTx(stCANBus0);
+    eStatus = eTxStatus;
+    qwtDone = esp_timer_get_time();
+
+    /* Kill after the throttle is already at 0, and again until the fault clears */
+    if (eAPPSFault != KILL_SOURCE_NONE && (qwtLastKill == 0 || qwtRead - qwtLastKill >= APPS_KILL_PERIOD_MS * 1000ULL))
+    {
+        eTxStatus = APPS_kill(KILL_INVERTER, qwtRead);
+        eStatus = eStatus == ESP_OK ? eTxStatus : eStatus;
+    }
+    if (BStatusNow || qwtRead - qwtLastStatus >= STATUSAPPSSENSOR_PERIOD_MS * 1000ULL)
+    {
+        eTxStatus = StatusAPPSSensorTx(stCANBus0);
+        eStatus = eStatus == ESP_OK ? eTxStatus : eStatus;
+        qwtLastStatus = qwtRead;
+    }
+
+    portENTER_CRITICAL(&stAPPSLock);
+    stAPPSStats.dwNCycles++;
+    if (qwtLastCycle != 0 && qwtRead - qwtLastCycle > APPS_LATE_US)
+    {
+        stAPPSStats.dwNLate++;
+    }
+    if (eStatus != ESP_OK)
+    {
+        stAPPSStats.dwNTxErrors++;
+    }
+    stAPPSStats.qwNLatencyus += qwtDone - qwtRead;
+    if (qwtDone - qwtRead > stAPPSStats.dwLatencyMaxus)
+    {
+        stAPPSStats.dwLatencyMaxus = (dword)(qwtDone - qwtRead);
+    }
+    portEXIT_CRITICAL(&stAPPSLock);
+    qwtLastCycle = qwtRead;
+    return eStatus;
+}
+
+void APPS_get_stats(stAPPSStats_t *pstStats)
+{
+    /*
+    *===========================================================================
+    *   APPS_get_stats
+    *   Takes:   pstStats: Filled with the counts since APPS_init
+    *
+    *   Returns: None
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    portENTER_CRITICAL(&stAPPSLock);
+    *pstStats = stAPPSStats;
+    portEXIT_CRITICAL(&stAPPSLock);
+}
+
+void APPS_report(void)
+{
+    /*
+    *===========================================================================
+    *   APPS_report
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Logs the checks a second run since the last call, late calls, Tx
+    *   errors, the read to SetRelCurrent latency and faults with their kill
+    *   latency. Nothing before APPS_init.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    static stAPPSStats_t stLast;
+    stAPPSStats_t stStats;
+    qword qwtNow = esp_timer_get_time();
+    dword dwElapsedms = (dword)((qwtNow - qwtAPPSReport) / 1000);
+    dword dwNCycles;
+
+    if (!BAPPSInit || dwElapsedms == 0)
+    {
+        return;
+    }
+    APPS_get_stats(&stStats);
+    dwNCycles = stStats.dwNCycles - stLast.dwNCycles;
+    ESP_LOGI("APPS", "%lu checks/s, %lu late, %lu Tx errors, latency %lu us, max %lu us, %lu faults, kill %lu us, max %lu us",
+        (dword)((qword)dwNCycles * 1000 / dwElapsedms), stStats.dwNLate - stLast.dwNLate,
+        stStats.dwNTxErrors - stLast.dwNTxErrors,
+        dwNCycles == 0 ? 0 : (dword)((stStats.qwNLatencyus - stLast.qwNLatencyus) / dwNCycles),
+        stStats.dwLatencyMaxus, stStats.dwNFaults, stStats.dwKillLatencyus, stStats.dwKillLatencyMaxus);
+    stLast = stStats;
+    qwtAPPSReport = qwtNow;
+}
+
+/* --------------------------- Local Functions ------------------------ */
+static boolean APPS_window(boolean BImplausible, qword *pqwtSince, qword qwtRead)
+{
+    /* TRUE once implausible for more than APPS_IMPLAUSIBLE_US, *pqwtSince its first read */
+    if (!BImplausible)
+    {
+        *pqwtSince = 0;
+        return FALSE;
+    }
+    if (*pqwtSince == 0)
+    {
+        *pqwtSince = qwtRead;
+    }
+    return qwtRead - *pqwtSince > APPS_IMPLAUSIBLE_US;
+}
+
+static esp_err_t APPS_kill(KillLevel_t eKillLevel, qword qwtRead)
+{
+    /* The standing fault's kill, the first of each fault timed from its first implausible read */
+    esp_err_t eStatus = CAN_Tx_killlevel(eKillLevel, eAPPSFault);
+    dword dwLatencyus;
+
+    if (eKillLevel != KILL_NONE && qwtLastKill == 0)
+    {
+        dwLatencyus = (dword)(esp_timer_get_time() - qwtFaultSince);
+        portENTER_CRITICAL(&stAPPSLock);
+        stAPPSStats.dwNFaults++;
+        stAPPSStats.dwKillLatencyus = dwLatencyus;
+        if (dwLatencyus > stAPPSStats.dwKillLatencyMaxus)
+        {
+            stAPPSStats.dwKillLatencyMaxus = dwLatencyus;
+        }
+        portEXIT_CRITICAL(&stAPPSLock);
+    }
+    qwtLastKill = qwtRead;
+    return eStatus;
+}
@@ -0,0 +1,66 @@
+#ifndef APPS_H
+#define APPS_H
+
+#include "sfrtypes.h"
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "pin.h"
+#include "adc.h"
+#include "CAN/can.h"
+#include "CAN/canDecodeAuto.h"
+
+/*  APPS plausibility
+    APPS_task_1ms, called by task_1ms on the APPS node, reads both pedal sensors one straight
+    after the other, turns each into pedal travel through its sensor map and checks them:
+        - Range, a sensor outside APPS_V_MIN to APPS_V_MAX is open or shorted, BAPPSFail.
+        - Drift, the two more than APPS_DRIFT_PERCENT of travel apart, BAPPSDrift.
+    Either for more than APPS_IMPLAUSIBLE_US is a fault: the throttle goes to 0, BThrottleOK is
+    cleared and a kill is sent with the sensor's KILL_SOURCE_APPS_*, repeated every
+    APPS_KILL_PERIOD_MS while it stands. The windows are timed from esp_timer, not counted in
+    calls, so a late task cannot stretch them. A fault clears once both sensors are plausible
+    again and the pedal is back under APPS_RESET_PERCENT, so the throttle never jumps back on.
+    rAPPsFinal, the lower of the two, is sent as SetRelCurrent every call and StatusAPPSSensor
+    every STATUSAPPSSENSOR_PERIOD_MS, and at once when a fault starts or clears.
+    Latency is measured from the sensors being read to SetRelCurrent being queued, and for a
+    fault from its first implausible read to the kill, and logged by APPS_report. The ADC's
+    oversampling, filter and frame are before the read, see adc.h, apps_bench.py measures the
+    whole of it from the pedal.
+*/
+#define APPS_ID                 0x16        // DEVICE_ID, STATUSAPPS_ID
+#define APPS_IMPLAUSIBLE_US     100000      // Rules, more than 100 ms implausible cuts the power
+#define APPS_DRIFT_PERCENT      10.0f       // Rules, more than 10 % of pedal travel apart
+#define APPS_RESET_PERCENT      5.0f        // Both under this before a fault clears
+#define APPS_KILL_PERIOD_MS     100
+#define APPS_LATE_US            1500        // Calls further apart than this are counted late
+
+/* Sensor volts at the ADC pin, the two transfer functions opposite so they never cross */
+#define APPS_V_MIN              0.20f       // Below, open or shorted to ground
+#define APPS_V_MAX              3.00f       // Above, shorted to supply
+#define APPS1_V_REST            0.40f
+#define APPS1_V_FULL            2.80f
+#define APPS2_V_REST            2.60f
+#define APPS2_V_FULL            0.60f
+
+typedef struct {
+    dword dwNCycles;
+    dword dwNLate;              // Calls more than APPS_LATE_US after the last
+    dword dwNTxErrors;
+    qword qwNLatencyus;         // Read to SetRelCurrent queued, summed
+    dword dwLatencyMaxus;
+    dword dwNFaults;
+    dword dwKillLatencyus;      // First implausible read to kill, last fault
+    dword dwKillLatencyMaxus;
+} stAPPSStats_t;
+
+extern stSensorMap_t astAPPSMap[2];
+
+/* --------------------------- Function prototypes --------------------- */
+esp_err_t APPS_map(stSensorMap_t *stSensorMap, float fVRest, float fVFull);
+esp_err_t APPS_init(void);
+esp_err_t APPS_task_1ms(void);
+void APPS_get_stats(stAPPSStats_t *pstStats);
+void APPS_report(void);
+
+#endif // APPS_H
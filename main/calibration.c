@@ -0,0 +1,608 @@
+/*
+calibration.c
+File contains the sensor calibration tables, their NVS storage and their update over CAN, see
+calibration.h.
+
+Written by Cole Perera for Sheffield Formula Racing 2026
+*/
+
+#include "calibration.h"
+
+/* --------------------------- Local Types ---------------------------- */
+typedef struct {
+    word wVersion;
+    byte byNPoints;
+    word wLowerLimit;                       // 0.1 mV, within the breakpoints
+    word wUpperLimit;
+    uint32_t dwStepInverse;                 // 65536 / breakpoint spacing if even, 0 to binary search
+    float fScale;
+    float fOffset;
+    word awVolts[CAL_MAX_POINTS];           // 0.1 mV
+    sword anValues[CAL_MAX_POINTS];
+} stCalTable_t;
+
+typedef struct {
+    stCalTable_t astTables[2];
+    stCalTable_t * volatile pstActive;      // NULL until a table is loaded
+    volatile dword dwWrites;                // Updates started, readers go again if it moves
+} stCalSlot_t;
+
+/* --------------------------- Local Variables ------------------------ */
+static stCalSlot_t astCalSlots[CAL_MAX_TABLES];
+static byte abyCalStaging[64 * CAL_CHUNK_SIZE];     // A bit of qwCalChunks each
+static qword qwCalChunks = 0;                       // Chunks received of the blob being sent
+static stCalStats_t stCalStats;
+static qword qwtCalReport = 0;
+static portMUX_TYPE stCalLock = portMUX_INITIALIZER_UNLOCKED;
+
+_Static_assert(CAL_MAX_BLOB <= sizeof(abyCalStaging), "Calibration blob needs more than 64 chunks");
+
+/* --------------------------- Global Variables ----------------------- */
+
+
+/* --------------------------- Definitions ---------------------------- */
+#define CAL_MAX_MV10        65535       // Breakpoint counts, 6.5535 V
+
+/* --------------------------- Function prototypes -------------------- */
+static float CAL_lookup(const stCalTable_t *pstTable, float fVSensor);
+static void CAL_reply(byte bySlot, eCalResult_t eResult);
+
+
+/* --------------------------- Functions ------------------------------ */
+esp_err_t CAL_init(void)
+{
+    /*
+    *===========================================================================
+    *   CAL_init
+    *   Takes:   None
+    *
+    *   Returns: ESP_OK, or NVS_init's error.
+    *
+    *   Loads every slot's table present in NVS, one that fails its checks
+    *   is logged and left out. Call once at boot before anything converts.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    static byte abyBlob[CAL_MAX_BLOB];
+    esp_err_t eStatus = NVS_init();
+    nvs_handle_t stNVSHandle;
+    eCalResult_t eResult;
+    size_t NSize;
+    char sKey[8];
+    byte bySlot;
+
+    qwtCalReport = esp_timer_get_time();
+    if (eStatus != ESP_OK)
+    {
+        ESP_LOGE("CAL", "NVS failed, no calibration tables: %s", esp_err_to_name(eStatus));
+        return eStatus;
+    }
+    if (nvs_open(CAL_NVS_NAMESPACE, NVS_READONLY, &stNVSHandle) != ESP_OK)
+    {
+        /* Nothing has been stored yet */
+        ESP_LOGW("CAL", "No calibration tables in NVS");
+        return ESP_OK;
+    }
+    for (bySlot = 0; bySlot < CAL_MAX_TABLES; bySlot++)
+    {
+        snprintf(sKey, sizeof(sKey), "cal%d", bySlot);
+        NSize = sizeof(abyBlob);
+        if (nvs_get_blob(stNVSHandle, sKey, abyBlob, &NSize) != ESP_OK)
+        {
+            continue;
+        }
+        eResult = CAL_update(abyBlob, (word)NSize, FALSE);
+        if (eResult != eCAL_OK || CAL_get_version(bySlot) == 0)
+        {
+            ESP_LOGE("CAL", "Table %s in NVS refused: %d", sKey, (int)eResult);
+            continue;
+        }
+        ESP_LOGI("CAL", "Slot %d table version %d", bySlot, CAL_get_version(bySlot));
+    }
+    nvs_close(stNVSHandle);
+    return ESP_OK;
+}
+
+eCalResult_t CAL_update(const byte *abyBlob, word wNBytes, boolean BStore)
+{
+    /*
+    *===========================================================================
+    *   CAL_update
+    *   Takes:   abyBlob: A table as util/CAN_calibrate.py makes it
+    *            wNBytes: Its size
+    *            BStore: TRUE to write it to NVS before it is swapped in
+    *
+    *   Returns: eCAL_OK if it is now the slot's table, or why not.
+    *
+    *   Checks a blob, decodes it into the slot's spare table and swaps that
+    *   in, see calibration.h. Call from one task, the background task once
+    *   CAL_init is done, readers may preempt it at any point.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    stCalBlobHeader_t stHeader;
+    stCalSlot_t *pstSlot;
+    stCalTable_t *pstSpare;
+    const byte *abyPoints = abyBlob + sizeof(stCalBlobHeader_t);
+    uint32_t dwCRC;
+    uint32_t dwSpan;
+    nvs_handle_t stNVSHandle;
+    esp_err_t eStatus;
+    char sKey[8];
+    sdword nError;
+    word wPrevious;
+    word wVolts;
+    byte byPoint;
+    boolean BEven = TRUE;
+
+    if (wNBytes < sizeof(stCalBlobHeader_t) + 4)
+    {
+        return eCAL_BAD_TABLE;
+    }
+    memcpy(&stHeader, abyBlob, sizeof(stHeader));
+    if (stHeader.dwMagic != CAL_MAGIC || stHeader.byFormat != CAL_FORMAT || stHeader.bySlot >= CAL_MAX_TABLES ||
+        stHeader.byNPoints < 2 || stHeader.byNPoints > CAL_MAX_POINTS || stHeader.wVersion == 0 ||
+        wNBytes != sizeof(stCalBlobHeader_t) + stHeader.byNPoints * 4 + 4)
+    {
+        return eCAL_BAD_TABLE;
+    }
+    memcpy(&dwCRC, abyBlob + wNBytes - 4, 4);
+    if (esp_rom_crc32_le(0, abyBlob, wNBytes - 4) != dwCRC)
+    {
+        return eCAL_BAD_CRC;
+    }
+    pstSlot = &astCalSlots[stHeader.bySlot];
+    if (stHeader.wVersion < CAL_get_version(stHeader.bySlot))
+    {
+        return eCAL_OLD_VERSION;
+    }
+
+    /* Breakpoints must rise, and a table is only used within them */
+    memcpy(&wPrevious, abyPoints, 2);
+    for (byPoint = 1; byPoint < stHeader.byNPoints; byPoint++)
+    {
+        memcpy(&wVolts, &abyPoints[2 * byPoint], 2);
+        if (wVolts <= wPrevious)
+        {
+            return eCAL_BAD_TABLE;
+        }
+        wPrevious = wVolts;
+    }
+    if (stHeader.wLowerLimit >= stHeader.wUpperLimit)
+    {
+        return eCAL_BAD_TABLE;
+    }
+
+    if (BStore)
+    {
+        snprintf(sKey, sizeof(sKey), "cal%d", stHeader.bySlot);
+        eStatus = nvs_open(CAL_NVS_NAMESPACE, NVS_READWRITE, &stNVSHandle);
+        if (eStatus == ESP_OK)
+        {
+            eStatus = nvs_set_blob(stNVSHandle, sKey, abyBlob, wNBytes);
+            if (eStatus == ESP_OK)
+            {
+                eStatus = nvs_commit(stNVSHandle);
+            }
+            nvs_close(stNVSHandle);
+        }
+        if (eStatus != ESP_OK)
+        {
+            ESP_LOGE("CAL", "Failed to store table %s: %s", sKey, esp_err_to_name(eStatus));
+            return eCAL_NVS_ERROR;
+        }
+    }
+
+    /* Readers that started before this go again once they see dwWrites move */
+    pstSpare = pstSlot->pstActive == &pstSlot->astTables[0] ? &pstSlot->astTables[1] : &pstSlot->astTables[0];
+    pstSlot->dwWrites++;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    pstSpare->wVersion = stHeader.wVersion;
+    pstSpare->byNPoints = stHeader.byNPoints;
+    pstSpare->fScale = stHeader.fScale;
+    pstSpare->fOffset = stHeader.fOffset;
+    memcpy(pstSpare->awVolts, abyPoints, stHeader.byNPoints * 2);
+    memcpy(pstSpare->anValues, &abyPoints[stHeader.byNPoints * 2], stHeader.byNPoints * 2);
+    dwSpan = pstSpare->awVolts[stHeader.byNPoints - 1] - pstSpare->awVolts[0];
+    for (byPoint = 1; byPoint < stHeader.byNPoints - 1; byPoint++)
+    {
+        /* Within 0.1 mV of even spacing, the lookup steps to the right segment from there */
+        nError = ((sdword)pstSpare->awVolts[byPoint] - pstSpare->awVolts[0]) * (stHeader.byNPoints - 1) -
+                 (sdword)dwSpan * byPoint;
+        if (nError > stHeader.byNPoints - 1 || nError < 1 - stHeader.byNPoints)
+        {
+            BEven = FALSE;
+        }
+    }
+    pstSpare->dwStepInverse = BEven ? (uint32_t)((65536u * (stHeader.byNPoints - 1) + dwSpan / 2) / dwSpan) : 0;
+    pstSpare->wLowerLimit = stHeader.wLowerLimit > pstSpare->awVolts[0] ? stHeader.wLowerLimit : pstSpare->awVolts[0];
+    pstSpare->wUpperLimit = stHeader.wUpperLimit < pstSpare->awVolts[stHeader.byNPoints - 1] ?
+                            stHeader.wUpperLimit : pstSpare->awVolts[stHeader.byNPoints - 1];
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    pstSlot->pstActive = pstSpare;
+
+    portENTER_CRITICAL(&stCalLock);
+    stCalStats.dwNUpdates++;
+    portEXIT_CRITICAL(&stCalLock);
+    return eCAL_OK;
+}
+
+float CAL_convert(byte bySlot, float fVSensor)
+{
+    /*
+    *===========================================================================
+    *   CAL_convert
+    *   Takes:   bySlot: Table to convert with
+    *            fVSensor: The voltage read from the sensor
+    *
+    *   Returns: The sensor's value, or SENSOR_INVALID if outside the table's
+    *            limits or the slot has no table.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    float fOutput;
+
+    CAL_convert_batch(bySlot, &fVSensor, &fOutput, 1);
+    return fOutput;
+}
+
+void CAL_convert_batch(byte bySlot, const float *afVSensor, float *afOutput, word wNSamples)
+{
+    /*
+    *===========================================================================
+    *   CAL_convert_batch
+    *   Takes:   bySlot: Table to convert with
+    *            afVSensor: Voltages read from the sensor
+    *            afOutput: Filled with their values, or SENSOR_INVALID if
+    *            outside the table's limits or the slot has no table, not
+    *            afVSensor as the batch may be converted again
+    *            wNSamples: How many
+    *
+    *   Returns: None
+    *
+    *   Converts the batch with the slot's table as it was when it started.
+    *   If an update started meanwhile the table may have been rewritten
+    *   under it, so the batch goes again with the new one. Updates come from
+    *   the background task which every reader preempts, so on the C6 that
+    *   only happens to a reader preempted itself for a whole update.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    stCalSlot_t *pstSlot;
+    const stCalTable_t *pstTable;
+    dword dwWrites;
+    dword dwNRetries = 0;
+    word wSample;
+
+    if (bySlot >= CAL_MAX_TABLES)
+    {
+        for (wSample = 0; wSample < wNSamples; wSample++)
+        {
+            afOutput[wSample] = SENSOR_INVALID;
+        }
+        return;
+    }
+    pstSlot = &astCalSlots[bySlot];
+    for (;;)
+    {
+        dwWrites = pstSlot->dwWrites;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        pstTable = pstSlot->pstActive;
+        for (wSample = 0; wSample < wNSamples; wSample++)
+        {
+            afOutput[wSample] = pstTable == NULL ? SENSOR_INVALID : CAL_lookup(pstTable, afVSensor[wSample]);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (pstSlot->dwWrites == dwWrites)
+        {
+            break;
+        }
+        dwNRetries++;
+    }
+
+    portENTER_CRITICAL(&stCalLock);
+    stCalStats.dwNConversions += wNSamples;
+    stCalStats.dwNRetries += dwNRetries;
+    portEXIT_CRITICAL(&stCalLock);
+}
+
+word CAL_get_version(byte bySlot)
+{
+    /*
+    *===========================================================================
+    *   CAL_get_version
+    *   Takes:   bySlot: Table to look at
+    *
+    *   Returns: Its table's version, 0 if it has none.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    const stCalTable_t *pstTable;
+
+    if (bySlot >= CAL_MAX_TABLES)
+    {
+        return 0;
+    }
+    pstTable = astCalSlots[bySlot].pstActive;
+    return pstTable == NULL ? 0 : pstTable->wVersion;
+}
+
+void IRAM_ATTR CAL_receive(dword dwID, const byte *abyData, byte byDLC)
+{
+    /*
+    *===========================================================================
+    *   CAL_receive
+    *   Takes:   dwID: A received frame's ID
+    *            abyData: Its data
+    *            byDLC: Its length
+    *
+    *   Returns: None
+    *
+    *   From the CAN Rx interrupt, for every frame. A calibration data frame
+    *   for this node is copied into the blob being received, the rest is
+    *   left to CAL_service.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    dword dwSeq = dwID & CAL_SEQ_MASK;
+
+    if ((dwID & ~(CAL_SEQ_MASK | 0xFF << CAL_NODE_SHIFT)) != CAL_DATA_ID ||
+        ((dwID >> CAL_NODE_SHIFT) & 0xFF) != (DEVICE_ID & 0xFF) || dwSeq >= 64)
+    {
+        return;
+    }
+    portENTER_CRITICAL_ISR(&stCalLock);
+    if (dwSeq == 0)
+    {
+        qwCalChunks = 0;
+    }
+    memcpy(&abyCalStaging[dwSeq * CAL_CHUNK_SIZE], abyData, byDLC < CAL_CHUNK_SIZE ? byDLC : CAL_CHUNK_SIZE);
+    qwCalChunks |= 1ULL << dwSeq;
+    stCalStats.dwNChunks++;
+    portEXIT_CRITICAL_ISR(&stCalLock);
+}
+
+esp_err_t CAL_service(void)
+{
+    /*
+    *===========================================================================
+    *   CAL_service
+    *   Takes:   None
+    *
+    *   Returns: ESP_OK, or ESP_ERR_INVALID_RESPONSE if a blob received was
+    *            refused.
+    *
+    *   From the background task. Once every chunk of a blob sent over CAN
+    *   is in, takes it with CAL_update, stored to NVS, and replies with the
+    *   result.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    static byte abyBlob[CAL_MAX_BLOB];
+    stCalBlobHeader_t *pstHeader = (stCalBlobHeader_t *)abyCalStaging;
+    eCalResult_t eResult = eCAL_BAD_TABLE;
+    word wNBytes = 0;
+    qword qwNeeded;
+    byte bySlot;
+
+    /* Nothing until the header is in */
+    portENTER_CRITICAL(&stCalLock);
+    qwNeeded = (1ULL << ((sizeof(stCalBlobHeader_t) + CAL_CHUNK_SIZE - 1) / CAL_CHUNK_SIZE)) - 1;
+    if ((qwCalChunks & qwNeeded) != qwNeeded)
+    {
+        portEXIT_CRITICAL(&stCalLock);
+        return ESP_OK;
+    }
+    bySlot = pstHeader->bySlot;
+    if (pstHeader->byNPoints >= 2 && pstHeader->byNPoints <= CAL_MAX_POINTS)
+    {
+        wNBytes = (word)(sizeof(stCalBlobHeader_t) + pstHeader->byNPoints * 4 + 4);
+        qwNeeded = (1ULL << ((wNBytes + CAL_CHUNK_SIZE - 1) / CAL_CHUNK_SIZE)) - 1;
+        if ((qwCalChunks & qwNeeded) != qwNeeded)
+        {
+            portEXIT_CRITICAL(&stCalLock);
+            return ESP_OK;
+        }
+        memcpy(abyBlob, abyCalStaging, wNBytes);
+    }
+    qwCalChunks = 0;
+    portEXIT_CRITICAL(&stCalLock);
+
+    if (wNBytes != 0)
+    {
+        eResult = CAL_update(abyBlob, wNBytes, TRUE);
+    }
+    if (eResult != eCAL_OK)
+    {
+        portENTER_CRITICAL(&stCalLock);
+        stCalStats.dwNRejected++;
+        portEXIT_CRITICAL(&stCalLock);
+        ESP_LOGE("CAL", "Table for slot %d refused: %d", bySlot, (int)eResult);
+    }
+    else
+    {
+        ESP_LOGI("CAL", "Slot %d now table version %d", bySlot, CAL_get_version(bySlot));
+    }
+    CAL_reply(bySlot, eResult);
+    return eResult == eCAL_OK ? ESP_OK : ESP_ERR_INVALID_RESPONSE;
+}
+
+void CAL_get_stats(stCalStats_t *pstStats)
+{
+    /*
+    *===========================================================================
+    *   CAL_get_stats
+    *   Takes:   pstStats: Filled with the counts since boot
+    *
+    *   Returns: None
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    portENTER_CRITICAL(&stCalLock);
+    *pstStats = stCalStats;
+    portEXIT_CRITICAL(&stCalLock);
+}
+
+void CAL_report(void)
+{
+    /*
+    *===========================================================================
+    *   CAL_report
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Logs the conversions a second since the last call, retries, updates,
+    *   refusals and each loaded slot's version. Nothing before CAL_init.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    static stCalStats_t stLast;
+    stCalStats_t stStats;
+    qword qwtNow = esp_timer_get_time();
+    dword dwElapsedms = (dword)((qwtNow - qwtCalReport) / 1000);
+    char sVersions[CAL_MAX_TABLES * 8 + 1];
+    int NLength = 0;
+    byte bySlot;
+
+    if (qwtCalReport == 0 || dwElapsedms == 0)
+    {
+        return;
+    }
+    CAL_get_stats(&stStats);
+    sVersions[0] = '\0';
+    for (bySlot = 0; bySlot < CAL_MAX_TABLES; bySlot++)
+    {
+        if (CAL_get_version(bySlot) != 0)
+        {
+            NLength += snprintf(&sVersions[NLength], sizeof(sVersions) - NLength, " %d:v%d", bySlot, CAL_get_version(bySlot));
+        }
+    }
+    ESP_LOGI("CAL", "%lu conversions/s, %lu retries, %lu updates, %lu refused, tables%s",
+        (dword)((qword)(stStats.dwNConversions - stLast.dwNConversions) * 1000 / dwElapsedms),
+        stStats.dwNRetries - stLast.dwNRetries, stStats.dwNUpdates - stLast.dwNUpdates,
+        stStats.dwNRejected - stLast.dwNRejected, NLength == 0 ? " none" : sVersions);
+    stLast = stStats;
+    qwtCalReport = qwtNow;
+}
+
+/* --------------------------- Local Functions ------------------------ */
+static float CAL_lookup(const stCalTable_t *pstTable, float fVSensor)
+{
+    /* The straight line through the segment the volts are in, in fixed point */
+    const word *awVolts = pstTable->awVolts;
+    dword dwmV10;
+    int32_t nSegment;
+    int32_t nFraction;
+    int32_t nValue;
+    byte byLow;
+    byte byHigh;
+    byte byMiddle;
+
+    /* If outside plauseable range throw error (SCS Requirement), NaN included */
+    if (!(fVSensor >= 0.0f && fVSensor * (1000.0f * CAL_MV_SCALE) < CAL_MAX_MV10 + 0.5f))
+    {
+        return SENSOR_INVALID;
+    }
+    dwmV10 = (dword)(fVSensor * (1000.0f * CAL_MV_SCALE) + 0.5f);
+    if (dwmV10 < pstTable->wLowerLimit || dwmV10 > pstTable->wUpperLimit)
+    {
+        return SENSOR_INVALID;
+    }
+
+    if (pstTable->dwStepInverse != 0)
+    {
+        /* Even, a breakpoint off by 0.1 mV can put it a segment out so step to it */
+        nSegment = (int32_t)(((uint32_t)(dwmV10 - awVolts[0]) * pstTable->dwStepInverse) >> 16);
+        if (nSegment > pstTable->byNPoints - 2)
+        {
+            nSegment = pstTable->byNPoints - 2;
+        }
+        while (nSegment > 0 && dwmV10 < awVolts[nSegment])
+        {
+            nSegment--;
+        }
+        while (nSegment < pstTable->byNPoints - 2 && dwmV10 >= awVolts[nSegment + 1])
+        {
+            nSegment++;
+        }
+    }
+    else
+    {
+        /* Last breakpoint at or below the voltage */
+        byLow = 0;
+        byHigh = (byte)(pstTable->byNPoints - 2);
+        while (byLow < byHigh)
+        {
+            byMiddle = (byte)((byLow + byHigh + 1) / 2);
+            if (awVolts[byMiddle] <= dwmV10)
+            {
+                byLow = byMiddle;
+            }
+            else
+            {
+                byHigh = (byte)(byMiddle - 1);
+            }
+        }
+        nSegment = byLow;
+    }
+
+    /* Q15 of the way along, at most 65535 * 32768 so it fits */
+    nFraction = (int32_t)(((uint32_t)(dwmV10 - awVolts[nSegment]) << 15) / (uint32_t)(awVolts[nSegment + 1] - awVolts[nSegment]));
+    nValue = pstTable->anValues[nSegment] +
+             (((int32_t)pstTable->anValues[nSegment + 1] - pstTable->anValues[nSegment]) * nFraction) / 32768;
+    return (float)nValue * pstTable->fScale + pstTable->fOffset;
+}
+
+static void CAL_reply(byte bySlot, eCalResult_t eResult)
+{
+    /* [CAL_RESP, Slot, eCalResult_t, Version1, Version0] on DEVICE_ID */
+    word wVersion = CAL_get_version(bySlot);
+    CAN_frame_t stCANFrame;
+
+    memset(&stCANFrame, 0, sizeof(stCANFrame));
+    stCANFrame.dwID = DEVICE_ID;
+    stCANFrame.byDLC = 5;
+    stCANFrame.abData[0] = CAL_RESP;
+    stCANFrame.abData[1] = bySlot;
+    stCANFrame.abData[2] = (byte)eResult;
+    stCANFrame.abData[3] = (byte)(wVersion >> 8);
+    stCANFrame.abData[4] = (byte)(wVersion & 0xFF);
+    (void)CAN_transmit(stCANBus0, &stCANFrame);
+}
@@ -0,0 +1,102 @@
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include "sfrtypes.h"
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_attr.h"
+#include "esp_rom_crc.h"
+#include "nvs_flash.h"
+#include "nvs.h"
+
+#include "adc.h"
+#include "CAN/can.h"
+
+/*  Calibration tables
+    A sensor's volts to value table lives in NVS, not the image, so a transducer recalibrated on
+    the dyno only needs its table sent. Each of CAL_MAX_TABLES slots holds one, kept in NVS as the
+    blob it arrived as under CAL_NVS_NAMESPACE "cal<slot>", and CAL_init loads every one present
+    at boot. A slot with no table, or one that fails its checks, converts to SENSOR_INVALID.
+    Loaded, a table is fixed point: breakpoints in 0.1 mV and values in 16 bits with a scale and
+    offset, 4 bytes a point against a stSensorMap_t's 12. A conversion is integer compares, a
+    multiply to find an evenly spaced segment, one divide and a multiply and add to float. The C6
+    has no FPU so that is fewer soft float calls than a sensor map.
+    Each slot has two tables. An update is written into the one not in use, then a pointer to it
+    is swapped in, so sampling and conversion never stop or wait for it. A reader that was part
+    way through when an update started goes again, see CAL_convert_batch.
+
+    Blob, little endian, made by util/CAN_calibrate.py:
+        stCalBlobHeader_t, then byNPoints uint16_t volts in 0.1 mV strictly rising, then
+        byNPoints int16_t values, then the CRC32 of everything before it.
+    A blob is refused if its CRC, magic, format or breakpoints are wrong, or its version is
+    older than the slot's table. The same version again is taken, to resend one.
+
+    Update over CAN
+    Data:   ID: CAL_DATA_ID | DEVICE_ID << CAL_NODE_SHIFT | Seq, Data: [7 bytes of blob]
+            Seq is the 7 byte chunk index. Seq 0 starts a new blob, the rest may come in any
+            order. Once every chunk of the size in the header is in, the background task checks
+            it, writes it to NVS and swaps it in.
+    Reply on DEVICE_ID:
+            [CAL_RESP, Slot, eCalResult_t, Version1, Version0], the slot's version after it
+*/
+#define CAL_MAX_TABLES          8
+#define CAL_MAX_POINTS          SENSOR_MAP_POINTS
+#define CAL_MAGIC               0x4C414353  // "SCAL"
+#define CAL_FORMAT              1
+#define CAL_MV_SCALE            10          // Breakpoint counts a mV, 6.5535 V at most
+#define CAL_MAX_BLOB            (sizeof(stCalBlobHeader_t) + CAL_MAX_POINTS * 4 + 4)
+#define CAL_NVS_NAMESPACE       "sfrcal"
+#define CAL_DATA_ID             0x1FD00000
+#define CAL_NODE_SHIFT          12
+#define CAL_SEQ_MASK            0x00000FFF
+#define CAL_CHUNK_SIZE          7
+#define CAL_RESP                0x54
+
+/* Dyno, slots of its MCP320X channels */
+#define CAL_DYNO_PRESSURE       0           // Slots 0 to 2, pDynoPressure
+#define CAL_DYNO_FLOW           3           // VDynoCoolantFlow
+#define CAL_DYNO_TEMP           4           // Slots 4 to 6, TDynoTemp
+
+typedef enum {
+    eCAL_OK = 0,
+    eCAL_BAD_CRC,
+    eCAL_BAD_TABLE,         // Magic, format, size, slot, points or breakpoints
+    eCAL_OLD_VERSION,
+    eCAL_NVS_ERROR,         // Not swapped in, the old table stays
+} eCalResult_t;
+
+/* Fixed width types as the blob is made on a PC */
+typedef struct __attribute__((packed)) {
+    uint32_t dwMagic;           // CAL_MAGIC
+    uint8_t  byFormat;          // CAL_FORMAT
+    uint8_t  bySlot;
+    uint8_t  byNPoints;         // 2 to CAL_MAX_POINTS
+    uint8_t  byReserved;
+    uint16_t wVersion;          // The table's own from the tool, 1 up
+    uint16_t wLowerLimit;       // 0.1 mV, plausible volts (SCS)
+    uint16_t wUpperLimit;
+    uint16_t wReserved;
+    float    fScale;            // Value = nValue * fScale + fOffset
+    float    fOffset;
+} stCalBlobHeader_t;
+
+typedef struct {
+    dword dwNConversions;
+    dword dwNRetries;           // Conversions gone again as an update started
+    dword dwNUpdates;           // Swapped in
+    dword dwNRejected;
+    dword dwNChunks;            // Data frames for this node
+} stCalStats_t;
+
+/* --------------------------- Function prototypes --------------------- */
+esp_err_t CAL_init(void);
+eCalResult_t CAL_update(const byte *abyBlob, word wNBytes, boolean BStore);
+float CAL_convert(byte bySlot, float fVSensor);
+void CAL_convert_batch(byte bySlot, const float *afVSensor, float *afOutput, word wNSamples);
+word CAL_get_version(byte bySlot);         // 0 if the slot has no table
+void CAL_receive(dword dwID, const byte *abyData, byte byDLC);
+esp_err_t CAL_service(void);
+void CAL_get_stats(stCalStats_t *pstStats);
+void CAL_report(void);
+
+#endif // CALIBRATION_H
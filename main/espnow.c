@@ -6,6 +6,10 @@ Written by Cole Perera for Sheffield Formula Racing 2025
 */
 
 #include "espnow.h"
+#include "espnowflash.h"
+#include "espnowtelem.h"
+#include "espnowcodec.h"
+#include "espnowlink.h"
 #include "sfrtypes.h"
 
 /* --------------------------- Local Types ----------------------------- */
@@ -36,7 +40,70 @@ typedef struct {
 } espnow_event_t;
 
 /* --------------------------- Local Variables ------------------------ */
-QueueHandle_t xESPNOWRingBuffer = NULL;
+QueueHandle_t xESPNOWPriorityBuffer = NULL;
+QueueHandle_t xESPNOWTelemBuffer = NULL;
+static boolean bTxStarted = FALSE;
+
+/* Telemetry sender, the packet being filled and the radio flow control */
+static byte abyTxPacket[MAX_ESPNOW_PAYLOAD];
+static dword dwTxOffset = ESPNOW_TELEM_HEADER_SIZE;
+static qword qwtTxOldest = 0;
+static qword qwtTxPrevious = 0;
+static volatile dword dwNTxSent = 0;
+static volatile dword dwNTxDone = 0;
+static volatile boolean BTxFailed = FALSE;
+static volatile boolean BTxDelivered = FALSE;
+static qword qwtTxLastSent = 0;
+static qword qwtTxBackoffEnd = 0;
+static dword dwTxBackoffus = 0;
+static dword dwNTxDropped = 0;
+
+/* Priority lane, its packet is filled and sent in one go */
+static byte abyPriorityPacket[MAX_ESPNOW_PAYLOAD];
+static dword dwPriorityOffset = ESPNOW_TELEM_HEADER_SIZE;
+
+/* Link adaptation, the counts are only written from the ESP-NOW callbacks */
+static stESPNOWLinkPeer_t stLinkPeer;
+static word awTxLength[ESPNOW_LINK_TX_LENGTHS];     // Packets waiting on their send callback
+static volatile dword dwNLinkDone = 0;
+static volatile dword dwNLinkDelivered = 0;
+static volatile dword dwLinkBytes = 0;
+static volatile sdword sdwLinkRSSISum = 0;
+static volatile dword dwNLinkRSSI = 0;
+static dword dwLastNLinkDone = 0;
+static dword dwLastNLinkDelivered = 0;
+static dword dwLastLinkBytes = 0;
+static sdword sdwLastLinkRSSISum = 0;
+static dword dwLastNLinkRSSI = 0;
+static qword qwtLinkSample = 0;
+static qword qwtLinkStats = 0;
+static qword qwtLinkReport = 0;
+
+/* Rx frame ring, ESPNOW_fill_buffer writes ahead of wRxFrameHead then publishes a packet at once */
+static CAN_frame_t astRxFrames[ESPNOW_RX_FRAME_RING_LENGTH];
+static volatile word wRxFrameHead = 0;
+static volatile word wRxFrameTail = 0;
+static word wRxFrameFill = 0;
+
+/* Rx path statistics, the callback times are only written from the ESP-NOW Rx callback */
+static volatile dword dwNRxCallbacks = 0;
+static volatile dword dwRxCallbackus = 0;
+static volatile dword dwRxCallbackMaxus = 0;
+static dword dwLastNRxCallbacks = 0;
+static dword dwLastRxCallbackus = 0;
+static dword dwNRxRelayed = 0;
+static dword dwNRxDropped = 0;
+
+/* Radio setting for each rate in espnowlink.h */
+static const esp_now_rate_config_t astLinkRates[eLINK_RATE_TOTAL] = {
+    { .phymode = WIFI_PHY_MODE_LR,  .rate = WIFI_PHY_RATE_LORA_250K },
+    { .phymode = WIFI_PHY_MODE_LR,  .rate = WIFI_PHY_RATE_LORA_500K },
+    { .phymode = WIFI_PHY_MODE_11B, .rate = WIFI_PHY_RATE_1M_L },
+    { .phymode = WIFI_PHY_MODE_11B, .rate = WIFI_PHY_RATE_2M_L },
+    { .phymode = WIFI_PHY_MODE_11G, .rate = WIFI_PHY_RATE_6M },
+    { .phymode = WIFI_PHY_MODE_11G, .rate = WIFI_PHY_RATE_12M },
+    { .phymode = WIFI_PHY_MODE_11G, .rate = WIFI_PHY_RATE_24M },
+};
 
 /* --------------------------- Global Variables ----------------------- */
 /*
@@ -50,14 +117,25 @@ QueueHandle_t xESPNOWRingBuffer = NULL;
 uint8_t byMACAddress[6] = {0x98, 0xA3, 0x16, 0x85, 0x6C, 0xEC}; // Change to the MAC address of target device
 
 /* --------------------------- Definitions ----------------------------- */
-#define PACKED_FRAME_SIZE 11 // 2 bytes ID + 1 byte DLC + 8 bytes data
 #define TX_ENABLE  // Comment out if TX undesired
+#define LINK_ADAPT // Comment out to stay on ESP-NOW's default rate
 
 /* --------------------------- Function prototypes --------------------- */
 esp_err_t ESPNOW_init(void);
 esp_err_t NVS_init(void);
-esp_err_t ESPNOW_fill_buffer(const byte *abyData, byte byNDataLength);
+esp_err_t ESPNOW_fill_buffer(const byte *abyData, byte byNDataLength, qword qwtRx);
 esp_err_t ESPNOW_empty_buffer(void);
+esp_err_t ESPNOW_tx_service(void);
+static boolean ESPNOW_pack_frames(qword qwtNow);
+static esp_err_t ESPNOW_send_packet(qword qwtNow);
+static esp_err_t ESPNOW_send_priority(qword qwtNow);
+static dword ESPNOW_put_frame(byte *abyPacket, dword dwOffset, const CAN_frame_t *stFrame, dword dwDelta,
+    const stESPNOWCodecFrame_t *stEncoded);
+static void ESPNOW_link_service(qword qwtNow);
+static esp_err_t ESPNOW_link_apply(void);
+static void ESPNOW_link_send_stats(void);
+static void ESPNOW_tx_backoff(qword qwtNow);
+static byte ESPNOW_varint_size(dword dwValue);
 static void ESPNOW_tx_callback(const wifi_tx_info_t *tx_info, esp_now_send_status_t eStatus);
 static void ESPNOW_rx_callback(const esp_now_recv_info_t *recv_info, const uint8_t *byData, int byNLength);
 
@@ -77,6 +155,11 @@ esp_err_t ESPNOW_init(void)
     *   Revision History:
     *   04/05/25 CP Initial Version
     *   23/11/25 CP Added FreeRTOS queue for Rxed CAN messages 
+    *   18/10/26 CP Starts the telemetry link statistics
+    *   18/10/26 CP Queue for the priority lane
+    *   18/10/26 CP Long range rates allowed, starts the link adaptation
+    *   18/10/26 CP Rxed frames go in a ring instead of a queue
+    *   18/10/26 CP Telemetry queue, only made on a node that sends
     *
     *===========================================================================
     */
@@ -100,6 +183,8 @@ esp_err_t ESPNOW_init(void)
     esp_event_loop_create_default();
     esp_wifi_init(&stWifiConfig);
     esp_wifi_set_mode(WIFI_MODE_STA);
+    /* Long range on top of the defaults, the peer needs it to hear the LR rates */
+    esp_wifi_set_protocol(WIFI_IF_STA, WIFI_PROTOCOL_11B | WIFI_PROTOCOL_11G | WIFI_PROTOCOL_11N | WIFI_PROTOCOL_LR);
     esp_wifi_set_storage(WIFI_STORAGE_RAM);
     esp_wifi_set_ps(WIFI_PS_NONE);
     eStatus = esp_wifi_start();
@@ -134,17 +219,41 @@ esp_err_t ESPNOW_init(void)
     }
     #endif
 
-    /* Allocate Ring Buffer */
-    xESPNOWRingBuffer = xQueueCreate(CAN_QUEUE_LENGTH, sizeof(CAN_frame_t));
-    if (xESPNOWRingBuffer == NULL) {
-        ESP_LOGE("ESP-NOW", "Failed to create ESPNOW Queue");
+    ESPNOW_link_init(&stLinkPeer, eLINK_RATE_1M);
+    qwtLinkSample = (qword)esp_timer_get_time();
+    qwtLinkStats = qwtLinkSample;
+    qwtLinkReport = qwtLinkSample;
+    #if defined(TX_ENABLE) && defined(LINK_ADAPT)
+    (void)ESPNOW_link_apply();
+    #endif
+
+    #ifdef TX_ENABLE
+    /* Telemetry queues, the CAN Rx callback copies frames into them once they exist */
+    xESPNOWPriorityBuffer = xQueueCreate(ESPNOW_PRIORITY_QUEUE_LENGTH, sizeof(CAN_frame_t));
+    if (xESPNOWPriorityBuffer == NULL) {
+        ESP_LOGE("ESP-NOW", "Failed to create priority Queue");
+        return ESP_ERR_NO_MEM;
+    }
+    xESPNOWTelemBuffer = xQueueCreate(ESPNOW_TELEM_QUEUE_LENGTH, sizeof(CAN_frame_t));
+    if (xESPNOWTelemBuffer == NULL) {
+        ESP_LOGE("ESP-NOW", "Failed to create telemetry Queue");
         return ESP_ERR_NO_MEM;
     }
+    #endif
+
+    eStatus = ESPNOW_telem_init();
+    if (eStatus != ESP_OK) {
+        return eStatus;
+    }
 
     /* Register Callbacks */
     esp_now_register_send_cb(ESPNOW_tx_callback);
     esp_now_register_recv_cb(ESPNOW_rx_callback);
 
+    #ifdef TX_ENABLE
+    bTxStarted = TRUE;
+    #endif
+
     return eStatus;
 }
 
@@ -190,15 +299,42 @@ static void ESPNOW_tx_callback(const wifi_tx_info_t *tx_info, esp_now_send_statu
     * 
     *   Returns: None
     * 
-    *   The callback function for when data is sent via esp now. Currently does
-    *   nothing. Do not do anything lengthy in this function.
+    *   The callback function for when data is sent via esp now. Counts the
+    *   delivered and failed packets for the link statistics and adaptation and
+    *   frees a slot for the telemetry sender. Do not do anything lengthy in
+    *   this function.
     *=========================================================================== 
     *   Revision History:
     *   06/10/25 CP Initial Version
+    *   18/10/26 CP Counts Tx success and failure
+    *   18/10/26 CP Flow control for ESPNOW_tx_service
+    *   18/10/26 CP Counts for the link adaptation
     *
     *===========================================================================
     */
 
+    (void)tx_info;
+    ESPNOW_telem_tx_done(eStatus == ESP_NOW_SEND_SUCCESS);
+
+    /* Reflash packets share the callback, only count as many as were sent */
+    if (dwNTxDone != dwNTxSent)
+    {
+        if (eStatus == ESP_NOW_SEND_SUCCESS)
+        {
+            dwNLinkDelivered++;
+            dwLinkBytes += awTxLength[dwNTxDone % ESPNOW_LINK_TX_LENGTHS];
+        }
+        dwNLinkDone++;
+        dwNTxDone++;
+    }
+    if (eStatus == ESP_NOW_SEND_SUCCESS)
+    {
+        BTxDelivered = TRUE;
+    }
+    else
+    {
+        BTxFailed = TRUE;
+    }
 }
 
 static void ESPNOW_rx_callback(const esp_now_recv_info_t *recv_info, const uint8_t *byData, int byNLength)
@@ -219,12 +355,43 @@ static void ESPNOW_rx_callback(const esp_now_recv_info_t *recv_info, const uint8
     *=========================================================================== 
     *   Revision History:
     *   06/10/25 CP Initial Version
+    *   18/10/26 CP Reflash packets passed to espnowflash.c
+    *   18/10/26 CP Telemetry packets queued for reordering in espnowtelem.c
+    *   18/10/26 CP Priority telemetry packets
+    *   18/10/26 CP RSSI of the peer for the link adaptation
+    *   18/10/26 CP Times itself for the Rx path statistics
     *
     *===========================================================================
     */
+    qword qwtStart = (qword)esp_timer_get_time();
+    dword dwTime;
 
-    ESPNOW_fill_buffer(byData, byNLength);
+    if (byNLength <= 0)
+    {
+        return;
+    }
+    if (recv_info->rx_ctrl != NULL && memcmp(recv_info->src_addr, byMACAddress, ESP_NOW_ETH_ALEN) == 0)
+    {
+        sdwLinkRSSISum += recv_info->rx_ctrl->rssi;
+        dwNLinkRSSI++;
+    }
+    if (byData[0] == ESPNOW_FLASH_PACKET)
+    {
+        ESPNOW_flash_rx(recv_info->src_addr, byData, byNLength);
+    }
+    else if (byData[0] == ESPNOW_TELEM_PACKET || byData[0] == ESPNOW_TELEM_PRIORITY_PACKET)
+    {
+        ESPNOW_telem_rx(byData, byNLength);
+    }
 
+    /* Time spent in the Wi-Fi task */
+    dwTime = (dword)((qword)esp_timer_get_time() - qwtStart);
+    dwRxCallbackus += dwTime;
+    dwNRxCallbacks++;
+    if (dwTime > dwRxCallbackMaxus)
+    {
+        dwRxCallbackMaxus = dwTime;
+    }
 }
 
 esp_err_t ESPNOW_empty_buffer(void)
@@ -236,130 +403,932 @@ esp_err_t ESPNOW_empty_buffer(void)
     * 
     *   Returns: eStatus - ESP_OK if successful, error code if not.
     * 
-    *   Empties the CAN ring buffer by packing as many CAN frames as possible
-    *   into a single ESP-NOW packet (250 bytes) and sending it. If there are no
-    *   frames to send, it returns ESP_OK. Each CAN frame takes 11 bytes in the
-    *   ESP-NOW packet (2 bytes ID, 1 byte DLC, 8 bytes data). The ring buffer is
-    *   115 frames in total so it can take up to 3 ESP-NOW packets to empty
-    *   the buffer if it is full. This function only sends one ESP-NOW packet per
-    *   call, it is intended to be run once per 100ms or so.
+    *   Packs as many CAN frames from the telemetry queue as fit into the
+    *   pending ESP-NOW packet (250 bytes) and sends it straight away, full or
+    *   not. If there are no frames to send, it returns ESP_OK. The packet starts
+    *   with a sequence number and the Rx time of the first frame, see
+    *   espnowtelem.h. Each CAN frame takes a 2 byte header (5 bytes for a 29 bit
+    *   ID), the time since the previous frame then its data, see espnow.h. Only
+    *   sends one packet per call, ESPNOW_tx_service is the normal way to send.
+    *   Priority frames waiting are sent first in their own packet.
     * 
     *=========================================================================== 
     *   Revision History:
     *   08/10/25 CP Initial Version
     *   23/11/25 CP Changed to use FreeRTOS queue instead of ring buffer, refactored
+    *   18/10/26 CP Variable length header carrying 29 bit IDs, DLC 0 frames allowed
+    *   18/10/26 CP Sequenced packets with per frame Rx times
+    *   18/10/26 CP Packing split out so ESPNOW_tx_service can fill a packet over several calls
+    *   18/10/26 CP Priority lane
+    *   18/10/26 CP Own telemetry queue, only once ESP-NOW has started
+    *
+    *===========================================================================
+    */
+
+    qword qwtNow = (qword)esp_timer_get_time();
+
+    if (!bTxStarted) 
+    {
+        return ESP_ERR_INVALID_STATE;
+    } 
+    (void)ESPNOW_send_priority(qwtNow);
+
+    (void)ESPNOW_pack_frames(qwtNow);
+
+    /* If data is present send it otherwise return ESP_OK */
+    if (dwTxOffset > ESPNOW_TELEM_HEADER_SIZE) 
+    {
+        return ESPNOW_send_packet(qwtNow);
+    }
+    
+    return ESP_OK;
+}
+
+esp_err_t ESPNOW_tx_service(void)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_tx_service
+    *   Takes:   None
+    * 
+    *   Returns: eStatus - ESP_OK if successful, error code if not.
+    * 
+    *   Telemetry sender, call as often as possible from the background task.
+    *   Moves frames from the telemetry queue into the pending packet and sends
+    *   it when it is full or its oldest frame is ESPNOW_TX_DEADLINE_US old, as
+    *   many packets as the radio will take. The send callback is the flow
+    *   control, at most ESPNOW_TX_WINDOW packets are waiting on it at once.
+    *   After a failed send the radio is left alone for a back off time that
+    *   doubles on each failure and clears when a packet is delivered, and
+    *   every ID is sent whole again as the pits dropped their references.
+    *   Priority frames go first, see espnow.h. The PHY rate follows the link,
+    *   see espnowlink.h. Does nothing until ESP-NOW has started on a node
+    *   that sends, see espnow.h.
+    * 
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Keyframes after a failed send
+    *   18/10/26 CP Priority lane
+    *   18/10/26 CP Link adaptation
+    *   18/10/26 CP Own telemetry queue, only once ESP-NOW has started
+    *
+    *===========================================================================
+    */
+
+    qword qwtNow;
+    boolean BFull;
+    esp_err_t eStatus;
+
+    if (!bTxStarted) 
+    {
+        return ESP_OK;
+    }
+    qwtNow = (qword)esp_timer_get_time();
+
+    /* What the radio said about the last packets */
+    if (BTxFailed)
+    {
+        BTxFailed = FALSE;
+        BTxDelivered = FALSE;
+        ESPNOW_tx_backoff(qwtNow);
+        ESPNOW_codec_reset_tx();
+    }
+    else if (BTxDelivered)
+    {
+        BTxDelivered = FALSE;
+        dwTxBackoffus = 0;
+    }
+    if (dwNTxSent != dwNTxDone && qwtNow - qwtTxLastSent > ESPNOW_TX_DONE_TIMEOUT_US)
+    {
+        ESP_LOGW("ESP-NOW", "No send callback for %lu packets", (unsigned long)(dwNTxSent - dwNTxDone));
+        dwNTxDone = dwNTxSent;
+    }
+    ESPNOW_link_service(qwtNow);
+
+    /* Priority lane, a radio full for it is tried again on the next call */
+    eStatus = ESPNOW_send_priority(qwtNow);
+    if (eStatus != ESP_OK && eStatus != ESP_ERR_ESPNOW_NO_MEM)
+    {
+        return eStatus;
+    }
+
+    while (TRUE)
+    {
+        BFull = ESPNOW_pack_frames(qwtNow);
+        if (dwTxOffset == ESPNOW_TELEM_HEADER_SIZE)
+        {
+            /* Nothing waiting */
+            return ESP_OK;
+        }
+        if (!BFull && qwtNow - qwtTxOldest < ESPNOW_TX_DEADLINE_US)
+        {
+            /* Give it time to fill */
+            return ESP_OK;
+        }
+        if (dwNTxSent - dwNTxDone >= ESPNOW_TX_WINDOW || qwtNow < qwtTxBackoffEnd)
+        {
+            /* Radio busy, frames wait in the telemetry queue */
+            return ESP_OK;
+        }
+        eStatus = ESPNOW_send_packet(qwtNow);
+        if (eStatus != ESP_OK)
+        {
+            return eStatus;
+        }
+    }
+}
+
+static boolean ESPNOW_pack_frames(qword qwtNow)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_pack_frames
+    *   Takes:   qwtNow - current time in us
+    * 
+    *   Returns: TRUE if the pending packet is full, FALSE if more frames fit.
+    * 
+    *   Moves frames from the telemetry queue into the pending packet until the
+    *   queue is empty or the next frame does not fit. The first frame sets
+    *   the packet's base time, each after it carries the time since the last.
+    *   Frames are rate limited and delta compressed per ID, see espnowcodec.h.
+    *   Frames with an invalid DLC are dropped.
+    * 
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version, split from ESPNOW_empty_buffer
+    *   18/10/26 CP Per ID rate limit and delta frames
+    *   18/10/26 CP Frames written by ESPNOW_put_frame
+    *   18/10/26 CP Own telemetry queue
     *
     *===========================================================================
     */
 
-    byte byBytesToSend[MAX_ESPNOW_PAYLOAD];
-    dword dwOffset = 0;
     CAN_frame_t stCANFrame;
+    stESPNOWCodecFrame_t stEncoded;
+    qword qwtFrame;
+    dword dwDelta;
+    byte byDataSize;
+
+    if (abyTxPacket[0] == ESPNOW_TELEM_PACKET)
+    {
+        /* Sealed waiting for the radio, the header is written */
+        return TRUE;
+    }
+
+    /* Until the queue is empty or the next frame does not fit, pack the message */ 
+    while (xQueuePeek(xESPNOWTelemBuffer, &stCANFrame, 0) == pdTRUE)
+    {
+        byte byDLC = stCANFrame.byDLC;
+        byte byHeaderSize = stCANFrame.dwID > 0x7FF ? ESPNOW_EXT_HEADER_SIZE : ESPNOW_STD_HEADER_SIZE;
+
+        if (byDLC > 8) 
+        {
+            xQueueReceive(xESPNOWTelemBuffer, &stCANFrame, 0);
+            ESP_LOGE("ESP-NOW", "Invalid CAN frame DLC: %u", byDLC);
+            continue;
+        }
+
+        /* Frames come out of the queue in Rx order, the first sets the packet base time */
+        qwtFrame = CAN_get_rx_time(&stCANFrame, qwtNow);
+        ESPNOW_codec_encode(&stCANFrame, qwtFrame, &stEncoded);
+        if (stEncoded.eType == eCODEC_DROP)
+        {
+            /* Over its ID's rate */
+            xQueueReceive(xESPNOWTelemBuffer, &stCANFrame, 0);
+            continue;
+        }
+        byDataSize = stEncoded.eType == eCODEC_DELTA ? (byte)(1 + stEncoded.byNChanged) : byDLC;
+
+        if (dwTxOffset == ESPNOW_TELEM_HEADER_SIZE)
+        {
+            qwtTxPrevious = qwtFrame;
+        }
+        dwDelta = qwtFrame > qwtTxPrevious ? (dword)(qwtFrame - qwtTxPrevious) : 0;
+
+        if (dwTxOffset + byHeaderSize + ESPNOW_varint_size(dwDelta) + byDataSize > MAX_ESPNOW_PAYLOAD)
+        {
+            /* Leave it for the next packet */
+            return TRUE;
+        }
+        xQueueReceive(xESPNOWTelemBuffer, &stCANFrame, 0);
+        ESPNOW_codec_sent(&stCANFrame, qwtFrame, &stEncoded);
+        if (dwTxOffset == ESPNOW_TELEM_HEADER_SIZE)
+        {
+            abyTxPacket[4] = (byte)(qwtFrame >> 24);
+            abyTxPacket[5] = (byte)(qwtFrame >> 16);
+            abyTxPacket[6] = (byte)(qwtFrame >> 8);
+            abyTxPacket[7] = (byte)qwtFrame;
+            qwtTxOldest = qwtFrame;
+        }
+        qwtTxPrevious = qwtFrame;
+        dwTxOffset = ESPNOW_put_frame(abyTxPacket, dwTxOffset, &stCANFrame, dwDelta, &stEncoded);
+    }
+
+    /* Full if not even the smallest frame fits */
+    return dwTxOffset + ESPNOW_STD_HEADER_SIZE + 1 > MAX_ESPNOW_PAYLOAD;
+}
+
+static esp_err_t ESPNOW_send_packet(qword qwtNow)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_send_packet
+    *   Takes:   qwtNow - current time in us
+    * 
+    *   Returns: eStatus - ESP_OK if the radio took the packet or it was
+    *            dropped, error code if it should be tried again later.
+    * 
+    *   Writes the header of the pending packet and hands it to the radio. If
+    *   the radio is out of buffers the packet is kept, with the same sequence
+    *   number, and sent after the back off. Any other error drops it, only
+    *   the first of a run of drops is logged.
+    * 
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Logs the first drop of a run
+    *
+    *===========================================================================
+    */
+
+    esp_err_t eStatus;
+    word wSeq;
+
+    if (abyTxPacket[0] != ESPNOW_TELEM_PACKET)
+    {
+        wSeq = ESPNOW_telem_next_seq(eTELEM_LANE_BULK);
+        abyTxPacket[0] = ESPNOW_TELEM_PACKET;
+        abyTxPacket[1] = DEVICE_ID;
+        abyTxPacket[2] = (byte)(wSeq >> 8);
+        abyTxPacket[3] = (byte)wSeq;
+    }
 
-    for (byte NLoopCounter = 0; NLoopCounter < MAX_ESPNOW_PAYLOAD; NLoopCounter++) 
+    awTxLength[dwNTxSent % ESPNOW_LINK_TX_LENGTHS] = (word)dwTxOffset;
+    eStatus = esp_now_send(byMACAddress, abyTxPacket, dwTxOffset);
+    if (eStatus == ESP_ERR_ESPNOW_NO_MEM)
     {
-        byBytesToSend[NLoopCounter] = 0;
+        /* Radio saturated, keep the packet */
+        ESPNOW_tx_backoff(qwtNow);
+        return eStatus;
+    }
+    if (eStatus == ESP_OK)
+    {
+        dwNTxSent++;
+        qwtTxLastSent = qwtNow;
+        if (dwNTxDropped > 0)
+        {
+            ESP_LOGW("ESP-NOW", "%lu telemetry packets dropped", (unsigned long)dwNTxDropped);
+            dwNTxDropped = 0;
+        }
+    }
+    else if (dwNTxDropped++ == 0)
+    {
+        ESP_LOGE("ESP-NOW", "Telemetry packet dropped: %s", esp_err_to_name(eStatus));
     }
 
-    if (!xCANRingBuffer) 
+    /* Start the next packet */
+    abyTxPacket[0] = 0;
+    dwTxOffset = ESPNOW_TELEM_HEADER_SIZE;
+    return eStatus;
+}
+
+static esp_err_t ESPNOW_send_priority(qword qwtNow)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_send_priority
+    *   Takes:   qwtNow - current time in us
+    * 
+    *   Returns: eStatus - ESP_OK if the radio took the packet, there was
+    *            nothing to send or it was dropped, error code if it should be
+    *            tried again later.
+    * 
+    *   Packs the frames waiting in the priority queue, whole, into a packet of
+    *   their own and hands it to the radio straight away. It may use the
+    *   ESPNOW_TX_PRIORITY_SLOTS slots the bulk packets leave free and does not
+    *   wait for the back off. If the radio is out of buffers the packet is
+    *   kept and sent on the next call.
+    * 
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+
+    CAN_frame_t stCANFrame;
+    stESPNOWCodecFrame_t stEncoded = { .eType = eCODEC_KEYFRAME, .wEntry = ESPNOW_CODEC_NO_ENTRY };
+    qword qwtFrame;
+    qword qwtPrevious = 0;
+    esp_err_t eStatus;
+    word wSeq;
+
+    if (!xESPNOWPriorityBuffer)
     {
         return ESP_ERR_INVALID_STATE;
-    } 
+    }
 
-    /* Until the ring buffer is empty or the ESP-NOW message is full, pack the message */ 
-    while (dwOffset + PACKED_FRAME_SIZE <= MAX_ESPNOW_PAYLOAD && xQueueReceive(xCANRingBuffer, &stCANFrame, 0) == pdTRUE)
+    if (abyPriorityPacket[0] != ESPNOW_TELEM_PRIORITY_PACKET)
     {
-        uint8_t byDLC = stCANFrame.byDLC;
-        if (byDLC > 8 || byDLC < 1) 
+        while (dwPriorityOffset + ESPNOW_TELEM_MAX_FRAME_SIZE <= MAX_ESPNOW_PAYLOAD &&
+            xQueueReceive(xESPNOWPriorityBuffer, &stCANFrame, 0) == pdTRUE)
         {
-            ESP_LOGE("ESP-NOW", "Invalid CAN frame DLC: %u", byDLC);
-            break;
+            if (stCANFrame.byDLC > 8)
+            {
+                ESP_LOGE("ESP-NOW", "Invalid CAN frame DLC: %u", stCANFrame.byDLC);
+                continue;
+            }
+            qwtFrame = CAN_get_rx_time(&stCANFrame, qwtNow);
+            if (dwPriorityOffset == ESPNOW_TELEM_HEADER_SIZE)
+            {
+                abyPriorityPacket[4] = (byte)(qwtFrame >> 24);
+                abyPriorityPacket[5] = (byte)(qwtFrame >> 16);
+                abyPriorityPacket[6] = (byte)(qwtFrame >> 8);
+                abyPriorityPacket[7] = (byte)qwtFrame;
+                qwtPrevious = qwtFrame;
+            }
+            dwPriorityOffset = ESPNOW_put_frame(abyPriorityPacket, dwPriorityOffset, &stCANFrame,
+                qwtFrame > qwtPrevious ? (dword)(qwtFrame - qwtPrevious) : 0, &stEncoded);
+            qwtPrevious = qwtFrame;
         }
+        if (dwPriorityOffset == ESPNOW_TELEM_HEADER_SIZE)
+        {
+            /* Nothing waiting */
+            return ESP_OK;
+        }
+        wSeq = ESPNOW_telem_next_seq(eTELEM_LANE_PRIORITY);
+        abyPriorityPacket[0] = ESPNOW_TELEM_PRIORITY_PACKET;
+        abyPriorityPacket[1] = DEVICE_ID;
+        abyPriorityPacket[2] = (byte)(wSeq >> 8);
+        abyPriorityPacket[3] = (byte)wSeq;
+    }
 
-        byBytesToSend[dwOffset + 0] = (byte)((stCANFrame.dwID >> 8) & 0xFF);
-        byBytesToSend[dwOffset + 1] = (byte)(stCANFrame.dwID & 0xFF);
-        byBytesToSend[dwOffset + 2] = (byte)byDLC;
-        memcpy(&byBytesToSend[dwOffset + 3], stCANFrame.abData, byDLC);
-        dwOffset += 3 + byDLC; // 2 bytes ID + 1 byte DLC + 1-8 bytes data
+    if (dwNTxSent - dwNTxDone >= ESPNOW_TX_WINDOW + ESPNOW_TX_PRIORITY_SLOTS)
+    {
+        return ESP_ERR_ESPNOW_NO_MEM;
+    }
+    awTxLength[dwNTxSent % ESPNOW_LINK_TX_LENGTHS] = (word)dwPriorityOffset;
+    eStatus = esp_now_send(byMACAddress, abyPriorityPacket, dwPriorityOffset);
+    if (eStatus == ESP_ERR_ESPNOW_NO_MEM)
+    {
+        /* Radio saturated, keep the packet */
+        return eStatus;
+    }
+    if (eStatus == ESP_OK)
+    {
+        dwNTxSent++;
+        qwtTxLastSent = qwtNow;
+    }
+    else
+    {
+        ESP_LOGE("ESP-NOW", "Priority packet dropped: %s", esp_err_to_name(eStatus));
     }
 
-    /* If data is present send it otherwise return ESP_OK */
-    if (dwOffset > 0) 
+    /* Start the next packet */
+    abyPriorityPacket[0] = 0;
+    dwPriorityOffset = ESPNOW_TELEM_HEADER_SIZE;
+    return eStatus;
+}
+
+static dword ESPNOW_put_frame(byte *abyPacket, dword dwOffset, const CAN_frame_t *stFrame, dword dwDelta,
+    const stESPNOWCodecFrame_t *stEncoded)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_put_frame
+    *   Takes:   abyPacket - packet being filled
+    *            dwOffset - where the frame goes, the caller has checked it fits
+    *            stFrame - frame to write
+    *            dwDelta - us since the previous frame in the packet
+    *            stEncoded - how to send it, from ESPNOW_codec_encode
+    * 
+    *   Returns: Offset after the frame.
+    * 
+    *   Writes a frame's header, time and data, see espnow.h. A delta frame
+    *   carries its mask and changed bytes in place of the data.
+    * 
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version, split from ESPNOW_pack_frames
+    *
+    *===========================================================================
+    */
+
+    byte byDLC = stEncoded->eType == eCODEC_DELTA ? ESPNOW_FRAME_DLC_DELTA : stFrame->byDLC;
+
+    if (stFrame->dwID > 0x7FF)
     {
-        return esp_now_send(byMACAddress, byBytesToSend, dwOffset);
+        abyPacket[dwOffset + 0] = (byte)(ESPNOW_FRAME_EXTENDED | (byDLC << ESPNOW_FRAME_DLC_SHIFT));
+        abyPacket[dwOffset + 1] = (byte)((stFrame->dwID >> 24) & 0x1F);
+        abyPacket[dwOffset + 2] = (byte)((stFrame->dwID >> 16) & 0xFF);
+        abyPacket[dwOffset + 3] = (byte)((stFrame->dwID >> 8) & 0xFF);
+        abyPacket[dwOffset + 4] = (byte)(stFrame->dwID & 0xFF);
+        dwOffset += ESPNOW_EXT_HEADER_SIZE;
+    }
+    else
+    {
+        abyPacket[dwOffset + 0] = (byte)((byDLC << ESPNOW_FRAME_DLC_SHIFT) | ((stFrame->dwID >> 8) & 0x07));
+        abyPacket[dwOffset + 1] = (byte)(stFrame->dwID & 0xFF);
+        dwOffset += ESPNOW_STD_HEADER_SIZE;
+    }
+
+    /* Time since the previous frame, 7 bits a byte */
+    do
+    {
+        abyPacket[dwOffset] = (byte)(dwDelta & 0x7F);
+        dwDelta >>= 7;
+        if (dwDelta != 0)
+        {
+            abyPacket[dwOffset] |= 0x80;
+        }
+        dwOffset++;
+    } while (dwDelta != 0);
+
+    if (stEncoded->eType == eCODEC_DELTA)
+    {
+        abyPacket[dwOffset] = stEncoded->byMask;
+        memcpy(&abyPacket[dwOffset + 1], stEncoded->abyXOR, stEncoded->byNChanged);
+        return dwOffset + 1 + stEncoded->byNChanged;
+    }
+    memcpy(&abyPacket[dwOffset], stFrame->abData, stFrame->byDLC);
+    return dwOffset + stFrame->byDLC;
+}
+
+static void ESPNOW_link_service(qword qwtNow)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_link_service
+    *   Takes:   qwtNow - current time in us
+    * 
+    *   Returns: None
+    * 
+    *   Every ESPNOW_LINK_SAMPLE_MS passes what the callbacks counted to
+    *   espnowlink.c and moves the radio to the rate it picks. Sends the link
+    *   stats frame every ESPNOW_TELEM_STATS_PERIOD_MS and logs the goodput of
+    *   each rate every ESPNOW_LINK_REPORT_MS.
+    * 
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+
+    stESPNOWLinkSample_t stSample;
+    dword dwNDone = dwNLinkDone;
+    dword dwNDelivered = dwNLinkDelivered;
+    dword dwBytes = dwLinkBytes;
+    sdword sdwRSSISum = sdwLinkRSSISum;
+    dword dwNRSSI = dwNLinkRSSI;
+    eESPNOWLinkRate_t eOldRate = stLinkPeer.eRate;
+
+    if (qwtNow - qwtLinkSample < (qword)ESPNOW_LINK_SAMPLE_MS * 1000)
+    {
+        return;
+    }
+
+    stSample.wNSent = (word)(dwNDone - dwLastNLinkDone);
+    stSample.wNDelivered = (word)(dwNDelivered - dwLastNLinkDelivered);
+    stSample.dwNBytes = dwBytes - dwLastLinkBytes;
+    stSample.sbyRSSI = dwNRSSI != dwLastNLinkRSSI ?
+        (sbyte)((sdwRSSISum - sdwLastLinkRSSISum) / (sdword)(dwNRSSI - dwLastNLinkRSSI)) : ESPNOW_LINK_NO_RSSI;
+    dwLastNLinkDone = dwNDone;
+    dwLastNLinkDelivered = dwNDelivered;
+    dwLastLinkBytes = dwBytes;
+    sdwLastLinkRSSISum = sdwRSSISum;
+    dwLastNLinkRSSI = dwNRSSI;
+
+    if (ESPNOW_link_update(&stLinkPeer, &stSample, (word)((qwtNow - qwtLinkSample) / 1000)))
+    {
+        #if defined(TX_ENABLE) && defined(LINK_ADAPT)
+        ESP_LOGI("ESP-NOW", "Link %s to %s, %u %% delivered, RSSI %d", ESPNOW_link_rate_name(eOldRate),
+            ESPNOW_link_rate_name(stLinkPeer.eRate), stLinkPeer.byDeliveryPercent, stLinkPeer.sbyRSSI);
+        (void)ESPNOW_link_apply();
+        #else
+        /* Watching only */
+        stLinkPeer.eRate = eOldRate;
+        #endif
+    }
+    qwtLinkSample = qwtNow;
+
+    if (qwtNow - qwtLinkStats >= (qword)ESPNOW_TELEM_STATS_PERIOD_MS * 1000)
+    {
+        qwtLinkStats = qwtNow;
+        ESPNOW_link_send_stats();
+    }
+    if (qwtNow - qwtLinkReport >= (qword)ESPNOW_LINK_REPORT_MS * 1000)
+    {
+        qwtLinkReport = qwtNow;
+        for (byte byRate = 0; byRate < eLINK_RATE_TOTAL; byRate++)
+        {
+            if (stLinkPeer.adwTimems[byRate] > 0)
+            {
+                ESP_LOGI("ESP-NOW", "Link %-7s %6lu B/s over %lu s, %lu of %lu delivered",
+                    ESPNOW_link_rate_name(byRate), (unsigned long)ESPNOW_link_goodput(&stLinkPeer, byRate),
+                    (unsigned long)(stLinkPeer.adwTimems[byRate] / 1000),
+                    (unsigned long)stLinkPeer.adwNDelivered[byRate], (unsigned long)stLinkPeer.adwNSent[byRate]);
+            }
+        }
     }
-    
-    return ESP_OK;
 }
 
-esp_err_t ESPNOW_fill_buffer(const byte *abyData, byte byNDataLength)
+static esp_err_t ESPNOW_link_apply(void)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_link_apply
+    *   Takes:   None
+    * 
+    *   Returns: eStatus - ESP_OK if successful, error code if not.
+    * 
+    *   Sets the telemetry peer's PHY rate to the link's.
+    * 
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+
+    esp_now_rate_config_t stRateConfig = astLinkRates[stLinkPeer.eRate];
+    esp_err_t eStatus = esp_now_set_peer_rate_config(byMACAddress, &stRateConfig);
+
+    if (eStatus != ESP_OK)
+    {
+        ESP_LOGE("ESP-NOW", "Failed to set link rate %s: %s", ESPNOW_link_rate_name(stLinkPeer.eRate),
+            esp_err_to_name(eStatus));
+    }
+    return eStatus;
+}
+
+static void ESPNOW_link_send_stats(void)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_link_send_stats
+    *   Takes:   None
+    * 
+    *   Returns: None
+    * 
+    *   Sends ESPNOW_TELEM_LINK_ID in the telemetry, see espnowtelem.h.
+    * 
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+
+    CAN_frame_t stFrame;
+    dword dwGoodput = ESPNOW_link_goodput(&stLinkPeer, stLinkPeer.eRate) / 100;
+
+    if (xESPNOWTelemBuffer == NULL || stLinkPeer.adwNSent[stLinkPeer.eRate] == 0)
+    {
+        return;
+    }
+    memset(&stFrame, 0, sizeof(stFrame));
+    stFrame.dwID = ESPNOW_TELEM_LINK_ID;
+    stFrame.byDLC = 8;
+    stFrame.abData[0] = (byte)stLinkPeer.eRate;
+    stFrame.abData[1] = stLinkPeer.byDeliveryPercent;
+    stFrame.abData[2] = (byte)stLinkPeer.sbyRSSI;
+    stFrame.abData[3] = (byte)((dwGoodput > 0xFFFF ? 0xFFFF : dwGoodput) >> 8);
+    stFrame.abData[4] = (byte)(dwGoodput > 0xFFFF ? 0xFFFF : dwGoodput);
+    stFrame.abData[5] = (byte)(stLinkPeer.dwNChanges > 0xFF ? 0xFF : stLinkPeer.dwNChanges);
+    CAN_set_rx_time(&stFrame, (qword)esp_timer_get_time());
+    (void)xQueueSend(xESPNOWTelemBuffer, &stFrame, 0);
+}
+
+static void ESPNOW_tx_backoff(qword qwtNow)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_tx_backoff
+    *   Takes:   qwtNow - current time in us
+    * 
+    *   Returns: None
+    * 
+    *   Doubles the time the sender leaves the radio alone, up to
+    *   ESPNOW_TX_BACKOFF_MAX_US.
+    * 
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+
+    if (dwTxBackoffus == 0)
+    {
+        dwTxBackoffus = ESPNOW_TX_BACKOFF_MIN_US;
+    }
+    else if (dwTxBackoffus < ESPNOW_TX_BACKOFF_MAX_US)
+    {
+        dwTxBackoffus *= 2;
+    }
+    qwtTxBackoffEnd = qwtNow + dwTxBackoffus;
+}
+
+esp_err_t ESPNOW_fill_buffer(const byte *abyData, byte byNDataLength, qword qwtRx)
 {
     /*
     *===========================================================================
     *   ESPNOW_fill_buffer
-    *   Takes:   abData - pointer to data Rxed over ESP-NOW
+    *   Takes:   abData - pointer to a telemetry packet Rxed over ESP-NOW
     *            byNDataLength - length of data Rxed
+    *            qwtRx - time the packet was Rxed in us
     * 
     *   Returns: None
     * 
-    *   Processes data received over ESP-NOW and adds it to the CAN ring buffer.
-    *   The ring buffer is intended to be emptied by a seperate CAN task. If the
-    *   buffer is full (or not initialised) the message will be dropped.
+    *   Processes data received over ESP-NOW and adds it to the Rx frame ring
+    *   for CAN_empty_ESPNOW_buffer. If the ring is full the frame is dropped.
+    *   Called by espnowtelem.c once the packet is in order, each frame's Rx
+    *   time on the sender is passed back for the latency statistics. Delta
+    *   frames are rebuilt from the last frame of their ID, see espnowcodec.h,
+    *   so every frame is decoded even when the ring is full. Frames are
+    *   decoded in place and the packet's are published together.
     * 
     *=========================================================================== 
     *   Revision History:
     *   15/10/25 CP Initial Version
     *   03/11/25 CP Fixed the way this was writing to the ring buffer, god what a nightmare
     *   23/11/25 CP Changed to use FreeRTOS queue instead of ring buffer, refactored
+    *   18/10/26 CP Decodes the variable length header, see espnow.h
+    *   18/10/26 CP Skips the packet header and decodes the frame times
+    *   18/10/26 CP Decodes delta frames
+    *   18/10/26 CP Latency kept for each lane
+    *   18/10/26 CP Decodes into the Rx frame ring, no queue send or memset per frame
     *
     *===========================================================================
     */
 
-    volatile uint16_t wOffset = 0;
-    CAN_frame_t stFrame;
+    word wOffset = ESPNOW_TELEM_HEADER_SIZE;
+    byte byHeaderSize;
+    byte byShift;
+    byte byMask;
+    byte byNChanged;
+    dword dwDelta;
+    dword dwFrameTime;
+    CAN_frame_t *stFrame;
+    CAN_frame_t stDropped;
+    esp_err_t eStatus;
+    eESPNOWTelemLane_t eLane;
 
-    if (byNDataLength <= 0) 
+    if (byNDataLength <= ESPNOW_TELEM_HEADER_SIZE) 
     {
         return ESP_OK;
     }
-
-    if (!xESPNOWRingBuffer) 
-    {
-        return ESP_ERR_INVALID_STATE;
-    }
+    eLane = abyData[0] == ESPNOW_TELEM_PRIORITY_PACKET ? eTELEM_LANE_PRIORITY : eTELEM_LANE_BULK;
+    dwFrameTime = ((dword)abyData[4] << 24) | ((dword)abyData[5] << 16) |
+                  ((dword)abyData[6] << 8)  | ((dword)abyData[7]);
 
     while (wOffset < byNDataLength) {
-        /* Ensure at least ID(2) + DLC(1) remain */
-        if (byNDataLength - wOffset < 3) break;
- 
-        memset(&stFrame, 0, sizeof(CAN_frame_t));
-        stFrame.dwID = ((uint32_t)abyData[wOffset] << 8)  |
-                        ((uint32_t)abyData[wOffset + 1]);
-        wOffset += 2;
-        stFrame.byDLC = abyData[wOffset];
-        wOffset += 1;
-        
-        if (stFrame.byDLC > 8) 
+        /* Ensure the whole header remains */
+        byHeaderSize = (abyData[wOffset] & ESPNOW_FRAME_EXTENDED) ? ESPNOW_EXT_HEADER_SIZE : ESPNOW_STD_HEADER_SIZE;
+        if (byNDataLength - wOffset < byHeaderSize) break;
+
+        /* Decode straight into the ring, a full ring still decodes to keep the delta references */
+        if ((word)(wRxFrameFill - wRxFrameTail) < ESPNOW_RX_FRAME_RING_LENGTH)
+        {
+            stFrame = &astRxFrames[wRxFrameFill % ESPNOW_RX_FRAME_RING_LENGTH];
+        }
+        else
+        {
+            stFrame = &stDropped;
+        }
+        stFrame->byDLC = (abyData[wOffset] >> ESPNOW_FRAME_DLC_SHIFT) & 0x0F;
+        if (byHeaderSize == ESPNOW_EXT_HEADER_SIZE)
         {
-            //Invalid DLC, drop frame
-            break;
+            stFrame->dwID = ((uint32_t)(abyData[wOffset + 1] & 0x1F) << 24) |
+                            ((uint32_t)abyData[wOffset + 2] << 16) |
+                            ((uint32_t)abyData[wOffset + 3] << 8)  |
+                            ((uint32_t)abyData[wOffset + 4]);
         }
-        if (byNDataLength - wOffset < stFrame.byDLC) {
-            /* Truncated frame, drop frame */
-            break;
+        else
+        {
+            stFrame->dwID = ((uint32_t)(abyData[wOffset] & 0x07) << 8) |
+                            ((uint32_t)abyData[wOffset + 1]);
         }
+        wOffset += byHeaderSize;
 
-        if (stFrame.byDLC > 0)
+        /* Time since the previous frame */
+        dwDelta = 0;
+        byShift = 0;
+        while (wOffset < byNDataLength && byShift < 7 * ESPNOW_TELEM_MAX_DELTA_SIZE)
+        {
+            dwDelta |= (dword)(abyData[wOffset] & 0x7F) << byShift;
+            byShift += 7;
+            if ((abyData[wOffset++] & 0x80) == 0)
+            {
+                break;
+            }
+        }
+        dwFrameTime = (dwFrameTime + dwDelta) & 0xFFFFFFFF;
+        
+        if (stFrame->byDLC == ESPNOW_FRAME_DLC_DELTA)
         {
-            memcpy(stFrame.abData, &abyData[wOffset], stFrame.byDLC);
-            wOffset += stFrame.byDLC;
+            /* Mask then the changed bytes */
+            if (wOffset >= byNDataLength)
+            {
+                ESPNOW_codec_reset_rx();
+                break;
+            }
+            byMask = abyData[wOffset++];
+            byNChanged = 0;
+            for (byte byBit = 0; byBit < 8; byBit++)
+            {
+                byNChanged += (byMask >> byBit) & 0x01;
+            }
+            if (byNDataLength - wOffset < byNChanged)
+            {
+                ESPNOW_codec_reset_rx();
+                break;
+            }
+            eStatus = ESPNOW_codec_decode(stFrame, byMask, &abyData[wOffset]);
+            wOffset += byNChanged;
+            if (eStatus != ESP_OK)
+            {
+                /* Joined mid-stream or lost a packet, wait for the keyframe */
+                continue;
+            }
         }
+        else
+        {
+            if (stFrame->byDLC > 8 || byNDataLength - wOffset < stFrame->byDLC) 
+            {
+                /* Invalid DLC or truncated, the rest of the packet is lost */
+                ESPNOW_codec_reset_rx();
+                break;
+            }
+            if (stFrame->byDLC > 0)
+            {
+                memcpy(stFrame->abData, &abyData[wOffset], stFrame->byDLC);
+                wOffset += stFrame->byDLC;
+            }
+            ESPNOW_codec_keyframe(stFrame);
+        }
+        ESPNOW_telem_frame_latency(eLane, dwFrameTime, qwtRx);
+        CAN_set_rx_time(stFrame, qwtRx);
 
-        if (xQueueSend(xESPNOWRingBuffer, &stFrame, 0) != pdTRUE) 
+        if (stFrame == &stDropped)
+        {
+            dwNRxDropped++;
+        }
+        else
         {
-            /* Buffer full, drop frames */
-            break;
+            wRxFrameFill++;
         }
     }
+
+    /* Publish the packet's frames to CAN_empty_ESPNOW_buffer */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    wRxFrameHead = wRxFrameFill;
     return ESP_OK;
 }
+
+void ESPNOW_rx_frame_put(const CAN_frame_t *stFrame)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_rx_frame_put
+    *   Takes:   stFrame - frame to put on the bus
+    *
+    *   Returns: None
+    *
+    *   Adds a frame made on this node, the telemetry statistics, to the Rx
+    *   frame ring. Dropped if the ring is full. Only call from the task that
+    *   runs ESPNOW_telem_service.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    if ((word)(wRxFrameFill - wRxFrameTail) >= ESPNOW_RX_FRAME_RING_LENGTH)
+    {
+        dwNRxDropped++;
+        return;
+    }
+    astRxFrames[wRxFrameFill % ESPNOW_RX_FRAME_RING_LENGTH] = *stFrame;
+    wRxFrameFill++;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    wRxFrameHead = wRxFrameFill;
+}
+
+word ESPNOW_rx_frames_peek(const CAN_frame_t **pastFrames)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_rx_frames_peek
+    *   Takes:   pastFrames - set to the oldest frame waiting
+    *
+    *   Returns: Frames waiting in a run from *pastFrames, stops at the end of
+    *            the ring so the rest follow on the next call.
+    *
+    *   The frames stay in the ring until ESPNOW_rx_frames_release.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    word wTail = wRxFrameTail;
+    word wNFrames = (word)(wRxFrameHead - wTail);
+    word wNToEnd = ESPNOW_RX_FRAME_RING_LENGTH - (wTail % ESPNOW_RX_FRAME_RING_LENGTH);
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    *pastFrames = &astRxFrames[wTail % ESPNOW_RX_FRAME_RING_LENGTH];
+    return wNFrames < wNToEnd ? wNFrames : wNToEnd;
+}
+
+void ESPNOW_rx_frames_release(word wNFrames)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_rx_frames_release
+    *   Takes:   wNFrames - frames from ESPNOW_rx_frames_peek that are done with
+    *
+    *   Returns: None
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    wRxFrameTail = (word)(wRxFrameTail + wNFrames);
+    dwNRxRelayed += wNFrames;
+}
+
+void ESPNOW_rx_send_stats(void)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_rx_send_stats
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Sends ESPNOW_TELEM_RX_PATH_ID on this node's bus, the time the Rx
+    *   callback held the Wi-Fi task and the frames relayed since the last
+    *   call, see espnowtelem.h. Run from ESPNOW_telem_service's statistics.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    CAN_frame_t stFrame;
+    dword dwNCallbacks = dwNRxCallbacks - dwLastNRxCallbacks;
+    dword dwCallbackus = dwRxCallbackus - dwLastRxCallbackus;
+    dword dwValue;
+
+    dwLastNRxCallbacks += dwNCallbacks;
+    dwLastRxCallbackus += dwCallbackus;
+    memset(&stFrame, 0, sizeof(stFrame));
+    stFrame.dwID = ESPNOW_TELEM_RX_PATH_ID;
+    stFrame.byDLC = 8;
+    dwValue = dwNCallbacks > 0 ? (dwCallbackus * 10) / dwNCallbacks : 0;
+    dwValue = dwValue > 0xFFFF ? 0xFFFF : dwValue;
+    stFrame.abData[0] = (byte)(dwValue >> 8);
+    stFrame.abData[1] = (byte)dwValue;
+    dwValue = dwRxCallbackMaxus > 0xFFFF ? 0xFFFF : dwRxCallbackMaxus;
+    stFrame.abData[2] = (byte)(dwValue >> 8);
+    stFrame.abData[3] = (byte)dwValue;
+    dwValue = dwNRxRelayed > 0xFFFF ? 0xFFFF : dwNRxRelayed;
+    stFrame.abData[4] = (byte)(dwValue >> 8);
+    stFrame.abData[5] = (byte)dwValue;
+    dwValue = dwNRxDropped > 0xFFFF ? 0xFFFF : dwNRxDropped;
+    stFrame.abData[6] = (byte)(dwValue >> 8);
+    stFrame.abData[7] = (byte)dwValue;
+    dwRxCallbackMaxus = 0;
+    dwNRxRelayed = 0;
+    dwNRxDropped = 0;
+    CAN_set_rx_time(&stFrame, (qword)esp_timer_get_time());
+    ESPNOW_rx_frame_put(&stFrame);
+}
+
+static byte ESPNOW_varint_size(dword dwValue)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_varint_size
+    *   Takes:   dwValue - value to encode
+    * 
+    *   Returns: Bytes the value takes as a varint, 7 bits a byte.
+    *=========================================================================== 
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    byte byNBytes = 1;
+    while (dwValue >= 0x80)
+    {
+        dwValue >>= 7;
+        byNBytes++;
+    }
+    return byNBytes;
+}
@@ -20,9 +20,74 @@
 #define CAN_QUEUE_LENGTH 115 // Number of CAN frames in the ring buffer
 #define MAX_ESPNOW_PAYLOAD 250
 
+/*  Telemetry frame format
+    After the packet header in espnowtelem.h a packet is a run of CAN frames, each a 2 or 5 byte
+    header followed by the time since the previous frame and DLC data bytes.
+        Standard: [0 | DLC3..DLC0 | ID10..ID8], [ID7..ID0]
+        Extended: [1 | DLC3..DLC0 | 0 0 0], [ID28..ID24], [ID23..ID16], [ID15..ID8], [ID7..ID0]
+*/
+#define ESPNOW_FRAME_EXTENDED   0x80    // Header flag, a 29 bit ID follows
+#define ESPNOW_FRAME_DLC_SHIFT  3
+#define ESPNOW_STD_HEADER_SIZE  2
+#define ESPNOW_EXT_HEADER_SIZE  5
+#define ESPNOW_MAX_FRAME_SIZE   (ESPNOW_EXT_HEADER_SIZE + 8)
+
+/*  Telemetry sender
+    ESPNOW_tx_service packs frames as they arrive and sends a packet once it is full or its oldest
+    frame has waited ESPNOW_TX_DEADLINE_US. Up to ESPNOW_TX_WINDOW packets are handed to the radio
+    at once, the send callback frees a slot. A failed send or a full radio backs off, doubling from
+    ESPNOW_TX_BACKOFF_MIN_US, until a packet gets through.
+*/
+#define ESPNOW_TX_DEADLINE_US       5000    // Lower for latency, higher for fuller packets
+#define ESPNOW_TX_WINDOW            2       // Packets waiting on their send callback
+#define ESPNOW_TX_DONE_TIMEOUT_US   100000  // Send callback given up on after this
+#define ESPNOW_TX_BACKOFF_MIN_US    1000
+#define ESPNOW_TX_BACKOFF_MAX_US    32000
+
+/*  Telemetry queue
+    The CAN Rx callback copies each frame into xESPNOWTelemBuffer, so the sender never takes
+    frames from the CAN ring buffer the rest of the node reads. The queues are only made, and
+    the sender only runs, once ESP-NOW has started on a node built with TX_ENABLE in espnow.c.
+*/
+#define ESPNOW_TELEM_QUEUE_LENGTH   CAN_QUEUE_LENGTH
+
+/*  Priority lane
+    Safety frames skip the telemetry queue for xESPNOWPriorityBuffer so a backlog of bulk frames
+    can not hold them up. ESPNOW_tx_service sends them whole, as soon as they arrive, in their own
+    packets ahead of the bulk ones. They have ESPNOW_TX_PRIORITY_SLOTS radio slots on top of
+    ESPNOW_TX_WINDOW and ignore the back off, so wait for at most the bulk packets already on air.
+*/
+#define ESPNOW_IS_PRIORITY_ID(dwID) ((dwID) == KILL_MSG_ID || (dwID) == IMDDATA_ID || (dwID) == STATUSAPPS_ID)
+#define ESPNOW_PRIORITY_QUEUE_LENGTH 16
+#define ESPNOW_TX_PRIORITY_SLOTS    1
+
+/*  Link adaptation
+    The telemetry peer's PHY rate is picked by espnowlink.c from the send callbacks and the RSSI of
+    packets heard from the peer. The channel stays on CONFIG_ESPNOW_CHANNEL as both ends have to
+    move together.
+*/
+#define ESPNOW_LINK_TX_LENGTHS      4       // Power of 2 over ESPNOW_TX_WINDOW + ESPNOW_TX_PRIORITY_SLOTS
+#define ESPNOW_LINK_REPORT_MS       10000   // Goodput of each rate logged this often
+
+/*  Telemetry receiver
+    The Rx callback runs in the Wi-Fi task so it only copies the packet into the packet ring in
+    espnowtelem.c. ESPNOW_telem_service, in the background task, takes every packet waiting in one
+    go, puts them in order and ESPNOW_fill_buffer decodes their frames straight into the Rx frame
+    ring, published once a packet. CAN_empty_ESPNOW_buffer then puts runs of them on the bus. Each
+    ring has one writer and one reader so neither takes a lock.
+*/
+#define ESPNOW_RX_FRAME_RING_LENGTH 128     // Power of 2, frames waiting for the bus
+
 
 esp_err_t ESPNOW_init(void);
+esp_err_t NVS_init(void);
 esp_err_t ESPNOW_empty_buffer(void);
+esp_err_t ESPNOW_tx_service(void);
+esp_err_t ESPNOW_fill_buffer(const byte *abyData, byte byNDataLength, qword qwtRx);
+void ESPNOW_rx_frame_put(const CAN_frame_t *stFrame);
+word ESPNOW_rx_frames_peek(const CAN_frame_t **pastFrames);
+void ESPNOW_rx_frames_release(word wNFrames);
+void ESPNOW_rx_send_stats(void);
 
 #define SFREspNow
 #endif // SFRESPNow
\ No newline at end of file
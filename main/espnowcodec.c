@@ -0,0 +1,270 @@
+/*
+espnowcodec.c
+File contains the per ID rate limiting and delta compression of the ESP-NOW telemetry.
+
+Written by Cole Perera for Sheffield Formula Racing 2026
+*/
+
+#include "espnowcodec.h"
+#include "sfrtypes.h"
+
+/* --------------------------- Definitions ----------------------------- */
+#define ESPNOW_CODEC_EARLY_DIVISOR  4   // Frames up to a quarter of the period early are not rate limited
+
+/* --------------------------- Local Variables ------------------------ */
+/* Car, the last frame sent for each ID in astCANTelemRates */
+static byte aabyTxData[CAN_TELEM_RATES_LENGTH][8];
+static byte abyTxDLC[CAN_TELEM_RATES_LENGTH];
+static boolean abTxValid[CAN_TELEM_RATES_LENGTH];      // Pits hold the reference
+static boolean abTxSent[CAN_TELEM_RATES_LENGTH];       // Rate limit started
+static dword adwTxLastus[CAN_TELEM_RATES_LENGTH];        // Low 32 bits of the Rx time
+static dword adwTxKeyframeus[CAN_TELEM_RATES_LENGTH];
+
+/* Pits, the last frame received for each ID */
+static byte aabyRxData[CAN_TELEM_RATES_LENGTH][8];
+static byte abyRxDLC[CAN_TELEM_RATES_LENGTH];
+static boolean abRxValid[CAN_TELEM_RATES_LENGTH];
+
+/* --------------------------- Function prototypes --------------------- */
+static word ESPNOW_codec_entry(dword dwID);
+
+/* --------------------------- Functions ----------------------------- */
+void ESPNOW_codec_encode(const CAN_frame_t *stFrame, qword qwtFrame, stESPNOWCodecFrame_t *stEncoded)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_codec_encode
+    *   Takes:   stFrame - frame to send
+    *            qwtFrame - its Rx time in us
+    *            stEncoded - filled with how to send it
+    *
+    *   Returns: None
+    *
+    *   Decides whether the frame is dropped by its ID's rate limit, sent whole
+    *   as a keyframe or sent as the bytes that changed. Nothing is remembered
+    *   until ESPNOW_codec_sent, so a frame left for the next packet is encoded
+    *   again the same way.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    word wEntry = ESPNOW_codec_entry(stFrame->dwID);
+    dword dwPeriodus;
+    dword dwNow = (dword)qwtFrame;
+
+    stEncoded->wEntry = wEntry;
+    stEncoded->byMask = 0;
+    stEncoded->byNChanged = 0;
+    stEncoded->eType = eCODEC_KEYFRAME;
+
+    if (wEntry == ESPNOW_CODEC_NO_ENTRY)
+    {
+        return;
+    }
+
+    /* Rate limit */
+    dwPeriodus = (dword)astCANTelemRates[wEntry].wTelemPeriodms * 1000;
+    if (abTxSent[wEntry] && dwPeriodus > 0 &&
+        (dword)(dwNow - adwTxLastus[wEntry]) < dwPeriodus - dwPeriodus / ESPNOW_CODEC_EARLY_DIVISOR)
+    {
+        stEncoded->eType = eCODEC_DROP;
+        return;
+    }
+
+    if (!abTxValid[wEntry] || stFrame->byDLC != abyTxDLC[wEntry] ||
+        (dword)(dwNow - adwTxKeyframeus[wEntry]) >= (dword)ESPNOW_CODEC_KEYFRAME_MS * 1000)
+    {
+        return;
+    }
+
+    /* Delta against the last frame sent */
+    stEncoded->eType = eCODEC_DELTA;
+    for (byte byIndex = 0; byIndex < stFrame->byDLC; byIndex++)
+    {
+        byte byXOR = stFrame->abData[byIndex] ^ aabyTxData[wEntry][byIndex];
+        if (byXOR != 0)
+        {
+            stEncoded->byMask |= (byte)(1 << byIndex);
+            stEncoded->abyXOR[stEncoded->byNChanged++] = byXOR;
+        }
+    }
+}
+
+void ESPNOW_codec_sent(const CAN_frame_t *stFrame, qword qwtFrame, const stESPNOWCodecFrame_t *stEncoded)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_codec_sent
+    *   Takes:   stFrame - frame put in the packet
+    *            qwtFrame - its Rx time in us
+    *            stEncoded - how it was encoded by ESPNOW_codec_encode
+    *
+    *   Returns: None
+    *
+    *   Remembers the frame as the reference for the next delta of its ID.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    word wEntry = stEncoded->wEntry;
+
+    if (wEntry == ESPNOW_CODEC_NO_ENTRY || stEncoded->eType == eCODEC_DROP)
+    {
+        return;
+    }
+    memcpy(aabyTxData[wEntry], stFrame->abData, stFrame->byDLC);
+    abyTxDLC[wEntry] = stFrame->byDLC;
+    adwTxLastus[wEntry] = (dword)qwtFrame;
+    abTxSent[wEntry] = TRUE;
+    if (stEncoded->eType == eCODEC_KEYFRAME)
+    {
+        adwTxKeyframeus[wEntry] = (dword)qwtFrame;
+        abTxValid[wEntry] = TRUE;
+    }
+}
+
+esp_err_t ESPNOW_codec_decode(CAN_frame_t *stFrame, byte byMask, const byte *abyXOR)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_codec_decode
+    *   Takes:   stFrame - ID set, DLC and data filled in from the reference
+    *            byMask - bytes that changed
+    *            abyXOR - changed bytes XORed with the reference
+    *
+    *   Returns: ESP_OK if decoded, ESP_ERR_INVALID_STATE if there is no
+    *            reference for the ID since the last keyframe.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    word wEntry = ESPNOW_codec_entry(stFrame->dwID);
+    byte byNChanged = 0;
+
+    if (wEntry == ESPNOW_CODEC_NO_ENTRY || !abRxValid[wEntry])
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    for (byte byIndex = 0; byIndex < abyRxDLC[wEntry]; byIndex++)
+    {
+        if (byMask & (1 << byIndex))
+        {
+            aabyRxData[wEntry][byIndex] ^= abyXOR[byNChanged++];
+        }
+    }
+    stFrame->byDLC = abyRxDLC[wEntry];
+    memcpy(stFrame->abData, aabyRxData[wEntry], stFrame->byDLC);
+    return ESP_OK;
+}
+
+void ESPNOW_codec_keyframe(const CAN_frame_t *stFrame)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_codec_keyframe
+    *   Takes:   stFrame - whole frame received
+    *
+    *   Returns: None
+    *
+    *   Keeps the frame as the reference for the deltas of its ID that follow.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    word wEntry = ESPNOW_codec_entry(stFrame->dwID);
+
+    if (wEntry == ESPNOW_CODEC_NO_ENTRY)
+    {
+        return;
+    }
+    memcpy(aabyRxData[wEntry], stFrame->abData, stFrame->byDLC);
+    abyRxDLC[wEntry] = stFrame->byDLC;
+    abRxValid[wEntry] = TRUE;
+}
+
+void ESPNOW_codec_reset_tx(void)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_codec_reset_tx
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Called when a packet was not delivered, the pits will have forgotten
+    *   their references so the next frame of every ID is sent as a keyframe.
+    *   The rate limits are kept.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    memset(abTxValid, 0, sizeof(abTxValid));
+}
+
+void ESPNOW_codec_reset_rx(void)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_codec_reset_rx
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Forgets every reference, called when a packet is lost as its frames may
+    *   have changed them. Deltas are dropped until each ID's next keyframe.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    memset(abRxValid, 0, sizeof(abRxValid));
+}
+
+static word ESPNOW_codec_entry(dword dwID)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_codec_entry
+    *   Takes:   dwID - CAN ID
+    *
+    *   Returns: Index of the ID in astCANTelemRates or ESPNOW_CODEC_NO_ENTRY.
+    *
+    *   Binary search, the table is generated sorted by ID.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    word wLow = 0;
+    word wHigh = CAN_TELEM_RATES_LENGTH;
+
+    while (wLow < wHigh)
+    {
+        word wMid = (word)((wLow + wHigh) / 2);
+        if (astCANTelemRates[wMid].dwID < dwID)
+        {
+            wLow = wMid + 1;
+        }
+        else
+        {
+            wHigh = wMid;
+        }
+    }
+    if (wLow < CAN_TELEM_RATES_LENGTH && astCANTelemRates[wLow].dwID == dwID)
+    {
+        return wLow;
+    }
+    return ESPNOW_CODEC_NO_ENTRY;
+}
@@ -0,0 +1,46 @@
+/* Only define once */
+#ifndef SFRESPNowCodec
+#define SFRESPNowCodec
+
+#include "espnow.h"
+#include "CAN/canDecodeAuto.h"
+
+/*  ESP-NOW Telemetry Compression
+    IDs in astCANTelemRates (the Telemetry Rate column of the CAN spreadsheet, see decodeCAN.py)
+    are sent at most once per their telemetry period, 0 sends every frame. Frames that come early
+    are dropped on the car.
+
+    A frame of a known ID is sent whole as a keyframe the first time, when its DLC changes and every
+    ESPNOW_CODEC_KEYFRAME_MS. In between it is sent as a delta against the last frame sent for the ID:
+        [Header with DLC ESPNOW_FRAME_DLC_DELTA], Time..., [Mask], XOR...
+        Bit n of Mask is set if data byte n changed, XOR is each changed byte XORed with the old
+        one. The DLC is that of the last frame.
+    Unknown IDs are always sent whole. The receiver forgets every ID when a packet is lost and drops
+    deltas until the ID's next keyframe.
+*/
+#define ESPNOW_FRAME_DLC_DELTA      0x0F
+#define ESPNOW_CODEC_KEYFRAME_MS    500
+#define ESPNOW_CODEC_NO_ENTRY       0xFFFF
+
+typedef enum {
+    eCODEC_DROP = 0,
+    eCODEC_KEYFRAME,
+    eCODEC_DELTA,
+} eESPNOWCodec_t;
+
+typedef struct {
+    eESPNOWCodec_t eType;
+    word wEntry;        // Index in astCANTelemRates or ESPNOW_CODEC_NO_ENTRY
+    byte byMask;
+    byte byNChanged;
+    byte abyXOR[8];
+} stESPNOWCodecFrame_t;
+
+void ESPNOW_codec_encode(const CAN_frame_t *stFrame, qword qwtFrame, stESPNOWCodecFrame_t *stEncoded);
+void ESPNOW_codec_sent(const CAN_frame_t *stFrame, qword qwtFrame, const stESPNOWCodecFrame_t *stEncoded);
+esp_err_t ESPNOW_codec_decode(CAN_frame_t *stFrame, byte byMask, const byte *abyXOR);
+void ESPNOW_codec_keyframe(const CAN_frame_t *stFrame);
+void ESPNOW_codec_reset_tx(void);
+void ESPNOW_codec_reset_rx(void);
+
+#endif // SFRESPNowCodec
@@ -0,0 +1,539 @@
+/*
+espnowflash.c
+File contains the ESP-NOW transport for reflashing a node and the pit laptop bridge for it.
+
+Written by Cole Perera for Sheffield Formula Racing 2026
+*/
+
+#include "espnowflash.h"
+#include "sfrtypes.h"
+#ifdef ESPNOW_FLASH_BRIDGE
+#include "driver/usb_serial_jtag.h"
+#endif
+
+/* --------------------------- Definitions ----------------------------- */
+#define ESPNOW_FLASH_QUEUE_LENGTH 16       // Packets, more than the host window
+#define ESPNOW_FLASH_NO_NACK 0xFFFFFFFF    // No NACK sent for the current offset
+#define ESPNOW_FLASH_OFFSET_INDEX 3        // Index of the offset/size in a packet
+#define ESPNOW_FLASH_DIGEST_INDEX 7        // Index of the digest in an ENTER packet
+#define ESPNOW_FLASH_COMMIT_SIZE (ESPNOW_FLASH_HEADER_SIZE + 1)
+#define SLIP_END 0xC0
+#define SLIP_ESC 0xDB
+#define SLIP_ESC_END 0xDC
+#define SLIP_ESC_ESC 0xDD
+#define BRIDGE_FRAME_SIZE (ESP_NOW_ETH_ALEN + MAX_ESPNOW_PAYLOAD)
+#define BRIDGE_USB_BUFFER_SIZE 512
+#define BRIDGE_USB_TIMEOUT_MS 10
+
+/* --------------------------- Local Types ----------------------------- */
+typedef struct {
+    uint8_t abySourceMAC[ESP_NOW_ETH_ALEN];
+    byte byNLength;
+    byte abyData[MAX_ESPNOW_PAYLOAD];
+} stESPNOWFlashPacket_t;
+
+/* --------------------------- Local Variables ------------------------ */
+extern eChipMode_t eDeviceMode;
+static QueueHandle_t xESPNOWFlashQueue = NULL;
+static uint8_t abyHostMAC[ESP_NOW_ETH_ALEN];
+
+/* Resume query latched from the ESP-NOW Rx callback */
+static volatile boolean bQueryRequested = FALSE;
+static volatile dword dwQueryDigest = 0;
+
+/* Link statistics for this reflash */
+static dword dwLastNACKOffset = ESPNOW_FLASH_NO_NACK;
+static dword dwNDataPackets = 0;
+static dword dwNDuplicatePackets = 0;
+static dword dwNOutOfOrderPackets = 0;
+static qword qwtFirstData = 0;
+
+/* --------------------------- Function prototypes --------------------- */
+static dword ESPNOW_flash_read_dword(const byte *abyData);
+static void ESPNOW_flash_write_dword(byte *abyData, dword dwValue);
+static esp_err_t ESPNOW_flash_add_peer(const uint8_t *abyMAC);
+static esp_err_t ESPNOW_flash_send_offset(byte byOp, dword dwOffset);
+#ifdef ESPNOW_FLASH_BRIDGE
+static void ESPNOW_flash_bridge_forward(const byte *abyFrame, word wNLength);
+static void ESPNOW_flash_bridge_send_usb(const stESPNOWFlashPacket_t *stPacket);
+#endif
+
+/* --------------------------- Functions ----------------------------- */
+esp_err_t ESPNOW_flash_init(void)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_flash_init
+    *   Takes:   None
+    *
+    *   Returns: ESP_OK if successful, error code if not.
+    *
+    *   Allocates the queue of reflash packets. Run after ESPNOW_init. The
+    *   bridge also installs the USB serial driver and silences the logs as
+    *   they share the port with the SLIP frames.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    xESPNOWFlashQueue = xQueueCreate(ESPNOW_FLASH_QUEUE_LENGTH, sizeof(stESPNOWFlashPacket_t));
+    if (xESPNOWFlashQueue == NULL)
+    {
+        ESP_LOGE("ESP-NOW", "Failed to create reflash Queue");
+        return ESP_ERR_NO_MEM;
+    }
+
+    #ifdef ESPNOW_FLASH_BRIDGE
+    usb_serial_jtag_driver_config_t stUSBConfig = USB_SERIAL_JTAG_DRIVER_CONFIG_DEFAULT();
+    esp_err_t eStatus = usb_serial_jtag_driver_install(&stUSBConfig);
+    if (eStatus != ESP_OK)
+    {
+        ESP_LOGE("ESP-NOW", "Failed to install USB serial driver: %s", esp_err_to_name(eStatus));
+        return eStatus;
+    }
+    esp_log_level_set("*", ESP_LOG_NONE);
+    #endif
+    return ESP_OK;
+}
+
+void ESPNOW_flash_rx(const uint8_t *abySourceMAC, const byte *abyData, int NLength)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_flash_rx
+    *   Takes:   abySourceMAC - MAC address the packet came from
+    *            abyData - received reflash packet
+    *            NLength - length of the packet
+    *
+    *   Returns: None
+    *
+    *   Called from the ESP-NOW Rx callback for reflash packets. ENTER and
+    *   QUERY are latched like the CAN reflash commands, DATA is queued for the
+    *   reflash background task. Nothing lengthy is done here.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    stESPNOWFlashPacket_t stPacket;
+
+    if (NLength < ESPNOW_FLASH_HEADER_SIZE || NLength > MAX_ESPNOW_PAYLOAD || xESPNOWFlashQueue == NULL)
+    {
+        return;
+    }
+
+    #ifdef ESPNOW_FLASH_BRIDGE
+    /* The bridge passes everything from the nodes to the laptop */
+    memcpy(stPacket.abySourceMAC, abySourceMAC, ESP_NOW_ETH_ALEN);
+    stPacket.byNLength = (byte)NLength;
+    memcpy(stPacket.abyData, abyData, NLength);
+    (void)xQueueSend(xESPNOWFlashQueue, &stPacket, 0);
+    return;
+    #endif
+
+    if (abyData[2] != DEVICE_ID)
+    {
+        return;
+    }
+    /* Do not take over a reflash already running on CAN */
+    if (eDeviceMode == eREFLASH && eReflashTransport != eREFLASH_TRANSPORT_ESPNOW)
+    {
+        return;
+    }
+
+    switch (abyData[1])
+    {
+        case ESPNOW_FLASH_OP_ENTER:
+            if (NLength < ESPNOW_FLASH_DIGEST_INDEX + 4)
+            {
+                break;
+            }
+            memcpy(abyHostMAC, abySourceMAC, ESP_NOW_ETH_ALEN);
+            dwQueryDigest = ESPNOW_flash_read_dword(&abyData[ESPNOW_FLASH_DIGEST_INDEX]);
+            bQueryRequested = TRUE;
+            if (eDeviceMode != eREFLASH)
+            {
+                dwFirmwareSize = ESPNOW_flash_read_dword(&abyData[ESPNOW_FLASH_OFFSET_INDEX]);
+                bMulticastReflash = FALSE;
+                eReflashTransport = eREFLASH_TRANSPORT_ESPNOW;
+                set_device_mode(eREFLASH);
+            }
+            break;
+        case ESPNOW_FLASH_OP_QUERY:
+            if (NLength < ESPNOW_FLASH_OFFSET_INDEX + 4 || eDeviceMode != eREFLASH)
+            {
+                break;
+            }
+            memcpy(abyHostMAC, abySourceMAC, ESP_NOW_ETH_ALEN);
+            dwQueryDigest = ESPNOW_flash_read_dword(&abyData[ESPNOW_FLASH_OFFSET_INDEX]);
+            bQueryRequested = TRUE;
+            break;
+        case ESPNOW_FLASH_OP_DATA:
+            if (NLength < ESPNOW_FLASH_DATA_HEADER_SIZE || eDeviceMode != eREFLASH)
+            {
+                break;
+            }
+            memcpy(stPacket.abySourceMAC, abySourceMAC, ESP_NOW_ETH_ALEN);
+            stPacket.byNLength = (byte)NLength;
+            memcpy(stPacket.abyData, abyData, NLength);
+            /* Queue full, the host resends from the next NACK or timeout */
+            (void)xQueueSend(xESPNOWFlashQueue, &stPacket, 0);
+            break;
+        default:
+            break;
+    }
+}
+
+esp_err_t ESPNOW_flash_empty_queue(esp_partition_t *stOTAPartition)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_flash_empty_queue
+    *   Takes:   stOTAPartition - target partition to write to
+    *
+    *   Returns: ESP_OK if successful, error code if not.
+    *
+    *   Answers a latched ENTER/QUERY with the resume point, then writes the
+    *   queued DATA packets that are in order and ACKs them. Repeats are ACKed
+    *   again in case the ACK was lost, a gap is NACKed once.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    stESPNOWFlashPacket_t stPacket;
+    dword dwOffset;
+    dword dwNReceived;
+    esp_err_t eState = ESP_OK;
+
+    if (xESPNOWFlashQueue == NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (stOTAPartition == NULL || eReflashTransport != eREFLASH_TRANSPORT_ESPNOW)
+    {
+        return ESP_OK;
+    }
+
+    if (bQueryRequested)
+    {
+        bQueryRequested = FALSE;
+        eState = ESPNOW_flash_add_peer(abyHostMAC);
+        if (eState == ESP_OK)
+        {
+            eState = CAN_flash_resume(stOTAPartition, dwQueryDigest, &dwNReceived);
+        }
+        if (eState != ESP_OK)
+        {
+            return eState;
+        }
+        dwLastNACKOffset = ESPNOW_FLASH_NO_NACK;
+        (void)ESPNOW_flash_send_offset(ESPNOW_FLASH_OP_ACK, dwNReceived);
+    }
+
+    while (xQueueReceive(xESPNOWFlashQueue, &stPacket, 0) == pdTRUE)
+    {
+        dwOffset = ESPNOW_flash_read_dword(&stPacket.abyData[ESPNOW_FLASH_OFFSET_INDEX]);
+        dwNReceived = CAN_flash_bytes_received();
+        dwNDataPackets++;
+        if (qwtFirstData == 0)
+        {
+            qwtFirstData = (qword)esp_timer_get_time();
+        }
+
+        if (dwOffset == dwNReceived)
+        {
+            eState = CAN_flash_append(stOTAPartition, &stPacket.abyData[ESPNOW_FLASH_DATA_HEADER_SIZE],
+                                      stPacket.byNLength - ESPNOW_FLASH_DATA_HEADER_SIZE);
+            if (eState != ESP_OK)
+            {
+                ESP_LOGE("ESP-NOW", "Failed to write reflash data: %s", esp_err_to_name(eState));
+            }
+            dwLastNACKOffset = ESPNOW_FLASH_NO_NACK;
+            (void)ESPNOW_flash_send_offset(ESPNOW_FLASH_OP_ACK, CAN_flash_bytes_received());
+        } else if (dwOffset < dwNReceived)
+        {
+            dwNDuplicatePackets++;
+            (void)ESPNOW_flash_send_offset(ESPNOW_FLASH_OP_ACK, dwNReceived);
+        } else
+        {
+            dwNOutOfOrderPackets++;
+            if (dwLastNACKOffset != dwNReceived)
+            {
+                dwLastNACKOffset = dwNReceived;
+                (void)ESPNOW_flash_send_offset(ESPNOW_FLASH_OP_NACK, dwNReceived);
+            }
+        }
+    }
+    return eState;
+}
+
+esp_err_t ESPNOW_flash_send_commit(eReflashCommit_t eResult)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_flash_send_commit
+    *   Takes:   eResult - result of checking and committing the image
+    *
+    *   Returns: ESP_OK if successful, error code if not.
+    *
+    *   Sends the COMMIT reply to the host and logs the link statistics.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    byte abyPacket[ESPNOW_FLASH_COMMIT_SIZE];
+    qword qwtFlash = (qword)esp_timer_get_time() - qwtFirstData;
+
+    ESP_LOGI("ESP-NOW", "Reflash %d bytes in %d ms, %d packets, %d repeated, %d out of order",
+        (int)CAN_flash_bytes_received(), (int)(qwtFlash / 1000), (int)dwNDataPackets,
+        (int)dwNDuplicatePackets, (int)dwNOutOfOrderPackets);
+
+    abyPacket[0] = ESPNOW_FLASH_PACKET;
+    abyPacket[1] = ESPNOW_FLASH_OP_COMMIT;
+    abyPacket[2] = DEVICE_ID;
+    abyPacket[3] = (byte)eResult;
+    return esp_now_send(abyHostMAC, abyPacket, sizeof(abyPacket));
+}
+
+void ESPNOW_flash_stop(void)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_flash_stop
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Clears the queue and statistics when reflash mode is left.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    if (xESPNOWFlashQueue != NULL)
+    {
+        xQueueReset(xESPNOWFlashQueue);
+    }
+    bQueryRequested = FALSE;
+    dwLastNACKOffset = ESPNOW_FLASH_NO_NACK;
+    dwNDataPackets = 0;
+    dwNDuplicatePackets = 0;
+    dwNOutOfOrderPackets = 0;
+    qwtFirstData = 0;
+}
+
+static dword ESPNOW_flash_read_dword(const byte *abyData)
+{
+    /* Big endian, same as the CAN reflash commands */
+    return ((dword)abyData[0] << 24) | ((dword)abyData[1] << 16) |
+           ((dword)abyData[2] << 8)  | ((dword)abyData[3]);
+}
+
+static void ESPNOW_flash_write_dword(byte *abyData, dword dwValue)
+{
+    abyData[0] = (byte)((dwValue >> 24) & 0xFF);
+    abyData[1] = (byte)((dwValue >> 16) & 0xFF);
+    abyData[2] = (byte)((dwValue >> 8) & 0xFF);
+    abyData[3] = (byte)(dwValue & 0xFF);
+}
+
+static esp_err_t ESPNOW_flash_add_peer(const uint8_t *abyMAC)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_flash_add_peer
+    *   Takes:   abyMAC - MAC address to send to
+    *
+    *   Returns: ESP_OK if successful, error code if not.
+    *
+    *   ESP-NOW only sends to known peers, the host is added on first contact.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    esp_now_peer_info_t stPeerInfo = {0};
+
+    if (esp_now_is_peer_exist(abyMAC))
+    {
+        return ESP_OK;
+    }
+    memcpy(stPeerInfo.peer_addr, abyMAC, ESP_NOW_ETH_ALEN);
+    stPeerInfo.channel = CONFIG_ESPNOW_CHANNEL;
+    stPeerInfo.encrypt = false;
+    return esp_now_add_peer(&stPeerInfo);
+}
+
+static esp_err_t ESPNOW_flash_send_offset(byte byOp, dword dwOffset)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_flash_send_offset
+    *   Takes:   byOp - ESPNOW_FLASH_OP_ACK or ESPNOW_FLASH_OP_NACK
+    *            dwOffset - offset of the next byte wanted from the host
+    *
+    *   Returns: ESP_OK if successful, error code if not.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    byte abyPacket[ESPNOW_FLASH_DATA_HEADER_SIZE];
+
+    abyPacket[0] = ESPNOW_FLASH_PACKET;
+    abyPacket[1] = byOp;
+    abyPacket[2] = DEVICE_ID;
+    ESPNOW_flash_write_dword(&abyPacket[ESPNOW_FLASH_OFFSET_INDEX], dwOffset);
+    return esp_now_send(abyHostMAC, abyPacket, sizeof(abyPacket));
+}
+
+#ifdef ESPNOW_FLASH_BRIDGE
+esp_err_t ESPNOW_flash_bridge_service(void)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_flash_bridge_service
+    *   Takes:   None
+    *
+    *   Returns: ESP_OK if successful, error code if not.
+    *
+    *   Run from the background task of the pit bridge. Decodes SLIP frames
+    *   from the laptop and sends them over ESP-NOW, and passes packets from
+    *   the nodes back up the USB serial port.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    static byte abyFrame[BRIDGE_FRAME_SIZE];
+    static word wNFrameBytes = 0;
+    static boolean bEscape = FALSE;
+    static boolean bOverflow = FALSE;
+    byte abyUSBBuffer[BRIDGE_USB_BUFFER_SIZE];
+    stESPNOWFlashPacket_t stPacket;
+    byte byData;
+    int NRead;
+
+    if (xESPNOWFlashQueue == NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    /* Laptop to nodes */
+    NRead = usb_serial_jtag_read_bytes(abyUSBBuffer, sizeof(abyUSBBuffer), 0);
+    for (int NCounter = 0; NCounter < NRead; NCounter++)
+    {
+        byData = abyUSBBuffer[NCounter];
+        if (byData == SLIP_END)
+        {
+            if (!bOverflow && wNFrameBytes > ESP_NOW_ETH_ALEN)
+            {
+                ESPNOW_flash_bridge_forward(abyFrame, wNFrameBytes);
+            }
+            wNFrameBytes = 0;
+            bEscape = FALSE;
+            bOverflow = FALSE;
+            continue;
+        }
+        if (byData == SLIP_ESC)
+        {
+            bEscape = TRUE;
+            continue;
+        }
+        if (bEscape)
+        {
+            byData = (byData == SLIP_ESC_END) ? SLIP_END : SLIP_ESC;
+            bEscape = FALSE;
+        }
+        if (wNFrameBytes < BRIDGE_FRAME_SIZE)
+        {
+            abyFrame[wNFrameBytes++] = byData;
+        } else
+        {
+            bOverflow = TRUE;
+        }
+    }
+
+    /* Nodes to laptop */
+    while (xQueueReceive(xESPNOWFlashQueue, &stPacket, 0) == pdTRUE)
+    {
+        ESPNOW_flash_bridge_send_usb(&stPacket);
+    }
+    return ESP_OK;
+}
+
+static void ESPNOW_flash_bridge_forward(const byte *abyFrame, word wNLength)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_flash_bridge_forward
+    *   Takes:   abyFrame - decoded SLIP frame, destination MAC then payload
+    *            wNLength - length of the frame
+    *
+    *   Returns: None
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    if (ESPNOW_flash_add_peer(abyFrame) != ESP_OK)
+    {
+        return;
+    }
+    /* Dropped packets are recovered by the host's retransmit */
+    (void)esp_now_send(abyFrame, &abyFrame[ESP_NOW_ETH_ALEN], wNLength - ESP_NOW_ETH_ALEN);
+}
+
+static void ESPNOW_flash_bridge_send_usb(const stESPNOWFlashPacket_t *stPacket)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_flash_bridge_send_usb
+    *   Takes:   stPacket - packet received from a node
+    *
+    *   Returns: None
+    *
+    *   SLIP encodes the source MAC and packet and writes it to the laptop.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    byte abyEncoded[2 * BRIDGE_FRAME_SIZE + 2];
+    word wNEncoded = 0;
+    byte byData;
+
+    abyEncoded[wNEncoded++] = SLIP_END;
+    for (word wNCounter = 0; wNCounter < ESP_NOW_ETH_ALEN + stPacket->byNLength; wNCounter++)
+    {
+        byData = (wNCounter < ESP_NOW_ETH_ALEN) ? stPacket->abySourceMAC[wNCounter]
+                                                : stPacket->abyData[wNCounter - ESP_NOW_ETH_ALEN];
+        if (byData == SLIP_END)
+        {
+            abyEncoded[wNEncoded++] = SLIP_ESC;
+            abyEncoded[wNEncoded++] = SLIP_ESC_END;
+        } else if (byData == SLIP_ESC)
+        {
+            abyEncoded[wNEncoded++] = SLIP_ESC;
+            abyEncoded[wNEncoded++] = SLIP_ESC_ESC;
+        } else
+        {
+            abyEncoded[wNEncoded++] = byData;
+        }
+    }
+    abyEncoded[wNEncoded++] = SLIP_END;
+    (void)usb_serial_jtag_write_bytes(abyEncoded, wNEncoded, pdMS_TO_TICKS(BRIDGE_USB_TIMEOUT_MS));
+}
+#endif
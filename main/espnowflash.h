@@ -0,0 +1,54 @@
+/* Only define once */
+#ifndef SFRESPNowFlash
+#define SFRESPNowFlash
+
+#include "espnow.h"
+#include "CAN/canflash.h"
+
+/*  Reflash over ESP-NOW
+    Unicast reflash carried in ESP-NOW packets instead of CAN frames, it feeds the same sector
+    writer and checkpoint as the CAN reflash. Telemetry packets start with ESPNOW_TELEM_PACKET
+    (see espnowtelem.h), a first byte of ESPNOW_FLASH_PACKET marks a reflash packet.
+
+    Host -> Node: [ESPNOW_FLASH_PACKET, Op, DEVICE_ID, ...]
+        ENTER:  [.., Size3..Size0, Digest3..Digest0]   Enter reflash mode, replied to with an ACK
+                                                        of the resume point once ready.
+        QUERY:  [.., Digest3..Digest0]                  Replied to with an ACK of the resume point.
+        DATA:   [.., Offset3..Offset0, Data...]         Up to ESPNOW_FLASH_MAX_DATA bytes of binary.
+    Node -> Host: [ESPNOW_FLASH_PACKET, Op, DEVICE_ID, ...]
+        ACK:    [.., Offset3..Offset0]                  Every byte before Offset is received.
+        NACK:   [.., Offset3..Offset0]                  Data arrived out of order, resend from Offset.
+        COMMIT: [.., eReflashCommit_t]                  Sent once the whole image is received.
+
+    The host keeps a window of DATA packets in flight and goes back to the offset of a NACK, or of
+    the last ACK if nothing is heard for a while. Only in order data is written.
+
+    Pit bridge: building with ESPNOW_FLASH_BRIDGE defined turns a node into a USB to ESP-NOW bridge.
+    Packets are SLIP framed on the USB serial port as [MAC0..MAC5, ESP-NOW payload], the MAC is the
+    destination from the host and the source towards the host.
+*/
+
+// #define ESPNOW_FLASH_BRIDGE      // Uncomment to build the pit laptop bridge
+
+#define ESPNOW_FLASH_PACKET         0xF1
+#define ESPNOW_FLASH_OP_ENTER       0x01
+#define ESPNOW_FLASH_OP_QUERY       0x02
+#define ESPNOW_FLASH_OP_DATA        0x03
+#define ESPNOW_FLASH_OP_ACK         0x81
+#define ESPNOW_FLASH_OP_NACK        0x82
+#define ESPNOW_FLASH_OP_COMMIT      0x83
+
+#define ESPNOW_FLASH_HEADER_SIZE    3   // Packet marker, Op, DEVICE_ID
+#define ESPNOW_FLASH_DATA_HEADER_SIZE (ESPNOW_FLASH_HEADER_SIZE + 4)
+#define ESPNOW_FLASH_MAX_DATA       (MAX_ESPNOW_PAYLOAD - ESPNOW_FLASH_DATA_HEADER_SIZE)
+
+esp_err_t ESPNOW_flash_init(void);
+void ESPNOW_flash_rx(const uint8_t *abySourceMAC, const byte *abyData, int NLength);
+esp_err_t ESPNOW_flash_empty_queue(esp_partition_t *stOTAPartition);
+esp_err_t ESPNOW_flash_send_commit(eReflashCommit_t eResult);
+void ESPNOW_flash_stop(void);
+#ifdef ESPNOW_FLASH_BRIDGE
+esp_err_t ESPNOW_flash_bridge_service(void);
+#endif
+
+#endif // SFRESPNowFlash
@@ -0,0 +1,197 @@
+/*
+espnowlink.c
+File contains the PHY rate choice for ESP-NOW peers, kept free of the radio so it can be run on a
+host against recorded link traces.
+
+Written by Cole Perera for Sheffield Formula Racing 2026
+*/
+
+#include "espnowlink.h"
+#include "string.h"
+
+/* --------------------------- Local Variables ------------------------ */
+/* Rx sensitivity of each rate in dBm, from the ESP32-C6 datasheet rounded down */
+static const sbyte asbySensitivity[eLINK_RATE_TOTAL] = { -103, -100, -98, -95, -92, -89, -83 };
+static const char *asRateName[eLINK_RATE_TOTAL] = { "LR 250K", "LR 500K", "1M", "2M", "6M", "12M", "24M" };
+
+/* --------------------------- Function prototypes --------------------- */
+static void ESPNOW_link_change(stESPNOWLinkPeer_t *stPeer, eESPNOWLinkRate_t eRate);
+
+/* --------------------------- Functions ----------------------------- */
+void ESPNOW_link_init(stESPNOWLinkPeer_t *stPeer, eESPNOWLinkRate_t eRate)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_link_init
+    *   Takes:   stPeer - peer to start
+    *            eRate - rate the radio is on
+    *
+    *   Returns: None
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    memset(stPeer, 0, sizeof(*stPeer));
+    stPeer->eRate = eRate;
+    stPeer->byNUpWindows = ESPNOW_LINK_UP_WINDOWS_MIN;
+    stPeer->sbyRSSI = ESPNOW_LINK_NO_RSSI;
+}
+
+boolean ESPNOW_link_update(stESPNOWLinkPeer_t *stPeer, const stESPNOWLinkSample_t *stSample, word wSamplems)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_link_update
+    *   Takes:   stPeer - peer the sample is for
+    *            stSample - packets and RSSI since the last sample
+    *            wSamplems - time the sample covers
+    *
+    *   Returns: TRUE if stPeer->eRate has changed and the radio should follow.
+    *
+    *   Adds the sample to the rate's totals and the window, then judges the
+    *   window once it is ESPNOW_LINK_WINDOW_MS long with enough packets in it,
+    *   see espnowlink.h. A quiet link keeps filling the same window.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    eESPNOWLinkRate_t eRate = stPeer->eRate;
+    boolean BBad;
+    sbyte sbyRSSI = ESPNOW_LINK_NO_RSSI;
+
+    stPeer->adwBytes[eRate] += stSample->dwNBytes;
+    stPeer->adwTimems[eRate] += wSamplems;
+    stPeer->adwNSent[eRate] += stSample->wNSent;
+    stPeer->adwNDelivered[eRate] += stSample->wNDelivered;
+
+    stPeer->dwNWindowSent += stSample->wNSent;
+    stPeer->dwNWindowDelivered += stSample->wNDelivered;
+    stPeer->dwWindowms += wSamplems;
+    if (stSample->sbyRSSI != ESPNOW_LINK_NO_RSSI)
+    {
+        stPeer->sdwRSSISum += stSample->sbyRSSI;
+        stPeer->dwNRSSI++;
+    }
+    if (stPeer->dwWindowms < ESPNOW_LINK_WINDOW_MS || stPeer->dwNWindowSent < ESPNOW_LINK_MIN_PACKETS)
+    {
+        return FALSE;
+    }
+
+    /* Judge the window */
+    stPeer->byDeliveryPercent = (byte)((stPeer->dwNWindowDelivered * 100) / stPeer->dwNWindowSent);
+    if (stPeer->dwNRSSI > 0)
+    {
+        sbyRSSI = (sbyte)(stPeer->sdwRSSISum / (sdword)stPeer->dwNRSSI);
+    }
+    stPeer->sbyRSSI = sbyRSSI;
+    stPeer->dwNWindowSent = 0;
+    stPeer->dwNWindowDelivered = 0;
+    stPeer->sdwRSSISum = 0;
+    stPeer->dwNRSSI = 0;
+    stPeer->dwWindowms = 0;
+
+    BBad = stPeer->byDeliveryPercent < ESPNOW_LINK_DOWN_PERCENT ||
+        (sbyRSSI != ESPNOW_LINK_NO_RSSI && sbyRSSI < asbySensitivity[eRate] + ESPNOW_LINK_RSSI_MARGIN_DB);
+    if (BBad)
+    {
+        if (stPeer->BProbing && stPeer->byNUpWindows < ESPNOW_LINK_UP_WINDOWS_MAX)
+        {
+            /* The faster rate did not hold, wait longer before trying it again */
+            stPeer->byNUpWindows *= 2;
+        }
+        stPeer->BProbing = FALSE;
+        stPeer->byNGoodWindows = 0;
+        if (eRate == eLINK_RATE_LR_250K)
+        {
+            return FALSE;
+        }
+        ESPNOW_link_change(stPeer, eRate - 1);
+        return TRUE;
+    }
+
+    if (stPeer->byDeliveryPercent < ESPNOW_LINK_UP_PERCENT)
+    {
+        stPeer->byNGoodWindows = 0;
+        return FALSE;
+    }
+    if (stPeer->byNGoodWindows < stPeer->byNUpWindows)
+    {
+        stPeer->byNGoodWindows++;
+    }
+    if (stPeer->byNGoodWindows < stPeer->byNUpWindows)
+    {
+        return FALSE;
+    }
+    if (stPeer->BProbing)
+    {
+        /* The rate held, come down from any back off */
+        stPeer->BProbing = FALSE;
+        if (stPeer->byNUpWindows > ESPNOW_LINK_UP_WINDOWS_MIN)
+        {
+            stPeer->byNUpWindows /= 2;
+        }
+    }
+    if (eRate + 1 >= eLINK_RATE_TOTAL ||
+        (sbyRSSI != ESPNOW_LINK_NO_RSSI &&
+         sbyRSSI < asbySensitivity[eRate + 1] + ESPNOW_LINK_RSSI_MARGIN_DB + ESPNOW_LINK_RSSI_HYSTERESIS_DB))
+    {
+        return FALSE;
+    }
+    ESPNOW_link_change(stPeer, eRate + 1);
+    stPeer->BProbing = TRUE;
+    return TRUE;
+}
+
+dword ESPNOW_link_goodput(const stESPNOWLinkPeer_t *stPeer, eESPNOWLinkRate_t eRate)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_link_goodput
+    *   Takes:   stPeer - peer
+    *            eRate - rate wanted
+    *
+    *   Returns: Payload delivered per second while on the rate, 0 if never used.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    if (stPeer->adwTimems[eRate] == 0)
+    {
+        return 0;
+    }
+    return (dword)(((qword)stPeer->adwBytes[eRate] * 1000) / stPeer->adwTimems[eRate]);
+}
+
+const char *ESPNOW_link_rate_name(eESPNOWLinkRate_t eRate)
+{
+    /* Name of the rate for logging */
+    return eRate < eLINK_RATE_TOTAL ? asRateName[eRate] : "?";
+}
+
+static void ESPNOW_link_change(stESPNOWLinkPeer_t *stPeer, eESPNOWLinkRate_t eRate)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_link_change
+    *   Takes:   stPeer - peer
+    *            eRate - new rate
+    *
+    *   Returns: None
+    *
+    *   Moves to the rate, the good windows start again from nothing.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    stPeer->eRate = eRate;
+    stPeer->byNGoodWindows = 0;
+    stPeer->dwNChanges++;
+}
@@ -0,0 +1,82 @@
+/* Only define once */
+#ifndef SFRESPNowLink
+#define SFRESPNowLink
+
+#include "sfrtypes.h"
+
+/*  ESP-NOW Link Adaptation
+    Picks the PHY rate for a peer from how its packets get through. Every ESPNOW_LINK_SAMPLE_MS the
+    packets sent, those delivered and the RSSI of packets heard from the peer are added, and each
+    ESPNOW_LINK_WINDOW_MS with at least ESPNOW_LINK_MIN_PACKETS sent is judged:
+        Down a rate straight away if under ESPNOW_LINK_DOWN_PERCENT were delivered or the RSSI is
+        under the rate's sensitivity plus ESPNOW_LINK_RSSI_MARGIN_DB.
+        Up a rate after byNUpWindows windows in a row over ESPNOW_LINK_UP_PERCENT, with the RSSI,
+        if heard, ESPNOW_LINK_RSSI_HYSTERESIS_DB over what the faster rate needs to be kept.
+        A step up is a probe until it has held for as many good windows as were waited for it. A
+        bad window in that time goes back down and doubles the windows wanted next time, up to
+        ESPNOW_LINK_UP_WINDOWS_MAX, so a marginal link does not flap. A probe that holds halves it.
+    Nothing here touches the radio so it runs the same on the host, see
+    util/reflash_sim/link_replay.py. espnow.c maps the rates to the radio's.
+*/
+#define ESPNOW_LINK_SAMPLE_MS           100
+#define ESPNOW_LINK_WINDOW_MS           500
+#define ESPNOW_LINK_MIN_PACKETS         8
+#define ESPNOW_LINK_DOWN_PERCENT        90
+#define ESPNOW_LINK_UP_PERCENT          95
+#define ESPNOW_LINK_RSSI_MARGIN_DB      0
+#define ESPNOW_LINK_RSSI_HYSTERESIS_DB  3
+#define ESPNOW_LINK_UP_WINDOWS_MIN      6
+#define ESPNOW_LINK_UP_WINDOWS_MAX      24      // A power of two times the MIN
+#define ESPNOW_LINK_NO_RSSI             ((sbyte)-128)
+
+typedef enum {
+    eLINK_RATE_LR_250K = 0,     // Long range, both ends need WIFI_PROTOCOL_LR
+    eLINK_RATE_LR_500K,
+    eLINK_RATE_1M,              // ESP-NOW's default
+    eLINK_RATE_2M,
+    eLINK_RATE_6M,
+    eLINK_RATE_12M,
+    eLINK_RATE_24M,
+    eLINK_RATE_TOTAL
+} eESPNOWLinkRate_t;
+
+typedef struct {
+    word wNSent;
+    word wNDelivered;
+    dword dwNBytes;             // Payload delivered
+    sbyte sbyRSSI;              // Mean of the packets heard from the peer, ESPNOW_LINK_NO_RSSI if none
+} stESPNOWLinkSample_t;
+
+typedef struct {
+    eESPNOWLinkRate_t eRate;
+
+    /* Window being filled */
+    dword dwNWindowSent;
+    dword dwNWindowDelivered;
+    sdword sdwRSSISum;
+    dword dwNRSSI;
+    dword dwWindowms;
+
+    /* Hysteresis */
+    byte byNGoodWindows;
+    byte byNUpWindows;          // Good windows wanted before stepping up
+    boolean BProbing;           // Stepped up and not yet held for byNUpWindows
+
+    /* Last window judged */
+    byte byDeliveryPercent;
+    sbyte sbyRSSI;
+
+    /* Totals for each rate */
+    dword adwBytes[eLINK_RATE_TOTAL];
+    dword adwTimems[eLINK_RATE_TOTAL];
+    dword adwNSent[eLINK_RATE_TOTAL];
+    dword adwNDelivered[eLINK_RATE_TOTAL];
+    dword dwNChanges;
+} stESPNOWLinkPeer_t;
+
+void ESPNOW_link_init(stESPNOWLinkPeer_t *stPeer, eESPNOWLinkRate_t eRate);
+boolean ESPNOW_link_update(stESPNOWLinkPeer_t *stPeer, const stESPNOWLinkSample_t *stSample, word wSamplems);
+dword ESPNOW_link_goodput(const stESPNOWLinkPeer_t *stPeer, eESPNOWLinkRate_t eRate);
+const char *ESPNOW_link_rate_name(eESPNOWLinkRate_t eRate);
+
+#endif // SFRESPNowLink
@@ -0,0 +1,832 @@
+/*
+espnowtelem.c
+File contains the sequencing, reordering and link statistics of the ESP-NOW telemetry.
+
+Written by Cole Perera for Sheffield Formula Racing 2026
+*/
+
+#include "espnowtelem.h"
+#include "espnowcodec.h"
+#include "sfrtypes.h"
+
+/* --------------------------- Definitions ----------------------------- */
+#define ESPNOW_TELEM_RX_RING_LENGTH     16      // Power of 2, packets waiting to be put in order
+#define ESPNOW_TELEM_RESTART_WINDOW     1024    // Seq this far behind means the sender restarted
+#define ESPNOW_TELEM_NO_DELAY           0x7FFFFFFF
+#define LATENCY_SUB_BUCKETS             4       // Buckets per doubling of latency
+#define LATENCY_NBUCKETS                92      // Latencies up to 2^24 us
+#define LATENCY_MAX_US                  0x00FFFFFF
+#define LATENCY_UNIT_US                 100     // Units of the latency stats frame
+
+/* --------------------------- Local Types ----------------------------- */
+typedef struct {
+    qword qwtRx;
+    byte byNLength;
+    byte abyData[MAX_ESPNOW_PAYLOAD];
+} stESPNOWTelemPacket_t;
+
+typedef struct {
+    dword adwBuckets[LATENCY_NBUCKETS];
+    dword dwN;
+    dword dwMax;
+} stESPNOWTelemLatency_t;
+
+typedef struct {
+    word wStartSeq;
+    word wNLost;
+    dword dwTime;       // ms since power up the gap was given up on
+} stESPNOWTelemGap_t;
+
+/* --------------------------- Local Variables ------------------------ */
+extern dword dwNDroppedTelemFrames;
+extern QueueHandle_t xESPNOWTelemBuffer;
+extern dword dwTimeSincePowerUpms;
+static boolean bTelemStarted = FALSE;
+static qword qwtLastStats = 0;
+
+/* Rx packet ring, only the ESP-NOW Rx callback moves the head and only ESPNOW_telem_service the tail */
+static stESPNOWTelemPacket_t astRxRing[ESPNOW_TELEM_RX_RING_LENGTH];
+static volatile word wRxRingHead = 0;
+static volatile word wRxRingTail = 0;
+
+/* Sender, the counts are only written from the ESP-NOW send callback */
+static word awTxSeq[eTELEM_LANE_TOTAL];
+static volatile dword dwNTxOK = 0;
+static volatile dword dwNTxFail = 0;
+static dword dwLastNTxOK = 0;
+static dword dwLastNTxFail = 0;
+static dword dwLastNDroppedTelemFrames = 0;
+
+/* Receiver stream */
+static boolean bStreamStarted = FALSE;
+static byte byStreamNode = 0;
+static word wNextSeq = 0;
+static stESPNOWTelemPacket_t astReorder[ESPNOW_TELEM_REORDER_DEPTH];
+static boolean abReorderUsed[ESPNOW_TELEM_REORDER_DEPTH];
+static byte byNHeld = 0;
+
+/* Receiver statistics, totals are since the stream started the rest are for this period */
+static dword dwNRxTotal = 0;
+static dword dwNLostTotal = 0;
+static dword dwNRx = 0;
+static dword dwNLost = 0;
+static dword dwNReordered = 0;
+static dword dwNLate = 0;
+static volatile dword dwNQueueFull = 0;
+static stESPNOWTelemGap_t astGaps[ESPNOW_TELEM_MAX_GAPS];
+static byte byGapIndex = 0;
+static byte byNNewGaps = 0;
+
+/* Receiver priority lane, delivered as it arrives so only the next Seq is kept */
+static boolean bPriorityStarted = FALSE;
+static byte byPriorityNode = 0;
+static word wNextPrioritySeq = 0;
+static dword dwNPriorityLost = 0;
+
+/* Latency, for each lane */
+static stESPNOWTelemLatency_t astLatency[eTELEM_LANE_TOTAL];
+static int32_t sdwMinDelay = ESPNOW_TELEM_NO_DELAY;
+static int32_t sdwPrevMinDelay = ESPNOW_TELEM_NO_DELAY;
+static qword qwtOffsetWindow = 0;
+
+/* --------------------------- Function prototypes --------------------- */
+static void ESPNOW_telem_accept(const stESPNOWTelemPacket_t *stPacket);
+static void ESPNOW_telem_accept_priority(const stESPNOWTelemPacket_t *stPacket);
+static void ESPNOW_telem_reset_stream(byte byNode, word wSeq);
+static void ESPNOW_telem_skip(void);
+static void ESPNOW_telem_release(void);
+static void ESPNOW_telem_flush_timeout(qword qwtNow);
+static void ESPNOW_telem_send_stats(void);
+static void ESPNOW_telem_log_gaps(void);
+static byte ESPNOW_telem_latency_bucket(dword dwLatency);
+static dword ESPNOW_telem_latency_percentile(const stESPNOWTelemLatency_t *stLatency, byte byPercent);
+static word ESPNOW_telem_latency_units(dword dwLatency);
+static word ESPNOW_telem_clamp_word(dword dwValue);
+static word ESPNOW_telem_seq(const stESPNOWTelemPacket_t *stPacket);
+
+/* --------------------------- Functions ----------------------------- */
+esp_err_t ESPNOW_telem_init(void)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_telem_init
+    *   Takes:   None
+    *
+    *   Returns: ESP_OK if successful, error code if not.
+    *
+    *   Starts the telemetry statistics, the packet ring is static. Run from
+    *   ESPNOW_init.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Packet ring instead of a queue
+    *
+    *===========================================================================
+    */
+    bTelemStarted = TRUE;
+    qwtLastStats = (qword)esp_timer_get_time();
+    qwtOffsetWindow = qwtLastStats;
+    return ESP_OK;
+}
+
+void ESPNOW_telem_rx(const byte *abyData, int NLength)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_telem_rx
+    *   Takes:   abyData - received telemetry packet
+    *            NLength - length of the packet
+    *
+    *   Returns: None
+    *
+    *   Called from the ESP-NOW Rx callback. Copies the packet into the ring
+    *   with its Rx time for ESPNOW_telem_service, nothing lengthy is done here.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP One copy straight into the packet ring
+    *
+    *===========================================================================
+    */
+    word wHead = wRxRingHead;
+    stESPNOWTelemPacket_t *stPacket;
+
+    if (NLength < ESPNOW_TELEM_HEADER_SIZE || NLength > MAX_ESPNOW_PAYLOAD || !bTelemStarted)
+    {
+        return;
+    }
+    if ((word)(wHead - wRxRingTail) >= ESPNOW_TELEM_RX_RING_LENGTH)
+    {
+        dwNQueueFull++;
+        return;
+    }
+    stPacket = &astRxRing[wHead % ESPNOW_TELEM_RX_RING_LENGTH];
+    stPacket->qwtRx = (qword)esp_timer_get_time();
+    stPacket->byNLength = (byte)NLength;
+    memcpy(stPacket->abyData, abyData, NLength);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    wRxRingHead = wHead + 1;
+}
+
+void ESPNOW_telem_tx_done(boolean bSuccess)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_telem_tx_done
+    *   Takes:   bSuccess - TRUE if the peer acknowledged the packet
+    *
+    *   Returns: None
+    *
+    *   Called from the ESP-NOW send callback to count delivered and failed
+    *   packets.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    if (bSuccess)
+    {
+        dwNTxOK++;
+    }
+    else
+    {
+        dwNTxFail++;
+    }
+}
+
+word ESPNOW_telem_next_seq(eESPNOWTelemLane_t eLane)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_telem_next_seq
+    *   Takes:   eLane - lane the packet is sent in
+    *
+    *   Returns: The sequence number for the next telemetry packet sent in the
+    *            lane, each lane counts its own.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Sequence for each lane
+    *
+    *===========================================================================
+    */
+    return awTxSeq[eLane]++;
+}
+
+void ESPNOW_telem_frame_latency(eESPNOWTelemLane_t eLane, dword dwFrameTime, qword qwtRx)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_telem_frame_latency
+    *   Takes:   eLane - lane the frame came in
+    *            dwFrameTime - low 32 bits of the frame's Rx time on the sender in us
+    *            qwtRx - time the packet carrying it was received here in us
+    *
+    *   Returns: None
+    *
+    *   Adds a frame to its lane's latency histogram. The clocks are not
+    *   synchronised so the latency is the delay above the smallest delay seen
+    *   by either lane over the last ESPNOW_TELEM_OFFSET_WINDOW_US, which
+    *   follows the drift between clocks.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Histogram for each lane
+    *
+    *===========================================================================
+    */
+    stESPNOWTelemLatency_t *stLatency = &astLatency[eLane];
+    int32_t sdwDelay = (int32_t)((uint32_t)qwtRx - (uint32_t)dwFrameTime);
+    int32_t sdwFloor;
+    dword dwLatency;
+
+    if (sdwDelay < sdwMinDelay)
+    {
+        sdwMinDelay = sdwDelay;
+    }
+    sdwFloor = sdwPrevMinDelay < sdwMinDelay ? sdwPrevMinDelay : sdwMinDelay;
+    dwLatency = (dword)((sqword)sdwDelay - sdwFloor);
+    if (dwLatency > LATENCY_MAX_US)
+    {
+        dwLatency = LATENCY_MAX_US;
+    }
+
+    stLatency->adwBuckets[ESPNOW_telem_latency_bucket(dwLatency)]++;
+    stLatency->dwN++;
+    if (dwLatency > stLatency->dwMax)
+    {
+        stLatency->dwMax = dwLatency;
+    }
+}
+
+esp_err_t ESPNOW_telem_service(void)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_telem_service
+    *   Takes:   None
+    *
+    *   Returns: ESP_OK if successful, error code if not.
+    *
+    *   Run from the background task. Puts received telemetry packets back in
+    *   order and passes them to ESPNOW_fill_buffer, gives up on missing
+    *   packets after ESPNOW_TELEM_REORDER_TIMEOUT_US and sends the link
+    *   statistics every ESPNOW_TELEM_STATS_PERIOD_MS. Priority packets are
+    *   passed straight on. Every packet waiting is taken in one go and read
+    *   in place, the ring slots are freed once they are all done.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Priority lane
+    *   18/10/26 CP Takes the packets waiting in the ring in one go
+    *
+    *===========================================================================
+    */
+    stESPNOWTelemPacket_t *stPacket;
+    word wTail = wRxRingTail;
+    word wHead;
+    qword qwtNow;
+
+    if (!bTelemStarted)
+    {
+        return ESP_OK;
+    }
+
+    wHead = wRxRingHead;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    for (; wTail != wHead; wTail++)
+    {
+        stPacket = &astRxRing[wTail % ESPNOW_TELEM_RX_RING_LENGTH];
+        if (stPacket->abyData[0] == ESPNOW_TELEM_PRIORITY_PACKET)
+        {
+            ESPNOW_telem_accept_priority(stPacket);
+        }
+        else
+        {
+            ESPNOW_telem_accept(stPacket);
+        }
+    }
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    wRxRingTail = wTail;
+
+    qwtNow = (qword)esp_timer_get_time();
+    ESPNOW_telem_flush_timeout(qwtNow);
+
+    /* Start a new window for the clock offset, the last one still counts until this one fills */
+    if (qwtNow - qwtOffsetWindow >= ESPNOW_TELEM_OFFSET_WINDOW_US)
+    {
+        qwtOffsetWindow = qwtNow;
+        sdwPrevMinDelay = sdwMinDelay;
+        sdwMinDelay = ESPNOW_TELEM_NO_DELAY;
+    }
+
+    if (qwtNow - qwtLastStats >= (qword)ESPNOW_TELEM_STATS_PERIOD_MS * 1000)
+    {
+        qwtLastStats = qwtNow;
+        ESPNOW_telem_send_stats();
+    }
+    return ESP_OK;
+}
+
+static void ESPNOW_telem_accept(const stESPNOWTelemPacket_t *stPacket)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_telem_accept
+    *   Takes:   stPacket - a received telemetry packet
+    *
+    *   Returns: None
+    *
+    *   Delivers the packet if it is the next in sequence, otherwise holds it
+    *   until the missing ones arrive or are given up on. Anything behind the
+    *   stream is late or a duplicate and dropped.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    byte byNode = stPacket->abyData[1];
+    word wSeq = ESPNOW_telem_seq(stPacket);
+    sword swAhead = (sword)(wSeq - wNextSeq);
+    byte bySlot;
+
+    if (!bStreamStarted || byNode != byStreamNode || swAhead < -ESPNOW_TELEM_RESTART_WINDOW)
+    {
+        if (bStreamStarted)
+        {
+            ESP_LOGW("ESP-NOW", "Telemetry stream restarted by node 0x%02X at seq %u", byNode, wSeq);
+        }
+        ESPNOW_telem_reset_stream(byNode, wSeq);
+        swAhead = 0;
+    }
+    if (swAhead < 0)
+    {
+        dwNLate++;
+        return;
+    }
+
+    /* Too far ahead to hold, give up on the oldest missing packets to make room */
+    while ((sword)(wSeq - wNextSeq) >= ESPNOW_TELEM_REORDER_DEPTH)
+    {
+        ESPNOW_telem_skip();
+    }
+
+    if (wSeq == wNextSeq)
+    {
+        if (byNHeld > 0)
+        {
+            /* Packets behind this one already arrived */
+            dwNReordered++;
+        }
+        dwNRx++;
+        dwNRxTotal++;
+        wNextSeq++;
+        (void)ESPNOW_fill_buffer(stPacket->abyData, stPacket->byNLength, stPacket->qwtRx);
+        ESPNOW_telem_release();
+        return;
+    }
+
+    bySlot = wSeq % ESPNOW_TELEM_REORDER_DEPTH;
+    if (abReorderUsed[bySlot])
+    {
+        dwNLate++;
+        return;
+    }
+    astReorder[bySlot] = *stPacket;
+    abReorderUsed[bySlot] = TRUE;
+    byNHeld++;
+}
+
+static void ESPNOW_telem_accept_priority(const stESPNOWTelemPacket_t *stPacket)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_telem_accept_priority
+    *   Takes:   stPacket - a received priority packet
+    *
+    *   Returns: None
+    *
+    *   Delivers the packet straight away, holding it back for a missing one
+    *   would undo the point of the lane. Packets skipped over are counted as
+    *   lost and anything behind the lane is late or a duplicate and dropped.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    byte byNode = stPacket->abyData[1];
+    word wSeq = ESPNOW_telem_seq(stPacket);
+    sword swAhead = (sword)(wSeq - wNextPrioritySeq);
+
+    if (!bPriorityStarted || byNode != byPriorityNode || swAhead < -ESPNOW_TELEM_RESTART_WINDOW)
+    {
+        bPriorityStarted = TRUE;
+        byPriorityNode = byNode;
+        swAhead = 0;
+    }
+    if (swAhead < 0)
+    {
+        dwNLate++;
+        return;
+    }
+    dwNPriorityLost += (dword)swAhead;
+    wNextPrioritySeq = wSeq + 1;
+    (void)ESPNOW_fill_buffer(stPacket->abyData, stPacket->byNLength, stPacket->qwtRx);
+}
+
+static void ESPNOW_telem_reset_stream(byte byNode, word wSeq)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_telem_reset_stream
+    *   Takes:   byNode - DEVICE_ID of the sender
+    *            wSeq - sequence number to start from
+    *
+    *   Returns: None
+    *
+    *   Starts following a new telemetry stream, the sender has a new clock so
+    *   the latency floor is measured again and its delta references are gone.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Forgets the delta references
+    *
+    *===========================================================================
+    */
+    bStreamStarted = TRUE;
+    byStreamNode = byNode;
+    wNextSeq = wSeq;
+    memset(abReorderUsed, 0, sizeof(abReorderUsed));
+    byNHeld = 0;
+    dwNRxTotal = 0;
+    dwNLostTotal = 0;
+    sdwMinDelay = ESPNOW_TELEM_NO_DELAY;
+    sdwPrevMinDelay = ESPNOW_TELEM_NO_DELAY;
+    qwtOffsetWindow = (qword)esp_timer_get_time();
+    ESPNOW_codec_reset_rx();
+}
+
+static void ESPNOW_telem_skip(void)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_telem_skip
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Moves the stream on by one packet, delivering it if held or counting it
+    *   as lost. Consecutive lost packets are kept as one gap. A lost packet
+    *   may have changed any delta reference so they are all forgotten.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Forgets the delta references on a loss
+    *
+    *===========================================================================
+    */
+    byte bySlot = wNextSeq % ESPNOW_TELEM_REORDER_DEPTH;
+    stESPNOWTelemGap_t *stGap = &astGaps[(byGapIndex + ESPNOW_TELEM_MAX_GAPS - 1) % ESPNOW_TELEM_MAX_GAPS];
+
+    if (abReorderUsed[bySlot] && ESPNOW_telem_seq(&astReorder[bySlot]) == wNextSeq)
+    {
+        ESPNOW_telem_release();
+        return;
+    }
+
+    if (byNNewGaps > 0 && (word)(stGap->wStartSeq + stGap->wNLost) == wNextSeq)
+    {
+        stGap->wNLost++;
+    }
+    else
+    {
+        stGap = &astGaps[byGapIndex];
+        stGap->wStartSeq = wNextSeq;
+        stGap->wNLost = 1;
+        stGap->dwTime = dwTimeSincePowerUpms;
+        byGapIndex = (byGapIndex + 1) % ESPNOW_TELEM_MAX_GAPS;
+        if (byNNewGaps < ESPNOW_TELEM_MAX_GAPS)
+        {
+            byNNewGaps++;
+        }
+    }
+    dwNLost++;
+    dwNLostTotal++;
+    wNextSeq++;
+    ESPNOW_codec_reset_rx();
+}
+
+static void ESPNOW_telem_release(void)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_telem_release
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Delivers the held packets that are now next in sequence.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    byte bySlot = wNextSeq % ESPNOW_TELEM_REORDER_DEPTH;
+
+    while (abReorderUsed[bySlot] && ESPNOW_telem_seq(&astReorder[bySlot]) == wNextSeq)
+    {
+        abReorderUsed[bySlot] = FALSE;
+        byNHeld--;
+        dwNRx++;
+        dwNRxTotal++;
+        wNextSeq++;
+        (void)ESPNOW_fill_buffer(astReorder[bySlot].abyData, astReorder[bySlot].byNLength, astReorder[bySlot].qwtRx);
+        bySlot = wNextSeq % ESPNOW_TELEM_REORDER_DEPTH;
+    }
+}
+
+static void ESPNOW_telem_flush_timeout(qword qwtNow)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_telem_flush_timeout
+    *   Takes:   qwtNow - current time in us
+    *
+    *   Returns: None
+    *
+    *   Gives up on the packets missing in front of a packet held for longer
+    *   than ESPNOW_TELEM_REORDER_TIMEOUT_US.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    qword qwtOldest = qwtNow;
+
+    for (byte byNSlot = 0; byNSlot < ESPNOW_TELEM_REORDER_DEPTH; byNSlot++)
+    {
+        if (abReorderUsed[byNSlot] && astReorder[byNSlot].qwtRx < qwtOldest)
+        {
+            qwtOldest = astReorder[byNSlot].qwtRx;
+        }
+    }
+    while (byNHeld > 0 && qwtNow - qwtOldest >= ESPNOW_TELEM_REORDER_TIMEOUT_US)
+    {
+        ESPNOW_telem_skip();
+        qwtOldest = qwtNow;
+        for (byte byNSlot = 0; byNSlot < ESPNOW_TELEM_REORDER_DEPTH; byNSlot++)
+        {
+            if (abReorderUsed[byNSlot] && astReorder[byNSlot].qwtRx < qwtOldest)
+            {
+                qwtOldest = astReorder[byNSlot].qwtRx;
+            }
+        }
+    }
+}
+
+static void ESPNOW_telem_send_stats(void)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_telem_send_stats
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Sends the link statistics for the last period as CAN frames, see
+    *   espnowtelem.h. The sender's go out in its telemetry, the receiver's on
+    *   its own bus with the frames it received.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Priority lane latency and loss
+    *   18/10/26 CP Rx path statistics
+    *   18/10/26 CP Sender's drops are the telemetry queue's
+    *
+    *===========================================================================
+    */
+    CAN_frame_t stFrame;
+    dword dwTxOK = dwNTxOK;
+    dword dwTxFail = dwNTxFail;
+    dword dwDropped = dwNDroppedTelemFrames;
+    stESPNOWTelemLatency_t *stLatency;
+    word wValue;
+
+    /* Sender */
+    if (dwTxOK != dwLastNTxOK || dwTxFail != dwLastNTxFail)
+    {
+        memset(&stFrame, 0, sizeof(stFrame));
+        stFrame.dwID = ESPNOW_TELEM_TX_STATS_ID;
+        stFrame.byDLC = 8;
+        stFrame.abData[0] = DEVICE_ID;
+        wValue = ESPNOW_telem_clamp_word(dwTxOK - dwLastNTxOK);
+        stFrame.abData[1] = (byte)(wValue >> 8);
+        stFrame.abData[2] = (byte)wValue;
+        wValue = ESPNOW_telem_clamp_word(dwTxFail - dwLastNTxFail);
+        stFrame.abData[3] = (byte)(wValue >> 8);
+        stFrame.abData[4] = (byte)wValue;
+        wValue = ESPNOW_telem_clamp_word(dwDropped - dwLastNDroppedTelemFrames);
+        stFrame.abData[5] = (byte)(wValue >> 8);
+        stFrame.abData[6] = (byte)wValue;
+        CAN_set_rx_time(&stFrame, (qword)esp_timer_get_time());
+        if (xESPNOWTelemBuffer != NULL)
+        {
+            (void)xQueueSend(xESPNOWTelemBuffer, &stFrame, 0);
+        }
+    }
+    dwLastNTxOK = dwTxOK;
+    dwLastNTxFail = dwTxFail;
+    dwLastNDroppedTelemFrames = dwDropped;
+
+    /* Receiver */
+    if (!bStreamStarted)
+    {
+        return;
+    }
+
+    memset(&stFrame, 0, sizeof(stFrame));
+    stFrame.dwID = ESPNOW_TELEM_RX_STATS_ID;
+    stFrame.byDLC = 8;
+    stFrame.abData[0] = byStreamNode;
+    wValue = (word)(((qword)dwNLostTotal * 10000) / (dwNRxTotal + dwNLostTotal > 0 ? dwNRxTotal + dwNLostTotal : 1));
+    stFrame.abData[1] = (byte)(wValue >> 8);
+    stFrame.abData[2] = (byte)wValue;
+    wValue = ESPNOW_telem_clamp_word(dwNLost);
+    stFrame.abData[3] = (byte)(wValue >> 8);
+    stFrame.abData[4] = (byte)wValue;
+    wValue = ESPNOW_telem_clamp_word(dwNRx);
+    stFrame.abData[5] = (byte)(wValue >> 8);
+    stFrame.abData[6] = (byte)wValue;
+    stFrame.abData[7] = (byte)(dwNReordered > 0xFF ? 0xFF : dwNReordered);
+    ESPNOW_rx_frame_put(&stFrame);
+
+    memset(&stFrame, 0, sizeof(stFrame));
+    stFrame.dwID = ESPNOW_TELEM_LATENCY_ID;
+    stFrame.byDLC = 8;
+    stLatency = &astLatency[eTELEM_LANE_BULK];
+    wValue = ESPNOW_telem_latency_units(ESPNOW_telem_latency_percentile(stLatency, 50));
+    stFrame.abData[0] = (byte)(wValue >> 8);
+    stFrame.abData[1] = (byte)wValue;
+    wValue = ESPNOW_telem_latency_units(ESPNOW_telem_latency_percentile(stLatency, 95));
+    stFrame.abData[2] = (byte)(wValue >> 8);
+    stFrame.abData[3] = (byte)wValue;
+    wValue = ESPNOW_telem_latency_units(ESPNOW_telem_latency_percentile(stLatency, 99));
+    stFrame.abData[4] = (byte)(wValue >> 8);
+    stFrame.abData[5] = (byte)wValue;
+    wValue = ESPNOW_telem_latency_units(stLatency->dwMax);
+    stFrame.abData[6] = (byte)(wValue >> 8);
+    stFrame.abData[7] = (byte)wValue;
+    ESPNOW_rx_frame_put(&stFrame);
+
+    /* Priority lane, only once it has been heard */
+    if (bPriorityStarted)
+    {
+        memset(&stFrame, 0, sizeof(stFrame));
+        stFrame.dwID = ESPNOW_TELEM_PRIORITY_ID;
+        stFrame.byDLC = 8;
+        stLatency = &astLatency[eTELEM_LANE_PRIORITY];
+        wValue = ESPNOW_telem_latency_units(ESPNOW_telem_latency_percentile(stLatency, 50));
+        stFrame.abData[0] = (byte)(wValue >> 8);
+        stFrame.abData[1] = (byte)wValue;
+        wValue = ESPNOW_telem_latency_units(ESPNOW_telem_latency_percentile(stLatency, 99));
+        stFrame.abData[2] = (byte)(wValue >> 8);
+        stFrame.abData[3] = (byte)wValue;
+        wValue = ESPNOW_telem_latency_units(stLatency->dwMax);
+        stFrame.abData[4] = (byte)(wValue >> 8);
+        stFrame.abData[5] = (byte)wValue;
+        wValue = ESPNOW_telem_clamp_word(dwNPriorityLost);
+        stFrame.abData[6] = (byte)(wValue >> 8);
+        stFrame.abData[7] = (byte)wValue;
+        ESPNOW_rx_frame_put(&stFrame);
+    }
+    ESPNOW_rx_send_stats();
+
+    if (dwNLate > 0 || dwNQueueFull > 0)
+    {
+        ESP_LOGW("ESP-NOW", "Telemetry %d late or duplicate packets, %d dropped with the ring full",
+            (int)dwNLate, (int)dwNQueueFull);
+        dwNQueueFull = 0;
+    }
+    ESPNOW_telem_log_gaps();
+
+    dwNRx = 0;
+    dwNLost = 0;
+    dwNReordered = 0;
+    dwNLate = 0;
+    dwNPriorityLost = 0;
+    memset(astLatency, 0, sizeof(astLatency));
+}
+
+static void ESPNOW_telem_log_gaps(void)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_telem_log_gaps
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Logs the gaps in the stream since the last call, oldest first.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    stESPNOWTelemGap_t *stGap;
+
+    for (byte byNGap = byNNewGaps; byNGap > 0; byNGap--)
+    {
+        stGap = &astGaps[(byGapIndex + ESPNOW_TELEM_MAX_GAPS - byNGap) % ESPNOW_TELEM_MAX_GAPS];
+        ESP_LOGW("ESP-NOW", "Telemetry lost seq %u-%u at %d ms", stGap->wStartSeq,
+            (word)(stGap->wStartSeq + stGap->wNLost - 1), (int)stGap->dwTime);
+    }
+    byNNewGaps = 0;
+}
+
+static byte ESPNOW_telem_latency_bucket(dword dwLatency)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_telem_latency_bucket
+    *   Takes:   dwLatency - latency in us, up to LATENCY_MAX_US
+    *
+    *   Returns: Histogram bucket of the latency.
+    *
+    *   Buckets are LATENCY_SUB_BUCKETS per doubling so each is within 25 % of
+    *   the latencies in it.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    byte byMSB;
+
+    if (dwLatency < LATENCY_SUB_BUCKETS)
+    {
+        return (byte)dwLatency;
+    }
+    byMSB = (byte)(31 - __builtin_clz((unsigned int)dwLatency));
+    return (byte)((byMSB - 1) * LATENCY_SUB_BUCKETS + ((dwLatency >> (byMSB - 2)) & (LATENCY_SUB_BUCKETS - 1)));
+}
+
+static dword ESPNOW_telem_latency_percentile(const stESPNOWTelemLatency_t *stLatency, byte byPercent)
+{
+    /*
+    *===========================================================================
+    *   ESPNOW_telem_latency_percentile
+    *   Takes:   stLatency - lane's histogram
+    *            byPercent - percentile wanted
+    *
+    *   Returns: Upper end of the bucket holding the percentile in us.
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Histogram passed in
+    *
+    *===========================================================================
+    */
+    dword dwTarget = (dword)(((qword)stLatency->dwN * byPercent + 99) / 100);
+    dword dwCount = 0;
+    byte byMSB;
+
+    for (byte byBucket = 0; byBucket < LATENCY_NBUCKETS; byBucket++)
+    {
+        dwCount += stLatency->adwBuckets[byBucket];
+        if (dwCount >= dwTarget && dwCount > 0)
+        {
+            if (byBucket < LATENCY_SUB_BUCKETS)
+            {
+                return byBucket;
+            }
+            byMSB = byBucket / LATENCY_SUB_BUCKETS + 1;
+            return ((dword)(LATENCY_SUB_BUCKETS + byBucket % LATENCY_SUB_BUCKETS) << (byMSB - 2))
+                + ((dword)1 << (byMSB - 2)) - 1;
+        }
+    }
+    return 0;
+}
+
+static word ESPNOW_telem_latency_units(dword dwLatency)
+{
+    /* Latency in the units of the stats frames, rounded up */
+    return ESPNOW_telem_clamp_word((dwLatency + LATENCY_UNIT_US - 1) / LATENCY_UNIT_US);
+}
+
+static word ESPNOW_telem_clamp_word(dword dwValue)
+{
+    /* Counts in the stats frames saturate rather than wrap */
+    return dwValue > 0xFFFF ? 0xFFFF : (word)dwValue;
+}
+
+static word ESPNOW_telem_seq(const stESPNOWTelemPacket_t *stPacket)
+{
+    /* Sequence number from the packet header */
+    return ((word)stPacket->abyData[2] << 8) | stPacket->abyData[3];
+}
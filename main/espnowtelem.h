@@ -0,0 +1,77 @@
+/* Only define once */
+#ifndef SFRESPNowTelem
+#define SFRESPNowTelem
+
+#include "espnow.h"
+
+/*  ESP-NOW Telemetry
+    Packet: [ESPNOW_TELEM_PACKET, Node, Seq1, Seq0, Base3..Base0, Frames...]
+        Node is the DEVICE_ID of the sender and Seq counts its packets. Base is the low 32 bits of
+        the Rx time in us of the first frame on the sender.
+        Each frame is its header from espnow.h, the time in us since the previous frame as a
+        varint (7 bits a byte, low bits first, top bit set if another byte follows) then the data.
+    Priority packets are the same with ESPNOW_TELEM_PRIORITY_PACKET and their own Seq, they carry
+    the priority lane from espnow.h. They are passed on as soon as they arrive, never held for
+    reordering, and a missing one is only counted.
+
+    The receiver holds packets that arrive ahead of a missing one for up to
+    ESPNOW_TELEM_REORDER_TIMEOUT_US, then gives the missing ones up as lost. Packets that arrive
+    after that or twice are dropped as late.
+
+    The sender and receiver clocks are not synchronised so latency is measured above the smallest
+    Rx time minus frame time seen over the last ESPNOW_TELEM_OFFSET_WINDOW_US. It is the time
+    a frame spent queued on the car and waiting on the radio on top of the best case.
+
+    Stats are sent every ESPNOW_TELEM_STATS_PERIOD_MS as CAN frames, counts are for that period.
+        ESPNOW_TELEM_TX_STATS_ID, in the car's telemetry:
+            [Node, NTxOK1, NTxOK0, NTxFail1, NTxFail0, NQueueDropped1, NQueueDropped0, 0]
+        ESPNOW_TELEM_RX_STATS_ID, on the pit bus:
+            [Node, Loss1, Loss0, NLost1, NLost0, NRx1, NRx0, NReordered]
+            Loss is since the stream started in 0.01 %.
+        ESPNOW_TELEM_LATENCY_ID, on the pit bus:
+            [P501, P500, P951, P950, P991, P990, Max1, Max0] in 100 us
+        ESPNOW_TELEM_PRIORITY_ID, on the pit bus, the priority lane:
+            [P501, P500, P991, P990, Max1, Max0, NLost1, NLost0], latency in 100 us
+        ESPNOW_TELEM_LINK_ID, in the car's telemetry, the link adaptation in espnowlink.h:
+            [Rate, Delivered %, RSSI, Goodput1, Goodput0, NChanges, 0, 0]
+            Rate is an eESPNOWLinkRate_t, RSSI in dBm signed, Goodput at the rate in 100 B/s.
+        ESPNOW_TELEM_RX_PATH_ID, on the pit bus, the receive path in espnow.h:
+            [CallbackMean1, CallbackMean0, CallbackMax1, CallbackMax0, NRelayed1, NRelayed0,
+             NDropped1, NDropped0]
+            Time the Rx callback held the Wi-Fi task, mean in 0.1 us and max in us. Frames put on
+            the bus and dropped with the Rx frame ring full.
+*/
+
+#define ESPNOW_TELEM_PACKET             0xF2
+#define ESPNOW_TELEM_PRIORITY_PACKET    0xF3
+#define ESPNOW_TELEM_HEADER_SIZE        8
+#define ESPNOW_TELEM_MAX_DELTA_SIZE     4   // Varint bytes, deltas are under 2^28 us
+#define ESPNOW_TELEM_MAX_FRAME_SIZE     (ESPNOW_MAX_FRAME_SIZE + ESPNOW_TELEM_MAX_DELTA_SIZE)
+
+#define ESPNOW_TELEM_TX_STATS_ID        0x7E0
+#define ESPNOW_TELEM_RX_STATS_ID        0x7E1
+#define ESPNOW_TELEM_LATENCY_ID         0x7E2
+#define ESPNOW_TELEM_PRIORITY_ID        0x7E3
+#define ESPNOW_TELEM_LINK_ID            0x7E4
+#define ESPNOW_TELEM_RX_PATH_ID         0x7E5
+
+#define ESPNOW_TELEM_STATS_PERIOD_MS    1000
+#define ESPNOW_TELEM_REORDER_DEPTH      8       // Packets held waiting for a missing one
+#define ESPNOW_TELEM_REORDER_TIMEOUT_US 20000
+#define ESPNOW_TELEM_OFFSET_WINDOW_US   10000000
+#define ESPNOW_TELEM_MAX_GAPS           8       // Most recent gaps kept for the log
+
+typedef enum {
+    eTELEM_LANE_BULK,
+    eTELEM_LANE_PRIORITY,
+    eTELEM_LANE_TOTAL
+} eESPNOWTelemLane_t;
+
+esp_err_t ESPNOW_telem_init(void);
+void ESPNOW_telem_rx(const byte *abyData, int NLength);
+void ESPNOW_telem_tx_done(boolean bSuccess);
+word ESPNOW_telem_next_seq(eESPNOWTelemLane_t eLane);
+void ESPNOW_telem_frame_latency(eESPNOWTelemLane_t eLane, dword dwFrameTime, qword qwtRx);
+esp_err_t ESPNOW_telem_service(void);
+
+#endif // SFRESPNowTelem
@@ -0,0 +1,385 @@
+/*
+imd.c
+File contains the IMD's PWM capture and the decoding of its states, see imd.h.
+
+Written by Cole Perera for Sheffield Formula Racing 2026
+*/
+
+#include "imd.h"
+
+/* --------------------------- Local Types ---------------------------- */
+
+
+/* --------------------------- Local Variables ------------------------ */
+static mcpwm_cap_timer_handle_t stIMDTimer = NULL;
+static mcpwm_cap_channel_handle_t stIMDChannel = NULL;
+static gpio_num_t eIMDPin;
+static dword dwIMDResolutionHz = 0;         // Capture counts a second
+static dword adwIMDEdgeCounts[IMD_MAX_EDGES];
+static boolean abIMDEdgeRising[IMD_MAX_EDGES];
+static dword dwIMDNEdges = 0;               // Since the ring was last emptied, the next goes at & (IMD_MAX_EDGES - 1)
+static qword qwtIMDLastEdge = 0;
+static eIMDState_t eIMDState = eIMD_OFF;
+static stIMDStats_t stIMDStats;
+static qword qwtIMDReport = 0;
+static portMUX_TYPE stIMDLock = portMUX_INITIALIZER_UNLOCKED;
+
+static const char *IMD_STATE_NAMES[] = {
+    "Off",
+    "Normal",
+    "Undervoltage",
+    "Speed start",
+    "Device error",
+    "Ground fault",
+    "Shorted to supply",
+    "Invalid",
+};
+
+/* --------------------------- Global Variables ----------------------- */
+
+
+/* --------------------------- Definitions ---------------------------- */
+#define IMD_STATE_HZ        10.0f       // Normal, then every state 10 Hz on
+
+/* --------------------------- Function prototypes -------------------- */
+static bool IMD_capture(mcpwm_cap_channel_handle_t stChannel, const mcpwm_capture_event_data_t *pstEvent, void *pvArg);
+static eIMDState_t IMD_decode(float fHz, float rDuty);
+
+
+/* --------------------------- Functions ------------------------------ */
+esp_err_t IMD_init(gpio_num_t eNPin)
+{
+    /*
+    *===========================================================================
+    *   IMD_init
+    *   Takes:   eNPin: GPIO the IMD's OKHS output is on, IMD_PWM_IN
+    *
+    *   Returns: ESP_OK if successful, error code if not.
+    *
+    *   Sets up an MCPWM capture timer and a channel on eNPin for both
+    *   edges, pulled down so an unplugged IMD reads as off, and starts it.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    esp_err_t eStatus;
+    mcpwm_capture_timer_config_t stTimerConfig = {
+        .group_id = 0,
+        .clk_src = MCPWM_CAPTURE_CLK_SRC_DEFAULT,
+    };
+    mcpwm_capture_channel_config_t stChannelConfig = {
+        .gpio_num = eNPin,
+        .prescale = 1,
+        .flags.pos_edge = TRUE,
+        .flags.neg_edge = TRUE,
+        .flags.pull_down = TRUE,
+    };
+    mcpwm_capture_event_callbacks_t stCallbacks = {
+        .on_cap = IMD_capture,
+    };
+    uint32_t dwResolutionHz;
+
+    eStatus = mcpwm_new_capture_timer(&stTimerConfig, &stIMDTimer);
+    if (eStatus == ESP_OK)
+    {
+        eStatus = mcpwm_new_capture_channel(stIMDTimer, &stChannelConfig, &stIMDChannel);
+    }
+    if (eStatus == ESP_OK)
+    {
+        eStatus = mcpwm_capture_channel_register_event_callbacks(stIMDChannel, &stCallbacks, NULL);
+    }
+    if (eStatus == ESP_OK)
+    {
+        eStatus = mcpwm_capture_channel_enable(stIMDChannel);
+    }
+    if (eStatus == ESP_OK)
+    {
+        eStatus = mcpwm_capture_timer_get_resolution(stIMDTimer, &dwResolutionHz);
+    }
+    if (eStatus != ESP_OK)
+    {
+        ESP_LOGE("IMD", "Failed to set up PWM capture: %s", esp_err_to_name(eStatus));
+        return eStatus;
+    }
+    eIMDPin = eNPin;
+    dwIMDResolutionHz = dwResolutionHz;
+    qwtIMDLastEdge = esp_timer_get_time();
+    qwtIMDReport = qwtIMDLastEdge;
+    eStatus = mcpwm_capture_timer_enable(stIMDTimer);
+    if (eStatus == ESP_OK)
+    {
+        eStatus = mcpwm_capture_timer_start(stIMDTimer);
+    }
+    if (eStatus != ESP_OK)
+    {
+        ESP_LOGE("IMD", "Failed to start PWM capture: %s", esp_err_to_name(eStatus));
+        dwIMDResolutionHz = 0;
+    }
+    return eStatus;
+}
+
+eIMDState_t IMD_update(void)
+{
+    /*
+    *===========================================================================
+    *   IMD_update
+    *   Takes:   None
+    *
+    *   Returns: The IMD's state, eIMD_OFF before IMD_init.
+    *
+    *   Takes the frequency and duty from the captured edges and sets
+    *   IMDData's signals from them, as imd.h sets out. BIMDSSTGood is the
+    *   last speed start measurement's result and RIsolation only changes in
+    *   the states that give it, and is 0 in the fault states.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    dword adwCounts[IMD_MAX_EDGES];
+    boolean abRising[IMD_MAX_EDGES];
+    byte abyRises[IMD_WINDOW_PERIODS + 1];  // Newest first
+    byte byNRises = 0;
+    byte byNEdges;
+    byte byN;
+    byte byNFalls;
+    byte byFall = 0;
+    byte byEdge;
+    dword dwNEdges;
+    dword dwPeriod;
+    dword dwSumPeriod = 0;
+    dword dwSumHigh = 0;
+    float fHz = 0.0f;
+    float rDuty = 0.0f;
+    float fPeriodHz;
+    float fStateHz = 0.0f;
+    boolean BMissing = FALSE;
+    eIMDState_t eState;
+    qword qwtNow = esp_timer_get_time();
+    qword qwtLastEdge;
+
+    if (dwIMDResolutionHz == 0)
+    {
+        return eIMD_OFF;
+    }
+
+    /* The ring oldest first, or empty it if the pin has gone quiet */
+    portENTER_CRITICAL(&stIMDLock);
+    qwtLastEdge = qwtIMDLastEdge;
+    dwNEdges = dwIMDNEdges;
+    if (qwtNow - qwtLastEdge > IMD_TIMEOUT_US)
+    {
+        dwIMDNEdges = 0;
+        dwNEdges = 0;
+    }
+    byNEdges = (byte)(dwNEdges < IMD_MAX_EDGES ? dwNEdges : IMD_MAX_EDGES);
+    for (byN = 0; byN < byNEdges; byN++)
+    {
+        adwCounts[byN] = adwIMDEdgeCounts[(dwNEdges - byNEdges + byN) & (IMD_MAX_EDGES - 1)];
+        abRising[byN] = abIMDEdgeRising[(dwNEdges - byNEdges + byN) & (IMD_MAX_EDGES - 1)];
+    }
+    portEXIT_CRITICAL(&stIMDLock);
+
+    if (qwtNow - qwtLastEdge > IMD_TIMEOUT_US)
+    {
+        /* 0 Hz, the level says off or shorted to supply */
+        eState = gpio_get_level(eIMDPin) ? eIMD_SHORT_SUPPLY : eIMD_OFF;
+        rDuty = eState == eIMD_SHORT_SUPPLY ? 100.0f : 0.0f;
+    }
+    else
+    {
+        /* Rising edges from the newest back, each period needs one falling edge in it */
+        for (byN = byNEdges; byN > 0 && byNRises <= IMD_WINDOW_PERIODS; byN--)
+        {
+            if (abRising[byN - 1])
+            {
+                abyRises[byNRises++] = byN - 1;
+            }
+        }
+        eState = byNRises < 2 ? eIMDState : eIMD_INVALID;
+        for (byN = 1; byN < byNRises; byN++)
+        {
+            byNFalls = 0;
+            for (byEdge = abyRises[byN] + 1; byEdge < abyRises[byN - 1]; byEdge++)
+            {
+                byNFalls++;
+                byFall = byEdge;
+            }
+            /* Only the newest period missing an edge spoils the window, older ones end it */
+            if (byNFalls != 1)
+            {
+                BMissing = byN == 1;
+                break;
+            }
+            /* Stop at a period of another state, the newest sets it. The count is 32 bits and wraps */
+            dwPeriod = (uint32_t)(adwCounts[abyRises[byN - 1]] - adwCounts[abyRises[byN]]);
+            fPeriodHz = (float)dwIMDResolutionHz / dwPeriod;
+            if (byN == 1)
+            {
+                fStateHz = IMD_STATE_HZ * roundf(fPeriodHz / IMD_STATE_HZ);
+            }
+            else if (fabsf(fPeriodHz - fStateHz) > IMD_FREQ_TOLERANCE * fStateHz)
+            {
+                break;
+            }
+            dwSumPeriod += dwPeriod;
+            dwSumHigh += (uint32_t)(adwCounts[byFall] - adwCounts[abyRises[byN]]);
+        }
+        if (!BMissing && dwSumPeriod != 0)
+        {
+            fHz = (float)dwIMDResolutionHz * (byN - 1) / dwSumPeriod;
+            rDuty = 100.0f * dwSumHigh / dwSumPeriod;
+            eState = IMD_decode(fHz, rDuty);
+        }
+    }
+
+    /* IMDData */
+    BIMDOff = eState == eIMD_OFF;
+    BIMDUnderVoltage = eState == eIMD_UNDERVOLTAGE;
+    BIMDStarting = eState == eIMD_SPEED_START;
+    BIMDDeviceError = eState == eIMD_DEVICE_ERROR;
+    BIMDGroundConnectionFault = eState == eIMD_GROUND_FAULT;
+    BIMDInvalidState = eState == eIMD_INVALID || eState == eIMD_SHORT_SUPPLY;
+    if (eState == eIMD_SPEED_START)
+    {
+        BIMDSSTGood = rDuty < 50.0f;
+    }
+    if (eState == eIMD_NORMAL || eState == eIMD_UNDERVOLTAGE)
+    {
+        RIsolation = rDuty <= 5.0f ? IMD_R_MAX_OHMS : 90.0f * IMD_R_SERIES_OHMS / (rDuty - 5.0f) - IMD_R_SERIES_OHMS;
+        RIsolation = RIsolation < 0.0f ? 0.0f : RIsolation > IMD_R_MAX_OHMS ? IMD_R_MAX_OHMS : RIsolation;
+    }
+    else if (eState != eIMD_SPEED_START)
+    {
+        RIsolation = 0.0f;
+    }
+    fIMDPWM = fHz;
+    rIMDPWM = rDuty;
+
+    portENTER_CRITICAL(&stIMDLock);
+    stIMDStats.dwNUpdates++;
+    stIMDStats.dwNInvalid += eState == eIMD_INVALID ? 1 : 0;
+    stIMDStats.dwNMissing += BMissing ? 1 : 0;
+    stIMDStats.dwNTimeouts += qwtNow - qwtLastEdge > IMD_TIMEOUT_US ? 1 : 0;
+    stIMDStats.dwNStateChanges += eState != eIMDState ? 1 : 0;
+    portEXIT_CRITICAL(&stIMDLock);
+    if (eState != eIMDState)
+    {
+        ESP_LOGI("IMD", "%s, %.1f Hz %.1f %%", IMD_STATE_NAMES[eState], fHz, rDuty);
+    }
+    eIMDState = eState;
+    return eState;
+}
+
+void IMD_get_stats(stIMDStats_t *pstStats)
+{
+    /*
+    *===========================================================================
+    *   IMD_get_stats
+    *   Takes:   pstStats: Filled with the counts since IMD_init
+    *
+    *   Returns: None
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    portENTER_CRITICAL(&stIMDLock);
+    *pstStats = stIMDStats;
+    portEXIT_CRITICAL(&stIMDLock);
+}
+
+void IMD_report(void)
+{
+    /*
+    *===========================================================================
+    *   IMD_report
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Logs the edges a second captured since the last call, invalid windows,
+    *   those with an edge missing, timeouts, state changes and the state.
+    *   Nothing before IMD_init.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    static stIMDStats_t stLast;
+    stIMDStats_t stStats;
+    qword qwtNow = esp_timer_get_time();
+    dword dwElapsedms = (dword)((qwtNow - qwtIMDReport) / 1000);
+
+    if (dwIMDResolutionHz == 0 || dwElapsedms == 0)
+    {
+        return;
+    }
+    IMD_get_stats(&stStats);
+    ESP_LOGI("IMD", "%lu edges/s, %lu invalid, %lu missing edges, %lu timeouts, %lu changes, %s %.1f Hz %.1f %% %.0f kOhm",
+        (dword)((qword)(stStats.dwNEdges - stLast.dwNEdges) * 1000 / dwElapsedms),
+        stStats.dwNInvalid - stLast.dwNInvalid, stStats.dwNMissing - stLast.dwNMissing,
+        stStats.dwNTimeouts - stLast.dwNTimeouts, stStats.dwNStateChanges - stLast.dwNStateChanges,
+        IMD_STATE_NAMES[eIMDState], fIMDPWM, rIMDPWM, RIsolation / 1000.0f);
+    stLast = stStats;
+    qwtIMDReport = qwtNow;
+}
+
+/* --------------------------- Local Functions ------------------------ */
+static bool IRAM_ATTR IMD_capture(mcpwm_cap_channel_handle_t stChannel, const mcpwm_capture_event_data_t *pstEvent, void *pvArg)
+{
+    /* Both edges, the hardware's count for each into the ring */
+    (void)stChannel;
+    (void)pvArg;
+    portENTER_CRITICAL_ISR(&stIMDLock);
+    adwIMDEdgeCounts[dwIMDNEdges & (IMD_MAX_EDGES - 1)] = pstEvent->cap_value;
+    abIMDEdgeRising[dwIMDNEdges & (IMD_MAX_EDGES - 1)] = pstEvent->cap_edge == MCPWM_CAP_EDGE_POS;
+    dwIMDNEdges++;
+    qwtIMDLastEdge = esp_timer_get_time();
+    stIMDStats.dwNEdges++;
+    portEXIT_CRITICAL_ISR(&stIMDLock);
+    return false;
+}
+
+static eIMDState_t IMD_decode(float fHz, float rDuty)
+{
+    /* The state for a window's frequency, if its duty is in that state's range */
+    float fState = roundf(fHz / IMD_STATE_HZ);
+
+    if (fState < 1.0f || fState > 5.0f || fabsf(fHz - fState * IMD_STATE_HZ) > IMD_FREQ_TOLERANCE * fState * IMD_STATE_HZ)
+    {
+        return eIMD_INVALID;
+    }
+    switch ((int)fState)
+    {
+        case 1:
+        case 2:
+            if (rDuty < 5.0f - IMD_DUTY_SLACK || rDuty > 95.0f + IMD_DUTY_SLACK)
+            {
+                return eIMD_INVALID;
+            }
+            return fState == 1.0f ? eIMD_NORMAL : eIMD_UNDERVOLTAGE;
+        case 3:
+            if ((rDuty < 5.0f - IMD_DUTY_SLACK || rDuty > 10.0f + IMD_DUTY_SLACK) &&
+                (rDuty < 90.0f - IMD_DUTY_SLACK || rDuty > 95.0f + IMD_DUTY_SLACK))
+            {
+                return eIMD_INVALID;
+            }
+            return eIMD_SPEED_START;
+        default:
+            if (rDuty < 47.5f - IMD_DUTY_SLACK || rDuty > 52.5f + IMD_DUTY_SLACK)
+            {
+                return eIMD_INVALID;
+            }
+            return fState == 4.0f ? eIMD_DEVICE_ERROR : eIMD_GROUND_FAULT;
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef IMD_H
+#define IMD_H
+
+#include "sfrtypes.h"
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "driver/gpio.h"
+#include "driver/mcpwm_cap.h"
+#include <math.h>
+
+#include "pin.h"
+#include "CAN/canDecodeAuto.h"
+
+/*  IMD PWM capture
+    The Bender IR155's OKHS output is a PWM, its frequency the IMD's state and its duty a reading:
+        10 Hz   Normal, duty 5 to 95 % is the insulation resistance
+        20 Hz   Undervoltage, the HV is below the IMD's threshold, resistance as normal
+        30 Hz   Speed start measurement, duty 5 to 10 % good, 90 to 95 % bad
+        40 Hz   Device error, duty 47.5 to 52.5 %
+        50 Hz   Ground connection fault, duty 47.5 to 52.5 %
+        0 Hz    Low, the IMD is off or shorted to ground. High, shorted to supply.
+    Both edges are timestamped by an MCPWM capture channel in hardware. Its interrupt only puts
+    the count and edge in a ring of IMD_MAX_EDGES, 100 a second at 50 Hz, and nothing polls the
+    pin, the ring is overwritten as it goes. IMD_update, from the 100 ms task, takes the frequency
+    and duty over up to the last IMD_WINDOW_PERIODS whole periods in it, rising edge to rising
+    edge, stopping at a period of another state so a change shows after one period. They are
+    decoded into the BIMD flags, fIMDPWM, rIMDPWM and RIsolation. No edge for IMD_TIMEOUT_US is
+    0 Hz, the pin's level says which, and empties the ring. A window that matches no state, or
+    has an edge missing, is BIMDInvalidState.
+*/
+#define IMD_ID                  0x13        // DEVICE_ID, MCUSTATUSIMDMONITOR_ID
+#define IMD_MAX_EDGES           32          // Power of 2
+#define IMD_WINDOW_PERIODS      3
+#define IMD_TIMEOUT_US          250000      // 2.5 periods at 10 Hz
+#define IMD_FREQ_TOLERANCE      0.1f        // Of the state's frequency, either way
+#define IMD_DUTY_SLACK          1.0f        // % past each state's duty range still accepted
+#define IMD_R_SERIES_OHMS       1200000.0f  // R = 90 % * 1200k / (duty - 5 %) - 1200k
+#define IMD_R_MAX_OHMS          13000000.0f // IMDData's RIsolation tops out at 13.1M
+
+typedef enum {
+    eIMD_OFF = 0,
+    eIMD_NORMAL,
+    eIMD_UNDERVOLTAGE,
+    eIMD_SPEED_START,
+    eIMD_DEVICE_ERROR,
+    eIMD_GROUND_FAULT,
+    eIMD_SHORT_SUPPLY,
+    eIMD_INVALID,
+} eIMDState_t;
+
+typedef struct {
+    dword dwNEdges;
+    dword dwNUpdates;
+    dword dwNInvalid;           // Updates whose window matched no state
+    dword dwNMissing;           // Of those, a period without exactly one falling edge
+    dword dwNTimeouts;          // Updates with no edge for IMD_TIMEOUT_US
+    dword dwNStateChanges;
+} stIMDStats_t;
+
+/* --------------------------- Function prototypes --------------------- */
+esp_err_t IMD_init(gpio_num_t eNPin);
+eIMDState_t IMD_update(void);
+void IMD_get_stats(stIMDStats_t *pstStats);
+void IMD_report(void);
+
+#endif // IMD_H
@@ -111,6 +111,18 @@ static void main_init(void)
     // {
     //     ESP_LOGE(SFR_TAG, "Failed to initialise ESP-NOW: %s", esp_err_to_name(eStatus));
     // }
+    // eStatus = ESPNOW_flash_init();
+    // if (eStatus != ESP_OK)
+    // {
+    //     ESP_LOGE(SFR_TAG, "Failed to initialise ESP-NOW Reflash: %s", esp_err_to_name(eStatus));
+    // }
+
+    /* External Clock, before the SD card so log files get the time */
+    // eStatus = I2C_init();
+    // if (eStatus != ESP_OK)
+    // {
+    //     ESP_LOGE(SFR_TAG, "Failed to initialise I2C: %s", esp_err_to_name(eStatus));
+    // }
 
     /* SD Card (SDCard and LCD share the SPI bus, take care) */
     /* SPI Devices */
@@ -124,13 +136,6 @@ static void main_init(void)
     // };
     // eStatus = spi_bus_initialize(SPI2_HOST, &stBusConfig, SPI_DMA_CH_AUTO);
 
-    /* SD Card */
-    // eStatus = SD_card_init();
-    // if (eStatus != ESP_OK)
-    // {
-    //     ESP_LOGE(SFR_TAG, "Failed to initialise SD Card: %s", esp_err_to_name(eStatus));
-    // }
-
     /* ADC MCP3204/8 This is a example config is required */
     // uint8_t aNCSPins[2] = {SPI_MCP3204_1_CS, SPI_MCP3204_2_CS};
     // eStatus = MCP320X_init(aNCSPins, MCP320XDevs);
@@ -138,6 +143,14 @@ static void main_init(void)
     // {
     //     ESP_LOGE(SFR_TAG, "Failed to initialise MCP320X: %s", esp_err_to_name(eStatus));
     // }
+    /* Then scan them, the Dyno's 2 MCP3204s here, the temperature monitor builds its map too */
+    // byte abyNMCP320XChannels[2] = {4, 4};
+    // eStatus = MCP320X_scan_init(2, MCP320XDevs, abyNMCP320XChannels, MCP320X_SCAN_HZ);
+    // if (eStatus != ESP_OK)
+    // {
+    //     ESP_LOGE(SFR_TAG, "Failed to start MCP320X scan: %s", esp_err_to_name(eStatus));
+    // }
+    // (void)MCP320X_thermistor_map(&stThermistorMap);
     /* END of SPI Devices*/
     
     /* CAN BUS */
@@ -152,14 +165,53 @@ static void main_init(void)
         ESP_LOGE(SFR_TAG, "Failed to initialise CAN Reflash: %s", esp_err_to_name(eStatus));
     }
 
-    /* External Clock */
-    // eStatus = I2C_init();
+    /* Calibration tables from NVS, before anything converts with them, updated over CAN from here */
+    // eStatus = CAL_init();
     // if (eStatus != ESP_OK)
     // {
-    //     ESP_LOGE(SFR_TAG, "Failed to initialise I2C: %s", esp_err_to_name(eStatus));
+    //     ESP_LOGE(SFR_TAG, "Failed to load calibration tables: %s", esp_err_to_name(eStatus));
     // }
 
-    /* ADC */
+    /* SD Card, after CAN so frames are logged from the first one, the card mounts in the background */
+    // eStatus = SD_card_init();
+    // if (eStatus != ESP_OK)
+    // {
+    //     ESP_LOGE(SFR_TAG, "Failed to initialise SD Card: %s", esp_err_to_name(eStatus));
+    // }
+
+    /* SD capture ring, sized from the heap the inits above have left */
+    // eStatus = SD_capture_init();
+    // if (eStatus != ESP_OK)
+    // {
+    //     ESP_LOGE(SFR_TAG, "Failed to initialise SD capture: %s", esp_err_to_name(eStatus));
+    // }
+
+    /* ADC, APPS sampled continuously so the 1ms task never waits on a conversion */
+    // eStatus = adc_continuous_add(&stADCHandle0, ADC_ATTEN_DB_12, 3, eADC_FILTER_MEDIAN, 0);
+    // if (eStatus == ESP_OK)
+    // {
+    //     eStatus = adc_continuous_add(&stADCHandle1, ADC_ATTEN_DB_12, 3, eADC_FILTER_MEDIAN, 0);
+    // }
+    // if (eStatus == ESP_OK)
+    // {
+    //     eStatus = adc_continuous_init(ADC_SAMPLE_HZ);
+    // }
+    // if (eStatus != ESP_OK)
+    // {
+    //     ESP_LOGE(SFR_TAG, "Failed to initialise ADC: %s", esp_err_to_name(eStatus));
+    // }
+    /* IMD monitor, its PWM timed by MCPWM capture, decoded by task_100ms */
+    // eStatus = IMD_init(IMD_PWM_IN);
+    // if (eStatus != ESP_OK)
+    // {
+    //     ESP_LOGE(SFR_TAG, "Failed to initialise IMD capture: %s", esp_err_to_name(eStatus));
+    // }
+    /* APPS checks, on the APPS node after its ADC, run by task_1ms */
+    // eStatus = APPS_init();
+    // if (eStatus != ESP_OK)
+    // {
+    //     ESP_LOGE(SFR_TAG, "Failed to initialise APPS: %s", esp_err_to_name(eStatus));
+    // }
     
     /* Timers and GPIO cause a hard fault on fail so no error warning */
     GPIO_init();
@@ -13,15 +13,31 @@ spi_device_handle_t stMCP3204_2;
 spi_device_handle_t stMCP3208;
 
 /* --------------------------- Local Variables ------------------------ */
-
+static spi_device_handle_t astScanDevices[MCP320X_MAX_DEVICES];
+static byte abyScanNChannels[MCP320X_MAX_DEVICES];
+static word wNScanDevices = 0;
+static spi_transaction_t aastScanCalls[MCP320X_MAX_DEVICES][MCP320X_MAX_CHANNELS];
+static word aawScanCounts[MCP320X_MAX_DEVICES][MCP320X_MAX_CHANNELS];
+static stMCP320XStats_t stScanStats;
+static portMUX_TYPE stScanLock = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t xScanTask = NULL;
+static esp_timer_handle_t stScanTimer = NULL;
+static qword qwtScanReport = 0;
 
 /* --------------------------- Global Variables ----------------------- */
-
+stSensorMap_t stThermistorMap;      // Temperature monitor, from MCP320X_thermistor_map
 
 /* --------------------------- Definitions ---------------------------- */
 #define MCP3208_SPI_FREQ 1000000 // 1 MHz
 #define VADC_REFERNCE 5.0
 
+/* --------------------------- Function prototypes -------------------- */
+static void MCP320X_command(uint8_t NDevADC, uint8_t *NDataTx);
+static word MCP320X_counts(const uint8_t *NDataRx);
+static int MCP320X_find(spi_device_handle_t stDeviceHandle);
+static void MCP320X_scan_tick(void *pvArg);
+static void MCP320X_scan_task(void *pvArg);
+static dword MCP320X_scan(void);
 
 
 /* --------------------------- Functions ------------------------------ */
@@ -75,10 +91,12 @@ float MCP320X_read(spi_device_handle_t stDeviceHandle, uint8_t NDevADC)
     * 
     *   Returns: ADC voltage after convertsion from counts.
     * 
-    *   Sends a command to the MCP3208 and reads back the ADC data.
+    *   Sends a command to the MCP3208 and reads back the ADC data. A device
+    *   being scanned gives its latest count instead, without the bus.
     *===========================================================================
     *   Revision History:
     *   02/03/26 CP Initial Version
+    *   18/10/26 CP Scanned devices read from the scan
     *
     *===========================================================================
     */
@@ -88,31 +106,541 @@ float MCP320X_read(spi_device_handle_t stDeviceHandle, uint8_t NDevADC)
     uint8_t NDataTx[3];
     uint8_t NDataRx[3];
     float fVADCRaw; 
+    int NDevice;
     if (NDevADC > 7)
     {
-        return 999.9;
+        return MCP320X_READ_ERROR;
     }
 
-    // Alignment Logic for 24 clocks (3 bytes):
-    // Byte 0: 0 0 0 0 0 S M D2
-    // Byte 1: D1 D0 N N B11 B10 B9 B8
-    // Byte 2: B7 B6 B5 B4 B3 B2 B1 B0
-    // Where S is start bit (1), M is mode (0 for single-ended, 1 for differential), D2-D0 are the channel selection bits, 
-    // N is null bit, and B11-B0 are the 12-bit ADC result.
+    NDevice = MCP320X_find(stDeviceHandle);
+    if (NDevice >= 0)
+    {
+        if (NDevADC >= abyScanNChannels[NDevice])
+        {
+            return MCP320X_READ_ERROR;
+        }
+        return (float)MCP320X_get_count((byte)NDevice, NDevADC) / 4096.0f * (float)VADC_REFERNCE;
+    }
 
     memset(&stSPICall, 0, sizeof(stSPICall));
-    NDataTx[0] = 0x6 | ((NDevADC & 0x4) >> 2);
-    NDataTx[1] = (NDevADC & 0x3) << 6;
-    NDataTx[2] = 0x00;
+    MCP320X_command(NDevADC, NDataTx);
     stSPICall.length = 24;
     stSPICall.tx_buffer = NDataTx;
     stSPICall.rx_buffer = NDataRx;
     eStatus = spi_device_transmit(stDeviceHandle, &stSPICall);
     if (eStatus != ESP_OK)    {
-        return 999.9;
+        return MCP320X_READ_ERROR;
     }
-    wNData = ((NDataRx[1] & 0xF) << 8) | NDataRx[2];
+    wNData = MCP320X_counts(NDataRx);
     fVADCRaw = (float)wNData / 4096.0 * (float)VADC_REFERNCE;
     return fVADCRaw;
 
-}
\ No newline at end of file
+}
+
+esp_err_t MCP320X_scan_init(word wNDevices, spi_device_handle_t astDeviceHandles[], const byte abyNChannels[],
+                            word wScanHz)
+{
+    /*
+    *===========================================================================
+    *   MCP320X_scan_init
+    *   Takes:   wNDevices: Devices to scan, up to MCP320X_MAX_DEVICES
+    *            astDeviceHandles: Their handles from MCP320X_init
+    *            abyNChannels: Channels to read on each, from 0, up to 4 for
+    *            an MCP3204 and 8 for an MCP3208
+    *            wScanHz: Scans a second, MCP320X_SCAN_HZ unless there is a
+    *            reason, see MCP320X_report for what the bus manages
+    *
+    *   Returns: ESP_OK if scanning has started, ESP_ERR_INVALID_STATE if it
+    *            already had, ESP_ERR_INVALID_ARG for a bad count or rate,
+    *            ESP_ERR_NO_MEM if the task could not start, or the timer's
+    *            error.
+    *
+    *   Starts the scan task and the timer that wakes it, see Scanning in
+    *   mcp320X.h. Counts are 0 until the first scan.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    esp_err_t eStatus;
+    word wDevice;
+    byte byChannel;
+    spi_transaction_t *pstCall;
+    const esp_timer_create_args_t stScanTimerArgs = {
+        .callback = &MCP320X_scan_tick,
+        .arg = NULL,
+        .name = "MCP320X"
+    };
+
+    if (xScanTask != NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (wNDevices == 0 || wNDevices > MCP320X_MAX_DEVICES || wScanHz == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (wDevice = 0; wDevice < wNDevices; wDevice++)
+    {
+        if (abyNChannels[wDevice] == 0 || abyNChannels[wDevice] > MCP320X_MAX_CHANNELS)
+        {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    /* Every call is built once, each scan only sends them again */
+    memset(aastScanCalls, 0, sizeof(aastScanCalls));
+    memset(aawScanCounts, 0, sizeof(aawScanCounts));
+    memset(&stScanStats, 0, sizeof(stScanStats));
+    for (wDevice = 0; wDevice < wNDevices; wDevice++)
+    {
+        astScanDevices[wDevice] = astDeviceHandles[wDevice];
+        abyScanNChannels[wDevice] = abyNChannels[wDevice];
+        for (byChannel = 0; byChannel < abyNChannels[wDevice]; byChannel++)
+        {
+            pstCall = &aastScanCalls[wDevice][byChannel];
+            pstCall->flags = SPI_TRANS_USE_TXDATA | SPI_TRANS_USE_RXDATA;
+            pstCall->length = 24;
+            MCP320X_command(byChannel, pstCall->tx_data);
+        }
+    }
+    wNScanDevices = wNDevices;
+
+    if (xTaskCreate(MCP320X_scan_task, "MCP320X", MCP320X_SCAN_TASK_STACK, NULL, MCP320X_SCAN_TASK_PRIORITY,
+                    &xScanTask) != pdPASS)
+    {
+        ESP_LOGE(SFR_TAG, "Failed to start MCP320X scan task");
+        xScanTask = NULL;
+        wNScanDevices = 0;
+        return ESP_ERR_NO_MEM;
+    }
+    qwtScanReport = esp_timer_get_time();
+    eStatus = esp_timer_create(&stScanTimerArgs, &stScanTimer);
+    if (eStatus == ESP_OK)
+    {
+        eStatus = esp_timer_start_periodic(stScanTimer, 1000000 / wScanHz);
+    }
+    if (eStatus != ESP_OK)
+    {
+        ESP_LOGE(SFR_TAG, "Failed to start MCP320X scan timer: %s", esp_err_to_name(eStatus));
+    }
+    return eStatus;
+}
+
+word MCP320X_get_count(byte byDevice, byte byChannel)
+{
+    /*
+    *===========================================================================
+    *   MCP320X_get_count
+    *   Takes:   byDevice: Index into the handles given to MCP320X_scan_init
+    *            byChannel: Channel on it
+    *
+    *   Returns: Its latest 12 bit count, 0 if it is not scanned.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    if (byDevice >= wNScanDevices || byChannel >= abyScanNChannels[byDevice])
+    {
+        return 0;
+    }
+    return aawScanCounts[byDevice][byChannel];
+}
+
+void MCP320X_get_counts(byte byDevice, word *awCounts)
+{
+    /*
+    *===========================================================================
+    *   MCP320X_get_counts
+    *   Takes:   byDevice: Index into the handles given to MCP320X_scan_init
+    *            awCounts: Filled with every scanned channel's count, all
+    *            from the same scan
+    *
+    *   Returns: None
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    if (byDevice >= wNScanDevices)
+    {
+        return;
+    }
+    portENTER_CRITICAL(&stScanLock);
+    memcpy(awCounts, aawScanCounts[byDevice], abyScanNChannels[byDevice] * sizeof(word));
+    portEXIT_CRITICAL(&stScanLock);
+}
+
+void MCP320X_get_stats(stMCP320XStats_t *pstStats)
+{
+    /*
+    *===========================================================================
+    *   MCP320X_get_stats
+    *   Takes:   pstStats: Filled with the counts since MCP320X_scan_init
+    *
+    *   Returns: None
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    portENTER_CRITICAL(&stScanLock);
+    *pstStats = stScanStats;
+    portEXIT_CRITICAL(&stScanLock);
+}
+
+void MCP320X_report(void)
+{
+    /*
+    *===========================================================================
+    *   MCP320X_report
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Logs the scans and samples a second achieved since the last call,
+    *   overruns, errors and the time a scan takes. Nothing if not scanning.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    static stMCP320XStats_t stLast;
+    stMCP320XStats_t stStats;
+    qword qwtNow = esp_timer_get_time();
+    dword dwElapsedms = (dword)((qwtNow - qwtScanReport) / 1000);
+    dword dwNScans;
+
+    if (xScanTask == NULL || dwElapsedms == 0)
+    {
+        return;
+    }
+    MCP320X_get_stats(&stStats);
+    dwNScans = stStats.dwNScans - stLast.dwNScans;
+    ESP_LOGI("MCP320X", "%lu scans/s, %lu samples/s, %lu overruns, %lu errors, scan %lu us, max %lu us",
+        (dword)((qword)dwNScans * 1000 / dwElapsedms),
+        (dword)((qword)(stStats.dwNSamples - stLast.dwNSamples) * 1000 / dwElapsedms),
+        stStats.dwNOverruns - stLast.dwNOverruns, stStats.dwNErrors - stLast.dwNErrors,
+        dwNScans == 0 ? 0 : (dword)((stStats.qwNScanus - stLast.qwNScanus) / dwNScans), stStats.dwScanMaxus);
+    stLast = stStats;
+    qwtScanReport = qwtNow;
+}
+
+esp_err_t MCP320X_update_dyno(void)
+{
+    /*
+    *===========================================================================
+    *   MCP320X_update_dyno
+    *   Takes:   None
+    *
+    *   Returns: ESP_OK, or ESP_ERR_INVALID_STATE if the Dyno's two devices
+    *            are not being scanned.
+    *
+    *   Sets the DynoPressuresRaw and DynoTempsRaw signals from the latest
+    *   scan, in volts, and DynoPressures and DynoTemps from those through
+    *   their calibration tables, SENSOR_INVALID for a slot with none, ready
+    *   for their Tx functions.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Calibrated signals from the NVS calibration tables
+    *
+    *===========================================================================
+    */
+    word awPressures[MCP320X_MAX_CHANNELS];
+    word awTemps[MCP320X_MAX_CHANNELS];
+    byte byChannel;
+
+    if (wNScanDevices <= MCP320X_DYNO_TEMP_DEVICE || wNScanDevices <= MCP320X_DYNO_PRESSURE_DEVICE ||
+        abyScanNChannels[MCP320X_DYNO_PRESSURE_DEVICE] <= MCP320X_DYNO_FLOW_CHANNEL ||
+        abyScanNChannels[MCP320X_DYNO_TEMP_DEVICE] < 3)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    MCP320X_get_counts(MCP320X_DYNO_PRESSURE_DEVICE, awPressures);
+    MCP320X_get_counts(MCP320X_DYNO_TEMP_DEVICE, awTemps);
+    for (byChannel = 0; byChannel < 3; byChannel++)
+    {
+        VDynoPressureRaw[byChannel] = (float)awPressures[byChannel] * (float)VADC_REFERNCE / 4096.0f;
+        VDynoTempRaw[byChannel] = (float)awTemps[byChannel] * (float)VADC_REFERNCE / 4096.0f;
+        pDynoPressure[byChannel] = CAL_convert((byte)(CAL_DYNO_PRESSURE + byChannel), VDynoPressureRaw[byChannel]);
+        TDynoTemp[byChannel] = CAL_convert((byte)(CAL_DYNO_TEMP + byChannel), VDynoTempRaw[byChannel]);
+    }
+    VDynoCoolantFlowRaw = (float)MCP320X_get_count(MCP320X_DYNO_FLOW_DEVICE, MCP320X_DYNO_FLOW_CHANNEL) *
+                          (float)VADC_REFERNCE / 4096.0f;
+    VDynoCoolantFlow = CAL_convert(CAL_DYNO_FLOW, VDynoCoolantFlowRaw);
+    return ESP_OK;
+}
+
+esp_err_t MCP320X_thermistor_map(stSensorMap_t *stSensorMap)
+{
+    /*
+    *===========================================================================
+    *   MCP320X_thermistor_map
+    *   Takes:   stSensorMap: Filled with volts to degrees C
+    *
+    *   Returns: sensor_map_init's result.
+    *
+    *   Builds the temperature monitor's sensor map from the thermistor's
+    *   beta, MCP320X_THERMISTOR_STEP_C apart from MCP320X_THERMISTOR_MAX_C
+    *   down, the breakpoints rise in volts as temperature falls.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    float fDegC;
+    float fOhms;
+    byte byPoint;
+
+    memset(stSensorMap, 0, sizeof(*stSensorMap));
+    for (byPoint = 0; byPoint < SENSOR_MAP_POINTS; byPoint++)
+    {
+        fDegC = MCP320X_THERMISTOR_MAX_C - MCP320X_THERMISTOR_STEP_C * byPoint;
+        fOhms = MCP320X_THERMISTOR_R25 * expf(MCP320X_THERMISTOR_BETA * (1.0f / (fDegC + 273.15f) - 1.0f / 298.15f));
+        stSensorMap->afLookupTable[0][byPoint] = (float)VADC_REFERNCE * fOhms / (fOhms + MCP320X_THERMISTOR_PULLUP);
+        stSensorMap->afLookupTable[1][byPoint] = fDegC;
+    }
+    stSensorMap->fLowerLimit = stSensorMap->afLookupTable[0][0];
+    stSensorMap->fUpperLimit = stSensorMap->afLookupTable[0][SENSOR_MAP_POINTS - 1];
+    return sensor_map_init(stSensorMap);
+}
+
+esp_err_t MCP320X_update_temp_monitor(stSensorMap_t *stThermistorMap, byte byFirstCell)
+{
+    /*
+    *===========================================================================
+    *   MCP320X_update_temp_monitor
+    *   Takes:   stThermistorMap: From MCP320X_thermistor_map
+    *            byFirstCell: TCell index of the first device's channel 0
+    *
+    *   Returns: ESP_OK, ESP_ERR_INVALID_STATE if nothing is scanned, or
+    *            ESP_ERR_INVALID_ARG if the cells run past TCell.
+    *
+    *   Converts every scanned channel to degrees C in one batch and sets
+    *   this module's TCell from them, and TCellMin, TCellMax, their IDs and
+    *   TCellAvg over them. A channel out of the map's range keeps its last
+    *   TCell and is left out.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    word awCounts[MCP320X_MAX_CHANNELS];
+    float afValues[MCP320X_MAX_DEVICES * MCP320X_MAX_CHANNELS];
+    word wNCells = 0;
+    word wCell;
+    word wNValid = 0;
+    sdword nSum = 0;
+    sbyte byTemp;
+    byte byDevice;
+    byte byChannel;
+
+    if (wNScanDevices == 0)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    for (byDevice = 0; byDevice < wNScanDevices; byDevice++)
+    {
+        MCP320X_get_counts(byDevice, awCounts);
+        for (byChannel = 0; byChannel < abyScanNChannels[byDevice]; byChannel++)
+        {
+            afValues[wNCells++] = (float)awCounts[byChannel] * (float)VADC_REFERNCE / 4096.0f;
+        }
+    }
+    if (byFirstCell + wNCells > sizeof(TCell) / sizeof(TCell[0]))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    convert_sensor_batch(afValues, afValues, wNCells, stThermistorMap);
+
+    for (wCell = 0; wCell < wNCells; wCell++)
+    {
+        if (afValues[wCell] == SENSOR_INVALID)
+        {
+            continue;
+        }
+        byTemp = (sbyte)(afValues[wCell] < -128.0f ? -128 : afValues[wCell] > 127.0f ? 127 :
+                         (afValues[wCell] < 0.0f ? afValues[wCell] - 0.5f : afValues[wCell] + 0.5f));
+        TCell[byFirstCell + wCell] = byTemp;
+        if (wNValid == 0 || byTemp < TCellMin)
+        {
+            TCellMin = byTemp;
+            NTCellMinID = (uint8_t)(byFirstCell + wCell);
+        }
+        if (wNValid == 0 || byTemp > TCellMax)
+        {
+            TCellMax = byTemp;
+            NTCellMaxID = (uint8_t)(byFirstCell + wCell);
+        }
+        nSum += byTemp;
+        wNValid++;
+    }
+    if (wNValid > 0)
+    {
+        TCellAvg = (int8_t)(nSum / (sdword)wNValid);
+    }
+    return ESP_OK;
+}
+
+/* --------------------------- Local Functions ------------------------ */
+static void MCP320X_command(uint8_t NDevADC, uint8_t *NDataTx)
+{
+    // Alignment Logic for 24 clocks (3 bytes):
+    // Byte 0: 0 0 0 0 0 S M D2
+    // Byte 1: D1 D0 N N B11 B10 B9 B8
+    // Byte 2: B7 B6 B5 B4 B3 B2 B1 B0
+    // Where S is start bit (1), M is mode (0 for single-ended, 1 for differential), D2-D0 are the channel selection bits, 
+    // N is null bit, and B11-B0 are the 12-bit ADC result.
+    NDataTx[0] = 0x6 | ((NDevADC & 0x4) >> 2);
+    NDataTx[1] = (NDevADC & 0x3) << 6;
+    NDataTx[2] = 0x00;
+}
+
+static word MCP320X_counts(const uint8_t *NDataRx)
+{
+    return (word)(((NDataRx[1] & 0xF) << 8) | NDataRx[2]);
+}
+
+static int MCP320X_find(spi_device_handle_t stDeviceHandle)
+{
+    /* Index of a scanned device, -1 if it is not */
+    word wDevice;
+    for (wDevice = 0; wDevice < wNScanDevices; wDevice++)
+    {
+        if (astScanDevices[wDevice] == stDeviceHandle)
+        {
+            return wDevice;
+        }
+    }
+    return -1;
+}
+
+static void MCP320X_scan_tick(void *pvArg)
+{
+    /* esp_timer callback, wakes the scan task */
+    (void)pvArg;
+    (void)xTaskNotifyGive(xScanTask);
+}
+
+static void MCP320X_scan_task(void *pvArg)
+{
+    /*
+    *===========================================================================
+    *   MCP320X_scan_task
+    *   Takes:   pvArg: Unused
+    *
+    *   Returns: Never
+    *
+    *   Scans once for each wake up from the timer. Ticks that came while
+    *   the last scan ran are counted as overruns, not scanned for.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    dword dwNTicks;
+    dword dwNErrors;
+    qword qwtScan;
+    dword dwNSamples = 0;
+    word wDevice;
+
+    (void)pvArg;
+    for (wDevice = 0; wDevice < wNScanDevices; wDevice++)
+    {
+        dwNSamples += abyScanNChannels[wDevice];
+    }
+    for (;;)
+    {
+        dwNTicks = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (dwNTicks == 0)
+        {
+            continue;
+        }
+        qwtScan = esp_timer_get_time();
+        dwNErrors = MCP320X_scan();
+        qwtScan = esp_timer_get_time() - qwtScan;
+
+        portENTER_CRITICAL(&stScanLock);
+        stScanStats.dwNScans++;
+        stScanStats.dwNSamples += dwNSamples - dwNErrors;
+        stScanStats.dwNOverruns += dwNTicks - 1;
+        stScanStats.dwNErrors += dwNErrors;
+        stScanStats.qwNScanus += qwtScan;
+        if (qwtScan > stScanStats.dwScanMaxus)
+        {
+            stScanStats.dwScanMaxus = (dword)qwtScan;
+        }
+        portEXIT_CRITICAL(&stScanLock);
+    }
+}
+
+static dword MCP320X_scan(void)
+{
+    /*
+    *===========================================================================
+    *   MCP320X_scan
+    *   Takes:   None
+    *
+    *   Returns: Transactions that failed
+    *
+    *   Reads every channel of every device, holding the bus for each device
+    *   so its transactions go back to back, then publishes the device's
+    *   counts together.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    word awCounts[MCP320X_MAX_CHANNELS];
+    dword dwNErrors = 0;
+    word wDevice;
+    byte byChannel;
+
+    for (wDevice = 0; wDevice < wNScanDevices; wDevice++)
+    {
+        memcpy(awCounts, aawScanCounts[wDevice], sizeof(awCounts));
+        if (spi_device_acquire_bus(astScanDevices[wDevice], portMAX_DELAY) != ESP_OK)
+        {
+            dwNErrors += abyScanNChannels[wDevice];
+            continue;
+        }
+        for (byChannel = 0; byChannel < abyScanNChannels[wDevice]; byChannel++)
+        {
+            if (spi_device_polling_transmit(astScanDevices[wDevice], &aastScanCalls[wDevice][byChannel]) == ESP_OK)
+            {
+                awCounts[byChannel] = MCP320X_counts(aastScanCalls[wDevice][byChannel].rx_data);
+            }
+            else
+            {
+                dwNErrors++;
+            }
+        }
+        spi_device_release_bus(astScanDevices[wDevice]);
+
+        portENTER_CRITICAL(&stScanLock);
+        memcpy(aawScanCounts[wDevice], awCounts, sizeof(awCounts));
+        portEXIT_CRITICAL(&stScanLock);
+    }
+    return dwNErrors;
+}
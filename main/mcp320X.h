@@ -8,9 +8,68 @@
 #include "string.h"
 #include "esp_err.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include "adc.h"
+#include "calibration.h"
+#include "CAN/canDecodeAuto.h"
+
+/*  Scanning
+    MCP320X_scan_init starts a task that reads every channel of every device each time an
+    esp_timer fires, wScanHz times a second, and keeps their raw 12 bit counts. The bus is acquired
+    once per device per scan and each channel is a polling transaction with its command and result
+    held in the transaction, so there is no queue, interrupt or buffer to set up per channel. The
+    MCP320X starts a conversion on CS falling so every channel needs its own transaction.
+    Timer ticks that come while a scan is still running are counted as overruns and the next scan
+    starts straight away. MCP320X_read on a scanned device gives its latest count without the bus.
+    The Dyno's and temperature monitor's signals are worked out from the counts by
+    MCP320X_update_dyno and MCP320X_update_temp_monitor. The Dyno's calibrated signals go through
+    its calibration tables, CAL_DYNO_*, so a recalibrated sensor needs no new image.
+*/
+#define MCP320X_MAX_DEVICES             2
+#define MCP320X_MAX_CHANNELS            8       // MCP3208, 4 for an MCP3204
+#define MCP320X_SCAN_HZ                 1000
+#define MCP320X_SCAN_TASK_STACK         3072
+#define MCP320X_SCAN_TASK_PRIORITY      5       // Above the background loop, below esp_timer
+#define MCP320X_READ_ERROR              999.9f
+
+/* Dyno, two MCP3204s */
+#define MCP320X_DYNO_ID                 0x19    // DEVICE_ID
+#define MCP320X_DYNO_PRESSURE_DEVICE    0       // Channels 0 to 2
+#define MCP320X_DYNO_FLOW_DEVICE        0
+#define MCP320X_DYNO_FLOW_CHANNEL       3
+#define MCP320X_DYNO_TEMP_DEVICE        1       // Channels 0 to 2
+
+/* Temperature monitor, one MCP3208 of NTC thermistors to ground, pulled up to the reference */
+#define MCP320X_TEMP_MONITOR_ID         0x1A    // DEVICE_ID
+#define MCP320X_THERMISTOR_BETA         3950.0f
+#define MCP320X_THERMISTOR_R25          10000.0f
+#define MCP320X_THERMISTOR_PULLUP       10000.0f
+#define MCP320X_THERMISTOR_MAX_C        160.0f  // Sensor map from here down
+#define MCP320X_THERMISTOR_STEP_C       2.0f
+
+typedef struct {
+    dword dwNScans;
+    dword dwNSamples;
+    dword dwNOverruns;          // Timer ticks that came during a scan
+    dword dwNErrors;            // Transactions that failed, the channel keeps its last count
+    qword qwNScanus;
+    dword dwScanMaxus;
+} stMCP320XStats_t;
+
+extern stSensorMap_t stThermistorMap;
 
 /* --------------------------- Function prototypes -------------------- */
 esp_err_t MCP320X_init(word wNDevices, uint8_t abyNCSPins[], spi_device_handle_t astDeviceHandles[]);
 float MCP320X_read(spi_device_handle_t stDeviceHandle, uint8_t NDevADC);
+esp_err_t MCP320X_scan_init(word wNDevices, spi_device_handle_t astDeviceHandles[], const byte abyNChannels[],
+                            word wScanHz);
+word MCP320X_get_count(byte byDevice, byte byChannel);
+void MCP320X_get_counts(byte byDevice, word *awCounts);
+void MCP320X_get_stats(stMCP320XStats_t *pstStats);
+void MCP320X_report(void);
+esp_err_t MCP320X_update_dyno(void);
+esp_err_t MCP320X_thermistor_map(stSensorMap_t *stSensorMap);
+esp_err_t MCP320X_update_temp_monitor(stSensorMap_t *stThermistorMap, byte byFirstCell);
 
 #endif
\ No newline at end of file
@@ -8,40 +8,141 @@ Written by Cole Perera for Sheffield Formula Racing 2025
 #include "sdcard.h"
 
 /* --------------------------- Global Variables ----------------------------- */
-static const char *SD_MOUNT_POINT = "/sdcard";
-static char abyFilePath[64] = "/sdcard/log000.bin";
+static char abyFilePath[64] = SD_MOUNT_POINT "/log000.bin";
 
 /* --------------------------- Local Variables ------------------------------ */
 extern dword dwTimeSincePowerUpms;
-FILE *stFile;
+static int NLogFile = -1;
+static TaskHandle_t xSDLogWriterTask = NULL;
+static TaskHandle_t xSDLogCloser = NULL;
+static volatile boolean BLogOpen = FALSE;       // Producers may add frames
+static volatile boolean BLogClosing = FALSE;
+static volatile boolean BLogMountPending = FALSE;   // SD_card_init has left the writer to open the file
+static boolean BSDMounted = FALSE;
+static portMUX_TYPE stSDLogLock = portMUX_INITIALIZER_UNLOCKED;
+
+/* Producers fill one block while the writer task writes the others */
+static DMA_ATTR byte aabyLogBlock[SD_LOG_BLOCKS][SD_LOG_BLOCK_SIZE];
+static word awLogBlockLength[SD_LOG_BLOCKS];   // Bytes waiting for the writer, 0 while free or filling
+static word awLogBlockNFrames[SD_LOG_BLOCKS];
+static qword aqwtLogBlockBase[SD_LOG_BLOCKS];
+static byte abyLogBlockType[SD_LOG_BLOCKS];
+static qword aqwtLogBlockLast[SD_LOG_BLOCKS];
+static byte aabyLogBlockBloom[SD_LOG_BLOCKS][SD_LOG_BLOOM_SIZE];
+static byte byLogFillBlock;
+static word wLogFillLength;                     // Header included
+static qword qwtLogLastFrame;
+static byte byLogWriteBlock;
+static dword dwLogBlockSequence;
+static stSDLogStats_t stLogStats;
+
+/* Writer task only, the index block being built and where the file has got to */
+static DMA_ATTR byte abyLogIndexBlock[SD_LOG_INDEX_BLOCK_SIZE];
+static stSDLogIndex_t *const pstLogIndex = (stSDLogIndex_t *)&abyLogIndexBlock[sizeof(stSDLogBlockHeader_t)];
+static qword qwLogFileOffset;
+static dword dwLogNBlocks;
+static qword qwtLogFirstFrame;
+static dword dwLogFileNFrames;
+static qword qwtLogFileLastFrame;
+static dword dwLogFileStartDropped;
+static dword dwLogFileNumber;
+static stSDLogFileHeader_t stLogFileHeader;
+static DMA_ATTR byte abyLogFileSector[SD_SECTOR_SIZE];
+
+#if SD_LOG_COMPRESS
+/* A frame block compressed, the log's or the capture's, both written from the writer task */
+static DMA_ATTR byte abyLogPackedBlock[SD_LOG_BLOCK_SIZE];
+#endif
+
+/* Capture ring, the producers' until it is frozen and then the writer task's until it is re-armed */
+static CAN_frame_t *astCaptureRing = NULL;
+static dword dwCaptureSize;                     // Frames it holds
+static dword dwCaptureHead;                     // Where the next frame goes
+static dword dwCaptureNFrames;
+static dword dwCaptureNPre;                     // Frames from before the trigger still in the ring
+static dword dwCapturePreShare;                 // Of the ring, kept for them once the post window needs room
+static qword qwtCaptureNewest;
+static qword qwtCaptureTrigger;
+static qword qwtCaptureFrozen;
+static qword qwtCaptureRetry;
+static volatile eSDCaptureState_t eCaptureState = eSD_CAPTURE_OFF;
+static byte byCaptureLastKill = KILL_NONE;
+static stSDCaptureStats_t stCaptureStats;
+static portMUX_TYPE stSDCaptureLock = portMUX_INITIALIZER_UNLOCKED;
+
+/* Writer task only, the capture file being written */
+static byte *abyCaptureBlock = NULL;            // DMA capable, a frame block then an index block
+static char abyCapturePath[64];
+static int NCaptureFile = -1;
+static qword qwCaptureOffset;
+static dword dwCaptureSequence;
+static dword dwCaptureNumber = SD_LOG_MAX_NUMBER + 1;  // Past the end until the card is scanned
+static stSDLogFileHeader_t stCaptureFileHeader;
+
+/* Timeouts that trigger a capture, its trigger block's source is the position here */
+static bool *const apBCaptureTimeouts[] = {
+    &BStatusAPPSInError,
+    &BStatusAPPSSensorInError,
+    &BIMDDataInError,
+    &BCellVoltagesInError,
+    &BCellStats1InError,
+    &BCellStats2InError,
+    &BCellStats3InError,
+    &BCellStats4InError,
+    &BSetRelCurrentInError,
+    &BERPM_DUTY_VOLTAGEInError,
+};
+#define SD_CAPTURE_N_TIMEOUTS (sizeof(apBCaptureTimeouts) / sizeof(apBCaptureTimeouts[0]))
+static boolean aBCaptureLastTimeout[SD_CAPTURE_N_TIMEOUTS];
 
 /* --------------------------- Function prototypes -------------------------- */
 esp_err_t SD_card_init(void);
-esp_err_t sdcard_empty_buffer(void);
+esp_err_t SD_card_write_CAN(const CAN_frame_t *stCANFrame, qword qwtRx);
+esp_err_t SD_card_close(void);
+void SD_log_get_stats(stSDLogStats_t *stStats);
+static esp_err_t SD_log_start_writer(void);
+static boolean SD_log_seal(void);
+static word SD_log_put_frame(byte *abyBlock, word wOffset, const CAN_frame_t *stFrame, dword dwDeltaus);
+static void SD_log_bloom_add(byte *abyBloom, dword dwID);
+static void SD_log_writer_task(void *pvParameters);
+static boolean SD_log_start_file(void);
+static boolean SD_log_write_block(void);
+static dword SD_log_write(byte *abyBlock, byte byType, word wLength, word wNFrames, qword qwtBaseus);
+static word SD_log_fill_header(byte *abyBlock, byte byType, word wLength, word wNFrames, qword qwtBaseus,
+                               dword dwSequence, dword dwCRCSeed);
+static byte *SD_log_pack(byte *abyBlock, byte *pbyType, word *pwLength);
+static void SD_log_index_add(dword dwSector, qword qwtBaseus, qword qwtLastus, const byte *abyBloom);
+static void SD_log_write_index(void);
+static esp_err_t SD_log_mount(void);
+static void SD_log_name_file(void);
+static dword SD_log_scan_numbers(const char *sPrefix);
+static void SD_log_save_number(dword dwNext);
+static esp_err_t SD_log_open_file(void);
+static boolean SD_log_mark_valid(void);
+#if SD_LOG_FILE_KB > 0
+static void SD_log_roll(void);
+#endif
+static void SD_log_finish_file(void);
+static void SD_log_close_file(void);
+static void SD_log_sync(void);
+static void SD_log_first_written(void);
+static void SD_log_histogram_add(dword *adwNHistogram, dword dwTimeus);
+static void SD_log_report(void);
+static boolean SD_capture_latch(byte byCause, byte bySource, qword qwtEvent);
+static boolean SD_capture_freeze(boolean BPostCut);
+static qword SD_capture_time(const CAN_frame_t *stFrame);
+static TickType_t SD_capture_wait(TickType_t xWait);
+static void SD_capture_service(void);
+static boolean SD_capture_write(void);
+static boolean SD_capture_write_frames(void);
+static dword SD_capture_put(byte *abyBlock, byte byType, word wLength, word wNFrames, qword qwtBaseus);
+static boolean SD_capture_put_file_block(void);
 
 /* --------------------------- Definitions ---------------------------------- */
 #define MAX_FILES 5
 #define ALLOCATION_UNIT_SIZE 16 * 1024
-#define SDMMC_FREQ 10000 // 10 kHz
+#define SDMMC_FREQ SDMMC_FREQ_DEFAULT // 20 MHz, the most an SPI mode card is guaranteed to take
 #define MAX_TRANSFER_SIZE 4000 // max transfer size of one spi operation (bytes)
-#define WRITE_BUFFER_SIZE 16384 // 16KB Buffer
-#define FILE_SPEC_VERSION 0x01
-#define MAX_WRITES_PER_CALL 50
-
-typedef struct __attribute__((packed)) {
-    byte     type;
-    uint32_t dwTimestamp;
-    uint16_t dwID;
-    uint8_t  byDLC;
-    uint8_t  abData[8];
-} BinLogEntry_t;
-
-typedef enum {
-    CAN = 0x01,
-    CAN_FD,
-    CAN_STATE,
-    ETERNAL_CLOCK,
-} eLogEntryType_t;
 
 /* --------------------------- Functions ------------------------------------ */
 
@@ -51,150 +152,2134 @@ esp_err_t SD_card_init(void)
     *===========================================================================
     *   SD_card_init
     *   Takes:   None
-    * 
-    *   Returns: ESP_OK if successful, error code if not.
-    * 
-    *   Initializes the SD card interface.
+    *
+    *   Returns: ESP_OK if logging has started, ESP_ERR_INVALID_STATE if it
+    *            already had, ESP_ERR_NO_MEM if the writer task could not be
+    *            created.
+    *
+    *   Starts logging. Frames are taken from the moment this returns, the
+    *   writer task mounts the card and opens the next log file in the
+    *   background so call it once CAN is up. A card that fails to mount is
+    *   logged by the writer and logging stops.
     *===========================================================================
     *   Revision History:
     *   20/10/25 CP Initial Version
     *   25/11/25 CP Switch to asc format
+    *   18/10/26 CP Full SPI clock, file header goes in the first log block and
+    *               the writer task is started
+    *   18/10/26 CP Log format v2 file header block with the external clock's time
+    *   18/10/26 CP Index state reset for each file
+    *   18/10/26 CP File opened by SD_log_open_file, pre-allocated
+    *   18/10/26 CP Mount and open moved to the writer task, SD_log_mount
+    *   18/10/26 CP Writer started by SD_log_start_writer
+    *
+    *===========================================================================
+    */
+    if (BLogOpen)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    /* Every block starts free, the writer writes the file header before any of them */
+    memset(awLogBlockLength, 0, sizeof(awLogBlockLength));
+    memset(awLogBlockNFrames, 0, sizeof(awLogBlockNFrames));
+    memset(aabyLogBlockBloom, 0, sizeof(aabyLogBlockBloom));
+    memset(&stLogStats, 0, sizeof(stLogStats));
+    BLogClosing = FALSE;
+    byLogWriteBlock = 0;
+    byLogFillBlock = 0;
+    wLogFillLength = sizeof(stSDLogBlockHeader_t);
+    qwtLogLastFrame = (qword)esp_timer_get_time();
+    BLogMountPending = TRUE;
+
+    /* A writer left waiting by SD_card_close takes the new file */
+    if (SD_log_start_writer() != ESP_OK)
+    {
+        BLogMountPending = FALSE;
+        return ESP_ERR_NO_MEM;
+    }
+    BLogOpen = TRUE;
+    (void)xTaskNotifyGive(xSDLogWriterTask);
+
+    return ESP_OK;
+}
+
+esp_err_t SD_card_write_CAN(const CAN_frame_t *stCANFrame, qword qwtRx)
+{
+    /*
+    *===========================================================================
+    *   SD_card_write_CAN
+    *   Takes:   stCANFrame: Frame to log
+    *            qwtRx: Rx time in us since power up
+    *
+    *   Returns: ESP_OK if added, ESP_ERR_INVALID_STATE if the card is not
+    *            logging, ESP_ERR_NO_MEM if every block is waiting on the card.
+    *
+    *   Adds a frame to the block being filled and wakes the writer task once
+    *   it is full. Only copies, safe from an ISR or any task.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   24/10/25 CP Initial Version as sdcard_empty_buffer
+    *   25/11/25 CP Changed to use FreeRTOS queue
+    *   26/11/25 CP Switch to asc format
+    *   27/11/25 CP Switch to binary format
+    *   18/10/26 CP Called per frame by the producer, no longer takes frames
+    *               off the CAN queue or writes the card
+    *   18/10/26 CP Log format v2, us delta times, 29 bit IDs and DLC bytes
+    *   18/10/26 CP Adds the ID to the block's bloom filter
+    *   18/10/26 CP Notes when the first frame was taken
+    *   18/10/26 CP Bloom filter set by SD_log_bloom_add
     *
     *===========================================================================
     */
     esp_err_t eStatus = ESP_OK;
-    esp_vfs_fat_sdmmc_mount_config_t stSDMountConfig = 
+    boolean BBlockFull = FALSE;
+    qword qwDeltaus;
+
+    if (!BLogOpen)
     {
-        .format_if_mount_failed = true,
-        .max_files = MAX_FILES,
-        .allocation_unit_size = ALLOCATION_UNIT_SIZE
-    };
-    sdmmc_card_t *stSDCard;
-    sdmmc_host_t stSDCardHost = SDSPI_HOST_DEFAULT();
-    stSDCardHost.max_freq_khz = SDMMC_FREQ;
-    sdspi_device_config_t stSDCardSlot = SDSPI_DEVICE_CONFIG_DEFAULT();
-    stSDCardSlot.gpio_cs = SPI_SD_CS;
-    stSDCardSlot.host_id = stSDCardHost.slot;
+        return ESP_ERR_INVALID_STATE;
+    }
 
-    ESP_LOGI("SDCARD", "Initializing SD card...");
-    if (eStatus != ESP_OK)
+    portENTER_CRITICAL_SAFE(&stSDLogLock);
+    /* Frames come from one ISR so are in order, anything else is logged as simultaneous */
+    qwDeltaus = qwtRx > qwtLogLastFrame ? qwtRx - qwtLogLastFrame : 0;
+    if (qwDeltaus > 0xFFFFFFFF)
     {
-        ESP_LOGE("SDCARD", "Failed to initialize SPI bus: %s", esp_err_to_name(eStatus));
-        return eStatus;
+        /* Too long a gap for the varint, start a block with a new base time */
+        BBlockFull = SD_log_seal();
     }
 
-    ESP_LOGI("SDCARD", "Mounting filesystem...");
-    eStatus = esp_vfs_fat_sdspi_mount(SD_MOUNT_POINT, &stSDCardHost, &stSDCardSlot, &stSDMountConfig, &stSDCard);
-    if (eStatus != ESP_OK)
+    if (!BLogOpen)
     {
-        if (eStatus == ESP_FAIL)
+        /* Closed since the check above */
+        eStatus = ESP_ERR_INVALID_STATE;
+    }
+    else if (awLogBlockLength[byLogFillBlock] != 0)
+    {
+        stLogStats.dwNDropped++;
+        eStatus = ESP_ERR_NO_MEM;
+    }
+    else
+    {
+        if (awLogBlockNFrames[byLogFillBlock] == 0)
         {
-            ESP_LOGE("SDCARD", "Failed to mount filesystem. Formatting...");
-            eStatus = esp_vfs_fat_sdcard_format("/sdcard", stSDCard);
-            if (eStatus != ESP_OK)
-            {
-                ESP_LOGE("SDCARD", "Failed to format: %s", esp_err_to_name(eStatus));
-                return eStatus;
-            }
+            aqwtLogBlockBase[byLogFillBlock] = qwtRx;
+            qwDeltaus = 0;
+        }
+        wLogFillLength = SD_log_put_frame(aabyLogBlock[byLogFillBlock], wLogFillLength, stCANFrame, (dword)qwDeltaus);
+        awLogBlockNFrames[byLogFillBlock]++;
+        aqwtLogBlockLast[byLogFillBlock] = qwtRx;
+        SD_log_bloom_add(aabyLogBlockBloom[byLogFillBlock], stCANFrame->dwID);
+        qwtLogLastFrame = qwtRx;
+        if (stLogStats.dwNFrames == 0)
+        {
+            stLogStats.qwtFirstFrameus = qwtRx;
+        }
+        stLogStats.dwNFrames++;
+        if (wLogFillLength + SD_LOG_MAX_RECORD_SIZE > SD_LOG_BLOCK_SIZE)
+        {
+            BBlockFull |= SD_log_seal();
+        }
+    }
+    portEXIT_CRITICAL_SAFE(&stSDLogLock);
+
+    /* The writer is low priority so there is no need to yield to it */
+    if (BBlockFull)
+    {
+        if (xPortInIsrContext())
+        {
+            vTaskNotifyGiveFromISR(xSDLogWriterTask, NULL);
         }
         else
         {
-            ESP_LOGE("SDCARD", "Failed to mount filesystem: %s", esp_err_to_name(eStatus));
-            return eStatus;
+            (void)xTaskNotifyGive(xSDLogWriterTask);
         }
     }
-    ESP_LOGI("SDCARD", "Mounted successfully.");
-    /* Print Card Details */
-    sdmmc_card_print_info(stdout, stSDCard);
-    /* Query card to update file abyFilePath */
-    DIR *stDirectory;
-    stDirectory = opendir(SD_MOUNT_POINT);
-    if (stDirectory == NULL)
+    return eStatus;
+}
+
+esp_err_t SD_card_close(void)
+{
+    /*
+    *===========================================================================
+    *   SD_card_close
+    *   Takes:   None
+    *
+    *   Returns: ESP_OK if the file was closed, ESP_ERR_INVALID_STATE if none
+    *            was open, ESP_ERR_TIMEOUT if the writer did not finish.
+    *
+    *   Stops logging and has the writer task write out what is left, the
+    *   last index block and the footer, then sync and close the file. Waits
+    *   up to SD_LOG_CLOSE_TIMEOUT_MS, call from a task. The writer task is
+    *   left waiting for another file.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    if (!BLogOpen || BLogClosing)
     {
-        ESP_LOGE("SDCARD", "Failed to open directory");
         return ESP_ERR_INVALID_STATE;
     }
-    struct dirent *stDirInfo;
-    stDirInfo = readdir(stDirectory);
-    word wNLastFile = 0;
-    while (stDirInfo != NULL)
+
+    xSDLogCloser = xTaskGetCurrentTaskHandle();
+    BLogClosing = TRUE;
+    (void)xTaskNotifyGive(xSDLogWriterTask);
+    if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(SD_LOG_CLOSE_TIMEOUT_MS)) == 0)
     {
-        wNLastFile++;
-        stDirInfo = readdir(stDirectory);
+        ESP_LOGE("SDCARD", "Timed out closing %s", abyFilePath);
+        return ESP_ERR_TIMEOUT;
     }
-    closedir(stDirectory);
-    snprintf(abyFilePath, sizeof(abyFilePath), "%s/log%03d.bin", SD_MOUNT_POINT, (int)wNLastFile);
-    stFile = fopen(abyFilePath, "ab");
-    
-    if (stFile != NULL)
+    ESP_LOGI("SDCARD", "Closed %s", abyFilePath);
+    return ESP_OK;
+}
+
+static esp_err_t SD_log_start_writer(void)
+{
+    /*
+    *===========================================================================
+    *   SD_log_start_writer
+    *   Takes:   None
+    *
+    *   Returns: ESP_OK if the writer task is running, ESP_ERR_NO_MEM if it
+    *            could not be created.
+    *
+    *   Creates the writer task unless the log or the capture ring already
+    *   has. It serves both.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version, split from SD_card_init
+    *
+    *===========================================================================
+    */
+    if (xSDLogWriterTask == NULL && xTaskCreate(SD_log_writer_task, "SD log", SD_LOG_TASK_STACK, NULL,
+                                                SD_LOG_TASK_PRIORITY, &xSDLogWriterTask) != pdPASS)
+    {
+        ESP_LOGE("SDCARD", "Failed to create the writer task");
+        xSDLogWriterTask = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+static boolean SD_log_seal(void)
+{
+    /*
+    *===========================================================================
+    *   SD_log_seal
+    *   Takes:   None, call with stSDLogLock held
+    *
+    *   Returns: TRUE if the block being filled was handed to the writer.
+    *
+    *   Hands the block being filled to the writer task and moves the
+    *   producers on to the next one. An empty block is left alone.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    if (awLogBlockNFrames[byLogFillBlock] == 0 || awLogBlockLength[byLogFillBlock] != 0)
+    {
+        return FALSE;
+    }
+    abyLogBlockType[byLogFillBlock] = eSD_BLOCK_FRAMES;
+    awLogBlockLength[byLogFillBlock] = wLogFillLength;
+    byLogFillBlock = (byte)((byLogFillBlock + 1) % SD_LOG_BLOCKS);
+    wLogFillLength = sizeof(stSDLogBlockHeader_t);
+    return TRUE;
+}
+
+static word SD_log_put_frame(byte *abyBlock, word wOffset, const CAN_frame_t *stFrame, dword dwDeltaus)
+{
+    /*
+    *===========================================================================
+    *   SD_log_put_frame
+    *   Takes:   abyBlock: Block being filled
+    *            wOffset: Where the record goes, the caller has checked it fits
+    *            stFrame: Frame to write
+    *            dwDeltaus: us since the previous frame in the block
+    *
+    *   Returns: Offset after the record.
+    *
+    *   Writes a frame record, the same header, time and data as an ESP-NOW
+    *   telemetry frame, see espnow.h.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    byte byDLC = stFrame->byDLC > 8 ? 8 : stFrame->byDLC;
+
+    if (stFrame->dwID > 0x7FF)
+    {
+        abyBlock[wOffset + 0] = (byte)(ESPNOW_FRAME_EXTENDED | (byDLC << ESPNOW_FRAME_DLC_SHIFT));
+        abyBlock[wOffset + 1] = (byte)((stFrame->dwID >> 24) & 0x1F);
+        abyBlock[wOffset + 2] = (byte)((stFrame->dwID >> 16) & 0xFF);
+        abyBlock[wOffset + 3] = (byte)((stFrame->dwID >> 8) & 0xFF);
+        abyBlock[wOffset + 4] = (byte)(stFrame->dwID & 0xFF);
+        wOffset += ESPNOW_EXT_HEADER_SIZE;
+    }
+    else
     {
-        static char acBuffer[WRITE_BUFFER_SIZE];
-        setvbuf(stFile, acBuffer, _IOFBF, sizeof(acBuffer));
+        abyBlock[wOffset + 0] = (byte)((byDLC << ESPNOW_FRAME_DLC_SHIFT) | ((stFrame->dwID >> 8) & 0x07));
+        abyBlock[wOffset + 1] = (byte)(stFrame->dwID & 0xFF);
+        wOffset += ESPNOW_STD_HEADER_SIZE;
     }
 
-    byte byFileSpecVersion = FILE_SPEC_VERSION;
-    byte abyTimeData[6] = {0};
-    byte abReserved[9] = {0};
-    fwrite(&byFileSpecVersion, sizeof(byFileSpecVersion), 1, stFile);
-    fwrite(&abyTimeData, sizeof(abyTimeData), 1, stFile);
-    fwrite(&abReserved, sizeof(abReserved), 1, stFile);
+    /* Time since the previous frame, 7 bits a byte */
+    do
+    {
+        abyBlock[wOffset] = (byte)(dwDeltaus & 0x7F);
+        dwDeltaus >>= 7;
+        if (dwDeltaus != 0)
+        {
+            abyBlock[wOffset] |= 0x80;
+        }
+        wOffset++;
+    } while (dwDeltaus != 0);
+
+    memcpy(&abyBlock[wOffset], stFrame->abData, byDLC);
+    return (word)(wOffset + byDLC);
+}
+
+static void SD_log_bloom_add(byte *abyBloom, dword dwID)
+{
+    /*
+    *===========================================================================
+    *   SD_log_bloom_add
+    *   Takes:   abyBloom: SD_LOG_BLOOM_SIZE byte filter
+    *            dwID: Frame ID to add
+    *
+    *   Returns: None
+    *
+    *   Sets the ID's two bits, each picked by a byte of ID * SD_LOG_BLOOM_HASH.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version, split from SD_card_write_CAN
+    *
+    *===========================================================================
+    */
+    dword dwHash = (dword)((dwID * SD_LOG_BLOOM_HASH) & 0xFFFFFFFF);
+
+    abyBloom[dwHash >> 27] |= (byte)(1 << ((dwHash >> 24) & 7));
+    abyBloom[(dwHash >> 19) & 0x1F] |= (byte)(1 << ((dwHash >> 16) & 7));
+}
+
+void SD_log_get_stats(stSDLogStats_t *stStats)
+{
+    /*
+    *===========================================================================
+    *   SD_log_get_stats
+    *   Takes:   stStats: Filled with a copy of the logger's counters
+    *
+    *   Returns: None
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    portENTER_CRITICAL_SAFE(&stSDLogLock);
+    *stStats = stLogStats;
+    portEXIT_CRITICAL_SAFE(&stSDLogLock);
+}
+
+static void SD_log_writer_task(void *pvParameters)
+{
+    /*
+    *===========================================================================
+    *   SD_log_writer_task
+    *   Takes:   pvParameters: Unused
+    *
+    *   Returns: Never
+    *
+    *   Sleeps until a block is full or a sync is due. Writes the full blocks
+    *   in order, then if SD_LOG_SYNC_MS is up writes what has been logged
+    *   since and syncs the file. Opens the file when SD_card_init asks and
+    *   closes it when SD_card_close asks. Freezes and writes out the capture
+    *   ring first, its file holding up the log's for as long as it takes.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Closes the file and waits for the next
+    *   18/10/26 CP Mounts the card and opens the file
+    *   18/10/26 CP Writes the capture ring
+    *
+    *===========================================================================
+    */
+    qword qwtNow = (qword)esp_timer_get_time();
+    qword qwtLastSync = qwtNow;
+    qword qwtLastReport = qwtNow;
+    TickType_t xWait;
+    byte byNBlocks;
+
+    (void)pvParameters;
+    while (1)
+    {
+        xWait = portMAX_DELAY;
+        #if SD_LOG_SYNC_MS > 0
+        qwtNow = (qword)esp_timer_get_time();
+        if (NLogFile < 0)
+        {
+            /* Nothing to sync until SD_card_init opens a file */
+        }
+        else if (qwtNow - qwtLastSync < (qword)SD_LOG_SYNC_MS * 1000)
+        {
+            xWait = pdMS_TO_TICKS((qwtLastSync + (qword)SD_LOG_SYNC_MS * 1000 - qwtNow) / 1000 + 1);
+        }
+        else
+        {
+            xWait = 0;
+        }
+        #endif
+        xWait = SD_capture_wait(xWait);
+        (void)ulTaskNotifyTake(pdTRUE, xWait);
+
+        SD_capture_service();
+        if (BLogMountPending)
+        {
+            BLogMountPending = FALSE;
+            if (!SD_log_start_file())
+            {
+                continue;
+            }
+            qwtLastSync = (qword)esp_timer_get_time();
+        }
+        if (BLogClosing && BLogOpen)
+        {
+            SD_log_close_file();
+            (void)xTaskNotifyGive(xSDLogCloser);
+            continue;
+        }
+        if (NLogFile < 0)
+        {
+            continue;
+        }
+
+        /* No more than there are blocks, a flat out producer would never let a sync in */
+        for (byNBlocks = 0; byNBlocks < SD_LOG_BLOCKS && SD_log_write_block(); byNBlocks++)
+        {
+        }
+
+        qwtNow = (qword)esp_timer_get_time();
+        #if SD_LOG_SYNC_MS > 0
+        if (qwtNow - qwtLastSync >= (qword)SD_LOG_SYNC_MS * 1000)
+        {
+            /* Close off the block being filled, unless the card is behind and it is waiting */
+            portENTER_CRITICAL(&stSDLogLock);
+            (void)SD_log_seal();
+            portEXIT_CRITICAL(&stSDLogLock);
+
+            for (byNBlocks = 0; byNBlocks < SD_LOG_BLOCKS && SD_log_write_block(); byNBlocks++)
+            {
+            }
+            SD_log_sync();
+            qwtLastSync = (qword)esp_timer_get_time();
+        }
+        #endif
 
-   return eStatus;
+        if (qwtNow - qwtLastReport >= (qword)SD_LOG_REPORT_MS * 1000)
+        {
+            qwtLastReport = qwtNow;
+            SD_log_report();
+        }
+    }
 }
 
-esp_err_t sdcard_empty_buffer(void)
+static boolean SD_log_start_file(void)
 {
     /*
     *===========================================================================
-    *   sdcard_empty_buffer
+    *   SD_log_start_file
     *   Takes:   None
-    * 
-    *   Returns: eStatus - ESP_OK if successful, error code if not.
-    * 
-    *   Empties the CAN ring buffer dumping the contents into the sdcard. If there 
-    *   is no data to append, it returns ESP_OK. The ring buffer is
-    *   115 frames in total.
-    * 
-    *=========================================================================== 
+    *
+    *   Returns: TRUE if the file is open and logging carries on.
+    *
+    *   Mounts the card, names and opens the log file for SD_card_init. If
+    *   any of it fails the producers are stopped and the frames they had
+    *   taken are dropped.
+    *
+    *===========================================================================
     *   Revision History:
-    *   24/10/25 CP Initial Version
-    *   25/11/25 CP Changed to use FreeRTOS queue
-    *   26/11/25 CP Switch to asc format
-    *   27/11/25 CP Switch to binary format
+    *   18/10/26 CP Initial Version
     *
     *===========================================================================
     */
+    esp_err_t eStatus = SD_log_mount();
 
-    CAN_frame_t stCANFrame; 
-    BinLogEntry_t stLogEntry;
-    word wNWrites = 0;
+    if (eStatus == ESP_OK)
+    {
+        portENTER_CRITICAL(&stSDLogLock);
+        stLogStats.qwtMountedus = (qword)esp_timer_get_time();
+        portEXIT_CRITICAL(&stSDLogLock);
+        SD_log_name_file();
+        eStatus = SD_log_open_file();
+    }
+    if (eStatus == ESP_OK)
+    {
+        ESP_LOGI("SDCARD", "Logging to %s", abyFilePath);
+        return TRUE;
+    }
 
-    if (!xCANRingBuffer) 
+    ESP_LOGE("SDCARD", "Logging stopped: %s", esp_err_to_name(eStatus));
+    portENTER_CRITICAL(&stSDLogLock);
+    BLogOpen = FALSE;
+    memset(awLogBlockLength, 0, sizeof(awLogBlockLength));
+    memset(awLogBlockNFrames, 0, sizeof(awLogBlockNFrames));
+    portEXIT_CRITICAL(&stSDLogLock);
+    if (BLogClosing)
     {
-        return ESP_ERR_INVALID_STATE;
+        /* Nothing to close, let SD_card_close go */
+        (void)xTaskNotifyGive(xSDLogCloser);
     }
-   
-    if (uxQueueMessagesWaiting(xCANRingBuffer) == 0)
+    return FALSE;
+}
+
+static boolean SD_log_write_block(void)
+{
+    /*
+    *===========================================================================
+    *   SD_log_write_block
+    *   Takes:   None
+    *
+    *   Returns: TRUE if a block was written, FALSE if none were waiting.
+    *
+    *   Writes the oldest waiting block, indexes it if it holds frames, then
+    *   hands it back to the producers. Rolls on to the next file first if
+    *   the block might not fit with the index and footer after it.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Fills in the v2 block header and CRC
+    *   18/10/26 CP Header and write moved to SD_log_write, frame blocks indexed
+    *   18/10/26 CP Rolls on to the next file
+    *   18/10/26 CP Reports the first frames on the card
+    *
+    *===========================================================================
+    */
+    word wLength;
+    dword dwSector;
+
+    portENTER_CRITICAL(&stSDLogLock);
+    wLength = awLogBlockLength[byLogWriteBlock];
+    portEXIT_CRITICAL(&stSDLogLock);
+    if (wLength == 0 || NLogFile < 0)
     {
-        return ESP_OK;
+        return FALSE;
     }
 
-    if (stFile == NULL)
+    #if SD_LOG_FILE_KB > 0
+    /* Room for this block, an index block it fills and the last index block and footer */
+    if (qwLogFileOffset + SD_LOG_BLOCK_SIZE + 2 * SD_LOG_INDEX_BLOCK_SIZE + SD_SECTOR_SIZE > SD_LOG_FILE_SIZE)
     {
-        return ESP_FAIL;
+        SD_log_roll();
+        if (NLogFile < 0)
+        {
+            /* Left waiting, the producers drop frames rather than overwrite it */
+            return FALSE;
+        }
     }
+    #endif
 
-    /* Until the ring buffer is empty, write lines to file */ 
-    while (xQueueReceive(xCANRingBuffer, &stCANFrame, 0) == pdTRUE
-           && wNWrites < MAX_WRITES_PER_CALL)
+    /* The producers have moved on so the block is the writer's until it is handed back */
+    dwSector = SD_log_write(aabyLogBlock[byLogWriteBlock], abyLogBlockType[byLogWriteBlock], wLength,
+                            awLogBlockNFrames[byLogWriteBlock], aqwtLogBlockBase[byLogWriteBlock]);
+    if (dwSector != SD_LOG_NO_SECTOR && abyLogBlockType[byLogWriteBlock] == eSD_BLOCK_FRAMES)
     {
-        wNWrites++;
-        stLogEntry.type = CAN;
-        stLogEntry.dwTimestamp = dwTimeSincePowerUpms;
-        stLogEntry.dwID = stCANFrame.dwID;
-        stLogEntry.byDLC = stCANFrame.byDLC;
-        memcpy(stLogEntry.abData, stCANFrame.abData, 8);
-        fwrite(&stLogEntry, sizeof(BinLogEntry_t), 1, stFile);
+        SD_log_index_add(dwSector, aqwtLogBlockBase[byLogWriteBlock], aqwtLogBlockLast[byLogWriteBlock],
+                         aabyLogBlockBloom[byLogWriteBlock]);
+        dwLogFileNFrames += awLogBlockNFrames[byLogWriteBlock];
+        qwtLogFileLastFrame = aqwtLogBlockLast[byLogWriteBlock];
+        if (stLogStats.qwtFirstWrittenus == 0)
+        {
+            SD_log_first_written();
+        }
     }
-    return ESP_OK;
-}
\ No newline at end of file
+
+    portENTER_CRITICAL(&stSDLogLock);
+    memset(aabyLogBlockBloom[byLogWriteBlock], 0, SD_LOG_BLOOM_SIZE);
+    awLogBlockNFrames[byLogWriteBlock] = 0;
+    awLogBlockLength[byLogWriteBlock] = 0;
+    portEXIT_CRITICAL(&stSDLogLock);
+    byLogWriteBlock = (byte)((byLogWriteBlock + 1) % SD_LOG_BLOCKS);
+    return TRUE;
+}
+
+static dword SD_log_write(byte *abyBlock, byte byType, word wLength, word wNFrames, qword qwtBaseus)
+{
+    /*
+    *===========================================================================
+    *   SD_log_write
+    *   Takes:   abyBlock: Block with its records after room for the header,
+    *                      padded in place so it must have room to the sector
+    *            byType: eSDLogBlock_t
+    *            wLength: Header and records
+    *            wNFrames: Frames in the records
+    *            qwtBaseus: Header's base time
+    *
+    *   Returns: Sector the block starts at, SD_LOG_NO_SECTOR if it failed.
+    *
+    *   Fills in the block header and CRC and writes the block, padded out to
+    *   a whole sector so the file stays sector aligned.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version, split from SD_log_write_block
+    *   18/10/26 CP CRC starts from the file ID
+    *   18/10/26 CP Header filled in by SD_log_fill_header
+    *   18/10/26 CP Frame blocks compressed by SD_log_pack
+    *   18/10/26 CP Short write goes back to the last good block
+    *
+    *===========================================================================
+    */
+    dword dwSector = (dword)(qwLogFileOffset / SD_SECTOR_SIZE);
+    word wPaddedLength;
+    qword qwtStart;
+    dword dwWriteus;
+    ssize_t NWritten;
+    off_t NOffset;
+
+    abyBlock = SD_log_pack(abyBlock, &byType, &wLength);
+    wPaddedLength = SD_log_fill_header(abyBlock, byType, wLength, wNFrames, qwtBaseus,
+                                       dwLogBlockSequence++, stLogFileHeader.dwFileID);
+    qwtStart = (qword)esp_timer_get_time();
+    NWritten = write(NLogFile, abyBlock, wPaddedLength);
+    dwWriteus = (dword)((qword)esp_timer_get_time() - qwtStart);
+
+    portENTER_CRITICAL(&stSDLogLock);
+    stLogStats.dwNWrites++;
+    if (NWritten == (ssize_t)wPaddedLength)
+    {
+        stLogStats.qwNBytesWritten += wPaddedLength;
+    }
+    else
+    {
+        stLogStats.dwNWriteErrors++;
+    }
+    if (dwWriteus > stLogStats.dwWriteMaxus)
+    {
+        stLogStats.dwWriteMaxus = dwWriteus;
+    }
+    SD_log_histogram_add(stLogStats.adwNWriteus, dwWriteus);
+    portEXIT_CRITICAL(&stSDLogLock);
+
+    if (NWritten != (ssize_t)wPaddedLength)
+    {
+        ESP_LOGE("SDCARD", "Failed to write %u bytes to %s", (unsigned)wPaddedLength, abyFilePath);
+        /* Part of it may have gone. The file is pre-allocated, so go back to the end of the last good
+           block and write over it, its end would be the end of the whole file */
+        NOffset = lseek(NLogFile, (off_t)qwLogFileOffset, SEEK_SET);
+        if (NOffset != (off_t)qwLogFileOffset)
+        {
+            ESP_LOGE("SDCARD", "Failed to seek back in %s", abyFilePath);
+        }
+        return SD_LOG_NO_SECTOR;
+    }
+    qwLogFileOffset += wPaddedLength;
+    return dwSector;
+}
+
+static word SD_log_fill_header(byte *abyBlock, byte byType, word wLength, word wNFrames, qword qwtBaseus,
+                               dword dwSequence, dword dwCRCSeed)
+{
+    /*
+    *===========================================================================
+    *   SD_log_fill_header
+    *   Takes:   abyBlock: Block with its records after room for the header,
+    *                      padded in place so it must have room to the sector
+    *            byType: eSDLogBlock_t
+    *            wLength: Header and records
+    *            wNFrames: Frames in the records
+    *            qwtBaseus: Header's base time
+    *            dwSequence: Blocks before this one in the file
+    *            dwCRCSeed: The file ID, 0 for the file block
+    *
+    *   Returns: Bytes to write, wLength out to a whole sector.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version, split from SD_log_write
+    *
+    *===========================================================================
+    */
+    stSDLogBlockHeader_t stHeader = {0};
+    word wPaddedLength = (word)((wLength + SD_SECTOR_SIZE - 1) & ~(SD_SECTOR_SIZE - 1));
+
+    stHeader.dwMagic = SD_LOG_BLOCK_MAGIC;
+    stHeader.byType = byType;
+    stHeader.wLength = (word)(wLength - sizeof(stSDLogBlockHeader_t));
+    stHeader.wNFrames = wNFrames;
+    stHeader.dwSequence = dwSequence;
+    stHeader.qwtBaseus = qwtBaseus;
+    stHeader.dwCRC = esp_rom_crc32_le(dwCRCSeed, (const byte *)&stHeader, offsetof(stSDLogBlockHeader_t, dwCRC));
+    stHeader.dwCRC = esp_rom_crc32_le(stHeader.dwCRC, &abyBlock[sizeof(stSDLogBlockHeader_t)], stHeader.wLength);
+    memcpy(abyBlock, &stHeader, sizeof(stHeader));
+    memset(&abyBlock[wLength], 0, wPaddedLength - wLength);
+    return wPaddedLength;
+}
+
+static byte *SD_log_pack(byte *abyBlock, byte *pbyType, word *pwLength)
+{
+    /*
+    *===========================================================================
+    *   SD_log_pack
+    *   Takes:   abyBlock: Block with its records after room for the header
+    *            pbyType: eSDLogBlock_t, eSD_BLOCK_FRAMES_LZ if compressed
+    *            pwLength: Header and records, the compressed length if so
+    *
+    *   Returns: The block to write, abyBlock or the compressed copy.
+    *
+    *   Compresses a frame block's records if SD_LOG_COMPRESS and it saves
+    *   a sector, and counts the bytes and cycles it took. Any other block
+    *   is left as it is. Writer task only, the compressed copy is shared.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    #if SD_LOG_COMPRESS
+    const word wHeaderSize = sizeof(stSDLogBlockHeader_t) + SD_LOG_RAW_LENGTH_SIZE;
+    word wRecords = (word)(*pwLength - sizeof(stSDLogBlockHeader_t));
+    word wPaddedLength = (word)((*pwLength + SD_SECTOR_SIZE - 1) & ~(SD_SECTOR_SIZE - 1));
+    word wPacked = 0;
+    uint32_t dwtStart;
+    uint32_t dwCycles;
+
+    if (*pbyType != eSD_BLOCK_FRAMES || wPaddedLength < wHeaderSize + 2 * SD_SECTOR_SIZE)
+    {
+        return abyBlock;
+    }
+
+    /* Only room for it to come out a sector shorter */
+    dwtStart = esp_cpu_get_cycle_count();
+    wPacked = SD_compress_block(&abyBlock[sizeof(stSDLogBlockHeader_t)], wRecords, &abyLogPackedBlock[wHeaderSize],
+                                (word)(wPaddedLength - SD_SECTOR_SIZE - wHeaderSize));
+    dwCycles = esp_cpu_get_cycle_count() - dwtStart;
+
+    portENTER_CRITICAL(&stSDLogLock);
+    stLogStats.qwNRawBytes += wRecords;
+    stLogStats.qwNPackedBytes += wPacked > 0 ? wPacked + SD_LOG_RAW_LENGTH_SIZE : wRecords;
+    stLogStats.qwNCompressCycles += dwCycles;
+    portEXIT_CRITICAL(&stSDLogLock);
+    if (wPacked == 0)
+    {
+        return abyBlock;
+    }
+
+    abyLogPackedBlock[sizeof(stSDLogBlockHeader_t) + 0] = (byte)(wRecords & 0xFF);
+    abyLogPackedBlock[sizeof(stSDLogBlockHeader_t) + 1] = (byte)(wRecords >> 8);
+    *pbyType = eSD_BLOCK_FRAMES_LZ;
+    *pwLength = (word)(wHeaderSize + wPacked);
+    return abyLogPackedBlock;
+    #else
+    (void)pbyType;
+    (void)pwLength;
+    return abyBlock;
+    #endif
+}
+
+static void SD_log_index_add(dword dwSector, qword qwtBaseus, qword qwtLastus, const byte *abyBloom)
+{
+    /*
+    *===========================================================================
+    *   SD_log_index_add
+    *   Takes:   dwSector: Where the frame block was written
+    *            qwtBaseus: Its first frame's time
+    *            qwtLastus: Its last frame's time
+    *            abyBloom: SD_LOG_BLOOM_SIZE byte filter of its IDs
+    *
+    *   Returns: None
+    *
+    *   Adds the block to the index block being built and writes that once
+    *   it has SD_LOG_INDEX_ENTRIES.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    stSDLogIndexEntry_t *pstEntry = &pstLogIndex->astEntries[pstLogIndex->wNEntries];
+    qword qwSpanus = qwtLastus > qwtBaseus ? qwtLastus - qwtBaseus : 0;
+
+    if (dwLogNBlocks == 0)
+    {
+        qwtLogFirstFrame = qwtBaseus;
+    }
+    dwLogNBlocks++;
+
+    pstEntry->dwSector = dwSector;
+    pstEntry->dwSpanus = qwSpanus > 0xFFFFFFFF ? 0xFFFFFFFF : (dword)qwSpanus;
+    pstEntry->qwtBaseus = qwtBaseus;
+    memcpy(pstEntry->abyIDBloom, abyBloom, SD_LOG_BLOOM_SIZE);
+    pstLogIndex->wNEntries++;
+    if (pstLogIndex->wNEntries == SD_LOG_INDEX_ENTRIES)
+    {
+        SD_log_write_index();
+    }
+}
+
+static void SD_log_write_index(void)
+{
+    /*
+    *===========================================================================
+    *   SD_log_write_index
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Writes the index block being built and starts the next, which points
+    *   back at it. If the write fails the next points at the one before.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    word wLength = (word)(sizeof(stSDLogBlockHeader_t) + offsetof(stSDLogIndex_t, astEntries) +
+                          pstLogIndex->wNEntries * sizeof(stSDLogIndexEntry_t));
+    dword dwSector = SD_log_write(abyLogIndexBlock, eSD_BLOCK_INDEX, wLength, 0,
+                                  pstLogIndex->astEntries[0].qwtBaseus);
+
+    if (dwSector != SD_LOG_NO_SECTOR)
+    {
+        pstLogIndex->dwPreviousSector = dwSector;
+    }
+    pstLogIndex->wNEntries = 0;
+}
+
+static esp_err_t SD_log_mount(void)
+{
+    /*
+    *===========================================================================
+    *   SD_log_mount
+    *   Takes:   None
+    *
+    *   Returns: ESP_OK if successful, error code if not.
+    *
+    *   Initializes the SD card interface and mounts the card, unless a file
+    *   before this one already did.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   20/10/25 CP Initial Version as part of SD_card_init
+    *   18/10/26 CP Full SPI clock
+    *   18/10/26 CP Split from SD_card_init, run by the writer task
+    *
+    *===========================================================================
+    */
+    esp_err_t eStatus = ESP_OK;
+    esp_vfs_fat_sdmmc_mount_config_t stSDMountConfig =
+    {
+        .format_if_mount_failed = true,
+        .max_files = MAX_FILES,
+        .allocation_unit_size = ALLOCATION_UNIT_SIZE
+    };
+    sdmmc_card_t *stSDCard;
+    sdmmc_host_t stSDCardHost = SDSPI_HOST_DEFAULT();
+    stSDCardHost.max_freq_khz = SDMMC_FREQ;
+    sdspi_device_config_t stSDCardSlot = SDSPI_DEVICE_CONFIG_DEFAULT();
+    stSDCardSlot.gpio_cs = SPI_SD_CS;
+    stSDCardSlot.host_id = stSDCardHost.slot;
+
+    if (BSDMounted)
+    {
+        /* Still mounted from the last file */
+        return ESP_OK;
+    }
+
+    ESP_LOGI("SDCARD", "Initializing SD card...");
+    if (eStatus != ESP_OK)
+    {
+        ESP_LOGE("SDCARD", "Failed to initialize SPI bus: %s", esp_err_to_name(eStatus));
+        return eStatus;
+    }
+
+    ESP_LOGI("SDCARD", "Mounting filesystem...");
+    eStatus = esp_vfs_fat_sdspi_mount(SD_MOUNT_POINT, &stSDCardHost, &stSDCardSlot, &stSDMountConfig, &stSDCard);
+    if (eStatus != ESP_OK)
+    {
+        if (eStatus == ESP_FAIL)
+        {
+            ESP_LOGE("SDCARD", "Failed to mount filesystem. Formatting...");
+            eStatus = esp_vfs_fat_sdcard_format(SD_MOUNT_POINT, stSDCard);
+            if (eStatus != ESP_OK)
+            {
+                ESP_LOGE("SDCARD", "Failed to format: %s", esp_err_to_name(eStatus));
+                return eStatus;
+            }
+        }
+        else
+        {
+            ESP_LOGE("SDCARD", "Failed to mount filesystem: %s", esp_err_to_name(eStatus));
+            return eStatus;
+        }
+    }
+    ESP_LOGI("SDCARD", "Mounted successfully.");
+    /* Print Card Details */
+    sdmmc_card_print_info(stdout, stSDCard);
+    BSDMounted = TRUE;
+    return eStatus;
+}
+
+static void SD_log_name_file(void)
+{
+    /*
+    *===========================================================================
+    *   SD_log_name_file
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Sets dwLogFileNumber to the next log number saved in NVS. Falls back
+    *   on scanning the card if there is none or that file already exists.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version, replaces counting directory entries
+    *
+    *===========================================================================
+    */
+    nvs_handle_t stNVSHandle;
+    uint32_t dwNext = 0;
+    boolean BFound = FALSE;
+    struct stat stInfo;
+
+    if (NVS_init() == ESP_OK && nvs_open(SD_LOG_NVS_NAMESPACE, NVS_READONLY, &stNVSHandle) == ESP_OK)
+    {
+        BFound = nvs_get_u32(stNVSHandle, SD_LOG_NVS_KEY, &dwNext) == ESP_OK;
+        nvs_close(stNVSHandle);
+    }
+    dwLogFileNumber = dwNext > SD_LOG_MAX_NUMBER ? 0 : dwNext;
+    snprintf(abyFilePath, sizeof(abyFilePath), SD_LOG_NAME_FORMAT, SD_MOUNT_POINT, dwLogFileNumber);
+    if (!BFound || stat(abyFilePath, &stInfo) == 0)
+    {
+        dwLogFileNumber = SD_log_scan_numbers("log");
+        ESP_LOGW("SDCARD", "Log number %s in NVS, %lu from scanning the card",
+                 BFound ? "already used" : "not", dwLogFileNumber);
+    }
+}
+
+static dword SD_log_scan_numbers(const char *sPrefix)
+{
+    /*
+    *===========================================================================
+    *   SD_log_scan_numbers
+    *   Takes:   sPrefix: "log" or "cap", the three letters before the number
+    *
+    *   Returns: One more than the highest numbered file on the card, 0 if it
+    *            has none or that is past SD_LOG_MAX_NUMBER.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Takes the prefix, capture files are numbered too
+    *
+    *===========================================================================
+    */
+    DIR *stDirectory = opendir(SD_MOUNT_POINT);
+    struct dirent *stDirInfo;
+    dword dwNext = 0;
+    dword dwNumber;
+
+    if (stDirectory == NULL)
+    {
+        ESP_LOGE("SDCARD", "Failed to open directory");
+        return 0;
+    }
+    for (stDirInfo = readdir(stDirectory); stDirInfo != NULL; stDirInfo = readdir(stDirectory))
+    {
+        /* FATFS gives 8.3 names in upper case */
+        if (strncasecmp(stDirInfo->d_name, sPrefix, 3) == 0 && sscanf(&stDirInfo->d_name[3], "%lu", &dwNumber) == 1 &&
+            dwNumber >= dwNext)
+        {
+            dwNext = dwNumber + 1;
+        }
+    }
+    closedir(stDirectory);
+    return dwNext > SD_LOG_MAX_NUMBER ? 0 : dwNext;
+}
+
+static void SD_log_save_number(dword dwNext)
+{
+    /*
+    *===========================================================================
+    *   SD_log_save_number
+    *   Takes:   dwNext: Log number for the next file
+    *
+    *   Returns: None
+    *
+    *   Saves the next log number in NVS, once per file so the wear is
+    *   nothing.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    nvs_handle_t stNVSHandle;
+    esp_err_t eStatus = nvs_open(SD_LOG_NVS_NAMESPACE, NVS_READWRITE, &stNVSHandle);
+
+    if (eStatus == ESP_OK)
+    {
+        eStatus = nvs_set_u32(stNVSHandle, SD_LOG_NVS_KEY, (uint32_t)(dwNext > SD_LOG_MAX_NUMBER ? 0 : dwNext));
+        if (eStatus == ESP_OK)
+        {
+            eStatus = nvs_commit(stNVSHandle);
+        }
+        nvs_close(stNVSHandle);
+    }
+    if (eStatus != ESP_OK)
+    {
+        ESP_LOGW("SDCARD", "Failed to save the next log number: %s", esp_err_to_name(eStatus));
+    }
+}
+
+static esp_err_t SD_log_open_file(void)
+{
+    /*
+    *===========================================================================
+    *   SD_log_open_file
+    *   Takes:   None, dwLogFileNumber is the file to open
+    *
+    *   Returns: ESP_OK if successful, error code if not.
+    *
+    *   Creates the log file SD_LOG_FILE_KB long in one contiguous run of
+    *   clusters, writes its header sector and starts its index. Called by
+    *   SD_card_init and by the writer task when it rolls.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version, split from SD_card_init
+    *   18/10/26 CP Next log number saved in NVS
+    *
+    *===========================================================================
+    */
+    esp_err_t eStatus = ESP_OK;
+    qword qwtStart = (qword)esp_timer_get_time();
+
+    snprintf(abyFilePath, sizeof(abyFilePath), SD_LOG_NAME_FORMAT, SD_MOUNT_POINT, dwLogFileNumber);
+
+    #if SD_LOG_FILE_KB > 0
+    /* Every cluster is in the FAT from here on, writing the file only fills them in */
+    eStatus = esp_vfs_fat_create_contiguous_file(SD_MOUNT_POINT, abyFilePath, SD_LOG_FILE_SIZE, true);
+    if (eStatus != ESP_OK)
+    {
+        ESP_LOGE("SDCARD", "Failed to allocate %s: %s", abyFilePath, esp_err_to_name(eStatus));
+        return eStatus;
+    }
+    #endif
+
+    /* Plain file descriptor, the blocks go to FATFS whole with no stdio copy */
+    NLogFile = open(abyFilePath, O_WRONLY | O_CREAT, 0666);
+    if (NLogFile < 0)
+    {
+        ESP_LOGE("SDCARD", "Failed to open %s", abyFilePath);
+        return ESP_FAIL;
+    }
+
+    pstLogIndex->dwPreviousSector = SD_LOG_NO_SECTOR;
+    pstLogIndex->wNEntries = 0;
+    dwLogNBlocks = 0;
+    dwLogFileNFrames = 0;
+    portENTER_CRITICAL(&stSDLogLock);
+    dwLogFileStartDropped = stLogStats.dwNDropped;
+    portEXIT_CRITICAL(&stSDLogLock);
+
+    memset(&stLogFileHeader, 0, sizeof(stLogFileHeader));
+    stLogFileHeader.byVersion = SD_LOG_FILE_VERSION;
+    stLogFileHeader.wSectorSize = SD_SECTOR_SIZE;
+    stLogFileHeader.wBlockSize = SD_LOG_BLOCK_SIZE;
+    stLogFileHeader.wDeviceID = DEVICE_ID;
+    stLogFileHeader.qwtOpenus = qwtStart;
+    if (eternal_clock_read_time(stLogFileHeader.abyClock) != ESP_OK)
+    {
+        memset(stLogFileHeader.abyClock, 0, sizeof(stLogFileHeader.abyClock));
+    }
+    stLogFileHeader.dwFileID = esp_random();
+    stLogFileHeader.qwFileBytes = SD_LOG_FILE_SIZE;
+    qwtLogFileLastFrame = qwtStart;
+
+    /* The header has the first sector to itself so it can be rewritten in place */
+    qwLogFileOffset = SD_SECTOR_SIZE;
+    dwLogBlockSequence = 1;
+    if (!SD_log_mark_valid() || lseek(NLogFile, SD_SECTOR_SIZE, SEEK_SET) != SD_SECTOR_SIZE)
+    {
+        ESP_LOGE("SDCARD", "Failed to write the header of %s", abyFilePath);
+        close(NLogFile);
+        NLogFile = -1;
+        return ESP_FAIL;
+    }
+
+    SD_log_save_number(dwLogFileNumber + 1);
+    portENTER_CRITICAL(&stSDLogLock);
+    stLogStats.dwNFiles++;
+    portEXIT_CRITICAL(&stSDLogLock);
+    ESP_LOGI("SDCARD", "Opened %s in %lu us", abyFilePath, (dword)((qword)esp_timer_get_time() - qwtStart));
+    return eStatus;
+}
+
+static boolean SD_log_mark_valid(void)
+{
+    /*
+    *===========================================================================
+    *   SD_log_mark_valid
+    *   Takes:   None
+    *
+    *   Returns: TRUE if the header sector was written.
+    *
+    *   Rewrites the file header block in the first sector with qwValidBytes
+    *   set to where the writer has got to. Leaves the file position alone.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Header filled in by SD_log_fill_header
+    *
+    *===========================================================================
+    */
+    stLogFileHeader.qwValidBytes = qwLogFileOffset;
+    memcpy(&abyLogFileSector[sizeof(stSDLogBlockHeader_t)], &stLogFileHeader, sizeof(stLogFileHeader));
+    /* Always from 0, the reader needs this block to learn the file ID */
+    (void)SD_log_fill_header(abyLogFileSector, eSD_BLOCK_FILE, sizeof(stSDLogBlockHeader_t) + sizeof(stLogFileHeader),
+                             0, stLogFileHeader.qwtOpenus, 0, 0);
+    return pwrite(NLogFile, abyLogFileSector, SD_SECTOR_SIZE, 0) == SD_SECTOR_SIZE;
+}
+
+#if SD_LOG_FILE_KB > 0
+static void SD_log_roll(void)
+{
+    /*
+    *===========================================================================
+    *   SD_log_roll
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Finishes the file and opens the next one without stopping the
+    *   producers, the RAM blocks carry the frames across. Leaves NLogFile at
+    *   -1 if the next one could not be opened.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    qword qwtStart = (qword)esp_timer_get_time();
+    dword dwRollus;
+
+    SD_log_finish_file();
+    dwLogFileNumber = dwLogFileNumber >= SD_LOG_MAX_NUMBER ? 0 : dwLogFileNumber + 1;
+    if (SD_log_open_file() != ESP_OK)
+    {
+        ESP_LOGE("SDCARD", "Failed to roll on to %s, logging stopped", abyFilePath);
+        return;
+    }
+
+    dwRollus = (dword)((qword)esp_timer_get_time() - qwtStart);
+    portENTER_CRITICAL(&stSDLogLock);
+    if (dwRollus > stLogStats.dwRollMaxus)
+    {
+        stLogStats.dwRollMaxus = dwRollus;
+    }
+    portEXIT_CRITICAL(&stSDLogLock);
+}
+#endif
+
+static void SD_log_finish_file(void)
+{
+    /*
+    *===========================================================================
+    *   SD_log_finish_file
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Writes the last index block and a footer in the file's last sector,
+    *   gives back the pre-allocated clusters past it, then syncs and closes.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version, split from SD_log_close_file
+    *
+    *===========================================================================
+    */
+    stSDLogFooter_t stFooter = {0};
+
+    if (pstLogIndex->wNEntries != 0)
+    {
+        SD_log_write_index();
+    }
+
+    stFooter.dwIndexSector = pstLogIndex->dwPreviousSector;
+    stFooter.dwNBlocks = dwLogNBlocks;
+    stFooter.dwNFrames = dwLogFileNFrames;
+    portENTER_CRITICAL(&stSDLogLock);
+    stFooter.dwNDropped = stLogStats.dwNDropped - dwLogFileStartDropped;
+    portEXIT_CRITICAL(&stSDLogLock);
+    stFooter.qwtFirstus = qwtLogFirstFrame;
+    stFooter.qwtLastus = qwtLogFileLastFrame;
+    memcpy(&abyLogIndexBlock[sizeof(stSDLogBlockHeader_t)], &stFooter, sizeof(stFooter));
+    (void)SD_log_write(abyLogIndexBlock, eSD_BLOCK_FOOTER, sizeof(stSDLogBlockHeader_t) + sizeof(stFooter),
+                       0, qwtLogFileLastFrame);
+
+    #if SD_LOG_FILE_KB > 0
+    /* The footer must be the last sector, and the clusters after it are free for the next file */
+    if (ftruncate(NLogFile, (off_t)qwLogFileOffset) != 0)
+    {
+        ESP_LOGE("SDCARD", "Failed to trim %s", abyFilePath);
+    }
+    #endif
+
+    SD_log_sync();
+    close(NLogFile);
+    NLogFile = -1;
+}
+
+static void SD_log_close_file(void)
+{
+    /*
+    *===========================================================================
+    *   SD_log_close_file
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Stops the producers, writes every block still waiting and finishes
+    *   the file.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Index, footer and close moved to SD_log_finish_file
+    *
+    *===========================================================================
+    */
+    portENTER_CRITICAL(&stSDLogLock);
+    BLogOpen = FALSE;
+    (void)SD_log_seal();
+    portEXIT_CRITICAL(&stSDLogLock);
+
+    /* Nothing more is coming so there is no sync to let in */
+    while (SD_log_write_block())
+    {
+    }
+    if (NLogFile >= 0)
+    {
+        SD_log_finish_file();
+    }
+}
+
+static void SD_log_sync(void)
+{
+    /*
+    *===========================================================================
+    *   SD_log_sync
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Marks the file valid up to where the writer has got to, then has
+    *   FATFS write the file's size and FAT out to the card so everything
+    *   written so far survives a power cut.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Rewrites the file header's valid length first
+    *
+    *===========================================================================
+    */
+    qword qwtStart = (qword)esp_timer_get_time();
+    int NStatus = SD_log_mark_valid() ? 0 : -1;
+
+    if (NStatus == 0)
+    {
+        NStatus = fsync(NLogFile);
+    }
+    dword dwSyncus = (dword)((qword)esp_timer_get_time() - qwtStart);
+
+    portENTER_CRITICAL(&stSDLogLock);
+    stLogStats.dwNSyncs++;
+    if (NStatus != 0)
+    {
+        stLogStats.dwNWriteErrors++;
+    }
+    if (dwSyncus > stLogStats.dwSyncMaxus)
+    {
+        stLogStats.dwSyncMaxus = dwSyncus;
+    }
+    SD_log_histogram_add(stLogStats.adwNSyncus, dwSyncus);
+    portEXIT_CRITICAL(&stSDLogLock);
+
+    if (NStatus != 0)
+    {
+        ESP_LOGE("SDCARD", "Failed to sync %s", abyFilePath);
+    }
+}
+
+static void SD_log_first_written(void)
+{
+    /*
+    *===========================================================================
+    *   SD_log_first_written
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Notes the first frame block being on the card and logs how long after
+    *   power up the first frame was taken, the card mounted and the frame
+    *   written.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    qword qwtNow = (qword)esp_timer_get_time();
+    stSDLogStats_t stStats;
+
+    portENTER_CRITICAL(&stSDLogLock);
+    stLogStats.qwtFirstWrittenus = qwtNow;
+    stStats = stLogStats;
+    portEXIT_CRITICAL(&stSDLogLock);
+    ESP_LOGI("SDCARD", "From power up: first frame %lu ms, card mounted %lu ms, first frame on the card %lu ms",
+             (dword)(stStats.qwtFirstFrameus / 1000), (dword)(stStats.qwtMountedus / 1000), (dword)(qwtNow / 1000));
+}
+
+static void SD_log_histogram_add(dword *adwNHistogram, dword dwTimeus)
+{
+    /*
+    *===========================================================================
+    *   SD_log_histogram_add
+    *   Takes:   adwNHistogram: SD_LOG_HIST_BUCKETS counts
+    *            dwTimeus: Time to add
+    *
+    *   Returns: None
+    *
+    *   Counts the time in bucket floor(log2(dwTimeus)), the last bucket takes
+    *   everything longer.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    byte byBucket = 0;
+
+    while (dwTimeus > 1 && byBucket < SD_LOG_HIST_BUCKETS - 1)
+    {
+        dwTimeus >>= 1;
+        byBucket++;
+    }
+    adwNHistogram[byBucket]++;
+}
+
+static void SD_log_report(void)
+{
+    /*
+    *===========================================================================
+    *   SD_log_report
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Logs the totals and the write time histogram, one count per bucket
+    *   from 1 us up, and how well frame blocks compress.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Reports the compression ratio and cycles per KB
+    *
+    *===========================================================================
+    */
+    stSDLogStats_t stStats;
+    char acHistogram[SD_LOG_HIST_BUCKETS * 11 + 1];
+    word wLength = 0;
+    byte byBucket;
+
+    SD_log_get_stats(&stStats);
+    for (byBucket = 0; byBucket < SD_LOG_HIST_BUCKETS; byBucket++)
+    {
+        wLength += (word)snprintf(&acHistogram[wLength], sizeof(acHistogram) - wLength, " %lu",
+                                  stStats.adwNWriteus[byBucket]);
+    }
+    ESP_LOGI("SDCARD", "%lu frames, %lu dropped, %lu KB in %lu writes, max %lu us, %lu syncs, max %lu us, %lu errors",
+        stStats.dwNFrames, stStats.dwNDropped, (dword)(stStats.qwNBytesWritten / 1024), stStats.dwNWrites,
+        stStats.dwWriteMaxus, stStats.dwNSyncs, stStats.dwSyncMaxus, stStats.dwNWriteErrors);
+    ESP_LOGI("SDCARD", "Write us log2 histogram:%s", acHistogram);
+    if (stStats.qwNPackedBytes > 0)
+    {
+        ESP_LOGI("SDCARD", "Frame records %lu KB compressed to %lu KB, %lu.%02lu:1, %lu cycles/KB",
+            (dword)(stStats.qwNRawBytes / 1024), (dword)(stStats.qwNPackedBytes / 1024),
+            (dword)(stStats.qwNRawBytes / stStats.qwNPackedBytes),
+            (dword)(stStats.qwNRawBytes * 100 / stStats.qwNPackedBytes % 100),
+            (dword)(stStats.qwNCompressCycles * 1024 / stStats.qwNRawBytes));
+    }
+}
+
+esp_err_t SD_capture_init(void)
+{
+    /*
+    *===========================================================================
+    *   SD_capture_init
+    *   Takes:   None
+    *
+    *   Returns: ESP_OK if the ring is armed, ESP_ERR_INVALID_STATE if it
+    *            already was, ESP_ERR_NO_MEM if the heap could not spare
+    *            SD_CAPTURE_MIN_FRAMES or the writer task could not start.
+    *
+    *   Takes SD_CAPTURE_HEAP_PERCENT of the heap free over
+    *   SD_CAPTURE_HEAP_RESERVE_KB, up to SD_CAPTURE_MAX_KB, for the capture
+    *   ring and arms it. Call once the rest of the firmware has allocated
+    *   what it needs, SD_card_init is not needed.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    dword dwFree;
+    dword dwBytes;
+    dword dwLargest;
+    word wTimeout;
+
+    if (astCaptureRing != NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    /* The file is written from here so the ring itself need not be DMA capable */
+    abyCaptureBlock = heap_caps_malloc(SD_LOG_BLOCK_SIZE + SD_LOG_INDEX_BLOCK_SIZE, MALLOC_CAP_DMA);
+    if (abyCaptureBlock == NULL)
+    {
+        ESP_LOGE("SDCARD", "No room for the capture write buffer");
+        return ESP_ERR_NO_MEM;
+    }
+
+    dwFree = (dword)heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    dwBytes = dwFree > SD_CAPTURE_HEAP_RESERVE_KB * 1024 ?
+              (dwFree - SD_CAPTURE_HEAP_RESERVE_KB * 1024) / 100 * SD_CAPTURE_HEAP_PERCENT : 0;
+    dwLargest = (dword)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    dwBytes = dwBytes > dwLargest ? dwLargest : dwBytes;
+    dwBytes = dwBytes > SD_CAPTURE_MAX_KB * 1024 ? SD_CAPTURE_MAX_KB * 1024 : dwBytes;
+    dwCaptureSize = dwBytes / sizeof(CAN_frame_t);
+    astCaptureRing = dwCaptureSize < SD_CAPTURE_MIN_FRAMES ? NULL :
+                     heap_caps_malloc(dwCaptureSize * sizeof(CAN_frame_t), MALLOC_CAP_8BIT);
+    if (astCaptureRing == NULL || SD_log_start_writer() != ESP_OK)
+    {
+        ESP_LOGE("SDCARD", "No room for a capture ring, %lu KB free", dwFree / 1024);
+        heap_caps_free(astCaptureRing);
+        heap_caps_free(abyCaptureBlock);
+        astCaptureRing = NULL;
+        abyCaptureBlock = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+
+    /* The flags start set until their frame first comes, only a set after a clear is a timeout */
+    for (wTimeout = 0; wTimeout < SD_CAPTURE_N_TIMEOUTS; wTimeout++)
+    {
+        aBCaptureLastTimeout[wTimeout] = *apBCaptureTimeouts[wTimeout];
+    }
+
+    dwCapturePreShare = (dword)((qword)dwCaptureSize * SD_CAPTURE_PRE_MS / (SD_CAPTURE_PRE_MS + SD_CAPTURE_POST_MS));
+    portENTER_CRITICAL(&stSDCaptureLock);
+    memset(&stCaptureStats, 0, sizeof(stCaptureStats));
+    stCaptureStats.dwRingFrames = dwCaptureSize;
+    stCaptureStats.dwRingBytes = dwCaptureSize * sizeof(CAN_frame_t) + SD_LOG_BLOCK_SIZE + SD_LOG_INDEX_BLOCK_SIZE;
+    stCaptureStats.dwHeapLeft = (dword)heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    dwCaptureHead = 0;
+    dwCaptureNFrames = 0;
+    eCaptureState = eSD_CAPTURE_ARMED;
+    portEXIT_CRITICAL(&stSDCaptureLock);
+
+    ESP_LOGI("SDCARD", "Capture ring of %lu frames in %lu KB, %lu ms of a full bus, %lu KB of heap left",
+             dwCaptureSize, stCaptureStats.dwRingBytes / 1024, dwCaptureSize * 1000 / SD_CAPTURE_BUS_FPS,
+             stCaptureStats.dwHeapLeft / 1024);
+    return ESP_OK;
+}
+
+esp_err_t SD_capture_CAN(const CAN_frame_t *stCANFrame, qword qwtRx)
+{
+    /*
+    *===========================================================================
+    *   SD_capture_CAN
+    *   Takes:   stCANFrame: Frame to keep
+    *            qwtRx: Rx time in us since power up
+    *
+    *   Returns: ESP_OK if kept, ESP_ERR_INVALID_STATE if there is no ring or
+    *            it is frozen, ESP_ERR_NO_MEM if this frame froze it.
+    *
+    *   Adds a frame to the capture ring over the oldest, and triggers it on
+    *   a kill frame that is not a repeat of the last. Once triggered the
+    *   oldest is only overwritten while it is from before the pre window or
+    *   the pre-trigger frames hold more than their share, and the first
+    *   frame past the post window freezes the ring. Only copies, safe from
+    *   an ISR or any task.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    esp_err_t eStatus = ESP_OK;
+    boolean BNotify = FALSE;
+    CAN_frame_t *pstSlot;
+
+    if (eCaptureState == eSD_CAPTURE_OFF)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    portENTER_CRITICAL_SAFE(&stSDCaptureLock);
+    if (stCANFrame->dwID == KILL_MSG_ID && stCANFrame->byDLC >= 3 &&
+        (byte)(stCANFrame->abData[0] + stCANFrame->abData[1]) == stCANFrame->abData[2])
+    {
+        /* The kill frame is the first after the trigger */
+        if (stCANFrame->abData[0] != KILL_NONE && byCaptureLastKill == KILL_NONE)
+        {
+            BNotify = SD_capture_latch(eSD_CAPTURE_KILL, stCANFrame->abData[1], qwtRx);
+        }
+        byCaptureLastKill = stCANFrame->abData[0];
+    }
+
+    if (eCaptureState == eSD_CAPTURE_POST && qwtRx >= qwtCaptureTrigger + (qword)SD_CAPTURE_POST_MS * 1000)
+    {
+        BNotify |= SD_capture_freeze(FALSE);
+    }
+
+    if (eCaptureState == eSD_CAPTURE_FROZEN)
+    {
+        eStatus = ESP_ERR_INVALID_STATE;
+    }
+    else if (dwCaptureNFrames == dwCaptureSize && eCaptureState == eSD_CAPTURE_POST &&
+             (dwCaptureNPre == 0 || (dwCaptureNPre <= dwCapturePreShare &&
+              SD_capture_time(&astCaptureRing[dwCaptureHead]) + (qword)SD_CAPTURE_PRE_MS * 1000 >= qwtCaptureTrigger)))
+    {
+        /* Only frames the capture wants are left to overwrite */
+        BNotify |= SD_capture_freeze(TRUE);
+        eStatus = ESP_ERR_NO_MEM;
+    }
+    else
+    {
+        if (dwCaptureNFrames < dwCaptureSize)
+        {
+            dwCaptureNFrames++;
+        }
+        else if (dwCaptureNPre > 0)
+        {
+            dwCaptureNPre--;
+        }
+        pstSlot = &astCaptureRing[dwCaptureHead];
+        *pstSlot = *stCANFrame;
+        CAN_set_rx_time(pstSlot, qwtRx);
+        dwCaptureHead = dwCaptureHead + 1 == dwCaptureSize ? 0 : dwCaptureHead + 1;
+        qwtCaptureNewest = qwtRx;
+    }
+    portEXIT_CRITICAL_SAFE(&stSDCaptureLock);
+
+    if (BNotify)
+    {
+        if (xPortInIsrContext())
+        {
+            vTaskNotifyGiveFromISR(xSDLogWriterTask, NULL);
+        }
+        else
+        {
+            (void)xTaskNotifyGive(xSDLogWriterTask);
+        }
+    }
+    return eStatus;
+}
+
+esp_err_t SD_capture_trigger(byte byCause, byte bySource)
+{
+    /*
+    *===========================================================================
+    *   SD_capture_trigger
+    *   Takes:   byCause: eSDCaptureCause_t
+    *            bySource: Kept in the trigger block, see stSDLogTrigger_t
+    *
+    *   Returns: ESP_OK if the capture was triggered, ESP_ERR_INVALID_STATE if
+    *            there is no ring or a capture is already under way.
+    *
+    *   Triggers the capture ring now. Safe from an ISR or any task.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    boolean BLatched;
+
+    if (eCaptureState == eSD_CAPTURE_OFF)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    portENTER_CRITICAL_SAFE(&stSDCaptureLock);
+    BLatched = SD_capture_latch(byCause, bySource, (qword)esp_timer_get_time());
+    portEXIT_CRITICAL_SAFE(&stSDCaptureLock);
+
+    if (!BLatched)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (xPortInIsrContext())
+    {
+        vTaskNotifyGiveFromISR(xSDLogWriterTask, NULL);
+    }
+    else
+    {
+        (void)xTaskNotifyGive(xSDLogWriterTask);
+    }
+    return ESP_OK;
+}
+
+void SD_capture_check_errors(void)
+{
+    /*
+    *===========================================================================
+    *   SD_capture_check_errors
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Triggers the capture ring on any of apBCaptureTimeouts being set since
+    *   the last call. Call from the 1 ms task after CANRxCheck1ms.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    boolean BInError;
+    word wTimeout;
+
+    if (eCaptureState == eSD_CAPTURE_OFF)
+    {
+        return;
+    }
+    for (wTimeout = 0; wTimeout < SD_CAPTURE_N_TIMEOUTS; wTimeout++)
+    {
+        BInError = *apBCaptureTimeouts[wTimeout];
+        if (BInError && !aBCaptureLastTimeout[wTimeout])
+        {
+            (void)SD_capture_trigger(eSD_CAPTURE_TIMEOUT, (byte)wTimeout);
+        }
+        aBCaptureLastTimeout[wTimeout] = BInError;
+    }
+}
+
+void SD_capture_get_stats(stSDCaptureStats_t *stStats)
+{
+    /*
+    *===========================================================================
+    *   SD_capture_get_stats
+    *   Takes:   stStats: Filled with a copy of the capture ring's counters
+    *
+    *   Returns: None
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    portENTER_CRITICAL_SAFE(&stSDCaptureLock);
+    *stStats = stCaptureStats;
+    portEXIT_CRITICAL_SAFE(&stSDCaptureLock);
+}
+
+static boolean SD_capture_latch(byte byCause, byte bySource, qword qwtEvent)
+{
+    /*
+    *===========================================================================
+    *   SD_capture_latch
+    *   Takes:   byCause: eSDCaptureCause_t
+    *            bySource: Kept in the trigger block
+    *            qwtEvent: When it happened, the trigger time
+    *            Call with stSDCaptureLock held
+    *
+    *   Returns: TRUE if the ring was armed and is now triggered, the writer
+    *            task must be woken to time the post window.
+    *
+    *   Holds every frame in the ring as a pre-trigger frame. The latch
+    *   latency is from the event to here.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    if (eCaptureState != eSD_CAPTURE_ARMED)
+    {
+        stCaptureStats.dwNIgnored++;
+        return FALSE;
+    }
+    eCaptureState = eSD_CAPTURE_POST;
+    qwtCaptureTrigger = qwtEvent;
+    dwCaptureNPre = dwCaptureNFrames;
+    stCaptureStats.dwNTriggers++;
+    stCaptureStats.byCause = byCause;
+    stCaptureStats.bySource = bySource;
+    stCaptureStats.BPostCut = FALSE;
+    stCaptureStats.dwLatchus = (dword)((qword)esp_timer_get_time() - qwtEvent);
+    return TRUE;
+}
+
+static boolean SD_capture_freeze(boolean BPostCut)
+{
+    /*
+    *===========================================================================
+    *   SD_capture_freeze
+    *   Takes:   BPostCut: TRUE if the ring filled before the post window was up
+    *            Call with stSDCaptureLock held
+    *
+    *   Returns: TRUE, the writer task must be woken to write the ring out.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    qwtCaptureFrozen = (qword)esp_timer_get_time();
+    qwtCaptureRetry = 0;
+    eCaptureState = eSD_CAPTURE_FROZEN;
+    stCaptureStats.BPostCut = BPostCut;
+    stCaptureStats.dwFrozenus = (dword)(qwtCaptureFrozen - qwtCaptureTrigger);
+    return TRUE;
+}
+
+static qword SD_capture_time(const CAN_frame_t *stFrame)
+{
+    /*
+    *===========================================================================
+    *   SD_capture_time
+    *   Takes:   stFrame: A frame in the capture ring
+    *
+    *   Returns: Its Rx time in us, from its low 24 bits and the newest frame's.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    return CAN_get_rx_time(stFrame, qwtCaptureNewest);
+}
+
+static TickType_t SD_capture_wait(TickType_t xWait)
+{
+    /*
+    *===========================================================================
+    *   SD_capture_wait
+    *   Takes:   xWait: Ticks the writer task would otherwise sleep for
+    *
+    *   Returns: Ticks to sleep, no longer than until the post window is up or
+    *            a frozen capture is due another try at the card.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    qword qwtNow = (qword)esp_timer_get_time();
+    qword qwtDue;
+    TickType_t xDue;
+
+    if (eCaptureState == eSD_CAPTURE_POST)
+    {
+        qwtDue = qwtCaptureTrigger + (qword)SD_CAPTURE_POST_MS * 1000;
+    }
+    else if (eCaptureState == eSD_CAPTURE_FROZEN)
+    {
+        qwtDue = qwtCaptureRetry;
+    }
+    else
+    {
+        return xWait;
+    }
+
+    xDue = qwtDue > qwtNow ? pdMS_TO_TICKS((qwtDue - qwtNow) / 1000 + 1) : 0;
+    return xDue < xWait ? xDue : xWait;
+}
+
+static void SD_capture_service(void)
+{
+    /*
+    *===========================================================================
+    *   SD_capture_service
+    *   Takes:   None
+    *
+    *   Returns: None
+    *
+    *   Freezes the ring once its post window is up with no frame since to do
+    *   it, then writes a frozen ring out and re-arms it. If the card will not
+    *   mount the ring stays frozen for SD_CAPTURE_RETRY_MS.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    qword qwtNow = (qword)esp_timer_get_time();
+
+    if (eCaptureState == eSD_CAPTURE_POST && qwtNow >= qwtCaptureTrigger + (qword)SD_CAPTURE_POST_MS * 1000)
+    {
+        portENTER_CRITICAL(&stSDCaptureLock);
+        if (eCaptureState == eSD_CAPTURE_POST)
+        {
+            (void)SD_capture_freeze(FALSE);
+        }
+        portEXIT_CRITICAL(&stSDCaptureLock);
+    }
+    if (eCaptureState != eSD_CAPTURE_FROZEN || qwtNow < qwtCaptureRetry)
+    {
+        return;
+    }
+
+    if (!SD_capture_write())
+    {
+        qwtCaptureRetry = (qword)esp_timer_get_time() + (qword)SD_CAPTURE_RETRY_MS * 1000;
+        return;
+    }
+
+    portENTER_CRITICAL(&stSDCaptureLock);
+    dwCaptureHead = 0;
+    dwCaptureNFrames = 0;
+    dwCaptureNPre = 0;
+    eCaptureState = eSD_CAPTURE_ARMED;
+    portEXIT_CRITICAL(&stSDCaptureLock);
+}
+
+static boolean SD_capture_write(void)
+{
+    /*
+    *===========================================================================
+    *   SD_capture_write
+    *   Takes:   None
+    *
+    *   Returns: FALSE if the card did not mount and the capture should be
+    *            tried again, TRUE once it is written or has failed for good.
+    *
+    *   Writes the frozen ring as the next capNNNNN.bin: the file block, the
+    *   trigger block, the frames from SD_CAPTURE_PRE_MS before the trigger
+    *   on in frame blocks, the index and the footer, in one pass, then
+    *   rewrites the file block with its length and syncs.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    stSDLogTrigger_t stTrigger = {0};
+    stSDCaptureStats_t stStats;
+    esp_err_t eStatus = SD_log_mount();
+    boolean BOk;
+    dword dwWriteus;
+
+    if (eStatus != ESP_OK)
+    {
+        ESP_LOGE("SDCARD", "Capture waiting for the card: %s", esp_err_to_name(eStatus));
+        return FALSE;
+    }
+
+    if (dwCaptureNumber > SD_LOG_MAX_NUMBER)
+    {
+        dwCaptureNumber = SD_log_scan_numbers("cap");
+    }
+    snprintf(abyCapturePath, sizeof(abyCapturePath), SD_CAPTURE_NAME_FORMAT, SD_MOUNT_POINT, dwCaptureNumber);
+    dwCaptureNumber = dwCaptureNumber >= SD_LOG_MAX_NUMBER ? 0 : dwCaptureNumber + 1;
+    NCaptureFile = open(abyCapturePath, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (NCaptureFile < 0)
+    {
+        ESP_LOGE("SDCARD", "Failed to open %s, capture lost", abyCapturePath);
+        portENTER_CRITICAL(&stSDCaptureLock);
+        stCaptureStats.dwNWriteErrors++;
+        portEXIT_CRITICAL(&stSDCaptureLock);
+        return TRUE;
+    }
+
+    memset(&stCaptureFileHeader, 0, sizeof(stCaptureFileHeader));
+    stCaptureFileHeader.byVersion = SD_LOG_FILE_VERSION;
+    stCaptureFileHeader.wSectorSize = SD_SECTOR_SIZE;
+    stCaptureFileHeader.wBlockSize = SD_LOG_BLOCK_SIZE;
+    stCaptureFileHeader.wDeviceID = DEVICE_ID;
+    stCaptureFileHeader.qwtOpenus = (qword)esp_timer_get_time();
+    if (eternal_clock_read_time(stCaptureFileHeader.abyClock) != ESP_OK)
+    {
+        memset(stCaptureFileHeader.abyClock, 0, sizeof(stCaptureFileHeader.abyClock));
+    }
+    stCaptureFileHeader.dwFileID = esp_random();
+    qwCaptureOffset = 0;
+    dwCaptureSequence = 0;
+
+    /* Valid for 0 bytes until the end, a reader takes the blocks in sequence */
+    BOk = SD_capture_put_file_block();
+    if (BOk)
+    {
+        stTrigger.byCause = stCaptureStats.byCause;
+        stTrigger.bySource = stCaptureStats.bySource;
+        stTrigger.dwPreus = (dword)SD_CAPTURE_PRE_MS * 1000;
+        stTrigger.dwPostus = (dword)SD_CAPTURE_POST_MS * 1000;
+        stTrigger.qwtTriggerus = qwtCaptureTrigger;
+        memcpy(&abyCaptureBlock[sizeof(stSDLogBlockHeader_t)], &stTrigger, sizeof(stTrigger));
+        BOk = SD_capture_put(abyCaptureBlock, eSD_BLOCK_TRIGGER, sizeof(stSDLogBlockHeader_t) + sizeof(stTrigger), 0,
+                             qwtCaptureTrigger) != SD_LOG_NO_SECTOR && SD_capture_write_frames();
+    }
+
+    /* Now the length is known */
+    stCaptureFileHeader.qwValidBytes = qwCaptureOffset;
+    BOk = BOk && SD_capture_put_file_block() && fsync(NCaptureFile) == 0;
+    close(NCaptureFile);
+    NCaptureFile = -1;
+    dwWriteus = (dword)((qword)esp_timer_get_time() - qwtCaptureFrozen);
+
+    portENTER_CRITICAL(&stSDCaptureLock);
+    if (BOk)
+    {
+        stCaptureStats.dwNFiles++;
+    }
+    else
+    {
+        stCaptureStats.dwNWriteErrors++;
+    }
+    stCaptureStats.dwWriteus = dwWriteus;
+    stStats = stCaptureStats;
+    portEXIT_CRITICAL(&stSDCaptureLock);
+
+    if (!BOk)
+    {
+        ESP_LOGE("SDCARD", "Failed to write %s, capture lost", abyCapturePath);
+        return TRUE;
+    }
+    ESP_LOGI("SDCARD", "Captured %s: cause %u source %u, %lu frames before and %lu after%s, latched in %lu us, "
+             "frozen %lu ms after, on the card %lu ms after that", abyCapturePath, stStats.byCause, stStats.bySource,
+             stStats.dwNPreFrames, stStats.dwNPostFrames, stStats.BPostCut ? " (ring full)" : "", stStats.dwLatchus,
+             stStats.dwFrozenus / 1000, dwWriteus / 1000);
+    return TRUE;
+}
+
+static boolean SD_capture_write_frames(void)
+{
+    /*
+    *===========================================================================
+    *   SD_capture_write_frames
+    *   Takes:   None
+    *
+    *   Returns: TRUE if every block was written.
+    *
+    *   Writes the frozen ring's frames from SD_CAPTURE_PRE_MS before the
+    *   trigger on, oldest first, as frame blocks indexed as the log's are,
+    *   then the last index block and the footer.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    byte *abyIndexBlock = &abyCaptureBlock[SD_LOG_BLOCK_SIZE];
+    stSDLogIndex_t *pstIndex = (stSDLogIndex_t *)&abyIndexBlock[sizeof(stSDLogBlockHeader_t)];
+    stSDLogIndexEntry_t *pstEntry = &pstIndex->astEntries[0];
+    stSDLogFooter_t stFooter = {0};
+    qword qwtStart = qwtCaptureTrigger > (qword)SD_CAPTURE_PRE_MS * 1000 ?
+                     qwtCaptureTrigger - (qword)SD_CAPTURE_PRE_MS * 1000 : 0;
+    word wLength = sizeof(stSDLogBlockHeader_t);
+    word wNFrames = 0;
+    word wIndexLength;
+    dword dwNPre = 0;
+    dword dwNPost = 0;
+    dword dwFrame = dwCaptureHead + dwCaptureSize - dwCaptureNFrames;
+    dword dwLeft;
+    dword dwSector;
+    qword qwtFrame;
+    qword qwtLast = 0;
+    const CAN_frame_t *pstFrame;
+
+    pstIndex->dwPreviousSector = SD_LOG_NO_SECTOR;
+    pstIndex->wNEntries = 0;
+    /* One pass over the ring, a pass more to write out the last block */
+    for (dwLeft = dwCaptureNFrames + 1; dwLeft > 0; dwLeft--, dwFrame++)
+    {
+        pstFrame = &astCaptureRing[dwFrame % dwCaptureSize];
+        qwtFrame = dwLeft > 1 ? SD_capture_time(pstFrame) : 0;
+        if (dwLeft > 1 && qwtFrame < qwtStart)
+        {
+            continue;
+        }
+        if (wNFrames > 0 && (dwLeft == 1 || wLength + SD_LOG_MAX_RECORD_SIZE > SD_LOG_BLOCK_SIZE))
+        {
+            dwSector = SD_capture_put(abyCaptureBlock, eSD_BLOCK_FRAMES, wLength, wNFrames, pstEntry->qwtBaseus);
+            if (dwSector == SD_LOG_NO_SECTOR)
+            {
+                return FALSE;
+            }
+            pstEntry->dwSector = dwSector;
+            pstEntry->dwSpanus = (dword)(qwtLast - pstEntry->qwtBaseus);
+            stFooter.dwNBlocks++;
+            stFooter.dwNFrames += wNFrames;
+            if (++pstIndex->wNEntries == SD_LOG_INDEX_ENTRIES)
+            {
+                wIndexLength = (word)(sizeof(stSDLogBlockHeader_t) + sizeof(stSDLogIndex_t));
+                dwSector = SD_capture_put(abyIndexBlock, eSD_BLOCK_INDEX, wIndexLength, 0, pstIndex->astEntries[0].qwtBaseus);
+                if (dwSector == SD_LOG_NO_SECTOR)
+                {
+                    return FALSE;
+                }
+                pstIndex->dwPreviousSector = dwSector;
+                pstIndex->wNEntries = 0;
+            }
+            pstEntry = &pstIndex->astEntries[pstIndex->wNEntries];
+            wLength = sizeof(stSDLogBlockHeader_t);
+            wNFrames = 0;
+        }
+        if (dwLeft == 1)
+        {
+            break;
+        }
+
+        if (wNFrames == 0)
+        {
+            pstEntry->qwtBaseus = qwtFrame;
+            memset(pstEntry->abyIDBloom, 0, SD_LOG_BLOOM_SIZE);
+            qwtLast = qwtFrame;
+        }
+        wLength = SD_log_put_frame(abyCaptureBlock, wLength, pstFrame, (dword)(qwtFrame - qwtLast));
+        SD_log_bloom_add(pstEntry->abyIDBloom, pstFrame->dwID);
+        wNFrames++;
+        qwtLast = qwtFrame;
+        if (stFooter.dwNFrames + wNFrames == 1)
+        {
+            stFooter.qwtFirstus = qwtFrame;
+        }
+        if (qwtFrame < qwtCaptureTrigger)
+        {
+            dwNPre++;
+        }
+        else
+        {
+            dwNPost++;
+        }
+    }
+
+    if (pstIndex->wNEntries != 0)
+    {
+        wIndexLength = (word)(sizeof(stSDLogBlockHeader_t) + offsetof(stSDLogIndex_t, astEntries) +
+                              pstIndex->wNEntries * sizeof(stSDLogIndexEntry_t));
+        dwSector = SD_capture_put(abyIndexBlock, eSD_BLOCK_INDEX, wIndexLength, 0, pstIndex->astEntries[0].qwtBaseus);
+        if (dwSector == SD_LOG_NO_SECTOR)
+        {
+            return FALSE;
+        }
+        pstIndex->dwPreviousSector = dwSector;
+    }
+
+    stFooter.dwIndexSector = pstIndex->dwPreviousSector;
+    stFooter.qwtLastus = qwtLast;
+    memcpy(&abyIndexBlock[sizeof(stSDLogBlockHeader_t)], &stFooter, sizeof(stFooter));
+    portENTER_CRITICAL(&stSDCaptureLock);
+    stCaptureStats.dwNPreFrames = dwNPre;
+    stCaptureStats.dwNPostFrames = dwNPost;
+    portEXIT_CRITICAL(&stSDCaptureLock);
+    return SD_capture_put(abyIndexBlock, eSD_BLOCK_FOOTER, sizeof(stSDLogBlockHeader_t) + sizeof(stFooter), 0,
+                          qwtLast) != SD_LOG_NO_SECTOR;
+}
+
+static dword SD_capture_put(byte *abyBlock, byte byType, word wLength, word wNFrames, qword qwtBaseus)
+{
+    /*
+    *===========================================================================
+    *   SD_capture_put
+    *   Takes:   As SD_log_write
+    *
+    *   Returns: Sector the block starts at, SD_LOG_NO_SECTOR if it failed.
+    *
+    *   SD_log_write for the capture file.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *   18/10/26 CP Frame blocks compressed by SD_log_pack
+    *
+    *===========================================================================
+    */
+    dword dwSector = (dword)(qwCaptureOffset / SD_SECTOR_SIZE);
+    word wPaddedLength;
+
+    abyBlock = SD_log_pack(abyBlock, &byType, &wLength);
+    wPaddedLength = SD_log_fill_header(abyBlock, byType, wLength, wNFrames, qwtBaseus, dwCaptureSequence++,
+                                       stCaptureFileHeader.dwFileID);
+    if (write(NCaptureFile, abyBlock, wPaddedLength) != (ssize_t)wPaddedLength)
+    {
+        return SD_LOG_NO_SECTOR;
+    }
+    qwCaptureOffset += wPaddedLength;
+    return dwSector;
+}
+
+static boolean SD_capture_put_file_block(void)
+{
+    /*
+    *===========================================================================
+    *   SD_capture_put_file_block
+    *   Takes:   None
+    *
+    *   Returns: TRUE if it was written.
+    *
+    *   Writes the capture file's file block at its first sector, the first
+    *   time as the file's first write and the second over it.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    memcpy(&abyCaptureBlock[sizeof(stSDLogBlockHeader_t)], &stCaptureFileHeader, sizeof(stCaptureFileHeader));
+    (void)SD_log_fill_header(abyCaptureBlock, eSD_BLOCK_FILE, sizeof(stSDLogBlockHeader_t) + sizeof(stCaptureFileHeader),
+                             0, stCaptureFileHeader.qwtOpenus, 0, 0);
+    if (pwrite(NCaptureFile, abyCaptureBlock, SD_SECTOR_SIZE, 0) != SD_SECTOR_SIZE)
+    {
+        return FALSE;
+    }
+    if (qwCaptureOffset == 0)
+    {
+        /* pwrite leaves the file position, the trigger block goes after it */
+        qwCaptureOffset = SD_SECTOR_SIZE;
+        dwCaptureSequence = 1;
+        return lseek(NCaptureFile, SD_SECTOR_SIZE, SEEK_SET) == SD_SECTOR_SIZE;
+    }
+    return TRUE;
+}
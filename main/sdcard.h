@@ -1,21 +1,273 @@
 #ifndef SDCARD
 
 #include <unistd.h>
+#include <fcntl.h>
+#include <stddef.h>
 #include <stdio.h>
+#include <strings.h>
+#include <sys/stat.h>
 #include "pin.h"
+#include "esp_attr.h"
 #include "esp_vfs_fat.h"
 #include "sdmmc_cmd.h"
 #include "driver/sdspi_host.h"
 #include "driver/spi_master.h"
+#include "freertos/task.h"
+#include "esp_rom_crc.h"
 #include "espnow.h"
+#include "I2C.h"
 #include "main.h"
 #include "dirent.h"
+#include "nvs.h"
+#include "esp_heap_caps.h"
+#include "esp_cpu.h"
+#include "sdcompress.h"
 #include "CAN/can.h"
 
+#define SD_MOUNT_POINT "/sdcard"
+
+/*  SD logger
+    Producers, the CAN Rx callback included, only add their frame to one of SD_LOG_BLOCKS RAM
+    blocks under a spinlock. A writer task at the background loop's priority writes each block once
+    it is full with a single sector aligned write(), which the SPI bus moves by DMA at SDMMC_FREQ.
+    Every SD_LOG_SYNC_MS the block being filled is written and the file synced so a power cut loses
+    at most that much. If every block is waiting on the card, frames are dropped and counted. Write
+    and sync times go in log2 histograms, logged every SD_LOG_REPORT_MS.
+    SD_card_init only starts the writer task, which mounts the card and opens the file itself, so
+    it is called once CAN is up and the producers fill the RAM blocks from the first frame. The
+    times from power up to the first frame taken and to it being on the card are logged.
+*/
+#define SD_LOG_BLOCK_SIZE       16384   // Bytes per write, a multiple of SD_SECTOR_SIZE up to 32 KB
+#define SD_LOG_BLOCKS           2       // Double buffered
+#define SD_LOG_SYNC_MS          1000    // 0 to only write full blocks and never sync
+#define SD_LOG_REPORT_MS        10000
+#define SD_LOG_HIST_BUCKETS     16      // Bucket N counts times of 2^N to 2^(N+1) - 1 us
+#define SD_SECTOR_SIZE          512
+#define SD_LOG_TASK_STACK       4096
+#define SD_LOG_TASK_PRIORITY    1       // Same as app_main's background loop, below Wi-Fi and esp_timer
+
+/*  Log files
+    Each file is made SD_LOG_FILE_KB long and contiguous when it is opened so the writer only ever
+    overwrites clusters FATFS has already allocated, a write never stops to extend the cluster chain
+    and write back a FAT sector, and a sync has no FAT to flush. As the file's size is then no guide
+    to how much of it holds the log, its header's qwValidBytes is rewritten on every sync. Before
+    the next frame block and the index and footer that may follow it no longer fit, the writer
+    finishes the file, trims it to the bytes used and rolls on to the next log number.
+    The next log number is kept in NVS and saved as each file is opened, so naming a file is one
+    NVS read and one stat() however many logs the card holds. If NVS has none, or that file is
+    already there because the card came from another logger, the directory is scanned once for
+    the highest number. Names are 8.3 so FATFS needs no long file name support.
+*/
+#define SD_LOG_FILE_KB          262144  // 256 MB, 0 to grow the file as it is written
+#define SD_LOG_FILE_SIZE        ((qword)SD_LOG_FILE_KB * 1024)
+#define SD_LOG_NAME_FORMAT      "%s/log%05lu.bin"
+#define SD_LOG_MAX_NUMBER       99999   // Then back to 0, overwriting
+#define SD_LOG_NVS_NAMESPACE    "sdlog"
+#define SD_LOG_NVS_KEY          "next"
+
+/*  Log format, SD_LOG_FILE_VERSION
+    A file is a run of blocks each starting on a sector: a stSDLogBlockHeader_t, its records and
+    zeros out to the sector. dwCRC is the CRC32 of the header up to it and the records, a reader
+    that finds a bad CRC or length skips to the next sector starting with SD_LOG_BLOCK_MAGIC so a
+    corrupt block loses only its own frames. The CRC starts from the file's dwFileID rather than 0
+    so blocks left on the card by an older file fail it, the file block's own CRC starts from 0.
+        eSD_BLOCK_FILE: Always first, its record is a stSDLogFileHeader_t.
+        eSD_BLOCK_FRAMES: CAN frames in the ESP-NOW telemetry frame format in espnow.h, a 2 or 5
+            byte header with the DLC and the 11 or 29 bit ID, the us since the previous frame as a
+            varint, the block's first since qwtBaseus, then DLC data bytes.
+        eSD_BLOCK_INDEX: A stSDLogIndex_t, see below.
+        eSD_BLOCK_FOOTER: A stSDLogFooter_t, only in a file's last sector after SD_card_close.
+        eSD_BLOCK_TRIGGER: A stSDLogTrigger_t, second in a capture file, see below.
+        eSD_BLOCK_FRAMES_LZ: An eSD_BLOCK_FRAMES block's records compressed, see below.
+    util/sdlog.py reads v1 and v2 files and converts between them.
+*/
+#define SD_LOG_FILE_VERSION     2
+#define SD_LOG_BLOCK_MAGIC      0x42524653  // "SFRB"
+#define SD_LOG_MAX_RECORD_SIZE  (ESPNOW_EXT_HEADER_SIZE + 5 + 8)
+
+/*  Log index
+    Every SD_LOG_INDEX_ENTRIES frame blocks the writer adds an index block giving the sector each
+    one starts at, its time span and a bloom filter of its IDs, and the sector of the index block
+    before it. SD_card_close writes the last part full index block and a footer pointing at it, so
+    a reader can walk the index back from the end of the file without reading any frames and seek
+    straight to a time or ID. util/sdlog.py rebuilds the index of a file that was not closed.
+*/
+#define SD_LOG_INDEX_ENTRIES    32
+#define SD_LOG_BLOOM_SIZE       32      // Bytes, each ID sets 2 bits
+#define SD_LOG_BLOOM_HASH       0x9E3779B1  // Bits are the top two bytes of ID * this
+#define SD_LOG_NO_SECTOR        0xFFFFFFFF
+#define SD_LOG_CLOSE_TIMEOUT_MS 2000
+
+/*  Log compression
+    With SD_LOG_COMPRESS the writer task compresses each frame block's records on their own before
+    writing it, see sdcompress.h, so the index, a corrupt block being skipped and a file that was
+    not closed all work as before. The records become [Raw length, 2 LE] then the compressed bytes
+    and the block is an eSD_BLOCK_FRAMES_LZ, the header's length, CRC and frame count are of the
+    block as written. A block that would not come out at least a sector shorter is written as it
+    was. The producers still fill whole raw blocks, only the writes are shorter. The bytes in and
+    out and the CPU cycles it took are in stSDLogStats_t and reported with the write times.
+*/
+#define SD_LOG_COMPRESS         1       // 0 to write frame blocks as they are
+#define SD_LOG_RAW_LENGTH_SIZE  2
+
+typedef enum {
+    eSD_BLOCK_FILE = 1,
+    eSD_BLOCK_FRAMES,
+    eSD_BLOCK_INDEX,
+    eSD_BLOCK_FOOTER,
+    eSD_BLOCK_TRIGGER,
+    eSD_BLOCK_FRAMES_LZ,
+} eSDLogBlock_t;
+
+/* Fixed width types as the file is read on a PC */
+typedef struct __attribute__((packed)) {
+    uint32_t dwMagic;           // SD_LOG_BLOCK_MAGIC
+    uint8_t  byType;            // eSDLogBlock_t
+    uint8_t  byReserved;
+    uint16_t wLength;           // Record bytes after the header
+    uint16_t wNFrames;
+    uint16_t wReserved;
+    uint32_t dwSequence;        // Blocks before this one in the file
+    uint64_t qwtBaseus;         // Rx time of the first frame, us since power up
+    uint32_t dwCRC;
+} stSDLogBlockHeader_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t  byVersion;         // SD_LOG_FILE_VERSION
+    uint8_t  byReserved;
+    uint16_t wSectorSize;
+    uint16_t wBlockSize;        // Longest a block can be
+    uint16_t wDeviceID;
+    uint64_t qwtOpenus;         // Time since power up when the file was opened
+    uint8_t  abyClock[7];       // External clock's BCD time registers then, 0s if it did not answer
+    uint8_t  byReserved2;
+    uint32_t dwFileID;          // Random, seeds every other block's CRC
+    uint32_t dwReserved;
+    uint64_t qwValidBytes;      // Log bytes from the start of the file as of the last sync
+    uint64_t qwFileBytes;       // Pre-allocated length, 0 if the file grows as it is written
+} stSDLogFileHeader_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t dwSector;          // Where the frame block starts, in SD_SECTOR_SIZE sectors
+    uint32_t dwSpanus;          // Its last frame's time less qwtBaseus
+    uint64_t qwtBaseus;
+    uint8_t  abyIDBloom[SD_LOG_BLOOM_SIZE];
+} stSDLogIndexEntry_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t dwPreviousSector;  // Index block before this one, SD_LOG_NO_SECTOR for the first
+    uint16_t wNEntries;
+    uint16_t wReserved;
+    stSDLogIndexEntry_t astEntries[SD_LOG_INDEX_ENTRIES];   // Only wNEntries are written
+} stSDLogIndex_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t dwIndexSector;     // Last index block, SD_LOG_NO_SECTOR if there are no frames
+    uint32_t dwNBlocks;         // Frame blocks
+    uint32_t dwNFrames;
+    uint32_t dwNDropped;
+    uint64_t qwtFirstus;
+    uint64_t qwtLastus;
+} stSDLogFooter_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t  byCause;           // eSDCaptureCause_t
+    uint8_t  bySource;          // Kill source, position in the capture's timeout list or command byte
+    uint16_t wReserved;
+    uint32_t dwPreus;           // Window asked for before the trigger
+    uint32_t dwPostus;          // And after it, the ring may have filled first
+    uint32_t dwReserved;
+    uint64_t qwtTriggerus;
+} stSDLogTrigger_t;
+
+/* Index and footer blocks are written from their own buffer, whole sectors */
+#define SD_LOG_INDEX_BLOCK_SIZE ((sizeof(stSDLogBlockHeader_t) + sizeof(stSDLogIndex_t) + SD_SECTOR_SIZE - 1) & ~(SD_SECTOR_SIZE - 1))
+
+typedef struct {
+    dword dwNFrames;
+    dword dwNDropped;           // Every block was waiting on the card
+    dword dwNWrites;
+    dword dwNWriteErrors;
+    dword dwNSyncs;
+    qword qwNBytesWritten;      // Padding included
+    dword dwWriteMaxus;
+    dword dwSyncMaxus;
+    dword dwNFiles;             // Opened, the first included
+    dword dwRollMaxus;          // Finishing one file and opening the next
+    qword qwtFirstFrameus;      // us since power up, 0 until it happens
+    qword qwtMountedus;
+    qword qwtFirstWrittenus;    // First frame block on the card
+    qword qwNRawBytes;          // Frame block records offered to the compressor, capture files included
+    qword qwNPackedBytes;       // Their length as written, raw where compressing did not save a sector
+    qword qwNCompressCycles;
+    dword adwNWriteus[SD_LOG_HIST_BUCKETS];
+    dword adwNSyncus[SD_LOG_HIST_BUCKETS];
+} stSDLogStats_t;
+
+/*  Capture ring
+    Without logging to the card, or as well as it, SD_capture_init keeps the last frames in a RAM
+    ring of CAN_frame_t sized from the free heap. A kill frame that is not a repeat, one of a list
+    of safety frames timing out or eCMD_CAPTURE triggers it: the frames from SD_CAPTURE_PRE_MS
+    before are held and the ring fills on for SD_CAPTURE_POST_MS, or until only the share of it
+    the pre-trigger frames were given is left, then freezes. The writer task writes the frozen
+    ring out as one capNNNNN.bin in the log format, trigger block second, then re-arms. Taking a
+    frame is a copy under a spinlock whatever the ring's state. If there is no card the capture
+    stays frozen and the writer tries again every SD_CAPTURE_RETRY_MS.
+*/
+#define SD_CAPTURE_PRE_MS           2000
+#define SD_CAPTURE_POST_MS          500     // With the pre window under the 16.7 s CAN Rx time wrap
+#define SD_CAPTURE_HEAP_RESERVE_KB  64      // Left free for Wi-Fi, ESP-NOW and the rest
+#define SD_CAPTURE_HEAP_PERCENT     50      // Of the free heap over the reserve
+#define SD_CAPTURE_MAX_KB           256
+#define SD_CAPTURE_MIN_FRAMES       1024
+#define SD_CAPTURE_BUS_FPS          7800    // 8 byte frames flat out at 1 Mbit/s, for the report
+#define SD_CAPTURE_RETRY_MS         1000
+#define SD_CAPTURE_NAME_FORMAT      "%s/cap%05lu.bin"
+
+#if SD_CAPTURE_PRE_MS + SD_CAPTURE_POST_MS >= 16000
+#error "A capture must fit in the CAN Rx time's 16.7 s wrap"
+#endif
+
+typedef enum {
+    eSD_CAPTURE_OFF = 0,
+    eSD_CAPTURE_ARMED,
+    eSD_CAPTURE_POST,           // Triggered, taking the post-trigger frames
+    eSD_CAPTURE_FROZEN,         // The writer task's until it is on the card
+} eSDCaptureState_t;
+
+typedef enum {
+    eSD_CAPTURE_KILL = 1,
+    eSD_CAPTURE_TIMEOUT,
+    eSD_CAPTURE_COMMAND,
+} eSDCaptureCause_t;
+
+typedef struct {
+    dword dwRingFrames;
+    dword dwRingBytes;
+    dword dwHeapLeft;           // Free heap once the ring and its write buffer were taken
+    dword dwNTriggers;
+    dword dwNIgnored;           // Came while a capture was already under way
+    dword dwNFiles;
+    dword dwNWriteErrors;
+    byte byCause;               // The last capture's
+    byte bySource;
+    boolean BPostCut;           // The ring filled before its post window was up
+    dword dwNPreFrames;
+    dword dwNPostFrames;
+    dword dwLatchus;            // Trigger event to the pre-trigger frames being held
+    dword dwFrozenus;           // Trigger to the ring frozen
+    dword dwWriteus;            // Frozen to the file synced
+} stSDCaptureStats_t;
+
 esp_err_t SD_card_init(void);
-esp_err_t sdcard_empty_buffer(void);
-esp_err_t SD_card_write(byte *abyData);
-esp_err_t SD_card_write_CAN(CAN_frame_t stCANFrame, dword dwTimestamp);
+esp_err_t SD_card_write_CAN(const CAN_frame_t *stCANFrame, qword qwtRx);
+esp_err_t SD_card_close(void);
+void SD_log_get_stats(stSDLogStats_t *stStats);
+esp_err_t SD_capture_init(void);
+esp_err_t SD_capture_CAN(const CAN_frame_t *stCANFrame, qword qwtRx);
+esp_err_t SD_capture_trigger(byte byCause, byte bySource);
+void SD_capture_check_errors(void);
+void SD_capture_get_stats(stSDCaptureStats_t *stStats);
 
 #define SDCARD
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,184 @@
+/*
+sdcompress.c
+File contains the LZ4 block compression of SD log blocks.
+
+Written by Cole Perera for Sheffield Formula Racing 2026
+*/
+
+#include "sdcompress.h"
+
+/* --------------------------- Local Variables ------------------------ */
+/* Last offset each hash of 4 bytes was seen at, only the SD writer task compresses */
+static word awHashTable[1 << SD_COMPRESS_HASH_BITS];
+
+/* --------------------------- Function prototypes --------------------- */
+static uint32_t SD_compress_read32(const byte *abySource);
+static dword SD_compress_put_sequence(byte *abyDest, dword dwOut, word wDestSize, const byte *abyLiterals,
+                                      dword dwNLiterals, dword dwOffset, dword dwMatchLength);
+static dword SD_compress_put_length(byte *abyDest, dword dwOut, dword dwLength);
+
+/* --------------------------- Functions ----------------------------- */
+word SD_compress_block(const byte *abySource, word wLength, byte *abyDest, word wDestSize)
+{
+    /*
+    *===========================================================================
+    *   SD_compress_block
+    *   Takes:   abySource - bytes to compress
+    *            wLength - how many
+    *            abyDest - where the compressed block goes
+    *            wDestSize - its size, the most the caller will take
+    *
+    *   Returns: Compressed length, 0 if it would not fit in wDestSize.
+    *
+    *   Compresses one block on its own in the LZ4 block format, see
+    *   sdcompress.h. Not reentrant, the hash table is shared.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    dword dwIn = 0;
+    dword dwAnchor = 0;
+    dword dwOut = 0;
+    dword dwNMisses = 0;
+    dword dwMatchEnd = wLength > SD_COMPRESS_LAST_LITERALS ? wLength - SD_COMPRESS_LAST_LITERALS : 0;
+    dword dwCandidate;
+    dword dwMatchLength;
+    dword dwHash;
+    uint32_t dwSequence;
+
+    memset(awHashTable, 0, sizeof(awHashTable));
+    while (dwIn + SD_COMPRESS_MATCH_LIMIT < wLength)
+    {
+        dwSequence = SD_compress_read32(&abySource[dwIn]);
+        dwHash = (dword)((uint32_t)(dwSequence * SD_COMPRESS_HASH) >> (32 - SD_COMPRESS_HASH_BITS));
+        dwCandidate = awHashTable[dwHash];
+        awHashTable[dwHash] = (word)dwIn;
+        if (dwCandidate >= dwIn || SD_compress_read32(&abySource[dwCandidate]) != dwSequence)
+        {
+            /* Nothing here, step further the longer nothing has matched */
+            dwIn += 1 + (dwNMisses++ >> SD_COMPRESS_SKIP_SHIFT);
+            continue;
+        }
+        dwNMisses = 0;
+
+        dwMatchLength = SD_COMPRESS_MIN_MATCH;
+        while (dwIn + dwMatchLength < dwMatchEnd && abySource[dwCandidate + dwMatchLength] == abySource[dwIn + dwMatchLength])
+        {
+            dwMatchLength++;
+        }
+        dwOut = SD_compress_put_sequence(abyDest, dwOut, wDestSize, &abySource[dwAnchor], dwIn - dwAnchor,
+                                         dwIn - dwCandidate, dwMatchLength);
+        if (dwOut == 0)
+        {
+            return 0;
+        }
+        dwIn += dwMatchLength;
+        dwAnchor = dwIn;
+    }
+
+    /* The rest as literals, with no match to end the sequence */
+    dwOut = SD_compress_put_sequence(abyDest, dwOut, wDestSize, &abySource[dwAnchor], wLength - dwAnchor, 0, 0);
+    return (word)dwOut;
+}
+
+static uint32_t SD_compress_read32(const byte *abySource)
+{
+    /*
+    *===========================================================================
+    *   SD_compress_read32
+    *   Takes:   abySource - 4 bytes, any alignment
+    *
+    *   Returns: Them as a 32 bit word.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    uint32_t dwValue;
+
+    memcpy(&dwValue, abySource, sizeof(dwValue));
+    return dwValue;
+}
+
+static dword SD_compress_put_sequence(byte *abyDest, dword dwOut, word wDestSize, const byte *abyLiterals,
+                                      dword dwNLiterals, dword dwOffset, dword dwMatchLength)
+{
+    /*
+    *===========================================================================
+    *   SD_compress_put_sequence
+    *   Takes:   abyDest - compressed block
+    *            dwOut - where the sequence goes
+    *            wDestSize - abyDest's size
+    *            abyLiterals - bytes before the match
+    *            dwNLiterals - how many
+    *            dwOffset - how far back the match is
+    *            dwMatchLength - its length, 0 for the last sequence
+    *
+    *   Returns: Offset after the sequence, 0 if it does not fit.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    dword dwMatchCode = dwMatchLength > 0 ? dwMatchLength - SD_COMPRESS_MIN_MATCH : 0;
+
+    /* Token, length bytes at one per 255, literals, offset and match length bytes */
+    if (dwOut + 1 + dwNLiterals / 255 + 1 + dwNLiterals + 2 + dwMatchCode / 255 + 1 > wDestSize)
+    {
+        return 0;
+    }
+    abyDest[dwOut++] = (byte)(((dwNLiterals < 15 ? dwNLiterals : 15) << 4) | (dwMatchCode < 15 ? dwMatchCode : 15));
+    if (dwNLiterals >= 15)
+    {
+        dwOut = SD_compress_put_length(abyDest, dwOut, dwNLiterals - 15);
+    }
+    memcpy(&abyDest[dwOut], abyLiterals, dwNLiterals);
+    dwOut += dwNLiterals;
+    if (dwMatchLength == 0)
+    {
+        return dwOut;
+    }
+
+    abyDest[dwOut++] = (byte)(dwOffset & 0xFF);
+    abyDest[dwOut++] = (byte)(dwOffset >> 8);
+    if (dwMatchCode >= 15)
+    {
+        dwOut = SD_compress_put_length(abyDest, dwOut, dwMatchCode - 15);
+    }
+    return dwOut;
+}
+
+static dword SD_compress_put_length(byte *abyDest, dword dwOut, dword dwLength)
+{
+    /*
+    *===========================================================================
+    *   SD_compress_put_length
+    *   Takes:   abyDest - compressed block, the caller has checked it fits
+    *            dwOut - where the length goes
+    *            dwLength - what is left over the token's 15
+    *
+    *   Returns: Offset after it.
+    *
+    *   Writes 255 until less is left, then the rest.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    while (dwLength >= 255)
+    {
+        abyDest[dwOut++] = 255;
+        dwLength -= 255;
+    }
+    abyDest[dwOut++] = (byte)dwLength;
+    return dwOut;
+}
@@ -0,0 +1,30 @@
+/* Only define once */
+#ifndef SFRSDCompress
+#define SFRSDCompress
+
+#include <string.h>
+#include "sfrtypes.h"
+
+/*  SD Log Block Compression
+    A block is compressed on its own in the LZ4 block format so any block can be decoded without
+    the ones before it: sequences of [Token], [Literal length - 15, 255s...], Literals,
+    [Offset, 2 LE], [Match length - 19, 255s...]. The token's top nibble is the literal count and
+    its bottom nibble the match length less 4, 15 in either means more length bytes follow. The
+    last sequence is literals only, the last SD_COMPRESS_LAST_LITERALS bytes are always literals
+    and no match starts in the last SD_COMPRESS_MATCH_LIMIT bytes.
+    Matches are found through a table of the last place each hash of 4 bytes was seen, so the
+    window is the block itself and the only state is the table. Past SD_COMPRESS_SKIP_SHIFT
+    misses in a row the search steps further each time, data that does not compress costs little.
+    util/sdlog.py decompresses it and any LZ4 block decoder can too.
+*/
+#define SD_COMPRESS_HASH_BITS       12      // 8 KB table
+#define SD_COMPRESS_HASH            2654435761u
+#define SD_COMPRESS_MIN_MATCH       4
+#define SD_COMPRESS_LAST_LITERALS   5
+#define SD_COMPRESS_MATCH_LIMIT     12
+#define SD_COMPRESS_SKIP_SHIFT      6
+#define SD_COMPRESS_MAX_INPUT       0xFFFF  // Offsets are 2 bytes
+
+word SD_compress_block(const byte *abySource, word wLength, byte *abyDest, word wDestSize);
+
+#endif // SFRSDCompress
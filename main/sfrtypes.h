@@ -10,7 +10,9 @@ Written by Cole Perera for Sheffield Formula Racing 2025
 #include "esp_adc/adc_cali.h"
 #include "esp_adc/adc_cali_scheme.h"
 
+#ifndef DEVICE_ID
 #define DEVICE_ID 0xFF // UPDATE THIS FOR EACH DEVICE
+#endif
 
 #define TRUE 1
 #define FALSE 0
@@ -33,21 +35,33 @@ typedef struct __attribute__((aligned(4))) {
     uint32_t dwID;       // 4 bytes
     uint8_t  byDLC;      // 0-8 (Data Length Code)
     uint8_t  abData[8];  // 8 bytes
-    uint8_t  padding[3]; // 3 bytes explicit padding to reach 16 bytes total
+    uint8_t  abyRxTime[3]; // Low 24 bits of the Rx time in us, fills the padding to 16 bytes
 } CAN_frame_t;
 
 _Static_assert(sizeof(CAN_frame_t) == 16, "CAN_frame_t size mismatch!");
 
+typedef struct {
+    uint32_t dwID;
+    uint16_t wTelemPeriodms;    // Max rate over ESP-NOW, 0 sends every frame
+} CAN_telem_rate_t;
+
 typedef struct {
     adc_cali_handle_t stCalibration;
     adc_oneshot_unit_handle_t stADCUnit;
     adc_channel_t eNChannel;
+    struct stADCChannel *pstContinuous; // Set by adc_continuous_add, NULL for oneshot reads
 } stADCHandles_t;
 
+#define SENSOR_MAP_POINTS 101
+
 typedef struct {
     float fLowerLimit;
     float fUpperLimit;
-    float afLookupTable[2][101];
+    float afLookupTable[2][SENSOR_MAP_POINTS];  // Volts, strictly rising, then values
+    /* Filled by sensor_map_init, leave out of initialisers */
+    float afSlope[SENSOR_MAP_POINTS - 1];        // Value per volt of each segment
+    float fStepInverse;                         // 1 / breakpoint spacing if even, 0 to binary search
+    boolean BCompiled;
 } stSensorMap_t;
 
 typedef enum {
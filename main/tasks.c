@@ -18,6 +18,10 @@ extern uint8_t byMACAddress[6];
 extern esp_reset_reason_t eResetReason;
 extern eChipMode_t eDeviceMode;
 static esp_partition_t *stOTAPartition = NULL;
+static qword qwtReflashEntryTime = 0;
+
+/* --------------------------- Function prototypes ----------------------------- */
+static void reflash_reset(void);
 
 /* --------------------------- Global Variables ----------------------------- */
 dword adwMaxTaskTime[eTASK_TOTAL];
@@ -39,6 +43,31 @@ void task_BG(void)
     qwtTaskTimer = esp_timer_get_time();
     astTaskState[eTASK_BG] = eTASK_ACTIVE;
 
+    /* Reflash left by a CAN command, clear it so the next entry starts fresh */
+    if (qwtReflashEntryTime != 0)
+    {
+        reflash_reset();
+    }
+
+    /* Send Rxed CAN frames over ESP-NOW once a packet is full or its deadline is up */
+    (void)ESPNOW_tx_service();
+
+    /* Put received ESP-NOW telemetry in order and send the link statistics */
+    (void)ESPNOW_telem_service();
+
+    /* Relay the received telemetry onto the bus */
+    #ifdef GPIO_CAN0_TX
+    (void)CAN_empty_ESPNOW_buffer(stCANBus0);
+    #endif
+
+    /* Check, store and swap in a calibration table received over CAN */
+    (void)CAL_service();
+
+    #ifdef ESPNOW_FLASH_BRIDGE
+    /* Pit bridge, relay reflash packets between the laptop and the nodes */
+    (void)ESPNOW_flash_bridge_service();
+    #endif
+
     /* Service the watchdog if all task have been completed at least once */
     word wNTaskCounter = 0;
     boolean bTasksComplete = TRUE;
@@ -78,6 +107,14 @@ void task_1ms(void)
     /* CAN error handling */
     CANRxCheck1ms();
 
+    /* A message timing out triggers an SD capture */
+    SD_capture_check_errors();
+
+    /* APPS checks and throttle */
+    #if DEVICE_ID == APPS_ID
+    (void)APPS_task_1ms();
+    #endif
+
     /* Update time since power up */
     dwTimeSincePowerUpms++;
 
@@ -141,6 +178,11 @@ void task_100ms(void)
             (int)adwLastTaskTime[eTASK_BG], 
             (int)adwLastTaskTime[eTASK_1MS],
             (int)adwLastTaskTime[eTASK_100MS]);
+        adc_report();
+        MCP320X_report();
+        APPS_report();
+        IMD_report();
+        CAL_report();
         wNCounter = 0;
         #endif
     }
@@ -149,6 +191,29 @@ void task_100ms(void)
     /* Check if the CAN bus is in error state and recover */
     CAN_bus_diagnosics();
 
+    /* Scanned MCP320X counts, or the IMD's captured PWM, to signals */
+    #if DEVICE_ID == MCP320X_DYNO_ID
+    if (MCP320X_update_dyno() == ESP_OK)
+    {
+        (void)DynoPressuresRawTx(stCANBus0);
+        (void)DynoTempsRawTx(stCANBus0);
+        /* Calibrated once their tables have been sent, see calibration.h */
+        if (CAL_get_version(CAL_DYNO_PRESSURE) != 0)
+        {
+            (void)DynoPressuresTx(stCANBus0);
+        }
+        if (CAL_get_version(CAL_DYNO_TEMP) != 0)
+        {
+            (void)DynoTempsTx(stCANBus0);
+        }
+    }
+    #elif DEVICE_ID == MCP320X_TEMP_MONITOR_ID
+    (void)MCP320X_update_temp_monitor(&stThermistorMap, (byte)(NTempMonNumber * MCP320X_MAX_CHANNELS));
+    #elif DEVICE_ID == IMD_ID
+    (void)IMD_update();
+    (void)IMDDataTx(stCANBus0);
+    #endif
+
     /* Update max task time */
     qwtTaskTimer = esp_timer_get_time() - qwtTaskTimer;
     adwLastTaskTime[eTASK_100MS] = (dword)qwtTaskTimer;
@@ -173,8 +238,8 @@ void reflash_task_100ms(void)
 /* Background task for reflash mode */
 void reflash_task_BG()
 {
-    static qword qwtReflashEntryTime = 0;
     esp_err_t eState;
+    qword qwtNow;
     (void)esp_task_wdt_reset();
 
     /* Initialise Reflash Mode */
@@ -182,6 +247,11 @@ void reflash_task_BG()
     {
         ESP_LOGI("CANFLASH", "Entering reflash mode with firmware size %d bytes", dwFirmwareSize);
         qwtReflashEntryTime = (qword)esp_timer_get_time();
+        qwtLastReflashActivity = qwtReflashEntryTime;
+
+        /* Nothing reads the Rx queue in normal mode, drop the stale frames so retries from an
+           earlier attempt are not taken as new data, which would throw away the checkpoint */
+        CAN_clear_rx_buffer();
     }
 
     if (stOTAPartition == NULL)
@@ -194,39 +264,63 @@ void reflash_task_BG()
         {
             ESP_LOGI("CANFLASH", "OTA partition found at address 0x%08X, size %d bytes",
                 stOTAPartition->address, stOTAPartition->size);
-            eState = esp_partition_erase_range(stOTAPartition, 0, stOTAPartition->size);
-            if (eState != ESP_OK) {
-                ESP_LOGE("CANFLASH", "Failed to erase OTA partition: %s", esp_err_to_name(eState));
+
+            /* Erasing waits for the host's first query so sectors from an interrupted reflash can be kept */
+            eState = CAN_flash_start(stOTAPartition);
+            if (eState != ESP_OK)
+            {
+                ESP_LOGE("CANFLASH", "Failed to start reflash: %s", esp_err_to_name(eState));
                 stOTAPartition = NULL;
             }
         }
     }
 
-    /* Write new binary as its recieved */
+    /* Write new binary as its recieved, a unicast image is committed once complete */
     eState = CAN_flash_empty_queue(stOTAPartition);
     if (eState != ESP_OK)
     {
         ESP_LOGE("CANFLASH", "Failed to read reflash data to flash: %s", esp_err_to_name(eState));
     }
+    eState = ESPNOW_flash_empty_queue(stOTAPartition);
+    if (eState != ESP_OK)
+    {
+        ESP_LOGE("CANFLASH", "Failed to read ESP-NOW reflash data to flash: %s", esp_err_to_name(eState));
+    }
     eState = CAN_flash_write(stOTAPartition);
     if (eState != ESP_OK)
     {
         ESP_LOGE("CANFLASH", "Failed to write reflash data to flash: %s", esp_err_to_name(eState));
     }
 
-    /* If binary fully received then restart */
-    if (dwBytesWrittenReflash >= dwFirmwareSize && dwFirmwareSize > 0)
+    /* Answer resume/missing queries, multicast nodes only restart on a commit from the host */
+    eState = CAN_flash_service_status(stOTAPartition);
+    if (eState != ESP_OK)
     {
-        uint32_t dwFlashTime = (uint32_t)((esp_timer_get_time() - qwtReflashEntryTime)/1000000);
-        ESP_LOGI("CANFLASH", "Reflash complete, written %d bytes in %d s", (int)dwBytesWrittenReflash, dwFlashTime);
-        eState = esp_ota_set_boot_partition(stOTAPartition);
-        if (eState == ESP_OK) {
-            esp_restart();
-        }
-        ESP_LOGE("CANFLASH", "Failed to set boot partition: %s", esp_err_to_name(eState));
+        ESP_LOGE("CANFLASH", "Failed to service reflash status: %s", esp_err_to_name(eState));
+    }
+
+    /* Give up if the host has gone, progress is in the checkpoint for the next attempt */
+    qwtNow = (qword)esp_timer_get_time();
+    if (qwtNow - qwtReflashEntryTime > MAX_eREFLASH_TIME_US ||
+        qwtNow - qwtLastReflashActivity > REFLASH_IDLE_TIMEOUT_US)
+    {
+        ESP_LOGW("CANFLASH", "Reflash timed out after %d s, %d bytes written, returning to normal mode",
+            (int)((qwtNow - qwtReflashEntryTime) / 1000000), (int)dwBytesWrittenReflash);
+        reflash_reset();
+        CAN_clear_rx_buffer();
+        set_device_mode(eNORMAL);
     }
 }
 
+static void reflash_reset(void)
+{
+    /* Clears the reflash state so the next entry to reflash mode starts fresh */
+    CAN_flash_stop();
+    ESPNOW_flash_stop();
+    stOTAPartition = NULL;
+    qwtReflashEntryTime = 0;
+}
+
 void pin_toggle(gpio_num_t ePin)
 {
     static boolean BLEDState = false;
@@ -11,6 +11,8 @@
 #include "pin.h"
 #include "CAN/can.h"
 #include "espnow.h"
+#include "espnowflash.h"
+#include "espnowtelem.h"
 #include "sdcard.h"
 #include "contactors.h"
 #include "adc.h"
@@ -20,6 +22,9 @@
 #include "main.h"
 #include "CAN/canDecodeAuto.h"
 #include "mcp320X.h"
+#include "apps.h"
+#include "imd.h"
+#include "calibration.h"
 
 /* --------------------------- Function prototypes ----------------------------- */
 void task_BG(void);
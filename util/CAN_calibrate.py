@@ -0,0 +1,201 @@
+import sys
+import os
+import csv
+import time
+import struct
+import zlib
+import argparse
+
+###
+# SFR ESP32 Calibration Table Tool
+# Makes a calibration table blob for main/calibration.h from a spreadsheet of a sensor's
+# calibration, writes it to a file and, with --device, sends it to a node over CAN with a
+# Vector CAN device (or any python-can interface). The node checks it, stores it in NVS and
+# swaps it in without stopping, then replies with the result.
+#
+# The spreadsheet (.xlsx or .csv) needs a column of volts, rising, and a column of the
+# sensor's value at each, 2 to 101 rows. Several sensors can share one sheet, --column picks one.
+#
+# Blob, little endian:
+#    - Header: Magic 'SCAL', Format, Slot, NPoints, 0, Version, Lower, Upper, 0, Scale, Offset
+#    - NPoints uint16 volts in 0.1 mV, NPoints int16 values, value = int * Scale + Offset
+#    - CRC32 of everything before it
+#
+# Sending:
+#    - ID: 0x1FD00000 | DeviceID << 12 | Index, Data: [7 bytes of blob], index 0 first
+#    - Reply: ID: DeviceID, Data: [0x54, Slot, Result, Version1, Version0] Result 0 = OK
+#
+# Examples:
+#    python CAN_calibrate.py --sheet dyno_cal.xlsx --column "Oil bar" --slot 0 --version 3
+#    python CAN_calibrate.py --sheet dyno_cal.csv --column "Oil bar" --slot 0 --version 3 --device 0x19
+#
+
+# -----------------------------------------------------------------------------
+# Configuration
+# -----------------------------------------------------------------------------
+CAN_INTERFACE = 'vector'
+CAN_CHANNEL = 0          # 0 = First channel assigned in Vector Hardware Config
+BITRATE = 1000000        # 1 Mbps
+APP_NAME = "CAN_Calibrate"
+
+# Must match firmware calibration.h
+CAL_MAGIC = 0x4C414353
+CAL_FORMAT = 1
+CAL_MAX_TABLES = 8
+CAL_MAX_POINTS = 101
+CAL_MV_SCALE = 10
+CAL_DATA_ID = 0x1FD00000
+CAL_NODE_SHIFT = 12
+CAL_CHUNK_SIZE = 7
+CAL_RESP = 0x54
+HEADER_FORMAT = '<IBBBBHHHHff'
+RESULTS = {0: "OK", 1: "CRC mismatch", 2: "Bad table", 3: "Older than the node's", 4: "NVS error"}
+SLOTS = {0: "Dyno pressure 0", 1: "Dyno pressure 1", 2: "Dyno pressure 2", 3: "Dyno coolant flow",
+         4: "Dyno temperature 0", 5: "Dyno temperature 1", 6: "Dyno temperature 2"}
+
+REPLY_TIMEOUT = 2.0     # Checked and written to NVS by the node's background task (s)
+FRAME_GAP = 0.0005      # Between data frames (s)
+
+# -----------------------------------------------------------------------------
+# Tables
+# -----------------------------------------------------------------------------
+def read_sheet(path, volts_column, value_column, sheet_name=None):
+    """Returns the (volts, value) rows of a spreadsheet, blank rows skipped."""
+    if path.lower().endswith('.csv'):
+        with open(path, newline='') as f:
+            rows = list(csv.DictReader(f))
+    else:
+        import pandas as pd
+        rows = pd.read_excel(path, sheet_name=sheet_name or 0).to_dict('records')
+    if not rows:
+        raise ValueError(f"{path} has no rows")
+    columns = list(rows[0].keys())
+    volts_column = volts_column or columns[0]
+    value_column = value_column or columns[1]
+    for column in (volts_column, value_column):
+        if column not in columns:
+            raise ValueError(f"No column '{column}' in {path}, it has {', '.join(map(str, columns))}")
+    points = []
+    for row in rows:
+        try:
+            points.append((float(row[volts_column]), float(row[value_column])))
+        except (TypeError, ValueError):
+            continue
+    return [(v, y) for v, y in points if v == v and y == y]
+
+def make_blob(points, slot, version, lower=None, upper=None):
+    """Packs points into a blob, returns it and the worst error the 16 bit values add."""
+    if not 2 <= len(points) <= CAL_MAX_POINTS:
+        raise ValueError(f"Need 2 to {CAL_MAX_POINTS} points, have {len(points)}")
+    if not 0 <= slot < CAL_MAX_TABLES:
+        raise ValueError(f"Slot must be 0 to {CAL_MAX_TABLES - 1}")
+    if not 1 <= version <= 0xFFFF:
+        raise ValueError("Version must be 1 to 65535")
+    volts = [round(v * 1000 * CAL_MV_SCALE) for v, _ in points]
+    if any(b <= a for a, b in zip(volts, volts[1:])):
+        raise ValueError("Volts must rise at least 0.1 mV a row")
+    if volts[0] < 0 or volts[-1] > 0xFFFF:
+        raise ValueError("Volts must be 0 to 6.5535 V")
+    values = [y for _, y in points]
+    offset = (max(values) + min(values)) / 2
+    scale = (max(values) - min(values)) / 65534 or 1.0
+    # The node works in float, so quantise against the float32 scale and offset it will use
+    scale, offset = struct.unpack('<ff', struct.pack('<ff', scale, offset))
+    ints = [max(-32767, min(32767, round((y - offset) / scale))) for y in values]
+    worst = max(abs(n * scale + offset - y) for n, y in zip(ints, values))
+    lower_mv = volts[0] if lower is None else round(lower * 1000 * CAL_MV_SCALE)
+    upper_mv = volts[-1] if upper is None else round(upper * 1000 * CAL_MV_SCALE)
+    if not 0 <= lower_mv < upper_mv <= 0xFFFF:
+        raise ValueError("Limits must be 0 to 6.5535 V, lower first")
+    blob = struct.pack(HEADER_FORMAT, CAL_MAGIC, CAL_FORMAT, slot, len(points), 0, version,
+                       lower_mv, upper_mv, 0, scale, offset)
+    blob += struct.pack(f'<{len(volts)}H', *volts) + struct.pack(f'<{len(ints)}h', *ints)
+    return blob + struct.pack('<I', zlib.crc32(blob) & 0xFFFFFFFF), worst
+
+def chunks(blob, device):
+    """The blob's data frames in order, (arbitration ID, data)."""
+    return [(CAL_DATA_ID | (device & 0xFF) << CAL_NODE_SHIFT | n, blob[o:o + CAL_CHUNK_SIZE])
+            for n, o in enumerate(range(0, len(blob), CAL_CHUNK_SIZE))]
+
+# -----------------------------------------------------------------------------
+# CAN
+# -----------------------------------------------------------------------------
+def send_blob(args, blob):
+    """Sends the blob and waits for the node's reply, returns the result code or None."""
+    vector_lib_path = r"C:\Users\Public\Documents\Vector\XL Driver Library\bin"
+    if os.path.exists(vector_lib_path):
+        os.environ['PATH'] += os.pathsep + vector_lib_path
+    try:
+        import can
+    except ImportError:
+        print("Error: 'python-can' library is required to send, pip install python-can")
+        sys.exit(1)
+
+    if args.interface == 'vector':
+        bus = can.Bus(interface=args.interface, channel=args.channel, bitrate=args.bitrate, app_name=APP_NAME)
+    else:
+        bus = can.Bus(interface=args.interface, channel=args.channel, bitrate=args.bitrate)
+    try:
+        while bus.recv(timeout=0) is not None:
+            pass
+        for arbitration_id, data in chunks(blob, args.device):
+            bus.send(can.Message(arbitration_id=arbitration_id, data=data, is_extended_id=True))
+            time.sleep(FRAME_GAP)
+        deadline = time.time() + REPLY_TIMEOUT
+        while time.time() < deadline:
+            msg = bus.recv(timeout=deadline - time.time())
+            if msg is None:
+                break
+            if msg.arbitration_id == args.device and not msg.is_extended_id and len(msg.data) >= 5 and \
+               msg.data[0] == CAL_RESP and msg.data[1] == args.slot:
+                version = msg.data[3] << 8 | msg.data[4]
+                print(f"Node 0x{args.device:02X} slot {args.slot}: {RESULTS.get(msg.data[2], msg.data[2])}, "
+                      f"now version {version}")
+                return msg.data[2]
+        print(f"Node 0x{args.device:02X}: no reply")
+        return None
+    finally:
+        bus.shutdown()
+
+# -----------------------------------------------------------------------------
+# Main Execution
+# -----------------------------------------------------------------------------
+def parse_args():
+    parser = argparse.ArgumentParser(description="SFR calibration table blob maker and sender")
+    parser.add_argument('--sheet', required=True, help="Calibration spreadsheet, .xlsx or .csv")
+    parser.add_argument('--sheet-name', help="Sheet of an .xlsx, the first if not given")
+    parser.add_argument('--volts', help="Column of volts, the first if not given")
+    parser.add_argument('--column', help="Column of the sensor's values, the second if not given")
+    parser.add_argument('--slot', type=int, required=True, help="Table slot on the node, see calibration.h")
+    parser.add_argument('--version', type=int, required=True, help="Table version, 1 up, not older than the node's")
+    parser.add_argument('--lower', type=float, help="Plausible volts from, the first row's if not given")
+    parser.add_argument('--upper', type=float, help="Plausible volts to, the last row's if not given")
+    parser.add_argument('--out', help="Blob file, <sheet>_slot<n>.cal if not given")
+    parser.add_argument('--device', type=lambda x: int(x, 0), help="Send to this device ID over CAN")
+    parser.add_argument('--interface', default=CAN_INTERFACE, help="python-can interface")
+    parser.add_argument('--channel', default=CAN_CHANNEL, help="python-can channel")
+    parser.add_argument('--bitrate', type=int, default=BITRATE)
+    return parser.parse_args()
+
+def main():
+    args = parse_args()
+    print("\n=== SFR Calibration Table ===")
+    try:
+        points = read_sheet(args.sheet, args.volts, args.column, args.sheet_name)
+        blob, worst = make_blob(points, args.slot, args.version, args.lower, args.upper)
+    except (OSError, ValueError) as e:
+        print(f"Error: {e}")
+        sys.exit(1)
+    out = args.out or f"{os.path.splitext(args.sheet)[0]}_slot{args.slot}.cal"
+    with open(out, 'wb') as f:
+        f.write(blob)
+    print(f"Slot {args.slot} ({SLOTS.get(args.slot, 'unassigned')}), version {args.version}, {len(points)} points, "
+          f"{points[0][0]:.4f} to {points[-1][0]:.4f} V")
+    print(f"Blob: {out}, {len(blob)} bytes, {len(chunks(blob, 0))} frames, worst 16 bit value error {worst:.6g}")
+
+    if args.device is not None:
+        result = send_blob(args, blob)
+        sys.exit(0 if result == 0 else 1)
+
+if __name__ == "__main__":
+    main()
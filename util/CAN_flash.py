@@ -2,6 +2,8 @@ import sys
 import os
 import time
 import struct
+import zlib
+import argparse
 
 ###
 # SFR ESP32 CAN Flasher using Vector CAN Interface
@@ -15,15 +17,45 @@ import struct
 #    - Size is a 4-byte big-endian integer representing the size of the binary in bytes.
 #
 # 2. Stream binary data in 8-byte CAN frames with crc8 error detection
-#    - ID: TargetID, Data: [Data0, Data1, Data2, Data3, Data4, Data5, Data6, CRC8]
+#    - ID: 0x1F800000 | TargetID << 14 | Offset, Data: [Data0, Data1, Data2, Data3, Data4, Data5, Data6, CRC8]
+#    - Offset is the low 14 bits of the byte offset of Data0, so a frame resent after its ACK was
+#      lost is recognised and ACKed again rather than written twice.
 #    - Each payload is 7 bytes of data + 1 byte CRC8 checksum.
-#    - The ESP returns a ACK or NACK, if is a NACK the same frame is resent.
+#    - The ESP returns a ACK or NACK with the bytes it has received, the stream carries on from
+#      there, so on a NACK the same frame is resent.
 #    - NACK frames also contain the error count.
-#    - ACK frame: ID: DeviceID, Data: [0xFF]
-#    - NACK frame: ID: DeviceID, Data: [0x00, ErrorCount0, ErrorCount1]
+#    - ACK frame: ID: DeviceID, Data: [0xFF, Received3, Received2, Received1, Received0]
+#    - NACK frame: ID: DeviceID, Data: [0x00, ErrorCount0, ErrorCount1, Received3, ..., Received0]
 #
 # 3. The ESP will validate the binary after all data is sent and restart running the new firmware.
-#   
+#    - Reply COMMIT: ID: DeviceID, Data: [0x43, Result] Result 0 = OK
+#
+# Resume: progress is checkpointed on the ESP every 4 KB sector. Between steps 1 and 2 the host
+# sends a status query with the CRC32 of the binary, if the ESP has part of the same binary it
+# replies with how far it got and the stream continues from there.
+#    - ID: 0x010, Data: [0x40, 0xFF, 0xFF, 0x00, CRC3, CRC2, CRC1, CRC0]
+#    - Reply RESUME: ID: DeviceID, Data: [0x52, Offset3, Offset2, Offset1, Offset0]
+#    - The commit then also checks the CRC32.
+#
+# Multicast (--nodes 0x11,0x12,...) flashes several nodes running the same image at once:
+# 1. Send "Enter Multicast Reflash" command with a node mask and the size of the binary
+#    - ID: 0x010, Data: [0x20, Mask1, Mask0, Size3, Size2, Size1, Size0]
+#    - Bit n of the mask selects the node with ID 0x10 + n.
+#
+# 2. Stream every 7 byte chunk once with no ACK, the chunk index is carried in an extended ID
+#    - ID: 0x1FE00000 | Index, Data: [Data0, ..., Data6, CRC8]
+#
+# 3. Query each node for the chunks it missed and re-send only those until none are missing
+#    - ID: 0x010, Data: [0x40, Mask1, Mask0, 0x00, CRC3, CRC2, CRC1, CRC0]
+#    - Reply RESUME (as above) first, the first pass starts from the lowest resume point.
+#    - Reply MISSING: ID: DeviceID, Data: [0x4D, Base2, Base1, Base0, Mask3, Mask2, Mask1, Mask0]
+#      bit n of the mask = chunk Base + n is missing.
+#    - Reply DONE: ID: DeviceID, Data: [0x44, NMissing3, NMissing2, NMissing1, NMissing0]
+#
+# 4. Commit each node with the CRC32 of the binary, the node checks it and boots the new image
+#    - ID: 0x010, Data: [0x40, Mask1, Mask0, 0x01, CRC3, CRC2, CRC1, CRC0]
+#    - Reply COMMIT: ID: DeviceID, Data: [0x43, Result] Result 0 = OK
+#
 
 vector_lib_path = r"C:\Users\Public\Documents\Vector\XL Driver Library\bin"
 if os.path.exists(vector_lib_path):
@@ -53,12 +85,38 @@ CRC8_POLYNOMIAL = 0x12F
 # Command Codes (Must match firmware eCAN_CMD_t)
 CMD_REFLASH_MODE = 0b00001000
 CMD_NORMAL_MODE  = 0b00010000  # Reused for Size packet in firmware logic
+CMD_REFLASH_MULTICAST = 0b00100000
+CMD_REFLASH_STATUS    = 0b01000000
+
+# Multicast Definitions (Must match firmware canflash.h)
+REFLASH_MULTICAST_ID = 0x1FE00000
+REFLASH_UNICAST_ID = 0x1F800000
+REFLASH_NODE_SHIFT = 14
+REFLASH_OFFSET_MASK = 0x3FFF
+RESP_ACK  = 0xFF
+RESP_NACK = 0x00
+REFLASH_NODE_ID_BASE = 0x10
+REFLASH_ALL_NODES = 0xFFFF
+REFLASH_OP_QUERY  = 0x00
+REFLASH_OP_COMMIT = 0x01
+RESP_MISSING = 0x4D
+RESP_DONE    = 0x44
+RESP_COMMIT  = 0x43
+RESP_RESUME  = 0x52
+COMMIT_RESULTS = {0: "OK", 1: "Digest mismatch", 2: "Incomplete", 3: "Flash error"}
+CHUNK_SIZE = 7
 
 # Timing
 TIMEOUT_RX = 1.0              # Timeout for receiving messages (if needed)
 ESP32_REFLASH_DELAY = 1.0   # Delay after sending reflash command
 TIMEOUT_COMMS = 5.0         # Timeout if no ACK/NACK received
 RESEND_INTERVAL = 0.5       # Resend frame if no ACK/NACK received for this long (s)
+MULTICAST_FRAME_RATE = 5000   # Data frames per second, leaves the nodes time to write flash
+MULTICAST_READY_TIMEOUT = 30.0  # Time for the nodes to erase and answer the first query (s)
+STATUS_TIMEOUT = 2.0        # Timeout for a MISSING/DONE or COMMIT reply (s)
+MAX_REPAIR_ROUNDS = 50      # Query/re-send rounds before giving up on a node
+MAX_SILENT_QUERIES = 3      # Unanswered queries in a row before giving up on a node, it has likely reset
+COMMIT_TIMEOUT = 10.0       # Time for a node to read back and check the image (s)
 
 # File Paths
 # Assumes script is in 'util/' and build is in 'build/' relative to project root
@@ -71,9 +129,9 @@ BIN_PATH = os.path.join(BUILD_DIR, BIN_FILENAME)
 # -----------------------------------------------------------------------------
 # Helpers
 # -----------------------------------------------------------------------------
-def send_frame(bus, arbitration_id, data):
+def send_frame(bus, arbitration_id, data, is_extended_id=False):
     """Sends a single CAN frame."""
-    msg = can.Message(arbitration_id=arbitration_id, data=data, is_extended_id=False)
+    msg = can.Message(arbitration_id=arbitration_id, data=data, is_extended_id=is_extended_id)
     try:
         bus.send(msg)
     except can.CanError as e:
@@ -115,33 +173,330 @@ def calculate_crc_byte(seven_bytes):
             return i
     raise ValueError("Could not find valid CRC byte")
 
+def make_payload(chunk):
+    """Pads a chunk to 7 bytes and appends the CRC byte."""
+    if len(chunk) < CHUNK_SIZE:
+        chunk += b'\xFF' * (CHUNK_SIZE - len(chunk))
+    return list(chunk) + [calculate_crc_byte(chunk)]
+
+def node_mask(nodes):
+    """Builds the 16 bit multicast node mask from a list of device IDs."""
+    mask = 0
+    for node in nodes:
+        if not REFLASH_NODE_ID_BASE <= node < REFLASH_NODE_ID_BASE + 16:
+            raise ValueError(f"Node 0x{node:02X} cannot be addressed by multicast")
+        mask |= 1 << (node - REFLASH_NODE_ID_BASE)
+    return mask
+
+def drain_rx(bus):
+    """Drops anything already waiting in the receive buffer."""
+    while bus.recv(timeout=0) is not None:
+        pass
+
+def status_mask(nodes):
+    """Node mask for a status command, nodes outside the multicast range need the all nodes mask."""
+    try:
+        return node_mask(nodes)
+    except ValueError:
+        return REFLASH_ALL_NODES
+
+def send_status(bus, nodes, op, digest=0):
+    """Sends a reflash status command to the given nodes."""
+    mask = status_mask(nodes)
+    data = [CMD_REFLASH_STATUS, (mask >> 8) & 0xFF, mask & 0xFF, op] + list(struct.pack('>I', digest))
+    return send_frame(bus, CAN_CMD_ID, data)
+
+def query_missing(bus, node, digest, timeout=STATUS_TIMEOUT):
+    """Asks one node for its resume point and missing chunks of the image with this digest.
+    Returns (set of reported chunk indexes, total missing count, resume offset) or None on timeout.
+    The node caps the report length so the count may exceed the reported set."""
+    drain_rx(bus)
+    send_status(bus, [node], REFLASH_OP_QUERY, digest)
+    missing = set()
+    resume = 0
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        msg = bus.recv(timeout=0.1)
+        if msg is None or msg.arbitration_id != node or msg.is_extended_id:
+            continue
+        if msg.dlc == 5 and msg.data[0] == RESP_RESUME:
+            resume = struct.unpack('>I', bytes(msg.data[1:5]))[0]
+            deadline = time.time() + timeout
+        elif msg.dlc == 8 and msg.data[0] == RESP_MISSING:
+            base = (msg.data[1] << 16) | (msg.data[2] << 8) | msg.data[3]
+            bits = struct.unpack('>I', bytes(msg.data[4:8]))[0]
+            missing.update(base + n for n in range(32) if bits & (1 << n))
+            deadline = time.time() + timeout
+        elif msg.dlc == 5 and msg.data[0] == RESP_DONE:
+            return missing, struct.unpack('>I', bytes(msg.data[1:5]))[0], resume
+    return None
+
+def wait_commit(bus, node, timeout=COMMIT_TIMEOUT):
+    """Waits for a node's COMMIT reply, returns the result or None on timeout."""
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        msg = bus.recv(timeout=0.1)
+        if msg and msg.arbitration_id == node and not msg.is_extended_id \
+                and msg.dlc == 2 and msg.data[0] == RESP_COMMIT:
+            return msg.data[1]
+    return None
+
+def stream_chunks(bus, payloads, indexes, frame_rate=MULTICAST_FRAME_RATE):
+    """Sends the given chunks on the multicast ID, paced to frame_rate."""
+    start_time = time.time()
+    for count, index in enumerate(indexes):
+        while not send_frame(bus, REFLASH_MULTICAST_ID | index, payloads[index], is_extended_id=True):
+            time.sleep(0.01)
+        # Sleep only once well ahead of schedule, OS sleeps are too coarse to pace every frame
+        ahead = start_time + (count + 1) / frame_rate - time.time()
+        if ahead > 0.002:
+            time.sleep(ahead)
+        if count % 500 == 0 or count == len(indexes) - 1:
+            print_progress(count + 1, len(indexes), prefix='Progress:', suffix='Sent', length=40)
+
+def flash_unicast(bus, firmware_data, device_id):
+    """Stop and wait reflash of a single node, every frame is ACKed.
+    Continues from the node's checkpoint if it already has part of this binary."""
+    firmware_size = len(firmware_data)
+    digest = zlib.crc32(firmware_data) & 0xFFFFFFFF
+
+    # 3. Enter Reflash Mode & Send Size
+    print("\nSending 'Enter Reflash Mode' command with Size...")
+    # Protocol: ID=0x010, Data=[CMD_REFLASH_MODE, DEVICE_ID, Size3, Size2, Size1, Size0, 0, 0]
+    size_bytes = struct.pack('>I', firmware_size)
+    data_packet = [CMD_REFLASH_MODE, device_id] + list(size_bytes) + [0, 0]
+    send_frame(bus, CAN_CMD_ID, data_packet)
+    
+    # Give the ESP32 time to switch tasks/modes
+    time.sleep(ESP32_REFLASH_DELAY)
+
+    # Ask where to continue from, firmware without resume support does not answer so start at 0
+    result = query_missing(bus, device_id, digest)
+    resume = result[2] if result is not None else 0
+    if result is None:
+        print("No resume point from the device, sending the whole binary")
+    elif resume > 0:
+        print(f"Resuming from byte {resume} ({100 * resume / firmware_size:.1f}%)")
+
+    # 4. Stream Firmware Data
+    print("Flashing Firmware...")
+    start_time = time.time()
+    
+    # The node's ACK or NACK says how much it has, that is the next offset to send
+    offset = resume
+    total_chunks = (firmware_size - resume + CHUNK_SIZE - 1) // CHUNK_SIZE
+    total_errors = 0
+    sent = 0
+
+    while offset < firmware_size:
+        # Pad chunk and calculate CRC byte to construct 8-byte payload
+        payload = make_payload(firmware_data[offset:offset + CHUNK_SIZE])
+        arbitration_id = REFLASH_UNICAST_ID | (device_id & 0xFF) << REFLASH_NODE_SHIFT | (offset & REFLASH_OFFSET_MASK)
+        
+        # Track overall wait and time since last ACK/NACK for this payload
+        start_wait_time = time.time()
+        last_response_time = start_wait_time  # last ACK/NACK (or initial send anchor)
+
+        def send_with_retry():
+            nonlocal last_response_time
+            while not send_frame(bus, arbitration_id, payload, is_extended_id=True):
+                if (time.time() - start_wait_time) > TIMEOUT_COMMS:
+                    raise TimeoutError(f"Communication Timeout: Unable to send frame for {TIMEOUT_COMMS}s")
+                time.sleep(0.1)
+            # Anchor the "no response" timer to when we sent
+            last_response_time = time.time()
+
+        # Initial send: block/retry on TX errors but don't spam
+        send_with_retry()
+        sent += 1
+
+        # Wait for ACK/NACK. Ignore other bus traffic; only ACK/NACK
+        # affects resend timing.
+        while True:
+            now = time.time()
+            if (now - start_wait_time) > TIMEOUT_COMMS:
+                raise TimeoutError(f"Communication Timeout: No ACK or NACK received for {TIMEOUT_COMMS}s")
+
+            # Short receive window so we can periodically check resend condition
+            recv_timeout = min(0.1, max(0.0, TIMEOUT_COMMS - (now - start_wait_time)))
+
+            try:
+                msg = bus.recv(timeout=recv_timeout)
+            except can.CanError:
+                msg = None
+
+            if msg and msg.arbitration_id == device_id and not msg.is_extended_id:
+                data = msg.data if msg.data is not None else b''
+                if len(data) >= 5 and data[0] == RESP_ACK:
+                    received = struct.unpack('>I', bytes(data[1:5]))[0]
+                    if received > offset:
+                        offset = received
+                        break
+                    # A late ACK for a frame already moved on from, keep waiting for this one's
+                elif len(data) >= 7 and data[0] == RESP_NACK:
+                    received = struct.unpack('>I', bytes(data[3:7]))[0]
+                    total_errors += 1
+                    print_progress(sent, total_chunks, prefix='Progress:', suffix=f'Complete (Err: {total_errors})', length=40)
+                    if received != offset:
+                        # The node has more or less than this, carry on from what it has
+                        offset = received
+                        break
+                    # Resend immediately on explicit NACK and reset response timer
+                    send_with_retry()
+
+            # If we haven't seen an ACK/NACK for RESEND_INTERVAL seconds,
+            # resend the frame regardless of other bus traffic.
+            if (time.time() - last_response_time) >= RESEND_INTERVAL:
+                send_with_retry()
+
+        # Update Progress Bar every 10 chunks to reduce console I/O overhead
+        done = (min(offset, firmware_size) - resume + CHUNK_SIZE - 1) // CHUNK_SIZE
+        if done % 10 == 0 or offset >= firmware_size:
+            print_progress(done, total_chunks, prefix='Progress:', suffix=f'Complete (Err: {total_errors})', length=40)
+
+    end_time = time.time()
+    duration = end_time - start_time
+    speed_kbs = ((firmware_size - resume) / 1024) / max(duration, 1e-3)
+
+    print(f"\nFlash Complete!")
+    print(f"Time Elapsed: {duration:.2f}s")
+    print(f"Average Speed: {speed_kbs:.2f} KB/s")
+    result = wait_commit(bus, device_id)
+    print(f"Commit: {COMMIT_RESULTS.get(result, 'No reply')}")
+    return result == 0
+
+def flash_multicast(bus, firmware_data, nodes):
+    """Streams the binary once to every node then repairs each node's missing chunks.
+    Returns True if every node committed the new image."""
+    firmware_size = len(firmware_data)
+    digest = zlib.crc32(firmware_data) & 0xFFFFFFFF
+    payloads = [make_payload(firmware_data[i:i+CHUNK_SIZE]) for i in range(0, firmware_size, CHUNK_SIZE)]
+    total_chunks = len(payloads)
+    mask = node_mask(nodes)
+    node_names = ', '.join(f'0x{node:02X}' for node in nodes)
+
+    print(f"\nSending 'Enter Multicast Reflash' to {node_names} (CRC32 0x{digest:08X})...")
+    send_frame(bus, CAN_CMD_ID, [CMD_REFLASH_MULTICAST, (mask >> 8) & 0xFF, mask & 0xFF] + list(struct.pack('>I', firmware_size)))
+
+    # Nodes answer their first query once the erase has finished
+    start_time = time.time()
+    pending = list(nodes)
+    resume = {}
+    while pending:
+        if time.time() - start_time > MULTICAST_READY_TIMEOUT:
+            raise TimeoutError(f"Nodes {pending} did not become ready within {MULTICAST_READY_TIMEOUT}s")
+        still_pending = []
+        for node in pending:
+            result = query_missing(bus, node, digest)
+            if result is None:
+                still_pending.append(node)
+            else:
+                resume[node] = result[2]
+        pending = still_pending
+    print(f"All nodes ready after {time.time() - start_time:.2f}s")
+
+    # Every node already has the image up to its resume point
+    first_chunk = min(resume.values()) // CHUNK_SIZE
+    if first_chunk > 0:
+        print(f"Resuming from chunk {first_chunk} ({100 * first_chunk / total_chunks:.1f}%)")
+
+    print("Streaming Firmware...")
+    start_time = time.time()
+    stream_chunks(bus, payloads, range(first_chunk, total_chunks))
+    frames_sent = total_chunks - first_chunk
+
+    # Repair rounds, only the union of what the nodes are missing is re-sent
+    first_pass_missing = {}
+    incomplete = list(nodes)
+    silent = {node: 0 for node in nodes}
+    for repair_round in range(MAX_REPAIR_ROUNDS):
+        repair = set()
+        still_incomplete = []
+        for node in incomplete:
+            result = query_missing(bus, node, digest)
+            if result is None:
+                silent[node] += 1
+                print(f"Node 0x{node:02X} did not answer the status query")
+                still_incomplete.append(node)
+                continue
+            silent[node] = 0
+            missing, n_missing, _ = result
+            first_pass_missing.setdefault(node, n_missing)
+            if n_missing > 0:
+                repair |= missing
+                still_incomplete.append(node)
+        incomplete = still_incomplete
+        if not incomplete or all(silent[node] >= MAX_SILENT_QUERIES for node in incomplete):
+            break
+        print(f"\nRepair round {repair_round + 1}: re-sending {len(repair)} chunks for {len(incomplete)} nodes")
+        stream_chunks(bus, payloads, sorted(repair))
+        frames_sent += len(repair)
+
+    duration = time.time() - start_time
+    for node in nodes:
+        print(f"Node 0x{node:02X}: {first_pass_missing.get(node, '?')} chunks missed in the first pass")
+    print(f"Data frames sent: {frames_sent} ({frames_sent - (total_chunks - first_chunk)} repairs)")
+    print(f"Time Elapsed: {duration:.2f}s")
+    print(f"Average Speed: {(firmware_size / 1024) / duration:.2f} KB/s per node, "
+          f"{(firmware_size * len(nodes) / 1024) / duration:.2f} KB/s fleet")
+    if incomplete:
+        print(f"Giving up on nodes {[f'0x{node:02X}' for node in incomplete]}")
+
+    # Commit, each node checks the digest and boots the new image
+    all_ok = not incomplete
+    for node in nodes:
+        if node in incomplete:
+            continue
+        drain_rx(bus)
+        send_status(bus, [node], REFLASH_OP_COMMIT, digest)
+        result = wait_commit(bus, node)
+        print(f"Node 0x{node:02X} commit: {COMMIT_RESULTS.get(result, 'No reply')}")
+        all_ok = all_ok and result == 0
+    return all_ok
+
 # -----------------------------------------------------------------------------
 # Main Execution
 # -----------------------------------------------------------------------------
+def parse_args():
+    parser = argparse.ArgumentParser(description="SFR ESP32 CAN Flasher")
+    parser.add_argument('--bin', default=BIN_PATH, help="Binary to flash")
+    parser.add_argument('--device', type=lambda x: int(x, 0), default=DEVICE_ID,
+                        help="Device ID for a single node reflash")
+    parser.add_argument('--nodes', type=lambda x: [int(n, 0) for n in x.split(',')],
+                        help="Comma separated device IDs to reflash together, eg 0x11,0x12")
+    parser.add_argument('--interface', default=CAN_INTERFACE, help="python-can interface")
+    parser.add_argument('--channel', default=CAN_CHANNEL, help="python-can channel")
+    parser.add_argument('--bitrate', type=int, default=BITRATE)
+    return parser.parse_args()
+
 def main():
-    print(f"\n=== SFR ESP32 CAN Flasher (Vector) ===")
-    print(f"Target Binary: {BIN_PATH}")
+    args = parse_args()
+    print(f"\n=== SFR ESP32 CAN Flasher ({args.interface}) ===")
+    print(f"Target Binary: {args.bin}")
 
     # 1. Validate Binary File
-    if not os.path.exists(BIN_PATH):
-        print(f"Error: Binary file not found at {BIN_PATH}")
+    if not os.path.exists(args.bin):
+        print(f"Error: Binary file not found at {args.bin}")
         print("Please build the project first.")
         sys.exit(1)
 
-    with open(BIN_PATH, 'rb') as f:
+    with open(args.bin, 'rb') as f:
         firmware_data = f.read()
     
     firmware_size = len(firmware_data)
     print(f"Firmware Size: {firmware_size} bytes ({firmware_size/1024:.2f} KB)")
 
-    # 2. Initialize CAN Bus (Vector)
-    print(f"Initializing Vector CAN Interface (Channel {CAN_CHANNEL})...")
+    # 2. Initialize CAN Bus
+    print(f"Initializing {args.interface} CAN Interface (Channel {args.channel})...")
     try:
         # 'app_name' is important for Vector hardware to recognize the application
-        bus = can.Bus(interface=CAN_INTERFACE, channel=CAN_CHANNEL, bitrate=BITRATE, app_name=APP_NAME)
+        if args.interface == 'vector':
+            bus = can.Bus(interface=args.interface, channel=args.channel, bitrate=args.bitrate, app_name=APP_NAME)
+        else:
+            bus = can.Bus(interface=args.interface, channel=args.channel, bitrate=args.bitrate)
         print("CAN Bus Connected.")
     except Exception as e:
-        print(f"\nCRITICAL ERROR: Could not connect to Vector CAN hardware.")
+        print(f"\nCRITICAL ERROR: Could not connect to {args.interface} CAN hardware.")
         print(f"Details: {e}")
         print("\nTroubleshooting:")
         print("1. Ensure Vector hardware (VN16xx, etc.) is connected via USB.")
@@ -150,109 +505,12 @@ def main():
         sys.exit(1)
 
     try:
-        # 3. Enter Reflash Mode & Send Size
-        print("\nSending 'Enter Reflash Mode' command with Size...")
-        # Protocol: ID=0x010, Data=[CMD_REFLASH_MODE, DEVICE_ID, Size3, Size2, Size1, Size0, 0, 0]
-        size_bytes = struct.pack('>I', firmware_size)
-        data_packet = [CMD_REFLASH_MODE, DEVICE_ID] + list(size_bytes) + [0, 0]
-        send_frame(bus, CAN_CMD_ID, data_packet)
-        
-        # Give the ESP32 time to switch tasks/modes and erase flash
-        time.sleep(ESP32_REFLASH_DELAY)
-
-        # 4. Stream Firmware Data
-        print("Flashing Firmware...")
-        start_time = time.time()
-        
-        # Chunk data into 7-byte blocks (leaving 1 byte for CRC)
-        chunks = [firmware_data[i:i+7] for i in range(0, firmware_size, 7)]
-        total_chunks = len(chunks)
-        
-        total_errors = 0
-
-        for i, chunk in enumerate(chunks):
-            # Pad chunk if less than 7 bytes
-            if len(chunk) < 7:
-                chunk += b'\xFF' * (7 - len(chunk))
-                
-            # Calculate CRC byte
-            crc_byte = calculate_crc_byte(chunk)
-            
-            # Construct 8-byte payload
-            payload = list(chunk) + [crc_byte]
-            
-            # Track overall wait and time since last ACK/NACK for this payload
-            start_wait_time = time.time()
-            last_response_time = start_wait_time  # last ACK/NACK (or initial send anchor)
-
-            def send_with_retry():
-                nonlocal last_response_time
-                while not send_frame(bus, DEVICE_ID, payload):
-                    if (time.time() - start_wait_time) > TIMEOUT_COMMS:
-                        raise TimeoutError(f"Communication Timeout: Unable to send frame for {TIMEOUT_COMMS}s")
-                    time.sleep(0.1)
-                # Anchor the "no response" timer to when we sent
-                last_response_time = time.time()
-
-            # Initial send: block/retry on TX errors but don't spam
-            send_with_retry()
-
-            # Wait for ACK/NACK. Ignore other bus traffic; only ACK/NACK
-            # affects resend timing.
-            while True:
-                now = time.time()
-                if (now - start_wait_time) > TIMEOUT_COMMS:
-                    raise TimeoutError(f"Communication Timeout: No ACK or NACK received for {TIMEOUT_COMMS}s")
-
-                # Short receive window so we can periodically check resend condition
-                recv_timeout = min(0.1, max(0.0, TIMEOUT_COMMS - (now - start_wait_time)))
-
-                try:
-                    msg = bus.recv(timeout=recv_timeout)
-                except can.CanError:
-                    msg = None
-
-                if msg and msg.arbitration_id == DEVICE_ID:
-                    # Some frames may have no or too few data bytes; guard against that.
-                    data_len = len(msg.data) if msg.data is not None else 0
-                    if data_len == 0:
-                        # Empty payload from our device, ignore
-                        pass
-                    else:
-                        first_byte = msg.data[0]
-
-                        if first_byte == 0xFF:
-                            # ACK
-                            break
-                        elif first_byte == 0x00:
-                            # NACK - Error Count in [1:3] (Little Endian)
-                            if data_len >= 3:
-                                error_count = msg.data[1] | (msg.data[2] << 8)
-                                total_errors += 1
-                                print_progress(i, total_chunks, prefix='Progress:', suffix=f'Complete (Err: {total_errors})', length=40)
-
-                            # Resend immediately on explicit NACK and reset response timer
-                            send_with_retry()
-
-                    # Either way, after handling our own device message, check resend timer below
-
-                # If we haven't seen an ACK/NACK for RESEND_INTERVAL seconds,
-                # resend the frame regardless of other bus traffic.
-                if (time.time() - last_response_time) >= RESEND_INTERVAL:
-                    send_with_retry()
-
-            # Update Progress Bar every 10 chunks to reduce console I/O overhead
-            if i % 10 == 0 or i == total_chunks - 1:
-                print_progress(i + 1, total_chunks, prefix='Progress:', suffix=f'Complete (Err: {total_errors})', length=40)
-
-        end_time = time.time()
-        duration = end_time - start_time
-        speed_kbs = (firmware_size / 1024) / duration
-
-        print(f"\nFlash Complete!")
-        print(f"Time Elapsed: {duration:.2f}s")
-        print(f"Average Speed: {speed_kbs:.2f} KB/s")
-        print("The device should now validate and restart.")
+        if args.nodes:
+            if not flash_multicast(bus, firmware_data, args.nodes):
+                sys.exit(1)
+        else:
+            if not flash_unicast(bus, firmware_data, args.device):
+                sys.exit(1)
 
     except KeyboardInterrupt:
         print("\nOperation cancelled by user.")
@@ -0,0 +1,291 @@
+import sys
+import os
+import time
+import struct
+import zlib
+import argparse
+
+###
+# SFR ESP32 ESP-NOW Flasher
+# This script sends a binary firmware file to an SFR ESP32 device over ESP-NOW through a pit
+# bridge, an ESP32 built with ESPNOW_FLASH_BRIDGE defined and plugged into the laptop over USB.
+# No connection to the CAN harness is needed. See main/espnowflash.h for the protocol.
+#
+# 1. Send ENTER with the size and CRC32 of the binary
+#    - Payload: [0xF1, 0x01, DeviceID, Size3..Size0, CRC3..CRC0]
+#    - The ESP enters reflash mode and ACKs the offset to start from, this is the resume point
+#      if it already has part of the same binary.
+#
+# 2. Stream the binary in DATA packets of up to 243 bytes, keeping a window of packets in flight
+#    - Payload: [0xF1, 0x03, DeviceID, Offset3..Offset0, Data...]
+#    - ACK:  [0xF1, 0x81, DeviceID, Offset3..Offset0] every byte before Offset is received
+#    - NACK: [0xF1, 0x82, DeviceID, Offset3..Offset0] a packet was lost, resend from Offset
+#    - With no ACK for a while the window is resent from the last ACK.
+#
+# 3. Once the last byte is in the ESP checks the CRC32 and boots the new image
+#    - COMMIT: [0xF1, 0x83, DeviceID, Result] Result 0 = OK
+#
+# Packets are SLIP framed on the serial port with the node MAC in front:
+#    [0xC0, MAC0..MAC5, Payload..., 0xC0]
+#
+
+# Try to import pyserial, provide instructions if missing
+try:
+    import serial
+except ImportError:
+    print("Error: 'pyserial' library is required.")
+    print("Please install it using: pip install pyserial")
+    sys.exit(1)
+
+# -----------------------------------------------------------------------------
+# Configuration
+# -----------------------------------------------------------------------------
+SERIAL_BAUD = 921600      # Ignored by the USB serial JTAG port but needed by pyserial
+DEVICE_ID = 0xFF
+
+# Protocol Definitions (Must match firmware espnowflash.h)
+ESPNOW_FLASH_PACKET = 0xF1
+OP_ENTER  = 0x01
+OP_QUERY  = 0x02
+OP_DATA   = 0x03
+OP_ACK    = 0x81
+OP_NACK   = 0x82
+OP_COMMIT = 0x83
+MAX_ESPNOW_PAYLOAD = 250
+DATA_HEADER_SIZE = 7
+MAX_DATA = MAX_ESPNOW_PAYLOAD - DATA_HEADER_SIZE
+COMMIT_RESULTS = {0: "OK", 1: "Digest mismatch", 2: "Incomplete", 3: "Flash error"}
+
+SLIP_END = 0xC0
+SLIP_ESC = 0xDB
+SLIP_ESC_END = 0xDC
+SLIP_ESC_ESC = 0xDD
+
+# Timing
+WINDOW_PACKETS = 8          # DATA packets in flight
+RETRANSMIT_TIMEOUT = 0.1    # Resend the window if no ACK for this long (s)
+ENTER_RETRY_INTERVAL = 1.0  # Resend ENTER if the ESP has not answered (s)
+ENTER_TIMEOUT = 30.0        # Time for the ESP to enter reflash mode (s)
+TIMEOUT_COMMS = 5.0         # Give up if no ACK for this long (s)
+COMMIT_TIMEOUT = 10.0       # Time for the ESP to read back and check the image (s)
+
+# File Paths
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+PROJECT_ROOT = os.path.dirname(SCRIPT_DIR)
+BIN_PATH = os.path.join(PROJECT_ROOT, 'build', 'SFRESP32.bin')
+
+# -----------------------------------------------------------------------------
+# Helpers
+# -----------------------------------------------------------------------------
+def print_progress(iteration, total, prefix='', suffix='', decimals=1, length=50, fill='█'):
+    """Call in a loop to create terminal progress bar"""
+    percent = ("{0:." + str(decimals) + "f}").format(100 * (iteration / float(total)))
+    filled_length = int(length * iteration // total)
+    bar = fill * filled_length + '-' * (length - filled_length)
+    sys.stdout.write(f'\r{prefix} |{bar}| {percent}% {suffix}')
+    if iteration == total:
+        sys.stdout.write('\n')
+    sys.stdout.flush()
+
+def parse_mac(text):
+    """'98:A3:16:85:6C:EC' to 6 bytes."""
+    mac = bytes(int(part, 16) for part in text.split(':'))
+    if len(mac) != 6:
+        raise argparse.ArgumentTypeError(f"Bad MAC address {text}")
+    return mac
+
+def slip_encode(data):
+    out = bytearray([SLIP_END])
+    for byte in data:
+        if byte == SLIP_END:
+            out += bytes([SLIP_ESC, SLIP_ESC_END])
+        elif byte == SLIP_ESC:
+            out += bytes([SLIP_ESC, SLIP_ESC_ESC])
+        else:
+            out.append(byte)
+    out.append(SLIP_END)
+    return bytes(out)
+
+class Bridge:
+    """SLIP framed link to the pit bridge."""
+    def __init__(self, port, mac):
+        self.serial = serial.Serial(port, SERIAL_BAUD, timeout=0)
+        self.mac = mac
+        self.frame = bytearray()
+        self.escape = False
+        self.packets = []
+
+    def send(self, payload):
+        self.serial.write(slip_encode(self.mac + bytes(payload)))
+
+    def recv(self, timeout):
+        """Returns the next reflash payload from the node or None on timeout."""
+        deadline = time.time() + timeout
+        while True:
+            for byte in self.serial.read(self.serial.in_waiting or 1):
+                if byte == SLIP_END:
+                    if len(self.frame) > 6:
+                        self.packets.append(bytes(self.frame))
+                    self.frame = bytearray()
+                    self.escape = False
+                elif byte == SLIP_ESC:
+                    self.escape = True
+                else:
+                    if self.escape:
+                        byte = SLIP_END if byte == SLIP_ESC_END else SLIP_ESC
+                        self.escape = False
+                    self.frame.append(byte)
+            while self.packets:
+                frame = self.packets.pop(0)
+                if frame[:6] == self.mac and frame[6] == ESPNOW_FLASH_PACKET:
+                    return frame[6:]
+            if time.time() >= deadline:
+                return None
+            time.sleep(0.001)
+
+    def close(self):
+        self.serial.close()
+
+def enter_reflash(bridge, device_id, firmware_size, digest):
+    """Sends ENTER until the node ACKs its resume point, returns the offset to start from."""
+    payload = [ESPNOW_FLASH_PACKET, OP_ENTER, device_id] + list(struct.pack('>II', firmware_size, digest))
+    start_time = time.time()
+    while time.time() - start_time < ENTER_TIMEOUT:
+        bridge.send(payload)
+        deadline = time.time() + ENTER_RETRY_INTERVAL
+        while time.time() < deadline:
+            packet = bridge.recv(deadline - time.time())
+            if packet and len(packet) >= DATA_HEADER_SIZE and packet[1] == OP_ACK and packet[2] == device_id:
+                return struct.unpack('>I', packet[3:7])[0]
+    raise TimeoutError(f"Device did not enter reflash mode within {ENTER_TIMEOUT}s")
+
+def flash_espnow(bridge, firmware_data, device_id, window):
+    """Go-back-N reflash of a single node, returns True if the node committed the image."""
+    firmware_size = len(firmware_data)
+    digest = zlib.crc32(firmware_data) & 0xFFFFFFFF
+
+    print(f"\nSending ENTER (CRC32 0x{digest:08X})...")
+    base = enter_reflash(bridge, device_id, firmware_size, digest)
+    if base > 0:
+        print(f"Resuming from byte {base} ({100 * base / firmware_size:.1f}%)")
+    resume = base
+
+    print("Flashing Firmware...")
+    start_time = time.time()
+    next_offset = base
+    highest_sent = base
+    packets_sent = 0
+    retransmits = 0
+    nacks = 0
+    timeouts = 0
+    last_ack_time = time.time()
+    last_heard = last_ack_time
+    last_progress = 0
+    result = None
+
+    while base < firmware_size:
+        # Fill the window
+        while next_offset < firmware_size and next_offset - base < window * MAX_DATA:
+            data = firmware_data[next_offset:next_offset + MAX_DATA]
+            bridge.send([ESPNOW_FLASH_PACKET, OP_DATA, device_id] + list(struct.pack('>I', next_offset)) + list(data))
+            packets_sent += 1
+            if next_offset < highest_sent:
+                retransmits += 1
+            next_offset += len(data)
+            highest_sent = max(highest_sent, next_offset)
+
+        packet = bridge.recv(RETRANSMIT_TIMEOUT / 4)
+        now = time.time()
+        if packet and len(packet) >= 4 and packet[1] == OP_COMMIT and packet[2] == device_id:
+            # The last ACK was lost but the node has the whole image
+            result = packet[3]
+            base = firmware_size
+            break
+        if packet and len(packet) >= DATA_HEADER_SIZE and packet[2] == device_id:
+            offset = struct.unpack('>I', packet[3:7])[0]
+            if packet[1] == OP_ACK and offset > base:
+                base = offset
+                last_ack_time = now
+                last_heard = now
+                next_offset = max(next_offset, base)
+            elif packet[1] == OP_NACK:
+                nacks += 1
+                base = max(base, offset)
+                next_offset = base
+                last_ack_time = now
+                last_heard = now
+
+        if now - last_heard > TIMEOUT_COMMS:
+            raise TimeoutError(f"Communication Timeout: No ACK received for {TIMEOUT_COMMS}s")
+        if now - last_ack_time > RETRANSMIT_TIMEOUT and next_offset > base:
+            # Lost packets or lost ACKs, go back to the last ACK
+            timeouts += 1
+            next_offset = base
+            last_ack_time = now - RETRANSMIT_TIMEOUT / 2
+
+        if base - last_progress >= 16 * MAX_DATA or base >= firmware_size:
+            last_progress = base
+            print_progress(base, firmware_size, prefix='Progress:', suffix=f'Complete (Retx: {retransmits})', length=40)
+
+    duration = time.time() - start_time
+    sent_bytes = firmware_size - resume
+    print(f"\nFlash Complete!")
+    print(f"Time Elapsed: {duration:.2f}s")
+    print(f"Average Speed: {(sent_bytes / 1024) / max(duration, 1e-3):.2f} KB/s")
+    print(f"Packets sent: {packets_sent}, retransmitted: {retransmits} "
+          f"({100 * retransmits / max(packets_sent, 1):.1f}%), NACKs: {nacks}, timeouts: {timeouts}")
+
+    deadline = time.time() + COMMIT_TIMEOUT
+    while time.time() < deadline and result is None:
+        packet = bridge.recv(deadline - time.time())
+        if packet and len(packet) >= 4 and packet[1] == OP_COMMIT and packet[2] == device_id:
+            result = packet[3]
+    print(f"Commit: {COMMIT_RESULTS.get(result, 'No reply')}")
+    return result == 0
+
+# -----------------------------------------------------------------------------
+# Main Execution
+# -----------------------------------------------------------------------------
+def parse_args():
+    parser = argparse.ArgumentParser(description="SFR ESP32 ESP-NOW Flasher")
+    parser.add_argument('--bin', default=BIN_PATH, help="Binary to flash")
+    parser.add_argument('--port', required=True, help="Serial port of the pit bridge, eg COM5 or /dev/ttyACM0")
+    parser.add_argument('--mac', type=parse_mac, required=True, help="WiFi STA MAC of the node, eg 98:A3:16:85:6C:EC")
+    parser.add_argument('--device', type=lambda x: int(x, 0), default=DEVICE_ID, help="Device ID of the node")
+    parser.add_argument('--window', type=int, default=WINDOW_PACKETS, help="DATA packets in flight")
+    return parser.parse_args()
+
+def main():
+    args = parse_args()
+    print("\n=== SFR ESP32 ESP-NOW Flasher ===")
+    print(f"Target Binary: {args.bin}")
+
+    if not os.path.exists(args.bin):
+        print(f"Error: Binary file not found at {args.bin}")
+        print("Please build the project first.")
+        sys.exit(1)
+
+    with open(args.bin, 'rb') as f:
+        firmware_data = f.read()
+    print(f"Firmware Size: {len(firmware_data)} bytes ({len(firmware_data)/1024:.2f} KB)")
+
+    try:
+        bridge = Bridge(args.port, args.mac)
+    except serial.SerialException as e:
+        print(f"\nCRITICAL ERROR: Could not open the bridge on {args.port}: {e}")
+        sys.exit(1)
+
+    ok = False
+    try:
+        ok = flash_espnow(bridge, firmware_data, args.device, args.window)
+    except KeyboardInterrupt:
+        print("\nOperation cancelled by user.")
+    except Exception as e:
+        print(f"\nAn error occurred during flashing: {e}")
+    finally:
+        bridge.close()
+    if not ok:
+        sys.exit(1)
+
+if __name__ == "__main__":
+    main()
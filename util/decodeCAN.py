@@ -23,6 +23,19 @@ if not EXCEL_PATH:
 
 OUTPUT_C_PATH = os.path.join(os.path.dirname(__file__), '../main/CAN/canDecodeAuto.c')
 OUTPUT_H_PATH = os.path.join(os.path.dirname(__file__), '../main/CAN/canDecodeAuto.h')
+OUTPUT_SIGNALS_PATH = os.path.join(os.path.dirname(__file__), 'sdlog_decode/canSignalsAuto.c')
+
+# C types of the signals as sdlog_decode's eCANSignalType_t
+SIGNAL_TYPES = {
+    "bool": "eCAN_SIGNAL_BOOL",
+    "uint8_t": "eCAN_SIGNAL_UINT8",
+    "int8_t": "eCAN_SIGNAL_INT8",
+    "uint16_t": "eCAN_SIGNAL_UINT16",
+    "int16_t": "eCAN_SIGNAL_INT16",
+    "uint32_t": "eCAN_SIGNAL_UINT32",
+    "int32_t": "eCAN_SIGNAL_INT32",
+    "float": "eCAN_SIGNAL_FLOAT",
+}
 
 def parse_id(id_val):
     if pd.isna(id_val):
@@ -277,8 +290,14 @@ def main():
         # Try to detect a rate/period column in the Main Bus sheet
         rate_col = None
         rate_col_is_period_ms = False
+        # Optional max rate over ESP-NOW telemetry, eg "Telemetry Rate (ms)", blank sends every frame
+        telem_col = None
         for col in df_bus.columns:
             cn = str(col).strip().lower()
+            if 'telem' in cn or 'radio' in cn:
+                if telem_col is None:
+                    telem_col = col
+                continue
             if any(k in cn for k in ['rate', 'frequency', 'freq', 'period', 'cycle', 'interval']):
                 rate_col = col
                 # If the header explicitly mentions ms, treat numeric values as period in ms
@@ -314,11 +333,23 @@ def main():
                     except Exception:
                         rate_hz, period_ms = 0.0, 0
 
+                telem_period_ms = 0
+                if telem_col is not None and telem_col in row:
+                    try:
+                        cell = row[telem_col]
+                        if isinstance(cell, (int, float)) and not pd.isna(cell):
+                            telem_period_ms = int(round(float(cell)))
+                        else:
+                            _, telem_period_ms = parse_rate(cell)
+                    except Exception:
+                        telem_period_ms = 0
+
                 msg_map[pid] = {
                     'name': msg_name_raw,
                     'desc': str(row['Description']).strip() if pd.notna(row['Description']) else "",
                     'rate_hz': rate_hz,
-                    'period_ms': period_ms
+                    'period_ms': period_ms,
+                    'telem_period_ms': telem_period_ms
                 }
                 
         # --- Read Main Bus Message (Signals) ---
@@ -544,6 +575,8 @@ def main():
         
         generate_c_code(messages, msg_map)
 
+        generate_signal_table(messages, msg_map)
+
     except Exception as e:
         print(f"Error: {e}")
         import traceback
@@ -730,6 +763,7 @@ def generate_c_code(messages, msg_map):
         thresh_ms = int(round(period_ms * 5)) if period_ms > 0 else 0
         h_content += f"#define {func_name.upper()}_PERIOD_MS {period_ms}\n"
         h_content += f"#define {func_name.upper()}_THRESH_MS {thresh_ms}\n"
+        h_content += f"#define {func_name.upper()}_TELEM_PERIOD_MS {int(msg_info.get('telem_period_ms', 0) or 0)}\n"
     h_content += "\n"
 
     # 3. Generate Functions
@@ -1163,6 +1197,10 @@ def generate_c_code(messages, msg_map):
 
     # Prototypes for periodic check functions
     h_content += "\nvoid CANRxCheck1ms(void);\nvoid CANRxCheck100ms(void);\n\n"
+
+    # ESP-NOW telemetry max rates, sorted by ID for a binary search
+    h_content += f"#define CAN_TELEM_RATES_LENGTH {len(per_msg_list)}\n"
+    h_content += "extern const CAN_telem_rate_t astCANTelemRates[CAN_TELEM_RATES_LENGTH];\n"
     h_content += "\n#endif\n"
     
     # Generate periodic check functions in C
@@ -1189,6 +1227,13 @@ def generate_c_code(messages, msg_map):
                 c_content += f"    tSince{base_name} += 100;\n"
     c_content += "}\n\n"
 
+    # ESP-NOW telemetry max rates
+    c_content += "/* ESP-NOW telemetry max rates - autogenerated */\n\n"
+    c_content += "const CAN_telem_rate_t astCANTelemRates[CAN_TELEM_RATES_LENGTH] =\n{\n"
+    for (pid, base_name, rate_hz, period_ms, thresh_ms) in per_msg_list:
+        c_content += f"    {{ 0x{pid:X}, {int(msg_map[pid].get('telem_period_ms', 0) or 0)} }},\n"
+    c_content += "};\n\n"
+
     with open(OUTPUT_C_PATH, 'w') as f:
         f.write(c_content)
     with open(OUTPUT_H_PATH, 'w') as f:
@@ -1196,6 +1241,72 @@ def generate_c_code(messages, msg_map):
         
     print(f"Generated code for {count} messages in {OUTPUT_C_PATH}")
 
+def generate_signal_table(messages, msg_map):
+    # Table of what each Rx function decodes for util/sdlog_decode, see canSignals.h there.
+    # A row per value written, in the order the Rx function writes them, a muxed array gets a row
+    # per mux value so the host never has to know about array patterns.
+    c_content = "/* This file is autogenerated from the script decodeCAN.py */\n#include \"canSignals.h\"\n\n"
+    signal_rows = ""
+    message_rows = ""
+    n_signals = 0
+    n_messages = 0
+
+    for pid in sorted(messages.keys()):
+        if pid not in msg_map:
+            continue
+        msg_name_clean = re.sub(r'[^a-zA-Z0-9_]', '', msg_map[pid]['name'])
+        base_name = msg_name_clean if msg_name_clean else f"Msg_{pid:X}"
+
+        # Same split as generate_c_code
+        checksum_sig = next((s for s in messages[pid] if s.get('is_checksum')), None)
+        standard_sigs = [s for s in messages[pid]
+                         if not s['is_mux_switch'] and s['mux_val'] is None and not s.get('is_checksum')]
+        mux_switch_sig = next((s for s in messages[pid] if s['is_mux_switch']), None)
+        muxed_sigs = sorted((s for s in messages[pid] if s['mux_val'] is not None), key=lambda s: s['mux_val'])
+
+        checksum_rule = 0
+        checksum_byte = 0
+        if checksum_sig and (checksum_sig.get('checksum_rule') == 1
+                             or (checksum_sig.get('checksum_rule') == 2 and checksum_sig['length'] == 16)):
+            checksum_rule = checksum_sig['checksum_rule']
+            checksum_byte = checksum_sig['start_bit'] // 8
+
+        first = n_signals
+        mux_switch = "CAN_SIGNAL_NO_MUX"
+        rows = [(s, "CAN_SIGNAL_NO_MUX") for s in standard_sigs]
+        if mux_switch_sig:
+            mux_switch = str(len([s for s in standard_sigs if not s['is_constant']]))
+            rows.append((mux_switch_sig, "CAN_SIGNAL_NO_MUX"))
+            rows += [(s, str(s['mux_val'])) for s in muxed_sigs]
+
+        signal_rows += f"    /* {base_name} (0x{pid:X}) */\n"
+        for sig, mux in rows:
+            if sig['is_constant']:
+                continue # Ignored on receive
+            if sig.get('is_array'):
+                target = f"{sig['array_name']}[{sig['array_index']}]"
+            else:
+                target = sig['name']
+            big_endian = "TRUE" if sig['big_endian'] else "FALSE"
+            signal_rows += (f"    {{\"{target}\", {sig['start_bit']}, {sig['length']}, {big_endian}, "
+                            f"{SIGNAL_TYPES[sig['type']]}, {sig['gain']}f, {sig['offset']}f, {mux}, "
+                            f"CAN_SIGNAL_FW({target})}},\n")
+            n_signals += 1
+
+        message_rows += (f"    {{0x{pid:X}, \"{base_name}\", {first}, {n_signals - first}, {mux_switch}, "
+                         f"{checksum_rule}, {checksum_byte}, CAN_SIGNAL_RX({base_name}Rx)}},\n")
+        n_messages += 1
+
+    c_content += "const stCANSignal_t astCANSignals[] = {\n" + signal_rows + "};\n\n"
+    c_content += "const stCANMessage_t astCANMessages[] = {\n" + message_rows + "};\n\n"
+    c_content += f"const word wNCANSignals = {n_signals};\n"
+    c_content += f"const word wNCANMessages = {n_messages};\n"
+
+    with open(OUTPUT_SIGNALS_PATH, 'w') as f:
+        f.write(c_content)
+
+    print(f"Generated {n_signals} signals of {n_messages} messages in {OUTPUT_SIGNALS_PATH}")
+
 def generate_signal_decode(sig, indent="    "):
     if sig['is_constant']:
         return f"{indent}/* Constant {sig['name']} ignored on receive */\n"
@@ -0,0 +1,181 @@
+import os
+import re
+import struct
+import argparse
+import sdlog
+
+###
+# SFR ESP-NOW Telemetry Packing
+# Packs a bus mix into 250 byte ESP-NOW packets with the old fixed 3 byte header and with the
+# sequenced packets from main/espnowtelem.h and the variable length frame header from
+# main/espnow.h, and prints frames per packet for each.
+#
+# The bus mix is either an SD card binary log (--log) or one period of every message in
+# main/CAN/canDecodeAuto.h at its PERIOD_MS rate.
+#
+# Old:      [ID15..ID8], [ID7..ID0], [DLC], Data...     (ID truncated to 16 bits, DLC 0 rejected)
+# New:      [0xF2, Node, Seq1, Seq0, Base3..Base0], then for each frame
+#   std:    [0 | DLC | ID10..ID8], [ID7..ID0], Delta..., Data...
+#   ext:    [1 | DLC | 000], [ID28..ID24], [ID23..ID16], [ID15..ID8], [ID7..ID0], Delta..., Data...
+#           Delta is the us since the previous frame, 7 bits a byte with the top bit set if more follow
+#   delta:  DLC 0xF, then [Mask], XOR... in place of the data, see main/espnowcodec.h. Only decoded
+#           here, the data is None as it needs the last frame of the ID.
+#
+
+# -----------------------------------------------------------------------------
+# Configuration
+# -----------------------------------------------------------------------------
+MAX_ESPNOW_PAYLOAD = 250
+ESPNOW_FRAME_EXTENDED = 0x80
+ESPNOW_FRAME_DLC_SHIFT = 3
+ESPNOW_TELEM_PACKET = 0xF2
+ESPNOW_TELEM_HEADER_SIZE = 8
+ESPNOW_FRAME_DLC_DELTA = 0x0F
+MAX_STD_ID = 0x7FF
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+DECODE_H_PATH = os.path.join(SCRIPT_DIR, '..', 'main', 'CAN', 'canDecodeAuto.h')
+
+# -----------------------------------------------------------------------------
+# Formats
+# -----------------------------------------------------------------------------
+def varint(value):
+    out = bytearray()
+    while True:
+        out.append((value & 0x7F) | (0x80 if value >= 0x80 else 0))
+        value >>= 7
+        if not value:
+            return bytes(out)
+
+def encode_old(can_id, data, delta):
+    if len(data) < 1:
+        return None
+    return bytes([(can_id >> 8) & 0xFF, can_id & 0xFF, len(data)]) + data
+
+def encode_new(can_id, data, delta):
+    dlc = len(data) << ESPNOW_FRAME_DLC_SHIFT
+    if can_id > MAX_STD_ID:
+        header = bytes([ESPNOW_FRAME_EXTENDED | dlc]) + struct.pack('>I', can_id & 0x1FFFFFFF)
+    else:
+        header = bytes([dlc | ((can_id >> 8) & 0x07), can_id & 0xFF])
+    return header + varint(delta) + data
+
+def header_new(seq, base):
+    return bytes([ESPNOW_TELEM_PACKET, 0x11]) + struct.pack('>HI', seq & 0xFFFF, base & 0xFFFFFFFF)
+
+def decode_new(packet):
+    """Mirror of ESPNOW_fill_buffer, returns a list of (id, data, time)."""
+    frames = []
+    offset = ESPNOW_TELEM_HEADER_SIZE
+    time_us = struct.unpack('>I', packet[4:8])[0]
+    while offset < len(packet):
+        extended = packet[offset] & ESPNOW_FRAME_EXTENDED
+        header = 5 if extended else 2
+        if len(packet) - offset < header:
+            break
+        dlc = (packet[offset] >> ESPNOW_FRAME_DLC_SHIFT) & 0x0F
+        if extended:
+            can_id = struct.unpack('>I', packet[offset + 1:offset + 5])[0] & 0x1FFFFFFF
+        else:
+            can_id = ((packet[offset] & 0x07) << 8) | packet[offset + 1]
+        offset += header
+        delta, shift = 0, 0
+        while offset < len(packet):
+            delta |= (packet[offset] & 0x7F) << shift
+            shift += 7
+            offset += 1
+            if not packet[offset - 1] & 0x80:
+                break
+        time_us = (time_us + delta) & 0xFFFFFFFF
+        if dlc == ESPNOW_FRAME_DLC_DELTA and offset < len(packet):
+            changed = bin(packet[offset]).count('1')
+            offset += 1 + changed
+            frames.append((can_id, None, time_us))
+            continue
+        if dlc > 8 or len(packet) - offset < dlc:
+            break
+        frames.append((can_id, packet[offset:offset + dlc], time_us))
+        offset += dlc
+    return frames
+
+def pack(frames, encode, header=None):
+    """Greedy packing like ESPNOW_empty_buffer, returns (packets, frames dropped)."""
+    packets = []
+    packet = bytearray()
+    dropped = 0
+    previous = None
+    for can_id, data, time_us in frames:
+        delta = 0 if previous is None else time_us - previous
+        encoded = encode(can_id, data, delta)
+        if encoded is None:
+            dropped += 1
+            continue
+        if packet and len(packet) + len(encoded) > MAX_ESPNOW_PAYLOAD:
+            packets.append(bytes(packet))
+            packet = bytearray()
+        if not packet and header is not None:
+            # A new packet restarts the deltas from its base time
+            packet += header(len(packets), time_us)
+            encoded = encode(can_id, data, 0)
+        packet += encoded
+        previous = time_us
+    if packet:
+        packets.append(bytes(packet))
+    return packets, dropped
+
+# -----------------------------------------------------------------------------
+# Bus mixes
+# -----------------------------------------------------------------------------
+def mix_from_log(path):
+    return sdlog.read(path)[0]
+
+def mix_from_header(path, seconds):
+    """Every message at its PERIOD_MS rate for the given time, all DLC 8 like the Tx functions."""
+    with open(path) as f:
+        text = f.read()
+    ids = dict(re.findall(r'#define (\w+)_ID (0x[0-9A-Fa-f]+)', text))
+    periods = dict(re.findall(r'#define (\w+)_PERIOD_MS (\d+)', text))
+    events = []
+    for name, can_id in ids.items():
+        period = int(periods.get(name, 0))
+        if period <= 0:
+            continue
+        for t in range(0, int(seconds * 1000), period):
+            events.append((t, int(can_id, 16)))
+    events.sort()
+    return [(can_id, bytes(8), t * 1000) for t, can_id in events]
+
+# -----------------------------------------------------------------------------
+# Main Execution
+# -----------------------------------------------------------------------------
+def report(name, frames, packets, dropped, truncated):
+    sent = len(frames) - dropped
+    print(f"{name:<5} packets {len(packets):6d}  frames/packet {sent / max(len(packets), 1):6.2f}  "
+          f"dropped {dropped}  IDs truncated {truncated}")
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare ESP-NOW telemetry packing formats")
+    parser.add_argument('--log', help="SD card binary log to take the bus mix from")
+    parser.add_argument('--seconds', type=float, default=10.0, help="Length of the canDecodeAuto.h mix")
+    args = parser.parse_args()
+
+    if args.log:
+        frames = mix_from_log(args.log)
+        print(f"Bus mix: {len(frames)} frames from {args.log}")
+    else:
+        frames = mix_from_header(DECODE_H_PATH, args.seconds)
+        print(f"Bus mix: {len(frames)} frames, {args.seconds:g}s of canDecodeAuto.h")
+
+    old_packets, old_dropped = pack(frames, encode_old)
+    new_packets, new_dropped = pack(frames, encode_new, header_new)
+    decoded = [frame for packet in new_packets for frame in decode_new(packet)]
+    if decoded != [(can_id & 0x1FFFFFFF, data, time_us & 0xFFFFFFFF) for can_id, data, time_us in frames]:
+        raise SystemExit("Decoded frames do not match the bus mix")
+
+    extended = sum(1 for can_id, data, _ in frames if can_id > 0xFFFF and len(data) > 0)
+    report("Old", frames, old_packets, old_dropped, extended)
+    report("New", frames, new_packets, new_dropped, 0)
+    print(f"Packets saved: {100 * (1 - len(new_packets) / max(len(old_packets), 1)):.1f}%")
+
+if __name__ == "__main__":
+    main()
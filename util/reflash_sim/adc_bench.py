@@ -0,0 +1,241 @@
+import os
+import sys
+import ctypes
+import argparse
+import tempfile
+import subprocess
+
+###
+# SFR ADC Benchmark
+# Runs main/adc.c's continuous sampling on the PC. sim_adc.c stands in for the ADC's DMA, making
+# 12 bit samples of a set signal in the configured pattern's order and handing them to the
+# conversion done callback a frame at a time, and for the calibration with a fixed bent curve.
+#
+# One channel is added for each entry in CONFIGS, all sampling the same signal, and the library is
+# driven through four phases:
+#    - Steady: a level with --noise counts of gaussian noise. Each channel's raw and filtered
+#      standard deviation from adc_get_noise, the before and after adc_report logs.
+#    - Spikes: no noise and a --spike count spike every SPIKE_EVERY samples. The most the filtered
+#      value strays from the level once the filter has settled.
+#    - Step: LEVEL_LOW to LEVEL_HIGH. The 10 to 90 % rise time, the lag a consumer sees.
+#    - Volts: adc_read_voltage, a lookup in the curve adc.c builds, against the calibration of the
+#      filtered count, at levels across the range.
+# Last --samples are given to the callback in ADC_FRAME_SAMPLES frames and timed, the PC's ns per
+# sample and per frame and what that would be per ms at --rate, and the cost of a read.
+#
+# The C6's own figures, cycles per ms in the callback against cycles per oneshot read from the 1 ms
+# task, are logged by adc_report on the car. The PC can't tell how long a oneshot conversion takes.
+#
+# Examples:
+#    python adc_bench.py
+#    python adc_bench.py --noise 8 --spike 1500 --samples 10000000
+#
+
+# -----------------------------------------------------------------------------
+# Configuration
+# -----------------------------------------------------------------------------
+SIM_DIR = os.path.dirname(os.path.abspath(__file__))
+MAIN_DIR = os.path.abspath(os.path.join(SIM_DIR, '..', '..', 'main'))
+CC = os.environ.get('CC', 'gcc')
+
+FILTER_NONE = 0                 # eADCFilter_t
+FILTER_IIR = 1
+FILTER_MEDIAN = 2
+FILTER_NAMES = {FILTER_NONE: 'none', FILTER_IIR: 'IIR', FILTER_MEDIAN: 'median'}
+CONFIGS = [                     # Oversample shift, filter, IIR shift
+    (0, FILTER_NONE, 0),        # What a oneshot read sees
+    (3, FILTER_NONE, 0),
+    (0, FILTER_IIR, 3),
+    (0, FILTER_MEDIAN, 0),
+    (3, FILTER_MEDIAN, 0),
+    (2, FILTER_IIR, 2),
+    (4, FILTER_IIR, 3),
+]
+FRACTION = 16                   # 1 << ADC_FRACTION_BITS
+FRAME_SAMPLES = 64              # ADC_FRAME_SAMPLES
+LEVEL = 2000
+LEVEL_LOW = 1000
+LEVEL_HIGH = 3000
+SPIKE_EVERY = 50
+SETTLE_S = 0.05
+VOLT_LEVELS = [3, 200, 1000, 2047, 2500, 3333, 4000, 4094]
+VOLT_TOLERANCE_MV = 1.0
+
+# -----------------------------------------------------------------------------
+# Build
+# -----------------------------------------------------------------------------
+def build(work_dir):
+    """Compiles sim_adc.c with main/adc.c into a shared library."""
+    lib = os.path.join(work_dir, 'sim_adc.so')
+    cmd = [CC, '-shared', '-fPIC', '-O2', '-Wall', '-Wextra', '-DDEVICE_ID=0x11',
+           '-I', os.path.join(SIM_DIR, 'stubs'), '-I', MAIN_DIR, '-I', os.path.join(MAIN_DIR, 'CAN'),
+           '-o', lib, os.path.join(SIM_DIR, 'sim_adc.c'), os.path.join(MAIN_DIR, 'adc.c'),
+           '-lm', '-Wl,--no-undefined']
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    if result.returncode != 0:
+        print(result.stderr)
+        raise RuntimeError("Failed to build sim_adc.so")
+    for line in result.stderr.splitlines():
+        if 'warning:' in line:
+            print(line)
+    return lib
+
+def load(path, seed, verbose):
+    lib = ctypes.CDLL(path)
+    lib.sim_adc_reset.argtypes = [ctypes.c_ulong, ctypes.c_int]
+    lib.sim_adc_add.argtypes = [ctypes.c_ubyte, ctypes.c_ubyte, ctypes.c_int, ctypes.c_ubyte]
+    lib.sim_adc_start.argtypes = [ctypes.c_ulong]
+    lib.sim_adc_signal.argtypes = [ctypes.c_float, ctypes.c_float, ctypes.c_ulong, ctypes.c_float]
+    lib.sim_adc_run.argtypes = [ctypes.c_ulong, ctypes.c_ulong, ctypes.POINTER(ctypes.c_ulong), ctypes.c_ulong]
+    lib.sim_adc_run.restype = ctypes.c_uint64
+    lib.sim_adc_filtered.argtypes = [ctypes.c_ubyte]
+    lib.sim_adc_filtered.restype = ctypes.c_ulong
+    lib.sim_adc_volts.argtypes = [ctypes.c_ubyte]
+    lib.sim_adc_volts.restype = ctypes.c_float
+    lib.sim_adc_read_ns.argtypes = [ctypes.c_ubyte, ctypes.c_ulong]
+    lib.sim_adc_read_ns.restype = ctypes.c_uint64
+    lib.sim_adc_cali_mV.argtypes = [ctypes.c_int]
+    lib.sim_adc_noise.argtypes = [ctypes.c_ubyte, ctypes.POINTER(ctypes.c_float)]
+    lib.sim_adc_stats.argtypes = [ctypes.POINTER(ctypes.c_ulong), ctypes.POINTER(ctypes.c_ulong),
+                                  ctypes.POINTER(ctypes.c_uint64)]
+    lib.adc_report.restype = None
+    lib.sim_adc_reset(seed, 1 if verbose else 0)
+    for channel, (shift, filt, iir) in enumerate(CONFIGS):
+        if lib.sim_adc_add(channel, shift, filt, iir) != 0:
+            raise RuntimeError(f"adc_continuous_add failed for channel {channel}")
+    return lib
+
+# -----------------------------------------------------------------------------
+# Phases
+# -----------------------------------------------------------------------------
+def noise(lib, channel):
+    out = (ctypes.c_float * 5)()
+    lib.sim_adc_noise(channel, out)
+    return {'n_raw': int(out[0]), 'n_filtered': int(out[1]), 'raw': out[2], 'filtered': out[3], 'mean': out[4]}
+
+def trace(lib, n_samples):
+    """Runs a pattern round per callback and gives each channel's filtered counts after each."""
+    n = len(CONFIGS)
+    rounds = n_samples // n
+    values = (ctypes.c_ulong * (rounds * n))()
+    lib.sim_adc_run(rounds * n, n, values, rounds * n)
+    return [[values[r * n + channel] / FRACTION for r in range(rounds)] for channel in range(n)]
+
+def run_steady(args, lib):
+    n = len(CONFIGS)
+    lib.sim_adc_signal(LEVEL, args.noise, 0, 0)
+    lib.sim_adc_run(int(args.rate * SETTLE_S), FRAME_SAMPLES, None, 0)
+    for channel in range(n):
+        noise(lib, channel)
+    lib.sim_adc_run(int(args.rate * args.seconds), FRAME_SAMPLES, None, 0)
+    return [noise(lib, channel) for channel in range(n)]
+
+def run_spikes(args, lib):
+    lib.sim_adc_signal(LEVEL, 0, SPIKE_EVERY, args.spike)
+    settle = int(args.rate * SETTLE_S)
+    lib.sim_adc_run(settle, FRAME_SAMPLES, None, 0)
+    values = trace(lib, int(args.rate * args.seconds))
+    return [max(abs(v - LEVEL) for v in channel) for channel in values]
+
+def run_step(args, lib):
+    lib.sim_adc_signal(LEVEL_LOW, 0, 0, 0)
+    lib.sim_adc_run(int(args.rate * SETTLE_S), FRAME_SAMPLES, None, 0)
+    lib.sim_adc_signal(LEVEL_HIGH, 0, 0, 0)
+    values = trace(lib, int(args.rate * SETTLE_S * 4))
+    round_ms = 1000.0 * len(CONFIGS) / args.rate
+    rise = []
+    for channel in values:
+        low = next((r for r, v in enumerate(channel) if v >= LEVEL_LOW + 0.1 * (LEVEL_HIGH - LEVEL_LOW)), None)
+        high = next((r for r, v in enumerate(channel) if v >= LEVEL_LOW + 0.9 * (LEVEL_HIGH - LEVEL_LOW)), None)
+        rise.append(None if low is None or high is None else ((high - low) * round_ms, (high + 1) * round_ms))
+    return rise
+
+def run_volts(args, lib):
+    """Worst mV between adc_read_voltage and the calibration of the same filtered count."""
+    worst = 0.0
+    for level in VOLT_LEVELS:
+        lib.sim_adc_signal(level + 0.37, 0, 0, 0)
+        lib.sim_adc_run(int(args.rate * SETTLE_S), FRAME_SAMPLES, None, 0)
+        for channel in range(len(CONFIGS)):
+            counts = lib.sim_adc_filtered(channel) / FRACTION
+            below = min(int(counts), 4094)
+            exact = lib.sim_adc_cali_mV(below) + (counts - below) * (lib.sim_adc_cali_mV(below + 1) - lib.sim_adc_cali_mV(below))
+            worst = max(worst, abs(lib.sim_adc_volts(channel) * 1000.0 - exact))
+    return worst
+
+def run_speed(args, lib):
+    lib.sim_adc_signal(LEVEL, args.noise, SPIKE_EVERY, args.spike)
+    samples, unknown, cycles = ctypes.c_ulong(), ctypes.c_ulong(), ctypes.c_uint64()
+    lib.sim_adc_stats(ctypes.byref(samples), ctypes.byref(unknown), ctypes.byref(cycles))
+    before = samples.value
+    ns = lib.sim_adc_run(args.samples, FRAME_SAMPLES, None, 0)
+    lib.sim_adc_stats(ctypes.byref(samples), ctypes.byref(unknown), ctypes.byref(cycles))
+    reads = 1000000
+    return {'samples': args.samples, 'counted': samples.value - before, 'unknown': unknown.value, 'ns': ns,
+            'read_ns': lib.sim_adc_read_ns(0, reads) / reads}
+
+# -----------------------------------------------------------------------------
+# Main Execution
+# -----------------------------------------------------------------------------
+def config_name(config):
+    shift, filt, iir = config
+    return f"x{1 << shift:<3} {FILTER_NAMES[filt]}{f' 1/{1 << iir}' if filt == FILTER_IIR else ''}"
+
+def report(args, steady, spikes, step, volts, speed):
+    per_channel = args.rate / len(CONFIGS)
+    print(f"=== {len(CONFIGS)} channels at {args.rate} samples/s, {per_channel:.0f} each, "
+          f"{args.noise} counts noise, {args.spike} count spikes every {SPIKE_EVERY} ===")
+    print(f"{'Channel':<8}{'Config':<15}{'Raw std':>9}{'Filt std':>10}{'Gain':>7}{'Mean err':>10}"
+          f"{'Spike':>8}{'Rise ms':>9}{'Settle ms':>11}")
+    passed = True
+    for channel, config in enumerate(CONFIGS):
+        raw, filt = steady[channel]['raw'], steady[channel]['filtered']
+        gain = raw / filt if filt > 0 else float('inf')
+        rise = step[channel]
+        print(f"{channel:<8}{config_name(config):<15}{raw:9.2f}{filt:10.2f}{gain:7.1f}"
+              f"{steady[channel]['mean'] - LEVEL:10.2f}{spikes[channel]:8.1f}"
+              f"{rise[0] if rise else float('nan'):9.2f}{rise[1] if rise else float('nan'):11.2f}")
+        if rise is None or abs(steady[channel]['mean'] - LEVEL) > 0.5:
+            passed = False
+        if config != (0, FILTER_NONE, 0) and gain < 1.5:
+            passed = False
+        if config[1] == FILTER_MEDIAN and spikes[channel] > 2 * args.noise + 1:
+            passed = False
+    print(f"\nVolts vs calibration: {volts:.3f} mV worst")
+    passed = passed and volts <= VOLT_TOLERANCE_MV
+    print(f"Samples:              {speed['counted']} of {speed['samples']} counted, {speed['unknown']} unknown")
+    passed = passed and speed['counted'] == speed['samples'] and speed['unknown'] == 0
+    ns_sample = speed['ns'] / speed['samples']
+    print(f"Callback, PC:         {ns_sample:.1f} ns/sample, {ns_sample * FRAME_SAMPLES / 1000:.2f} us/frame, "
+          f"{ns_sample * args.rate / 1e6:.2f} us/ms at {args.rate} samples/s")
+    print(f"adc_read_voltage, PC: {speed['read_ns']:.1f} ns, no conversion or calibration call")
+    return passed
+
+def main():
+    parser = argparse.ArgumentParser(description="Run adc.c's continuous sampling on the PC")
+    parser.add_argument('--rate', type=int, default=20000, help="Samples/s across every channel (default 20000)")
+    parser.add_argument('--seconds', type=float, default=2.0, help="Of the steady and spike phases")
+    parser.add_argument('--noise', type=float, default=4.0, help="Gaussian noise std, counts (default 4)")
+    parser.add_argument('--spike', type=float, default=800.0, help="Spike size, counts (default 800)")
+    parser.add_argument('--samples', type=int, default=4000000, help="Timed (default 4000000)")
+    parser.add_argument('--seed', type=int, default=1)
+    parser.add_argument('--verbose', action='store_true', help="Show adc_report's log")
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        lib = load(build(work_dir), args.seed, args.verbose)
+        if lib.sim_adc_start(args.rate) != 0:
+            raise RuntimeError("adc_continuous_init failed")
+        steady = run_steady(args, lib)
+        spikes = run_spikes(args, lib)
+        step = run_step(args, lib)
+        volts = run_volts(args, lib)
+        speed = run_speed(args, lib)
+        if args.verbose:
+            lib.adc_report()
+        passed = report(args, steady, spikes, step, volts, speed)
+    print(f"\n{'PASS' if passed else 'FAIL'}")
+    return 0 if passed else 1
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,289 @@
+import os
+import sys
+import math
+import random
+import shutil
+import ctypes
+import argparse
+import tempfile
+import subprocess
+
+###
+# SFR APPS Plausibility Benchmark
+# Runs main/apps.c's checks on the PC in virtual time against synthetic pedal traces. sim_apps.c
+# moves time a millisecond per APPS_task_1ms and feeds the pedal's volts through sim_adc.c's DMA,
+# adc.c's oversampling and median filter and the sensor maps, as on the car. Every frame sent is
+# logged, so throttle, kill and status are checked from what went on the bus.
+#
+# Each scenario runs from its own copy of the library so starts from APPS_init:
+#    - Driving: a smooth random pedal with ADC noise. No fault, SetRelCurrent every millisecond
+#      following the pedal, StatusAPPSSensor every 100 ms.
+#    - Step: pedal 0 to 100 % and back, the time from the pedal moving to SetRelCurrent passing
+#      90 % of the way, the sensor to CAN latency.
+#    - Faults: drift over the limit, either sensor open or shorted. A kill with the right source
+#      more than 100 ms after the fault starts and within --kill-bound ms, the throttle at 0 from
+#      then, and the fault only clearing once the pedal is released.
+#    - Not faults: drift under the limit, over it for 90 ms, a sensor dropping out 50 ms in every
+#      100. No kill.
+#    - Jitter: the drift fault again with every call up to --jitter us late.
+# Kill times are from the pedal, so include the ADC's filter and frame, the firmware's own figure
+# from APPS_get_stats is from its first implausible read. The task's own time is not modelled,
+# APPS_report gives it on the car.
+#
+# Examples:
+#    python apps_bench.py
+#    python apps_bench.py --jitter 900 --noise 6
+#
+
+# -----------------------------------------------------------------------------
+# Configuration
+# -----------------------------------------------------------------------------
+SIM_DIR = os.path.dirname(os.path.abspath(__file__))
+MAIN_DIR = os.path.abspath(os.path.join(SIM_DIR, '..', '..', 'main'))
+CC = os.environ.get('CC', 'gcc')
+
+APPS1_REST, APPS1_FULL = 0.40, 2.80         # APPS1_V_*
+APPS2_REST, APPS2_FULL = 2.60, 0.60         # APPS2_V_*
+OPEN_V, SHORT_V = 0.0, 3.3
+WINDOW_MS = 100                             # APPS_IMPLAUSIBLE_US
+KILL_MSG_ID, STATUS_ID, SETRELCURRENT_ID = 0x001, 0x81, 0xA4
+KILL_NONE, KILL_INVERTER = 0, 1
+SOURCE_DRIFT, SOURCE_APPS_1, SOURCE_APPS_2 = 8, 9, 10
+SETTLE_MS = 200
+
+class Frame(ctypes.Structure):
+    _fields_ = [('qwtus', ctypes.c_uint64), ('dwID', ctypes.c_ulong), ('byDLC', ctypes.c_ubyte),
+                ('abData', ctypes.c_ubyte * 8)]
+
+class Stats(ctypes.Structure):
+    _fields_ = [('dwNCycles', ctypes.c_ulong), ('dwNLate', ctypes.c_ulong), ('dwNTxErrors', ctypes.c_ulong),
+                ('qwNLatencyus', ctypes.c_uint64), ('dwLatencyMaxus', ctypes.c_ulong), ('dwNFaults', ctypes.c_ulong),
+                ('dwKillLatencyus', ctypes.c_ulong), ('dwKillLatencyMaxus', ctypes.c_ulong)]
+
+# -----------------------------------------------------------------------------
+# Build
+# -----------------------------------------------------------------------------
+def build(work_dir):
+    """Compiles sim_apps.c with the firmware into a shared library."""
+    lib = os.path.join(work_dir, 'sim_apps.so')
+    cmd = [CC, '-shared', '-fPIC', '-O2', '-Wall', '-Wextra', '-DDEVICE_ID=0x16',
+           '-I', os.path.join(SIM_DIR, 'stubs'), '-I', MAIN_DIR, '-I', os.path.join(MAIN_DIR, 'CAN'),
+           '-o', lib, os.path.join(SIM_DIR, 'sim_apps.c'), os.path.join(SIM_DIR, 'sim_adc.c'),
+           os.path.join(MAIN_DIR, 'apps.c'), os.path.join(MAIN_DIR, 'adc.c'),
+           os.path.join(MAIN_DIR, 'CAN', 'canDecodeAuto.c'), '-lm', '-Wl,--no-undefined']
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    if result.returncode != 0:
+        print(result.stderr)
+        raise RuntimeError("Failed to build sim_apps.so")
+    for line in result.stderr.splitlines():
+        if 'warning:' in line:
+            print(line)
+    return lib
+
+class Sim:
+    """A fresh copy of the library, apps.c and adc.c keep their state as long as it is loaded."""
+    count = 0
+
+    def __init__(self, path, work_dir, args):
+        Sim.count += 1
+        copy = os.path.join(work_dir, f'apps_{Sim.count}.so')
+        shutil.copy(path, copy)
+        self.lib = ctypes.CDLL(copy)
+        self.lib.sim_adc_reset(ctypes.c_ulong(args.seed + Sim.count), 1 if args.verbose else 0)
+        self.lib.sim_adc_signal.argtypes = [ctypes.c_float, ctypes.c_float, ctypes.c_ulong, ctypes.c_float]
+        self.lib.sim_adc_signal(0.0, args.noise, 0, 0.0)
+        self.lib.sim_apps_run.argtypes = [ctypes.POINTER(ctypes.c_float), ctypes.POINTER(ctypes.c_float), ctypes.c_ulong]
+        self.lib.sim_apps_run.restype = ctypes.c_uint64
+        self.lib.sim_apps_log.argtypes = [ctypes.POINTER(ctypes.c_ulong)]
+        self.lib.sim_apps_log.restype = ctypes.POINTER(Frame)
+        self.lib.sim_apps_jitter.argtypes = [ctypes.c_ulong]
+        if self.lib.sim_apps_init() != 0:
+            raise RuntimeError("sim_apps_init failed")
+        self.t_ms = 0
+
+    def run(self, v1, v2):
+        """Runs volts a millisecond each, returns the time in us the run started at."""
+        start = self.t_ms * 1000
+        n = len(v1)
+        self.lib.sim_apps_run((ctypes.c_float * n)(*v1), (ctypes.c_float * n)(*v2), n)
+        self.t_ms += n
+        return start
+
+    def frames(self):
+        n = ctypes.c_ulong()
+        log = self.lib.sim_apps_log(ctypes.byref(n))
+        return [(log[i].qwtus, log[i].dwID, bytes(log[i].abData[:log[i].byDLC])) for i in range(n.value)]
+
+    def stats(self):
+        out = Stats()
+        self.lib.APPS_get_stats(ctypes.byref(out))
+        return out
+
+# -----------------------------------------------------------------------------
+# Traces
+# -----------------------------------------------------------------------------
+def volts(pedal, offset2=0.0):
+    """Both sensors for pedal %, APPS2 offset2 % of travel further on."""
+    v1 = [APPS1_REST + (APPS1_FULL - APPS1_REST) * p / 100.0 for p in pedal]
+    v2 = [APPS2_REST + (APPS2_FULL - APPS2_REST) * (p + offset2) / 100.0 for p in pedal]
+    return v1, v2
+
+def hold(pedal, ms):
+    return [pedal] * ms
+
+def driving(ms, seed):
+    """Smooth random pedal, a few sines, clipped to 0 to 100 %."""
+    rng = random.Random(seed)
+    waves = [(rng.uniform(0.1, 2.0), rng.uniform(0, 2 * math.pi), rng.uniform(10, 40)) for _ in range(4)]
+    return [min(100.0, max(0.0, 50.0 + sum(a * math.sin(2 * math.pi * f * t / 1000.0 + p) for f, p, a in waves)))
+            for t in range(ms)]
+
+def throttle(frames, after_us=0):
+    return [(t, ((d[0] << 8) | d[1]) * 0.1) for t, i, d in frames if i == SETRELCURRENT_ID and t >= after_us]
+
+def kills(frames, after_us=0):
+    return [(t, d[0], d[1]) for t, i, d in frames if i == KILL_MSG_ID and t >= after_us]
+
+# -----------------------------------------------------------------------------
+# Scenarios
+# -----------------------------------------------------------------------------
+def run_driving(sim, args):
+    pedal = driving(args.seconds * 1000, args.seed)
+    sim.run(*volts(hold(0.0, SETTLE_MS)))
+    start = sim.run(*volts(pedal))
+    frames = sim.frames()
+    values = throttle(frames, start + 1000)
+    lag = args.lag_ms
+    errors = [abs(v - pedal[t // 1000 - start // 1000 - 1 - lag]) for t, v in values
+              if t // 1000 - start // 1000 - 1 - lag >= 0]
+    status = [t for t, i, _ in frames if i == STATUS_ID and t > start]
+    return {'name': 'Driving', 'kills': len(kills(frames)), 'n_throttle': len(values), 'ms': len(pedal),
+            'mean_error': sum(errors) / len(errors), 'max_error': max(errors), 'n_status': len(status),
+            'passed': (len(kills(frames)) == 0 and len(values) == len(pedal) and sum(errors) / len(errors) < 1.0 and
+                       abs(len(status) - len(pedal) / 100) <= 1)}
+
+def first(values, test):
+    return next((t for t, v in values if test(v)), None)
+
+def run_step(sim, args):
+    sim.run(*volts(hold(0.0, SETTLE_MS)))
+    up = sim.run(*volts(hold(100.0, SETTLE_MS)))
+    down = sim.run(*volts(hold(0.0, SETTLE_MS)))
+    values = throttle(sim.frames())
+    t_up = first([x for x in values if x[0] >= up], lambda v: v >= 90.0)
+    t_down = first([x for x in values if x[0] >= down], lambda v: v <= 10.0)
+    return {'name': 'Step', 'up_ms': (t_up - up) / 1000.0, 'down_ms': (t_down - down) / 1000.0,
+            'passed': t_up is not None and t_down is not None and (t_up - up) / 1000.0 <= args.step_bound and
+                      (t_down - down) / 1000.0 <= args.step_bound}
+
+def run_fault(sim, args, name, source, v1, v2, pedal=50.0):
+    """Pedal at 50 %, the fault for a second, then clear at 50 %, release, press to 30 %."""
+    sim.run(*volts(hold(pedal, SETTLE_MS)))
+    fault = sim.run(v1, v2)
+    cleared = sim.run(*volts(hold(pedal, 300)))
+    released = sim.run(*volts(hold(0.0, 100)))
+    again = sim.run(*volts(hold(30.0, 100)))
+    frames = sim.frames()
+    kill_list = kills(frames, fault)
+    on = [k for k in kill_list if k[1] == KILL_INVERTER]
+    off = [k for k in kill_list if k[1] == KILL_NONE]
+    result = {'name': name, 'kill_ms': None, 'source': None, 'repeats': len(on), 'held': False, 'cleared': False,
+              'firmware_ms': sim.stats().dwKillLatencyus / 1000.0}
+    if on:
+        t_kill = on[0][0]
+        result['kill_ms'] = (t_kill - fault) / 1000.0
+        result['source'] = on[0][2]
+        values = throttle(frames)
+        result['held'] = all(v == 0.0 for t, v in values if t_kill <= t < released)
+        result['cleared'] = (len(off) == 1 and released <= off[0][0] < again and off[0][2] == source and
+                             all(k[0] < cleared + 300000 for k in on))
+        result['again'] = values[-1][1]
+    result['passed'] = (result['source'] == source and result['kill_ms'] is not None and
+                        WINDOW_MS < result['kill_ms'] <= args.kill_bound and result['held'] and result['cleared'] and
+                        abs(result.get('again', 0.0) - 30.0) < 1.0)
+    return result
+
+def run_no_fault(sim, args, name, v1, v2):
+    sim.run(*volts(hold(50.0, SETTLE_MS)))
+    sim.run(v1, v2)
+    sim.run(*volts(hold(50.0, SETTLE_MS)))
+    frames = sim.frames()
+    return {'name': name, 'kills': len(kills(frames)), 'min_throttle': min(v for _, v in throttle(frames, SETTLE_MS * 1000)),
+            'passed': len(kills(frames)) == 0}
+
+def faults(args):
+    pedal = hold(50.0, 1000)
+    drift = volts(pedal, 15.0)
+    v1, v2 = volts(pedal)
+    return [('Drift 15 %', SOURCE_DRIFT, drift[0], drift[1]),
+            ('APPS1 open', SOURCE_APPS_1, [OPEN_V] * 1000, v2),
+            ('APPS1 shorted', SOURCE_APPS_1, [SHORT_V] * 1000, v2),
+            ('APPS2 open', SOURCE_APPS_2, v1, [OPEN_V] * 1000),
+            ('APPS2 shorted', SOURCE_APPS_2, v1, [SHORT_V] * 1000)]
+
+def no_faults(args):
+    pedal = hold(50.0, 1000)
+    under = volts(pedal, 8.0)
+    brief = volts(hold(50.0, 90), 15.0)
+    v1, v2 = volts(pedal)
+    dropout = [OPEN_V if (t // 50) % 2 == 0 else v for t, v in enumerate(v1)]
+    return [('Drift 8 %', under[0], under[1]), ('Drift 15 % for 90 ms', brief[0], brief[1]),
+            ('APPS1 out 50 ms in 100', dropout, v2)]
+
+# -----------------------------------------------------------------------------
+# Main Execution
+# -----------------------------------------------------------------------------
+def main():
+    parser = argparse.ArgumentParser(description="Run apps.c's plausibility checks on the PC against pedal traces")
+    parser.add_argument('--seconds', type=int, default=10, help="Driving trace length (default 10)")
+    parser.add_argument('--noise', type=float, default=3.0, help="ADC noise, counts (default 3)")
+    parser.add_argument('--jitter', type=int, default=900, help="Jitter scenario, us late at most (default 900)")
+    parser.add_argument('--kill-bound', type=float, default=110.0, help="Fault to kill, ms at most (default 110)")
+    parser.add_argument('--step-bound', type=float, default=10.0, help="Step to 90 %%, ms at most (default 10)")
+    parser.add_argument('--lag-ms', type=int, default=3, help="Driving throttle compared to the pedal this long before")
+    parser.add_argument('--seed', type=int, default=1)
+    parser.add_argument('--verbose', action='store_true', help="Show apps.c's log")
+    args = parser.parse_args()
+
+    results = []
+    with tempfile.TemporaryDirectory() as work_dir:
+        path = build(work_dir)
+        results.append(run_driving(Sim(path, work_dir, args), args))
+        step = run_step(Sim(path, work_dir, args), args)
+        results.append(step)
+        for name, source, v1, v2 in faults(args):
+            results.append(run_fault(Sim(path, work_dir, args), args, name, source, v1, v2))
+        for name, v1, v2 in no_faults(args):
+            results.append(run_no_fault(Sim(path, work_dir, args), args, name, v1, v2))
+        sim = Sim(path, work_dir, args)
+        sim.lib.sim_apps_jitter(args.jitter)
+        name, source, v1, v2 = faults(args)[0]
+        results.append(run_fault(sim, args, f"{name}, {args.jitter} us jitter", source, v1, v2))
+        results[-1]['late'] = sim.stats().dwNLate
+
+    drive = results[0]
+    print(f"=== Driving, {drive['ms']} ms, {args.noise} counts noise ===")
+    print(f"SetRelCurrent:        {drive['n_throttle']} frames, error vs pedal {args.lag_ms} ms before "
+          f"{drive['mean_error']:.2f} % mean, {drive['max_error']:.2f} % max")
+    print(f"StatusAPPSSensor:     {drive['n_status']} frames, {drive['kills']} kills")
+    print(f"\n=== Step ===")
+    print(f"Pedal to CAN:         0 to 100 % in {step['up_ms']:.1f} ms, 100 to 0 % in {step['down_ms']:.1f} ms "
+          f"(90 % of the way)")
+    print(f"\n=== Faults, kill {WINDOW_MS} ms to {args.kill_bound:.0f} ms after ===")
+    print(f"{'Scenario':<32}{'Kill ms':>9}{'Firmware':>10}{'Source':>8}{'Repeats':>9}{'Held 0':>8}{'Cleared':>9}")
+    for r in results[2:7] + results[-1:]:
+        kill = f"{r['kill_ms']:.1f}" if r['kill_ms'] is not None else '-'
+        print(f"{r['name']:<32}{kill:>9}{r['firmware_ms']:10.1f}{str(r['source']):>8}{r['repeats']:>9}"
+              f"{str(r['held']):>8}{str(r['cleared']):>9}{'' if r['passed'] else '  FAIL'}")
+    print(f"Jitter run:           {results[-1]['late']} calls late")
+    print(f"\n=== Not faults ===")
+    for r in results[7:10]:
+        print(f"{r['name']:<32}{r['kills']} kills, throttle down to {r['min_throttle']:.1f} %"
+              f"{'' if r['passed'] else '  FAIL'}")
+
+    passed = all(r['passed'] for r in results)
+    print(f"\n{'PASS' if passed else 'FAIL'}")
+    return 0 if passed else 1
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,312 @@
+import os
+import sys
+import math
+import zlib
+import struct
+import random
+import shutil
+import ctypes
+import argparse
+import tempfile
+import subprocess
+
+###
+# SFR Calibration Table Benchmark
+# Runs main/calibration.c on the PC with tables made by util/CAN_calibrate.py. sim_calibration.c
+# keeps NVS as a directory so a later copy of the library loads what an earlier one stored, as at
+# a reboot, and keeps the last reply sent over CAN.
+#
+# Each scenario runs from its own copy of the library so starts with no tables:
+#    - Accuracy: tables of a pressure transducer, evenly spaced 101 points and again 98 where the
+#      breakpoints round off even, a thermistor unevenly spaced and a 2 point flow meter. The fixed
+#      point conversion against straight lines through the spreadsheet's points in double, within
+#      the 16 bit values' error, a value LSB and 0.15 mV of slope. Volts outside the limits must give
+#      SENSOR_INVALID.
+#    - Refusals: a flipped bit, an older version, falling breakpoints, the wrong size and magic are
+#      refused and leave the slot's table as it was.
+#    - CAN: a table sent as data frames to CAL_receive, seq 0 first then shuffled, taken by
+#      CAL_service with a reply, a frame lost gets no reply. Then a new library loads it from NVS.
+#    - Swap: a writer thread alternating two tables while batches are converted, --updates times,
+#      no batch may come out with some of each. A batch is only at risk when two updates land
+#      while it converts, as the first writes the table not in use, the retries are those caught.
+#
+# Examples:
+#    python calibration_bench.py
+#    python calibration_bench.py --updates 200000 --verbose
+#
+
+# -----------------------------------------------------------------------------
+# Configuration
+# -----------------------------------------------------------------------------
+SIM_DIR = os.path.dirname(os.path.abspath(__file__))
+MAIN_DIR = os.path.abspath(os.path.join(SIM_DIR, '..', '..', 'main'))
+UTIL_DIR = os.path.abspath(os.path.join(SIM_DIR, '..'))
+CC = os.environ.get('CC', 'gcc')
+sys.path.insert(0, UTIL_DIR)
+import CAN_calibrate as cal
+
+DEVICE_ID = 0x19                # Dyno
+SENSOR_INVALID = -999.0
+OK, BAD_CRC, BAD_TABLE, OLD_VERSION, NVS_ERROR = range(5)
+BETA, R25, PULLUP, VREF = 3950.0, 10000.0, 10000.0, 5.0
+
+class Stats(ctypes.Structure):
+    _fields_ = [('dwNConversions', ctypes.c_ulong), ('dwNRetries', ctypes.c_ulong), ('dwNUpdates', ctypes.c_ulong),
+                ('dwNRejected', ctypes.c_ulong), ('dwNChunks', ctypes.c_ulong)]
+
+# -----------------------------------------------------------------------------
+# Build
+# -----------------------------------------------------------------------------
+def build(work_dir):
+    """Compiles sim_calibration.c with the firmware into a shared library."""
+    lib = os.path.join(work_dir, 'sim_calibration.so')
+    cmd = [CC, '-shared', '-fPIC', '-O2', '-Wall', '-Wextra', f'-DDEVICE_ID=0x{DEVICE_ID:02X}',
+           '-I', os.path.join(SIM_DIR, 'stubs'), '-I', MAIN_DIR, '-I', os.path.join(MAIN_DIR, 'CAN'),
+           '-o', lib, os.path.join(SIM_DIR, 'sim_calibration.c'), os.path.join(MAIN_DIR, 'calibration.c'),
+           '-lm', '-lpthread', '-Wl,--no-undefined']
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    if result.returncode != 0:
+        print(result.stderr)
+        raise RuntimeError("Failed to build sim_calibration.so")
+    for line in result.stderr.splitlines():
+        if 'warning:' in line:
+            print(line)
+    return lib
+
+class Sim:
+    """A fresh copy of the library, calibration.c keeps its tables as long as it is loaded."""
+    count = 0
+
+    def __init__(self, path, work_dir, nvs_dir, args):
+        Sim.count += 1
+        copy = os.path.join(work_dir, f'calibration_{Sim.count}.so')
+        shutil.copy(path, copy)
+        self.lib = ctypes.CDLL(copy)
+        self.lib.sim_cal_init.argtypes = [ctypes.c_char_p, ctypes.c_int]
+        self.lib.sim_cal_reply.argtypes = [ctypes.POINTER(ctypes.c_ubyte)]
+        self.lib.sim_cal_reply.restype = ctypes.c_ulong
+        self.lib.sim_cal_swap.argtypes = [ctypes.c_char_p, ctypes.c_ushort, ctypes.c_char_p, ctypes.c_ushort,
+                                          ctypes.c_ulong, ctypes.c_ubyte, ctypes.POINTER(ctypes.c_float),
+                                          ctypes.POINTER(ctypes.c_float), ctypes.POINTER(ctypes.c_float),
+                                          ctypes.c_ushort, ctypes.POINTER(ctypes.c_ulong)]
+        self.lib.sim_cal_swap.restype = ctypes.c_ulong
+        self.lib.CAL_update.argtypes = [ctypes.c_char_p, ctypes.c_ushort, ctypes.c_bool]
+        self.lib.CAL_convert.argtypes = [ctypes.c_ubyte, ctypes.c_float]
+        self.lib.CAL_convert.restype = ctypes.c_float
+        self.lib.CAL_convert_batch.argtypes = [ctypes.c_ubyte, ctypes.POINTER(ctypes.c_float),
+                                               ctypes.POINTER(ctypes.c_float), ctypes.c_ushort]
+        self.lib.CAL_get_version.argtypes = [ctypes.c_ubyte]
+        self.lib.CAL_get_version.restype = ctypes.c_ushort
+        self.lib.CAL_receive.argtypes = [ctypes.c_ulong, ctypes.c_char_p, ctypes.c_ubyte]
+        if self.lib.sim_cal_init(nvs_dir.encode(), 1 if args.verbose else 0) != 0:
+            raise RuntimeError("sim_cal_init failed")
+
+    def update(self, blob, store=False):
+        return self.lib.CAL_update(blob, len(blob), store)
+
+    def convert(self, slot, volts):
+        n = len(volts)
+        out = (ctypes.c_float * n)()
+        self.lib.CAL_convert_batch(slot, (ctypes.c_float * n)(*volts), out, n)
+        return list(out)
+
+    def reply(self):
+        data = (ctypes.c_ubyte * 8)()
+        count = self.lib.sim_cal_reply(data)
+        return count, list(data[:5])
+
+    def stats(self):
+        out = Stats()
+        self.lib.CAL_get_stats(ctypes.byref(out))
+        return out
+
+# -----------------------------------------------------------------------------
+# Tables
+# -----------------------------------------------------------------------------
+def pressure(n):
+    """A 0.5 to 4.5 V transducer to 10 bar, a little bent."""
+    points = []
+    for i in range(n):
+        v = 0.5 + 4.0 * i / (n - 1)
+        x = (v - 0.5) / 4.0
+        points.append((v, 10.0 * x + 0.15 * x * (1.0 - x)))
+    return points
+
+def thermistor():
+    """An NTC to ground under a pullup, -20 to 130 C in 5 C steps, uneven in volts."""
+    points = []
+    for t in range(-20, 135, 5):
+        r = R25 * math.exp(BETA * (1.0 / (t + 273.15) - 1.0 / 298.15))
+        points.append((VREF * r / (r + PULLUP), float(t)))
+    return sorted(points)
+
+def interpolate(points, v):
+    for (v0, y0), (v1, y1) in zip(points, points[1:]):
+        if v0 <= v <= v1:
+            return y0 + (y1 - y0) * (v - v0) / (v1 - v0)
+    return None
+
+def with_crc(blob):
+    return blob[:-4] + struct.pack('<I', zlib.crc32(blob[:-4]) & 0xFFFFFFFF)
+
+# -----------------------------------------------------------------------------
+# Scenarios
+# -----------------------------------------------------------------------------
+def run_accuracy(path, work_dir, args, rng):
+    cases = [('Pressure, 101 even', pressure(101), 0), ('Pressure, 98 nearly even', pressure(98), 1),
+             ('Thermistor, 31 uneven', thermistor(), 4), ('Flow, 2 points', [(0.2, 0.0), (4.8, 60.0)], 3)]
+    results = []
+    for name, points, slot in cases:
+        nvs_dir = tempfile.mkdtemp(dir=work_dir)
+        sim = Sim(path, work_dir, nvs_dir, args)
+        blob, quant = cal.make_blob(points, slot, 1)
+        result = sim.update(blob)
+        lo, hi = points[0][0], points[-1][0]
+        volts = [rng.uniform(lo, hi) for _ in range(args.samples)] + [v for v, _ in points]
+        got = sim.convert(slot, volts)
+        values = [y for _, y in points]
+        scale = (max(values) - min(values)) / 65534
+        slope = max(abs((y1 - y0) / (v1 - v0)) for (v0, y0), (v1, y1) in zip(points, points[1:]))
+        bound = quant + 2 * scale + slope * 1.5e-4
+        worst = 0.0
+        for v, y in zip(volts, got):
+            # The firmware sees the volts as a float rounded to 0.1 mV, as the table's breakpoints
+            expected = interpolate(points, min(max(v, lo), hi))
+            worst = max(worst, abs(y - expected))
+        outside = sim.convert(slot, [lo - 0.01, hi + 0.01, -1.0, 7.0, float('nan')])
+        passed = result == OK and worst <= bound and all(y == SENSOR_INVALID for y in outside)
+        results.append({'name': name, 'bytes': len(blob), 'worst': worst, 'bound': bound,
+                        'range': max(values) - min(values), 'passed': passed})
+    return results
+
+def run_refusals(path, work_dir, args, rng):
+    nvs_dir = tempfile.mkdtemp(dir=work_dir)
+    sim = Sim(path, work_dir, nvs_dir, args)
+    good, _ = cal.make_blob(pressure(21), 0, 5)
+    before = sim.update(good)
+    expected_value = sim.convert(0, [2.5])[0]
+    flipped = bytearray(good)
+    flipped[40] ^= 0x04
+    older, _ = cal.make_blob(pressure(21), 0, 4)
+    falling = bytearray(good)
+    header = struct.calcsize(cal.HEADER_FORMAT)
+    falling[header + 2:header + 4] = falling[header:header + 2]
+    magic = bytearray(good)
+    magic[0] ^= 0xFF
+    cases = [('Bit flipped', bytes(flipped), BAD_CRC), ('Older version', older, OLD_VERSION),
+             ('Breakpoints not rising', with_crc(bytes(falling)), BAD_TABLE), ('Short', good[:-7], BAD_TABLE),
+             ('Wrong magic', with_crc(bytes(magic)), BAD_TABLE)]
+    results = []
+    for name, blob, code in cases:
+        got = sim.update(blob)
+        kept = sim.lib.CAL_get_version(0) == 5 and sim.convert(0, [2.5])[0] == expected_value
+        results.append({'name': name, 'expected': cal.RESULTS[code], 'got': cal.RESULTS.get(got, got),
+                        'passed': before == OK and got == code and kept})
+    return results
+
+def run_can(path, work_dir, args, rng):
+    nvs_dir = tempfile.mkdtemp(dir=work_dir)
+    sim = Sim(path, work_dir, nvs_dir, args)
+    blob, _ = cal.make_blob(thermistor(), 5, 7)
+    frames = cal.chunks(blob, DEVICE_ID)
+    results = []
+
+    # One frame lost, nothing taken
+    for arbitration_id, data in frames[:-1]:
+        sim.lib.CAL_receive(arbitration_id, data, len(data))
+    sim.lib.CAL_service()
+    count, _ = sim.reply()
+    results.append({'name': f'{len(frames)} frames, last lost', 'detail': f'{count} replies, version {sim.lib.CAL_get_version(5)}',
+                    'passed': count == 0 and sim.lib.CAL_get_version(5) == 0})
+
+    # Another node's frames ignored, then the lot again out of order after seq 0
+    for arbitration_id, data in cal.chunks(blob, DEVICE_ID + 1):
+        sim.lib.CAL_receive(arbitration_id, bytes(7), 7)
+    rest = frames[1:]
+    rng.shuffle(rest)
+    for arbitration_id, data in [frames[0]] + rest:
+        sim.lib.CAL_receive(arbitration_id, data, len(data))
+        sim.lib.CAL_service()
+    count, reply = sim.reply()
+    expected = [cal.CAL_RESP, 5, OK, 0, 7]
+    results.append({'name': f'{len(frames)} frames, shuffled', 'detail': f'{count} reply {reply}',
+                    'passed': count == 1 and reply == expected})
+    before = sim.convert(5, [v for v, _ in thermistor()])
+
+    # Sent again older, refused with the version it has
+    older, _ = cal.make_blob(thermistor(), 5, 6)
+    for arbitration_id, data in cal.chunks(older, DEVICE_ID):
+        sim.lib.CAL_receive(arbitration_id, data, len(data))
+    sim.lib.CAL_service()
+    count, reply = sim.reply()
+    results.append({'name': 'Older version sent', 'detail': f'{count} replies, last {reply}',
+                    'passed': count == 2 and reply == [cal.CAL_RESP, 5, OLD_VERSION, 0, 7]})
+
+    # Reboot
+    rebooted = Sim(path, work_dir, nvs_dir, args)
+    after = rebooted.convert(5, [v for v, _ in thermistor()])
+    results.append({'name': 'Reboot, loaded from NVS', 'detail': f'version {rebooted.lib.CAL_get_version(5)}',
+                    'passed': rebooted.lib.CAL_get_version(5) == 7 and after == before})
+    return results
+
+def run_swap(path, work_dir, args, rng):
+    nvs_dir = tempfile.mkdtemp(dir=work_dir)
+    sim = Sim(path, work_dir, nvs_dir, args)
+    a, _ = cal.make_blob(pressure(101), 2, 1)
+    b, _ = cal.make_blob([(v, 10.0 - y) for v, y in pressure(101)], 2, 1)
+    volts = [0.5 + 4.0 * i / 99 for i in range(100)]
+    sim.update(a)
+    out_a = sim.convert(2, volts)
+    sim.update(b)
+    out_b = sim.convert(2, volts)
+    n = len(volts)
+    batches = ctypes.c_ulong()
+    before = sim.stats()
+    mixed = sim.lib.sim_cal_swap(a, len(a), b, len(b), args.updates, 2, (ctypes.c_float * n)(*volts),
+                                 (ctypes.c_float * n)(*out_a), (ctypes.c_float * n)(*out_b), n, ctypes.byref(batches))
+    after = sim.stats()
+    return [{'name': f'{args.updates} swaps, batches of {n}', 'batches': batches.value, 'mixed': mixed,
+             'retries': after.dwNRetries - before.dwNRetries, 'updates': after.dwNUpdates - before.dwNUpdates,
+             'passed': mixed == 0 and batches.value > 0 and out_a != out_b}]
+
+# -----------------------------------------------------------------------------
+# Main Execution
+# -----------------------------------------------------------------------------
+def main():
+    parser = argparse.ArgumentParser(description="Run calibration.c's tables, storage and CAN update on the PC")
+    parser.add_argument('--samples', type=int, default=20000, help="Random volts per accuracy table (default 20000)")
+    parser.add_argument('--updates', type=int, default=50000, help="Swaps in the swap scenario (default 50000)")
+    parser.add_argument('--seed', type=int, default=1)
+    parser.add_argument('--verbose', action='store_true', help="Show calibration.c's log")
+    args = parser.parse_args()
+    rng = random.Random(args.seed)
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        path = build(work_dir)
+        accuracy = run_accuracy(path, work_dir, args, rng)
+        refusals = run_refusals(path, work_dir, args, rng)
+        can = run_can(path, work_dir, args, rng)
+        swap = run_swap(path, work_dir, args, rng)
+
+    print("=== Accuracy, against the spreadsheet's points in double ===")
+    print(f"{'Table':<28}{'Blob B':>7}{'Worst':>12}{'Bound':>12}{'% range':>9}")
+    for r in accuracy:
+        print(f"{r['name']:<28}{r['bytes']:7}{r['worst']:12.6f}{r['bound']:12.6f}{r['worst'] / r['range'] * 100:9.4f}"
+              f"{'' if r['passed'] else '  FAIL'}")
+    print("\n=== Refusals, table kept ===")
+    for r in refusals:
+        print(f"{r['name']:<28}expected {r['expected']:<24}got {r['got']}{'' if r['passed'] else '  FAIL'}")
+    print("\n=== CAN ===")
+    for r in can:
+        print(f"{r['name']:<28}{r['detail']}{'' if r['passed'] else '  FAIL'}")
+    print("\n=== Swap ===")
+    for r in swap:
+        print(f"{r['name']:<28}{r['updates']} updates, {r['batches']} batches, {r['mixed']} mixed, "
+              f"{r['retries']} gone again{'' if r['passed'] else '  FAIL'}")
+
+    passed = all(r['passed'] for r in accuracy + refusals + can + swap)
+    print(f"\n{'PASS' if passed else 'FAIL'}")
+    return 0 if passed else 1
+
+if __name__ == '__main__':
+    sys.exit(main())
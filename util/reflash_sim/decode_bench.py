@@ -0,0 +1,475 @@
+import os
+import sys
+import time
+import glob
+import random
+import shutil
+import struct
+import ctypes
+import argparse
+import tempfile
+import subprocess
+
+###
+# SFR Log Decoder Benchmark
+# Checks util/sdlog_decode against the firmware and times it. sim_decode.c is built with the
+# signal table under CAN_SIGNAL_FIRMWARE and main/CAN/canDecodeAuto.c, so each frame can be
+# decoded by the firmware's own <Message>Rx function as well as by the table.
+#
+# --frames frames are made for every message in the table, each a random byte of the last one's
+# data changed: a mux value the message has most of the time, the checksum right most of the time
+# and the DLC 8 most of the time, and some IDs no message has. Each is decoded both ways and every
+# value compared. They are then written as a log the way the firmware writes one, frame blocks
+# compressed as SD_log_pack would, decoded by sdlog_decode to CSV on 1 and 4 threads and every row
+# checked against the firmware's values. A copy with a byte spoilt half way must lose the same
+# frames as sdlog.py read_v2 does. The MF4 it writes is read back here and checked against the CSV,
+# and a -r resample against what a zero order hold of the firmware's values gives.
+#
+# Throughput is then timed on --mb of log made of the same messages copied to --files files, at
+# each thread count up to the CPUs, CSV and MF4, next to sdlog.py only reading the frames.
+#
+# Examples:
+#    python decode_bench.py
+#    python decode_bench.py --mb 256 --files 8
+#
+
+# -----------------------------------------------------------------------------
+# Configuration
+# -----------------------------------------------------------------------------
+SIM_DIR = os.path.dirname(os.path.abspath(__file__))
+UTIL_DIR = os.path.dirname(SIM_DIR)
+MAIN_DIR = os.path.abspath(os.path.join(UTIL_DIR, '..', 'main'))
+DECODE_DIR = os.path.join(UTIL_DIR, 'sdlog_decode')
+CC = os.environ.get('CC', 'gcc')
+
+NO_MUX = -1
+SUM_SEED = 0x39                 # CAN_SIGNAL_SUM_SEED
+CHECKSUM_SUM = 1
+MAX_ROWS = 65535
+FLOAT = 7                       # eCAN_SIGNAL_FLOAT
+CHANGED_BYTES = 1               # Per frame from the message's last, so the log compresses
+GOOD_MUX = 0.9
+GOOD_CHECKSUM = 0.9
+GOOD_DLC = 0.95
+UNKNOWN_EVERY = 50              # A frame with an ID no message has
+FRAME_GAP_US = 200              # Most us between frames
+RESAMPLE_HZ = 1000
+HEADER_SIZE = 28                # stSDLogBlockHeader_t
+RAW_LENGTH_SIZE = 2
+
+sys.path.insert(0, UTIL_DIR)
+import sdlog
+
+class CANSignal(ctypes.Structure):
+    _fields_ = [('pszName', ctypes.c_char_p), ('byStartBit', ctypes.c_ubyte), ('byLength', ctypes.c_ubyte),
+                ('BBigEndian', ctypes.c_int), ('eType', ctypes.c_int), ('fGain', ctypes.c_float),
+                ('fOffset', ctypes.c_float), ('nMux', ctypes.c_int32), ('pvFirmware', ctypes.c_void_p)]
+
+class CANMessage(ctypes.Structure):
+    _fields_ = [('dwID', ctypes.c_uint32), ('pszName', ctypes.c_char_p), ('wFirstSignal', ctypes.c_ushort),
+                ('wNSignals', ctypes.c_ushort), ('nMuxSwitch', ctypes.c_short), ('byChecksumRule', ctypes.c_ubyte),
+                ('byChecksumByte', ctypes.c_ubyte), ('pfnRx', ctypes.c_void_p)]
+
+# -----------------------------------------------------------------------------
+# Build
+# -----------------------------------------------------------------------------
+def build(work_dir):
+    """Compiles sim_decode.c against the firmware and sdlog_decode, returns both."""
+    lib = os.path.join(work_dir, 'sim_decode.so')
+    cmd = [CC, '-shared', '-fPIC', '-O2', '-Wall', '-Wextra', '-DDEVICE_ID=0x11', '-DCAN_SIGNAL_FIRMWARE',
+           '-I', os.path.join(SIM_DIR, 'stubs'), '-I', MAIN_DIR, '-I', os.path.join(MAIN_DIR, 'CAN'),
+           '-I', DECODE_DIR, '-o', lib,
+           os.path.join(SIM_DIR, 'sim_decode.c'), os.path.join(DECODE_DIR, 'canSignals.c'),
+           os.path.join(DECODE_DIR, 'canSignalsAuto.c'), os.path.join(MAIN_DIR, 'CAN', 'canDecodeAuto.c'),
+           os.path.join(MAIN_DIR, 'sdcompress.c'), '-Wl,--no-undefined']
+    tool = os.path.join(work_dir, 'sdlog_decode')
+    for command in (cmd, [CC, '-O2', '-pthread', '-o', tool, os.path.join(DECODE_DIR, 'sdlog_decode.c'),
+                          os.path.join(DECODE_DIR, 'canSignals.c'), os.path.join(DECODE_DIR, 'canSignalsAuto.c'), '-lm']):
+        result = subprocess.run(command, capture_output=True, text=True)
+        if result.returncode != 0:
+            print(result.stderr)
+            raise RuntimeError(f"Failed to build {os.path.basename(command[-1 if command is cmd else 5])}")
+        for line in result.stderr.splitlines():
+            if 'warning:' in line:
+                print(line)
+    return lib, tool
+
+def load(path):
+    lib = ctypes.CDLL(path)
+    lib.sim_decode_init.restype = ctypes.c_int
+    for name in ('sim_decode_fw', 'sim_decode_table'):
+        function = getattr(lib, name)
+        function.argtypes = [ctypes.c_uint32, ctypes.c_char_p, ctypes.c_ubyte,
+                             ctypes.POINTER(ctypes.c_ushort), ctypes.POINTER(ctypes.c_double)]
+        function.restype = ctypes.c_ushort
+    lib.SD_compress_block.argtypes = [ctypes.c_char_p, ctypes.c_ushort, ctypes.c_char_p, ctypes.c_ushort]
+    lib.SD_compress_block.restype = ctypes.c_ushort
+    if not lib.sim_decode_init():
+        raise RuntimeError("CAN_signals_init failed")
+    n_signals = ctypes.c_ushort.in_dll(lib, 'wNCANSignals').value
+    n_messages = ctypes.c_ushort.in_dll(lib, 'wNCANMessages').value
+    signals = (CANSignal * n_signals).in_dll(lib, 'astCANSignals')
+    messages = (CANMessage * n_messages).in_dll(lib, 'astCANMessages')
+    return lib, signals, messages
+
+def packer(lib):
+    """SD_log_pack: a frames block's records compressed if it saves a sector."""
+    out = ctypes.create_string_buffer(sdlog.BLOCK_SIZE)
+
+    def pack(records):
+        padded = -(-(HEADER_SIZE + len(records)) // sdlog.SECTOR_SIZE) * sdlog.SECTOR_SIZE
+        if padded < HEADER_SIZE + RAW_LENGTH_SIZE + 2 * sdlog.SECTOR_SIZE:
+            return sdlog.V2_BLOCK_FRAMES, records
+        n = lib.SD_compress_block(records, len(records), out,
+                                  padded - sdlog.SECTOR_SIZE - HEADER_SIZE - RAW_LENGTH_SIZE)
+        if n == 0:
+            return sdlog.V2_BLOCK_FRAMES, records
+        return sdlog.V2_BLOCK_FRAMES_LZ, struct.pack('<H', len(records)) + out.raw[:n]
+    return pack
+
+# -----------------------------------------------------------------------------
+# Frames
+# -----------------------------------------------------------------------------
+def put_bits(data, signal, raw):
+    """Puts a raw value into the frame where the Rx function reads it from."""
+    position = signal.byStartBit
+    for n in range(signal.byLength):
+        bit = (raw >> (signal.byLength - 1 - n if signal.BBigEndian else n)) & 1
+        if position // 8 < len(data):
+            data[position // 8] = (data[position // 8] & ~(1 << (position % 8))) | (bit << (position % 8))
+        if signal.BBigEndian:
+            position = position + 15 if position % 8 == 0 else position - 1
+        else:
+            position += 1
+
+def make_frames(signals, messages, per_message, seed):
+    """Frames for every message in a random order, a few of them bad."""
+    rng = random.Random(seed)
+    known = {message.dwID for message in messages}
+    mux_values = {}
+    for row, message in enumerate(messages):
+        rows = signals[message.wFirstSignal:message.wFirstSignal + message.wNSignals]
+        mux_values[row] = sorted({signal.nMux for signal in rows if signal.nMux != NO_MUX})
+    order = [row for row in range(len(messages)) for _ in range(per_message)]
+    rng.shuffle(order)
+    frames = []
+    last = {}
+    time_us = rng.randrange(1 << 32)
+    for count, row in enumerate(order):
+        message = messages[row]
+        data = bytearray(last.get(row) or bytes(rng.randrange(256) for _ in range(8)))
+        for _ in range(CHANGED_BYTES):
+            data[rng.randrange(8)] = rng.randrange(256)
+        if message.nMuxSwitch != NO_MUX and rng.random() < GOOD_MUX:
+            put_bits(data, signals[message.wFirstSignal + message.nMuxSwitch], rng.choice(mux_values[row]))
+        if message.byChecksumRule == CHECKSUM_SUM and rng.random() < GOOD_CHECKSUM:
+            data[message.byChecksumByte] = (sum(data[:message.byChecksumByte]) + SUM_SEED + 8) & 0xFF
+        if rng.random() > GOOD_DLC:
+            data = data[:rng.randrange(8)]
+        time_us += rng.randrange(FRAME_GAP_US)
+        frames.append((message.dwID, bytes(data), time_us))
+        last[row] = data if len(data) == 8 else last.get(row)
+        if count % UNKNOWN_EVERY == 0:
+            can_id = rng.choice((rng.randrange(0x800), rng.randrange(0x800, 0x20000000)))
+            if can_id not in known:
+                time_us += 1
+                frames.append((can_id, bytes(rng.randrange(256) for _ in range(8)), time_us))
+    return frames
+
+def decode(function, frame, rows, values):
+    can_id, data, _ = frame
+    n = function(can_id, bytes(data) + bytes(8 - len(data)), len(data), rows, values)
+    return [(rows[i], values[i]) for i in range(n)]
+
+def same(signal, a, b):
+    if signal.eType == FLOAT:
+        return struct.pack('<f', a) == struct.pack('<f', b)
+    return a == b
+
+# -----------------------------------------------------------------------------
+# Correctness
+# -----------------------------------------------------------------------------
+def check_table(lib, signals, frames):
+    """Every frame through the Rx function and the table, returns the firmware's values."""
+    rows = (ctypes.c_ushort * MAX_ROWS)()
+    values = (ctypes.c_double * MAX_ROWS)()
+    expected = []
+    bad = 0
+    for frame in frames:
+        fw = decode(lib.sim_decode_fw, frame, rows, values)
+        table = decode(lib.sim_decode_table, frame, rows, values)
+        # A global written twice holds the last, the table gives both
+        last = {}
+        for row, value in table:
+            last[signals[row].pvFirmware] = (row, value)
+        table = sorted(last.values())
+        if len(fw) != len(table) or any(r1 != r2 or not same(signals[r1], v1, v2) for (r1, v1), (r2, v2) in zip(fw, table)):
+            if bad < 5:
+                print(f"  {frame[0]:08X} {frame[1].hex(' ')}: firmware {fw} table {table}")
+            bad += 1
+        expected.append(fw)
+    return expected, bad
+
+def names(signals, messages):
+    """Message.Signal of each row."""
+    out = {}
+    for message in messages:
+        for row in range(message.wFirstSignal, message.wFirstSignal + message.wNSignals):
+            out[row] = f"{message.pszName.decode()}.{signals[row].pszName.decode()}"
+    return out
+
+def time_text(time_us):
+    return f"{time_us // 1000000}.{time_us % 1000000:06d}"
+
+def run_tool(tool, args):
+    result = subprocess.run([tool] + args, capture_output=True, text=True)
+    if result.returncode != 0:
+        print(result.stdout, result.stderr)
+        raise RuntimeError("sdlog_decode failed")
+    return result.stdout
+
+def check_csv(out_dir, signals, row_names, frames, expected):
+    """sdlog_decode's CSVs against the firmware's values, every row of them."""
+    want = {}
+    for frame, written in zip(frames, expected):
+        for row, value in written:
+            want.setdefault(row, []).append((time_text(frame[2]), value))
+    bad = 0
+    found = 0
+    for row, rows in want.items():
+        path = os.path.join(out_dir, f"{row_names[row]}.csv")
+        if not os.path.exists(path):
+            bad += len(rows)
+            continue
+        with open(path) as f:
+            lines = f.read().split('\n')
+        found += 1
+        if lines[0] != f"time_s,{signals[row].pszName.decode()}" or len(lines) - 2 != len(rows):
+            bad += 1
+            continue
+        for line, (time_s, value) in zip(lines[1:], rows):
+            got_time, got = line.split(',')
+            if got_time != time_s or not same(signals[row], float(got), value):
+                if bad < 5:
+                    print(f"  {row_names[row]}: {line} expected {time_s},{value}")
+                bad += 1
+    extra = len(glob.glob(os.path.join(out_dir, '*.csv'))) - found
+    return bad + extra, found
+
+def read_mf4(path):
+    """Channel groups of an MF4 as {name: (times, values)}, or a resampled one's columns."""
+    with open(path, 'rb') as f:
+        raw = f.read()
+
+    def block(at):
+        block_id, length, n_links = struct.unpack_from('<4s4xQQ', raw, at)
+        links = struct.unpack_from(f'<{n_links}Q', raw, at + 24)
+        return block_id, links, raw[at + 24 + 8 * n_links:at + length]
+
+    def text(at):
+        return block(at)[2].split(b'\0')[0].decode()
+
+    def data(at):
+        block_id, links, body = block(at)
+        if block_id == b'##DT':
+            return body
+        return b''.join(block(link)[2] for link in links[1:])
+
+    out = {}
+    group = block(64)[1][0]
+    while group:
+        _, links, _ = block(group)
+        _, cg_links, cg = block(links[1])
+        n_records, n_bytes = struct.unpack_from('<8xQ8xI', cg)
+        records = data(links[2]) if links[2] else b''
+        channel = cg_links[1]
+        columns = []
+        while channel:
+            _, cn_links, cn = block(channel)
+            columns.append((text(cn_links[2]), struct.unpack_from('<I', cn, 4)[0]))
+            channel = cn_links[0]
+        if len(records) != n_records * n_bytes:
+            raise RuntimeError(f"{text(cg_links[2])}: {len(records)} bytes for {n_records} records")
+        values = struct.unpack(f'<{n_records * n_bytes // 8}d', records)
+        per = n_bytes // 8
+        for name, offset in columns[1:]:
+            key = name if text(cg_links[2]) == 'resampled' else f"{text(cg_links[2])}.{name}"
+            out[key] = (values[0::per], values[offset // 8::per])
+        group = links[0]
+    return out
+
+def check_mf4(out_dir, row_names, signals):
+    """signals.mf4 against the CSVs."""
+    groups = read_mf4(os.path.join(out_dir, 'signals.mf4'))
+    bad = 0
+    for row, name in row_names.items():
+        path = os.path.join(out_dir, f"{name}.csv")
+        if not os.path.exists(path):
+            bad += name in groups
+            continue
+        with open(path) as f:
+            lines = f.read().split('\n')[1:-1]
+        times, values = groups.get(name, ((), ()))
+        rows = [line.split(',') for line in lines]
+        if (len(rows) != len(times) or any(abs(float(t) - a) > 1e-6 for (t, _), a in zip(rows, times))
+                or any(not same(signals[row], float(v), b) for (_, v), b in zip(rows, values))):
+            bad += 1
+    return bad, len(groups)
+
+def check_resample(out_dir, signals, row_names, chosen, frames, expected):
+    """resampled.csv against a zero order hold of the firmware's values."""
+    held = {row: None for row in chosen}
+    samples = [(frame[2], row, value) for frame, written in zip(frames, expected)
+               for row, value in written if row in held]
+    rows = []
+    start = samples[0][0]
+    for time_us, row, value in samples:
+        while start + round(len(rows) * 1e6 / RESAMPLE_HZ) < time_us:
+            rows.append((start + round(len(rows) * 1e6 / RESAMPLE_HZ), dict(held)))
+        held[row] = value
+    while start + round(len(rows) * 1e6 / RESAMPLE_HZ) <= samples[-1][0]:
+        rows.append((start + round(len(rows) * 1e6 / RESAMPLE_HZ), dict(held)))
+    with open(os.path.join(out_dir, 'resampled.csv')) as f:
+        lines = f.read().split('\n')
+    bad = int(lines[0] != 'time_s,' + ','.join(row_names[row] for row in sorted(chosen)))
+    bad += abs(len(lines) - 2 - len(rows))
+    for line, (time_us, values) in zip(lines[1:], rows):
+        fields = line.split(',')
+        bad += fields[0] != time_text(time_us)
+        for field, row in zip(fields[1:], sorted(chosen)):
+            bad += (field == '') != (values[row] is None) or (field != '' and not same(signals[row], float(field), values[row]))
+    return bad, len(rows)
+
+def run_check(args, work_dir, lib, tool, signals, messages):
+    frames = make_frames(signals, messages, args.frames, args.seed)
+    start = time.monotonic()
+    expected, bad_table = check_table(lib, signals, frames)
+    table_s = time.monotonic() - start
+    log = os.path.join(work_dir, 'check.bin')
+    with open(log, 'wb') as f:
+        f.write(sdlog.write_v2(frames, file_id=0x5EED, pack=packer(lib)))
+    row_names = names(signals, messages)
+    result = {'frames': len(frames), 'messages': len(messages), 'signals': len(signals), 'bad_table': bad_table,
+              'table_s': table_s, 'values': sum(len(written) for written in expected),
+              'refused': sum(1 for frame, written in zip(frames, expected) if not written)}
+    for threads in (1, 4):
+        out_dir = os.path.join(work_dir, f'csv{threads}')
+        result['lz'] = run_tool(tool, ['-j', str(threads), '-f', 'csv', '-o', out_dir, log]).splitlines()[0]
+        result[f'bad_csv{threads}'], result['csv_files'] = check_csv(out_dir, signals, row_names, frames, expected)
+    # A block spoilt part way, read past as sdlog.py does
+    with open(log, 'rb') as f:
+        raw = bytearray(f.read())
+    raw[len(raw) // 2] ^= 0xFF
+    spoilt = os.path.join(work_dir, 'spoilt.bin')
+    with open(spoilt, 'wb') as f:
+        f.write(raw)
+    read, info = sdlog.read_v2(bytes(raw))
+    summary = run_tool(tool, ['-f', 'csv', '-o', os.path.join(work_dir, 'spoilt'), spoilt]).splitlines()
+    result['spoilt'] = (f"{info['corrupt']} corrupt" in summary[0] and summary[1].startswith(f"{len(read)} frames"),
+                        info['corrupt'], len(frames) - len(read))
+
+    out_dir = os.path.join(work_dir, 'csv1')
+    run_tool(tool, ['-j', '2', '-f', 'mf4', '-o', out_dir, log])
+    result['bad_mf4'], result['mf4_groups'] = check_mf4(out_dir, row_names, signals)
+
+    # Two signals of the busiest messages, one of them a float if there is one
+    counts = {}
+    for written in expected:
+        for row, _ in written:
+            counts[row] = counts.get(row, 0) + 1
+    busiest = sorted(counts, key=lambda row: -counts[row])
+    floats = [row for row in busiest if signals[row].eType == FLOAT and row != busiest[0]]
+    chosen = {busiest[0], (floats or busiest[1:])[0]}
+    out_dir = os.path.join(work_dir, 'resampled')
+    selected = []
+    for row in chosen:
+        selected += ['-s', row_names[row]]
+    run_tool(tool, ['-j', '2', '-f', 'csv', '-r', str(RESAMPLE_HZ)] + selected + ['-o', out_dir, log])
+    result['bad_resample'], result['resample_rows'] = check_resample(out_dir, signals, row_names, chosen, frames, expected)
+    run_tool(tool, ['-f', 'mf4', '-r', str(RESAMPLE_HZ)] + selected + ['-o', out_dir, log])
+    columns = read_mf4(os.path.join(out_dir, 'resampled.mf4'))
+    result['resample_mf4'] = sorted(columns) == sorted(row_names[row] for row in chosen) and \
+        all(len(times) == result['resample_rows'] for times, _ in columns.values())
+    return result
+
+# -----------------------------------------------------------------------------
+# Throughput
+# -----------------------------------------------------------------------------
+def run_speed(args, work_dir, lib, tool, signals, messages):
+    """Decodes --mb of log in --files files at each thread count."""
+    frames = make_frames(signals, messages, 1000, args.seed + 1)
+    one = sdlog.write_v2(frames, pack=packer(lib))
+    copies = max(1, round(args.mb * 1024 * 1024 / len(one) / args.files))
+    paths = []
+    for n in range(args.files):
+        paths.append(os.path.join(work_dir, f'log{n:03d}.bin'))
+        frames_n = [(can_id, data, time_us + k * (frames[-1][2] + 1) + n * copies * (frames[-1][2] + 1))
+                    for k in range(copies) for can_id, data, time_us in frames]
+        with open(paths[-1], 'wb') as f:
+            f.write(sdlog.write_v2(frames_n, pack=packer(lib)))
+    total_bytes = sum(os.path.getsize(path) for path in paths)
+    n_cpus = os.cpu_count() or 1
+    thread_counts = sorted({1, 2, 4, n_cpus} | {n for n in (8, 16, 32) if n <= n_cpus})
+    runs = []
+    for fmt in ('csv', 'mf4'):
+        for threads in thread_counts:
+            out_dir = os.path.join(work_dir, f'speed_{fmt}{threads}')
+            stdout = run_tool(tool, ['-j', str(threads), '-f', fmt, '-o', out_dir] + paths)
+            seconds, rate = stdout.splitlines()[-1].split(' s, ')
+            runs.append((fmt, threads, float(seconds), float(rate.split()[0])))
+            shutil.rmtree(out_dir)
+
+    start = time.monotonic()
+    n_python = 0
+    for path in paths[:1]:
+        n_python += len(sdlog.read(path)[0])
+    python_rate = n_python / (time.monotonic() - start)
+    return {'lz': stdout.splitlines()[0], 'mb': total_bytes / 1e6, 'files': len(paths),
+            'frames': len(frames) * copies * len(paths), 'cpus': n_cpus, 'runs': runs, 'python_rate': python_rate}
+
+# -----------------------------------------------------------------------------
+# Main Execution
+# -----------------------------------------------------------------------------
+def report_check(check):
+    print("=== Firmware cross-check ===")
+    print(f"Table:                {check['messages']} messages, {check['signals']} signals")
+    print(f"Log:                  {check['lz']}")
+    print(f"Frames:               {check['frames']}, {check['values']} values, {check['refused']} refused by their Rx function")
+    print(f"Rx function vs table: {check['bad_table']} frames differ")
+    print(f"CSV, 1 thread:        {check['bad_csv1']} bad of {check['csv_files']} signals")
+    print(f"CSV, 4 threads:       {check['bad_csv4']} bad")
+    print(f"Spoilt block:         {check['spoilt'][1]} corrupt, {check['spoilt'][2]} frames lost, "
+          f"{'same as' if check['spoilt'][0] else 'NOT the same as'} sdlog.py")
+    print(f"MF4 vs CSV:           {check['bad_mf4']} bad of {check['mf4_groups']} channel groups")
+    print(f"{'Resampled ' + str(RESAMPLE_HZ) + ' Hz:':<22}{check['bad_resample']} bad of {check['resample_rows']} rows, "
+          f"MF4 {'OK' if check['resample_mf4'] else 'FAIL'}")
+    return not (check['bad_table'] or check['bad_csv1'] or check['bad_csv4'] or check['bad_mf4']
+                or check['bad_resample']) and check['resample_mf4'] and check['spoilt'][0]
+
+def report_speed(speed):
+    print(f"\n=== Throughput, {speed['mb']:.0f} MB in {speed['files']} files, {speed['frames']} frames, "
+          f"{speed['cpus']} CPUs ===")
+    for fmt, threads, seconds, rate in speed['runs']:
+        print(f"{fmt} on {threads:>2} threads:    {rate / 1e6:6.2f} M frames/s, {speed['mb'] / seconds:6.0f} MB/s")
+    print(f"Log:                  {speed['lz']}")
+    print(f"sdlog.py read only:   {speed['python_rate'] / 1e6:6.2f} M frames/s")
+
+def main():
+    parser = argparse.ArgumentParser(description="Check sdlog_decode against the firmware and time it")
+    parser.add_argument('--frames', type=int, default=2000, help="Frames per message to check (default 2000)")
+    parser.add_argument('--mb', type=int, default=128, help="Log to time, 0 to skip (default 128)")
+    parser.add_argument('--files', type=int, default=4)
+    parser.add_argument('--seed', type=int, default=1)
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        lib_path, tool = build(work_dir)
+        lib, signals, messages = load(lib_path)
+        passed = report_check(run_check(args, work_dir, lib, tool, signals, messages))
+        if args.mb:
+            report_speed(run_speed(args, work_dir, lib, tool, signals, messages))
+    print(f"\n{'PASS' if passed else 'FAIL'}")
+    return 0 if passed else 1
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,342 @@
+import os
+import sys
+import random
+import shutil
+import ctypes
+import argparse
+import tempfile
+import subprocess
+
+###
+# SFR IMD PWM Benchmark
+# Runs main/imd.c's capture and decoding on the PC in virtual time against synthetic OKHS
+# waveforms. sim_imd.c hands each edge to the capture callback with a 160 MHz count, as the MCPWM
+# capture channel would, and calls IMD_update every 100 ms as task_100ms does, recording the state,
+# frequency, duty, RIsolation and IMDData's flags each time.
+#
+# Each scenario runs from its own copy of the library so starts from IMD_init:
+#    - States: every state at its frequency and in its duty range, decoded with the right flags,
+#      frequency and duty, with --jitter us of jitter on every edge.
+#    - Resistance: a duty sweep in Normal and Undervoltage, RIsolation against the IR155's formula.
+#    - Tolerance: frequencies just inside IMD_FREQ_TOLERANCE are still the state, ones outside or
+#      between states are invalid.
+#    - Start up: off, speed start, Normal, then off again and shorted to supply. The time from each
+#      change on the pin to the state changing, within --change-bound ms, or the timeout plus an
+#      update for 0 Hz.
+#    - Upsets: a falling edge lost, and a glitch, each only invalid for --upset-bound updates.
+#    - Wrap: the capture count crossing 2^32 mid run.
+# The edges a second captured are the interrupt load, against polling the pin fast enough for the
+# same duty resolution.
+#
+# Examples:
+#    python imd_bench.py
+#    python imd_bench.py --jitter 100 --duty-bound 1.2 --verbose
+#
+
+# -----------------------------------------------------------------------------
+# Configuration
+# -----------------------------------------------------------------------------
+SIM_DIR = os.path.dirname(os.path.abspath(__file__))
+MAIN_DIR = os.path.abspath(os.path.join(SIM_DIR, '..', '..', 'main'))
+CC = os.environ.get('CC', 'gcc')
+
+RESOLUTION_HZ = 160000000                   # SIM_IMD_RESOLUTION_HZ
+UPDATE_S = 0.1                              # task_100ms
+TIMEOUT_S = 0.25                            # IMD_TIMEOUT_US
+R_SERIES, R_MAX = 1200000.0, 13000000.0     # IMD_R_SERIES_OHMS, IMD_R_MAX_OHMS
+MAX_UPDATES = 1000
+
+OFF, NORMAL, UNDERVOLTAGE, SPEED_START, DEVICE_ERROR, GROUND_FAULT, SHORT_SUPPLY, INVALID = range(8)
+STATE_NAMES = ['Off', 'Normal', 'Undervoltage', 'Speed start', 'Device error', 'Ground fault',
+               'Shorted to supply', 'Invalid']
+# IMDData's flags as sim_imd_run packs them
+B_OFF, B_UV, B_STARTING, B_SST_GOOD, B_DEVICE_ERROR, B_GROUND_FAULT, B_INVALID = (1 << b for b in range(6, -1, -1))
+STATE_FLAGS = {OFF: B_OFF, NORMAL: 0, UNDERVOLTAGE: B_UV, SPEED_START: B_STARTING, DEVICE_ERROR: B_DEVICE_ERROR,
+               GROUND_FAULT: B_GROUND_FAULT, SHORT_SUPPLY: B_INVALID, INVALID: B_INVALID}
+
+class Stats(ctypes.Structure):
+    _fields_ = [('dwNEdges', ctypes.c_ulong), ('dwNUpdates', ctypes.c_ulong), ('dwNInvalid', ctypes.c_ulong),
+                ('dwNMissing', ctypes.c_ulong), ('dwNTimeouts', ctypes.c_ulong), ('dwNStateChanges', ctypes.c_ulong)]
+
+# -----------------------------------------------------------------------------
+# Build
+# -----------------------------------------------------------------------------
+def build(work_dir):
+    """Compiles sim_imd.c with the firmware into a shared library."""
+    lib = os.path.join(work_dir, 'sim_imd.so')
+    cmd = [CC, '-shared', '-fPIC', '-O2', '-Wall', '-Wextra', '-DDEVICE_ID=0x13',
+           '-I', os.path.join(SIM_DIR, 'stubs'), '-I', MAIN_DIR, '-I', os.path.join(MAIN_DIR, 'CAN'),
+           '-o', lib, os.path.join(SIM_DIR, 'sim_imd.c'), os.path.join(MAIN_DIR, 'imd.c'),
+           os.path.join(MAIN_DIR, 'CAN', 'canDecodeAuto.c'), '-lm', '-Wl,--no-undefined']
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    if result.returncode != 0:
+        print(result.stderr)
+        raise RuntimeError("Failed to build sim_imd.so")
+    for line in result.stderr.splitlines():
+        if 'warning:' in line:
+            print(line)
+    return lib
+
+class Sim:
+    """A fresh copy of the library, imd.c keeps its state as long as it is loaded."""
+    count = 0
+
+    def __init__(self, path, work_dir, args, start_count=0):
+        Sim.count += 1
+        copy = os.path.join(work_dir, f'imd_{Sim.count}.so')
+        shutil.copy(path, copy)
+        self.lib = ctypes.CDLL(copy)
+        self.lib.sim_imd_init.argtypes = [ctypes.c_ulong, ctypes.c_int]
+        self.lib.sim_imd_run.argtypes = [ctypes.POINTER(ctypes.c_double), ctypes.POINTER(ctypes.c_ubyte),
+                                         ctypes.c_ulong, ctypes.c_double, ctypes.POINTER(ctypes.c_float),
+                                         ctypes.POINTER(ctypes.c_float), ctypes.POINTER(ctypes.c_int),
+                                         ctypes.POINTER(ctypes.c_float), ctypes.POINTER(ctypes.c_ubyte), ctypes.c_ulong]
+        self.lib.sim_imd_run.restype = ctypes.c_ulong
+        if self.lib.sim_imd_init(start_count, 1 if args.verbose else 0) != 0:
+            raise RuntimeError("sim_imd_init failed")
+
+    def run(self, edges, end):
+        """Edges as (seconds, level) to end seconds. Returns a dict a list per update."""
+        n = len(edges)
+        hz, duty, r = (ctypes.c_float * MAX_UPDATES)(), (ctypes.c_float * MAX_UPDATES)(), (ctypes.c_float * MAX_UPDATES)()
+        state, flags = (ctypes.c_int * MAX_UPDATES)(), (ctypes.c_ubyte * MAX_UPDATES)()
+        count = self.lib.sim_imd_run((ctypes.c_double * n)(*[e[0] for e in edges]),
+                                     (ctypes.c_ubyte * n)(*[e[1] for e in edges]), n, end,
+                                     hz, duty, state, r, flags, MAX_UPDATES)
+        return {'t': [UPDATE_S * (i + 1) for i in range(count)], 'hz': list(hz[:count]), 'duty': list(duty[:count]),
+                'state': list(state[:count]), 'r': list(r[:count]), 'flags': list(flags[:count])}
+
+    def stats(self):
+        out = Stats()
+        self.lib.IMD_get_stats(ctypes.byref(out))
+        return out
+
+# -----------------------------------------------------------------------------
+# Waveforms
+# -----------------------------------------------------------------------------
+def pwm(segments, jitter_us, rng, start=0.013):
+    """Segments of (seconds, Hz, duty %), Hz 0 holding the level duty > 50. Returns the edges
+    as (seconds, level) and each segment's start."""
+    edges, starts = [], []
+    t, level = start, 0
+    jitter = lambda: rng.gauss(0.0, jitter_us * 1e-6) if jitter_us else 0.0
+    for seconds, hz, duty in segments:
+        starts.append(t)
+        end = t + seconds
+        if hz == 0:
+            if (1 if duty > 50 else 0) != level:
+                level = 1 - level
+                edges.append((t, level))
+            t = end
+            continue
+        period = 1.0 / hz
+        while t < end - 1e-9:
+            if level == 1:
+                edges.append((t, 0))
+            edges.append((t + jitter(), 1))
+            edges.append((t + duty / 100.0 * period + jitter(), 0))
+            level = 0
+            t += period
+    return sorted(edges), starts
+
+def r_expected(duty):
+    if duty <= 5.0:
+        return R_MAX
+    return min(max(90.0 * R_SERIES / (duty - 5.0) - R_SERIES, 0.0), R_MAX)
+
+# -----------------------------------------------------------------------------
+# Scenarios
+# -----------------------------------------------------------------------------
+def run_states(path, work_dir, args, rng):
+    """Every state held for 2 s, checked from 0.5 s in."""
+    cases = [('Normal 10 Hz 50 %', 10, 50.0, NORMAL, 0), ('Undervoltage 20 Hz 30 %', 20, 30.0, UNDERVOLTAGE, 0),
+             ('Speed start good 30 Hz 7.5 %', 30, 7.5, SPEED_START, B_SST_GOOD),
+             ('Speed start bad 30 Hz 92.5 %', 30, 92.5, SPEED_START, 0),
+             ('Device error 40 Hz 50 %', 40, 50.0, DEVICE_ERROR, 0), ('Ground fault 50 Hz 50 %', 50, 50.0, GROUND_FAULT, 0),
+             ('Off, 0 Hz low', 0, 0.0, OFF, 0), ('Shorted to supply, 0 Hz high', 0, 100.0, SHORT_SUPPLY, 0)]
+    results = []
+    for name, hz, duty, state, extra in cases:
+        sim = Sim(path, work_dir, args)
+        edges, _ = pwm([(2.0, hz, duty)], args.jitter, rng)
+        out = sim.run(edges, 2.0)
+        checked = [i for i, t in enumerate(out['t']) if t >= 0.5]
+        hz_error = max(abs(out['hz'][i] - hz) for i in checked)
+        duty_error = max(abs(out['duty'][i] - duty) for i in checked)
+        passed = all(out['state'][i] == state and out['flags'][i] == STATE_FLAGS[state] | extra for i in checked)
+        passed = passed and hz_error < 0.01 * max(hz, 1) and duty_error < args.duty_bound
+        results.append({'name': name, 'state': STATE_NAMES[out['state'][-1]], 'hz_error': hz_error,
+                        'duty_error': duty_error, 'edges_per_s': sim.stats().dwNEdges / 2.0, 'hz': hz,
+                        'passed': passed})
+    return results
+
+def run_resistance(path, work_dir, args, rng):
+    """Duty 6 to 94 % a second each. The duty measured at the end of each against the pin's and
+    RIsolation against the formula for it, the formula is steep enough at both ends that jitter's
+    share of a period moves it by a few %."""
+    results = []
+    for hz in (10, 20):
+        sim = Sim(path, work_dir, args)
+        duties = [6.0 + 4.0 * i for i in range(23)]
+        edges, starts = pwm([(1.0, hz, d) for d in duties], args.jitter, rng)
+        out = sim.run(edges, starts[-1] + 1.0)
+        worst_r, worst_duty, worst_pin = 0.0, 0.0, 0.0
+        for seg, duty in enumerate(duties):
+            i = max(i for i, t in enumerate(out['t']) if t < starts[seg] + 1.0)
+            expected = r_expected(out['duty'][i])
+            worst_r = max(worst_r, abs(out['r'][i] - expected) / expected)
+            worst_duty = max(worst_duty, abs(out['duty'][i] - duty))
+            worst_pin = max(worst_pin, abs(out['r'][i] - r_expected(duty)) / r_expected(duty))
+            if args.verbose:
+                print(f"{hz} Hz {duty:.0f} %: duty {out['duty'][i]:.3f} R {out['r'][i]:.0f} expected {r_expected(duty):.0f}")
+        results.append({'name': f'{STATE_NAMES[NORMAL if hz == 10 else UNDERVOLTAGE]} {hz} Hz, duty 6 to 94 %',
+                        'worst_r': worst_r, 'worst_duty': worst_duty, 'worst_pin': worst_pin,
+                        'passed': worst_r < args.r_tolerance / 100.0 and worst_duty < args.duty_bound})
+    return results
+
+def run_tolerance(path, work_dir, args, rng):
+    cases = [('Normal at 9.3 Hz', 9.3, 50.0, NORMAL), ('Normal at 10.8 Hz', 10.8, 50.0, NORMAL),
+             ('Ground fault at 46 Hz', 46.0, 50.0, GROUND_FAULT), ('11.5 Hz', 11.5, 50.0, INVALID),
+             ('25 Hz', 25.0, 50.0, INVALID), ('Device error at 30 % duty', 40.0, 30.0, INVALID),
+             ('Speed start at 50 % duty', 30.0, 50.0, INVALID), ('Normal at 98 % duty', 10.0, 98.0, INVALID)]
+    results = []
+    for name, hz, duty, state in cases:
+        sim = Sim(path, work_dir, args)
+        edges, _ = pwm([(2.0, hz, duty)], args.jitter, rng)
+        out = sim.run(edges, 2.0)
+        states = set(out['state'][i] for i, t in enumerate(out['t']) if t >= 0.5)
+        results.append({'name': name, 'expected': STATE_NAMES[state],
+                        'got': ', '.join(STATE_NAMES[s] for s in sorted(states)), 'passed': states == {state}})
+    return results
+
+def first_update(out, state, after):
+    for t, s in zip(out['t'], out['state']):
+        if t >= after and s == state:
+            return t
+    return None
+
+def run_start_up(path, work_dir, args, rng):
+    """Off, speed start good, Normal at 2 MOhm, off, Normal, shorted to supply."""
+    duty_2m = 5.0 + 90.0 * R_SERIES / (2000000.0 + R_SERIES)
+    segments = [(0.5, 0, 0.0), (2.0, 30, 7.5), (2.0, 10, duty_2m), (1.0, 0, 0.0), (1.0, 10, duty_2m), (1.0, 0, 100.0)]
+    expect = [OFF, SPEED_START, NORMAL, OFF, NORMAL, SHORT_SUPPLY]
+    sim = Sim(path, work_dir, args)
+    edges, starts = pwm(segments, args.jitter, rng)
+    out = sim.run(edges, starts[-1] + 1.0)
+    results = []
+    for seg in range(1, len(segments)):
+        # 0 Hz is only seen once the last edge is IMD_TIMEOUT_US old
+        if segments[seg][1] == 0:
+            change = max(t for t, _ in edges if t < starts[seg] + 1e-6)
+        else:
+            change = starts[seg]
+        t = first_update(out, expect[seg], starts[seg])
+        bound = (TIMEOUT_S + UPDATE_S) * 1000 if segments[seg][1] == 0 else args.change_bound
+        latency = (t - change) * 1000 if t is not None else None
+        invalid = sum(1 for u, s in zip(out['t'], out['state']) if starts[seg] <= u < starts[seg] + 0.5 and s == INVALID)
+        results.append({'name': f'{STATE_NAMES[expect[seg - 1]]} to {STATE_NAMES[expect[seg]]}', 'latency': latency,
+                        'bound': bound, 'invalid': invalid,
+                        'passed': latency is not None and latency <= bound and invalid == 0})
+    # The speed start's result and the resistance once Normal
+    i = max(i for i, u in enumerate(out['t']) if u < starts[3])
+    r_ok = abs(out['r'][i] - 2000000.0) < 0.01 * 2000000.0 and out['flags'][i] & B_SST_GOOD
+    results.append({'name': 'Normal at 2 MOhm after a good speed start', 'latency': None, 'bound': None,
+                    'invalid': 0, 'r': out['r'][i], 'passed': bool(r_ok)})
+    return results
+
+def run_upsets(path, work_dir, args, rng):
+    """Normal 10 Hz 50 %, a falling edge lost at 1 s and a 100 us glitch low at 2 s."""
+    results = []
+    for name in ('Falling edge lost', 'Glitch 100 us low', 'Glitch 100 us high'):
+        sim = Sim(path, work_dir, args)
+        edges, _ = pwm([(4.0, 10, 50.0)], args.jitter, rng)
+        if name == 'Falling edge lost':
+            i = next(i for i, (t, level) in enumerate(edges) if t > 1.0 and level == 0)
+            del edges[i]
+        elif name == 'Glitch 100 us low':
+            rise = next(t for t, level in edges if t > 2.0 and level == 1)
+            edges += [(rise + 0.020, 0), (rise + 0.0201, 1)]
+        else:
+            fall = next(t for t, level in edges if t > 2.0 and level == 0)
+            edges += [(fall + 0.020, 1), (fall + 0.0201, 0)]
+        edges.sort()
+        out = sim.run(edges, 4.0)
+        bad = sum(1 for t, s in zip(out['t'], out['state']) if t >= 0.5 and s != NORMAL)
+        stats = sim.stats()
+        results.append({'name': name, 'bad': bad, 'missing': stats.dwNMissing, 'final': STATE_NAMES[out['state'][-1]],
+                        'passed': bad <= args.upset_bound and out['state'][-1] == NORMAL})
+    return results
+
+def run_wrap(path, work_dir, args, rng):
+    """The capture count wraps 1.05 s in, Normal 10 Hz and Ground fault 50 Hz."""
+    results = []
+    for hz, duty, state in ((10, 35.0, NORMAL), (50, 50.0, GROUND_FAULT)):
+        sim = Sim(path, work_dir, args, start_count=(1 << 32) - int(1.05 * RESOLUTION_HZ))
+        edges, _ = pwm([(3.0, hz, duty)], args.jitter, rng)
+        out = sim.run(edges, 3.0)
+        checked = [i for i, t in enumerate(out['t']) if t >= 0.5]
+        duty_error = max(abs(out['duty'][i] - duty) for i in checked)
+        passed = all(out['state'][i] == state for i in checked) and duty_error < args.duty_bound
+        results.append({'name': f'{STATE_NAMES[state]} {hz} Hz', 'duty_error': duty_error, 'passed': passed})
+    return results
+
+# -----------------------------------------------------------------------------
+# Main Execution
+# -----------------------------------------------------------------------------
+def main():
+    parser = argparse.ArgumentParser(description="Run imd.c's PWM capture and decoding on the PC against OKHS waveforms")
+    parser.add_argument('--jitter', type=float, default=20.0, help="Edge jitter, us standard deviation (default 20)")
+    parser.add_argument('--duty-bound', type=float, default=0.2, help="Duty error, %% at most (default 0.2)")
+    parser.add_argument('--r-tolerance', type=float, default=1.0, help="RIsolation error, %% at most (default 1)")
+    parser.add_argument('--change-bound', type=float, default=210.0,
+                        help="Pin change to state change, ms at most (default 210)")
+    parser.add_argument('--upset-bound', type=int, default=2, help="Updates not Normal per upset at most (default 2)")
+    parser.add_argument('--seed', type=int, default=1)
+    parser.add_argument('--verbose', action='store_true', help="Show imd.c's log")
+    args = parser.parse_args()
+    rng = random.Random(args.seed)
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        path = build(work_dir)
+        states = run_states(path, work_dir, args, rng)
+        resistance = run_resistance(path, work_dir, args, rng)
+        tolerance = run_tolerance(path, work_dir, args, rng)
+        start_up = run_start_up(path, work_dir, args, rng)
+        upsets = run_upsets(path, work_dir, args, rng)
+        wrap = run_wrap(path, work_dir, args, rng)
+
+    print(f"=== States, {args.jitter:.0f} us edge jitter ===")
+    print(f"{'Scenario':<32}{'Decoded':<20}{'Hz error':>9}{'Duty error':>11}{'Edges/s':>9}{'Poll Hz':>9}")
+    for r in states:
+        # Polling would need a sample per 0.1 % of the period for the duty the capture gives
+        poll = f"{r['hz'] * 1000:.0f}" if r['hz'] else '-'
+        print(f"{r['name']:<32}{r['state']:<20}{r['hz_error']:9.4f}{r['duty_error']:11.4f}{r['edges_per_s']:9.0f}"
+              f"{poll:>9}{'' if r['passed'] else '  FAIL'}")
+    print(f"\n=== Resistance, within {args.r_tolerance} % of the formula for the duty measured ===")
+    for r in resistance:
+        print(f"{r['name']:<40}formula {r['worst_r'] * 100:.3f} %, duty {r['worst_duty']:.3f} %, "
+              f"against the pin's duty {r['worst_pin'] * 100:.2f} %{'' if r['passed'] else '  FAIL'}")
+    print(f"\n=== Tolerance ===")
+    for r in tolerance:
+        print(f"{r['name']:<32}expected {r['expected']:<16}got {r['got']}{'' if r['passed'] else '  FAIL'}")
+    print(f"\n=== Start up, pin change to state change ===")
+    for r in start_up:
+        if r['latency'] is None and 'r' in r:
+            print(f"{r['name']:<44}{r['r'] / 1000:.0f} kOhm{'' if r['passed'] else '  FAIL'}")
+            continue
+        latency = f"{r['latency']:.0f} ms" if r['latency'] is not None else 'never'
+        print(f"{r['name']:<44}{latency:>8} (bound {r['bound']:.0f} ms), {r['invalid']} invalid"
+              f"{'' if r['passed'] else '  FAIL'}")
+    print(f"\n=== Upsets, Normal 10 Hz 50 % ===")
+    for r in upsets:
+        print(f"{r['name']:<32}{r['bad']} updates not Normal, {r['missing']} missing edge, then {r['final']}"
+              f"{'' if r['passed'] else '  FAIL'}")
+    print(f"\n=== Capture count wrap ===")
+    for r in wrap:
+        print(f"{r['name']:<32}duty error {r['duty_error']:.4f} %{'' if r['passed'] else '  FAIL'}")
+
+    passed = all(r['passed'] for r in states + resistance + tolerance + start_up + upsets + wrap)
+    print(f"\n{'PASS' if passed else 'FAIL'}")
+    return 0 if passed else 1
+
+if __name__ == '__main__':
+    sys.exit(main())
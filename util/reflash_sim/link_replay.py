@@ -0,0 +1,268 @@
+import os
+import sys
+import csv
+import math
+import random
+import ctypes
+import argparse
+import tempfile
+import subprocess
+
+###
+# SFR ESP-NOW Link Adaptation Replay
+# Runs the rate choice in espnowlink.c on the PC against an RSSI trace and reports the goodput it
+# gets against staying on each rate. Only espnowlink.c is compiled, against the stubs in stubs/,
+# so the firmware's own decision is what gets tested.
+#
+# The trace is a CSV of time_ms,rssi_dbm (--trace), the RSSI in the ESPNOW_TELEM_LINK_ID frames of
+# an SD card binary log (--log) or a built in drive (--scenario):
+#    lap        Laps past the pits, 20 m to 250 m, with shadowing and fading
+#    edge       Drives out past the range of 1 Mbit/s and back
+#    flutter    Parked where 12 Mbit/s is marginal, for flapping
+#
+# Every ESPNOW_LINK_SAMPLE_MS the radio sends --load B/s of 250 byte packets, as many as the rate's
+# airtime allows, and each gets through its retries with a chance set by the RSSI against the rate's
+# sensitivity. The RSSI is given to the firmware unless --no-rssi, as when the pits send nothing.
+#
+# Telemetry would rather lose fewer packets than carry the most bytes, so it fails if more packets
+# are lost than staying on ESP-NOW's default 1 Mbit/s, less DELIVERY_SLACK, the goodput is under GOODPUT_MIN of the best
+# single rate or it flaps more than FLAPS_MAX_PER_MIN times a minute.
+#
+# Examples:
+#    python link_replay.py                          Every scenario, use for every change to espnowlink
+#    python link_replay.py --scenario edge --no-rssi
+#    python link_replay.py --log ../../logs/LOG0001.BIN
+#
+
+# -----------------------------------------------------------------------------
+# Configuration
+# -----------------------------------------------------------------------------
+SIM_DIR = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.dirname(SIM_DIR))
+import espnow_packing
+from reflash_sim import MAIN_DIR, CC
+
+SAMPLE_MS = 100                # ESPNOW_LINK_SAMPLE_MS
+NO_RSSI = -128                 # ESPNOW_LINK_NO_RSSI
+LINK_ID = 0x7E4                # ESPNOW_TELEM_LINK_ID
+PACKET_BYTES = 250
+RATES = ['LR 250K', 'LR 500K', '1M', '2M', '6M', '12M', '24M']
+RATE_MBPS = [0.25, 0.5, 1, 2, 6, 12, 24]
+SENSITIVITY_DBM = [-103, -100, -98, -95, -92, -89, -83]
+START_RATE = 2                 # eLINK_RATE_1M, as ESPNOW_init starts
+FADE_DB = 2.0                  # Slope of the packet error curve around the sensitivity
+SENSITIVITY_PER = 0.1          # Packet error rate the datasheet sensitivity is given at
+ATTEMPTS = 4                   # The MAC's tries before the send callback reports a failure
+WIFI_OVERHEAD_BYTES = 43
+DSSS_PREAMBLE_US = 192
+OFDM_PREAMBLE_US = 20
+ACK_BITS = 112
+SIFS_DIFS_BACKOFF_US = 370
+RSSI_NOISE_DB = 2.0            # Spread of the RSSI of single packets
+GOODPUT_MIN = 0.85
+DELIVERY_SLACK = 0.03          # What probing faster rates costs when nothing needs them
+FLAP_MS = 5000                 # A change back to the rate before within this is a flap
+FLAPS_MAX_PER_MIN = 6
+
+class LinkSample(ctypes.Structure):
+    _fields_ = [('wNSent', ctypes.c_ushort), ('wNDelivered', ctypes.c_ushort),
+                ('dwNBytes', ctypes.c_ulong), ('sbyRSSI', ctypes.c_byte)]
+
+class LinkPeer(ctypes.Structure):
+    _fields_ = [('eRate', ctypes.c_int),
+                ('dwNWindowSent', ctypes.c_ulong), ('dwNWindowDelivered', ctypes.c_ulong),
+                ('sdwRSSISum', ctypes.c_long), ('dwNRSSI', ctypes.c_ulong), ('dwWindowms', ctypes.c_ulong),
+                ('byNGoodWindows', ctypes.c_ubyte), ('byNUpWindows', ctypes.c_ubyte), ('BProbing', ctypes.c_int),
+                ('byDeliveryPercent', ctypes.c_ubyte), ('sbyRSSI', ctypes.c_byte),
+                ('adwBytes', ctypes.c_ulong * len(RATES)), ('adwTimems', ctypes.c_ulong * len(RATES)),
+                ('adwNSent', ctypes.c_ulong * len(RATES)), ('adwNDelivered', ctypes.c_ulong * len(RATES)),
+                ('dwNChanges', ctypes.c_ulong)]
+
+# -----------------------------------------------------------------------------
+# Traces
+# -----------------------------------------------------------------------------
+def path_loss_rssi(distance_m):
+    """Log distance path loss, -40 dBm at 1 m falling 27 dB a decade."""
+    return -40 - 27 * math.log10(max(distance_m, 1))
+
+def scenario(name, rng):
+    """List of (time_ms, rssi_dbm) every SAMPLE_MS for a built in drive."""
+    trace = []
+    shadow = 0.0
+    if name == 'lap':
+        length_ms, lap_ms = 180000, 60000
+    elif name == 'edge':
+        length_ms = 120000
+    else:
+        length_ms = 60000
+    for time_ms in range(0, length_ms, SAMPLE_MS):
+        if name == 'lap':
+            phase = (time_ms % lap_ms) / lap_ms
+            distance = 20 + 230 * (1 - math.cos(2 * math.pi * phase)) / 2
+        elif name == 'edge':
+            distance = 10 + 390 * (1 - abs(2 * time_ms / length_ms - 1))
+        else:
+            distance = 10 ** ((-40 - (SENSITIVITY_DBM[5] + 5)) / 27)
+        # Shadowing drifts slowly, about a second to change
+        shadow = 0.9 * shadow + rng.gauss(0, 4 * math.sqrt(1 - 0.81))
+        trace.append((time_ms, path_loss_rssi(distance) + shadow))
+    return trace
+
+def load_csv(path):
+    with open(path, newline='') as f:
+        rows = [row for row in csv.reader(f) if row and not row[0].startswith('#')]
+    if rows and not rows[0][0].strip().lstrip('-').isdigit():
+        rows = rows[1:]
+    return resample([(int(row[0]), float(row[1])) for row in rows])
+
+def load_log(path):
+    """RSSI from the ESPNOW_TELEM_LINK_ID frames the car logged, byte 2 in dBm."""
+    points = []
+    for can_id, data, time_us in espnow_packing.mix_from_log(path):
+        if can_id == LINK_ID and len(data) >= 3:
+            rssi = data[2] - 256 if data[2] > 127 else data[2]
+            if rssi != NO_RSSI:
+                points.append((time_us // 1000, rssi))
+    if not points:
+        raise RuntimeError(f"No link frames with an RSSI in {path}")
+    return resample(points)
+
+def resample(points):
+    """Holds each point until the next so the trace is every SAMPLE_MS."""
+    points.sort()
+    trace = []
+    n = 0
+    for time_ms in range(points[0][0], points[-1][0] + 1, SAMPLE_MS):
+        while n + 1 < len(points) and points[n + 1][0] <= time_ms:
+            n += 1
+        trace.append((time_ms, points[n][1]))
+    return trace
+
+# -----------------------------------------------------------------------------
+# Radio
+# -----------------------------------------------------------------------------
+def airtime_us(rate):
+    mbps = RATE_MBPS[rate]
+    preamble = DSSS_PREAMBLE_US if mbps <= 2 else OFDM_PREAMBLE_US
+    return preamble + (PACKET_BYTES + WIFI_OVERHEAD_BYTES) * 8 / mbps + preamble + ACK_BITS / mbps + SIFS_DIFS_BACKOFF_US
+
+def attempt_success(rssi, rate):
+    offset = math.log((1 - SENSITIVITY_PER) / SENSITIVITY_PER)
+    return 1 / (1 + math.exp(-(rssi - SENSITIVITY_DBM[rate]) / FADE_DB - offset))
+
+def radio(rate, rssi, load, carry, rng):
+    """Packets sent and delivered in one sample, and the packets still wanted after it."""
+    success = attempt_success(rssi, rate)
+    delivered_chance = 1 - (1 - success) ** ATTEMPTS
+    tries = sum((1 - success) ** n for n in range(ATTEMPTS))
+    capacity = int(SAMPLE_MS * 1000 / (airtime_us(rate) * tries))
+    wanted = carry + load * SAMPLE_MS / 1000 / PACKET_BYTES
+    sent = min(int(wanted), capacity)
+    delivered = sum(1 for _ in range(sent) if rng.random() < delivered_chance)
+    # Telemetry that waits past a sample is stale, only a sample's worth is carried
+    return sent, delivered, min(wanted - sent, load * SAMPLE_MS / 1000 / PACKET_BYTES)
+
+# -----------------------------------------------------------------------------
+# Replay
+# -----------------------------------------------------------------------------
+def build(work_dir):
+    out = os.path.join(work_dir, 'espnowlink.so')
+    cmd = [CC, '-shared', '-fPIC', '-O2', '-Wall', '-I', os.path.join(SIM_DIR, 'stubs'), '-I', MAIN_DIR,
+           '-o', out, os.path.join(MAIN_DIR, 'espnowlink.c')]
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    if result.returncode != 0:
+        print(result.stderr)
+        raise RuntimeError("Failed to build espnowlink.c")
+    lib = ctypes.CDLL(out)
+    lib.ESPNOW_link_init.argtypes = [ctypes.POINTER(LinkPeer), ctypes.c_int]
+    lib.ESPNOW_link_update.argtypes = [ctypes.POINTER(LinkPeer), ctypes.POINTER(LinkSample), ctypes.c_ushort]
+    lib.ESPNOW_link_goodput.argtypes = [ctypes.POINTER(LinkPeer), ctypes.c_int]
+    lib.ESPNOW_link_goodput.restype = ctypes.c_ulong
+    return lib
+
+def replay(lib, trace, load, use_rssi, fixed_rate, seed):
+    """Runs the trace, on fixed_rate throughout or adapting if None."""
+    rng = random.Random(seed)
+    peer = LinkPeer()
+    lib.ESPNOW_link_init(ctypes.byref(peer), START_RATE if fixed_rate is None else fixed_rate)
+    carry = 0.0
+    delivered_bytes = 0
+    sent_total = 0
+    delivered_total = 0
+    timeline = []
+    for time_ms, rssi in trace:
+        rate = peer.eRate
+        sent, delivered, carry = radio(rate, rssi, load, carry, rng)
+        sent_total += sent
+        delivered_total += delivered
+        delivered_bytes += delivered * PACKET_BYTES
+        heard = round(rssi + rng.gauss(0, RSSI_NOISE_DB)) if use_rssi else NO_RSSI
+        sample = LinkSample(sent, delivered, delivered * PACKET_BYTES, max(-127, min(0, heard)) if use_rssi else NO_RSSI)
+        if fixed_rate is None:
+            lib.ESPNOW_link_update(ctypes.byref(peer), ctypes.byref(sample), SAMPLE_MS)
+        timeline.append(rate)
+    seconds = len(trace) * SAMPLE_MS / 1000
+    return {'goodput': delivered_bytes / seconds, 'delivery': delivered_total / max(sent_total, 1),
+            'changes': peer.dwNChanges, 'timeline': timeline, 'peer': peer, 'seconds': seconds}
+
+def flaps(timeline):
+    """Changes back to the previous rate within FLAP_MS."""
+    count = 0
+    last = None
+    for n in range(1, len(timeline)):
+        if timeline[n] == timeline[n - 1]:
+            continue
+        if last is not None and timeline[n] == last[1] and (n - last[0]) * SAMPLE_MS <= FLAP_MS:
+            count += 1
+        last = (n, timeline[n - 1])
+    return count
+
+def report(lib, name, trace, load, use_rssi, seed):
+    fixed = [replay(lib, trace, load, use_rssi, rate, seed) for rate in range(len(RATES))]
+    adaptive = replay(lib, trace, load, use_rssi, None, seed)
+    best = max(range(len(RATES)), key=lambda rate: fixed[rate]['goodput'])
+    flaps_per_min = flaps(adaptive['timeline']) * 60 / adaptive['seconds']
+    rssis = [rssi for _, rssi in trace]
+
+    print(f"{name}: {adaptive['seconds']:.0f} s, RSSI {min(rssis):.0f} to {max(rssis):.0f} dBm, "
+          f"{load / 1000:g} kB/s offered, RSSI {'heard' if use_rssi else 'not heard'}")
+    print(f"  {'Rate':<10}{'Fixed B/s':>11}{'Delivered':>11}{'Time on':>10}{'B/s on it':>11}")
+    for rate in range(len(RATES)):
+        share = adaptive['timeline'].count(rate) / len(adaptive['timeline'])
+        print(f"  {RATES[rate]:<10}{fixed[rate]['goodput']:>11.0f}{100 * fixed[rate]['delivery']:>10.1f}%"
+              f"{100 * share:>9.1f}%{lib.ESPNOW_link_goodput(ctypes.byref(adaptive['peer']), rate):>11}")
+    ratio = adaptive['goodput'] / max(fixed[best]['goodput'], 1)
+    ok = (adaptive['delivery'] >= fixed[START_RATE]['delivery'] - DELIVERY_SLACK and ratio >= GOODPUT_MIN and
+          flaps_per_min <= FLAPS_MAX_PER_MIN)
+    print(f"  Adaptive  {adaptive['goodput']:>11.0f}{100 * adaptive['delivery']:>10.1f}%  "
+          f"{100 * ratio:.0f}% of {RATES[best]}, {adaptive['changes']} changes, {flaps_per_min:.1f} flaps/min")
+    print(f"  {'PASS' if ok else 'FAIL'}")
+    return ok
+
+def main():
+    parser = argparse.ArgumentParser(description="Replay an RSSI trace through the ESP-NOW link adaptation")
+    parser.add_argument('--trace', help="CSV of time_ms,rssi_dbm")
+    parser.add_argument('--log', help="SD card binary log with ESPNOW_TELEM_LINK_ID frames")
+    parser.add_argument('--scenario', choices=('lap', 'edge', 'flutter'), action='append',
+                        help="Built in drive, every one if no trace is given")
+    parser.add_argument('--load', type=float, default=30000, help="Telemetry offered in B/s")
+    parser.add_argument('--no-rssi', action='store_true', help="Decide on delivery alone")
+    parser.add_argument('--seed', type=int, default=1)
+    args = parser.parse_args()
+
+    traces = []
+    if args.trace:
+        traces.append((args.trace, load_csv(args.trace)))
+    if args.log:
+        traces.append((args.log, load_log(args.log)))
+    if not traces or args.scenario:
+        rng = random.Random(args.seed)
+        traces += [(name, scenario(name, rng)) for name in (args.scenario or ('lap', 'edge', 'flutter'))]
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        lib = build(work_dir)
+        results = [report(lib, name, trace, args.load, not args.no_rssi, args.seed) for name, trace in traces]
+    sys.exit(0 if all(results) else 1)
+
+if __name__ == "__main__":
+    main()
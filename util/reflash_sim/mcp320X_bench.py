@@ -0,0 +1,254 @@
+import os
+import sys
+import math
+import shutil
+import ctypes
+import argparse
+import tempfile
+import subprocess
+
+###
+# SFR MCP320X Scan Benchmark
+# Runs main/mcp320X.c's scanning on the PC in virtual time. sim_mcp320X.c stands in for the SPI
+# master, each transaction taking its 24 clocks plus a modelled driver cost, a queued transaction
+# more than a polling one and less again with the bus acquired, see sim_mcp320X.c. The scan task and
+# its esp_timer run on virtual time so what is reported is what the bus allows, not the PC.
+#
+# Two boards are run, each from its own copy of the library:
+#    - Dyno: two MCP3204s, 8 channels. DynoPressuresRaw and DynoTempsRaw are checked against the
+#      counts set for each channel after MCP320X_update_dyno, and again after the counts change.
+#    - Temperature monitor: one MCP3208 of thermistors at TEMPS, TCell and its min, max and average
+#      checked within a degree after MCP320X_update_temp_monitor with MCP320X_thermistor_map.
+# For each the old way, MCP320X_read on every channel one after another, is timed first, then the
+# scan at --rate and at each of RATES, reporting scans and samples a second achieved, overruns and
+# the time a scan takes.
+#
+# Examples:
+#    python mcp320X_bench.py
+#    python mcp320X_bench.py --rate 2000 --seconds 5
+#
+
+# -----------------------------------------------------------------------------
+# Configuration
+# -----------------------------------------------------------------------------
+SIM_DIR = os.path.dirname(os.path.abspath(__file__))
+MAIN_DIR = os.path.abspath(os.path.join(SIM_DIR, '..', '..', 'main'))
+CC = os.environ.get('CC', 'gcc')
+
+VREF = 5.0                      # VADC_REFERNCE
+RATES = [500, 1000, 2000, 3000, 4000, 8000]
+LEGACY_ROUNDS = 1000
+DYNO_CHANNELS = [4, 4]
+DYNO_CS = [17, 16]              # SPI_MCP3204_1_CS, SPI_MCP3204_2_CS
+TEMP_CHANNELS = [8]
+TEMP_CS = [17]                  # SPI_MCP3208_CS
+TEMPS = [-10.0, 5.0, 20.0, 25.0, 40.0, 61.0, 85.0, 120.0]
+FIRST_CELL = 16
+BETA, R25, PULLUP = 3950.0, 10000.0, 10000.0    # MCP320X_THERMISTOR_*
+
+class Stats(ctypes.Structure):
+    _fields_ = [('dwNScans', ctypes.c_ulong), ('dwNSamples', ctypes.c_ulong), ('dwNOverruns', ctypes.c_ulong),
+                ('dwNErrors', ctypes.c_ulong), ('qwNScanus', ctypes.c_uint64), ('dwScanMaxus', ctypes.c_ulong)]
+
+# -----------------------------------------------------------------------------
+# Build
+# -----------------------------------------------------------------------------
+def build(work_dir):
+    """Compiles sim_mcp320X.c with the firmware into a shared library."""
+    lib = os.path.join(work_dir, 'sim_mcp320X.so')
+    cmd = [CC, '-shared', '-fPIC', '-O2', '-Wall', '-Wextra', '-DDEVICE_ID=0x11',
+           '-I', os.path.join(SIM_DIR, 'stubs'), '-I', MAIN_DIR, '-I', os.path.join(MAIN_DIR, 'CAN'),
+           '-o', lib, os.path.join(SIM_DIR, 'sim_mcp320X.c'), os.path.join(SIM_DIR, 'sim_adc.c'),
+           os.path.join(MAIN_DIR, 'mcp320X.c'), os.path.join(MAIN_DIR, 'adc.c'), os.path.join(MAIN_DIR, 'calibration.c'),
+           os.path.join(MAIN_DIR, 'CAN', 'canDecodeAuto.c'), '-lm', '-Wl,--no-undefined']
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    if result.returncode != 0:
+        print(result.stderr)
+        raise RuntimeError("Failed to build sim_mcp320X.so")
+    for line in result.stderr.splitlines():
+        if 'warning:' in line:
+            print(line)
+    return lib
+
+def load(path, name, work_dir, verbose):
+    """A copy of the library per board, the firmware's scan state lasts as long as it is loaded."""
+    copy = os.path.join(work_dir, name + '.so')
+    shutil.copy(path, copy)
+    lib = ctypes.CDLL(copy)
+    lib.sim_adc_reset(ctypes.c_ulong(1), 1 if verbose else 0)
+    lib.sim_mcp_set_count.argtypes = [ctypes.c_int, ctypes.c_int, ctypes.c_ushort]
+    lib.sim_mcp_set_rate.argtypes = [ctypes.c_ulong]
+    lib.sim_mcp_run.argtypes = [ctypes.c_double]
+    lib.sim_mcp_run.restype = ctypes.c_double
+    lib.sim_mcp_legacy.argtypes = [ctypes.c_ulong, ctypes.POINTER(ctypes.c_void_p), ctypes.POINTER(ctypes.c_ubyte),
+                                   ctypes.c_ushort, ctypes.POINTER(ctypes.c_float)]
+    lib.sim_mcp_legacy.restype = ctypes.c_double
+    lib.MCP320X_init.argtypes = [ctypes.c_ushort, ctypes.POINTER(ctypes.c_ubyte), ctypes.POINTER(ctypes.c_void_p)]
+    lib.MCP320X_scan_init.argtypes = [ctypes.c_ushort, ctypes.POINTER(ctypes.c_void_p),
+                                      ctypes.POINTER(ctypes.c_ubyte), ctypes.c_ushort]
+    lib.MCP320X_get_count.argtypes = [ctypes.c_ubyte, ctypes.c_ubyte]
+    lib.MCP320X_get_count.restype = ctypes.c_ushort
+    lib.MCP320X_read.argtypes = [ctypes.c_void_p, ctypes.c_ubyte]
+    lib.MCP320X_read.restype = ctypes.c_float
+    lib.MCP320X_update_temp_monitor.argtypes = [ctypes.c_void_p, ctypes.c_ubyte]
+    lib.MCP320X_thermistor_map.argtypes = [ctypes.c_void_p]
+    lib.MCP320X_report.restype = None
+    return lib
+
+# -----------------------------------------------------------------------------
+# Runs
+# -----------------------------------------------------------------------------
+def stats(lib):
+    out = Stats()
+    lib.MCP320X_get_stats(ctypes.byref(out))
+    return out
+
+def counters(lib):
+    transactions, bad = ctypes.c_ulong(), ctypes.c_ulong()
+    lib.sim_mcp_counters(ctypes.byref(transactions), ctypes.byref(bad))
+    return transactions.value, bad.value
+
+def to_volts(count):
+    return count * VREF / 4096.0
+
+def start(lib, channels, pins):
+    n = len(channels)
+    handles = (ctypes.c_void_p * n)()
+    if lib.MCP320X_init(n, (ctypes.c_ubyte * n)(*pins), handles) != 0:
+        raise RuntimeError("MCP320X_init failed")
+    return handles, (ctypes.c_ubyte * n)(*channels)
+
+def run_legacy(lib, handles, n_channels, expected):
+    total = sum(n_channels)
+    volts = (ctypes.c_float * total)()
+    seconds = lib.sim_mcp_legacy(LEGACY_ROUNDS, handles, n_channels, len(n_channels), volts)
+    bad = sum(1 for got, want in zip(volts, expected) if abs(got - to_volts(want)) > 1e-6)
+    return {'rate': LEGACY_ROUNDS * total / seconds, 'round_us': seconds / LEGACY_ROUNDS * 1e6, 'bad': bad}
+
+def run_rate(lib, hz, seconds):
+    lib.sim_mcp_set_rate(hz)
+    before = stats(lib)
+    elapsed = -lib.sim_mcp_run(0.0)
+    elapsed += lib.sim_mcp_run(seconds)
+    after = stats(lib)
+    scans = after.dwNScans - before.dwNScans
+    return {'hz': hz, 'scans': scans / elapsed, 'samples': (after.dwNSamples - before.dwNSamples) / elapsed,
+            'overruns': after.dwNOverruns - before.dwNOverruns, 'errors': after.dwNErrors - before.dwNErrors,
+            'scan_us': (after.qwNScanus - before.qwNScanus) / scans if scans else 0.0}
+
+def check_counts(lib, handles, n_channels, expected):
+    """Counts and MCP320X_read on the scanned devices against what each channel was set to."""
+    bad = 0
+    n = 0
+    for device, channels in enumerate(n_channels):
+        for channel in range(channels):
+            if lib.MCP320X_get_count(device, channel) != expected[n]:
+                bad += 1
+            if abs(lib.MCP320X_read(handles[device], channel) - to_volts(expected[n])) > 1e-6:
+                bad += 1
+            n += 1
+    return bad
+
+def set_counts(lib, n_channels, counts):
+    n = 0
+    for device, channels in enumerate(n_channels):
+        for channel in range(channels):
+            lib.sim_mcp_set_count(device, channel, counts[n])
+            n += 1
+
+def run_board(args, lib, channels, pins, counts):
+    set_counts(lib, channels, counts)
+    handles, n_channels = start(lib, channels, pins)
+    legacy = run_legacy(lib, handles, n_channels, counts)
+    if lib.MCP320X_scan_init(len(channels), handles, n_channels, args.rate) != 0:
+        raise RuntimeError("MCP320X_scan_init failed")
+    lib.sim_mcp_run(args.seconds)
+    main_rate = run_rate(lib, args.rate, args.seconds)
+    bad = check_counts(lib, handles, n_channels, counts)
+    sweep = [run_rate(lib, hz, args.seconds / 4) for hz in RATES]
+    lib.sim_mcp_set_rate(args.rate)
+    if args.verbose:
+        lib.MCP320X_report()
+    return {'legacy': legacy, 'rate': main_rate, 'sweep': sweep, 'bad': bad, 'handles': handles,
+            'n_channels': n_channels, 'bad_commands': counters(lib)[1]}
+
+def run_dyno(args, lib):
+    counts = [(n * 523 + 111) % 4096 for n in range(sum(DYNO_CHANNELS))]
+    result = run_board(args, lib, DYNO_CHANNELS, DYNO_CS, counts)
+    signals = []
+    for step in range(2):
+        if step:
+            counts = [(c + 1000) % 4096 for c in counts]
+            set_counts(lib, DYNO_CHANNELS, counts)
+            lib.sim_mcp_run(2.0 / args.rate)
+        lib.MCP320X_update_dyno()
+        pressures = (ctypes.c_float * 3).in_dll(lib, 'VDynoPressureRaw')
+        temps = (ctypes.c_float * 3).in_dll(lib, 'VDynoTempRaw')
+        flow = ctypes.c_float.in_dll(lib, 'VDynoCoolantFlowRaw').value
+        got = list(pressures) + [flow] + list(temps)
+        want = [to_volts(c) for c in counts[:4] + counts[4:7]]
+        signals.append(sum(1 for g, w in zip(got, want) if abs(g - w) > 1e-6))
+    result['bad_signals'] = signals
+    return result
+
+def thermistor_count(degrees):
+    ohms = R25 * math.exp(BETA * (1.0 / (degrees + 273.15) - 1.0 / 298.15))
+    return round(ohms / (ohms + PULLUP) * 4096.0)
+
+def run_temp_monitor(args, lib):
+    counts = [thermistor_count(t) for t in TEMPS]
+    result = run_board(args, lib, TEMP_CHANNELS, TEMP_CS, counts)
+    thermistor_map = ctypes.addressof(ctypes.c_char.in_dll(lib, 'stThermistorMap'))
+    result['map'] = lib.MCP320X_thermistor_map(thermistor_map)
+    lib.MCP320X_update_temp_monitor(thermistor_map, FIRST_CELL)
+    cells = (ctypes.c_byte * 110).in_dll(lib, 'TCell')
+    got = list(cells[FIRST_CELL:FIRST_CELL + len(TEMPS)])
+    result['cells'] = got
+    result['worst_c'] = max(abs(g - t) for g, t in zip(got, TEMPS))
+    result['summary'] = (ctypes.c_byte.in_dll(lib, 'TCellMin').value, ctypes.c_byte.in_dll(lib, 'TCellMax').value,
+                         ctypes.c_ubyte.in_dll(lib, 'NTCellMinID').value, ctypes.c_ubyte.in_dll(lib, 'NTCellMaxID').value)
+    return result
+
+# -----------------------------------------------------------------------------
+# Main Execution
+# -----------------------------------------------------------------------------
+def report_board(name, r, args):
+    total = sum(r['n_channels'])
+    print(f"=== {name}, {len(r['n_channels'])} devices, {total} channels ===")
+    print(f"Old MCP320X_read:     {r['legacy']['rate']:8.0f} samples/s, {r['legacy']['round_us']:.0f} us for every "
+          f"channel, {r['legacy']['bad']} wrong")
+    print(f"{'Rate':>8}{'Scans/s':>10}{'Samples/s':>11}{'Overruns':>10}{'Scan us':>9}")
+    for s in [r['rate']] + r['sweep']:
+        print(f"{s['hz']:>8}{s['scans']:10.0f}{s['samples']:11.0f}{s['overruns']:10}{s['scan_us']:9.1f}")
+    print(f"Counts and reads:     {r['bad']} wrong, {r['bad_commands']} bad commands")
+    rate = r['rate']
+    return (r['legacy']['bad'] == 0 and r['bad'] == 0 and r['bad_commands'] == 0 and rate['overruns'] == 0 and
+            rate['errors'] == 0 and abs(rate['scans'] - args.rate) <= args.rate * 0.01)
+
+def main():
+    parser = argparse.ArgumentParser(description="Run mcp320X.c's scanning on the PC in virtual time")
+    parser.add_argument('--rate', type=int, default=1000, help="Scans/s (default 1000, MCP320X_SCAN_HZ)")
+    parser.add_argument('--seconds', type=float, default=2.0, help="Virtual seconds at --rate")
+    parser.add_argument('--verbose', action='store_true', help="Show MCP320X_report's log")
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        path = build(work_dir)
+        dyno = run_dyno(args, load(path, 'dyno', work_dir, args.verbose))
+        temp = run_temp_monitor(args, load(path, 'temp_monitor', work_dir, args.verbose))
+
+    passed = report_board("Dyno", dyno, args)
+    print(f"Dyno signals:         {dyno['bad_signals'][0]} wrong, {dyno['bad_signals'][1]} wrong after the counts change")
+    passed = passed and dyno['bad_signals'] == [0, 0]
+    print()
+    passed = report_board("Temperature monitor", temp, args) and passed
+    print(f"TCell:                {temp['cells']} for {TEMPS}, worst {temp['worst_c']:.1f} C")
+    print(f"Min, max:             {temp['summary'][0]} C cell {temp['summary'][2]}, "
+          f"{temp['summary'][1]} C cell {temp['summary'][3]}")
+    passed = (passed and temp['map'] == 0 and temp['worst_c'] <= 1.0 and
+              temp['summary'] == (round(min(TEMPS)), round(max(TEMPS)), FIRST_CELL, FIRST_CELL + len(TEMPS) - 1))
+    print(f"\n{'PASS' if passed else 'FAIL'}")
+    return 0 if passed else 1
+
+if __name__ == '__main__':
+    sys.exit(main())
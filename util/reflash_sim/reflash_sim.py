@@ -0,0 +1,455 @@
+import sys
+import os
+import time
+import random
+import shutil
+import zlib
+import ctypes
+import _ctypes
+import argparse
+import tempfile
+import threading
+import subprocess
+import queue
+
+###
+# SFR ESP32 Reflash Simulator
+# Runs the reflash firmware on the PC so a reflash protocol change can be checked and benchmarked
+# without a car. The real firmware in FIRMWARE_SOURCES (CAN, ESP-NOW, calibration tables and the tasks) is compiled
+# against the stubs in stubs/ and sim_platform.c, once per node with DEVICE_ID set, and loaded
+# with ctypes. The OTA partition of each node is a file and its NVS is a directory so both
+# survive a simulated power cut, which reloads the library like a reboot.
+#
+# The host side is the real flasher: CAN_flash.py talks to the nodes over python-can's virtual
+# bus and ESPNOW_flash.py talks to them through a simulated pit bridge.
+#
+# Faults are injected per node, host to node and node to host separately:
+#    --loss 0.01        Drop 1% of frames in each direction
+#    --loss-to-node / --loss-to-host   Drop frames in one direction only
+#    --corrupt 0.005    Flip a bit in 0.5% of the reflash data frames sent to the nodes
+#    --power-cut 0.5    Cut power to every node once half of the binary is written
+#
+# At the end it reports the time, KB/s, frames on the bus against the minimum needed, and
+# checks every node booted an image identical to the binary.
+#
+# Examples:
+#    python reflash_sim.py --mode unicast --size 65536 --loss 0.01
+#    python reflash_sim.py --mode multicast --nodes 0x11,0x12,0x13 --corrupt 0.01 --power-cut 0.5
+#    python reflash_sim.py --benchmark          Standard set of runs, use for every protocol change
+#
+
+# -----------------------------------------------------------------------------
+# Configuration
+# -----------------------------------------------------------------------------
+SIM_DIR = os.path.dirname(os.path.abspath(__file__))
+UTIL_DIR = os.path.dirname(SIM_DIR)
+PROJECT_ROOT = os.path.dirname(UTIL_DIR)
+MAIN_DIR = os.path.join(PROJECT_ROOT, 'main')
+FIRMWARE_SOURCES = ['CAN/canflash.c', 'CAN/can.c', 'CAN/canDecodeAuto.c', 'tasks.c', 'espnow.c', 'espnowflash.c', 'espnowtelem.c', 'espnowcodec.c', 'espnowlink.c', 'calibration.c']
+CC = os.environ.get('CC', 'gcc')
+
+PARTITION_SIZE = 0x1E0000      # Same as the ota_1 partition
+ERASE_TIME_US = 25000          # Per 4 KB sector, typical for the ESP32-C6 flash
+WRITE_TIME_US = 30             # Per write call
+WRITE_BYTE_TIME_NS = 1500      # Per byte, about 0.4 ms for a 256 byte page
+VIRTUAL_CHANNEL = 'reflash_sim'
+HOST_MAC = bytes([0x02, 0x00, 0x00, 0x00, 0x00, 0x01])
+CAN_BITRATE = 1000000
+REFLASH_SEQ_MASK = 0x001FFFFF  # Must match firmware canflash.h
+STANDARD_FRAME_BITS = 111      # 8 data bytes with typical stuffing
+EXTENDED_FRAME_BITS = 131
+RESTART_ATTEMPTS = 3           # Reflash attempts after a power cut
+
+BENCHMARK = [
+    # (name, mode, nodes, (loss to node, loss to host), corrupt, power cut)
+    ("unicast clean",           'unicast',   [0x11],             (0.0, 0.0),    0.0,   None),
+    ("unicast 1% loss to node", 'unicast',   [0x11],             (0.01, 0.0),   0.005, None),
+    ("unicast 1% ACKs lost",    'unicast',   [0x11],             (0.0, 0.01),   0.0,   None),
+    ("unicast power cut",       'unicast',   [0x11],             (0.0, 0.0),    0.0,   0.5),
+    ("multicast 3 nodes clean", 'multicast', [0x11, 0x12, 0x13], (0.0, 0.0),    0.0,   None),
+    ("multicast 3 nodes 2%",    'multicast', [0x11, 0x12, 0x13], (0.02, 0.02),  0.005, None),
+    ("multicast power cut",     'multicast', [0x11, 0x12],       (0.01, 0.01),  0.0,   0.5),
+    ("espnow clean",            'espnow',    [0x11],             (0.0, 0.0),    0.0,   None),
+    ("espnow 5% loss",          'espnow',    [0x11],             (0.05, 0.05),  0.0,   None),
+]
+
+sys.path.insert(0, UTIL_DIR)
+import can
+try:
+    import serial  # noqa: F401
+except ImportError:
+    # ESPNOW_flash.py only needs pyserial for the real bridge
+    import types
+    sys.modules['serial'] = types.ModuleType('serial')
+import CAN_flash
+import ESPNOW_flash
+
+# -----------------------------------------------------------------------------
+# Firmware build
+# -----------------------------------------------------------------------------
+_shown_warnings = set()
+
+def build_node(device_id, build_dir, sources=FIRMWARE_SOURCES):
+    """Compiles the reflash firmware for one device ID, returns the path of the library."""
+    out = os.path.join(build_dir, f'node_{device_id:02X}.so')
+    cmd = [CC, '-shared', '-fPIC', '-O2', '-Wall', '-Wextra', f'-DDEVICE_ID=0x{device_id:02X}',
+           '-I', os.path.join(SIM_DIR, 'stubs'), '-I', MAIN_DIR, '-I', os.path.join(MAIN_DIR, 'CAN'),
+           '-o', out]
+    cmd += [os.path.join(MAIN_DIR, source) for source in sources]
+    cmd += [os.path.join(SIM_DIR, 'sim_platform.c'), '-Wl,--no-undefined']
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    if result.returncode != 0:
+        print(result.stderr)
+        raise RuntimeError(f"Failed to build node 0x{device_id:02X}")
+    # Every case rebuilds the nodes, so show each warning once a run
+    for line in result.stderr.splitlines():
+        if 'warning:' in line and line not in _shown_warnings:
+            _shown_warnings.add(line)
+            print(line)
+    return out
+
+# -----------------------------------------------------------------------------
+# Fault injection
+# -----------------------------------------------------------------------------
+class Faults:
+    def __init__(self, loss_to_node, loss_to_host, corrupt, seed):
+        self.loss = {True: loss_to_node, False: loss_to_host}
+        self.corrupt = corrupt
+        self.random = random.Random(seed)
+        self.dropped = 0
+        self.corrupted = 0
+
+    def drop(self, to_node):
+        if self.loss[to_node] > 0 and self.random.random() < self.loss[to_node]:
+            self.dropped += 1
+            return True
+        return False
+
+    def mangle(self, data):
+        """Flips one bit of a reflash data frame."""
+        if self.corrupt > 0 and self.random.random() < self.corrupt:
+            data = bytearray(data)
+            bit = self.random.randrange(len(data) * 8)
+            data[bit // 8] ^= 1 << (bit % 8)
+            self.corrupted += 1
+        return bytes(data)
+
+def is_data_frame(msg, device_id):
+    if not msg.is_extended_id:
+        return False
+    if (msg.arbitration_id & ~REFLASH_SEQ_MASK) == CAN_flash.REFLASH_MULTICAST_ID:
+        return True
+    return (msg.arbitration_id & ~CAN_flash.REFLASH_OFFSET_MASK) == \
+        CAN_flash.REFLASH_UNICAST_ID | (device_id & 0xFF) << CAN_flash.REFLASH_NODE_SHIFT
+
+# -----------------------------------------------------------------------------
+# Simulated node
+# -----------------------------------------------------------------------------
+class Node:
+    """One ESP32 running the reflash firmware, on its own thread like app_main."""
+    def __init__(self, device_id, library, work_dir, faults, log_level, power_cut_bytes):
+        self.device_id = device_id
+        self.library = library
+        self.flash_path = os.path.join(work_dir, f'node_{device_id:02X}_ota.bin')
+        self.nvs_dir = os.path.join(work_dir, f'node_{device_id:02X}_nvs')
+        os.makedirs(self.nvs_dir, exist_ok=True)
+        self.mac = bytes([0x02, 0x00, 0x00, 0x00, 0x00, device_id])
+        self.faults = faults
+        self.log_level = log_level
+        self.power_cut_bytes = power_cut_bytes
+        self.work_dir = work_dir
+        self.boots = 0
+        self.lib = None
+        self.espnow_in = queue.Queue()
+        self.espnow_out = None
+        self.bus = can.Bus(interface='virtual', channel=VIRTUAL_CHANNEL)
+        self.frames_sent = 0
+        self.restarted = False
+        self.boot_set = False
+        self.stop_event = threading.Event()
+        self.thread = threading.Thread(target=self.run, daemon=True)
+
+    def power_on(self):
+        # A fresh copy of the library gives fresh globals, like a reboot
+        self.boots += 1
+        path = os.path.join(self.work_dir, f'node_{self.device_id:02X}_boot{self.boots}.so')
+        shutil.copyfile(self.library, path)
+        self.lib = ctypes.CDLL(path)
+        self.lib.sim_init.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.c_uint32, ctypes.c_char_p,
+                                      ctypes.c_char_p, ctypes.c_int]
+        self.lib.sim_set_delays.argtypes = [ctypes.c_uint32, ctypes.c_uint32, ctypes.c_uint32]
+        self.lib.sim_can_rx.argtypes = [ctypes.c_uint32, ctypes.c_int, ctypes.c_int, ctypes.c_char_p]
+        self.lib.sim_can_tx_pop.argtypes = [ctypes.POINTER(ctypes.c_uint32), ctypes.POINTER(ctypes.c_int), ctypes.c_char_p]
+        self.lib.sim_espnow_rx.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int]
+        self.lib.sim_espnow_tx_pop.argtypes = [ctypes.c_char_p, ctypes.c_char_p]
+        result = self.lib.sim_init(self.flash_path.encode(), self.nvs_dir.encode(), PARTITION_SIZE, self.mac,
+                                   f'[0x{self.device_id:02X}]'.encode(), self.log_level)
+        if result != 0:
+            raise RuntimeError(f"Node 0x{self.device_id:02X} failed to start")
+        self.lib.sim_set_delays(ERASE_TIME_US, WRITE_TIME_US, WRITE_BYTE_TIME_NS)
+        self.bytes_written = ctypes.c_uint32.in_dll(self.lib, 'dwBytesWrittenReflash')
+
+    def power_off(self):
+        self.lib.sim_close()
+        _ctypes.dlclose(self.lib._handle)
+        self.lib = None
+
+    def start(self):
+        self.power_on()
+        self.thread.start()
+
+    def stop(self):
+        self.stop_event.set()
+        self.thread.join()
+        self.bus.shutdown()
+
+    def run(self):
+        frame_id = ctypes.c_uint32()
+        extended = ctypes.c_int()
+        buffer = ctypes.create_string_buffer(256)
+        mac = ctypes.create_string_buffer(6)
+        while not self.stop_event.is_set():
+            busy = False
+            # Host to node
+            while (msg := self.bus.recv(timeout=0)) is not None:
+                busy = True
+                if self.faults.drop(True):
+                    continue
+                data = bytes(msg.data)
+                if is_data_frame(msg, self.device_id):
+                    data = self.faults.mangle(data)
+                self.lib.sim_can_rx(msg.arbitration_id, int(msg.is_extended_id), len(data), data)
+            while not self.espnow_in.empty():
+                busy = True
+                source, payload = self.espnow_in.get()
+                self.lib.sim_espnow_rx(source, payload, len(payload))
+
+            self.lib.sim_run_bg()
+
+            # Node to host
+            while (dlc := self.lib.sim_can_tx_pop(ctypes.byref(frame_id), ctypes.byref(extended), buffer)) >= 0:
+                busy = True
+                self.frames_sent += 1
+                if not self.faults.drop(False):
+                    self.bus.send(can.Message(arbitration_id=frame_id.value, is_extended_id=bool(extended.value),
+                                              data=buffer.raw[:dlc]))
+            while (length := self.lib.sim_espnow_tx_pop(mac, buffer)) >= 0:
+                busy = True
+                if self.espnow_out is not None and not self.faults.drop(False):
+                    self.espnow_out.put((mac.raw, buffer.raw[:length]))
+
+            if self.lib.sim_restarted():
+                self.restarted = True
+                self.boot_set = bool(self.lib.sim_boot_set())
+                break
+            if self.power_cut_bytes is not None and self.bytes_written.value >= self.power_cut_bytes:
+                print(f"\n*** Power cut on node 0x{self.device_id:02X} at {self.bytes_written.value} bytes ***")
+                self.power_cut_bytes = None
+                self.power_off()
+                time.sleep(0.2)
+                self.power_on()
+            if not busy:
+                time.sleep(0.0002)
+
+    def image(self, size):
+        with open(self.flash_path, 'rb') as f:
+            return f.read(size)
+
+class CountingBus:
+    """Host side of the virtual bus, counts what the flasher puts on the bus."""
+    def __init__(self):
+        self.bus = can.Bus(interface='virtual', channel=VIRTUAL_CHANNEL)
+        self.frames = 0
+        self.bits = 0
+
+    def send(self, msg, timeout=None):
+        self.frames += 1
+        self.bits += EXTENDED_FRAME_BITS if msg.is_extended_id else STANDARD_FRAME_BITS
+        self.bus.send(msg, timeout)
+
+    def recv(self, timeout=None):
+        return self.bus.recv(timeout)
+
+    def shutdown(self):
+        self.bus.shutdown()
+
+class SimBridge:
+    """Pit bridge for ESPNOW_flash.py, passes packets straight to the node."""
+    def __init__(self, node):
+        self.node = node
+        self.mac = node.mac
+        self.packets = queue.Queue()
+        self.frames = 0
+        node.espnow_out = self.packets
+
+    def send(self, payload):
+        self.frames += 1
+        if not self.node.faults.drop(True):
+            self.node.espnow_in.put((HOST_MAC, bytes(payload)))
+
+    def recv(self, timeout):
+        # Like the real bridge only reflash packets reach the laptop, telemetry goes to the pit bus
+        deadline = time.time() + timeout
+        while True:
+            try:
+                _, payload = self.packets.get(timeout=max(deadline - time.time(), 0))
+            except queue.Empty:
+                return None
+            if payload[0] == ESPNOW_flash.ESPNOW_FLASH_PACKET:
+                return payload
+
+    def close(self):
+        pass
+
+# -----------------------------------------------------------------------------
+# Runs
+# -----------------------------------------------------------------------------
+def run(mode, nodes, firmware_data, losses, corrupt, power_cut, seed=1, log_level=1, window=ESPNOW_flash.WINDOW_PACKETS):
+    """Reflashes the simulated nodes, returns a dict of results."""
+    work_dir = tempfile.mkdtemp(prefix='reflash_sim_')
+    firmware_size = len(firmware_data)
+    power_cut_bytes = int(power_cut * firmware_size) if power_cut is not None else None
+    results = {}
+    try:
+        sim_nodes = []
+        for index, device_id in enumerate(nodes):
+            library = build_node(device_id, work_dir)
+            faults = Faults(losses[0], losses[1], corrupt, seed * 100 + index)
+            sim_nodes.append(Node(device_id, library, work_dir, faults, log_level, power_cut_bytes))
+        host = CountingBus()
+        for node in sim_nodes:
+            node.start()
+
+        start_time = time.time()
+        ok = False
+        attempts = 0
+        while not ok and attempts < (RESTART_ATTEMPTS if power_cut is not None else 1):
+            attempts += 1
+            try:
+                if mode == 'unicast':
+                    ok = CAN_flash.flash_unicast(host, firmware_data, nodes[0])
+                elif mode == 'multicast':
+                    ok = CAN_flash.flash_multicast(host, firmware_data, nodes)
+                else:
+                    bridge = SimBridge(sim_nodes[0])
+                    ok = ESPNOW_flash.flash_espnow(bridge, firmware_data, nodes[0], window)
+                    host.frames += bridge.frames
+            except TimeoutError as e:
+                print(f"\nAttempt {attempts} failed: {e}")
+            # Give the nodes time to boot the new image
+            deadline = time.time() + ESPNOW_flash.COMMIT_TIMEOUT
+            while ok and time.time() < deadline and not all(node.restarted for node in sim_nodes):
+                time.sleep(0.01)
+        duration = time.time() - start_time
+
+        for node in sim_nodes:
+            node.stop()
+        host.shutdown()
+
+        # Minimum traffic: every chunk once plus the enter command
+        if mode == 'espnow':
+            needed = -(-firmware_size // ESPNOW_flash.MAX_DATA)
+        else:
+            needed = -(-firmware_size // CAN_flash.CHUNK_SIZE)
+        images_ok = [node.restarted and node.boot_set and node.image(firmware_size) == firmware_data
+                     for node in sim_nodes]
+        results = {
+            'ok': ok and all(images_ok),
+            'duration': duration,
+            'kbs': firmware_size / 1024 / duration,
+            'host_frames': host.frames,
+            'needed_frames': needed,
+            'node_frames': sum(node.frames_sent for node in sim_nodes),
+            'bus_time': host.bits / CAN_BITRATE if mode != 'espnow' else None,
+            'attempts': attempts,
+            'dropped': sum(node.faults.dropped for node in sim_nodes),
+            'corrupted': sum(node.faults.corrupted for node in sim_nodes),
+            'images_ok': images_ok,
+        }
+    finally:
+        shutil.rmtree(work_dir, ignore_errors=True)
+    return results
+
+def print_results(results, nodes):
+    print("\n=== Simulation Results ===")
+    print(f"Time Elapsed: {results['duration']:.2f}s ({results['attempts']} attempt(s))")
+    print(f"Average Speed: {results['kbs']:.2f} KB/s")
+    retries = results['host_frames'] - results['needed_frames']
+    print(f"Host frames: {results['host_frames']} for {results['needed_frames']} chunks "
+          f"({retries} retries/overhead, {100 * retries / results['needed_frames']:.1f}%)")
+    print(f"Node frames: {results['node_frames']}")
+    if results['bus_time'] is not None:
+        print(f"Host bus time at {CAN_BITRATE // 1000} kbit/s: {results['bus_time']:.2f}s")
+    print(f"Faults injected: {results['dropped']} dropped, {results['corrupted']} corrupted")
+    for node, image_ok in zip(nodes, results['images_ok']):
+        print(f"Node 0x{node:02X}: {'image matches, booted' if image_ok else 'IMAGE MISMATCH OR NOT BOOTED'}")
+    print("PASS" if results['ok'] else "FAIL")
+
+def benchmark(firmware_data, seed, log_level):
+    rows = []
+    for name, mode, nodes, losses, corrupt, power_cut in BENCHMARK:
+        print(f"\n##### {name} #####")
+        results = run(mode, nodes, firmware_data, losses, corrupt, power_cut, seed, log_level)
+        rows.append((name, results))
+    print("\n=== Benchmark ===")
+    print(f"{'Run':<26}{'Result':<8}{'Time s':>8}{'KB/s':>8}{'Retries':>9}{'Bus s':>8}")
+    all_ok = True
+    for name, results in rows:
+        retries = results['host_frames'] - results['needed_frames']
+        bus_time = f"{results['bus_time']:.2f}" if results['bus_time'] is not None else '-'
+        print(f"{name:<26}{'PASS' if results['ok'] else 'FAIL':<8}{results['duration']:>8.2f}"
+              f"{results['kbs']:>8.2f}{retries:>9}{bus_time:>8}")
+        all_ok = all_ok and results['ok']
+    return all_ok
+
+# -----------------------------------------------------------------------------
+# Main Execution
+# -----------------------------------------------------------------------------
+def parse_args():
+    parser = argparse.ArgumentParser(description="SFR ESP32 Reflash Simulator")
+    parser.add_argument('--bin', help="Binary to flash, a random one of --size bytes if not given")
+    parser.add_argument('--size', type=lambda x: int(x, 0), default=65536, help="Size of the random binary")
+    parser.add_argument('--mode', choices=['unicast', 'multicast', 'espnow'], default='unicast')
+    parser.add_argument('--nodes', default='0x11', help="Comma separated device IDs, eg 0x11,0x12")
+    parser.add_argument('--loss', type=float, default=0.0, help="Chance of dropping each frame")
+    parser.add_argument('--loss-to-node', type=float, default=None, help="Overrides --loss from host to node")
+    parser.add_argument('--loss-to-host', type=float, default=None, help="Overrides --loss from node to host")
+    parser.add_argument('--corrupt', type=float, default=0.0, help="Chance of a bit error in each data frame")
+    parser.add_argument('--power-cut', type=float, default=None, help="Cut power once this fraction is written")
+    parser.add_argument('--window', type=int, default=ESPNOW_flash.WINDOW_PACKETS, help="ESP-NOW packets in flight")
+    parser.add_argument('--seed', type=int, default=1, help="Seed for the faults and random binary")
+    parser.add_argument('--verbose', action='store_true', help="Show all firmware logs")
+    parser.add_argument('--benchmark', action='store_true', help="Run the standard benchmark set")
+    return parser.parse_args()
+
+def main():
+    args = parse_args()
+    print("\n=== SFR ESP32 Reflash Simulator ===")
+    if args.bin:
+        with open(args.bin, 'rb') as f:
+            firmware_data = f.read()
+    else:
+        firmware_data = random.Random(args.seed).randbytes(args.size)
+    print(f"Firmware Size: {len(firmware_data)} bytes, CRC32 0x{zlib.crc32(firmware_data) & 0xFFFFFFFF:08X}")
+    log_level = 2 if args.verbose else 1
+
+    # Quieter timing for the simulated nodes, they enter reflash mode straight away
+    CAN_flash.ESP32_REFLASH_DELAY = 0.1
+
+    if args.benchmark:
+        ok = benchmark(firmware_data, args.seed, log_level)
+    else:
+        nodes = [int(node, 0) for node in args.nodes.split(',')]
+        if args.mode != 'multicast' and len(nodes) != 1:
+            print("Error: unicast and ESP-NOW runs take a single node")
+            sys.exit(1)
+        losses = (args.loss if args.loss_to_node is None else args.loss_to_node,
+                  args.loss if args.loss_to_host is None else args.loss_to_host)
+        results = run(args.mode, nodes, firmware_data, losses, args.corrupt, args.power_cut,
+                      args.seed, log_level, args.window)
+        print_results(results, nodes)
+        ok = results['ok']
+    sys.exit(0 if ok else 1)
+
+if __name__ == "__main__":
+    main()
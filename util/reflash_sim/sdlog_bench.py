@@ -0,0 +1,639 @@
+import os
+import re
+import sys
+import time
+import zlib
+import shutil
+import struct
+import ctypes
+import argparse
+import tempfile
+import subprocess
+
+###
+# SFR SD Logger Benchmark
+# Runs main/sdcard.c on the PC against a file backed stand in for the SD card and reports what it
+# can log. sim_sdcard.c gives the writer task a thread and makes every write() and fsync() take as
+# long as it would on an SPI mode card at the clock the firmware mounts it at, so the writer and the
+# producers race each other as they would on the car. Writes that grow the file pay for FATFS
+# allocating clusters, see sim_sdcard.c.
+#
+# A producer thread, standing in for the CAN Rx callback, logs --rate frames/s for --seconds, each
+# carrying its sequence number. At the end the power is cut: what the card would show is worked out
+# from the last sync, then the writer is given time to finish and the file is checked for every
+# frame the logger took, in order.
+#
+# Reports frames taken and refused, the producer's cost per frame, the longest the background loop
+# was held up, the card's writes, how busy it was, the firmware's write time histogram, the log's
+# bytes per frame and the frames a power cut at the end would lose. A quarter of the frames have
+# 29 bit IDs, which the v2 file must keep. The old logger, fwrite per entry through a 16 KB stdio
+# buffer from the background loop at 10 kHz, runs alongside for comparison unless --no-legacy.
+#
+# The logger is started with SD_card_init just before the producer, which mounts the card in the
+# background, and the times to the first frame taken and on the card are reported. Four more
+# boots check the log numbers kept in NVS and the fall back to scanning the card.
+#
+# The logger runs twice, first growing its file as it writes (SD_LOG_FILE_KB 0), then writing into
+# a pre-allocated one, and the write and sync times of the two are compared. With --roll-kb it runs
+# again with files that small so it has to roll from one to the next while logging.
+#
+# The logger's file is then closed with SD_card_close and queried through its index. Last a log of
+# --index-mb is made the way the logger writes one and a time window and IDs are pulled out of it
+# through the footer, then again after cutting the footer and tail off as a power cut would, to
+# time sdlog.py against a full decode.
+#
+# The capture ring is armed on its own with --heap-kb free, logs --capture-rate frames/s and then
+# --rate with a kill frame once the ring has filled, and its file is checked for the frames from
+# SD_CAPTURE_PRE_MS before the kill to SD_CAPTURE_POST_MS after, or as many as the ring held. The
+# ring's memory and the time to latch, freeze and write the capture are reported.
+#
+# Frame blocks are compressed as the firmware is built, SD_LOG_COMPRESS. The pre-allocated run is
+# made again with it off and the card's bytes, writes and write times of the two compared, with the
+# compression ratio and the cycles per KB on the PC. The C6's cycles per KB are in the firmware's
+# own SD_log_report.
+#
+# --block, --sync-ms and --file-kb rebuild the firmware with SD_LOG_BLOCK_SIZE, SD_LOG_SYNC_MS and
+# SD_LOG_FILE_KB changed, --rate 0 logs as fast as the logger takes frames.
+#
+# Examples:
+#    python sdlog_bench.py
+#    python sdlog_bench.py --rate 0 --seconds 2 --no-legacy --index-mb 0
+#    python sdlog_bench.py --sync-ms 100 --block 32768
+#    python sdlog_bench.py --rate 0 --seconds 5 --roll-kb 4096 --no-legacy --index-mb 0
+#
+
+# -----------------------------------------------------------------------------
+# Configuration
+# -----------------------------------------------------------------------------
+SIM_DIR = os.path.dirname(os.path.abspath(__file__))
+MAIN_DIR = os.path.abspath(os.path.join(SIM_DIR, '..', '..', 'main'))
+CC = os.environ.get('CC', 'gcc')
+
+LEGACY_CLOCK_KHZ = 10          # SDMMC_FREQ before the writer task
+HIST_BUCKETS = 16
+SETTLE_S = 0.5                 # On top of the sync interval for the writer to finish
+SYNTH_FRAME_US = 125           # 8000 frames/s
+SYNTH_RARE_ID = 0x7F0
+SYNTH_RARE_EVERY = 1000
+SYNTH_SCAN_MB = 16
+
+sys.path.insert(0, os.path.dirname(SIM_DIR))
+import sdlog
+
+class SimSDResult(ctypes.Structure):
+    _fields_ = [('dwNProduced', ctypes.c_ulong), ('dwNRejected', ctypes.c_ulong),
+                ('qwProducerns', ctypes.c_ulonglong), ('dwProducerMaxns', ctypes.c_ulong),
+                ('dwBGStallMaxus', ctypes.c_ulong), ('dwNCardWrites', ctypes.c_ulong),
+                ('dwNUnaligned', ctypes.c_ulong), ('qwCardBytes', ctypes.c_ulonglong),
+                ('qwCardBusyus', ctypes.c_ulonglong), ('qwSyncedBytes', ctypes.c_ulonglong),
+                ('qwFileBytes', ctypes.c_ulonglong), ('dwNFATWrites', ctypes.c_ulong),
+                ('qwtKillus', ctypes.c_ulonglong)]
+
+class SDLogStats(ctypes.Structure):
+    _fields_ = [('dwNFrames', ctypes.c_ulong), ('dwNDropped', ctypes.c_ulong),
+                ('dwNWrites', ctypes.c_ulong), ('dwNWriteErrors', ctypes.c_ulong),
+                ('dwNSyncs', ctypes.c_ulong), ('qwNBytesWritten', ctypes.c_ulonglong),
+                ('dwWriteMaxus', ctypes.c_ulong), ('dwSyncMaxus', ctypes.c_ulong),
+                ('dwNFiles', ctypes.c_ulong), ('dwRollMaxus', ctypes.c_ulong),
+                ('qwtFirstFrameus', ctypes.c_ulonglong), ('qwtMountedus', ctypes.c_ulonglong),
+                ('qwtFirstWrittenus', ctypes.c_ulonglong), ('qwNRawBytes', ctypes.c_ulonglong),
+                ('qwNPackedBytes', ctypes.c_ulonglong), ('qwNCompressCycles', ctypes.c_ulonglong),
+                ('adwNWriteus', ctypes.c_ulong * HIST_BUCKETS),
+                ('adwNSyncus', ctypes.c_ulong * HIST_BUCKETS)]
+
+class SDCaptureStats(ctypes.Structure):
+    _fields_ = [('dwRingFrames', ctypes.c_ulong), ('dwRingBytes', ctypes.c_ulong),
+                ('dwHeapLeft', ctypes.c_ulong), ('dwNTriggers', ctypes.c_ulong),
+                ('dwNIgnored', ctypes.c_ulong), ('dwNFiles', ctypes.c_ulong),
+                ('dwNWriteErrors', ctypes.c_ulong), ('byCause', ctypes.c_ubyte),
+                ('bySource', ctypes.c_ubyte), ('BPostCut', ctypes.c_int),
+                ('dwNPreFrames', ctypes.c_ulong), ('dwNPostFrames', ctypes.c_ulong),
+                ('dwLatchus', ctypes.c_ulong), ('dwFrozenus', ctypes.c_ulong), ('dwWriteus', ctypes.c_ulong)]
+
+# -----------------------------------------------------------------------------
+# Build
+# -----------------------------------------------------------------------------
+_shown_warnings = set()
+
+def build(work_dir, block, sync_ms, file_kb=None, compress=None):
+    """Compiles sdcard.c with the card mounted under work_dir, returns the library and mount."""
+    mount = os.path.join(work_dir, 'sdcard')
+    with open(os.path.join(MAIN_DIR, 'sdcard.h')) as f:
+        header = f.read()
+    header = re.sub(r'#define SD_MOUNT_POINT "[^"]*"', f'#define SD_MOUNT_POINT "{mount}"', header)
+    if block is not None:
+        header = re.sub(r'#define SD_LOG_BLOCK_SIZE(\s+)\d+', rf'#define SD_LOG_BLOCK_SIZE\g<1>{block}', header)
+    if sync_ms is not None:
+        header = re.sub(r'#define SD_LOG_SYNC_MS(\s+)\d+', rf'#define SD_LOG_SYNC_MS\g<1>{sync_ms}', header)
+    if file_kb is not None:
+        header = re.sub(r'#define SD_LOG_FILE_KB(\s+)\d+', rf'#define SD_LOG_FILE_KB\g<1>{file_kb}', header)
+    if compress is not None:
+        header = re.sub(r'#define SD_LOG_COMPRESS(\s+)\d+', rf'#define SD_LOG_COMPRESS\g<1>{compress}', header)
+    with open(os.path.join(work_dir, 'sdcard.h'), 'w') as f:
+        f.write(header)
+    shutil.copy(os.path.join(MAIN_DIR, 'sdcard.c'), work_dir)
+
+    out = os.path.join(work_dir, 'sdlog.so')
+    cmd = [CC, '-shared', '-fPIC', '-O2', '-Wall', '-Wextra', '-DDEVICE_ID=0x11',
+           '-I', work_dir, '-I', os.path.join(SIM_DIR, 'stubs'), '-I', MAIN_DIR,
+           '-I', os.path.join(MAIN_DIR, 'CAN'), '-o', out,
+           os.path.join(work_dir, 'sdcard.c'), os.path.join(MAIN_DIR, 'sdcompress.c'), os.path.join(SIM_DIR, 'sim_sdcard.c'),
+           '-Wl,--wrap=write', '-Wl,--wrap=pwrite', '-Wl,--wrap=ftruncate', '-Wl,--wrap=fsync', '-lpthread',
+           '-Wl,--no-undefined']
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    if result.returncode != 0:
+        print(result.stderr)
+        raise RuntimeError("Failed to build sdcard.c")
+    # Every run rebuilds, so show each warning once
+    for line in result.stderr.splitlines():
+        if 'warning:' in line and line not in _shown_warnings:
+            _shown_warnings.add(line)
+            print(line)
+    return out, mount
+
+def load(path, verbose):
+    lib = ctypes.CDLL(path)
+    lib.SD_card_init.restype = ctypes.c_int
+    lib.SD_card_close.restype = ctypes.c_int
+    lib.sim_sd_produce.argtypes = [ctypes.c_ulong, ctypes.c_ulong, ctypes.c_int, ctypes.c_char_p,
+                                   ctypes.POINTER(SimSDResult)]
+    lib.sim_sd_result.argtypes = [ctypes.POINTER(SimSDResult)]
+    lib.SD_log_get_stats.argtypes = [ctypes.POINTER(SDLogStats)]
+    lib.SD_capture_init.restype = ctypes.c_int
+    lib.SD_capture_get_stats.argtypes = [ctypes.POINTER(SDCaptureStats)]
+    lib.sim_sd_set_kill.argtypes = [ctypes.c_ulong]
+    lib.sim_sd_set_heap.argtypes = [ctypes.c_ulong]
+    lib.sim_sd_set_clock.argtypes = [ctypes.c_ulong]
+    lib.sim_sd_now_us.restype = ctypes.c_ulonglong
+    lib.sim_sd_set_verbose(1 if verbose else 0)
+    return lib
+
+# -----------------------------------------------------------------------------
+# Log file
+# -----------------------------------------------------------------------------
+def read_sequences(path, length=None):
+    """Sequence numbers of the CAN frames in the file, or its first length bytes."""
+    return [int.from_bytes(data, 'little') for _, data, _ in sdlog.read(path, length)[0]]
+
+def read_log(paths):
+    """Sequence numbers through the files in order, frames whose ID is not the one sim_sd_produce
+    gave it, and the last file's info with the corrupt and compressed blocks of all of them."""
+    frames, corrupt, lz_blocks, size = [], 0, 0, 0
+    for path in paths:
+        file_frames, info = sdlog.read(path)
+        frames += file_frames
+        corrupt += info.get('corrupt', 0)
+        lz_blocks += info.get('lz_blocks', 0)
+        size += os.path.getsize(path)
+    sequences = [int.from_bytes(data, 'little') for _, data, _ in frames]
+    wrong = sum(1 for (can_id, _, _), seq in zip(frames, sequences) if can_id != expected_id(seq))
+    info['bytes_per_frame'] = size / max(len(frames), 1)
+    if 'corrupt' in info:
+        info['corrupt'] = corrupt
+        info['lz_blocks'] = lz_blocks
+    return sequences, wrong, info
+
+def expected_id(seq):
+    return 0x18FEF100 | (seq & 0xFF) if seq & 3 == 3 else 0x100 + seq % 0x6FF
+
+def check_index(path):
+    """Queries through the footer's index against filtering a full decode."""
+    frames, info = sdlog.read(path)
+    entries, source = sdlog.load_index(path)
+    if not frames:
+        return {'entries': len(entries), 'frame_blocks': 0, 'window': 0, 'id': 0, 'ok': source == 'footer'}
+    first, last = frames[0][2], frames[-1][2]
+    start, end = first + (last - first) * 4 // 10, first + (last - first) * 5 // 10
+    window, _, _, _ = sdlog.query(path, start, end)
+    rare = {expected_id(7), expected_id(8)}
+    by_id, _, _, _ = sdlog.query(path, can_ids=rare)
+    want_window = [f for f in frames if start <= f[2] <= end]
+    want_id = [f for f in frames if f[0] in rare]
+    with open(path, 'rb') as f:
+        header = sdlog.read_file_block(f)
+        frame_blocks = len(sdlog.rebuild_index(f, os.path.getsize(path), header['block'], header['file_id'],
+                                               header['valid'])[0])
+    return {
+        'entries': len(entries), 'frame_blocks': frame_blocks, 'window': len(window), 'id': len(by_id),
+        'ok': (source == 'footer' and len(entries) == frame_blocks and window == want_window
+               and by_id == want_id),
+    }
+
+def synth_log(path, megabytes, closed=True):
+    """A v2 log of about megabytes written the way the logger would at SYNTH_FRAME_US a frame, fast
+    enough to make gigabytes. Every SYNTH_RARE_EVERY'th block has one SYNTH_RARE_ID frame."""
+    ids = [0x100 + n for n in range(60)] + [0x18FEF100 + n for n in range(8)]
+    normal, rare = bytearray(), bytearray()
+    offsets = []
+    while sdlog.V2_BLOCK.size + len(normal) + sdlog.MAX_RECORD <= sdlog.BLOCK_SIZE:
+        can_id = ids[len(offsets) % len(ids)]
+        delta = SYNTH_FRAME_US if offsets else 0
+        rare += sdlog.encode_record(SYNTH_RARE_ID if not offsets else can_id, bytes(8), delta)
+        normal += sdlog.encode_record(can_id, bytes(8), delta)
+        offsets.append(len(offsets) * SYNTH_FRAME_US)
+    period = len(offsets) * SYNTH_FRAME_US
+    blooms = {False: sdlog.bloom_of(ids), True: sdlog.bloom_of(ids + [SYNTH_RARE_ID])}
+    n_blocks = megabytes * 1024 * 1024 // sdlog.BLOCK_SIZE
+
+    with open(path, 'wb') as f:
+        state = {'sector': 0, 'sequence': 0}
+
+        def put(block_type, records, n_frames, base_us):
+            header = sdlog.V2_BLOCK.pack(sdlog.V2_MAGIC, block_type, 0, len(records), n_frames, 0,
+                                         state['sequence'], base_us, 0)
+            crc = zlib.crc32(records, zlib.crc32(header[:sdlog.V2_CRC_OFFSET]))
+            block = header[:sdlog.V2_CRC_OFFSET] + struct.pack('<I', crc) + bytes(records)
+            block += bytes(-len(block) % sdlog.SECTOR_SIZE)
+            f.write(block)
+            sector = state['sector']
+            state['sector'] += len(block) // sdlog.SECTOR_SIZE
+            state['sequence'] += 1
+            return sector
+
+        def put_index(entries, previous):
+            records = sdlog.V2_INDEX.pack(previous, len(entries), 0)
+            records += b''.join(sdlog.V2_INDEX_ENTRY.pack(*entry) for entry in entries)
+            return put(sdlog.V2_BLOCK_INDEX, records, 0, entries[0][2])
+
+        # Never synced, so read on block by block as after a power cut
+        put(sdlog.V2_BLOCK_FILE, sdlog.V2_FILE.pack(2, 0, sdlog.SECTOR_SIZE, sdlog.BLOCK_SIZE, 0x11, 0,
+                                                    bytes(7), 0, 0, 0, 0, 0), 0, 0)
+        entries, previous = [], sdlog.NO_SECTOR
+        for n in range(n_blocks):
+            has_rare = n % SYNTH_RARE_EVERY == 0
+            sector = put(sdlog.V2_BLOCK_FRAMES, rare if has_rare else normal, len(offsets), n * period)
+            entries.append((sector, offsets[-1], n * period, blooms[has_rare]))
+            if len(entries) == sdlog.INDEX_ENTRIES:
+                previous, entries = put_index(entries, previous), []
+        if closed:
+            if entries:
+                previous = put_index(entries, previous)
+            footer = sdlog.V2_FOOTER.pack(previous, n_blocks, n_blocks * len(offsets), 0, 0,
+                                          (n_blocks - 1) * period + offsets[-1])
+            put(sdlog.V2_BLOCK_FOOTER, footer, 0, 0)
+    return n_blocks, offsets, period
+
+def run_synth(args, work_dir):
+    """Seeks through the index of a big log against a full decode."""
+    path = os.path.join(work_dir, 'log00000.bin')
+    start = time.perf_counter()
+    n_blocks, offsets, period = synth_log(path, args.index_mb)
+    write_s = time.perf_counter() - start
+
+    # A full decode of a big log takes minutes, time the first SYNTH_SCAN_MB and scale it
+    start = time.perf_counter()
+    with open(path, 'rb') as f:
+        sdlog.read_v2(f.read(SYNTH_SCAN_MB * 1024 * 1024))
+    scan_mb_s = SYNTH_SCAN_MB / (time.perf_counter() - start)
+
+    def timed(**kwargs):
+        start = time.perf_counter()
+        frames, n_read, n_total, source = sdlog.query(path, **kwargs)
+        return frames, n_read, n_total, source, (time.perf_counter() - start) * 1000
+
+    def window_count(start_us, end_us):
+        first, last = max(start_us // period - 1, 0), min(end_us // period + 1, n_blocks - 1)
+        return sum(1 for n in range(first, last + 1) for offset in offsets
+                   if start_us <= n * period + offset <= end_us)
+
+    queries = []
+    ok = True
+    middle = n_blocks * period // 2
+    for name, kwargs, expected in (
+            ("2 s window:", {'start_us': middle, 'end_us': middle + 2000000},
+             window_count(middle, middle + 2000000)),
+            ("Rare ID:", {'can_ids': {SYNTH_RARE_ID}}, -(-n_blocks // SYNTH_RARE_EVERY)),
+            ("ID in a 2 s window:", {'start_us': middle, 'end_us': middle + 2000000, 'can_ids': {0x105}},
+             sum(1 for n in range(n_blocks) for i, offset in enumerate(offsets)
+                 if middle <= n * period + offset <= middle + 2000000 and i % 68 == 5))):
+        frames, n_read, n_total, source, ms = timed(**kwargs)
+        ok &= len(frames) == expected
+        queries.append((name, f"{len(frames)} frames from {n_read} of {n_total} blocks in {ms:.1f} ms "
+                              f"(index {source}), expected {expected}"))
+
+    # Power cut: no footer and the tail not indexed, the first query rebuilds and saves the index
+    size = os.path.getsize(path)
+    with open(path, 'r+b') as f:
+        f.truncate(size - sdlog.SECTOR_SIZE - 4 * sdlog.BLOCK_SIZE)
+    for name in ("Rebuilt 2 s window:", "Saved 2 s window:"):
+        frames, n_read, n_total, source, ms = timed(start_us=middle, end_us=middle + 2000000)
+        ok &= len(frames) == window_count(middle, middle + 2000000)
+        queries.append((name, f"{len(frames)} frames from {n_read} of {n_total} blocks in {ms:.1f} ms "
+                              f"(index {source})"))
+    os.remove(path)
+    os.remove(sdlog.idx_path(path))
+    return {
+        'mb': args.index_mb, 'blocks': n_blocks, 'frames': n_blocks * len(offsets), 'write_s': write_s,
+        'scan_mb_s': scan_mb_s, 'scan_s': args.index_mb / scan_mb_s, 'queries': queries, 'ok': ok,
+    }
+
+def check_order(sequences):
+    """Number of places the sequence goes backwards or repeats."""
+    return sum(1 for before, after in zip(sequences, sequences[1:]) if after <= before)
+
+def log_files(mount):
+    return [os.path.join(mount, name) for name in sorted(os.listdir(mount)) if name.endswith('.bin')]
+
+# -----------------------------------------------------------------------------
+# Runs
+# -----------------------------------------------------------------------------
+def percentile_us(histogram, fraction):
+    """Upper edge of the log2 bucket holding the fraction'th write."""
+    total = sum(histogram)
+    if total == 0:
+        return 0
+    count = 0
+    for bucket, n in enumerate(histogram):
+        count += n
+        if count >= fraction * total:
+            return (2 << bucket) - 1
+    return (2 << (len(histogram) - 1)) - 1
+
+def run_logger(args, work_dir, file_kb, compress=None):
+    path, mount = build(work_dir, args.block, args.sync_ms, file_kb, compress)
+    lib = load(path, args.verbose)
+    boot_us = lib.sim_sd_now_us()
+    if lib.SD_card_init() != 0:
+        raise RuntimeError("SD_card_init failed")
+    result = SimSDResult()
+    lib.sim_sd_produce(args.rate, args.seconds, 0, None, ctypes.byref(result))
+    stats = SDLogStats()
+    lib.SD_log_get_stats(ctypes.byref(stats))
+    paths = log_files(mount)
+    boot = [(t - boot_us) / 1000 if t else None for t in (stats.qwtFirstFrameus, stats.qwtMountedus,
+                                                           stats.qwtFirstWrittenus)]
+
+    # The files before the last are closed, the last as the card shows it with what was written by now
+    taken = result.dwNProduced - result.dwNRejected
+    safe = sum(len(read_sequences(file_path)) for file_path in paths[:-1])
+    safe += len(read_sequences(paths[-1], min(result.qwSyncedBytes, result.qwFileBytes)))
+    sync_ms = args.sync_ms if args.sync_ms is not None else header_value('SD_LOG_SYNC_MS')
+    time.sleep(sync_ms / 1000 + SETTLE_S)
+    closed = lib.SD_card_close() == 0
+    lib.SD_log_get_stats(ctypes.byref(stats))
+    paths = log_files(mount)
+    sequences, wrong_ids, info = read_log(paths)
+    final = SimSDResult()
+    lib.sim_sd_result(ctypes.byref(final))
+    indexes = [check_index(file_path) for file_path in paths] if closed else None
+    return {
+        'result': result, 'final': final, 'taken': taken, 'safe': safe, 'logged': len(sequences),
+        'out_of_order': check_order(sequences), 'writes_us': list(stats.adwNWriteus),
+        'syncs_us': list(stats.adwNSyncus), 'write_max_us': stats.dwWriteMaxus,
+        'sync_max_us': stats.dwSyncMaxus, 'syncs': stats.dwNSyncs, 'errors': stats.dwNWriteErrors,
+        'files': len(paths), 'roll_max_us': stats.dwRollMaxus, 'raw_bytes': stats.qwNRawBytes,
+        'packed_bytes': stats.qwNPackedBytes, 'compress_cycles': stats.qwNCompressCycles, 'boot_ms': boot, 'bg_stall_us': 0, 'expect_all': True,
+        'wrong_ids': wrong_ids, 'info': info, 'index': indexes and {
+            'entries': sum(index['entries'] for index in indexes),
+            'frame_blocks': sum(index['frame_blocks'] for index in indexes),
+            'window': sum(index['window'] for index in indexes), 'id': sum(index['id'] for index in indexes),
+            'ok': all(index['ok'] for index in indexes)},
+    }
+
+def run_legacy(args, work_dir):
+    path, mount = build(work_dir, None, None)
+    lib = load(path, args.verbose)
+    lib.sim_sd_set_clock(args.legacy_khz)
+    os.makedirs(mount, exist_ok=True)
+    file_path = os.path.join(mount, 'log00000.bin')
+    result = SimSDResult()
+    lib.sim_sd_produce(args.rate, args.seconds, 1, file_path.encode(), ctypes.byref(result))
+    taken = result.dwNProduced - result.dwNRejected
+    sequences, wrong_ids, info = read_log([file_path])
+    return {
+        'result': result, 'final': result, 'taken': taken, 'safe': 0, 'logged': len(sequences),
+        'out_of_order': check_order(sequences), 'writes_us': None, 'syncs': 0, 'errors': 0,
+        'bg_stall_us': result.dwBGStallMaxus, 'expect_all': False, 'wrong_ids': 0, 'info': info,
+        'index': None,
+    }
+
+def run_naming(args, work_dir):
+    """Log numbers over four boots: no NVS, NVS, NVS lost, and NVS pointing at a file another
+    logger left on the card. Each boot logs for a second and closes."""
+    path, mount = build(work_dir, args.block, args.sync_ms, args.file_kb)
+    lib = load(path, args.verbose)
+    nvs = mount + '.nvs.sdlog.next'
+    os.makedirs(mount, exist_ok=True)
+    names = []
+    for boot in range(4):
+        if boot == 2:
+            os.remove(nvs)
+        if boot == 3:
+            for name in ('log00003.bin', 'LOG00007.BIN'):
+                open(os.path.join(mount, name), 'wb').close()
+        before = set(os.listdir(mount))
+        if lib.SD_card_init() != 0:
+            raise RuntimeError("SD_card_init failed")
+        result = SimSDResult()
+        lib.sim_sd_produce(2000, 1, 0, None, ctypes.byref(result))
+        if lib.SD_card_close() != 0:
+            raise RuntimeError("SD_card_close failed")
+        names += sorted(set(os.listdir(mount)) - before)
+    return names
+
+def run_capture(args, work_dir, rate):
+    """Arms the capture ring with no log open, logs rate frames/s with a kill frame once the ring
+    has been full for a while, and reads back the capture file it writes."""
+    path, mount = build(work_dir, args.block, None)
+    lib = load(path, args.verbose)
+    pre_ms, post_ms = header_value('SD_CAPTURE_PRE_MS'), header_value('SD_CAPTURE_POST_MS')
+    kill_ms = pre_ms + 1000
+    lib.sim_sd_set_heap(args.heap_kb * 1024)
+    if lib.SD_capture_init() != 0:
+        raise RuntimeError("SD_capture_init failed")
+    lib.sim_sd_set_kill(kill_ms)
+    result = SimSDResult()
+    lib.sim_sd_produce(rate, -(-(kill_ms + post_ms) // 1000), 0, None, ctypes.byref(result))
+    stats = SDCaptureStats()
+    deadline = time.time() + 5
+    while time.time() < deadline:
+        lib.SD_capture_get_stats(ctypes.byref(stats))
+        if stats.dwNFiles or stats.dwNWriteErrors:
+            break
+        time.sleep(0.05)
+    paths = [os.path.join(mount, name) for name in sorted(os.listdir(mount)) if name.startswith('cap')]
+    run = {'rate': rate, 'stats': stats, 'kill_us': result.qwtKillus, 'pre_ms': pre_ms, 'post_ms': post_ms,
+           'paths': paths}
+    if len(paths) == 1:
+        frames, info = sdlog.read(paths[0])
+        run['frames'], run['info'] = frames, info
+        run['query'] = len(sdlog.query(paths[0])[0])
+    return run
+
+def header_value(name):
+    with open(os.path.join(MAIN_DIR, 'sdcard.h')) as f:
+        return int(re.search(rf'#define {name}\s+(\d+)', f.read()).group(1))
+
+# -----------------------------------------------------------------------------
+# Report
+# -----------------------------------------------------------------------------
+def report(name, run, args):
+    result = run['result']
+    final = run['final']
+    produced = max(result.dwNProduced, 1)
+    rate = run['taken'] / args.seconds
+    lost = run['taken'] - run['safe']
+    print(f"\n=== {name} ===")
+    print(f"Frames:               {result.dwNProduced} offered, {run['taken']} taken "
+          f"({run['taken'] / args.seconds:.0f}/s), {result.dwNRejected} refused")
+    print(f"Producer:             {result.qwProducerns / produced:.0f} ns/frame mean, "
+          f"max {result.dwProducerMaxns / 1000:.1f} us")
+    print(f"Background loop held: {run['bg_stall_us'] / 1000:.1f} ms at most")
+    if final.dwNCardWrites:
+        print(f"Card:                 {final.dwNCardWrites} writes of {final.qwCardBytes / final.dwNCardWrites / 1024:.1f} KB, "
+              f"{final.dwNUnaligned} part sector, busy {final.qwCardBusyus / 1e4 / args.seconds:.0f}% "
+              f"({final.qwCardBytes / max(final.qwCardBusyus, 1):.2f} MB/s while busy)")
+    if run['writes_us'] is not None:
+        print(f"Write time:           p50 <{percentile_us(run['writes_us'], 0.5) / 1000:.1f} ms  "
+              f"p99 <{percentile_us(run['writes_us'], 0.99) / 1000:.1f} ms  "
+              f"p99.9 <{percentile_us(run['writes_us'], 0.999) / 1000:.1f} ms  max {run['write_max_us'] / 1000:.1f} ms")
+        print(f"Write us histogram:   {' '.join(str(n) for n in run['writes_us'])}")
+        print(f"Syncs:                {run['syncs']}, p99 <{percentile_us(run['syncs_us'], 0.99) / 1000:.1f} ms  "
+              f"max {run['sync_max_us'] / 1000:.1f} ms, {final.dwNFATWrites} FAT sector writes, {run['errors']} errors")
+        if run['raw_bytes']:
+            print(f"Compression:          {run['raw_bytes'] / 1024:.0f} KB of records in {run['packed_bytes'] / 1024:.0f} KB, "
+                  f"{run['raw_bytes'] / run['packed_bytes']:.2f}:1, {run['info']['lz_blocks']} blocks compressed, "
+                  f"{run['compress_cycles'] * 1024 / run['raw_bytes']:.0f} PC cycles/KB")
+        print(f"Files:                {run['files']}" + (f", longest roll {run['roll_max_us'] / 1000:.1f} ms"
+                                                          if run['files'] > 1 else ""))
+        first, mounted, written = run['boot_ms']
+        print(f"From SD_card_init:    first frame taken {first:.1f} ms, card mounted {mounted:.1f} ms, "
+              f"first frame on the card {written:.1f} ms")
+    print(f"Power cut at the end: {lost} frames lost ({lost / max(rate, 1):.2f} s)"
+          + ("" if run['safe'] else ", nothing synced so FAT shows an empty file"))
+    info = run['info']
+    print(f"Format:               v{info['version']}, {info['bytes_per_frame']:.2f} bytes/frame"
+          + (f", {info['corrupt']} corrupt blocks" if 'corrupt' in info else ", 29 bit IDs truncated"))
+    complete = run['logged'] == run['taken'] if run['expect_all'] else run['logged'] <= run['taken']
+    good = complete and run['out_of_order'] == 0 and run['wrong_ids'] == 0 and info.get('corrupt', 0) == 0
+    print(f"File check:           {run['logged']} frames, {run['out_of_order']} out of order, "
+          f"{run['wrong_ids']} wrong IDs, {'OK' if good else 'FAIL'}")
+    if 'footer' in info:
+        index = run['index']
+        if index is None:
+            print("Index:                SD_card_close failed, FAIL")
+            return False
+        print(f"Index:                footer {'yes' if info['footer'] else 'no'}, {index['entries']} of "
+              f"{index['frame_blocks']} frame blocks, window {index['window']} and ID {index['id']} "
+              f"queries match a full decode, {'OK' if index['ok'] else 'FAIL'}")
+        good &= index['ok'] and info['footer']
+    return good
+
+def report_capture(run):
+    stats = run['stats']
+    rate, kill_us = run['rate'], run['kill_us']
+    print(f"\n=== Capture ring at {rate} frames/s, kill at {kill_us / 1e6:.3f} s ===")
+    print(f"Memory:               {stats.dwRingFrames} frames, {stats.dwRingBytes / 1024:.0f} KB with the write "
+          f"buffer, {stats.dwRingFrames / rate:.2f} s at this rate, {stats.dwHeapLeft / 1024:.0f} KB heap left")
+    if len(run['paths']) != 1 or 'frames' not in run:
+        print(f"Capture file:         {len(run['paths'])} written, {stats.dwNWriteErrors} errors, FAIL")
+        return False
+    frames, info = run['frames'], run['info']
+    trigger = info.get('trigger', {})
+    kills = [frame for frame in frames if frame[0] == 0x001 and len(frame[1]) == 3]
+    sequences = [int.from_bytes(data, 'little') for can_id, data, _ in frames if len(data) == 8]
+    first_ms = (frames[0][2] - kill_us) / 1000
+    last_ms = (frames[-1][2] - kill_us) / 1000
+    gap_ms = 1000 / rate + 1
+    print(f"Captured:             {stats.dwNPreFrames} frames before and {stats.dwNPostFrames} after, "
+          f"{first_ms:.1f} to {last_ms:.1f} ms of the {-run['pre_ms']} to {run['post_ms']} ms asked for"
+          + (", ring full first" if stats.BPostCut else ""))
+    print(f"Latency:              latched {stats.dwLatchus} us after the kill frame, frozen {stats.dwFrozenus / 1000:.1f} ms "
+          f"after it, on the card {stats.dwWriteus / 1000:.1f} ms after that")
+    # The pre window is whole unless the ring held less, the post window unless the ring filled
+    pre_ok = first_ms >= -run['pre_ms'] and (first_ms <= -run['pre_ms'] + gap_ms
+                                             or stats.dwNPreFrames >= stats.dwRingFrames * 0.7)
+    post_ok = last_ms < run['post_ms'] and (last_ms >= run['post_ms'] - gap_ms or stats.BPostCut)
+    good = (len(kills) == 1 and kills[0][2] == kill_us and sequences == list(range(sequences[0], sequences[0] + len(sequences)))
+            and trigger.get('cause') == 1 and trigger.get('trigger_us') == kill_us and info['corrupt'] == 0
+            and info['footer'] and run['query'] == len(frames) and pre_ok and post_ok)
+    print(f"File check:           {os.path.basename(run['paths'][0])}, {len(frames)} frames, kill frame "
+          f"{'in' if len(kills) == 1 else 'missing'}, {'no gaps' if sequences and sequences[-1] - sequences[0] + 1 == len(sequences) else 'gaps'}, "
+          f"index {'matches' if run['query'] == len(frames) else 'does not match'}, {'OK' if good else 'FAIL'}")
+    return good
+
+def report_naming(names):
+    want = ['log00000.bin', 'log00001.bin', 'log00002.bin', 'log00008.bin']
+    print("\n=== Log numbers over four boots ===")
+    print(f"No NVS, NVS, NVS lost, NVS on a used number: {' '.join(names)}, {'OK' if names == want else 'FAIL'}")
+    return names == want
+
+def report_compare(growing, allocated):
+    print("\n=== Pre-allocated file against growing it ===")
+    for name, key, max_key in (("Write", 'writes_us', 'write_max_us'), ("Sync", 'syncs_us', 'sync_max_us')):
+        print(f"{name + ' time:':<22}p99 <{percentile_us(growing[key], 0.99) / 1000:.1f} -> "
+              f"<{percentile_us(allocated[key], 0.99) / 1000:.1f} ms  p99.9 <{percentile_us(growing[key], 0.999) / 1000:.1f} -> "
+              f"<{percentile_us(allocated[key], 0.999) / 1000:.1f} ms  max {growing[max_key] / 1000:.1f} -> "
+              f"{allocated[max_key] / 1000:.1f} ms")
+    print(f"FAT sector writes:    {growing['final'].dwNFATWrites} -> {allocated['final'].dwNFATWrites}")
+    print(f"Power cut at the end: {growing['taken'] - growing['safe']} -> {allocated['taken'] - allocated['safe']} frames lost")
+
+def report_compressed(raw, packed, args):
+    print("\n=== Compressed frame blocks against raw ===")
+    print(f"Card:                 {raw['final'].qwCardBytes / 1024:.0f} -> {packed['final'].qwCardBytes / 1024:.0f} KB "
+          f"in {raw['final'].dwNCardWrites} -> {packed['final'].dwNCardWrites} writes, busy "
+          f"{raw['final'].qwCardBusyus / 1e4 / args.seconds:.0f} -> {packed['final'].qwCardBusyus / 1e4 / args.seconds:.0f}%")
+    print(f"Format:               {raw['info']['bytes_per_frame']:.2f} -> {packed['info']['bytes_per_frame']:.2f} bytes/frame")
+    print(f"Write time:           p99 <{percentile_us(raw['writes_us'], 0.99) / 1000:.1f} -> "
+          f"<{percentile_us(packed['writes_us'], 0.99) / 1000:.1f} ms  max {raw['write_max_us'] / 1000:.1f} -> "
+          f"{packed['write_max_us'] / 1000:.1f} ms")
+
+def report_synth(synth):
+    print(f"\n=== Index on a {synth['mb']} MB log ===")
+    print(f"Written:              {synth['blocks']} frame blocks, {synth['frames']} frames in {synth['write_s']:.1f} s")
+    print(f"Full decode:          {synth['scan_mb_s']:.1f} MB/s, {synth['scan_s']:.0f} s for the whole file")
+    for name, result in synth['queries']:
+        print(f"{name:<22}{result}")
+    print(f"Index check:          {'OK' if synth['ok'] else 'FAIL'}")
+    return synth['ok']
+
+def main():
+    parser = argparse.ArgumentParser(description="Benchmark the SD logger against a modelled card")
+    parser.add_argument('--rate', type=int, default=8000, help="Frames/s, 0 for flat out (default 8000)")
+    parser.add_argument('--seconds', type=int, default=3)
+    parser.add_argument('--block', type=int, help="SD_LOG_BLOCK_SIZE to build with")
+    parser.add_argument('--sync-ms', type=int, help="SD_LOG_SYNC_MS to build with")
+    parser.add_argument('--file-kb', type=int, help="SD_LOG_FILE_KB to build the pre-allocated run with")
+    parser.add_argument('--roll-kb', type=int, default=64,
+                        help="File size for the rolling run, small enough to roll compressed, 0 to skip (default 64)")
+    parser.add_argument('--no-legacy', action='store_true', help="Skip the old logger")
+    parser.add_argument('--legacy-khz', type=int, default=LEGACY_CLOCK_KHZ, help="SPI clock for the old logger")
+    parser.add_argument('--verbose', action='store_true', help="Show the firmware's log")
+    parser.add_argument('--index-mb', type=int, default=1024, help="Size of log to query through its index, 0 to skip")
+    parser.add_argument('--heap-kb', type=int, default=200, help="Free heap for the capture ring (default 200)")
+    parser.add_argument('--capture-rate', type=int, default=2000, help="Frames/s for the capture ring, 0 to skip")
+    args = parser.parse_args()
+
+    passed = True
+    with tempfile.TemporaryDirectory() as work_dir:
+        runs = {}
+        for name, file_kb, compress in (("growing", 0, None), ("allocated", args.file_kb, None),
+                                        ("raw", args.file_kb, 0), ("rolling", args.roll_kb, None)):
+            if name == 'rolling' and not args.roll_kb:
+                continue
+            os.makedirs(os.path.join(work_dir, name))
+            runs[name] = run_logger(args, os.path.join(work_dir, name), file_kb, compress)
+        passed &= report("Writer task, growing the file", runs['growing'], args)
+        passed &= report("Writer task, pre-allocated file", runs['allocated'], args)
+        if 'rolling' in runs:
+            passed &= report(f"Writer task, rolling {args.roll_kb} KB files", runs['rolling'], args)
+            passed &= runs['rolling']['files'] > 1
+        report_compare(runs['growing'], runs['allocated'])
+        passed &= report("Writer task, pre-allocated file, not compressed", runs['raw'], args)
+        report_compressed(runs['raw'], runs['allocated'], args)
+        os.makedirs(os.path.join(work_dir, 'naming'))
+        passed &= report_naming(run_naming(args, os.path.join(work_dir, 'naming')))
+        if args.capture_rate:
+            for rate in (args.capture_rate, args.rate or 8000):
+                os.makedirs(os.path.join(work_dir, f'capture{rate}'), exist_ok=True)
+                passed &= report_capture(run_capture(args, os.path.join(work_dir, f'capture{rate}'), rate))
+        if not args.no_legacy:
+            os.makedirs(os.path.join(work_dir, 'legacy'))
+            passed &= report(f"Old logger at {args.legacy_khz} kHz", run_legacy(args, os.path.join(work_dir, 'legacy')), args)
+        if args.index_mb:
+            passed &= report_synth(run_synth(args, work_dir))
+    print(f"\n{'PASS' if passed else 'FAIL'}")
+    return 0 if passed else 1
+
+if __name__ == '__main__':
+    sys.exit(main())
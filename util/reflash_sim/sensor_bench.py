@@ -0,0 +1,152 @@
+import sys
+import math
+import bisect
+import random
+import struct
+import ctypes
+import argparse
+import tempfile
+
+import adc_bench
+
+###
+# SFR Sensor Map Benchmark
+# Times main/adc.c's sensor map lookup on the PC and checks it against the lookup read_sensor and
+# convert_sensor had before, a scan of the breakpoints and a divide per call, which sim_adc.c keeps.
+#
+# Each map in MAPS is compiled by sensor_map_init and --samples voltages, spread a little past its
+# limits, are converted by the old lookup, convert_sensor one at a time and convert_sensor_batch.
+# Every breakpoint is converted too. Reports ns per sample for each, whether the map was found to
+# be evenly spaced, the worst difference from the old lookup where both give a value, and from
+# the same straight lines worked out in double. Samples one gives SENSOR_INVALID for and the other
+# doesn't are counted, the old lookup refused the last breakpoint.
+#
+# The PC has a floating point unit, the C6 doesn't, so the old lookup's divide per call and its
+# float compares cost it more there than here.
+#
+# Examples:
+#    python sensor_bench.py
+#    python sensor_bench.py --samples 1000000
+#
+
+# -----------------------------------------------------------------------------
+# Configuration
+# -----------------------------------------------------------------------------
+POINTS = 101                    # SENSOR_MAP_POINTS
+INVALID = -999.0                # SENSOR_INVALID
+METHODS = ['old lookup', 'convert_sensor', 'batch']
+SPREAD_V = 0.2                  # Past the limits either side
+TOLERANCE = 1e-4                # Of the map's value range
+
+def f32(value):
+    return struct.unpack('<f', struct.pack('<f', value))[0]
+
+def map_apps():
+    """Pedal travel, evenly spaced 0.5 to 4.5 V, a little bent."""
+    volts = [f32(0.5 + 0.04 * n) for n in range(POINTS)]
+    values = [f32(100.0 * (n / (POINTS - 1)) ** 1.1) for n in range(POINTS)]
+    return volts, values, 0.45, 4.55
+
+def map_pressure():
+    """Evenly spaced 0 to 5 V in 0.05 V steps, as a table written out by hand rounds them."""
+    volts = [f32(round(0.05 * n, 2)) for n in range(POINTS)]
+    values = [f32(25.0 * v - 12.5) for v in volts]
+    return volts, values, 0.2, 4.8
+
+def map_thermistor():
+    """NTC 10k beta 3950 under a 10k pull up from 3.3 V, -20 to 180 C in 2 C steps, so uneven."""
+    points = []
+    for n in range(POINTS):
+        kelvin = 253.15 + 2.0 * n
+        ohms = 10000.0 * math.exp(3950.0 * (1.0 / kelvin - 1.0 / 298.15))
+        points.append((f32(3.3 * ohms / (ohms + 10000.0)), f32(kelvin - 273.15)))
+    points.sort()
+    return [v for v, _ in points], [t for _, t in points], points[0][0], points[-1][0]
+
+MAPS = [('APPS', map_apps), ('Pressure', map_pressure), ('Thermistor', map_thermistor)]
+
+# -----------------------------------------------------------------------------
+# Checks
+# -----------------------------------------------------------------------------
+def exact(volts, values, lower, upper, v):
+    """The same straight lines in double, None where the map gives SENSOR_INVALID."""
+    if not (max(f32(lower), volts[0]) <= v <= min(f32(upper), volts[-1])):
+        return None
+    n = min(bisect.bisect_right(volts, v) - 1, POINTS - 2)
+    return values[n] + (values[n + 1] - values[n]) / (volts[n + 1] - volts[n]) * (v - volts[n])
+
+def run_map(args, lib, name, make):
+    volts, values, lower, upper = make()
+    even = lib.sim_sensor_set((ctypes.c_float * POINTS)(*volts), (ctypes.c_float * POINTS)(*values), lower, upper)
+    rng = random.Random(args.seed)
+    samples = [f32(rng.uniform(lower - SPREAD_V, upper + SPREAD_V)) for _ in range(args.samples)] + volts
+    n = len(samples)
+    inputs = (ctypes.c_float * n)(*samples)
+    outputs = {}
+    ns = {}
+    for method in range(len(METHODS)):
+        out = (ctypes.c_float * n)()
+        ns[method] = min(lib.sim_sensor_convert(method, inputs, out, n) for _ in range(args.repeats)) / n
+        outputs[method] = list(out)
+
+    span = max(values) - min(values)
+    result = {'name': name, 'even': even, 'last_inside': f32(upper) >= volts[-1], 'ns': ns, 'n': n,
+              'vs_old': 0.0, 'vs_exact': 0.0, 'validity': 0, 'last': 0, 'single_batch': 0, 'bad_exact': 0}
+    for i, v in enumerate(samples):
+        old, single, batch = outputs[0][i], outputs[1][i], outputs[2][i]
+        ref = exact(volts, values, lower, upper, v)
+        if single != batch:
+            result['single_batch'] += 1
+        if (old == INVALID) != (batch == INVALID):
+            if v == volts[-1] and old == INVALID:
+                result['last'] += 1
+            else:
+                result['validity'] += 1
+        elif batch != INVALID:
+            result['vs_old'] = max(result['vs_old'], abs(batch - old))
+        if (ref is None) != (batch == INVALID):
+            result['bad_exact'] += 1
+        elif ref is not None:
+            result['vs_exact'] = max(result['vs_exact'], abs(batch - ref))
+    result['passed'] = (even >= 0 and result['validity'] == 0 and result['single_batch'] == 0 and
+                        result['bad_exact'] == 0 and result['vs_exact'] <= TOLERANCE * span and
+                        result['vs_old'] <= TOLERANCE * span)
+    return result
+
+# -----------------------------------------------------------------------------
+# Main Execution
+# -----------------------------------------------------------------------------
+def report(results):
+    passed = True
+    for r in results:
+        print(f"=== {r['name']}, {'even, one multiply' if r['even'] == 1 else 'binary searched'}, {r['n']} samples ===")
+        for method, name in enumerate(METHODS):
+            print(f"{name + ':':<22}{r['ns'][method]:7.1f} ns/sample, "
+                  f"{r['ns'][0] / r['ns'][method]:5.1f}x the old lookup")
+        print(f"Worst vs old lookup:  {r['vs_old']:.3g}, vs double {r['vs_exact']:.3g}")
+        print(f"Validity:             {r['validity']} differ from the old lookup, {r['last']} last breakpoint "
+              f"now valid, {r['bad_exact']} differ from double")
+        print(f"Single vs batch:      {r['single_batch']} differ\n")
+        passed = passed and r['passed'] and r['last'] == (1 if r['last_inside'] else 0)
+    return passed
+
+def main():
+    parser = argparse.ArgumentParser(description="Time and check adc.c's sensor map lookup on the PC")
+    parser.add_argument('--samples', type=int, default=200000, help="Random voltages per map (default 200000)")
+    parser.add_argument('--repeats', type=int, default=5, help="Timed runs, the quickest is kept (default 5)")
+    parser.add_argument('--seed', type=int, default=1)
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        lib = ctypes.CDLL(adc_bench.build(work_dir))
+        lib.sim_sensor_set.argtypes = [ctypes.POINTER(ctypes.c_float), ctypes.POINTER(ctypes.c_float),
+                                       ctypes.c_float, ctypes.c_float]
+        lib.sim_sensor_convert.argtypes = [ctypes.c_int, ctypes.POINTER(ctypes.c_float),
+                                           ctypes.POINTER(ctypes.c_float), ctypes.c_ulong]
+        lib.sim_sensor_convert.restype = ctypes.c_uint64
+        passed = report([run_map(args, lib, name, make) for name, make in MAPS])
+    print(f"{'PASS' if passed else 'FAIL'}")
+    return 0 if passed else 1
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,463 @@
+/*
+sim_adc.c
+Host side of the ESP-IDF ADC calls used by adc.c, so its continuous sampling can run on a PC for
+adc_bench.py. The DMA is a loop making type 2 samples in the configured pattern's order and handing
+them to the conversion done callback a frame at a time. Each sample is the signal set by
+sim_adc_signal: a level, gaussian noise and a spike every so many samples, quantised to 12 bits.
+A channel given its own level by sim_adc_channel_mV keeps it in place of sim_adc_signal's, and
+sim_adc_feed makes samples a few at a time for a sim that moves time along, apps_bench.py's.
+The calibration is a fixed gently bent curve so the curve adc.c builds has something to follow.
+Oneshot reads return the signal too, without the DMA.
+
+The sensor map lookup read_sensor and convert_sensor had before sensor_map_init is here too, for
+sensor_bench.py to compare against.
+
+Written for Sheffield Formula Racing 2026
+*/
+#define _GNU_SOURCE
+#include <math.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <time.h>
+#include "adc.h"
+
+/* --------------------------- Definitions ----------------------------- */
+#define SIM_ADC_HANDLES         ADC_MAX_CHANNELS
+#define SIM_ADC_MAX_FRAME       4096    // Samples a callback is given at most
+
+/* --------------------------- Local Variables ----------------------------- */
+static stADCHandles_t astSimHandles[SIM_ADC_HANDLES];
+static adc_digi_pattern_config_t astSimPattern[ADC_MAX_CHANNELS];
+static dword dwSimNPattern = 0;
+static dword dwSimNextPattern = 0;
+static adc_continuous_evt_cbs_t stSimCallbacks;
+static void *pvSimCallbackArg = NULL;
+static boolean BSimStarted = FALSE;
+static float fSimLevel = 2048.0f;       // Counts
+static float afSimChannelLevel[ADC_MAX_CHANNELS];
+static boolean abSimChannelLevel[ADC_MAX_CHANNELS];     // Channel has its own level, sim_adc_channel_mV
+static adc_digi_output_data_t astSimFeed[SIM_ADC_MAX_FRAME];
+static dword dwSimNFeed = 0;
+static float fSimNoise = 0.0f;          // Standard deviation, counts
+static dword dwSimSpikeEvery = 0;       // Samples of a channel, 0 for none
+static float fSimSpikeSize = 0.0f;
+static dword adwSimNSamples[ADC_MAX_CHANNELS];
+static qword qwSimRandom = 0x2545F4914F6CDD1DULL;
+static int NVerbose = 0;
+static stSensorMap_t stSimSensorMap;
+
+/* --------------------------- Function prototypes ----------------------------- */
+void sim_adc_reset(dword dwSeed, int NVerboseLog);
+int sim_adc_add(byte byChannel, byte byOversampleShift, int eFilter, byte byIIRShift);
+int sim_adc_start(dword dwSampleHz);
+void sim_adc_signal(float fLevel, float fNoise, dword dwSpikeEvery, float fSpikeSize);
+void sim_adc_channel_mV(byte byChannel, float fmV);
+void sim_adc_feed(dword dwNSamples, dword dwFrameSamples);
+qword sim_adc_run(dword dwNSamples, dword dwFrameSamples, dword *adwTrace, dword dwTraceLength);
+dword sim_adc_filtered(byte byChannel);
+float sim_adc_volts(byte byChannel);
+qword sim_adc_read_ns(byte byChannel, dword dwNReads);
+int sim_adc_cali_mV(int NRaw);
+void sim_adc_noise(byte byChannel, float *afNoise);
+void sim_adc_stats(dword *pdwNSamples, dword *pdwNUnknown, qword *pqwNCycles);
+int sim_sensor_set(const float *afVolts, const float *afValues, float fLowerLimit, float fUpperLimit);
+qword sim_sensor_convert(int NMethod, const float *afVSensor, float *afOutput, dword dwNSamples);
+
+/* --------------------------- Helpers ----------------------------- */
+static double sim_adc_uniform(void)
+{
+    /* xorshift64*, (0, 1] */
+    qwSimRandom ^= qwSimRandom >> 12;
+    qwSimRandom ^= qwSimRandom << 25;
+    qwSimRandom ^= qwSimRandom >> 27;
+    return ((qwSimRandom * 0x2545F4914F6CDD1DULL) >> 11) * (1.0 / 9007199254740992.0) + 1e-300;
+}
+
+static dword sim_adc_sample(byte byChannel)
+{
+    /* The signal's next sample for the channel, Box-Muller for the noise */
+    double dValue = abSimChannelLevel[byChannel] ? afSimChannelLevel[byChannel] : fSimLevel;
+
+    if (fSimNoise > 0.0f)
+    {
+        dValue += fSimNoise * sqrt(-2.0 * log(sim_adc_uniform())) * cos(2.0 * M_PI * sim_adc_uniform());
+    }
+    adwSimNSamples[byChannel]++;
+    if (dwSimSpikeEvery != 0 && adwSimNSamples[byChannel] % dwSimSpikeEvery == 0)
+    {
+        dValue += fSimSpikeSize;
+    }
+    dValue = floor(dValue + 0.5);
+    return dValue < 0.0 ? 0 : dValue > 4095.0 ? 4095 : (dword)dValue;
+}
+
+static qword sim_adc_cpu_ns(void)
+{
+    struct timespec stNow;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &stNow);
+    return (qword)stNow.tv_sec * 1000000000 + stNow.tv_nsec;
+}
+
+/* --------------------------- Harness ----------------------------- */
+void sim_adc_reset(dword dwSeed, int NVerboseLog)
+{
+    /* Only before adc_continuous_init, adc.c's own state lasts as long as the library */
+    byte byChannel;
+
+    for (byChannel = 0; byChannel < SIM_ADC_HANDLES; byChannel++)
+    {
+        astSimHandles[byChannel].eNChannel = (adc_channel_t)byChannel;
+    }
+    qwSimRandom ^= (qword)dwSeed * 0x9E3779B97F4A7C15ULL;
+    NVerbose = NVerboseLog;
+}
+
+int sim_adc_add(byte byChannel, byte byOversampleShift, int eFilter, byte byIIRShift)
+{
+    return adc_continuous_add(&astSimHandles[byChannel], ADC_ATTEN_DB_12, byOversampleShift,
+                              (eADCFilter_t)eFilter, byIIRShift);
+}
+
+int sim_adc_start(dword dwSampleHz)
+{
+    return adc_continuous_init(dwSampleHz);
+}
+
+void sim_adc_signal(float fLevel, float fNoise, dword dwSpikeEvery, float fSpikeSize)
+{
+    fSimLevel = fLevel;
+    fSimNoise = fNoise;
+    dwSimSpikeEvery = dwSpikeEvery;
+    fSimSpikeSize = fSpikeSize;
+}
+
+void sim_adc_channel_mV(byte byChannel, float fmV)
+{
+    /* Gives the channel its own level, the counts sim_adc_cali_mV turns into fmV */
+    double dA = 0.00002;
+    double dB = 0.74;
+    double dC = 20.0 - fmV;
+
+    afSimChannelLevel[byChannel] = (float)((-dB + sqrt(dB * dB - 4.0 * dA * dC)) / (2.0 * dA));
+    abSimChannelLevel[byChannel] = TRUE;
+}
+
+void sim_adc_feed(dword dwNSamples, dword dwFrameSamples)
+{
+    /*  Makes dwNSamples now, at the signal as it is, and gives them to the callback once
+        dwFrameSamples have built up, as the DMA would while time passes between calls */
+    adc_continuous_evt_data_t stEvent;
+
+    if (!BSimStarted || stSimCallbacks.on_conv_done == NULL || dwFrameSamples == 0 ||
+        dwFrameSamples > SIM_ADC_MAX_FRAME)
+    {
+        return;
+    }
+    while (dwNSamples-- > 0)
+    {
+        astSimFeed[dwSimNFeed].val = 0;
+        astSimFeed[dwSimNFeed].type2.channel = astSimPattern[dwSimNextPattern].channel;
+        astSimFeed[dwSimNFeed].type2.unit = 0;
+        astSimFeed[dwSimNFeed].type2.data = sim_adc_sample(astSimPattern[dwSimNextPattern].channel);
+        dwSimNextPattern = (dwSimNextPattern + 1) % dwSimNPattern;
+        if (++dwSimNFeed >= dwFrameSamples)
+        {
+            stEvent.conv_frame_buffer = (uint8_t *)astSimFeed;
+            stEvent.size = dwSimNFeed * SOC_ADC_DIGI_RESULT_BYTES;
+            (void)stSimCallbacks.on_conv_done(NULL, &stEvent, pvSimCallbackArg);
+            dwSimNFeed = 0;
+        }
+    }
+}
+
+qword sim_adc_run(dword dwNSamples, dword dwFrameSamples, dword *adwTrace, dword dwTraceLength)
+{
+    /*  Makes dwNSamples and gives them to the callback dwFrameSamples at a time. If adwTrace is
+        given every channel's filtered value goes in it after each callback, channel by channel in
+        pattern order, until dwTraceLength is full. Returns the host ns spent in the callback. */
+    static adc_digi_output_data_t astFrame[SIM_ADC_MAX_FRAME];
+    adc_continuous_evt_data_t stEvent;
+    qword qwNns = 0;
+    qword qwtStart;
+    dword dwNTrace = 0;
+    dword dwInFrame;
+    dword dwPattern;
+
+    if (!BSimStarted || stSimCallbacks.on_conv_done == NULL || dwFrameSamples == 0 ||
+        dwFrameSamples > SIM_ADC_MAX_FRAME)
+    {
+        return 0;
+    }
+    while (dwNSamples > 0)
+    {
+        dwInFrame = dwNSamples < dwFrameSamples ? dwNSamples : dwFrameSamples;
+        for (dword dwSample = 0; dwSample < dwInFrame; dwSample++)
+        {
+            astFrame[dwSample].val = 0;
+            astFrame[dwSample].type2.channel = astSimPattern[dwSimNextPattern].channel;
+            astFrame[dwSample].type2.unit = 0;
+            astFrame[dwSample].type2.data = sim_adc_sample(astSimPattern[dwSimNextPattern].channel);
+            dwSimNextPattern = (dwSimNextPattern + 1) % dwSimNPattern;
+        }
+        stEvent.conv_frame_buffer = (uint8_t *)astFrame;
+        stEvent.size = dwInFrame * SOC_ADC_DIGI_RESULT_BYTES;
+        qwtStart = sim_adc_cpu_ns();
+        (void)stSimCallbacks.on_conv_done(NULL, &stEvent, pvSimCallbackArg);
+        qwNns += sim_adc_cpu_ns() - qwtStart;
+        for (dwPattern = 0; adwTrace != NULL && dwPattern < dwSimNPattern && dwNTrace < dwTraceLength; dwPattern++)
+        {
+            adwTrace[dwNTrace++] = adc_read_filtered(&astSimHandles[astSimPattern[dwPattern].channel]);
+        }
+        dwNSamples -= dwInFrame;
+    }
+    return qwNns;
+}
+
+dword sim_adc_filtered(byte byChannel)
+{
+    return adc_read_filtered(&astSimHandles[byChannel]);
+}
+
+float sim_adc_volts(byte byChannel)
+{
+    return adc_read_voltage(&astSimHandles[byChannel]);
+}
+
+qword sim_adc_read_ns(byte byChannel, dword dwNReads)
+{
+    /* Host ns for dwNReads of adc_read_voltage, what a consumer pays per read */
+    volatile float fSink = 0.0f;
+    qword qwtStart = sim_adc_cpu_ns();
+
+    while (dwNReads-- > 0)
+    {
+        fSink += adc_read_voltage(&astSimHandles[byChannel]);
+    }
+    (void)fSink;
+    return sim_adc_cpu_ns() - qwtStart;
+}
+
+int sim_adc_cali_mV(int NRaw)
+{
+    /* A little bent, like the C6's curve fitting at 12 dB */
+    return (int)(20.0 + NRaw * 0.74 + NRaw * (double)NRaw * 0.00002);
+}
+
+void sim_adc_noise(byte byChannel, float *afNoise)
+{
+    /* dwNRaw, dwNFiltered, fRawStd, fFilteredStd, fMean */
+    stADCNoise_t stNoise;
+    adc_get_noise(&astSimHandles[byChannel], &stNoise);
+    afNoise[0] = (float)stNoise.dwNRaw;
+    afNoise[1] = (float)stNoise.dwNFiltered;
+    afNoise[2] = stNoise.fRawStd;
+    afNoise[3] = stNoise.fFilteredStd;
+    afNoise[4] = stNoise.fMean;
+}
+
+void sim_adc_stats(dword *pdwNSamples, dword *pdwNUnknown, qword *pqwNCycles)
+{
+    stADCStats_t stStats;
+    adc_get_stats(&stStats);
+    *pdwNSamples = stStats.dwNSamples;
+    *pdwNUnknown = stStats.dwNUnknown;
+    *pqwNCycles = stStats.qwNISRCycles;
+}
+
+/* --------------------------- Sensor maps ----------------------------- */
+static float sim_sensor_legacy(float fVSensor, stSensorMap_t *stSensorMap)
+{
+    /* convert_sensor as it was, a scan and a divide per call */
+    uint8_t NCounter;
+    if (fVSensor < stSensorMap->fLowerLimit || fVSensor > stSensorMap->fUpperLimit)
+    {
+        return -999.0f;
+    }
+    for (NCounter = 0; NCounter < sizeof(stSensorMap->afLookupTable[0])/sizeof(stSensorMap->afLookupTable[0][0]) - 1; NCounter++)
+    {
+        if (fVSensor >= stSensorMap->afLookupTable[0][NCounter] && fVSensor < stSensorMap->afLookupTable[0][NCounter + 1])
+        {
+            float fSlope = (stSensorMap->afLookupTable[1][NCounter + 1] - stSensorMap->afLookupTable[1][NCounter]) /
+                           (stSensorMap->afLookupTable[0][NCounter + 1] - stSensorMap->afLookupTable[0][NCounter]);
+            float fOutput = stSensorMap->afLookupTable[1][NCounter] +
+                            fSlope * (fVSensor - stSensorMap->afLookupTable[0][NCounter]);
+            return fOutput;
+        }
+    }
+    return -999.0f;
+}
+
+int sim_sensor_set(const float *afVolts, const float *afValues, float fLowerLimit, float fUpperLimit)
+{
+    /* Returns 1 if the breakpoints are even, 0 if binary searched, -1 if sensor_map_init refused them */
+    memset(&stSimSensorMap, 0, sizeof(stSimSensorMap));
+    memcpy(stSimSensorMap.afLookupTable[0], afVolts, sizeof(stSimSensorMap.afLookupTable[0]));
+    memcpy(stSimSensorMap.afLookupTable[1], afValues, sizeof(stSimSensorMap.afLookupTable[1]));
+    stSimSensorMap.fLowerLimit = fLowerLimit;
+    stSimSensorMap.fUpperLimit = fUpperLimit;
+    if (sensor_map_init(&stSimSensorMap) != ESP_OK)
+    {
+        return -1;
+    }
+    return stSimSensorMap.fStepInverse != 0.0f;
+}
+
+qword sim_sensor_convert(int NMethod, const float *afVSensor, float *afOutput, dword dwNSamples)
+{
+    /*  Converts with the old lookup (0), convert_sensor a sample at a time (1) or
+        convert_sensor_batch (2), returns the host ns taken */
+    qword qwtStart = sim_adc_cpu_ns();
+    dword dwSample;
+    word wN;
+
+    switch (NMethod)
+    {
+        case 0:
+            for (dwSample = 0; dwSample < dwNSamples; dwSample++)
+            {
+                afOutput[dwSample] = sim_sensor_legacy(afVSensor[dwSample], &stSimSensorMap);
+            }
+            break;
+        case 1:
+            for (dwSample = 0; dwSample < dwNSamples; dwSample++)
+            {
+                afOutput[dwSample] = convert_sensor(afVSensor[dwSample], &stSimSensorMap);
+            }
+            break;
+        default:
+            for (dwSample = 0; dwSample < dwNSamples; dwSample += wN)
+            {
+                wN = dwNSamples - dwSample > UINT16_MAX ? UINT16_MAX : (word)(dwNSamples - dwSample);
+                convert_sensor_batch(&afVSensor[dwSample], &afOutput[dwSample], wN, &stSimSensorMap);
+            }
+            break;
+    }
+    return sim_adc_cpu_ns() - qwtStart;
+}
+
+/* --------------------------- ESP-IDF ADC ----------------------------- */
+esp_err_t adc_oneshot_new_unit(const adc_oneshot_unit_init_cfg_t *pstConfig, adc_oneshot_unit_handle_t *pstUnit)
+{
+    *pstUnit = (adc_oneshot_unit_handle_t)(uintptr_t)(pstConfig->unit_id + 1);
+    return ESP_OK;
+}
+
+esp_err_t adc_oneshot_config_channel(adc_oneshot_unit_handle_t stUnit, adc_channel_t eChannel,
+                                     const adc_oneshot_chan_cfg_t *pstConfig)
+{
+    (void)stUnit;
+    (void)eChannel;
+    (void)pstConfig;
+    return ESP_OK;
+}
+
+esp_err_t adc_oneshot_read(adc_oneshot_unit_handle_t stUnit, adc_channel_t eChannel, int *pNRaw)
+{
+    (void)stUnit;
+    *pNRaw = (int)sim_adc_sample((byte)eChannel);
+    return ESP_OK;
+}
+
+esp_err_t adc_cali_create_scheme_curve_fitting(const adc_cali_curve_fitting_config_t *pstConfig,
+                                               adc_cali_handle_t *pstCalibration)
+{
+    *pstCalibration = (adc_cali_handle_t)(uintptr_t)(pstConfig->chan + 1);
+    return ESP_OK;
+}
+
+esp_err_t adc_cali_raw_to_voltage(adc_cali_handle_t stCalibration, int NRaw, int *pNmV)
+{
+    if (stCalibration == NULL || NRaw < 0 || NRaw > 4095)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *pNmV = sim_adc_cali_mV(NRaw);
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_new_handle(const adc_continuous_handle_cfg_t *pstConfig, adc_continuous_handle_t *pstHandle)
+{
+    if (pstConfig->conv_frame_size == 0 || pstConfig->conv_frame_size % SOC_ADC_DIGI_RESULT_BYTES != 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *pstHandle = (adc_continuous_handle_t)&stSimCallbacks;
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_config(adc_continuous_handle_t stHandle, const adc_continuous_config_t *pstConfig)
+{
+    (void)stHandle;
+    if (pstConfig->pattern_num == 0 || pstConfig->pattern_num > ADC_MAX_CHANNELS ||
+        pstConfig->conv_mode != ADC_CONV_SINGLE_UNIT_1 || pstConfig->format != ADC_DIGI_OUTPUT_FORMAT_TYPE2)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memcpy(astSimPattern, pstConfig->adc_pattern, pstConfig->pattern_num * sizeof(astSimPattern[0]));
+    dwSimNPattern = pstConfig->pattern_num;
+    dwSimNextPattern = 0;
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_register_event_callbacks(adc_continuous_handle_t stHandle,
+                                                  const adc_continuous_evt_cbs_t *pstCallbacks, void *pvArg)
+{
+    (void)stHandle;
+    stSimCallbacks = *pstCallbacks;
+    pvSimCallbackArg = pvArg;
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_start(adc_continuous_handle_t stHandle)
+{
+    (void)stHandle;
+    BSimStarted = TRUE;
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_deinit(adc_continuous_handle_t stHandle)
+{
+    (void)stHandle;
+    BSimStarted = FALSE;
+    return ESP_OK;
+}
+
+/* --------------------------- System ----------------------------- */
+uint32_t esp_cpu_get_cycle_count(void)
+{
+    /* The PC's time stamp counter, so cycles are the PC's and not the C6's */
+    #if defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__builtin_ia32_rdtsc();
+    #else
+    return (uint32_t)sim_adc_cpu_ns();
+    #endif
+}
+
+__attribute__((weak)) int64_t esp_timer_get_time(void)
+{
+    /* Weak so a sim built with this one can bring its own clock, sim_mcp320X.c does */
+    struct timespec stNow;
+    clock_gettime(CLOCK_MONOTONIC, &stNow);
+    return (int64_t)stNow.tv_sec * 1000000 + stNow.tv_nsec / 1000;
+}
+
+void sim_log(char cLevel, const char *sTag, const char *sFormat, ...)
+{
+    va_list stArgs;
+    if (!NVerbose && cLevel == 'I')
+    {
+        return;
+    }
+    fprintf(stderr, "%c (%s) ", cLevel, sTag);
+    va_start(stArgs, sFormat);
+    vfprintf(stderr, sFormat, stArgs);
+    va_end(stArgs);
+    fputc('\n', stderr);
+}
+
+const char *esp_err_to_name(esp_err_t eErr)
+{
+    static char sName[16];
+    snprintf(sName, sizeof(sName), "0x%x", eErr);
+    return sName;
+}
@@ -0,0 +1,149 @@
+/*
+sim_apps.c
+Host side of what apps.c needs beyond the ADC, so its checks can run on a PC for apps_bench.py.
+Built with sim_adc.c, main/adc.c and main/CAN/canDecodeAuto.c, so the pedal goes through the same
+continuous sampling, filter and sensor maps as on the car.
+
+Time is virtual and moves a millisecond a call to APPS_task_1ms, plus any jitter set, with
+ADC_SAMPLE_HZ worth of samples made at the pedal's volts for that millisecond and handed to adc.c
+ADC_FRAME_SAMPLES at a time. Every frame transmitted is logged with the time it was sent for the
+bench to decode. CAN_Tx_killlevel is a copy of can.c's, linking can.c would bring the rest of the
+CAN driver with it.
+
+Written for Sheffield Formula Racing 2026
+*/
+#include "apps.h"
+
+/* --------------------------- Definitions ----------------------------- */
+#define SIM_APPS_LOG_FRAMES     400000
+#define SIM_APPS_OVERSAMPLE     3       // As main_init's example
+#define SIM_APPS_TASK_US        1000
+
+/* --------------------------- Local Types ----------------------------- */
+typedef struct {
+    qword qwtus;
+    dword dwID;
+    byte byDLC;
+    byte abData[8];
+} stSimAPPSFrame_t;
+
+/* --------------------------- Local Variables ----------------------------- */
+static stSimAPPSFrame_t astSimLog[SIM_APPS_LOG_FRAMES];
+static dword dwSimNLog = 0;
+static qword qwtSimus = 0;
+static dword dwSimJitterus = 0;
+static qword qwSimJitterRandom = 0x9E3779B97F4A7C15ULL;
+
+/* --------------------------- Global Variables ----------------------------- */
+twai_node_handle_t stCANBus0 = NULL;
+
+/* --------------------------- Function prototypes ----------------------------- */
+void sim_adc_channel_mV(byte byChannel, float fmV);
+void sim_adc_feed(dword dwNSamples, dword dwFrameSamples);
+int sim_apps_init(void);
+void sim_apps_jitter(dword dwMaxus);
+qword sim_apps_run(const float *afV1, const float *afV2, dword dwNms);
+stSimAPPSFrame_t *sim_apps_log(dword *pdwNFrames);
+void sim_apps_clear_log(void);
+esp_err_t CAN_transmit(twai_node_handle_t stCANBus, const CAN_frame_t *stFrame);
+
+/* --------------------------- Harness ----------------------------- */
+int sim_apps_init(void)
+{
+    /* main_init's APPS node, both channels median filtered, then the checks */
+    esp_err_t eStatus = adc_continuous_add(&stADCHandle0, ADC_ATTEN_DB_12, SIM_APPS_OVERSAMPLE, eADC_FILTER_MEDIAN, 0);
+
+    if (eStatus == ESP_OK)
+    {
+        eStatus = adc_continuous_add(&stADCHandle1, ADC_ATTEN_DB_12, SIM_APPS_OVERSAMPLE, eADC_FILTER_MEDIAN, 0);
+    }
+    if (eStatus == ESP_OK)
+    {
+        eStatus = adc_continuous_init(ADC_SAMPLE_HZ);
+    }
+    if (eStatus == ESP_OK)
+    {
+        eStatus = APPS_init();
+    }
+    return eStatus;
+}
+
+void sim_apps_jitter(dword dwMaxus)
+{
+    /* Each call up to dwMaxus late at random, the next still due on its millisecond */
+    dwSimJitterus = dwMaxus;
+}
+
+qword sim_apps_run(const float *afV1, const float *afV2, dword dwNms)
+{
+    /*  A millisecond at a time, the ADC's samples at APPS1 afV1 and APPS2 afV2 volts, then
+        APPS_task_1ms up to the jitter later. Returns the time reached in us. */
+    static qword qwtNextms = 0;
+    dword dwms;
+    dword dwJitterus;
+
+    for (dwms = 0; dwms < dwNms; dwms++)
+    {
+        sim_adc_channel_mV((byte)APPS1_IN, afV1[dwms] * 1000.0f);
+        sim_adc_channel_mV((byte)APPS2_IN, afV2[dwms] * 1000.0f);
+        sim_adc_feed(ADC_SAMPLE_HZ / 1000, ADC_FRAME_SAMPLES);
+        qwtNextms += SIM_APPS_TASK_US;
+        dwJitterus = 0;
+        if (dwSimJitterus != 0)
+        {
+            qwSimJitterRandom ^= qwSimJitterRandom >> 12;
+            qwSimJitterRandom ^= qwSimJitterRandom << 25;
+            qwSimJitterRandom ^= qwSimJitterRandom >> 27;
+            dwJitterus = (dword)((qwSimJitterRandom * 0x2545F4914F6CDD1DULL) >> 33) % (dwSimJitterus + 1);
+        }
+        qwtSimus = qwtNextms + dwJitterus;
+        (void)APPS_task_1ms();
+    }
+    return qwtSimus;
+}
+
+stSimAPPSFrame_t *sim_apps_log(dword *pdwNFrames)
+{
+    *pdwNFrames = dwSimNLog;
+    return astSimLog;
+}
+
+void sim_apps_clear_log(void)
+{
+    dwSimNLog = 0;
+}
+
+/* --------------------------- CAN ----------------------------- */
+esp_err_t CAN_transmit(twai_node_handle_t stCANBus, const CAN_frame_t *stFrame)
+{
+    (void)stCANBus;
+    if (dwSimNLog >= SIM_APPS_LOG_FRAMES)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    astSimLog[dwSimNLog].qwtus = qwtSimus;
+    astSimLog[dwSimNLog].dwID = stFrame->dwID;
+    astSimLog[dwSimNLog].byDLC = stFrame->byDLC;
+    memcpy(astSimLog[dwSimNLog].abData, stFrame->abData, 8);
+    dwSimNLog++;
+    return ESP_OK;
+}
+
+esp_err_t CAN_Tx_killlevel(KillLevel_t eKillLevel, KillSource_t eKillSource)
+{
+    /* can.c's */
+    CAN_frame_t stCANFrame;
+    memset(&stCANFrame, 0, sizeof(stCANFrame));
+    stCANFrame.dwID = KILL_MSG_ID;
+    stCANFrame.byDLC = 3;
+    stCANFrame.abData[0] = (byte)eKillLevel;
+    stCANFrame.abData[1] = (byte)eKillSource;
+    stCANFrame.abData[2] = (byte)((stCANFrame.abData[0] + stCANFrame.abData[1]) % 256);
+    return CAN_transmit(stCANBus0, &stCANFrame);
+}
+
+/* --------------------------- System ----------------------------- */
+int64_t esp_timer_get_time(void)
+{
+    return (int64_t)qwtSimus;
+}
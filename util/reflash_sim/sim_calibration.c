@@ -0,0 +1,258 @@
+/*
+sim_calibration.c
+Host side of the ESP-IDF calls used by calibration.c, so its tables, NVS storage and update over
+CAN can run on a PC for calibration_bench.py. Built with main/calibration.c alone.
+
+NVS is a directory, a file per key as sim_platform.c keeps it, so tables stored by one library
+are loaded by the next as at a reboot. The last frame CAN_transmit was given is kept for the
+bench to read the node's reply.
+
+sim_cal_swap runs a writer thread updating a slot over and over, alternating two tables, while
+the calling thread converts batches with it. Every batch must come out all of one table or all of
+the other, never some of each. The PC has threads on several cores at once, harder on the swap
+than the C6 where the writer only runs when no reader is.
+
+Written for Sheffield Formula Racing 2026
+*/
+#include <stdarg.h>
+#include <pthread.h>
+#include "calibration.h"
+
+/* --------------------------- Definitions ----------------------------- */
+#define SIM_MAX_PATH            512
+#define SIM_MAX_NVS_HANDLES     8
+
+/* --------------------------- Local Types ----------------------------- */
+typedef struct {
+    const byte *aabyBlobs[2];
+    word awNBytes[2];
+    dword dwNUpdates;
+    volatile int BDone;
+} stSimSwap_t;
+
+/* --------------------------- Local Variables ----------------------------- */
+static char sNVSDir[256];
+static char asNVSNamespace[SIM_MAX_NVS_HANDLES][16];
+static CAN_frame_t stSimReply;
+static dword dwSimNReplies = 0;
+static int NVerbose = 0;
+
+/* --------------------------- Global Variables ----------------------------- */
+twai_node_handle_t stCANBus0 = NULL;
+
+/* --------------------------- Function prototypes ----------------------------- */
+esp_err_t sim_cal_init(const char *sNVSPath, int NVerboseLog);
+dword sim_cal_reply(byte *abyData);
+dword sim_cal_swap(const byte *abyBlobA, word wNBytesA, const byte *abyBlobB, word wNBytesB, dword dwNUpdates,
+                   byte bySlot, const float *afVSensor, const float *afA, const float *afB, word wNSamples,
+                   dword *pdwNBatches);
+
+/* --------------------------- Harness ----------------------------- */
+esp_err_t sim_cal_init(const char *sNVSPath, int NVerboseLog)
+{
+    snprintf(sNVSDir, sizeof(sNVSDir), "%s", sNVSPath);
+    NVerbose = NVerboseLog;
+    return CAL_init();
+}
+
+dword sim_cal_reply(byte *abyData)
+{
+    /* Replies sent so far, the last one's data in abyData */
+    memcpy(abyData, stSimReply.abData, sizeof(stSimReply.abData));
+    return dwSimNReplies;
+}
+
+static void *sim_cal_writer(void *pvArg)
+{
+    /* Alternates the two tables, each a version on so neither is refused as old */
+    stSimSwap_t *pstSwap = (stSimSwap_t *)pvArg;
+    byte abyBlob[CAL_MAX_BLOB];
+    stCalBlobHeader_t stHeader;
+    uint32_t dwCRC;
+    word wNBytes;
+
+    for (dword dwUpdate = 0; dwUpdate < pstSwap->dwNUpdates; dwUpdate++)
+    {
+        wNBytes = pstSwap->awNBytes[dwUpdate & 1];
+        memcpy(abyBlob, pstSwap->aabyBlobs[dwUpdate & 1], wNBytes);
+        memcpy(&stHeader, abyBlob, sizeof(stHeader));
+        stHeader.wVersion = (uint16_t)(dwUpdate % 65000 + 1);
+        memcpy(abyBlob, &stHeader, sizeof(stHeader));
+        dwCRC = esp_rom_crc32_le(0, abyBlob, wNBytes - 4);
+        memcpy(abyBlob + wNBytes - 4, &dwCRC, 4);
+        if (stHeader.wVersion == 1 && dwUpdate != 0)
+        {
+            /* Versions wrapped, start the slot again */
+            continue;
+        }
+        if (CAL_update(abyBlob, wNBytes, FALSE) != eCAL_OK)
+        {
+            fprintf(stderr, "sim_cal_writer: update %lu refused\n", (unsigned long)dwUpdate);
+        }
+    }
+    pstSwap->BDone = 1;
+    return NULL;
+}
+
+dword sim_cal_swap(const byte *abyBlobA, word wNBytesA, const byte *abyBlobB, word wNBytesB, dword dwNUpdates,
+                   byte bySlot, const float *afVSensor, const float *afA, const float *afB, word wNSamples,
+                   dword *pdwNBatches)
+{
+    /*  Converts afVSensor with bySlot while the writer swaps A and B in dwNUpdates times. Returns
+        how many batches were neither all afA nor all afB. */
+    stSimSwap_t stSwap = {{abyBlobA, abyBlobB}, {wNBytesA, wNBytesB}, dwNUpdates, 0};
+    float afOutput[CAL_MAX_POINTS * 4];
+    pthread_t stWriter;
+    dword dwNMixed = 0;
+    int BA;
+    int BB;
+
+    *pdwNBatches = 0;
+    if (wNSamples > sizeof(afOutput) / sizeof(afOutput[0]) || pthread_create(&stWriter, NULL, sim_cal_writer, &stSwap) != 0)
+    {
+        return (dword)-1;
+    }
+    while (!stSwap.BDone)
+    {
+        CAL_convert_batch(bySlot, afVSensor, afOutput, wNSamples);
+        BA = memcmp(afOutput, afA, wNSamples * sizeof(float)) == 0;
+        BB = memcmp(afOutput, afB, wNSamples * sizeof(float)) == 0;
+        dwNMixed += !BA && !BB;
+        (*pdwNBatches)++;
+    }
+    pthread_join(stWriter, NULL);
+    return dwNMixed;
+}
+
+/* --------------------------- NVS ----------------------------- */
+static void nvs_path(nvs_handle_t stHandle, const char *sKey, char *sPath)
+{
+    snprintf(sPath, SIM_MAX_PATH, "%s/%s.%s", sNVSDir, asNVSNamespace[stHandle], sKey);
+}
+
+esp_err_t NVS_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char *sNamespace, nvs_open_mode_t eMode, nvs_handle_t *pstHandle)
+{
+    (void)eMode;
+    for (nvs_handle_t stHandle = 1; stHandle < SIM_MAX_NVS_HANDLES; stHandle++)
+    {
+        if (asNVSNamespace[stHandle][0] == '\0')
+        {
+            snprintf(asNVSNamespace[stHandle], sizeof(asNVSNamespace[stHandle]), "%s", sNamespace);
+            *pstHandle = stHandle;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NO_MEM;
+}
+
+void nvs_close(nvs_handle_t stHandle)
+{
+    asNVSNamespace[stHandle][0] = '\0';
+}
+
+esp_err_t nvs_commit(nvs_handle_t stHandle)
+{
+    (void)stHandle;
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t stHandle, const char *sKey, void *pvData, size_t *pdwSize)
+{
+    char sPath[SIM_MAX_PATH];
+    FILE *pstFile;
+    long NSize;
+    nvs_path(stHandle, sKey, sPath);
+    pstFile = fopen(sPath, "rb");
+    if (pstFile == NULL)
+    {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    fseek(pstFile, 0, SEEK_END);
+    NSize = ftell(pstFile);
+    fseek(pstFile, 0, SEEK_SET);
+    if (pvData != NULL)
+    {
+        if ((size_t)NSize > *pdwSize)
+        {
+            fclose(pstFile);
+            return ESP_ERR_INVALID_SIZE;
+        }
+        if (fread(pvData, 1, NSize, pstFile) != (size_t)NSize)
+        {
+            fclose(pstFile);
+            return ESP_FAIL;
+        }
+    }
+    *pdwSize = (size_t)NSize;
+    fclose(pstFile);
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t stHandle, const char *sKey, const void *pvData, size_t dwSize)
+{
+    char sPath[SIM_MAX_PATH];
+    FILE *pstFile;
+    nvs_path(stHandle, sKey, sPath);
+    pstFile = fopen(sPath, "wb");
+    if (pstFile == NULL)
+    {
+        return ESP_FAIL;
+    }
+    fwrite(pvData, 1, dwSize, pstFile);
+    fclose(pstFile);
+    return ESP_OK;
+}
+
+/* --------------------------- CAN ----------------------------- */
+esp_err_t CAN_transmit(twai_node_handle_t stCANBus, const CAN_frame_t *stFrame)
+{
+    (void)stCANBus;
+    stSimReply = *stFrame;
+    dwSimNReplies++;
+    return ESP_OK;
+}
+
+/* --------------------------- System ----------------------------- */
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    /* Reflected CRC32, same as zlib.crc32 when chained */
+    crc = ~crc;
+    for (uint32_t dwIndex = 0; dwIndex < len; dwIndex++)
+    {
+        crc ^= buf[dwIndex];
+        for (int NBit = 0; NBit < 8; NBit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return 1;
+}
+
+const char *esp_err_to_name(esp_err_t eStatus)
+{
+    return eStatus == ESP_OK ? "ESP_OK" : "ESP_ERR";
+}
+
+void sim_log(char cLevel, const char *sTag, const char *sFormat, ...)
+{
+    va_list stArgs;
+    if (!NVerbose && cLevel == 'I')
+    {
+        return;
+    }
+    fprintf(stderr, "%c (%s) ", cLevel, sTag);
+    va_start(stArgs, sFormat);
+    vfprintf(stderr, sFormat, stArgs);
+    va_end(stArgs);
+    fputc('\n', stderr);
+}
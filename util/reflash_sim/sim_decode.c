@@ -0,0 +1,153 @@
+/*
+sim_decode.c
+Host side of decode_bench.py. Built with util/sdlog_decode/canSignals.c and its table under
+CAN_SIGNAL_FIRMWARE, and main/CAN/canDecodeAuto.c, so a frame can be decoded by the firmware's own
+Rx function and by the table and the two compared.
+
+What an Rx function wrote is found by filling every global in its message's rows with one pattern,
+calling it, then again with another. A global that comes out the same both times was written, and
+that is its value. Nothing else is modelled, the Rx functions only write globals.
+
+Written for Sheffield Formula Racing 2026
+*/
+#include <string.h>
+#include "canSignals.h"
+
+/* --------------------------- Definitions ----------------------------- */
+#define SIM_DECODE_FILL_A       0xA5
+#define SIM_DECODE_FILL_B       0x5A
+#define SIM_DECODE_MAX_VALUE    4       // Biggest global, uint32_t or float
+
+/* --------------------------- Function prototypes ----------------------------- */
+int sim_decode_init(void);
+word sim_decode_fw(uint32_t dwID, const byte *abyData, byte byDLC, word *awSignals, double *afValues);
+word sim_decode_table(uint32_t dwID, const byte *abyData, byte byDLC, word *awSignals, double *afValues);
+esp_err_t CAN_transmit(twai_node_handle_t stCANBus, const CAN_frame_t *stFrame);
+
+/* --------------------------- Helpers ----------------------------- */
+static size_t sim_decode_size(eCANSignalType_t eType)
+{
+    switch (eType)
+    {
+        case eCAN_SIGNAL_UINT16:
+        case eCAN_SIGNAL_INT16:
+            return 2;
+        case eCAN_SIGNAL_UINT32:
+        case eCAN_SIGNAL_INT32:
+        case eCAN_SIGNAL_FLOAT:
+            return 4;
+        default:
+            return 1;
+    }
+}
+
+static double sim_decode_read(const stCANSignal_t *pstSignal, const byte *abyValue)
+{
+    uint16_t wValue;
+    int16_t nValue16;
+    uint32_t dwValue;
+    int32_t nValue32;
+    float fValue;
+
+    switch (pstSignal->eType)
+    {
+        case eCAN_SIGNAL_BOOL:
+        case eCAN_SIGNAL_UINT8:
+            return abyValue[0];
+        case eCAN_SIGNAL_INT8:
+            return (int8_t)abyValue[0];
+        case eCAN_SIGNAL_UINT16:
+            memcpy(&wValue, abyValue, sizeof(wValue));
+            return wValue;
+        case eCAN_SIGNAL_INT16:
+            memcpy(&nValue16, abyValue, sizeof(nValue16));
+            return nValue16;
+        case eCAN_SIGNAL_UINT32:
+            memcpy(&dwValue, abyValue, sizeof(dwValue));
+            return dwValue;
+        case eCAN_SIGNAL_INT32:
+            memcpy(&nValue32, abyValue, sizeof(nValue32));
+            return nValue32;
+        default:
+            memcpy(&fValue, abyValue, sizeof(fValue));
+            return fValue;
+    }
+}
+
+static void sim_decode_call(const stCANMessage_t *pstMessage, const byte *abyData, byte byDLC, byte byFill,
+                            byte (*aabyValues)[SIM_DECODE_MAX_VALUE])
+{
+    /* Fills the message's globals with byFill, runs its Rx function and keeps what they hold */
+    CAN_frame_t stFrame;
+    const stCANSignal_t *pstSignal;
+    word wRow;
+
+    memset(&stFrame, 0, sizeof(stFrame));
+    stFrame.dwID = pstMessage->dwID;
+    stFrame.byDLC = byDLC;
+    memcpy(stFrame.abData, abyData, byDLC > 8 ? 8 : byDLC);
+    for (wRow = 0; wRow < pstMessage->wNSignals; wRow++)
+    {
+        pstSignal = &astCANSignals[pstMessage->wFirstSignal + wRow];
+        memset((void *)pstSignal->pvFirmware, byFill, sim_decode_size(pstSignal->eType));
+    }
+    (void)pstMessage->pfnRx(stFrame);
+    for (wRow = 0; wRow < pstMessage->wNSignals; wRow++)
+    {
+        pstSignal = &astCANSignals[pstMessage->wFirstSignal + wRow];
+        memcpy(aabyValues[wRow], pstSignal->pvFirmware, sim_decode_size(pstSignal->eType));
+    }
+}
+
+/* --------------------------- Functions ----------------------------- */
+esp_err_t CAN_transmit(twai_node_handle_t stCANBus, const CAN_frame_t *stFrame)
+{
+    /* Only the Tx functions in canDecodeAuto.c call it, nothing here does */
+    (void)stCANBus;
+    (void)stFrame;
+    return ESP_OK;
+}
+
+int sim_decode_init(void)
+{
+    return CAN_signals_init();
+}
+
+word sim_decode_fw(uint32_t dwID, const byte *abyData, byte byDLC, word *awSignals, double *afValues)
+{
+    /*  Decodes the frame with the firmware's Rx function. Gives the rows it wrote and their values
+        in row order, and returns how many. */
+    static byte aabyA[UINT16_MAX][SIM_DECODE_MAX_VALUE];
+    static byte aabyB[UINT16_MAX][SIM_DECODE_MAX_VALUE];
+    const stCANSignalMessage_t *pstFound = CAN_signals_find(dwID);
+    const stCANMessage_t *pstMessage;
+    const stCANSignal_t *pstSignal;
+    word wN = 0;
+    word wRow;
+
+    if (pstFound == NULL)
+    {
+        return 0;
+    }
+    pstMessage = pstFound->pstMessage;
+    sim_decode_call(pstMessage, abyData, byDLC, SIM_DECODE_FILL_A, aabyA);
+    sim_decode_call(pstMessage, abyData, byDLC, SIM_DECODE_FILL_B, aabyB);
+    for (wRow = 0; wRow < pstMessage->wNSignals; wRow++)
+    {
+        pstSignal = &astCANSignals[pstMessage->wFirstSignal + wRow];
+        if (memcmp(aabyA[wRow], aabyB[wRow], sim_decode_size(pstSignal->eType)) == 0)
+        {
+            awSignals[wN] = (word)(pstMessage->wFirstSignal + wRow);
+            afValues[wN++] = sim_decode_read(pstSignal, aabyA[wRow]);
+        }
+    }
+    return wN;
+}
+
+word sim_decode_table(uint32_t dwID, const byte *abyData, byte byDLC, word *awSignals, double *afValues)
+{
+    /* The same through the table, as sdlog_decode does */
+    const stCANSignalMessage_t *pstMessage = CAN_signals_find(dwID);
+
+    return pstMessage == NULL ? 0 : CAN_signals_decode(pstMessage, abyData, byDLC, awSignals, afValues);
+}
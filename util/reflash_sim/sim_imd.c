@@ -0,0 +1,175 @@
+/*
+sim_imd.c
+Host side of the ESP-IDF calls used by imd.c, so its capture and decoding can run on a PC for
+imd_bench.py against synthetic edge streams. Built with main/imd.c and main/CAN/canDecodeAuto.c
+for the IMDData signals it sets.
+
+Time is virtual. sim_imd_run walks a stream of edges in time order, each one the capture
+channel's callback with the capture timer's count at that time, and calls IMD_update every 100 ms
+between them as task_100ms would, recording what it decoded each time. The capture timer counts
+at SIM_IMD_RESOLUTION_HZ from a start count the bench picks, so its 32 bit wrap can be crossed.
+The pin's level is the last edge's, for the 0 Hz states.
+
+Written for Sheffield Formula Racing 2026
+*/
+#include <math.h>
+#include <stdarg.h>
+#include "imd.h"
+
+/* --------------------------- Definitions ----------------------------- */
+#define SIM_IMD_RESOLUTION_HZ   160000000   // Capture timer on the C6's 160 MHz PLL clock
+#define SIM_IMD_UPDATE_US       100000      // task_100ms
+
+/* --------------------------- Local Variables ----------------------------- */
+static mcpwm_capture_event_cb_t pfnSimCapture = NULL;
+static void *pvSimCaptureArg = NULL;
+static int NSimLevel = 0;
+static dword dwSimStartCount = 0;
+static qword qwtSimus = 0;
+static qword qwtSimNextUpdate = SIM_IMD_UPDATE_US;
+static int NVerbose = 0;
+
+/* --------------------------- Function prototypes ----------------------------- */
+int sim_imd_init(dword dwStartCount, int NVerboseLog);
+dword sim_imd_run(const double *adtEdges, const byte *abyLevels, dword dwNEdges, double dEnd,
+                  float *afHz, float *afDuty, int *aeState, float *afROhms, byte *abyFlags, dword dwMaxUpdates);
+esp_err_t CAN_transmit(twai_node_handle_t stCANBus, const CAN_frame_t *stFrame);
+
+/* --------------------------- Harness ----------------------------- */
+int sim_imd_init(dword dwStartCount, int NVerboseLog)
+{
+    dwSimStartCount = dwStartCount;
+    NVerbose = NVerboseLog;
+    return IMD_init(IMD_PWM_IN);
+}
+
+dword sim_imd_run(const double *adtEdges, const byte *abyLevels, dword dwNEdges, double dEnd,
+                  float *afHz, float *afDuty, int *aeState, float *afROhms, byte *abyFlags, dword dwMaxUpdates)
+{
+    /*  Edges at adtEdges seconds, rising to abyLevels 1 or falling to 0, IMD_update every 100 ms
+        to dEnd seconds. Each update's fIMDPWM, rIMDPWM, state, RIsolation and IMDData's flags,
+        BIMDOff in bit 6 down to BIMDInvalidState in bit 0, go in the arrays. Returns how many. */
+    mcpwm_capture_event_data_t stEvent;
+    dword dwNEdge = 0;
+    dword dwNUpdates = 0;
+    qword qwtEdge;
+    qword qwtEnd = (qword)(dEnd * 1e6);
+
+    while (qwtSimNextUpdate <= qwtEnd && dwNUpdates < dwMaxUpdates)
+    {
+        /* Edges before the update, in their order */
+        while (dwNEdge < dwNEdges && (qwtEdge = (qword)(adtEdges[dwNEdge] * 1e6)) < qwtSimNextUpdate)
+        {
+            qwtSimus = qwtEdge;
+            NSimLevel = abyLevels[dwNEdge];
+            stEvent.cap_value = (uint32_t)(dwSimStartCount + (qword)llround(adtEdges[dwNEdge] * SIM_IMD_RESOLUTION_HZ));
+            stEvent.cap_edge = abyLevels[dwNEdge] ? MCPWM_CAP_EDGE_POS : MCPWM_CAP_EDGE_NEG;
+            (void)pfnSimCapture(NULL, &stEvent, pvSimCaptureArg);
+            dwNEdge++;
+        }
+        qwtSimus = qwtSimNextUpdate;
+        aeState[dwNUpdates] = (int)IMD_update();
+        afHz[dwNUpdates] = fIMDPWM;
+        afDuty[dwNUpdates] = rIMDPWM;
+        afROhms[dwNUpdates] = RIsolation;
+        abyFlags[dwNUpdates] = (byte)(BIMDOff << 6 | BIMDUnderVoltage << 5 | BIMDStarting << 4 | BIMDSSTGood << 3 |
+                                      BIMDDeviceError << 2 | BIMDGroundConnectionFault << 1 | BIMDInvalidState);
+        dwNUpdates++;
+        qwtSimNextUpdate += SIM_IMD_UPDATE_US;
+    }
+    return dwNUpdates;
+}
+
+/* --------------------------- ESP-IDF MCPWM capture and GPIO ----------------------------- */
+esp_err_t mcpwm_new_capture_timer(const mcpwm_capture_timer_config_t *pstConfig, mcpwm_cap_timer_handle_t *pstTimer)
+{
+    (void)pstConfig;
+    *pstTimer = (mcpwm_cap_timer_handle_t)&dwSimStartCount;
+    return ESP_OK;
+}
+
+esp_err_t mcpwm_new_capture_channel(mcpwm_cap_timer_handle_t stTimer, const mcpwm_capture_channel_config_t *pstConfig,
+                                    mcpwm_cap_channel_handle_t *pstChannel)
+{
+    (void)stTimer;
+    if (!pstConfig->flags.pos_edge || !pstConfig->flags.neg_edge)
+    {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    *pstChannel = (mcpwm_cap_channel_handle_t)&pfnSimCapture;
+    return ESP_OK;
+}
+
+esp_err_t mcpwm_capture_channel_register_event_callbacks(mcpwm_cap_channel_handle_t stChannel,
+                                                         const mcpwm_capture_event_callbacks_t *pstCallbacks, void *pvArg)
+{
+    (void)stChannel;
+    pfnSimCapture = pstCallbacks->on_cap;
+    pvSimCaptureArg = pvArg;
+    return ESP_OK;
+}
+
+esp_err_t mcpwm_capture_channel_enable(mcpwm_cap_channel_handle_t stChannel)
+{
+    (void)stChannel;
+    return ESP_OK;
+}
+
+esp_err_t mcpwm_capture_timer_enable(mcpwm_cap_timer_handle_t stTimer)
+{
+    (void)stTimer;
+    return ESP_OK;
+}
+
+esp_err_t mcpwm_capture_timer_start(mcpwm_cap_timer_handle_t stTimer)
+{
+    (void)stTimer;
+    return ESP_OK;
+}
+
+esp_err_t mcpwm_capture_timer_get_resolution(mcpwm_cap_timer_handle_t stTimer, uint32_t *pdwResolutionHz)
+{
+    (void)stTimer;
+    *pdwResolutionHz = SIM_IMD_RESOLUTION_HZ;
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t ePin)
+{
+    (void)ePin;
+    return NSimLevel;
+}
+
+/* --------------------------- CAN ----------------------------- */
+esp_err_t CAN_transmit(twai_node_handle_t stCANBus, const CAN_frame_t *stFrame)
+{
+    /* canDecodeAuto.c's Tx functions need it, the bench reads the signals instead */
+    (void)stCANBus;
+    (void)stFrame;
+    return ESP_OK;
+}
+
+/* --------------------------- System ----------------------------- */
+int64_t esp_timer_get_time(void)
+{
+    return (int64_t)qwtSimus;
+}
+
+const char *esp_err_to_name(esp_err_t eStatus)
+{
+    return eStatus == ESP_OK ? "ESP_OK" : "ESP_ERR";
+}
+
+void sim_log(char cLevel, const char *sTag, const char *sFormat, ...)
+{
+    va_list stArgs;
+    if (!NVerbose && cLevel == 'I')
+    {
+        return;
+    }
+    fprintf(stderr, "%c (%s) ", cLevel, sTag);
+    va_start(stArgs, sFormat);
+    vfprintf(stderr, sFormat, stArgs);
+    va_end(stArgs);
+    fputc('\n', stderr);
+}
@@ -0,0 +1,344 @@
+/*
+sim_mcp320X.c
+Host side of the ESP-IDF calls used by mcp320X.c, so its scanning can run on a PC for
+mcp320X_bench.py. Built with sim_adc.c and main/adc.c for the sensor maps, with main/calibration.c
+for the Dyno's tables, and with main/CAN/canDecodeAuto.c for the signals it sets. There is no NVS
+so no table is ever loaded and the Dyno's values stay SENSOR_INVALID, the bench checks their raw
+counts.
+
+Time is virtual. The scan task is run on the calling thread and time only moves when an SPI call
+takes it or the task waits on its notification. The timer's ticks are given out at that point,
+each one a xTaskNotifyGive as the firmware's callback does. When time is up the wait jumps back
+to sim_mcp_run, between scans, and the next run starts the task again from the top.
+
+An SPI transaction takes its 24 bits at the device's clock plus a fixed cost for the driver:
+    - spi_device_transmit, queued and waited on through the driver's interrupt, SIM_MCP_QUEUED_US.
+    - spi_device_polling_transmit, SIM_MCP_POLLING_US, less SIM_MCP_LOCK_US for the bus lock when
+      the bus is already acquired.
+These are a model of the ESP-IDF SPI master's overheads at 160 MHz, not a measurement. Each
+channel reads back sim_mcp_count for its device and channel, decoded from the command it was sent.
+
+Written for Sheffield Formula Racing 2026
+*/
+#include <setjmp.h>
+#include "mcp320X.h"
+
+/* --------------------------- Definitions ----------------------------- */
+#define SIM_MCP_DEVICES         4
+#define SIM_MCP_QUEUED_US       25.0    // Queue, ISR, semaphore and context switch back
+#define SIM_MCP_POLLING_US      8.0
+#define SIM_MCP_LOCK_US         3.0     // Of the polling cost, taking and giving the bus lock
+#define SIM_MCP_ACQUIRE_US      3.0     // spi_device_acquire_bus and release together
+
+/* --------------------------- Local Types ----------------------------- */
+typedef struct {
+    int NCSPin;
+    int NClockHz;
+} stSimMCPDevice_t;
+
+/* --------------------------- Local Variables ----------------------------- */
+static stSimMCPDevice_t astSimDevices[SIM_MCP_DEVICES];
+static int NSimNDevices = 0;
+static stSimMCPDevice_t *pstSimBusOwner = NULL;
+static word aawSimCounts[SIM_MCP_DEVICES][MCP320X_MAX_CHANNELS];
+static qword qwtSimns = 0;
+static qword qwtSimEndns = 0;
+static qword qwtSimNextTickns = 0;
+static qword qwSimPeriodns = 0;
+static void (*pfnSimTimer)(void *) = NULL;
+static void *pvSimTimerArg = NULL;
+static void (*pfnSimTask)(void *) = NULL;
+static void *pvSimTaskArg = NULL;
+static dword dwSimNotified = 0;
+static dword dwSimNTransactions = 0;
+static dword dwSimNBadCommands = 0;
+static jmp_buf stSimEnd;
+
+/* --------------------------- Function prototypes ----------------------------- */
+void sim_mcp_set_count(int NDevice, int NChannel, word wCount);
+void sim_mcp_set_rate(dword dwScanHz);
+double sim_mcp_run(double dSeconds);
+double sim_mcp_legacy(dword dwNRounds, spi_device_handle_t *astHandles, const byte *abyNChannels,
+                      word wNDevices, float *afVolts);
+void sim_mcp_counters(dword *pdwNTransactions, dword *pdwNBadCommands);
+esp_err_t CAN_transmit(twai_node_handle_t stCANBus, const CAN_frame_t *stFrame);
+
+/* --------------------------- Helpers ----------------------------- */
+static void sim_mcp_ticks(void)
+{
+    /* Every timer tick up to now */
+    while (pfnSimTimer != NULL && qwSimPeriodns != 0 && qwtSimNextTickns <= qwtSimns)
+    {
+        pfnSimTimer(pvSimTimerArg);
+        qwtSimNextTickns += qwSimPeriodns;
+    }
+}
+
+static esp_err_t sim_mcp_transaction(spi_device_handle_t stHandle, spi_transaction_t *pstCall, double dOverheadus)
+{
+    /* 24 clocks, the command decoded as the MCP320X would and its count clocked back */
+    stSimMCPDevice_t *pstDevice = (stSimMCPDevice_t *)stHandle;
+    const byte *abyTx = (pstCall->flags & SPI_TRANS_USE_TXDATA) ? pstCall->tx_data : pstCall->tx_buffer;
+    byte *abyRx = (pstCall->flags & SPI_TRANS_USE_RXDATA) ? pstCall->rx_data : pstCall->rx_buffer;
+    int NDevice = (int)(pstDevice - astSimDevices);
+    int NChannel;
+    word wCount = 0;
+
+    if (pstCall->length != 24 || abyTx == NULL || abyRx == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* Start and single ended bits, then D2 D1 D0 */
+    if ((abyTx[0] & 0x6) != 0x6)
+    {
+        dwSimNBadCommands++;
+    }
+    else
+    {
+        NChannel = ((abyTx[0] & 0x1) << 2) | (abyTx[1] >> 6);
+        wCount = aawSimCounts[NDevice][NChannel];
+    }
+    abyRx[0] = 0xFF;
+    abyRx[1] = (byte)(0xE0 | (wCount >> 8));    // B12 null bit is 0, the bits before it float
+    abyRx[2] = (byte)wCount;
+    qwtSimns += (qword)(dOverheadus * 1000.0 + 24.0 * 1e9 / pstDevice->NClockHz);
+    dwSimNTransactions++;
+    return ESP_OK;
+}
+
+/* --------------------------- Harness ----------------------------- */
+void sim_mcp_set_count(int NDevice, int NChannel, word wCount)
+{
+    aawSimCounts[NDevice][NChannel] = wCount & 0xFFF;
+}
+
+void sim_mcp_set_rate(dword dwScanHz)
+{
+    /* esp_timer_restart as it were, the next tick a period from now */
+    qwSimPeriodns = 1000000000ULL / dwScanHz;
+    qwtSimNextTickns = qwtSimns + qwSimPeriodns;
+}
+
+double sim_mcp_run(double dSeconds)
+{
+    /* Runs the scan task for dSeconds of virtual time, returns the time reached */
+    qwtSimEndns = qwtSimns + (qword)(dSeconds * 1e9);
+    if (pfnSimTask != NULL && setjmp(stSimEnd) == 0)
+    {
+        pfnSimTask(pvSimTaskArg);
+    }
+    return qwtSimns / 1e9;
+}
+
+double sim_mcp_legacy(dword dwNRounds, spi_device_handle_t *astHandles, const byte *abyNChannels,
+                      word wNDevices, float *afVolts)
+{
+    /*  Reads every channel with MCP320X_read dwNRounds times, as a task would without the scan.
+        The last round's volts go in afVolts, device by device. Returns the virtual seconds taken. */
+    qword qwtStart = qwtSimns;
+    dword dwRound;
+    word wDevice;
+    byte byChannel;
+    word wN;
+
+    for (dwRound = 0; dwRound < dwNRounds; dwRound++)
+    {
+        wN = 0;
+        for (wDevice = 0; wDevice < wNDevices; wDevice++)
+        {
+            for (byChannel = 0; byChannel < abyNChannels[wDevice]; byChannel++)
+            {
+                afVolts[wN++] = MCP320X_read(astHandles[wDevice], byChannel);
+            }
+        }
+    }
+    return (qwtSimns - qwtStart) / 1e9;
+}
+
+void sim_mcp_counters(dword *pdwNTransactions, dword *pdwNBadCommands)
+{
+    *pdwNTransactions = dwSimNTransactions;
+    *pdwNBadCommands = dwSimNBadCommands;
+}
+
+esp_err_t CAN_transmit(twai_node_handle_t stCANBus, const CAN_frame_t *stFrame)
+{
+    /* Only the Tx functions in canDecodeAuto.c call it, nothing here does */
+    (void)stCANBus;
+    (void)stFrame;
+    return ESP_OK;
+}
+
+/* --------------------------- Calibration tables ----------------------------- */
+twai_node_handle_t stCANBus0 = NULL;
+
+esp_err_t NVS_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char *sNamespace, nvs_open_mode_t eMode, nvs_handle_t *pstHandle)
+{
+    /* Nothing stored, calibration.c finds no tables */
+    (void)sNamespace;
+    (void)eMode;
+    (void)pstHandle;
+    return ESP_ERR_NVS_NOT_FOUND;
+}
+
+void nvs_close(nvs_handle_t stHandle)
+{
+    (void)stHandle;
+}
+
+esp_err_t nvs_commit(nvs_handle_t stHandle)
+{
+    (void)stHandle;
+    return ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t stHandle, const char *sKey, void *pvData, size_t *pdwSize)
+{
+    (void)stHandle;
+    (void)sKey;
+    (void)pvData;
+    (void)pdwSize;
+    return ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t stHandle, const char *sKey, const void *pvData, size_t dwSize)
+{
+    (void)stHandle;
+    (void)sKey;
+    (void)pvData;
+    (void)dwSize;
+    return ESP_ERR_NVS_NOT_FOUND;
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    /* Only reached through CAL_update, which nothing here calls */
+    (void)buf;
+    (void)len;
+    return crc;
+}
+
+/* --------------------------- ESP-IDF SPI ----------------------------- */
+esp_err_t spi_bus_add_device(spi_host_device_t eHost, const spi_device_interface_config_t *pstConfig,
+                             spi_device_handle_t *pstHandle)
+{
+    (void)eHost;
+    if (NSimNDevices >= SIM_MCP_DEVICES)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    astSimDevices[NSimNDevices].NCSPin = pstConfig->spics_io_num;
+    astSimDevices[NSimNDevices].NClockHz = pstConfig->clock_speed_hz;
+    *pstHandle = &astSimDevices[NSimNDevices++];
+    return ESP_OK;
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t stHandle, spi_transaction_t *pstCall)
+{
+    if (pstSimBusOwner != NULL && pstSimBusOwner != (stSimMCPDevice_t *)stHandle)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return sim_mcp_transaction(stHandle, pstCall, SIM_MCP_QUEUED_US);
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t stHandle, spi_transaction_t *pstCall)
+{
+    if (pstSimBusOwner != NULL && pstSimBusOwner != (stSimMCPDevice_t *)stHandle)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return sim_mcp_transaction(stHandle, pstCall,
+                               pstSimBusOwner != NULL ? SIM_MCP_POLLING_US - SIM_MCP_LOCK_US : SIM_MCP_POLLING_US);
+}
+
+esp_err_t spi_device_acquire_bus(spi_device_handle_t stHandle, TickType_t xWait)
+{
+    (void)xWait;
+    if (pstSimBusOwner != NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    pstSimBusOwner = (stSimMCPDevice_t *)stHandle;
+    qwtSimns += (qword)(SIM_MCP_ACQUIRE_US * 1000.0);
+    return ESP_OK;
+}
+
+void spi_device_release_bus(spi_device_handle_t stHandle)
+{
+    if (pstSimBusOwner == (stSimMCPDevice_t *)stHandle)
+    {
+        pstSimBusOwner = NULL;
+    }
+}
+
+/* --------------------------- Timer and tasks ----------------------------- */
+esp_err_t esp_timer_create(const esp_timer_create_args_t *pstArgs, esp_timer_handle_t *pstTimer)
+{
+    pfnSimTimer = pstArgs->callback;
+    pvSimTimerArg = pstArgs->arg;
+    *pstTimer = (esp_timer_handle_t)&pfnSimTimer;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t stTimer, uint64_t qwPeriodus)
+{
+    (void)stTimer;
+    qwSimPeriodns = qwPeriodus * 1000;
+    qwtSimNextTickns = qwtSimns + qwSimPeriodns;
+    return ESP_OK;
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return (int64_t)(qwtSimns / 1000);
+}
+
+BaseType_t xTaskCreate(void (*pfnTask)(void *), const char *sName, uint32_t dwStack, void *pvArg,
+                       UBaseType_t uxPriority, TaskHandle_t *pxTask)
+{
+    /* Not started until sim_mcp_run */
+    (void)sName;
+    (void)dwStack;
+    (void)uxPriority;
+    pfnSimTask = pfnTask;
+    pvSimTaskArg = pvArg;
+    if (pxTask != NULL)
+    {
+        *pxTask = (TaskHandle_t)&pfnSimTask;
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTask)
+{
+    (void)xTask;
+    dwSimNotified++;
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClear, TickType_t xTicks)
+{
+    /* Where virtual time passes, waits for the next tick if none came during the last scan */
+    uint32_t dwNotified;
+
+    (void)xTicks;
+    sim_mcp_ticks();
+    if (dwSimNotified == 0 && qwSimPeriodns != 0)
+    {
+        qwtSimns = qwtSimNextTickns;
+        sim_mcp_ticks();
+    }
+    if (qwtSimns >= qwtSimEndns || qwSimPeriodns == 0)
+    {
+        longjmp(stSimEnd, 1);
+    }
+    dwNotified = dwSimNotified;
+    dwSimNotified = xClear ? 0 : dwNotified - 1;
+    return dwNotified;
+}
@@ -0,0 +1,887 @@
+/*
+sim_platform.c
+Host side of the ESP-IDF calls used by the reflash path, so canflash.c, tasks.c, can.c and the
+ESP-NOW reflash can run on a PC. Each node is one copy of the shared library built by
+reflash_sim.py, the OTA partition is a file and NVS is a directory of files so they outlive a
+simulated power cut. CAN and ESP-NOW frames are passed in and out by the harness.
+
+Only what the reflash path and the telemetry sender need is modelled:
+    - Flash writes can only clear bits and erases must be whole sectors, like the real part.
+    - Erase and write times are configurable so the harness can match the ESP32-C6.
+    - FreeRTOS queues are plain ring buffers, everything runs on the harness's node thread.
+    - The clock is the PC's unless the harness sets it, a replay runs on its own time.
+    - The radio holds a configurable number of packets. The harness takes each one off when it
+      goes on air and reports the result when the airtime is up, or both at once.
+
+Written for Sheffield Formula Racing 2026
+*/
+#define _GNU_SOURCE
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "main.h"
+#include "tasks.h"
+#include "esp_partition.h"
+#include "esp_ota_ops.h"
+#include "esp_twai.h"
+#include "esp_twai_onchip.h"
+#include "esp_now.h"
+#include "esp_wifi.h"
+#include "esp_event.h"
+#include "esp_netif.h"
+#include "nvs.h"
+#include "nvs_flash.h"
+#include "driver/gpio.h"
+#include "driver/usb_serial_jtag.h"
+
+/* The stubs keep the IDF signatures, most of their arguments go unused */
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+
+/* --------------------------- Definitions ----------------------------- */
+#define SIM_OTA_ADDRESS         0x110000
+#define SIM_SECTOR_SIZE         4096
+#define SIM_CAN_TX_LENGTH       512
+#define SIM_ESPNOW_TX_LENGTH    64
+#define SIM_MAX_NVS_HANDLES     8
+#define SIM_MAX_PATH            512
+#define SIM_INTERVAL_1MS        1000    // us, same as main.c
+#define SIM_INTERVAL_100MS      100000
+
+/* --------------------------- Local Types ----------------------------- */
+typedef struct
+{
+    dword dwID;
+    byte byExtended;
+    byte byDLC;
+    byte abData[8];
+} stSimCANFrame_t;
+
+typedef struct
+{
+    byte abyMAC[6];
+    word wNLength;
+    byte abyData[MAX_ESPNOW_PAYLOAD];
+} stSimESPNOWPacket_t;
+
+typedef struct
+{
+    byte *abyItems;
+    dword dwItemSize;
+    dword dwLength;
+    dword dwHead;
+    dword dwNItems;
+} stSimQueue_t;
+
+/* --------------------------- Global Variables ----------------------------- */
+eChipMode_t eDeviceMode = eNORMAL;
+esp_reset_reason_t eResetReason = 0;
+
+/* --------------------------- Local Variables ----------------------------- */
+static FILE *pstFlash = NULL;
+static esp_partition_t stOTAPartition = { .address = SIM_OTA_ADDRESS, .label = "ota_1" };
+static char sNVSDir[256];
+static char asNVSNamespace[SIM_MAX_NVS_HANDLES][16];
+static dword dwEraseDelayus = 0;
+static dword dwWriteDelayus = 0;
+static dword dwWriteByteDelayns = 0;
+static int NLogLevel = 1;
+static char sLogPrefix[32] = "";
+static boolean BRestarted = FALSE;
+static boolean BBootSet = FALSE;
+static byte abyMAC[6];
+static jmp_buf stRestartJump;
+static qword qwtNext1ms = 0;
+static qword qwtNext100ms = 0;
+
+static twai_event_callbacks_t stCANCallbacks;
+static const stSimCANFrame_t *pstCANRxFrame = NULL;
+static stSimCANFrame_t astCANTx[SIM_CAN_TX_LENGTH];
+static dword dwCANTxHead = 0;
+static dword dwNCANTx = 0;
+static dword dwNCANTxDropped = 0;
+
+static esp_now_recv_cb_t pfnESPNOWRx = NULL;
+static esp_now_send_cb_t pfnESPNOWTxDone = NULL;
+static wifi_tx_info_t stTxInfo;
+static stSimESPNOWPacket_t astESPNOWTx[SIM_ESPNOW_TX_LENGTH];
+static dword dwESPNOWTxHead = 0;
+static dword dwNESPNOWTx = 0;
+static dword dwESPNOWTxLength = SIM_ESPNOW_TX_LENGTH;
+static dword dwNESPNOWOnAir = 0;
+static int NESPNOWRate = -1;           // wifi_phy_rate_t set for the peer, -1 until set
+static wifi_pkt_rx_ctrl_t stRxCtrl;
+static boolean BRxCtrl = FALSE;
+static boolean BVirtualTime = FALSE;
+static qword qwtVirtual = 0;
+static qword qwRxCPUns = 0;            // Host CPU time in the ESP-NOW Rx callback
+static dword dwNRxCPU = 0;
+static qword qwBGCPUns = 0;            // Host CPU time in the background task
+
+/* --------------------------- Function prototypes ----------------------------- */
+static qword sim_cpu_ns(void);
+int sim_init(const char *sFlashPath, const char *sNVSPath, dword dwPartitionSize, const byte *abyNodeMAC,
+    const char *sPrefix, int NLevel);
+void sim_set_delays(dword dwEraseus, dword dwWriteus, dword dwWriteBytens);
+void sim_can_rx(dword dwID, int NExtended, int NDLC, const byte *abyData);
+int sim_can_tx_pop(dword *pdwID, int *pNExtended, byte *abyData);
+void sim_espnow_rx(const byte *abySourceMAC, const byte *abyData, int NLength);
+int sim_espnow_tx_pop(byte *abyDestMAC, byte *abyData);
+int sim_espnow_tx_start(byte *abyDestMAC, byte *abyData);
+void sim_espnow_tx_done(int NSuccess);
+void sim_espnow_set_tx_length(dword dwLength);
+void sim_espnow_set_rssi(int NRSSI);
+int sim_espnow_rate(void);
+void sim_cpu_times(qword *pqwRxns, dword *pdwNRx, qword *pqwBGns);
+void sim_set_time(qword qwtNow);
+void sim_run_bg(void);
+int sim_restarted(void);
+int sim_boot_set(void);
+int sim_mode(void);
+void sim_close(void);
+
+/* --------------------------- Harness interface ----------------------------- */
+int sim_init(const char *sFlashPath, const char *sNVSPath, dword dwPartitionSize, const byte *abyNodeMAC,
+    const char *sPrefix, int NLevel)
+{
+    /* Power on, the partition file and NVS directory keep what the last run left */
+    pstFlash = fopen(sFlashPath, "r+b");
+    if (pstFlash == NULL)
+    {
+        byte abyBlank[SIM_SECTOR_SIZE];
+        memset(abyBlank, 0xFF, sizeof(abyBlank));
+        pstFlash = fopen(sFlashPath, "w+b");
+        if (pstFlash == NULL)
+        {
+            return -1;
+        }
+        for (dword dwOffset = 0; dwOffset < dwPartitionSize; dwOffset += SIM_SECTOR_SIZE)
+        {
+            fwrite(abyBlank, 1, SIM_SECTOR_SIZE, pstFlash);
+        }
+        fflush(pstFlash);
+    }
+    stOTAPartition.size = dwPartitionSize;
+    stOTAPartition.erase_size = SIM_SECTOR_SIZE;
+    snprintf(sNVSDir, sizeof(sNVSDir), "%s", sNVSPath);
+    snprintf(sLogPrefix, sizeof(sLogPrefix), "%s", sPrefix);
+    memcpy(abyMAC, abyNodeMAC, sizeof(abyMAC));
+    NLogLevel = NLevel;
+
+    /* Same order as main_init */
+    if (ESPNOW_init() != ESP_OK || ESPNOW_flash_init() != ESP_OK)
+    {
+        return -1;
+    }
+    if (CAN_init(TRUE) != ESP_OK || CAN_flash_init() != ESP_OK)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+void sim_set_delays(dword dwEraseus, dword dwWriteus, dword dwWriteBytens)
+{
+    /* Erase time per sector, write time per call plus per byte */
+    dwEraseDelayus = dwEraseus;
+    dwWriteDelayus = dwWriteus;
+    dwWriteByteDelayns = dwWriteBytens;
+}
+
+void sim_can_rx(dword dwID, int NExtended, int NDLC, const byte *abyData)
+{
+    /* Frame arrives on the bus, the driver calls the Rx callback which reads it */
+    stSimCANFrame_t stFrame = { .dwID = dwID, .byExtended = (byte)NExtended, .byDLC = (byte)NDLC };
+    memcpy(stFrame.abData, abyData, NDLC);
+    if (stCANCallbacks.on_rx_done == NULL || BRestarted)
+    {
+        return;
+    }
+    pstCANRxFrame = &stFrame;
+    (void)stCANCallbacks.on_rx_done(stCANBus0, NULL, NULL);
+    pstCANRxFrame = NULL;
+}
+
+int sim_can_tx_pop(dword *pdwID, int *pNExtended, byte *abyData)
+{
+    /* Returns the DLC of the next transmitted frame or -1 if none */
+    stSimCANFrame_t *pstFrame;
+    if (dwNCANTx == 0)
+    {
+        return -1;
+    }
+    pstFrame = &astCANTx[dwCANTxHead];
+    dwCANTxHead = (dwCANTxHead + 1) % SIM_CAN_TX_LENGTH;
+    dwNCANTx--;
+    *pdwID = pstFrame->dwID;
+    *pNExtended = pstFrame->byExtended;
+    memcpy(abyData, pstFrame->abData, pstFrame->byDLC);
+    return pstFrame->byDLC;
+}
+
+void sim_espnow_rx(const byte *abySourceMAC, const byte *abyData, int NLength)
+{
+    esp_now_recv_info_t stInfo = { .src_addr = (uint8_t *)abySourceMAC, .des_addr = abyMAC,
+                                   .rx_ctrl = BRxCtrl ? &stRxCtrl : NULL };
+    qword qwStart;
+    if (pfnESPNOWRx != NULL && !BRestarted)
+    {
+        qwStart = sim_cpu_ns();
+        pfnESPNOWRx(&stInfo, abyData, NLength);
+        qwRxCPUns += sim_cpu_ns() - qwStart;
+        dwNRxCPU++;
+    }
+}
+
+int sim_espnow_tx_pop(byte *abyDestMAC, byte *abyData)
+{
+    /* Returns the length of the next sent packet or -1 if none */
+    int NLength = sim_espnow_tx_start(abyDestMAC, abyData);
+    if (NLength >= 0)
+    {
+        /* Popped packets count as sent, the harness drops them after the MAC layer */
+        sim_espnow_tx_done(TRUE);
+    }
+    return NLength;
+}
+
+int sim_espnow_tx_start(byte *abyDestMAC, byte *abyData)
+{
+    /* Next packet goes on air, returns its length or -1 if none. The radio slot stays taken */
+    stSimESPNOWPacket_t *pstPacket;
+    if (dwNESPNOWTx == 0)
+    {
+        return -1;
+    }
+    pstPacket = &astESPNOWTx[dwESPNOWTxHead];
+    dwESPNOWTxHead = (dwESPNOWTxHead + 1) % SIM_ESPNOW_TX_LENGTH;
+    dwNESPNOWTx--;
+    dwNESPNOWOnAir++;
+    memcpy(abyDestMAC, pstPacket->abyMAC, 6);
+    memcpy(abyData, pstPacket->abyData, pstPacket->wNLength);
+    return pstPacket->wNLength;
+}
+
+void sim_espnow_tx_done(int NSuccess)
+{
+    /* Airtime is up, the send callback reports whether the peer ACKed it */
+    if (dwNESPNOWOnAir > 0)
+    {
+        dwNESPNOWOnAir--;
+    }
+    if (pfnESPNOWTxDone != NULL)
+    {
+        pfnESPNOWTxDone(&stTxInfo, NSuccess ? ESP_NOW_SEND_SUCCESS : ESP_NOW_SEND_FAIL);
+    }
+}
+
+void sim_espnow_set_tx_length(dword dwLength)
+{
+    /* Packets the radio buffers before esp_now_send returns ESP_ERR_ESPNOW_NO_MEM */
+    dwESPNOWTxLength = dwLength < SIM_ESPNOW_TX_LENGTH ? dwLength : SIM_ESPNOW_TX_LENGTH;
+}
+
+void sim_espnow_set_rssi(int NRSSI)
+{
+    /* RSSI of the packets passed to sim_espnow_rx from now on, 0 for none */
+    BRxCtrl = NRSSI != 0;
+    stRxCtrl.rssi = NRSSI;
+}
+
+int sim_espnow_rate(void)
+{
+    /* PHY rate last set for the peer, -1 if never */
+    return NESPNOWRate;
+}
+
+void sim_set_time(qword qwtNow)
+{
+    /* From the first call esp_timer_get_time returns the harness's time */
+    BVirtualTime = TRUE;
+    qwtVirtual = qwtNow;
+}
+
+void sim_run_bg(void)
+{
+    /* One pass of the app_main loop, the timer tasks run first if they are due */
+    qword qwtNow = (qword)esp_timer_get_time();
+    qword qwStart;
+    if (BRestarted || setjmp(stRestartJump) != 0)
+    {
+        return;
+    }
+    if (qwtNow >= qwtNext1ms)
+    {
+        qwtNext1ms = qwtNow + SIM_INTERVAL_1MS;
+        if (eDeviceMode == eNORMAL)
+        {
+            task_1ms();
+        }
+    }
+    if (qwtNow >= qwtNext100ms)
+    {
+        qwtNext100ms = qwtNow + SIM_INTERVAL_100MS;
+        if (eDeviceMode == eNORMAL)
+        {
+            task_100ms();
+        } else
+        {
+            reflash_task_100ms();
+        }
+    }
+    if (eDeviceMode == eNORMAL)
+    {
+        qwStart = sim_cpu_ns();
+        task_BG();
+        qwBGCPUns += sim_cpu_ns() - qwStart;
+    } else
+    {
+        reflash_task_BG();
+    }
+}
+
+void sim_cpu_times(qword *pqwRxns, dword *pdwNRx, qword *pqwBGns)
+{
+    /* Host CPU time the firmware has spent in the ESP-NOW Rx callback and the background task */
+    *pqwRxns = qwRxCPUns;
+    *pdwNRx = dwNRxCPU;
+    *pqwBGns = qwBGCPUns;
+}
+
+int sim_restarted(void)
+{
+    return BRestarted;
+}
+
+int sim_boot_set(void)
+{
+    return BBootSet;
+}
+
+int sim_mode(void)
+{
+    return eDeviceMode;
+}
+
+void sim_close(void)
+{
+    if (pstFlash != NULL)
+    {
+        fclose(pstFlash);
+        pstFlash = NULL;
+    }
+}
+
+/* --------------------------- main.c ----------------------------- */
+void set_device_mode(eChipMode_t mode)
+{
+    eDeviceMode = mode;
+}
+
+void sim_log(char cLevel, const char *sTag, const char *sFormat, ...)
+{
+    /* Level 0 silent, 1 errors and warnings, 2 everything */
+    va_list args;
+    if (NLogLevel == 0 || (NLogLevel == 1 && cLevel != 'E' && cLevel != 'W'))
+    {
+        return;
+    }
+    fprintf(stderr, "%s %c (%s) ", sLogPrefix, cLevel, sTag);
+    va_start(args, sFormat);
+    vfprintf(stderr, sFormat, args);
+    va_end(args);
+    fputc('\n', stderr);
+}
+
+const char *esp_err_to_name(esp_err_t eErr)
+{
+    static char sName[16];
+    switch (eErr)
+    {
+        case ESP_OK:                    return "ESP_OK";
+        case ESP_FAIL:                  return "ESP_FAIL";
+        case ESP_ERR_NO_MEM:            return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG:       return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE:     return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_INVALID_SIZE:      return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FOUND:         return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_TIMEOUT:           return "ESP_ERR_TIMEOUT";
+        case ESP_ERR_INVALID_CRC:       return "ESP_ERR_INVALID_CRC";
+        case ESP_ERR_NVS_NOT_FOUND:     return "ESP_ERR_NVS_NOT_FOUND";
+        default:
+            snprintf(sName, sizeof(sName), "0x%x", eErr);
+            return sName;
+    }
+}
+
+/* --------------------------- System ----------------------------- */
+static qword sim_cpu_ns(void)
+{
+    /* Thread CPU time, unlike esp_timer_get_time it is never virtual */
+    struct timespec stNow;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &stNow);
+    return (qword)stNow.tv_sec * 1000000000 + stNow.tv_nsec;
+}
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec stNow;
+    if (BVirtualTime)
+    {
+        return (int64_t)qwtVirtual;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stNow);
+    return (int64_t)stNow.tv_sec * 1000000 + stNow.tv_nsec / 1000;
+}
+
+void esp_restart(void)
+{
+    /* Never returns, the harness reloads the library to boot again */
+    BRestarted = TRUE;
+    longjmp(stRestartJump, 1);
+}
+
+void vTaskDelay(TickType_t xTicks)
+{
+    usleep(xTicks * 1000 / configTICK_RATE_HZ * 1000);
+}
+
+esp_err_t esp_task_wdt_reset(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t SD_card_write_CAN(const CAN_frame_t *stCANFrame, qword qwtRx)
+{
+    /* No SD card here, sdlog_bench.py runs the logger on its own */
+    return ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t SD_capture_CAN(const CAN_frame_t *stCANFrame, qword qwtRx)
+{
+    /* No capture ring either, the nodes here never have SD_capture_init called */
+    return ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t SD_capture_trigger(byte byCause, byte bySource)
+{
+    return ESP_ERR_INVALID_STATE;
+}
+
+void SD_capture_check_errors(void)
+{
+}
+
+void adc_report(void)
+{
+    /* No ADCs here, adc_bench.py runs the sampling on its own */
+}
+
+void MCP320X_report(void)
+{
+    /* No MCP320X here, mcp320X_bench.py runs the scan on its own */
+}
+
+void APPS_report(void)
+{
+    /* No pedal here, apps_bench.py runs the plausibility check on its own */
+}
+
+eIMDState_t IMD_update(void)
+{
+    /* No IMD here, imd_bench.py runs the capture on its own, the pin reads as off */
+    return eIMD_OFF;
+}
+
+void IMD_report(void)
+{
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    /* Reflected CRC32, same as zlib.crc32 when chained */
+    crc = ~crc;
+    for (uint32_t dwIndex = 0; dwIndex < len; dwIndex++)
+    {
+        crc ^= buf[dwIndex];
+        for (int NBit = 0; NBit < 8; NBit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+esp_err_t gpio_set_level(gpio_num_t ePin, uint32_t dwLevel)
+{
+    return ESP_OK;
+}
+
+/* --------------------------- Flash ----------------------------- */
+const esp_partition_t *esp_ota_get_next_update_partition(const esp_partition_t *pstStart)
+{
+    return pstFlash != NULL ? &stOTAPartition : NULL;
+}
+
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t *pstPartition)
+{
+    BBootSet = (pstPartition == &stOTAPartition);
+    return BBootSet ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *pstPartition, size_t dwOffset, size_t dwSize)
+{
+    byte abyBlank[SIM_SECTOR_SIZE];
+    if (dwOffset % SIM_SECTOR_SIZE != 0 || dwSize % SIM_SECTOR_SIZE != 0 ||
+        dwOffset + dwSize > pstPartition->size)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(abyBlank, 0xFF, sizeof(abyBlank));
+    fseek(pstFlash, (long)dwOffset, SEEK_SET);
+    for (size_t dwDone = 0; dwDone < dwSize; dwDone += SIM_SECTOR_SIZE)
+    {
+        fwrite(abyBlank, 1, SIM_SECTOR_SIZE, pstFlash);
+        if (dwEraseDelayus)
+        {
+            usleep(dwEraseDelayus);
+        }
+    }
+    fflush(pstFlash);
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t *pstPartition, size_t dwOffset, const void *pvData, size_t dwSize)
+{
+    /* Programming only clears bits, writing over unerased data corrupts it like the real flash */
+    byte *abyOld;
+    if (dwOffset + dwSize > pstPartition->size)
+    {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    abyOld = malloc(dwSize);
+    if (abyOld == NULL)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    fseek(pstFlash, (long)dwOffset, SEEK_SET);
+    if (fread(abyOld, 1, dwSize, pstFlash) != dwSize)
+    {
+        free(abyOld);
+        return ESP_FAIL;
+    }
+    for (size_t dwIndex = 0; dwIndex < dwSize; dwIndex++)
+    {
+        abyOld[dwIndex] &= ((const byte *)pvData)[dwIndex];
+    }
+    fseek(pstFlash, (long)dwOffset, SEEK_SET);
+    fwrite(abyOld, 1, dwSize, pstFlash);
+    fflush(pstFlash);
+    free(abyOld);
+    if (dwWriteDelayus || dwWriteByteDelayns)
+    {
+        usleep(dwWriteDelayus + dwSize * dwWriteByteDelayns / 1000);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *pstPartition, size_t dwOffset, void *pvData, size_t dwSize)
+{
+    if (dwOffset + dwSize > pstPartition->size)
+    {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    fseek(pstFlash, (long)dwOffset, SEEK_SET);
+    return fread(pvData, 1, dwSize, pstFlash) == dwSize ? ESP_OK : ESP_FAIL;
+}
+
+/* --------------------------- NVS ----------------------------- */
+static void nvs_path(nvs_handle_t stHandle, const char *sKey, char *sPath)
+{
+    snprintf(sPath, SIM_MAX_PATH, "%s/%s.%s", sNVSDir, asNVSNamespace[stHandle], sKey);
+}
+
+esp_err_t nvs_flash_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char *sNamespace, nvs_open_mode_t eMode, nvs_handle_t *pstHandle)
+{
+    for (nvs_handle_t stHandle = 1; stHandle < SIM_MAX_NVS_HANDLES; stHandle++)
+    {
+        if (asNVSNamespace[stHandle][0] == '\0')
+        {
+            snprintf(asNVSNamespace[stHandle], sizeof(asNVSNamespace[stHandle]), "%s", sNamespace);
+            *pstHandle = stHandle;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NO_MEM;
+}
+
+void nvs_close(nvs_handle_t stHandle)
+{
+    asNVSNamespace[stHandle][0] = '\0';
+}
+
+esp_err_t nvs_commit(nvs_handle_t stHandle)
+{
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t stHandle, const char *sKey, void *pvData, size_t *pdwSize)
+{
+    char sPath[SIM_MAX_PATH];
+    FILE *pstFile;
+    long NSize;
+    nvs_path(stHandle, sKey, sPath);
+    pstFile = fopen(sPath, "rb");
+    if (pstFile == NULL)
+    {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    fseek(pstFile, 0, SEEK_END);
+    NSize = ftell(pstFile);
+    fseek(pstFile, 0, SEEK_SET);
+    if (pvData != NULL)
+    {
+        if ((size_t)NSize > *pdwSize)
+        {
+            fclose(pstFile);
+            return ESP_ERR_INVALID_SIZE;
+        }
+        if (fread(pvData, 1, NSize, pstFile) != (size_t)NSize)
+        {
+            fclose(pstFile);
+            return ESP_FAIL;
+        }
+    }
+    *pdwSize = (size_t)NSize;
+    fclose(pstFile);
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t stHandle, const char *sKey, const void *pvData, size_t dwSize)
+{
+    /* Written to a temporary file and renamed so a power cut leaves the old or new blob */
+    char sPath[SIM_MAX_PATH];
+    char sTemp[SIM_MAX_PATH + 4];
+    FILE *pstFile;
+    nvs_path(stHandle, sKey, sPath);
+    snprintf(sTemp, sizeof(sTemp), "%s.tmp", sPath);
+    pstFile = fopen(sTemp, "wb");
+    if (pstFile == NULL)
+    {
+        return ESP_FAIL;
+    }
+    fwrite(pvData, 1, dwSize, pstFile);
+    fclose(pstFile);
+    return rename(sTemp, sPath) == 0 ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t stHandle, const char *sKey)
+{
+    char sPath[SIM_MAX_PATH];
+    nvs_path(stHandle, sKey, sPath);
+    return remove(sPath) == 0 ? ESP_OK : ESP_ERR_NVS_NOT_FOUND;
+}
+
+/* --------------------------- FreeRTOS queues ----------------------------- */
+QueueHandle_t xQueueCreate(UBaseType_t uxLength, UBaseType_t uxItemSize)
+{
+    stSimQueue_t *pstQueue = calloc(1, sizeof(stSimQueue_t));
+    if (pstQueue == NULL)
+    {
+        return NULL;
+    }
+    pstQueue->abyItems = malloc((size_t)uxLength * uxItemSize);
+    if (pstQueue->abyItems == NULL)
+    {
+        free(pstQueue);
+        return NULL;
+    }
+    pstQueue->dwItemSize = uxItemSize;
+    pstQueue->dwLength = uxLength;
+    return pstQueue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void *pvItem, TickType_t xTicksToWait)
+{
+    stSimQueue_t *pstQueue = xQueue;
+    if (pstQueue->dwNItems == pstQueue->dwLength)
+    {
+        return pdFALSE;
+    }
+    memcpy(&pstQueue->abyItems[((pstQueue->dwHead + pstQueue->dwNItems) % pstQueue->dwLength) * pstQueue->dwItemSize],
+        pvItem, pstQueue->dwItemSize);
+    pstQueue->dwNItems++;
+    return pdTRUE;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t xQueue, const void *pvItem, BaseType_t *pxWoken)
+{
+    return xQueueSend(xQueue, pvItem, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvItem, TickType_t xTicksToWait)
+{
+    stSimQueue_t *pstQueue = xQueue;
+    if (pstQueue->dwNItems == 0)
+    {
+        return pdFALSE;
+    }
+    memcpy(pvItem, &pstQueue->abyItems[pstQueue->dwHead * pstQueue->dwItemSize], pstQueue->dwItemSize);
+    pstQueue->dwHead = (pstQueue->dwHead + 1) % pstQueue->dwLength;
+    pstQueue->dwNItems--;
+    return pdTRUE;
+}
+
+BaseType_t xQueuePeek(QueueHandle_t xQueue, void *pvItem, TickType_t xTicksToWait)
+{
+    stSimQueue_t *pstQueue = xQueue;
+    if (pstQueue->dwNItems == 0)
+    {
+        return pdFALSE;
+    }
+    memcpy(pvItem, &pstQueue->abyItems[pstQueue->dwHead * pstQueue->dwItemSize], pstQueue->dwItemSize);
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue)
+{
+    return ((stSimQueue_t *)xQueue)->dwNItems;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t xQueue)
+{
+    stSimQueue_t *pstQueue = xQueue;
+    return pstQueue->dwLength - pstQueue->dwNItems;
+}
+
+BaseType_t xQueueReset(QueueHandle_t xQueue)
+{
+    stSimQueue_t *pstQueue = xQueue;
+    pstQueue->dwHead = 0;
+    pstQueue->dwNItems = 0;
+    return pdPASS;
+}
+
+/* --------------------------- TWAI ----------------------------- */
+esp_err_t twai_new_node_onchip(const twai_onchip_node_config_t *pstConfig, twai_node_handle_t *pstNode)
+{
+    *pstNode = (twai_node_handle_t)&stCANCallbacks;
+    return ESP_OK;
+}
+
+esp_err_t twai_node_register_event_callbacks(twai_node_handle_t stNode, const twai_event_callbacks_t *pstCallbacks, void *pvData)
+{
+    stCANCallbacks = *pstCallbacks;
+    return ESP_OK;
+}
+
+esp_err_t twai_node_enable(twai_node_handle_t stNode)
+{
+    return ESP_OK;
+}
+
+esp_err_t twai_node_recover(twai_node_handle_t stNode)
+{
+    return ESP_OK;
+}
+
+esp_err_t twai_node_get_info(twai_node_handle_t stNode, twai_node_status_t *pstStatus, twai_node_record_t *pstRecord)
+{
+    if (pstStatus != NULL)
+    {
+        pstStatus->state = TWAI_ERROR_ACTIVE;
+    }
+    return ESP_OK;
+}
+
+esp_err_t twai_node_receive_from_isr(twai_node_handle_t stNode, twai_frame_t *pstFrame)
+{
+    if (pstCANRxFrame == NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    pstFrame->header.id = pstCANRxFrame->dwID;
+    pstFrame->header.ide = pstCANRxFrame->byExtended;
+    pstFrame->header.dlc = pstCANRxFrame->byDLC;
+    memcpy(pstFrame->buffer, pstCANRxFrame->abData, pstCANRxFrame->byDLC);
+    return ESP_OK;
+}
+
+esp_err_t twai_node_transmit(twai_node_handle_t stNode, const twai_frame_t *pstFrame, int NTimeoutms)
+{
+    stSimCANFrame_t *pstTx;
+    if (dwNCANTx == SIM_CAN_TX_LENGTH)
+    {
+        dwNCANTxDropped++;
+        return ESP_ERR_TIMEOUT;
+    }
+    pstTx = &astCANTx[(dwCANTxHead + dwNCANTx) % SIM_CAN_TX_LENGTH];
+    pstTx->dwID = pstFrame->header.id;
+    pstTx->byExtended = pstFrame->header.ide;
+    pstTx->byDLC = (byte)(pstFrame->header.dlc > 8 ? 8 : pstFrame->header.dlc);
+    memcpy(pstTx->abData, pstFrame->buffer, pstTx->byDLC);
+    dwNCANTx++;
+    return ESP_OK;
+}
+
+/* --------------------------- ESP-NOW ----------------------------- */
+esp_err_t esp_netif_init(void) { return ESP_OK; }
+esp_err_t esp_event_loop_create_default(void) { return ESP_OK; }
+esp_err_t esp_wifi_init(const wifi_init_config_t *pstConfig) { return ESP_OK; }
+esp_err_t esp_wifi_set_mode(int NMode) { return ESP_OK; }
+esp_err_t esp_wifi_set_storage(int NStorage) { return ESP_OK; }
+esp_err_t esp_wifi_set_ps(int NPS) { return ESP_OK; }
+esp_err_t esp_wifi_start(void) { return ESP_OK; }
+esp_err_t esp_wifi_set_channel(uint8_t byChannel, int NSecond) { return ESP_OK; }
+esp_err_t esp_wifi_set_protocol(int NInterface, uint8_t byProtocol) { return ESP_OK; }
+esp_err_t esp_now_set_peer_rate_config(const uint8_t *abyPeerMAC, esp_now_rate_config_t *pstConfig)
+{
+    NESPNOWRate = pstConfig->rate;
+    return ESP_OK;
+}
+esp_err_t esp_now_init(void) { return ESP_OK; }
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t *pstPeer) { return ESP_OK; }
+bool esp_now_is_peer_exist(const uint8_t *abyPeerMAC) { return TRUE; }
+esp_err_t esp_now_register_send_cb(esp_now_send_cb_t pfnCallback)
+{
+    pfnESPNOWTxDone = pfnCallback;
+    return ESP_OK;
+}
+
+esp_err_t esp_read_mac(uint8_t *abyOut, int NType)
+{
+    memcpy(abyOut, abyMAC, sizeof(abyMAC));
+    return ESP_OK;
+}
+
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t pfnCallback)
+{
+    pfnESPNOWRx = pfnCallback;
+    return ESP_OK;
+}
+
+esp_err_t esp_now_send(const uint8_t *abyPeerMAC, const uint8_t *abyData, size_t dwLength)
+{
+    stSimESPNOWPacket_t *pstTx;
+    if (dwNESPNOWTx + dwNESPNOWOnAir >= dwESPNOWTxLength || dwLength > MAX_ESPNOW_PAYLOAD)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    pstTx = &astESPNOWTx[(dwESPNOWTxHead + dwNESPNOWTx) % SIM_ESPNOW_TX_LENGTH];
+    memcpy(pstTx->abyMAC, abyPeerMAC, 6);
+    memcpy(pstTx->abyData, abyData, dwLength);
+    pstTx->wNLength = (word)dwLength;
+    dwNESPNOWTx++;
+    return ESP_OK;
+}
@@ -0,0 +1,784 @@
+/*
+sim_sdcard.c
+Host side of the ESP-IDF calls used by the SD logger, so sdcard.c can run on a PC for
+sdlog_bench.py. The card is a directory of files standing in for the FAT volume, with write(),
+pwrite(), ftruncate() and fsync() wrapped so each one takes as long as it would on an SPI mode card:
+    - A write is a multi-sector command, the data at the mounted SPI clock plus a per sector cost.
+    - A write that starts or ends part way into a sector costs a read and rewrite of that sector.
+    - A write past the end of the file allocates clusters. Each time the chain moves on to the
+      next FAT sector FATFS writes the last one back, away from the data, which costs the card
+      closing and later reopening its open allocation unit, SIM_SD_FAT_US. This is a model of
+      what SD cards do with scattered small writes, not a measurement of any one card.
+    - A sync rewrites the directory sector, and the FAT sector too if clusters were allocated.
+    - Creating a contiguous file or trimming one rewrites every FAT sector its clusters cover.
+Mounting takes SIM_SD_MOUNT_US and NVS is a file per key next to the card's directory.
+The heap has SIM_HEAP_FREE bytes free, or what sim_sd_set_heap gives it, for the capture ring.
+Tasks are threads and task notifications are counting condition variables. The harness's
+producer thread counts as an ISR, like the CAN Rx callback it stands in for.
+
+The old logger, 16 byte entries through a 16 KB stdio buffer from the background loop, is here
+too for comparison. It takes frames off a CAN_QUEUE_LENGTH queue at most 50 a call.
+
+Written for Sheffield Formula Racing 2026
+*/
+#define _GNU_SOURCE
+#include <errno.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <time.h>
+#include "sdcard.h"
+
+/* The stubs keep the IDF signatures, most of their arguments go unused */
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+
+/* --------------------------- Definitions ----------------------------- */
+#define SIM_SD_COMMAND_US       200     // Multi-sector write command, stop token and busy
+#define SIM_SD_SECTOR_US        20      // Data token, CRC and busy per sector
+#define SIM_SD_SYNC_US          3000    // Directory sector read and rewritten
+#define SIM_SD_CLUSTER          16384   // sdcard.c's ALLOCATION_UNIT_SIZE
+#define SIM_SD_FAT_ENTRIES      128     // FAT32 entries in a sector
+#define SIM_SD_FAT_US           20000   // Writing a FAT sector, both copies, between data writes
+#define SIM_SD_MOUNT_US         150000  // Card init at 400 kHz, boot sector and FAT reads
+#define SIM_MAX_PATH            256
+#define SIM_HEAP_FREE           (200 * 1024)    // ESP32-C6 with Wi-Fi and ESP-NOW up
+#define SIM_LEGACY_BUFFER_SIZE  16384   // The old stdio buffer
+#define SIM_LEGACY_QUEUE_LENGTH 115     // CAN_QUEUE_LENGTH
+#define SIM_LEGACY_WRITES_PER_CALL 50
+#define SIM_LEGACY_ENTRY_SIZE   16      // v1 log entry
+
+/* --------------------------- Local Types ----------------------------- */
+typedef struct
+{
+    pthread_t stThread;
+    pthread_mutex_t stLock;
+    pthread_cond_t stWake;
+    dword dwNNotified;
+    void (*pfnTask)(void *);
+    void *pvArg;
+} stSimTask_t;
+
+typedef struct
+{
+    dword dwNProduced;
+    dword dwNRejected;          // Refused by the logger or the old queue
+    qword qwProducerns;         // Time in the producer calls
+    dword dwProducerMaxns;
+    dword dwBGStallMaxus;       // Longest the old background loop sat in a write
+    dword dwNCardWrites;
+    dword dwNUnaligned;         // Writes that started or ended part way into a sector
+    qword qwCardBytes;
+    qword qwCardBusyus;
+    qword qwSyncedBytes;        // File size the card would show after a power cut now
+    qword qwFileBytes;
+    dword dwNFATWrites;         // FAT sectors written back while logging
+    qword qwtKillus;            // When the kill frame was sent, 0 if none was
+} stSimSDResult_t;
+
+/* --------------------------- Local Variables ----------------------------- */
+dword dwTimeSincePowerUpms = 0;
+static __thread stSimTask_t *pstCurrentTask = NULL;
+static __thread int NInIsr = 0;
+static dword dwCardkHz = SDMMC_FREQ_DEFAULT;
+static int NLogFD = -1;
+static stSimSDResult_t stResult;
+static pthread_mutex_t stResultLock = PTHREAD_MUTEX_INITIALIZER;
+static int NVerbose = 0;
+static int NFATDirty = 0;
+static dword dwKillAtms = 0;
+static dword dwHeapFree = SIM_HEAP_FREE;
+static char sSimBasePath[SIM_MAX_PATH];
+
+/* Old logger */
+static CAN_frame_t astLegacyQueue[SIM_LEGACY_QUEUE_LENGTH];
+static volatile dword dwLegacyHead;
+static volatile dword dwLegacyTail;
+static byte abyLegacyBuffer[SIM_LEGACY_BUFFER_SIZE];
+static dword dwLegacyFill;
+static volatile int NLegacyRun;
+static volatile qword qwtLegacyWriteStart;     // 0 unless the background loop is in a write
+
+/* --------------------------- Function prototypes ----------------------------- */
+ssize_t __real_write(int NFD, const void *pvData, size_t dwLength);
+ssize_t __real_pwrite(int NFD, const void *pvData, size_t dwLength, off_t NOffset);
+int __real_ftruncate(int NFD, off_t NLength);
+int __real_fsync(int NFD);
+void sim_sd_set_clock(dword dwkHz);
+void sim_sd_set_verbose(int NOn);
+void sim_sd_set_kill(dword dwAtms);
+void sim_sd_set_heap(dword dwBytes);
+int sim_sd_produce(dword dwFramesPerSecond, dword dwSeconds, int NLegacy, const char *sLegacyPath, stSimSDResult_t *pstResult);
+void sim_sd_result(stSimSDResult_t *pstResult);
+qword sim_sd_now_us(void);
+
+/* --------------------------- Helpers ----------------------------- */
+static qword sim_now_ns(void)
+{
+    struct timespec stNow;
+    clock_gettime(CLOCK_MONOTONIC, &stNow);
+    return (qword)stNow.tv_sec * 1000000000 + stNow.tv_nsec;
+}
+
+static void sim_sleep_until_ns(qword qwtUntil)
+{
+    struct timespec stUntil = { (time_t)(qwtUntil / 1000000000), (long)(qwtUntil % 1000000000) };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &stUntil, NULL) == EINTR)
+    {
+    }
+}
+
+static qword sim_card_write_us(qword qwOffset, size_t dwLength)
+{
+    /* Time an SPI mode card takes for one write() at the mounted clock */
+    qword qwNSectors = (qwOffset % SD_SECTOR_SIZE + dwLength + SD_SECTOR_SIZE - 1) / SD_SECTOR_SIZE;
+    qword qwus = SIM_SD_COMMAND_US + qwNSectors * SIM_SD_SECTOR_US +
+                 qwNSectors * SD_SECTOR_SIZE * 8 * 1000 / dwCardkHz;
+    int NUnaligned = 0;
+
+    if (qwOffset % SD_SECTOR_SIZE != 0)
+    {
+        NUnaligned++;
+    }
+    if ((qwOffset + dwLength) % SD_SECTOR_SIZE != 0)
+    {
+        NUnaligned++;
+    }
+    qwus += NUnaligned * (SIM_SD_COMMAND_US + (qword)SD_SECTOR_SIZE * 8 * 1000 / dwCardkHz);
+    return qwus;
+}
+
+static qword sim_fat_sectors(qword qwBytes)
+{
+    /* FAT sectors the chain of a file this long reaches into */
+    qword qwNClusters = (qwBytes + SIM_SD_CLUSTER - 1) / SIM_SD_CLUSTER;
+    return (qwNClusters + SIM_SD_FAT_ENTRIES - 1) / SIM_SD_FAT_ENTRIES;
+}
+
+static qword sim_fat_rewrite_us(qword qwNSectors)
+{
+    /* Both FAT copies rewritten one sector at a time, then back to the data */
+    return qwNSectors * 2 * sim_card_write_us(0, SD_SECTOR_SIZE) + SIM_SD_FAT_US;
+}
+
+static off_t sim_file_size(int NFD)
+{
+    struct stat stInfo;
+    return fstat(NFD, &stInfo) == 0 ? stInfo.st_size : -1;
+}
+
+static void sim_card_count(qword qwtStart, qword qwOffset, ssize_t NWritten, qword qwSize)
+{
+    /* Sleeps out a write of NWritten at qwOffset to a file qwSize long then counts it */
+    qword qwEnd = qwOffset + (qword)NWritten;
+    qword qwus = sim_card_write_us(qwOffset, (size_t)NWritten);
+    qword qwNOld = (qwSize + SIM_SD_CLUSTER - 1) / SIM_SD_CLUSTER;
+    qword qwNNew = (qwEnd + SIM_SD_CLUSTER - 1) / SIM_SD_CLUSTER;
+    dword dwNFAT = 0;
+
+    if (qwNNew > qwNOld)
+    {
+        /* Each FAT sector the chain moves on from goes back to the card, the last one at the sync */
+        dwNFAT = (dword)((qwNNew - 1) / SIM_SD_FAT_ENTRIES - (qwNOld == 0 ? 0 : (qwNOld - 1) / SIM_SD_FAT_ENTRIES));
+        qwus += dwNFAT * (2 * sim_card_write_us(0, SD_SECTOR_SIZE) + SIM_SD_FAT_US);
+        NFATDirty = 1;
+    }
+    sim_sleep_until_ns(qwtStart + qwus * 1000);
+
+    pthread_mutex_lock(&stResultLock);
+    stResult.dwNCardWrites++;
+    stResult.dwNUnaligned += (qwOffset % SD_SECTOR_SIZE != 0 || qwEnd % SD_SECTOR_SIZE != 0) ? 1 : 0;
+    stResult.qwCardBytes += (qword)NWritten;
+    stResult.qwCardBusyus += qwus;
+    stResult.dwNFATWrites += dwNFAT;
+    if (qwEnd > stResult.qwFileBytes)
+    {
+        stResult.qwFileBytes = qwEnd;
+    }
+    pthread_mutex_unlock(&stResultLock);
+}
+
+/* --------------------------- Card ----------------------------- */
+ssize_t __wrap_write(int NFD, const void *pvData, size_t dwLength)
+{
+    qword qwtStart = sim_now_ns();
+    off_t NOffset = lseek(NFD, 0, SEEK_CUR);
+    off_t NSize = sim_file_size(NFD);
+    ssize_t NWritten = __real_write(NFD, pvData, dwLength);
+
+    if (NWritten > 0 && NOffset >= 0 && NSize >= 0)
+    {
+        /* Counted once the card is done with it */
+        sim_card_count(qwtStart, (qword)NOffset, NWritten, (qword)NSize);
+    }
+    return NWritten;
+}
+
+ssize_t __wrap_pwrite(int NFD, const void *pvData, size_t dwLength, off_t NOffset)
+{
+    qword qwtStart = sim_now_ns();
+    off_t NSize = sim_file_size(NFD);
+    ssize_t NWritten = __real_pwrite(NFD, pvData, dwLength, NOffset);
+
+    if (NWritten > 0 && NSize >= 0)
+    {
+        sim_card_count(qwtStart, (qword)NOffset, NWritten, (qword)NSize);
+    }
+    return NWritten;
+}
+
+int __wrap_ftruncate(int NFD, off_t NLength)
+{
+    qword qwtStart = sim_now_ns();
+    off_t NSize = sim_file_size(NFD);
+    int NStatus = __real_ftruncate(NFD, NLength);
+
+    /* Freeing the clusters past the new end rewrites the FAT sectors they are in */
+    if (NStatus == 0 && NSize > NLength)
+    {
+        sim_sleep_until_ns(qwtStart + sim_fat_rewrite_us(sim_fat_sectors((qword)NSize) -
+                                                         sim_fat_sectors((qword)NLength) + 1) * 1000);
+    }
+    return NStatus;
+}
+
+int __wrap_fsync(int NFD)
+{
+    qword qwtStart = sim_now_ns();
+    off_t NSize = sim_file_size(NFD);
+    qword qwus = SIM_SD_SYNC_US;
+
+    /* The host's own fsync is not the card's, only the time is modelled */
+    if (NFATDirty)
+    {
+        NFATDirty = 0;
+        qwus += 2 * sim_card_write_us(0, SD_SECTOR_SIZE) + SIM_SD_FAT_US;
+        pthread_mutex_lock(&stResultLock);
+        stResult.dwNFATWrites++;
+        pthread_mutex_unlock(&stResultLock);
+    }
+    sim_sleep_until_ns(qwtStart + qwus * 1000);
+    pthread_mutex_lock(&stResultLock);
+    stResult.qwSyncedBytes = NSize < 0 ? 0 : (qword)NSize;
+    pthread_mutex_unlock(&stResultLock);
+    return 0;
+}
+
+esp_err_t esp_vfs_fat_sdspi_mount(const char *sBasePath, const sdmmc_host_t *pstHost, const void *pvSlot,
+                                  const esp_vfs_fat_mount_config_t *pstConfig, sdmmc_card_t **ppstCard)
+{
+    static sdmmc_card_t stCard;
+    qword qwtStart = sim_now_ns();
+    dwCardkHz = pstHost->max_freq_khz > 0 ? (dword)pstHost->max_freq_khz : SDMMC_FREQ_DEFAULT;
+    mkdir(sBasePath, 0777);
+    snprintf(sSimBasePath, sizeof(sSimBasePath), "%s", sBasePath);
+    *ppstCard = &stCard;
+    sim_sleep_until_ns(qwtStart + (qword)SIM_SD_MOUNT_US * 1000);
+    return ESP_OK;
+}
+
+esp_err_t esp_vfs_fat_sdcard_format(const char *sBasePath, sdmmc_card_t *pstCard)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_vfs_fat_create_contiguous_file(const char *sBasePath, const char *sFullPath, uint64_t qwSize,
+                                             bool BAllocNow)
+{
+    /* f_expand, a sparse file on the host, the FAT sectors for every cluster written on the card */
+    qword qwtStart = sim_now_ns();
+    int NFD = open(sFullPath, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+
+    if (NFD < 0)
+    {
+        return ESP_FAIL;
+    }
+    if (__real_ftruncate(NFD, (off_t)qwSize) != 0)
+    {
+        close(NFD);
+        return ESP_ERR_NO_MEM;
+    }
+    close(NFD);
+    sim_sleep_until_ns(qwtStart + sim_fat_rewrite_us(sim_fat_sectors(qwSize)) * 1000);
+    return ESP_OK;
+}
+
+void sdmmc_card_print_info(FILE *pstStream, const sdmmc_card_t *pstCard)
+{
+    if (NVerbose)
+    {
+        fprintf(pstStream, "Sim SD card, SPI at %lu kHz\n", dwCardkHz);
+    }
+}
+
+/* --------------------------- NVS ----------------------------- */
+static char asSimNVSNamespace[4][16];
+
+esp_err_t NVS_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char *sNamespace, nvs_open_mode_t eMode, nvs_handle_t *pstHandle)
+{
+    for (nvs_handle_t stHandle = 1; stHandle < 4; stHandle++)
+    {
+        if (asSimNVSNamespace[stHandle][0] == '\0')
+        {
+            snprintf(asSimNVSNamespace[stHandle], sizeof(asSimNVSNamespace[stHandle]), "%s", sNamespace);
+            *pstHandle = stHandle;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NO_MEM;
+}
+
+void nvs_close(nvs_handle_t stHandle)
+{
+    asSimNVSNamespace[stHandle][0] = '\0';
+}
+
+esp_err_t nvs_commit(nvs_handle_t stHandle)
+{
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_u32(nvs_handle_t stHandle, const char *sKey, uint32_t *pdwValue)
+{
+    char sPath[SIM_MAX_PATH * 2];
+    FILE *pstFile;
+    int NRead;
+    snprintf(sPath, sizeof(sPath), "%s.nvs.%s.%s", sSimBasePath, asSimNVSNamespace[stHandle], sKey);
+    pstFile = fopen(sPath, "rb");
+    if (pstFile == NULL)
+    {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    NRead = (int)fread(pdwValue, sizeof(*pdwValue), 1, pstFile);
+    fclose(pstFile);
+    return NRead == 1 ? ESP_OK : ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_set_u32(nvs_handle_t stHandle, const char *sKey, uint32_t dwValue)
+{
+    char sPath[SIM_MAX_PATH * 2];
+    FILE *pstFile;
+    snprintf(sPath, sizeof(sPath), "%s.nvs.%s.%s", sSimBasePath, asSimNVSNamespace[stHandle], sKey);
+    pstFile = fopen(sPath, "wb");
+    if (pstFile == NULL)
+    {
+        return ESP_FAIL;
+    }
+    fwrite(&dwValue, sizeof(dwValue), 1, pstFile);
+    fclose(pstFile);
+    return ESP_OK;
+}
+
+/* --------------------------- FreeRTOS ----------------------------- */
+static void *sim_task_main(void *pvTask)
+{
+    stSimTask_t *pstTask = (stSimTask_t *)pvTask;
+    pstCurrentTask = pstTask;
+    pstTask->pfnTask(pstTask->pvArg);
+    return NULL;
+}
+
+BaseType_t xTaskCreate(void (*pfnTask)(void *), const char *sName, uint32_t dwStack, void *pvArg,
+                       UBaseType_t uxPriority, TaskHandle_t *pxTask)
+{
+    stSimTask_t *pstTask = calloc(1, sizeof(stSimTask_t));
+    if (pstTask == NULL)
+    {
+        return pdFALSE;
+    }
+    pthread_mutex_init(&pstTask->stLock, NULL);
+    pthread_cond_init(&pstTask->stWake, NULL);
+    pstTask->pfnTask = pfnTask;
+    pstTask->pvArg = pvArg;
+    if (pthread_create(&pstTask->stThread, NULL, sim_task_main, pstTask) != 0)
+    {
+        free(pstTask);
+        return pdFALSE;
+    }
+    pthread_detach(pstTask->stThread);
+    if (pxTask != NULL)
+    {
+        *pxTask = pstTask;
+    }
+    return pdPASS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    /* A thread the sim did not start, the producer or Python, gets a task the first time it asks */
+    if (pstCurrentTask == NULL)
+    {
+        pstCurrentTask = calloc(1, sizeof(stSimTask_t));
+        pthread_mutex_init(&pstCurrentTask->stLock, NULL);
+        pthread_cond_init(&pstCurrentTask->stWake, NULL);
+        pstCurrentTask->stThread = pthread_self();
+    }
+    return pstCurrentTask;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClear, TickType_t xTicks)
+{
+    stSimTask_t *pstTask = (stSimTask_t *)xTaskGetCurrentTaskHandle();
+    uint32_t dwNotified;
+    struct timespec stUntil;
+
+    clock_gettime(CLOCK_REALTIME, &stUntil);
+    stUntil.tv_sec += xTicks / 1000;
+    stUntil.tv_nsec += (long)(xTicks % 1000) * 1000000;
+    if (stUntil.tv_nsec >= 1000000000)
+    {
+        stUntil.tv_sec++;
+        stUntil.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&pstTask->stLock);
+    while (pstTask->dwNNotified == 0 && xTicks != 0)
+    {
+        if (xTicks == portMAX_DELAY)
+        {
+            pthread_cond_wait(&pstTask->stWake, &pstTask->stLock);
+        }
+        else if (pthread_cond_timedwait(&pstTask->stWake, &pstTask->stLock, &stUntil) == ETIMEDOUT)
+        {
+            break;
+        }
+    }
+    dwNotified = pstTask->dwNNotified;
+    pstTask->dwNNotified = xClear ? 0 : (dwNotified > 0 ? dwNotified - 1 : 0);
+    pthread_mutex_unlock(&pstTask->stLock);
+    return dwNotified;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTask)
+{
+    stSimTask_t *pstTask = (stSimTask_t *)xTask;
+    pthread_mutex_lock(&pstTask->stLock);
+    pstTask->dwNNotified++;
+    pthread_cond_signal(&pstTask->stWake);
+    pthread_mutex_unlock(&pstTask->stLock);
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t xTask, BaseType_t *pxWoken)
+{
+    (void)xTaskNotifyGive(xTask);
+    if (pxWoken != NULL)
+    {
+        *pxWoken = pdTRUE;
+    }
+}
+
+BaseType_t xPortInIsrContext(void)
+{
+    return NInIsr;
+}
+
+/* --------------------------- System ----------------------------- */
+int64_t esp_timer_get_time(void)
+{
+    return (int64_t)(sim_now_ns() / 1000);
+}
+
+uint32_t esp_cpu_get_cycle_count(void)
+{
+    /* The PC's time stamp counter, so cycles are the PC's and not the C6's */
+    #if defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__builtin_ia32_rdtsc();
+    #else
+    return (uint32_t)sim_now_ns();
+    #endif
+}
+
+void sim_log(char cLevel, const char *sTag, const char *sFormat, ...)
+{
+    va_list stArgs;
+    if (!NVerbose && cLevel == 'I')
+    {
+        return;
+    }
+    fprintf(stderr, "%c (%s) ", cLevel, sTag);
+    va_start(stArgs, sFormat);
+    vfprintf(stderr, sFormat, stArgs);
+    va_end(stArgs);
+    fputc('\n', stderr);
+}
+
+uint32_t esp_random(void)
+{
+    /* Only needs to differ between files */
+    return (uint32_t)((sim_now_ns() * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+const char *esp_err_to_name(esp_err_t eErr)
+{
+    static char sName[16];
+    snprintf(sName, sizeof(sName), "0x%x", eErr);
+    return sName;
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    /* Reflected CRC32, same as zlib.crc32 when chained */
+    crc = ~crc;
+    for (uint32_t dwIndex = 0; dwIndex < len; dwIndex++)
+    {
+        crc ^= buf[dwIndex];
+        for (int NBit = 0; NBit < 8; NBit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+void *heap_caps_malloc(size_t dwSize, uint32_t dwCaps)
+{
+    (void)dwCaps;
+    if (dwSize > dwHeapFree)
+    {
+        return NULL;
+    }
+    dwHeapFree -= dwSize;
+    return malloc(dwSize);
+}
+
+void heap_caps_free(void *pvData)
+{
+    /* Only freed when init fails, the sim heap does not get it back */
+    free(pvData);
+}
+
+size_t heap_caps_get_free_size(uint32_t dwCaps)
+{
+    (void)dwCaps;
+    return dwHeapFree;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t dwCaps)
+{
+    (void)dwCaps;
+    return dwHeapFree;
+}
+
+/* can.c's, which is not built here */
+void CAN_set_rx_time(CAN_frame_t *stFrame, qword qwtRx)
+{
+    stFrame->abyRxTime[0] = (byte)(qwtRx >> 16);
+    stFrame->abyRxTime[1] = (byte)(qwtRx >> 8);
+    stFrame->abyRxTime[2] = (byte)qwtRx;
+}
+
+qword CAN_get_rx_time(const CAN_frame_t *stFrame, qword qwtNow)
+{
+    dword dwRxTime = ((dword)stFrame->abyRxTime[0] << 16) |
+                     ((dword)stFrame->abyRxTime[1] << 8)  |
+                     ((dword)stFrame->abyRxTime[2]);
+    return qwtNow - ((qwtNow - dwRxTime) & CAN_RX_TIME_MASK);
+}
+
+/* canDecodeAuto.c's timeouts the capture ring watches, never set here */
+bool BStatusAPPSInError = true;
+bool BStatusAPPSSensorInError = true;
+bool BIMDDataInError = true;
+bool BCellVoltagesInError = true;
+bool BCellStats1InError = true;
+bool BCellStats2InError = true;
+bool BCellStats3InError = true;
+bool BCellStats4InError = true;
+bool BSetRelCurrentInError = true;
+bool BERPM_DUTY_VOLTAGEInError = true;
+
+esp_err_t eternal_clock_read_time(uint8_t *abyTime)
+{
+    /* 12:34:56 Saturday 18/10/26 in the MCP7940 register layout */
+    static const byte abyClock[7] = {0x56, 0x34, 0x12, 0x06, 0x18, 0x10, 0x26};
+    memcpy(abyTime, abyClock, sizeof(abyClock));
+    return ESP_OK;
+}
+
+/* --------------------------- Old logger ----------------------------- */
+static void *sim_legacy_bg(void *pvArg)
+{
+    /* sdcard_empty_buffer as it was, called from the background loop */
+    dword dwNWrites;
+    qword qwtStart;
+    dword dwStallus;
+
+    while (NLegacyRun || dwLegacyTail != dwLegacyHead)
+    {
+        dwNWrites = 0;
+        while (dwLegacyTail != dwLegacyHead && dwNWrites < SIM_LEGACY_WRITES_PER_CALL)
+        {
+            const CAN_frame_t *pstFrame = &astLegacyQueue[dwLegacyTail % SIM_LEGACY_QUEUE_LENGTH];
+            byte *abyEntry = &abyLegacyBuffer[dwLegacyFill];
+            abyEntry[0] = 0x01;
+            memcpy(&abyEntry[1], &dwTimeSincePowerUpms, 4);
+            memcpy(&abyEntry[5], &pstFrame->dwID, 2);
+            abyEntry[7] = pstFrame->byDLC;
+            memcpy(&abyEntry[8], pstFrame->abData, 8);
+            __atomic_store_n(&dwLegacyTail, dwLegacyTail + 1, __ATOMIC_RELEASE);
+            dwLegacyFill += SIM_LEGACY_ENTRY_SIZE;
+            dwNWrites++;
+
+            /* stdio flushes once its buffer is full, with the background loop waiting */
+            if (dwLegacyFill == SIM_LEGACY_BUFFER_SIZE)
+            {
+                qwtStart = sim_now_ns();
+                qwtLegacyWriteStart = qwtStart;
+                (void)__wrap_write(NLogFD, abyLegacyBuffer, dwLegacyFill);
+                qwtLegacyWriteStart = 0;
+                dwLegacyFill = 0;
+                dwStallus = (dword)((sim_now_ns() - qwtStart) / 1000);
+                pthread_mutex_lock(&stResultLock);
+                if (dwStallus > stResult.dwBGStallMaxus)
+                {
+                    stResult.dwBGStallMaxus = dwStallus;
+                }
+                pthread_mutex_unlock(&stResultLock);
+            }
+        }
+        if (dwNWrites == 0)
+        {
+            usleep(100);
+        }
+    }
+    return NULL;
+}
+
+static int sim_legacy_put(const CAN_frame_t *pstFrame)
+{
+    /* xQueueSendFromISR onto the CAN queue */
+    if (dwLegacyHead - __atomic_load_n(&dwLegacyTail, __ATOMIC_ACQUIRE) >= SIM_LEGACY_QUEUE_LENGTH)
+    {
+        return 0;
+    }
+    astLegacyQueue[dwLegacyHead % SIM_LEGACY_QUEUE_LENGTH] = *pstFrame;
+    __atomic_store_n(&dwLegacyHead, dwLegacyHead + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+/* --------------------------- Harness ----------------------------- */
+void sim_sd_set_clock(dword dwkHz)
+{
+    /* Only used by the old logger, sdcard.c mounts at its own SDMMC_FREQ */
+    dwCardkHz = dwkHz;
+}
+
+void sim_sd_set_verbose(int NOn)
+{
+    NVerbose = NOn;
+}
+
+void sim_sd_set_kill(dword dwAtms)
+{
+    /* The producer sends one kill frame this long after it starts, 0 for none */
+    dwKillAtms = dwAtms;
+}
+
+void sim_sd_set_heap(dword dwBytes)
+{
+    dwHeapFree = dwBytes;
+}
+
+qword sim_sd_now_us(void)
+{
+    /* esp_timer_get_time, so the harness can note when it powered up */
+    return sim_now_ns() / 1000;
+}
+
+void sim_sd_result(stSimSDResult_t *pstResult)
+{
+    pthread_mutex_lock(&stResultLock);
+    *pstResult = stResult;
+    pthread_mutex_unlock(&stResultLock);
+}
+
+int sim_sd_produce(dword dwFramesPerSecond, dword dwSeconds, int NLegacy, const char *sLegacyPath,
+                   stSimSDResult_t *pstResult)
+{
+    /*  Sends dwFramesPerSecond frames for dwSeconds, 0 for as fast as they are taken, from this
+        thread as if from the CAN Rx ISR. Each frame's data is its sequence number so the harness
+        can check the file. Every frame goes to the capture ring too, which does nothing unless it
+        was armed, and sim_sd_set_kill's kill frame is sent between two of them. Fills pstResult as
+        things stand at the end, as if the power was cut. */
+    CAN_frame_t stFrame = { .byDLC = 8 };
+    CAN_frame_t stKill = { .dwID = KILL_MSG_ID, .byDLC = 3, .abData = {KILL_HV, KILL_SOURCE_IMD, KILL_HV + KILL_SOURCE_IMD} };
+    pthread_t stLegacyThread;
+    qword qwtStart = sim_now_ns();
+    qword qwtEnd = qwtStart + (qword)dwSeconds * 1000000000;
+    qword qwtNow = qwtStart;
+    qword qwtCall;
+    qword qwSequence = 0;
+    qword qwNDue;
+    dword dwCallns;
+    int NAccepted;
+
+    if (NLegacy)
+    {
+        NLogFD = open(sLegacyPath, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+        if (NLogFD < 0)
+        {
+            return -1;
+        }
+        /* The old header went through stdio too */
+        memset(abyLegacyBuffer, 0, SIM_LEGACY_ENTRY_SIZE);
+        abyLegacyBuffer[0] = 0x01;
+        dwLegacyFill = SIM_LEGACY_ENTRY_SIZE;
+        NLegacyRun = 1;
+        pthread_create(&stLegacyThread, NULL, sim_legacy_bg, NULL);
+        pthread_detach(stLegacyThread);
+    }
+
+    stResult.qwtKillus = 0;
+    NInIsr = 1;
+    while (qwtNow < qwtEnd)
+    {
+        if (dwKillAtms != 0 && stResult.qwtKillus == 0 && qwtNow - qwtStart >= (qword)dwKillAtms * 1000000)
+        {
+            stResult.qwtKillus = qwtNow / 1000;
+            (void)SD_card_write_CAN(&stKill, stResult.qwtKillus);
+            (void)SD_capture_CAN(&stKill, stResult.qwtKillus);
+        }
+        dwTimeSincePowerUpms = (dword)((qwtNow - qwtStart) / 1000000);
+        qwNDue = dwFramesPerSecond ? (qwtNow - qwtStart) * dwFramesPerSecond / 1000000000 + 1 : qwSequence + 64;
+        while (qwSequence < qwNDue)
+        {
+            /* A quarter of the bus on 29 bit IDs, which v1 could not hold, none on the kill ID */
+            stFrame.dwID = (qwSequence & 3) == 3 ? 0x18FEF100 | (dword)(qwSequence & 0xFF) : 0x100 + (dword)(qwSequence % 0x6FF);
+            memcpy(stFrame.abData, &qwSequence, 8);
+            qwtCall = sim_now_ns();
+            NAccepted = NLegacy ? sim_legacy_put(&stFrame) : SD_card_write_CAN(&stFrame, qwtNow / 1000) == ESP_OK;
+            (void)SD_capture_CAN(&stFrame, qwtNow / 1000);
+            dwCallns = (dword)(sim_now_ns() - qwtCall);
+            stResult.qwProducerns += dwCallns;
+            if (dwCallns > stResult.dwProducerMaxns)
+            {
+                stResult.dwProducerMaxns = dwCallns;
+            }
+            stResult.dwNProduced++;
+            stResult.dwNRejected += NAccepted ? 0 : 1;
+            qwSequence++;
+        }
+        if (dwFramesPerSecond)
+        {
+            sim_sleep_until_ns(qwtNow + 100000);
+        }
+        qwtNow = sim_now_ns();
+    }
+    NInIsr = 0;
+    NLegacyRun = 0;
+
+    sim_sd_result(pstResult);
+    qwtCall = qwtLegacyWriteStart;
+    if (qwtCall != 0 && (sim_now_ns() - qwtCall) / 1000 > pstResult->dwBGStallMaxus)
+    {
+        /* Still stuck in a write when the power went */
+        pstResult->dwBGStallMaxus = (dword)((sim_now_ns() - qwtCall) / 1000);
+    }
+    return 0;
+}
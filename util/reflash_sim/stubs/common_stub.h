@@ -0,0 +1,82 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_NO_MEM 0x101
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_STATE 0x103
+#define ESP_ERR_INVALID_SIZE 0x104
+#define ESP_ERR_NOT_FOUND 0x105
+#define ESP_ERR_TIMEOUT 0x107
+#define ESP_ERR_INVALID_CRC 0x109
+#define ESP_ERR_INVALID_RESPONSE 0x108
+#define ESP_ERR_NOT_SUPPORTED 0x106
+const char *esp_err_to_name(esp_err_t);
+#define ESP_ERROR_CHECK(x) (void)(x)
+void sim_log(char cLevel, const char *sTag, const char *sFormat, ...);
+#define ESP_LOGI(t, ...) sim_log('I', t, __VA_ARGS__)
+#define ESP_LOGW(t, ...) sim_log('W', t, __VA_ARGS__)
+#define ESP_LOGE(t, ...) sim_log('E', t, __VA_ARGS__)
+#define ESP_LOGD(t, ...) sim_log('D', t, __VA_ARGS__)
+#define IRAM_ATTR
+typedef int BaseType_t; typedef unsigned UBaseType_t; typedef uint32_t TickType_t;
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdMS_TO_TICKS(x) (x)
+#define portMAX_DELAY 0xFFFFFFFF
+typedef void *QueueHandle_t; typedef void *TaskHandle_t; typedef void *SemaphoreHandle_t;
+typedef struct { volatile int x; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {0}
+#define portENTER_CRITICAL(m) do { while (__atomic_exchange_n(&(m)->x, 1, __ATOMIC_ACQUIRE)) {} } while (0)
+#define portEXIT_CRITICAL(m) __atomic_store_n(&(m)->x, 0, __ATOMIC_RELEASE)
+#define portENTER_CRITICAL_ISR(m) portENTER_CRITICAL(m)
+#define portEXIT_CRITICAL_ISR(m) portEXIT_CRITICAL(m)
+#define portENTER_CRITICAL_SAFE(m) portENTER_CRITICAL(m)
+#define portEXIT_CRITICAL_SAFE(m) portEXIT_CRITICAL(m)
+BaseType_t xPortInIsrContext(void);
+#define portYIELD_FROM_ISR(x) (void)(x)
+QueueHandle_t xQueueCreate(UBaseType_t, UBaseType_t);
+BaseType_t xQueueSend(QueueHandle_t, const void *, TickType_t);
+BaseType_t xQueueSendFromISR(QueueHandle_t, const void *, BaseType_t *);
+BaseType_t xQueueReceive(QueueHandle_t, void *, TickType_t);
+BaseType_t xQueuePeek(QueueHandle_t, void *, TickType_t);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t);
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t);
+BaseType_t xQueueReset(QueueHandle_t);
+BaseType_t xTaskCreate(void (*)(void *), const char *, uint32_t, void *, UBaseType_t, TaskHandle_t *);
+void vTaskDelay(TickType_t); void vTaskDelayUntil(TickType_t *, TickType_t); TickType_t xTaskGetTickCount(void);
+BaseType_t xTaskDelayUntil(TickType_t *, TickType_t);
+void vTaskDelete(TaskHandle_t);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+uint32_t ulTaskNotifyTake(BaseType_t, TickType_t);
+BaseType_t xTaskNotifyGive(TaskHandle_t);
+void vTaskNotifyGiveFromISR(TaskHandle_t, BaseType_t *);
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t, UBaseType_t);
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t, BaseType_t *);
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS 1
+int64_t esp_timer_get_time(void);
+typedef void *esp_timer_handle_t;
+typedef struct { void (*callback)(void*); void *arg; const char *name; int dispatch_method; bool skip_unhandled_events; } esp_timer_create_args_t;
+esp_err_t esp_timer_create(const esp_timer_create_args_t*, esp_timer_handle_t*);
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t, uint64_t);
+void esp_restart(void);
+typedef int esp_reset_reason_t;
+
+void *heap_caps_malloc(size_t, uint32_t); void heap_caps_free(void *); size_t heap_caps_get_free_size(uint32_t); size_t heap_caps_get_largest_free_block(uint32_t);
+#define MALLOC_CAP_8BIT 4
+#define MALLOC_CAP_DMA 8
+#define MALLOC_CAP_INTERNAL 16
+esp_err_t esp_task_wdt_reset(void);
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len);
+uint32_t esp_cpu_get_cycle_count(void);
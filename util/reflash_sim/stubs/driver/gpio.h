@@ -0,0 +1,9 @@
+#pragma once
+#include "common_stub.h"
+typedef int gpio_num_t;
+typedef struct { uint64_t pin_bit_mask; int mode, pull_up_en, pull_down_en, intr_type; } gpio_config_t;
+#define GPIO_MODE_OUTPUT 2
+#define GPIO_MODE_INPUT 1
+#define GPIO_INTR_DISABLE 0
+esp_err_t gpio_config(const gpio_config_t*); esp_err_t gpio_set_level(gpio_num_t, uint32_t);
+int gpio_get_level(gpio_num_t);
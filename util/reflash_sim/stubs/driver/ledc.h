@@ -0,0 +1,4 @@
+#pragma once
+#include "common_stub.h"
+#define LEDC_LOW_SPEED_MODE 0
+esp_err_t ledc_set_duty(int,int,uint32_t); esp_err_t ledc_update_duty(int,int);
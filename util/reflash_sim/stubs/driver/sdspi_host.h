@@ -0,0 +1,5 @@
+#pragma once
+#include "sdmmc_cmd.h"
+typedef struct { int gpio_cs; int host_id; } sdspi_device_config_t;
+#define SDSPI_HOST_DEFAULT() {0}
+#define SDSPI_DEVICE_CONFIG_DEFAULT() {0}
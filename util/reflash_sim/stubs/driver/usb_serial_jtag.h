@@ -0,0 +1,7 @@
+#pragma once
+#include "common_stub.h"
+typedef struct { uint32_t tx_buffer_size; uint32_t rx_buffer_size; } usb_serial_jtag_driver_config_t;
+#define USB_SERIAL_JTAG_DRIVER_CONFIG_DEFAULT() {256, 256}
+esp_err_t usb_serial_jtag_driver_install(usb_serial_jtag_driver_config_t*);
+int usb_serial_jtag_read_bytes(void*, uint32_t, TickType_t);
+int usb_serial_jtag_write_bytes(const void*, size_t, TickType_t);
@@ -0,0 +1,4 @@
+#pragma once
+#include "common_stub.h"
+#define WORD_ALIGNED_ATTR __attribute__((aligned(4)))
+#define DMA_ATTR WORD_ALIGNED_ATTR
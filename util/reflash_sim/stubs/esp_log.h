@@ -0,0 +1,3 @@
+#pragma once
+#include "common_stub.h"
+typedef enum { ESP_LOG_NONE = 0, ESP_LOG_ERROR, ESP_LOG_WARN, ESP_LOG_INFO } esp_log_level_t; void esp_log_level_set(const char*, esp_log_level_t);
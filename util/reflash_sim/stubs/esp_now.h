@@ -0,0 +1,16 @@
+#pragma once
+#include "esp_wifi.h"
+#define ESP_NOW_ETH_ALEN 6
+#define ESP_NOW_MAX_DATA_LEN 250
+#define ESP_ERR_ESPNOW_NO_MEM 0x3066
+typedef enum { ESP_NOW_SEND_SUCCESS = 0, ESP_NOW_SEND_FAIL } esp_now_send_status_t;
+typedef struct { uint8_t peer_addr[6]; uint8_t channel; bool encrypt; int ifidx; } esp_now_peer_info_t;
+typedef struct { uint8_t *src_addr; uint8_t *des_addr; wifi_pkt_rx_ctrl_t *rx_ctrl; } esp_now_recv_info_t;
+typedef struct { wifi_phy_mode_t phymode; wifi_phy_rate_t rate; bool ersu; bool dcm; } esp_now_rate_config_t;
+typedef void (*esp_now_send_cb_t)(const wifi_tx_info_t*, esp_now_send_status_t);
+typedef void (*esp_now_recv_cb_t)(const esp_now_recv_info_t*, const uint8_t*, int);
+esp_err_t esp_now_init(void); esp_err_t esp_now_add_peer(const esp_now_peer_info_t*);
+esp_err_t esp_now_send(const uint8_t*, const uint8_t*, size_t);
+esp_err_t esp_now_register_send_cb(esp_now_send_cb_t); esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t);
+esp_err_t esp_now_set_peer_rate_config(const uint8_t*, esp_now_rate_config_t*);
+bool esp_now_is_peer_exist(const uint8_t*);
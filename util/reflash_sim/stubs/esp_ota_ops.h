@@ -0,0 +1,4 @@
+#pragma once
+#include "esp_partition.h"
+const esp_partition_t *esp_ota_get_next_update_partition(const esp_partition_t*);
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t*);
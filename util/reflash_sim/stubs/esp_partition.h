@@ -0,0 +1,6 @@
+#pragma once
+#include "common_stub.h"
+typedef struct { uint32_t address; uint32_t size; uint32_t erase_size; const char *label; } esp_partition_t;
+esp_err_t esp_partition_erase_range(const esp_partition_t*, size_t, size_t);
+esp_err_t esp_partition_write(const esp_partition_t*, size_t, const void*, size_t);
+esp_err_t esp_partition_read(const esp_partition_t*, size_t, void*, size_t);
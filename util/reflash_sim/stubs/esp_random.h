@@ -0,0 +1,3 @@
+#pragma once
+#include "common_stub.h"
+uint32_t esp_random(void);
@@ -0,0 +1,4 @@
+#pragma once
+#include "common_stub.h"
+typedef struct { uint32_t timeout_ms; uint32_t idle_core_mask; bool trigger_panic; } esp_task_wdt_config_t;
+esp_err_t esp_task_wdt_init(const esp_task_wdt_config_t*); esp_err_t esp_task_wdt_deinit(void); esp_err_t esp_task_wdt_add(void*);
@@ -0,0 +1,16 @@
+#pragma once
+#include "common_stub.h"
+typedef void *twai_node_handle_t;
+typedef struct { uint32_t id; uint32_t dlc; bool ide, rtr, fdf, brs; } twai_frame_header_t;
+typedef struct { twai_frame_header_t header; uint8_t *buffer; size_t buffer_len; } twai_frame_t;
+typedef struct { int dummy; } twai_rx_done_event_data_t;
+typedef enum { TWAI_ERROR_ACTIVE, TWAI_ERROR_WARNING, TWAI_ERROR_PASSIVE, TWAI_ERROR_BUS_OFF } twai_error_state_t;
+typedef struct { twai_error_state_t state; } twai_node_status_t;
+typedef struct { int x; } twai_node_record_t;
+typedef struct { bool (*on_rx_done)(twai_node_handle_t, const twai_rx_done_event_data_t*, void*); } twai_event_callbacks_t;
+esp_err_t twai_node_transmit(twai_node_handle_t, const twai_frame_t*, int);
+esp_err_t twai_node_receive_from_isr(twai_node_handle_t, twai_frame_t*);
+esp_err_t twai_node_get_info(twai_node_handle_t, twai_node_status_t*, twai_node_record_t*);
+esp_err_t twai_node_recover(twai_node_handle_t);
+esp_err_t twai_node_register_event_callbacks(twai_node_handle_t, const twai_event_callbacks_t*, void*);
+esp_err_t twai_node_enable(twai_node_handle_t);
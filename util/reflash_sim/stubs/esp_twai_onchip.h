@@ -0,0 +1,4 @@
+#pragma once
+#include "esp_twai.h"
+typedef struct { struct { int tx, rx; } io_cfg; struct { uint32_t bitrate; } bit_timing; int tx_queue_depth; int intr_priority; } twai_onchip_node_config_t;
+esp_err_t twai_new_node_onchip(const twai_onchip_node_config_t*, twai_node_handle_t*);
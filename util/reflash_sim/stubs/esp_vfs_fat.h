@@ -0,0 +1,9 @@
+#pragma once
+#include "common_stub.h"
+#include "sdmmc_cmd.h"
+typedef struct { bool format_if_mount_failed; int max_files; size_t allocation_unit_size; } esp_vfs_fat_sdmmc_mount_config_t;
+typedef esp_vfs_fat_sdmmc_mount_config_t esp_vfs_fat_mount_config_t;
+esp_err_t esp_vfs_fat_sdspi_mount(const char*, const sdmmc_host_t*, const void*, const esp_vfs_fat_mount_config_t*, sdmmc_card_t**);
+esp_err_t esp_vfs_fat_sdcard_format(const char*, sdmmc_card_t*);
+esp_err_t esp_vfs_fat_create_contiguous_file(const char*, const char*, uint64_t, bool);
+esp_err_t esp_vfs_fat_test_contiguous_file(const char*, const char*, bool*);
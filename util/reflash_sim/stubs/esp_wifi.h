@@ -0,0 +1,24 @@
+#pragma once
+#include "common_stub.h"
+typedef struct { int x; } wifi_init_config_t;
+#define WIFI_INIT_CONFIG_DEFAULT() {0}
+typedef struct { int x; } wifi_tx_info_t;
+typedef struct { signed rssi:8; unsigned rate:5; } wifi_pkt_rx_ctrl_t;
+typedef enum { WIFI_PHY_MODE_LR, WIFI_PHY_MODE_11B, WIFI_PHY_MODE_11G, WIFI_PHY_MODE_HT20 } wifi_phy_mode_t;
+typedef enum { WIFI_PHY_RATE_1M_L, WIFI_PHY_RATE_2M_L, WIFI_PHY_RATE_11M_L, WIFI_PHY_RATE_6M, WIFI_PHY_RATE_12M, WIFI_PHY_RATE_24M, WIFI_PHY_RATE_MCS0_LGI, WIFI_PHY_RATE_MCS3_LGI, WIFI_PHY_RATE_MCS5_LGI, WIFI_PHY_RATE_LORA_250K, WIFI_PHY_RATE_LORA_500K } wifi_phy_rate_t;
+#define WIFI_MODE_STA 1
+#define WIFI_STORAGE_RAM 1
+#define WIFI_PS_NONE 0
+#define WIFI_SECOND_CHAN_NONE 0
+#define ESP_IF_WIFI_AP 1
+#define WIFI_IF_STA 0
+#define WIFI_PROTOCOL_11B 1
+#define WIFI_PROTOCOL_11G 2
+#define WIFI_PROTOCOL_11N 4
+#define WIFI_PROTOCOL_LR 8
+esp_err_t esp_netif_init(void); esp_err_t esp_event_loop_create_default(void);
+esp_err_t esp_wifi_init(const wifi_init_config_t*); esp_err_t esp_wifi_set_mode(int); esp_err_t esp_wifi_set_storage(int);
+esp_err_t esp_wifi_set_ps(int); esp_err_t esp_wifi_start(void); esp_err_t esp_wifi_set_channel(uint8_t, int);
+esp_err_t esp_wifi_set_protocol(int, uint8_t);
+esp_err_t esp_read_mac(uint8_t*, int);
+#define ESP_MAC_WIFI_STA 0
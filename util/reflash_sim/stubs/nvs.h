@@ -0,0 +1,15 @@
+#pragma once
+#include "common_stub.h"
+typedef uint32_t nvs_handle_t;
+typedef enum { NVS_READONLY, NVS_READWRITE } nvs_open_mode_t;
+#define ESP_ERR_NVS_NOT_FOUND 0x1102
+#define ESP_ERR_NVS_NO_FREE_PAGES 0x110d
+#define ESP_ERR_NVS_NEW_VERSION_FOUND 0x1110
+esp_err_t nvs_open(const char*, nvs_open_mode_t, nvs_handle_t*);
+esp_err_t nvs_get_blob(nvs_handle_t, const char*, void*, size_t*);
+esp_err_t nvs_set_blob(nvs_handle_t, const char*, const void*, size_t);
+esp_err_t nvs_get_u32(nvs_handle_t, const char*, uint32_t*);
+esp_err_t nvs_set_u32(nvs_handle_t, const char*, uint32_t);
+esp_err_t nvs_erase_key(nvs_handle_t, const char*);
+esp_err_t nvs_commit(nvs_handle_t);
+void nvs_close(nvs_handle_t);
@@ -0,0 +1,7 @@
+#pragma once
+#include "common_stub.h"
+typedef struct { int slot; int max_freq_khz; } sdmmc_host_t;
+typedef struct { int x; } sdmmc_card_t;
+void sdmmc_card_print_info(FILE*, const sdmmc_card_t*);
+#define SDMMC_FREQ_DEFAULT 20000
+#define SDMMC_FREQ_HIGHSPEED 40000
@@ -0,0 +1,384 @@
+import os
+import re
+import sys
+import random
+import ctypes
+import argparse
+import tempfile
+
+###
+# SFR ESP-NOW Telemetry Replay
+# Replays a CAN bus trace into the car's firmware on simulated time, sends what the ESP-NOW
+# telemetry sender gets off the car to a pit node and reports what arrives. Built on the reflash
+# simulator, the same firmware is compiled against the stubs in stubs/ and sim_platform.c.
+#
+# The trace is an SD card binary log (--log) or canDecodeAuto.h at its PERIOD_MS rates (--seconds),
+# either sped up by --scale. canDecodeAuto.h has no data so each message gets 16 bit signals that
+# hold, drift or jump, and some a rolling counter. Frames are queued behind each other on a 1 Mbit/s
+# bus as they would arrive. The radio sends one packet at a time with a rough 802.11 airtime for
+# --phy-mbps, holds --radio-buffers packets and fails --loss of them after its retries.
+#
+# Reports frames/s off the car, telemetry queue overflow, packets, airtime used, the time from a
+# frame's Rx to its packet going on air and to the pits for the priority and bulk lanes, the
+# compression against sending every frame whole and how far each signal at the pits is behind the car. --poll-ms sends one packet every N ms from ESPNOW_empty_buffer
+# instead of running the firmware's tasks, for comparing against a polled sender.
+#
+# The pit's host CPU time in the ESP-NOW Rx callback, which holds the Wi-Fi task on the ESP32, and in
+# the background task relaying to its bus are reported. --relay-bench N pushes the delivered packets
+# through a second pit N at a time with no gaps for what the receive path can relay.
+#
+# --limit tries telemetry rates before they go in the spreadsheet, it rebuilds the firmware with
+# astCANTelemRates changed.
+#
+# Examples:
+#    python telem_replay.py --seconds 10
+#    python telem_replay.py --scale 3 --loss 0.05
+#    python telem_replay.py --limit 0x200-0x20F=100 --limit 0xB0-0xB2=100
+#    python telem_replay.py --log ../../logs/LOG0001.BIN --poll-ms 100
+#    python telem_replay.py --seconds 5 --relay-bench 4
+#
+
+# -----------------------------------------------------------------------------
+# Configuration
+# -----------------------------------------------------------------------------
+SIM_DIR = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.dirname(SIM_DIR))
+import espnow_packing
+from reflash_sim import build_node, FIRMWARE_SOURCES, MAIN_DIR
+
+CAR_ID = 0x11
+PIT_ID = 0x12
+STEP_US = 50                   # Background loop pass
+DRAIN_US = 200000              # Run on after the trace to empty the queues
+FRESHNESS_STEP_US = 10000      # Signal age at the pits sampled this often
+CAN_BITRATE = 1000000
+STANDARD_FRAME_BITS = 47       # Plus 8 a data byte, with typical stuffing and the IFS
+EXTENDED_FRAME_BITS = 67
+WIFI_OVERHEAD_BYTES = 43       # MAC header, ESP-NOW vendor header and FCS
+DSSS_PREAMBLE_US = 192         # 1 to 11 Mbit/s
+OFDM_PREAMBLE_US = 20
+ACK_BITS = 112
+SIFS_DIFS_BACKOFF_US = 370     # SIFS, DIFS and the mean contention backoff
+TELEM_STATS_IDS = (0x7E0, 0x7E1, 0x7E2, 0x7E3, 0x7E4, 0x7E5)
+RX_PATH_ID = 0x7E5
+PRIORITY_PACKET = 0xF3
+DECODE_C_PATH = os.path.join(MAIN_DIR, 'CAN', 'canDecodeAuto.c')
+
+# -----------------------------------------------------------------------------
+# Trace
+# -----------------------------------------------------------------------------
+def signal_payloads(frames, seed):
+    """Gives the empty canDecodeAuto.h frames data, 4 signals each that hold, drift or jump."""
+    rng = random.Random(seed)
+    state = {}
+    out = []
+    for can_id, data, time_us in frames:
+        if can_id not in state:
+            kinds = [rng.choice(('hold', 'hold', 'drift', 'jump')) for _ in range(4)]
+            state[can_id] = (kinds, [rng.randrange(0x10000) for _ in range(4)], rng.random() < 0.25, [0])
+        kinds, values, counter, count = state[can_id]
+        for n, kind in enumerate(kinds):
+            if kind == 'drift':
+                values[n] = (values[n] + rng.choice((-1, 0, 0, 1))) & 0xFFFF
+            elif kind == 'jump':
+                values[n] = (values[n] + rng.randrange(-300, 300)) & 0xFFFF
+        payload = bytearray(b''.join(value.to_bytes(2, 'little') for value in values))
+        if counter:
+            count[0] = (count[0] + 1) & 0xFF
+            payload[7] = count[0]
+        out.append((can_id, bytes(payload[:len(data)]), time_us))
+    return out
+
+def bus_trace(frames, scale):
+    """Speeds the trace up and queues frames that would overlap on the bus."""
+    trace = []
+    bus_free = 0
+    for can_id, data, time_us in sorted(frames, key=lambda frame: frame[2]):
+        bits = (EXTENDED_FRAME_BITS if can_id > 0x7FF else STANDARD_FRAME_BITS) + 8 * len(data)
+        start = max(time_us / scale, bus_free)
+        bus_free = start + bits * 1000000 / CAN_BITRATE
+        trace.append((int(bus_free), can_id, data))
+    return trace
+
+def airtime_us(length, phy_mbps):
+    preamble = DSSS_PREAMBLE_US if phy_mbps <= 11 else OFDM_PREAMBLE_US
+    data = (length + WIFI_OVERHEAD_BYTES) * 8 / phy_mbps
+    ack = preamble + ACK_BITS / min(phy_mbps, 24)
+    return int(preamble + data + ack + SIFS_DIFS_BACKOFF_US)
+
+def percentile(values, percent):
+    if not values:
+        return 0
+    values = sorted(values)
+    return values[min(len(values) - 1, len(values) * percent // 100)]
+
+def parse_limits(limits):
+    """'0x200-0x20F=100' to a list of (first ID, last ID, ms)."""
+    out = []
+    for limit in limits:
+        ids, period = limit.split('=')
+        first, _, last = ids.partition('-')
+        out.append((int(first, 0), int(last or first, 0), int(period)))
+    return out
+
+def firmware_sources(limits, work_dir):
+    """FIRMWARE_SOURCES with canDecodeAuto.c copied and astCANTelemRates changed."""
+    if not limits:
+        return FIRMWARE_SOURCES
+    with open(DECODE_C_PATH) as f:
+        text = f.read()
+
+    def entry(match):
+        can_id = int(match.group(1), 16)
+        for first, last, period in limits:
+            if first <= can_id <= last:
+                return f'{{ 0x{can_id:X}, {period} }}'
+        return match.group(0)
+
+    text = re.sub(r'\{ 0x([0-9A-F]+), \d+ \}', entry, text)
+    path = os.path.join(work_dir, 'canDecodeAuto.c')
+    with open(path, 'w') as f:
+        f.write(text)
+    return [path if source == 'CAN/canDecodeAuto.c' else source for source in FIRMWARE_SOURCES]
+
+# -----------------------------------------------------------------------------
+# Replay
+# -----------------------------------------------------------------------------
+def load_node(device_id, work_dir, sources):
+    lib = ctypes.CDLL(build_node(device_id, work_dir, sources))
+    lib.sim_init.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.c_uint32, ctypes.c_char_p,
+                             ctypes.c_char_p, ctypes.c_int]
+    lib.sim_can_rx.argtypes = [ctypes.c_uint32, ctypes.c_int, ctypes.c_int, ctypes.c_char_p]
+    lib.sim_can_tx_pop.argtypes = [ctypes.POINTER(ctypes.c_uint32), ctypes.POINTER(ctypes.c_int), ctypes.c_char_p]
+    lib.sim_espnow_rx.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int]
+    lib.sim_espnow_tx_start.argtypes = [ctypes.c_char_p, ctypes.c_char_p]
+    lib.sim_espnow_tx_done.argtypes = [ctypes.c_int]
+    lib.sim_espnow_set_tx_length.argtypes = [ctypes.c_uint32]
+    lib.sim_cpu_times.argtypes = [ctypes.POINTER(ctypes.c_uint64), ctypes.POINTER(ctypes.c_ulong),
+                                  ctypes.POINTER(ctypes.c_uint64)]
+    lib.sim_set_time.argtypes = [ctypes.c_uint64]
+    lib.CAN_empty_ESPNOW_buffer.argtypes = [ctypes.c_void_p]
+    nvs_dir = os.path.join(work_dir, f'nvs_{device_id:02X}')
+    os.makedirs(nvs_dir, exist_ok=True)
+    # Time starts at 1 so frames at 0 still get a base time
+    lib.sim_set_time(1)
+    if lib.sim_init(os.path.join(work_dir, f'ota_{device_id:02X}.bin').encode(), nvs_dir.encode(), 65536,
+                    bytes([0x02, 0, 0, 0, 0, device_id]), f'[0x{device_id:02X}]'.encode(), 1) != 0:
+        raise RuntimeError(f"Node 0x{device_id:02X} failed to start")
+    return lib
+
+def replay(trace, phy_mbps, loss, radio_buffers, poll_ms, limits, seed):
+    work_dir = tempfile.mkdtemp(prefix='telem_replay_')
+    sources = firmware_sources(limits, work_dir)
+    car = load_node(CAR_ID, work_dir, sources)
+    pit = load_node(PIT_ID, work_dir, sources)
+    car.sim_espnow_set_tx_length(radio_buffers)
+    dropped = ctypes.c_ulong.in_dll(car, 'dwNDroppedTelemFrames')
+    rng = random.Random(seed)
+
+    frame_id = ctypes.c_uint32()
+    extended = ctypes.c_int()
+    buffer = ctypes.create_string_buffer(256)
+    mac = ctypes.create_string_buffer(6)
+
+    stats = {'packets': 0, 'failed': 0, 'frames': 0, 'frames_lost': 0, 'airtime': 0, 'bytes': 0,
+             'latency': [], 'pit': [], 'bulk_delivery': [], 'priority_delivery': [], 'priority_packets': 0,
+             'delivered_packets': []}
+    on_air = None
+    next_poll = 0
+    index = 0
+    end = (trace[-1][0] if trace else 0) + DRAIN_US
+    now = 1
+    while now < end:
+        car.sim_set_time(now)
+        pit.sim_set_time(now)
+        while index < len(trace) and trace[index][0] <= now:
+            _, can_id, data = trace[index]
+            car.sim_can_rx(can_id, int(can_id > 0x7FF), len(data), data)
+            index += 1
+
+        # Radio, the send callback runs when the airtime is up
+        if on_air is not None and now >= on_air[0]:
+            delivered = rng.random() >= loss
+            car.sim_espnow_tx_done(int(delivered))
+            stats['packets'] += 1
+            frames = [frame for frame in espnow_packing.decode_new(on_air[1]) if frame[0] not in TELEM_STATS_IDS]
+            lane = 'priority' if on_air[1][0] == PRIORITY_PACKET else 'bulk'
+            stats['priority_packets'] += lane == 'priority'
+            if delivered:
+                stats['delivered_packets'].append(on_air[1])
+                stats['frames'] += len(frames)
+                stats[lane + '_delivery'] += [(now - time_us) & 0xFFFFFFFF for _, _, time_us in frames]
+                pit.sim_espnow_rx(bytes([0x02, 0, 0, 0, 0, CAR_ID]), on_air[1], len(on_air[1]))
+            else:
+                stats['failed'] += 1
+                stats['frames_lost'] += len(frames)
+            on_air = None
+
+        if poll_ms:
+            if now >= next_poll:
+                car.ESPNOW_empty_buffer()
+                next_poll = now + poll_ms * 1000
+        else:
+            car.sim_run_bg()
+        while car.sim_can_tx_pop(ctypes.byref(frame_id), ctypes.byref(extended), buffer) >= 0:
+            pass
+
+        # Pits, in order then out on its bus
+        pit.sim_run_bg()
+        while (dlc := pit.sim_can_tx_pop(ctypes.byref(frame_id), ctypes.byref(extended), buffer)) >= 0:
+            stats['pit'].append((now, frame_id.value, buffer.raw[:dlc]))
+
+        if on_air is None:
+            length = car.sim_espnow_tx_start(mac, buffer)
+            if length >= 0:
+                packet = buffer.raw[:length]
+                duration = airtime_us(length, phy_mbps)
+                on_air = (now + duration, packet)
+                stats['airtime'] += duration
+                stats['bytes'] += length
+                for can_id, _, time_us in espnow_packing.decode_new(packet):
+                    if can_id not in TELEM_STATS_IDS:
+                        stats['latency'].append((now - time_us) & 0xFFFFFFFF)
+        now += STEP_US
+
+    stats['dropped'] = dropped.value
+    rx_ns, rx_packets, bg_ns = ctypes.c_uint64(), ctypes.c_ulong(), ctypes.c_uint64()
+    pit.sim_cpu_times(ctypes.byref(rx_ns), ctypes.byref(rx_packets), ctypes.byref(bg_ns))
+    stats['pit_rx_ns'] = rx_ns.value / max(rx_packets.value, 1)
+    stats['pit_bg_ns'] = bg_ns.value
+    stats['duration'] = end - DRAIN_US
+    return stats
+
+def relay_bench(packets, limits, batch):
+    """Pushes the packets through a new pit node as fast as it takes them, batch packets a pass."""
+    work_dir = tempfile.mkdtemp(prefix='telem_relay_')
+    pit = load_node(PIT_ID, work_dir, firmware_sources(limits, work_dir))
+    frame_id = ctypes.c_uint32()
+    extended = ctypes.c_int()
+    buffer = ctypes.create_string_buffer(256)
+    frames = 0
+    now = 1
+    for start in range(0, len(packets), batch):
+        for packet in packets[start:start + batch]:
+            pit.sim_espnow_rx(bytes([0x02, 0, 0, 0, 0, CAR_ID]), packet, len(packet))
+        # The background loop spins until the bus has everything
+        while True:
+            now += STEP_US
+            pit.sim_set_time(now)
+            pit.sim_run_bg()
+            count = 0
+            while pit.sim_can_tx_pop(ctypes.byref(frame_id), ctypes.byref(extended), buffer) >= 0:
+                count += frame_id.value not in TELEM_STATS_IDS
+            frames += count
+            if count == 0:
+                break
+    rx_ns, rx_packets, bg_ns = ctypes.c_uint64(), ctypes.c_ulong(), ctypes.c_uint64()
+    pit.sim_cpu_times(ctypes.byref(rx_ns), ctypes.byref(rx_packets), ctypes.byref(bg_ns))
+    return frames, rx_ns.value, bg_ns.value
+
+def freshness(trace, pit_frames, duration):
+    """How far behind the car each signal is at the pits every FRESHNESS_STEP_US, the time since the
+    car's bus first carried newer data than the pits show. 0 when the pits are up to date.
+    Returns (ages in us, samples with nothing or data the car never sent at the pits)."""
+    car_by_id = {}
+    for time_us, can_id, data in trace:
+        car_by_id.setdefault(can_id, []).append((time_us, data))
+    pit_by_id = {}
+    for time_us, can_id, data in pit_frames:
+        if can_id in car_by_id:
+            pit_by_id.setdefault(can_id, []).append((time_us, data))
+
+    ages = []
+    missing = 0
+    for can_id, car_frames in car_by_id.items():
+        pit_updates = pit_by_id.get(can_id, [])
+        last_seen = {}
+        car_index = 0
+        pit_index = 0
+        shown = None
+        for sample in range(car_frames[0][0] + FRESHNESS_STEP_US, duration, FRESHNESS_STEP_US):
+            while car_index < len(car_frames) and car_frames[car_index][0] <= sample:
+                last_seen[car_frames[car_index][1]] = car_index
+                car_index += 1
+            while pit_index < len(pit_updates) and pit_updates[pit_index][0] <= sample:
+                shown = pit_updates[pit_index][1]
+                pit_index += 1
+            if shown is None or shown not in last_seen:
+                missing += 1
+            elif last_seen[shown] == car_index - 1:
+                ages.append(0)
+            else:
+                ages.append(sample - car_frames[last_seen[shown] + 1][0])
+    return ages, missing
+
+# -----------------------------------------------------------------------------
+# Main Execution
+# -----------------------------------------------------------------------------
+def main():
+    parser = argparse.ArgumentParser(description="Replay a CAN trace through the ESP-NOW telemetry sender")
+    parser.add_argument('--log', help="SD card binary log to replay")
+    parser.add_argument('--seconds', type=float, default=10.0, help="Length of the canDecodeAuto.h trace")
+    parser.add_argument('--scale', type=float, default=1.0, help="Speed the trace up by this much")
+    parser.add_argument('--phy-mbps', type=float, default=1.0, help="ESP-NOW PHY rate, 1 Mbit/s by default")
+    parser.add_argument('--loss', type=float, default=0.0, help="Fraction of packets that fail after retries")
+    parser.add_argument('--radio-buffers', type=int, default=8, help="Packets the radio holds")
+    parser.add_argument('--poll-ms', type=int, default=0, help="Send one packet every N ms instead of the sender task")
+    parser.add_argument('--limit', action='append', default=[], help="Telemetry period, eg 0x200-0x20F=100 (ms)")
+    parser.add_argument('--relay-bench', type=int, default=0, metavar='N',
+                        help="Also push the delivered packets through the pits N at a time as fast as they go")
+    parser.add_argument('--seed', type=int, default=1)
+    args = parser.parse_args()
+
+    if args.log:
+        frames = espnow_packing.mix_from_log(args.log)
+        source = args.log
+    else:
+        frames = signal_payloads(espnow_packing.mix_from_header(espnow_packing.DECODE_H_PATH, args.seconds), args.seed)
+        source = f"{args.seconds:g}s of canDecodeAuto.h"
+    trace = bus_trace(frames, args.scale)
+    stats = replay(trace, args.phy_mbps, args.loss, args.radio_buffers, args.poll_ms, parse_limits(args.limit), args.seed)
+
+    # Every frame sent whole in the same packets, the format before compression
+    whole, _ = espnow_packing.pack([(can_id, data, time_us) for time_us, can_id, data in trace],
+                                   espnow_packing.encode_new, espnow_packing.header_new)
+    whole_bytes = sum(len(packet) for packet in whole)
+    ages, missing = freshness(trace, stats['pit'], stats['duration'])
+
+    seconds = max(stats['duration'], 1) / 1e6
+    sender = f"polled every {args.poll_ms} ms" if args.poll_ms else "sender task"
+    print(f"Trace: {len(trace)} frames, {source} x{args.scale:g}, {len(trace) / seconds:.0f} frames/s")
+    print(f"Sender: {sender}, {args.phy_mbps:g} Mbit/s, {args.loss * 100:g}% loss, limits {args.limit or 'none'}")
+    print(f"Frames/s off the car:  {stats['frames'] / seconds:8.0f}")
+    print(f"Telem queue overflow:  {100 * stats['dropped'] / max(len(trace), 1):8.2f}%  ({stats['dropped']} frames)")
+    print(f"Lost on air:           {100 * stats['frames_lost'] / max(len(trace), 1):8.2f}%  "
+          f"({stats['failed']} of {stats['packets']} packets)")
+    print(f"Frames/packet:         {(stats['frames'] + stats['frames_lost']) / max(stats['packets'], 1):8.2f}")
+    print(f"Airtime used:          {100 * stats['airtime'] / max(stats['duration'], 1):8.1f}%")
+    print(f"Compression:           {whole_bytes / max(stats['bytes'], 1):8.2f}x  "
+          f"({stats['bytes']} bytes sent, {whole_bytes} whole)")
+    latency = stats['latency']
+    print(f"Rx to air ms:          p50 {percentile(latency, 50) / 1000:.1f}  p99 {percentile(latency, 99) / 1000:.1f}  "
+          f"max {max(latency, default=0) / 1000:.1f}")
+    for lane in ('priority', 'bulk'):
+        delivery = stats[lane + '_delivery']
+        print(f"{lane.capitalize() + ' Rx to pits ms:':<23}p50 {percentile(delivery, 50) / 1000:.1f}  "
+              f"p99 {percentile(delivery, 99) / 1000:.1f}  max {max(delivery, default=0) / 1000:.1f}  ({len(delivery)} frames)")
+    relayed = [frame for frame in stats['pit'] if frame[1] not in TELEM_STATS_IDS]
+    rx_path = [frame[2] for frame in stats['pit'] if frame[1] == RX_PATH_ID]
+    peak = max((int.from_bytes(data[4:6], 'big') for data in rx_path), default=0)
+    dropped = sum(int.from_bytes(data[6:8], 'big') for data in rx_path)
+    print(f"Pit Wi-Fi task:        {stats['pit_rx_ns']:8.0f} ns/packet host CPU in the Rx callback")
+    print(f"Pit relay to CAN:      {len(relayed) / seconds:8.0f} frames/s, peak {peak}/s, {dropped} dropped, "
+          f"{stats['pit_bg_ns'] / max(len(relayed), 1):.0f} ns/frame host CPU in the BG task")
+    if args.relay_bench:
+        frames, rx_ns, bg_ns = relay_bench(stats['delivered_packets'], parse_limits(args.limit), args.relay_bench)
+        packets = len(stats['delivered_packets'])
+        print(f"Pit relay capacity:    {frames * 1e9 / max(rx_ns + bg_ns, 1):8.0f} frames/s host CPU, "
+              f"{rx_ns / max(packets, 1):.0f} ns/packet Rx callback, {bg_ns / max(frames, 1):.0f} ns/frame BG task "
+              f"({frames} frames, {args.relay_bench} packets a pass)")
+    print(f"Pits behind car ms:    p50 {percentile(ages, 50) / 1000:.1f}  p99 {percentile(ages, 99) / 1000:.1f}  "
+          f"max {max(ages, default=0) / 1000:.1f}  ({100 * missing / max(len(ages) + missing, 1):.1f}% of samples missing)")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,651 @@
+import os
+import sys
+import time
+import zlib
+import struct
+import argparse
+
+###
+# SFR SD Card Log Reader
+# Reads the binary logs main/sdcard.c writes, converts between the two versions printing the bytes
+# per frame of each, and pulls a time window or set of IDs out of a v2 log through its index.
+#
+# v1:   16 byte entries, the first the file header [0x01, 15 reserved], then
+#       [Type], [Time ms, 4 LE], [ID, 2 LE], [DLC], [Data, 8]  (Type 0 pads to a sector, 1 is CAN)
+# v2:   Sector aligned blocks, see SD_LOG_FILE_VERSION in main/sdcard.h
+#       [Magic "SFRB"], [Type], [0], [Length, 2 LE], [Frames, 2 LE], [0, 2], [Sequence, 4 LE],
+#       [Base us, 8 LE], [CRC32, 4 LE], Length bytes of records, zeros to the sector
+#   file:   [Version], [0], [Sector, 2 LE], [Block, 2 LE], [Device, 2 LE], [Open us, 8 LE],
+#           [Clock BCD, 7], [0], [File ID, 4 LE], [0, 4], [Valid bytes, 8 LE], [Allocated, 8 LE]
+#           in the first sector, CRC from 0. Every other block's CRC starts from the file ID
+#   std:    [0 | DLC | ID10..ID8], [ID7..ID0], Delta..., Data...
+#   ext:    [1 | DLC | 000], [ID28..ID24], [ID23..ID16], [ID15..ID8], [ID7..ID0], Delta..., Data...
+#           Delta is the us since the previous frame in the block, the first frame's is 0
+#   index:  [Previous index sector, 4 LE], [Entries, 2 LE], [0, 2], then per frame block
+#           [Sector, 4 LE], [Span us, 4 LE], [Base us, 8 LE], [ID bloom filter, 32]
+#   footer: [Last index sector, 4 LE], [Frame blocks, 4 LE], [Frames, 4 LE], [Dropped, 4 LE],
+#           [First us, 8 LE], [Last us, 8 LE], in the file's last sector
+#   trigger: [Cause], [Source], [0, 2], [Pre us, 4 LE], [Post us, 4 LE], [0, 4], [Trigger us, 8 LE],
+#           second in a capNNNNN.bin the capture ring wrote, cause 1 kill, 2 timeout, 3 command
+#   frames lz: [Raw length, 2 LE], then a frames block's records as an LZ4 block, see
+#           main/sdcompress.h, written with SD_LOG_COMPRESS and read as if it were the frames block
+#
+# A file pre-allocated on the card holds zeros or an older file's blocks past what has been
+# written. Up to its valid bytes any good block is read, past them only blocks that carry straight
+# on from the one before, so the blocks written after the last sync are kept too.
+#
+# The index is read back from the footer, or from logNNN.idx next to the log, which is rebuilt
+# from the block headers and any index blocks found if the log was not closed. Only the frame
+# blocks the index says can hold the query are read.
+#
+# Frames are (id, data, time us) tuples as in espnow_packing.py.
+#
+# Examples:
+#    python sdlog.py info log003.bin --dump 20
+#    python sdlog.py info cap00002.bin
+#    python sdlog.py convert log003.bin log003_v1.bin
+#    python sdlog.py index log003.bin
+#    python sdlog.py query log003.bin --start 612.5 --end 614.5 --id 0x120 0x18FEF100 --out event.csv
+#
+
+# -----------------------------------------------------------------------------
+# Configuration
+# -----------------------------------------------------------------------------
+V1_ENTRY = struct.Struct('<BIHB8s')
+V1_TYPE_PADDING = 0x00
+V1_TYPE_CAN = 0x01
+
+V2_VERSION = 2
+V2_MAGIC = 0x42524653
+V2_BLOCK = struct.Struct('<IBBHHHIQI')
+V2_FILE = struct.Struct('<BBHHHQ7sBIIQQ')
+V2_FILE_OLD = struct.Struct('<BBHHHQ7sB')  # Before the file ID and valid bytes
+V2_INDEX = struct.Struct('<IHH')
+V2_INDEX_ENTRY = struct.Struct('<IIQ32s')
+V2_FOOTER = struct.Struct('<IIIIQQ')
+V2_TRIGGER = struct.Struct('<BBHIIIQ')
+V2_BLOCK_FILE = 1
+V2_BLOCK_FRAMES = 2
+V2_BLOCK_INDEX = 3
+V2_BLOCK_FOOTER = 4
+V2_BLOCK_TRIGGER = 5
+V2_BLOCK_FRAMES_LZ = 6
+V2_FRAME_BLOCKS = (V2_BLOCK_FRAMES, V2_BLOCK_FRAMES_LZ)
+V2_RAW_LENGTH = struct.Struct('<H')
+V2_CRC_OFFSET = V2_BLOCK.size - 4
+
+SECTOR_SIZE = 512
+BLOCK_SIZE = 16384
+DEVICE_ID = 0x11
+MAX_STD_ID = 0x7FF
+EXTENDED = 0x80
+DLC_SHIFT = 3
+MAX_RECORD = 5 + 5 + 8      # SD_LOG_MAX_RECORD_SIZE
+INDEX_ENTRIES = 32          # SD_LOG_INDEX_ENTRIES
+BLOOM_HASH = 0x9E3779B1     # SD_LOG_BLOOM_HASH
+NO_SECTOR = 0xFFFFFFFF
+NO_FILE_BLOCK = {'block': BLOCK_SIZE, 'file_id': 0, 'valid': None}
+TRIGGER_CAUSES = {1: 'kill', 2: 'timeout', 3: 'command'}   # eSDCaptureCause_t
+
+IDX_HEADER = struct.Struct('<4sIQI')    # logNNN.idx: "SFRI", version, log size, entries
+IDX_MAGIC = b'SFRI'
+IDX_VERSION = 1
+
+# -----------------------------------------------------------------------------
+# v1
+# -----------------------------------------------------------------------------
+def read_v1(raw):
+    frames = []
+    for offset in range(V1_ENTRY.size, len(raw) - V1_ENTRY.size + 1, V1_ENTRY.size):
+        entry_type, time_ms, can_id, dlc, data = V1_ENTRY.unpack_from(raw, offset)
+        if entry_type == V1_TYPE_CAN and dlc <= 8:
+            frames.append((can_id, data[:dlc], time_ms * 1000))
+    return frames, {'version': 1}
+
+def write_v1(frames):
+    """Returns the file and the number of IDs that did not fit in 16 bits."""
+    out = bytearray(V1_ENTRY.size)
+    out[0] = 0x01
+    truncated = 0
+    for can_id, data, time_us in frames:
+        truncated += 1 if can_id > 0xFFFF else 0
+        out += V1_ENTRY.pack(V1_TYPE_CAN, (time_us // 1000) & 0xFFFFFFFF, can_id & 0xFFFF, len(data),
+                             bytes(data).ljust(8, b'\0'))
+    return bytes(out), truncated
+
+# -----------------------------------------------------------------------------
+# v2 records
+# -----------------------------------------------------------------------------
+def varint(value):
+    out = bytearray()
+    while True:
+        out.append((value & 0x7F) | (0x80 if value >= 0x80 else 0))
+        value >>= 7
+        if not value:
+            return bytes(out)
+
+def encode_record(can_id, data, delta):
+    dlc = len(data) << DLC_SHIFT
+    if can_id > MAX_STD_ID:
+        header = bytes([EXTENDED | dlc]) + struct.pack('>I', can_id & 0x1FFFFFFF)
+    else:
+        header = bytes([dlc | ((can_id >> 8) & 0x07), can_id & 0xFF])
+    return header + varint(delta) + bytes(data)
+
+def decode_records(records, base_us):
+    """Mirror of SD_log_put_frame, returns the frames and whether the records ran out early."""
+    frames = []
+    offset = 0
+    time_us = base_us
+    while offset < len(records):
+        extended = records[offset] & EXTENDED
+        header = 5 if extended else 2
+        dlc = (records[offset] >> DLC_SHIFT) & 0x0F
+        if len(records) - offset < header or dlc > 8:
+            return frames, True
+        if extended:
+            can_id = struct.unpack('>I', records[offset + 1:offset + 5])[0] & 0x1FFFFFFF
+        else:
+            can_id = ((records[offset] & 0x07) << 8) | records[offset + 1]
+        offset += header
+        delta, shift = 0, 0
+        while True:
+            if offset >= len(records):
+                return frames, True
+            delta |= (records[offset] & 0x7F) << shift
+            shift += 7
+            offset += 1
+            if not records[offset - 1] & 0x80:
+                break
+        if len(records) - offset < dlc:
+            return frames, True
+        time_us += delta
+        frames.append((can_id, records[offset:offset + dlc], time_us))
+        offset += dlc
+    return frames, False
+
+def lz_decompress(data):
+    """Records of a frames lz block, None if they do not decode to the raw length it gives. Mirror
+    of SD_compress_block: [Token], literal length bytes, literals, [Offset, 2 LE], match length bytes."""
+    if len(data) < V2_RAW_LENGTH.size:
+        return None
+    raw_length = V2_RAW_LENGTH.unpack_from(data)[0]
+    out = bytearray()
+    pos = V2_RAW_LENGTH.size
+    try:
+        while pos < len(data):
+            token = data[pos]
+            pos += 1
+            length = token >> 4
+            if length == 15:
+                while data[pos] == 255:
+                    length += 255
+                    pos += 1
+                length += data[pos]
+                pos += 1
+            out += data[pos:pos + length]
+            pos += length
+            if pos >= len(data):
+                break
+            offset = data[pos] | data[pos + 1] << 8
+            pos += 2
+            length = (token & 0x0F) + 4
+            if length == 19:
+                while data[pos] == 255:
+                    length += 255
+                    pos += 1
+                length += data[pos]
+                pos += 1
+            if offset == 0 or offset > len(out):
+                return None
+            # A match may overlap what it writes, a run of the last offset bytes
+            match = out[len(out) - offset:len(out) - offset + length]
+            out += (match * (length // len(match) + 1))[:length]
+    except IndexError:
+        return None
+    return bytes(out) if len(out) == raw_length else None
+
+def frame_records(block_type, records):
+    """Records of a frames or frames lz block, None if they do not decompress."""
+    return lz_decompress(records) if block_type == V2_BLOCK_FRAMES_LZ else records
+
+def bloom_bits(can_id):
+    """The two (byte, mask) pairs SD_card_write_CAN sets for an ID."""
+    hashed = (can_id * BLOOM_HASH) & 0xFFFFFFFF
+    return ((hashed >> 27, 1 << ((hashed >> 24) & 7)), ((hashed >> 19) & 0x1F, 1 << ((hashed >> 16) & 7)))
+
+def bloom_of(can_ids):
+    bloom = bytearray(32)
+    for can_id in can_ids:
+        for byte, mask in bloom_bits(can_id):
+            bloom[byte] |= mask
+    return bytes(bloom)
+
+def bloom_may_hold(bloom, can_id):
+    return all(bloom[byte] & mask for byte, mask in bloom_bits(can_id))
+
+# -----------------------------------------------------------------------------
+# v2 blocks
+# -----------------------------------------------------------------------------
+def block_crc(raw, offset, length, seed=0):
+    crc = zlib.crc32(raw[offset:offset + V2_CRC_OFFSET], seed)
+    start = offset + V2_BLOCK.size
+    return zlib.crc32(raw[start:start + length], crc)
+
+def parse_file(records):
+    """The file block's fields, an old one has file ID 0 and no valid bytes."""
+    if len(records) >= V2_FILE.size:
+        version, _, sector, block, device, open_us, clock, _, file_id, _, valid, allocated = V2_FILE.unpack_from(records)
+    else:
+        version, _, sector, block, device, open_us, clock, _ = V2_FILE_OLD.unpack_from(records)
+        file_id, valid, allocated = 0, None, 0
+    return {'version': version, 'sector': sector, 'block': block, 'device': device, 'open_us': open_us,
+            'clock': clock.hex(), 'file_id': file_id, 'valid': valid, 'allocated': allocated}
+
+def read_block(f, sector, block_size=BLOCK_SIZE, seed=0):
+    """The header and records of the block at a sector, or None if there is no good one there. A
+    frames lz block's records are decompressed."""
+    f.seek(sector * SECTOR_SIZE)
+    header = f.read(V2_BLOCK.size)
+    if len(header) < V2_BLOCK.size:
+        return None
+    fields = V2_BLOCK.unpack(header)
+    length = fields[3]
+    if fields[0] != V2_MAGIC or length > block_size:
+        return None
+    records = f.read(length)
+    if len(records) < length or zlib.crc32(records, zlib.crc32(header[:V2_CRC_OFFSET], seed)) != fields[8]:
+        return None
+    records = frame_records(fields[1], records)
+    return (fields, records) if records is not None else None
+
+def read_file_block(f):
+    """parse_file of a v2 log's first block, None if it has none."""
+    block = read_block(f, 0)
+    if block is None or block[0][1] != V2_BLOCK_FILE or len(block[1]) < V2_FILE_OLD.size:
+        return None
+    return parse_file(block[1])
+
+def read_v2(raw):
+    """Frames from every good block, a bad one is skipped by looking for the magic a sector on.
+    Past the valid bytes the first block that is bad or out of sequence ends the log."""
+    frames = []
+    info = {'version': V2_VERSION, 'blocks': 0, 'corrupt': 0, 'missing': 0, 'sector': SECTOR_SIZE,
+            'block': BLOCK_SIZE, 'index_blocks': 0, 'footer': False, 'file_id': 0, 'valid': None,
+            'unsynced': 0, 'lz_blocks': 0, 'lz_bytes': 0, 'lz_raw_bytes': 0}
+    sector = SECTOR_SIZE
+    expected = 0
+    offset = 0
+    while offset + V2_BLOCK.size <= len(raw):
+        trusted = info['valid'] is None or offset < info['valid']
+        magic, block_type, _, length, n_frames, _, sequence, base_us, crc = V2_BLOCK.unpack_from(raw, offset)
+        if magic != V2_MAGIC:
+            if not trusted:
+                break
+            offset += sector
+            continue
+        if (offset + V2_BLOCK.size + length > len(raw) or length > info['block']
+                or block_crc(raw, offset, length, info['file_id'] if offset else 0) != crc):
+            if not trusted:
+                break
+            info['corrupt'] += 1
+            offset += sector
+            continue
+        if not trusted and sequence != expected:
+            break
+        records = raw[offset + V2_BLOCK.size:offset + V2_BLOCK.size + length]
+        if block_type == V2_BLOCK_FILE and offset == 0 and length >= V2_FILE_OLD.size:
+            info.update(parse_file(records))
+            sector = info['sector']
+        elif block_type in V2_FRAME_BLOCKS:
+            unpacked = frame_records(block_type, records)
+            decoded, short = decode_records(unpacked, base_us) if unpacked is not None else ([], True)
+            if short or len(decoded) != n_frames:
+                info['corrupt'] += 1
+            if block_type == V2_BLOCK_FRAMES_LZ:
+                info['lz_blocks'] += 1
+                info['lz_bytes'] += len(records)
+                info['lz_raw_bytes'] += len(unpacked or b'')
+            frames += decoded
+        elif block_type == V2_BLOCK_INDEX:
+            info['index_blocks'] += 1
+        elif block_type == V2_BLOCK_FOOTER:
+            info['footer'] = True
+        elif block_type == V2_BLOCK_TRIGGER and length >= V2_TRIGGER.size:
+            cause, source, _, pre_us, post_us, _, trigger_us = V2_TRIGGER.unpack_from(records)
+            info['trigger'] = {'cause': cause, 'source': source, 'pre_us': pre_us, 'post_us': post_us,
+                               'trigger_us': trigger_us}
+        info['missing'] += max(sequence - expected, 0)
+        info['unsynced'] += 0 if trusted else 1
+        expected = sequence + 1
+        info['blocks'] += 1
+        offset += -(-(V2_BLOCK.size + length) // sector) * sector
+    return frames, info
+
+def write_v2(frames, block_size=BLOCK_SIZE, sector_size=SECTOR_SIZE, clock=bytes(7), file_id=0, pack=None):
+    """What SD_card_init, SD_card_write_CAN and SD_card_close would have written for these frames.
+    pack stands in for SD_log_pack, it takes a frames block's records and gives back the block type
+    and records to write."""
+    out = bytearray()
+    sequence = 0
+    index = []
+    previous_index = NO_SECTOR
+
+    def seal(block_type, records, n_frames, base_us):
+        nonlocal sequence
+        sector = len(out) // sector_size
+        header = V2_BLOCK.pack(V2_MAGIC, block_type, 0, len(records), n_frames, 0, sequence, base_us, 0)
+        seed = 0 if block_type == V2_BLOCK_FILE else file_id
+        crc = zlib.crc32(bytes(records), zlib.crc32(header[:V2_CRC_OFFSET], seed))
+        block = header[:V2_CRC_OFFSET] + struct.pack('<I', crc) + bytes(records)
+        out.extend(block + bytes(-len(block) % sector_size))
+        sequence += 1
+        return sector
+
+    def seal_index():
+        nonlocal index, previous_index
+        records = V2_INDEX.pack(previous_index, len(index), 0) + b''.join(V2_INDEX_ENTRY.pack(*e) for e in index)
+        previous_index = seal(V2_BLOCK_INDEX, records, 0, index[0][2])
+        index = []
+
+    def seal_frames():
+        block_type, packed = pack(bytes(records)) if pack else (V2_BLOCK_FRAMES, records)
+        sector = seal(block_type, packed, n_frames, base_us)
+        index.append((sector, min(last_us - base_us, 0xFFFFFFFF), base_us, bloom_of(ids)))
+        if len(index) == INDEX_ENTRIES:
+            seal_index()
+
+    def file_block(valid):
+        return V2_FILE.pack(V2_VERSION, 0, sector_size, block_size, DEVICE_ID, 0, clock, 0, file_id, 0, valid, 0)
+
+    seal(V2_BLOCK_FILE, file_block(0), 0, 0)
+    records, ids = bytearray(), set()
+    n_frames = n_blocks = 0
+    base_us = last_us = first_us = 0
+    for can_id, data, time_us in frames:
+        delta = max(time_us - last_us, 0)
+        if n_frames and delta > 0xFFFFFFFF:
+            seal_frames()
+            records, ids, n_frames, n_blocks = bytearray(), set(), 0, n_blocks + 1
+        if not n_frames:
+            base_us, delta = time_us, 0
+            first_us = time_us if n_blocks == 0 else first_us
+        records += encode_record(can_id, data, delta)
+        ids.add(can_id)
+        n_frames += 1
+        last_us = time_us
+        if V2_BLOCK.size + len(records) + MAX_RECORD > block_size:
+            seal_frames()
+            records, ids, n_frames, n_blocks = bytearray(), set(), 0, n_blocks + 1
+    if n_frames:
+        seal_frames()
+        n_blocks += 1
+    if index:
+        seal_index()
+    seal(V2_BLOCK_FOOTER, V2_FOOTER.pack(previous_index, n_blocks, len(frames), 0, first_us, last_us), 0, last_us)
+    # Rewritten in place once the length is known, as SD_log_sync does
+    end, sequence = bytes(out), 0
+    out.clear()
+    seal(V2_BLOCK_FILE, file_block(len(end)), 0, 0)
+    return bytes(out) + end[sector_size:]
+
+# -----------------------------------------------------------------------------
+# Index
+# -----------------------------------------------------------------------------
+def index_from_footer(f, size, block_size=BLOCK_SIZE, seed=0):
+    """Walks the index blocks back from the footer, None if the file has no good footer."""
+    if size < SECTOR_SIZE or size % SECTOR_SIZE:
+        return None
+    block = read_block(f, size // SECTOR_SIZE - 1, block_size, seed)
+    if block is None or block[0][1] != V2_BLOCK_FOOTER:
+        return None
+    sector = V2_FOOTER.unpack_from(block[1])[0]
+    chunks = []
+    while sector != NO_SECTOR:
+        block = read_block(f, sector, block_size, seed)
+        if block is None or block[0][1] != V2_BLOCK_INDEX:
+            return None
+        previous, count, _ = V2_INDEX.unpack_from(block[1])
+        chunks.append([V2_INDEX_ENTRY.unpack_from(block[1], V2_INDEX.size + n * V2_INDEX_ENTRY.size)
+                       for n in range(count)])
+        sector = previous
+    return [entry for chunk in reversed(chunks) for entry in chunk]
+
+def rebuild_index(f, size, block_size=BLOCK_SIZE, seed=0, valid=None):
+    """Index of a file that was not closed: the header of every block is read, and only the frame
+    blocks no index block covers are decoded. Past the valid bytes blocks are only taken while
+    each is good and next in sequence. Returns the entries and how many were decoded."""
+    covered = {}
+    uncovered = []
+    offset = 0
+    expected = 0
+    while offset + V2_BLOCK.size <= size:
+        f.seek(offset)
+        magic, block_type, _, length, _, _, sequence, base_us, _ = V2_BLOCK.unpack(f.read(V2_BLOCK.size))
+        trusted = valid is None or offset < valid
+        if magic != V2_MAGIC or length > block_size:
+            if not trusted:
+                break
+            offset += SECTOR_SIZE
+            continue
+        if not trusted and (sequence != expected or read_block(f, offset // SECTOR_SIZE, block_size, seed) is None):
+            break
+        expected = sequence + 1
+        if block_type == V2_BLOCK_INDEX:
+            block = read_block(f, offset // SECTOR_SIZE, block_size, seed)
+            if block is not None:
+                count = V2_INDEX.unpack_from(block[1])[1]
+                for n in range(count):
+                    entry = V2_INDEX_ENTRY.unpack_from(block[1], V2_INDEX.size + n * V2_INDEX_ENTRY.size)
+                    covered[entry[0]] = entry
+        elif block_type in V2_FRAME_BLOCKS:
+            uncovered.append(offset // SECTOR_SIZE)
+        offset += -(-(V2_BLOCK.size + length) // SECTOR_SIZE) * SECTOR_SIZE
+    decoded = 0
+    for sector in uncovered:
+        if sector in covered:
+            continue
+        block = read_block(f, sector, block_size, seed)
+        if block is None:
+            continue
+        frames, _ = decode_records(block[1], block[0][7])
+        if frames:
+            covered[sector] = (sector, min(frames[-1][2] - frames[0][2], 0xFFFFFFFF), frames[0][2],
+                               bloom_of(can_id for can_id, _, _ in frames))
+            decoded += 1
+    return [covered[sector] for sector in sorted(covered)], decoded
+
+def idx_path(path):
+    return os.path.splitext(path)[0] + '.idx'
+
+def save_index(path, size, entries):
+    with open(idx_path(path), 'wb') as f:
+        f.write(IDX_HEADER.pack(IDX_MAGIC, IDX_VERSION, size, len(entries)))
+        f.write(b''.join(V2_INDEX_ENTRY.pack(*entry) for entry in entries))
+
+def load_saved_index(path, size):
+    try:
+        with open(idx_path(path), 'rb') as f:
+            raw = f.read()
+    except OSError:
+        return None
+    if len(raw) < IDX_HEADER.size:
+        return None
+    magic, version, log_size, count = IDX_HEADER.unpack_from(raw)
+    if magic != IDX_MAGIC or version != IDX_VERSION or log_size != size:
+        return None
+    return list(V2_INDEX_ENTRY.iter_unpack(raw[IDX_HEADER.size:IDX_HEADER.size + count * V2_INDEX_ENTRY.size]))
+
+def load_index(path, rebuild=False):
+    """Index entries of a v2 log and where they came from: footer, saved or rebuilt."""
+    size = os.path.getsize(path)
+    with open(path, 'rb') as f:
+        header = read_file_block(f) or NO_FILE_BLOCK
+        block_size, seed = header['block'], header['file_id']
+        if not rebuild:
+            entries = index_from_footer(f, size, block_size, seed)
+            if entries is not None:
+                return entries, 'footer'
+            entries = load_saved_index(path, size)
+            if entries is not None:
+                return entries, 'saved'
+        entries, decoded = rebuild_index(f, size, block_size, seed, header['valid'])
+    save_index(path, size, entries)
+    return entries, f'rebuilt, {decoded} blocks decoded'
+
+def query(path, start_us=None, end_us=None, can_ids=None, rebuild=False):
+    """Frames in [start_us, end_us] with one of can_ids, reading only the blocks the index allows.
+    Returns the frames, the blocks read, the blocks in the file and where the index came from."""
+    entries, source = load_index(path, rebuild)
+    chosen = []
+    for sector, span_us, base_us, bloom in entries:
+        if start_us is not None and base_us + span_us < start_us:
+            continue
+        if end_us is not None and base_us > end_us:
+            continue
+        if can_ids and not any(bloom_may_hold(bloom, can_id) for can_id in can_ids):
+            continue
+        chosen.append(sector)
+    frames = []
+    with open(path, 'rb') as f:
+        header = read_file_block(f) or NO_FILE_BLOCK
+        for sector in chosen:
+            block = read_block(f, sector, header['block'], header['file_id'])
+            if block is None:
+                continue
+            for frame in decode_records(block[1], block[0][7])[0]:
+                if start_us is not None and frame[2] < start_us:
+                    continue
+                if end_us is not None and frame[2] > end_us:
+                    continue
+                if can_ids and frame[0] not in can_ids:
+                    continue
+                frames.append(frame)
+    return frames, len(chosen), len(entries), source
+
+# -----------------------------------------------------------------------------
+# Either
+# -----------------------------------------------------------------------------
+def read(path, length=None):
+    """Frames and file info from a v1 or v2 log, or its first length bytes."""
+    with open(path, 'rb') as f:
+        raw = f.read() if length is None else f.read(length)
+    if len(raw) >= 4 and struct.unpack_from('<I', raw)[0] == V2_MAGIC:
+        return read_v2(raw)
+    return read_v1(raw)
+
+# -----------------------------------------------------------------------------
+# Main Execution
+# -----------------------------------------------------------------------------
+def per_frame(size, frames):
+    return size / max(len(frames), 1)
+
+def dump(frames, count):
+    for can_id, data, time_us in frames[:count]:
+        print(f"  {time_us / 1e6:12.6f}  {can_id:08X}  [{len(data)}] {bytes(data).hex(' ')}")
+
+def write_frames(path, frames):
+    if path.endswith('.csv'):
+        with open(path, 'w') as f:
+            f.write("time_s,id,dlc,data\n")
+            for can_id, data, time_us in frames:
+                f.write(f"{time_us / 1e6:.6f},0x{can_id:X},{len(data)},{bytes(data).hex()}\n")
+    else:
+        with open(path, 'wb') as f:
+            f.write(write_v2(frames))
+
+def cmd_info(args):
+    frames, info = read(args.log)
+    size = os.path.getsize(args.log)
+    print(f"{args.log}: v{info['version']}  {len(frames)} frames  {size} bytes  "
+          f"{per_frame(size, frames):.2f} bytes/frame")
+    if info['version'] == V2_VERSION:
+        print(f"  blocks {info['blocks']}  corrupt {info['corrupt']}  missing {info['missing']}  "
+              f"index blocks {info['index_blocks']}  footer {'yes' if info['footer'] else 'no'}  "
+              f"sector {info['sector']}  block {info['block']}  clock {info.get('clock', '-')}")
+        if info['valid'] is not None:
+            print(f"  file ID {info['file_id']:08X}  valid {info['valid']} of {info['allocated'] or size} bytes  "
+                  f"blocks after it {info['unsynced']}")
+        if info['lz_blocks']:
+            print(f"  compressed {info['lz_blocks']} frame blocks, {info['lz_raw_bytes']} record bytes in {info['lz_bytes']}, "
+                  f"{info['lz_raw_bytes'] / max(info['lz_bytes'], 1):.2f}:1")
+        if 'trigger' in info:
+            trigger = info['trigger']
+            print(f"  capture: {TRIGGER_CAUSES.get(trigger['cause'], trigger['cause'])} source {trigger['source']} "
+                  f"at {trigger['trigger_us'] / 1e6:.6f} s, {trigger['pre_us'] / 1000:.0f} ms before and "
+                  f"{trigger['post_us'] / 1000:.0f} ms after asked for")
+            if frames:
+                print(f"  frames from {(frames[0][2] - trigger['trigger_us']) / 1000:.1f} ms to "
+                      f"{(frames[-1][2] - trigger['trigger_us']) / 1000:.1f} ms")
+    dump(frames, args.dump)
+    return 0
+
+def cmd_convert(args):
+    frames, info = read(args.log)
+    v1, truncated = write_v1(frames)
+    v2 = write_v2(frames, args.block)
+    print(f"{args.log}: v{info['version']}  {len(frames)} frames")
+    print(f"v1 {per_frame(len(v1), frames):6.2f} bytes/frame  IDs truncated {truncated}")
+    print(f"v2 {per_frame(len(v2), frames):6.2f} bytes/frame  saving {100 * (1 - len(v2) / max(len(v1), 1)):.1f}%")
+    with open(args.out, 'wb') as f:
+        f.write(v1 if info['version'] == V2_VERSION else v2)
+    print(f"Wrote {args.out} as v{1 if info['version'] == V2_VERSION else V2_VERSION}")
+    return 0
+
+def cmd_index(args):
+    start = time.perf_counter()
+    entries, source = load_index(args.log, args.rebuild)
+    message = f"{args.log}: {len(entries)} frame blocks indexed ({source}) in {(time.perf_counter() - start) * 1000:.1f} ms"
+    if source.startswith('rebuilt'):
+        message += f", saved to {idx_path(args.log)}"
+    print(message)
+    return 0
+
+def cmd_query(args):
+    start = time.perf_counter()
+    frames, read_blocks, total, source = query(
+        args.log, None if args.start is None else int(args.start * 1e6),
+        None if args.end is None else int(args.end * 1e6), set(args.id) if args.id else None, args.rebuild)
+    print(f"{len(frames)} frames from {read_blocks} of {total} blocks in "
+          f"{(time.perf_counter() - start) * 1000:.1f} ms (index {source})")
+    dump(frames, args.dump)
+    if args.out:
+        write_frames(args.out, frames)
+        print(f"Wrote {args.out}")
+    return 0
+
+def main():
+    parser = argparse.ArgumentParser(description="Read, convert and query SFR SD card logs")
+    commands = parser.add_subparsers(dest='command', required=True)
+
+    info = commands.add_parser('info', help="Decode the whole log and print its totals")
+    info.add_argument('log', help="v1 or v2 log")
+    info.add_argument('--dump', type=int, default=0, help="Print the first N frames")
+    info.set_defaults(run=cmd_info)
+
+    convert = commands.add_parser('convert', help="Write the log as the other version")
+    convert.add_argument('log', help="v1 or v2 log")
+    convert.add_argument('out')
+    convert.add_argument('--block', type=int, default=BLOCK_SIZE, help="v2 block size to convert with")
+    convert.set_defaults(run=cmd_convert)
+
+    index = commands.add_parser('index', help="Read or rebuild a v2 log's index")
+    index.add_argument('log', help="v2 log")
+    index.add_argument('--rebuild', action='store_true', help="Ignore the footer and any saved index")
+    index.set_defaults(run=cmd_index)
+
+    find = commands.add_parser('query', help="Pull a time window and/or IDs out of a v2 log")
+    find.add_argument('log', help="v2 log")
+    find.add_argument('--start', type=float, help="Seconds since power up")
+    find.add_argument('--end', type=float, help="Seconds since power up")
+    find.add_argument('--id', type=lambda text: int(text, 0), nargs='+', help="IDs to keep")
+    find.add_argument('--out', help="Write the frames here, .csv or a v2 log")
+    find.add_argument('--dump', type=int, default=0, help="Print the first N frames")
+    find.add_argument('--rebuild', action='store_true', help="Rebuild the index first")
+    find.set_defaults(run=cmd_query)
+
+    args = parser.parse_args()
+    return args.run(args)
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,440 @@
+/*
+canSignals.c
+File contains the decoding of CAN frames through the table decodeCAN.py writes to
+canSignalsAuto.c, bit for bit what the firmware's Rx functions do, see canSignals.h.
+
+Written by Cole Perera for Sheffield Formula Racing 2026
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "canSignals.h"
+
+/* --------------------------- Definitions ----------------------------- */
+#define CAN_SIGNAL_HASH_SIZE    1024    // Over twice the most messages a bus could have
+#define CAN_SIGNAL_HASH         0x9E3779B1u
+#define CAN_SIGNAL_CRC16_POLY   0x8408  // CRC-16/CCITT reflected, as the ROM's crc16_le
+
+/* --------------------------- Local Types ----------------------------- */
+typedef struct {
+    byte byNChunks;
+    stCANSignalChunk_t astChunks[CAN_SIGNAL_MAX_CHUNKS];
+} stCANSignalLayout_t;
+
+/* --------------------------- Local Variables ------------------------ */
+static stCANSignalLayout_t *astLayouts;
+static stCANSignalMessage_t *astMessages;
+static stCANSignalMessage_t *apstHash[CAN_SIGNAL_HASH_SIZE];
+
+/* --------------------------- Function prototypes --------------------- */
+static void CAN_signals_layout(const stCANSignal_t *pstSignal, stCANSignalLayout_t *pstLayout);
+static uint32_t CAN_signals_raw(const stCANSignalLayout_t *pstLayout, const byte *abyData);
+static double CAN_signals_convert(const stCANSignal_t *pstSignal, uint32_t dwRaw);
+static boolean CAN_signals_checksum(const stCANMessage_t *pstMessage, const byte *abyData, byte byDLC);
+static uint16_t CAN_signals_crc16_le(uint16_t wCRC, const byte *abyData, dword dwLength);
+
+/* --------------------------- Functions ----------------------------- */
+boolean CAN_signals_init(void)
+{
+    /*
+    *===========================================================================
+    *   CAN_signals_init
+    *   Takes:   None
+    *
+    *   Returns: FALSE if out of memory.
+    *
+    *   Works out where in the frame each signal's bits are, the rows of each
+    *   message's mux values and the table CAN_signals_find looks IDs up in.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    word wMessage;
+    word wSignal;
+    dword dwSlot;
+    const stCANMessage_t *pstMessage;
+    stCANSignalMessage_t *pstDecode;
+
+    astLayouts = calloc(wNCANSignals, sizeof(stCANSignalLayout_t));
+    astMessages = calloc(wNCANMessages, sizeof(stCANSignalMessage_t));
+    if (astLayouts == NULL || astMessages == NULL)
+    {
+        return FALSE;
+    }
+    for (wSignal = 0; wSignal < wNCANSignals; wSignal++)
+    {
+        CAN_signals_layout(&astCANSignals[wSignal], &astLayouts[wSignal]);
+    }
+
+    for (wMessage = 0; wMessage < wNCANMessages; wMessage++)
+    {
+        pstMessage = &astCANMessages[wMessage];
+        pstDecode = &astMessages[wMessage];
+        pstDecode->pstMessage = pstMessage;
+        pstDecode->wNUnmuxed = pstMessage->wNSignals;
+        if (pstMessage->nMuxSwitch != CAN_SIGNAL_NO_MUX && pstMessage->nMuxSwitch + 1 < pstMessage->wNSignals)
+        {
+            /* The muxed rows follow the switch in order of mux value */
+            const stCANSignal_t *astRows = &astCANSignals[pstMessage->wFirstSignal];
+            word wFirstMuxed = (word)(pstMessage->nMuxSwitch + 1);
+
+            pstDecode->wNUnmuxed = wFirstMuxed;
+            pstDecode->nMuxMin = astRows[wFirstMuxed].nMux;
+            pstDecode->dwNMuxValues = (dword)(astRows[pstMessage->wNSignals - 1].nMux - pstDecode->nMuxMin + 1);
+            pstDecode->awMuxFirst = calloc(pstDecode->dwNMuxValues, sizeof(word));
+            pstDecode->awMuxCount = calloc(pstDecode->dwNMuxValues, sizeof(word));
+            if (pstDecode->awMuxFirst == NULL || pstDecode->awMuxCount == NULL)
+            {
+                return FALSE;
+            }
+            for (wSignal = pstMessage->wNSignals; wSignal-- > wFirstMuxed;)
+            {
+                dword dwValue = (dword)(astRows[wSignal].nMux - pstDecode->nMuxMin);
+
+                pstDecode->awMuxFirst[dwValue] = (word)(pstMessage->wFirstSignal + wSignal);
+                pstDecode->awMuxCount[dwValue]++;
+            }
+        }
+
+        dwSlot = (dword)((pstMessage->dwID * CAN_SIGNAL_HASH) >> 22) % CAN_SIGNAL_HASH_SIZE;
+        while (apstHash[dwSlot] != NULL)
+        {
+            dwSlot = (dwSlot + 1) % CAN_SIGNAL_HASH_SIZE;
+        }
+        apstHash[dwSlot] = pstDecode;
+    }
+    return TRUE;
+}
+
+const stCANSignalMessage_t *CAN_signals_find(uint32_t dwID)
+{
+    /*
+    *===========================================================================
+    *   CAN_signals_find
+    *   Takes:   dwID - 11 or 29 bit ID, matched as the Rx functions do with
+    *            no regard to which it is
+    *
+    *   Returns: The message, NULL if no Rx function takes it.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    dword dwSlot = (dword)((dwID * CAN_SIGNAL_HASH) >> 22) % CAN_SIGNAL_HASH_SIZE;
+
+    while (apstHash[dwSlot] != NULL)
+    {
+        if (apstHash[dwSlot]->pstMessage->dwID == dwID)
+        {
+            return apstHash[dwSlot];
+        }
+        dwSlot = (dwSlot + 1) % CAN_SIGNAL_HASH_SIZE;
+    }
+    return NULL;
+}
+
+word CAN_signals_decode(const stCANSignalMessage_t *pstMessage, const byte *abyData, byte byDLC,
+                        word *awSignals, double *afValues)
+{
+    /*
+    *===========================================================================
+    *   CAN_signals_decode
+    *   Takes:   pstMessage - from CAN_signals_find
+    *            abyData - the frame's data
+    *            byDLC - its length
+    *            awSignals - where the rows decoded go, room for the message's
+    *            afValues - and their values
+    *
+    *   Returns: How many were decoded, 0 if the Rx function would have
+    *            refused the frame.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    const stCANMessage_t *pstInfo = pstMessage->pstMessage;
+    word wSignal = pstInfo->wFirstSignal;
+    word wEnd = (word)(wSignal + pstMessage->wNUnmuxed);
+    word wN = 0;
+    uint32_t dwRaw = 0;
+    int64_t nMux;
+
+    if (byDLC != CAN_SIGNAL_DLC || !CAN_signals_checksum(pstInfo, abyData, byDLC))
+    {
+        return 0;
+    }
+
+    for (; wSignal < wEnd; wSignal++)
+    {
+        dwRaw = CAN_signals_raw(&astLayouts[wSignal], abyData);
+        awSignals[wN] = wSignal;
+        afValues[wN++] = CAN_signals_convert(&astCANSignals[wSignal], dwRaw);
+    }
+    if (pstMessage->dwNMuxValues == 0)
+    {
+        return wN;
+    }
+
+    /* The switch was the last one decoded, the Rx function takes its raw bits as an int */
+    nMux = (int64_t)(int)dwRaw - pstMessage->nMuxMin;
+    if (nMux < 0 || nMux >= (int64_t)pstMessage->dwNMuxValues)
+    {
+        return wN;
+    }
+    wSignal = pstMessage->awMuxFirst[nMux];
+    wEnd = (word)(wSignal + pstMessage->awMuxCount[nMux]);
+    for (; wSignal < wEnd; wSignal++)
+    {
+        awSignals[wN] = wSignal;
+        afValues[wN++] = CAN_signals_convert(&astCANSignals[wSignal], CAN_signals_raw(&astLayouts[wSignal], abyData));
+    }
+    return wN;
+}
+
+double CAN_signals_value(word wSignal, const byte *abyData)
+{
+    /*
+    *===========================================================================
+    *   CAN_signals_value
+    *   Takes:   wSignal - row of astCANSignals
+    *            abyData - a frame's 8 bytes
+    *
+    *   Returns: The value the Rx function would set it to, whatever the mux
+    *            or checksum.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    return CAN_signals_convert(&astCANSignals[wSignal], CAN_signals_raw(&astLayouts[wSignal], abyData));
+}
+
+static void CAN_signals_layout(const stCANSignal_t *pstSignal, stCANSignalLayout_t *pstLayout)
+{
+    /*
+    *===========================================================================
+    *   CAN_signals_layout
+    *   Takes:   pstSignal - row of the table
+    *            pstLayout - its chunks
+    *
+    *   Returns: Nothing.
+    *
+    *   Mirror of decodeCAN.py's generate_unpack_expr. Intel takes bits up
+    *   from the start bit, least significant first. Motorola takes them down
+    *   from the start bit then on to the top of the next byte, most
+    *   significant first, and stops at the end of the frame with what it has
+    *   left where it would have been.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    dword dwBit = pstSignal->byStartBit;
+    dword dwRemaining = pstSignal->byLength;
+    dword dwPlace = 0;
+    dword dwTake;
+    dword dwShift;
+    stCANSignalChunk_t *pstChunk;
+
+    pstLayout->byNChunks = 0;
+    while (dwRemaining > 0 && pstLayout->byNChunks < CAN_SIGNAL_MAX_CHUNKS)
+    {
+        if (!pstSignal->BBigEndian)
+        {
+            dwShift = dwBit % 8;
+            dwTake = dwRemaining < 8 - dwShift ? dwRemaining : 8 - dwShift;
+        } else
+        {
+            dwTake = dwRemaining < dwBit % 8 + 1 ? dwRemaining : dwBit % 8 + 1;
+            dwShift = dwBit % 8 + 1 - dwTake;
+        }
+        if (dwBit / 8 >= CAN_SIGNAL_DLC)
+        {
+            break;
+        }
+        pstChunk = &pstLayout->astChunks[pstLayout->byNChunks++];
+        pstChunk->byByte = (byte)(dwBit / 8);
+        pstChunk->byShift = (byte)dwShift;
+        pstChunk->byMask = (byte)((1u << dwTake) - 1);
+        dwRemaining -= dwTake;
+        if (!pstSignal->BBigEndian)
+        {
+            pstChunk->byPlace = (byte)dwPlace;
+            dwPlace += dwTake;
+            dwBit += dwTake;
+        } else
+        {
+            pstChunk->byPlace = (byte)dwRemaining;
+            dwBit = (dwBit / 8 + 1) * 8 + 7;
+        }
+    }
+}
+
+static uint32_t CAN_signals_raw(const stCANSignalLayout_t *pstLayout, const byte *abyData)
+{
+    /*
+    *===========================================================================
+    *   CAN_signals_raw
+    *   Takes:   pstLayout - a signal's chunks
+    *            abyData - the frame's 8 bytes
+    *
+    *   Returns: Its raw bits.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    const stCANSignalChunk_t *pstChunk = pstLayout->astChunks;
+    const stCANSignalChunk_t *pstEnd = pstChunk + pstLayout->byNChunks;
+    uint32_t dwRaw = 0;
+
+    for (; pstChunk < pstEnd; pstChunk++)
+    {
+        dwRaw |= (uint32_t)((abyData[pstChunk->byByte] >> pstChunk->byShift) & pstChunk->byMask) << pstChunk->byPlace;
+    }
+    return dwRaw;
+}
+
+static double CAN_signals_convert(const stCANSignal_t *pstSignal, uint32_t dwRaw)
+{
+    /*
+    *===========================================================================
+    *   CAN_signals_convert
+    *   Takes:   pstSignal - row of the table
+    *            dwRaw - its raw bits
+    *
+    *   Returns: The value as the Rx function works it out, held as a double.
+    *
+    *   The same float sums in the same order as decodeCAN.py's
+    *   generate_signal_decode, so it rounds the same.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    float fValue;
+
+    if (pstSignal->fGain == 1.0f && pstSignal->fOffset == 0.0f && pstSignal->eType != eCAN_SIGNAL_FLOAT)
+    {
+        switch (pstSignal->eType)
+        {
+            case eCAN_SIGNAL_BOOL:      return (double)(dwRaw != 0);
+            case eCAN_SIGNAL_UINT8:     return (double)(uint8_t)dwRaw;
+            case eCAN_SIGNAL_INT8:      return (double)(int8_t)dwRaw;
+            case eCAN_SIGNAL_UINT16:    return (double)(uint16_t)dwRaw;
+            case eCAN_SIGNAL_INT16:     return (double)(int16_t)dwRaw;
+            case eCAN_SIGNAL_INT32:     return (double)(int32_t)dwRaw;
+            default:                    return (double)dwRaw;
+        }
+    }
+
+    if (pstSignal->fGain != 1.0f && pstSignal->fOffset != 0.0f)
+    {
+        fValue = (float)dwRaw * pstSignal->fGain + pstSignal->fOffset;
+    } else if (pstSignal->fGain != 1.0f)
+    {
+        fValue = (float)dwRaw * pstSignal->fGain;
+    } else if (pstSignal->fOffset != 0.0f)
+    {
+        fValue = (float)dwRaw + pstSignal->fOffset;
+    } else
+    {
+        fValue = (float)dwRaw;
+    }
+    switch (pstSignal->eType)
+    {
+        case eCAN_SIGNAL_BOOL:      return (double)(fValue != 0.0f);
+        case eCAN_SIGNAL_UINT8:     return (double)(uint8_t)fValue;
+        case eCAN_SIGNAL_INT8:      return (double)(int8_t)fValue;
+        case eCAN_SIGNAL_UINT16:    return (double)(uint16_t)fValue;
+        case eCAN_SIGNAL_INT16:     return (double)(int16_t)fValue;
+        case eCAN_SIGNAL_UINT32:    return (double)(uint32_t)fValue;
+        case eCAN_SIGNAL_INT32:     return (double)(int32_t)fValue;
+        default:                    return (double)fValue;
+    }
+}
+
+static boolean CAN_signals_checksum(const stCANMessage_t *pstMessage, const byte *abyData, byte byDLC)
+{
+    /*
+    *===========================================================================
+    *   CAN_signals_checksum
+    *   Takes:   pstMessage - row of the table
+    *            abyData - the frame's 8 bytes
+    *            byDLC - its length
+    *
+    *   Returns: FALSE if the Rx function would refuse it for its checksum.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    dword dwByte;
+    uint16_t wSum = 0;
+
+    switch (pstMessage->byChecksumRule)
+    {
+        case CAN_SIGNAL_CHECKSUM_SUM:
+            for (dwByte = 0; dwByte < pstMessage->byChecksumByte; dwByte++)
+            {
+                wSum = (uint16_t)(wSum + abyData[dwByte]);
+            }
+            wSum = (uint16_t)(wSum + CAN_SIGNAL_SUM_SEED + byDLC);
+            return (byte)wSum == abyData[pstMessage->byChecksumByte];
+        case CAN_SIGNAL_CHECKSUM_CRC:
+            return CAN_signals_crc16_le(0xFFFF, abyData, pstMessage->byChecksumByte) ==
+                   (uint16_t)((abyData[pstMessage->byChecksumByte] << 8) | abyData[pstMessage->byChecksumByte + 1]);
+        default:
+            return TRUE;
+    }
+}
+
+static uint16_t CAN_signals_crc16_le(uint16_t wCRC, const byte *abyData, dword dwLength)
+{
+    /*
+    *===========================================================================
+    *   CAN_signals_crc16_le
+    *   Takes:   wCRC - CRC so far
+    *            abyData - bytes to add
+    *            dwLength - how many
+    *
+    *   Returns: The CRC, as esp_rom_crc16_le works it out, inverted in and
+    *            out.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    dword dwByte;
+    dword dwBit;
+
+    wCRC = (uint16_t)~wCRC;
+    for (dwByte = 0; dwByte < dwLength; dwByte++)
+    {
+        wCRC ^= abyData[dwByte];
+        for (dwBit = 0; dwBit < 8; dwBit++)
+        {
+            wCRC = (uint16_t)((wCRC & 1) ? (wCRC >> 1) ^ CAN_SIGNAL_CRC16_POLY : wCRC >> 1);
+        }
+    }
+    return (uint16_t)~wCRC;
+}
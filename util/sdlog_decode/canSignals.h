@@ -0,0 +1,114 @@
+/* Only define once */
+#ifndef SFRCANSignals
+#define SFRCANSignals
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*  CAN Signal Table
+    canSignalsAuto.c is written by decodeCAN.py next to canDecodeAuto.c and holds what each
+    <Message>Rx function decodes, so a log can be decoded on a PC exactly as the firmware would:
+        - A message only decodes with a DLC of 8, and not at all if its checksum is wrong.
+        - A row per value written, in the order the Rx function writes them: the standard signals,
+          the mux switch, then each mux value's signals. A muxed array has a row per element with
+          the mux value that writes it, "VCell[3]" with mux 3.
+        - The raw bits are put together as the Rx function does, then cast straight to the type with
+          a gain of 1 and offset of 0, or worked out in float and cast otherwise. Nothing is sign
+          extended, a signed type gets its sign from the cast.
+    Built with CAN_SIGNAL_FIRMWARE, and main/CAN/canDecodeAuto.c, each row points at the global
+    it is decoded to and each message at its Rx function so the two can be checked against each
+    other, see util/reflash_sim/decode_bench.py.
+*/
+#ifdef CAN_SIGNAL_FIRMWARE
+#include "canDecodeAuto.h"
+#define CAN_SIGNAL_FW(x)    ((const void *)&(x))
+#define CAN_SIGNAL_RX(x)    (x)
+typedef esp_err_t (*pfnCANSignalRx_t)(CAN_frame_t stFrame);
+#else
+#define CAN_SIGNAL_FW(x)    NULL
+#define CAN_SIGNAL_RX(x)    NULL
+typedef const void *pfnCANSignalRx_t;
+#endif
+
+#ifndef SFRTypes
+#define TRUE 1
+#define FALSE 0
+typedef int boolean;
+typedef unsigned char byte;
+typedef unsigned short word;
+typedef signed short sword;
+typedef unsigned long dword;
+typedef unsigned long long qword;
+#endif
+
+#define CAN_SIGNAL_NO_MUX       -1
+#define CAN_SIGNAL_DLC          8       // The Rx functions take nothing shorter
+#define CAN_SIGNAL_MAX_CHUNKS   8       // A byte each
+#define CAN_SIGNAL_CHECKSUM_SUM 1       // Rule 1, 8 bit sum of the bytes before + 0x39 + DLC
+#define CAN_SIGNAL_CHECKSUM_CRC 2       // Rule 2, esp_rom_crc16_le of the bytes before, stored MSB first
+#define CAN_SIGNAL_SUM_SEED     0x39
+
+typedef enum {
+    eCAN_SIGNAL_BOOL = 0,
+    eCAN_SIGNAL_UINT8,
+    eCAN_SIGNAL_INT8,
+    eCAN_SIGNAL_UINT16,
+    eCAN_SIGNAL_INT16,
+    eCAN_SIGNAL_UINT32,
+    eCAN_SIGNAL_INT32,
+    eCAN_SIGNAL_FLOAT,
+} eCANSignalType_t;
+
+typedef struct {
+    const char *pszName;        // The global it is decoded to
+    byte byStartBit;            // LSB for Intel, MSB for Motorola
+    byte byLength;
+    boolean BBigEndian;
+    eCANSignalType_t eType;
+    float fGain;
+    float fOffset;
+    int32_t nMux;               // Mux value that writes it, CAN_SIGNAL_NO_MUX for every frame
+    const void *pvFirmware;     // The global, CAN_SIGNAL_FIRMWARE only
+} stCANSignal_t;
+
+typedef struct {
+    uint32_t dwID;
+    const char *pszName;
+    word wFirstSignal;          // Its rows in astCANSignals
+    word wNSignals;
+    sword nMuxSwitch;           // Row of the mux switch from wFirstSignal, CAN_SIGNAL_NO_MUX for none
+    byte byChecksumRule;        // 0 for none
+    byte byChecksumByte;
+    pfnCANSignalRx_t pfnRx;     // CAN_SIGNAL_FIRMWARE only
+} stCANMessage_t;
+
+/* A byte's worth of a signal, ((abData[byByte] >> byShift) & byMask) << byPlace */
+typedef struct {
+    byte byByte;
+    byte byShift;
+    byte byMask;
+    byte byPlace;
+} stCANSignalChunk_t;
+
+/* A message as CAN_signals_decode uses it, the rows of each mux value found up front */
+typedef struct {
+    const stCANMessage_t *pstMessage;
+    word wNUnmuxed;             // Rows decoded every frame, the switch last if there is one
+    int32_t nMuxMin;
+    dword dwNMuxValues;
+    word *awMuxFirst;           // Per mux value from nMuxMin, its first row and how many
+    word *awMuxCount;
+} stCANSignalMessage_t;
+
+extern const stCANSignal_t astCANSignals[];
+extern const stCANMessage_t astCANMessages[];
+extern const word wNCANSignals;
+extern const word wNCANMessages;
+
+boolean CAN_signals_init(void);
+const stCANSignalMessage_t *CAN_signals_find(uint32_t dwID);
+word CAN_signals_decode(const stCANSignalMessage_t *pstMessage, const byte *abyData, byte byDLC,
+                        word *awSignals, double *afValues);
+double CAN_signals_value(word wSignal, const byte *abyData);
+
+#endif // SFRCANSignals
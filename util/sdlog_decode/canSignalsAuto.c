@@ -0,0 +1,1387 @@
+/* This file is autogenerated from the script decodeCAN.py */
+#include "canSignals.h"
+
+const stCANSignal_t astCANSignals[] = {
+    /* ESPControl (0x10) */
+    {"BRestart", 7, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BRestart)},
+    {"BClearMinMax", 6, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BClearMinMax)},
+    {"BClearErrors", 5, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BClearErrors)},
+    {"BReflashMode", 4, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BReflashMode)},
+    {"BNormalMode", 3, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BNormalMode)},
+    {"NTargetDeviceID", 8, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NTargetDeviceID)},
+    /* MCUStatusTelemCar (0x11) */
+    {"tLastTaskTime1msTelemCar", 0, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime1msTelemCar)},
+    {"tMaxTaskTime1msTelemCar", 8, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime1msTelemCar)},
+    {"tLastTaskTime100msTelemCar", 16, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime100msTelemCar)},
+    {"tMaxTaskTime100msTelemCar", 24, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime100msTelemCar)},
+    {"tLastTaskTimeBGTelemCar", 32, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTimeBGTelemCar)},
+    {"tMaxTaskTimeBGTelemCar", 40, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTimeBGTelemCar)},
+    {"tSincePowerUpTelemCar", 55, 12, TRUE, eCAN_SIGNAL_UINT16, 4.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tSincePowerUpTelemCar)},
+    {"NLastResetReasonTelemCar", 56, 4, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NLastResetReasonTelemCar)},
+    /* MCUStatusTelemPits (0x12) */
+    {"tLastTaskTime1msTelemPits", 0, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime1msTelemPits)},
+    {"tMaxTaskTime1msTelemPits", 8, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime1msTelemPits)},
+    {"tLastTaskTime100msTelemPits", 16, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime100msTelemPits)},
+    {"tMaxTaskTime100msTelemPits", 24, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime100msTelemPits)},
+    {"tLastTaskTimeBGTelemPits", 32, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTimeBGTelemPits)},
+    {"tMaxTaskTimeBGTelemPits", 40, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTimeBGTelemPits)},
+    {"tSincePowerUpTelemPits", 55, 12, TRUE, eCAN_SIGNAL_UINT16, 4.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tSincePowerUpTelemPits)},
+    {"NLastResetReasonTelemPits", 56, 4, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NLastResetReasonTelemPits)},
+    /* MCUStatusIMDMonitor (0x13) */
+    {"tLastTaskTime1msIMDMon", 0, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime1msIMDMon)},
+    {"tMaxTaskTime1msIMDMon", 8, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime1msIMDMon)},
+    {"tLastTaskTime100msIMDMon", 16, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime100msIMDMon)},
+    {"tMaxTaskTime100msIMDMon", 24, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime100msIMDMon)},
+    {"tLastTaskTimeBGIMDMon", 32, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTimeBGIMDMon)},
+    {"tMaxTaskTimeBGIMDMon", 40, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTimeBGIMDMon)},
+    {"tSincePowerUpIMDMon", 55, 12, TRUE, eCAN_SIGNAL_UINT16, 4.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tSincePowerUpIMDMon)},
+    {"NLastResetReasonIMDMon", 56, 4, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NLastResetReasonIMDMon)},
+    /* MCUStatusLogger (0x14) */
+    {"tLastTaskTime1msLogger", 0, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime1msLogger)},
+    {"tMaxTaskTime1msLogger", 8, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime1msLogger)},
+    {"tLastTaskTime100msLogger", 16, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime100msLogger)},
+    {"tMaxTaskTime100msLogger", 24, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime100msLogger)},
+    {"tLastTaskTimeBGLogger", 32, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTimeBGLogger)},
+    {"tMaxTaskTimeBGLogger", 40, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTimeBGLogger)},
+    {"tSincePowerUpLogger", 55, 12, TRUE, eCAN_SIGNAL_UINT16, 4.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tSincePowerUpLogger)},
+    {"NLastResetReasonLogger", 56, 4, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NLastResetReasonLogger)},
+    /* MCUStatusPDU (0x15) */
+    {"tLastTaskTime1msPDU", 0, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime1msPDU)},
+    {"tMaxTaskTime1msPDU", 8, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime1msPDU)},
+    {"tLastTaskTime100msPDU", 16, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime100msPDU)},
+    {"tMaxTaskTime100msPDU", 24, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime100msPDU)},
+    {"tLastTaskTimeBGPDU", 32, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTimeBGPDU)},
+    {"tMaxTaskTimeBGPDU", 40, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTimeBGPDU)},
+    {"tSincePowerUpPDU", 55, 12, TRUE, eCAN_SIGNAL_UINT16, 4.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tSincePowerUpPDU)},
+    {"NLastResetReasonPDU", 56, 4, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NLastResetReasonPDU)},
+    /* StatusAPPS (0x16) */
+    {"tLastTaskTime1msAPPS", 0, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime1msAPPS)},
+    {"tMaxTaskTime1msAPPS", 8, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime1msAPPS)},
+    {"tLastTaskTime100msAPPS", 16, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime100msAPPS)},
+    {"tMaxTaskTime100msAPPS", 24, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime100msAPPS)},
+    {"tLastTaskTimeBGAPPS", 32, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTimeBGAPPS)},
+    {"tMaxTaskTimeBGAPPS", 40, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTimeBGAPPS)},
+    {"tSincePowerUpAPPS", 55, 12, TRUE, eCAN_SIGNAL_UINT16, 4.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tSincePowerUpAPPS)},
+    {"NLastResetReasonAPPS", 56, 4, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NLastResetReasonAPPS)},
+    /* MCUStatusScreen (0x17) */
+    {"tLastTaskTime1msScreen", 0, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime1msScreen)},
+    {"tMaxTaskTime1msScreen", 8, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime1msScreen)},
+    {"tLastTaskTime100msScreen", 16, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime100msScreen)},
+    {"tMaxTaskTime100msScreen", 24, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime100msScreen)},
+    {"tLastTaskTimeBGScreen", 32, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTimeBGScreen)},
+    {"tMaxTaskTimeBGScreen", 40, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTimeBGScreen)},
+    {"tSincePowerUpScreen", 55, 12, TRUE, eCAN_SIGNAL_UINT16, 4.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tSincePowerUpScreen)},
+    {"NLastResetReasonScreen", 56, 4, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NLastResetReasonScreen)},
+    /* MCUStatusDash (0x18) */
+    {"tLastTaskTime1msDash", 0, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime1msDash)},
+    {"tMaxTaskTime1msDash", 8, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime1msDash)},
+    {"tLastTaskTime100msDash", 16, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime100msDash)},
+    {"tMaxTaskTime100msDash", 24, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime100msDash)},
+    {"tLastTaskTimeBGDash", 32, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTimeBGDash)},
+    {"tMaxTaskTimeBGDash", 40, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTimeBGDash)},
+    {"tSincePowerUpDash", 55, 12, TRUE, eCAN_SIGNAL_UINT16, 4.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tSincePowerUpDash)},
+    {"NLastResetReasonDash", 56, 4, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NLastResetReasonDash)},
+    /* MCUStatusDyno (0x19) */
+    {"tLastTaskTime1msDyno", 0, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime1msDyno)},
+    {"tMaxTaskTime1msDyno", 8, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime1msDyno)},
+    {"tLastTaskTime100msDyno", 16, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime100msDyno)},
+    {"tMaxTaskTime100msDyno", 24, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime100msDyno)},
+    {"tLastTaskTimeBGDyno", 32, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTimeBGDyno)},
+    {"tMaxTaskTimeBGDyno", 40, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTimeBGDyno)},
+    {"tSincePowerUpDyno", 55, 12, TRUE, eCAN_SIGNAL_UINT16, 4.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tSincePowerUpDyno)},
+    {"NLastResetReasonDyno", 56, 4, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NLastResetReasonDyno)},
+    /* MCUStatusTempMon (0x1A) */
+    {"tLastTaskTime1msTempMon", 0, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime1msTempMon)},
+    {"tMaxTaskTime1msTempMon", 8, 8, FALSE, eCAN_SIGNAL_UINT8, 50.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime1msTempMon)},
+    {"tLastTaskTime100msTempMon", 16, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTime100msTempMon)},
+    {"tMaxTaskTime100msTempMon", 24, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTime100msTempMon)},
+    {"tLastTaskTimeBGTempMon", 32, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tLastTaskTimeBGTempMon)},
+    {"tMaxTaskTimeBGTempMon", 40, 8, FALSE, eCAN_SIGNAL_UINT8, 500.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tMaxTaskTimeBGTempMon)},
+    {"tSincePowerUpTempMon", 55, 12, TRUE, eCAN_SIGNAL_UINT16, 4.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(tSincePowerUpTempMon)},
+    {"NLastResetReasonTempMon", 56, 4, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NLastResetReasonTempMon)},
+    /* SetAcCurrent (0x24) */
+    {"CMD_TargetAcCurrent", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(CMD_TargetAcCurrent)},
+    /* CellVoltages (0x36) */
+    {"CellID", 0, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(CellID)},
+    {"VCell[0]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 0, CAN_SIGNAL_FW(VCell[0])},
+    {"BBalancingCell[0]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 0, CAN_SIGNAL_FW(BBalancingCell[0])},
+    {"RCell[0]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 0, CAN_SIGNAL_FW(RCell[0])},
+    {"VOpenCell[0]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 0, CAN_SIGNAL_FW(VOpenCell[0])},
+    {"VCell[1]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 1, CAN_SIGNAL_FW(VCell[1])},
+    {"BBalancingCell[1]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 1, CAN_SIGNAL_FW(BBalancingCell[1])},
+    {"RCell[1]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 1, CAN_SIGNAL_FW(RCell[1])},
+    {"VOpenCell[1]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 1, CAN_SIGNAL_FW(VOpenCell[1])},
+    {"VCell[2]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 2, CAN_SIGNAL_FW(VCell[2])},
+    {"BBalancingCell[2]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 2, CAN_SIGNAL_FW(BBalancingCell[2])},
+    {"RCell[2]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 2, CAN_SIGNAL_FW(RCell[2])},
+    {"VOpenCell[2]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 2, CAN_SIGNAL_FW(VOpenCell[2])},
+    {"VCell[3]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 3, CAN_SIGNAL_FW(VCell[3])},
+    {"BBalancingCell[3]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 3, CAN_SIGNAL_FW(BBalancingCell[3])},
+    {"RCell[3]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 3, CAN_SIGNAL_FW(RCell[3])},
+    {"VOpenCell[3]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 3, CAN_SIGNAL_FW(VOpenCell[3])},
+    {"VCell[4]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 4, CAN_SIGNAL_FW(VCell[4])},
+    {"BBalancingCell[4]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 4, CAN_SIGNAL_FW(BBalancingCell[4])},
+    {"RCell[4]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 4, CAN_SIGNAL_FW(RCell[4])},
+    {"VOpenCell[4]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 4, CAN_SIGNAL_FW(VOpenCell[4])},
+    {"VCell[5]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 5, CAN_SIGNAL_FW(VCell[5])},
+    {"BBalancingCell[5]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 5, CAN_SIGNAL_FW(BBalancingCell[5])},
+    {"RCell[5]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 5, CAN_SIGNAL_FW(RCell[5])},
+    {"VOpenCell[5]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 5, CAN_SIGNAL_FW(VOpenCell[5])},
+    {"VCell[6]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 6, CAN_SIGNAL_FW(VCell[6])},
+    {"BBalancingCell[6]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 6, CAN_SIGNAL_FW(BBalancingCell[6])},
+    {"RCell[6]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 6, CAN_SIGNAL_FW(RCell[6])},
+    {"VOpenCell[6]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 6, CAN_SIGNAL_FW(VOpenCell[6])},
+    {"VCell[7]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 7, CAN_SIGNAL_FW(VCell[7])},
+    {"BBalancingCell[7]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 7, CAN_SIGNAL_FW(BBalancingCell[7])},
+    {"RCell[7]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 7, CAN_SIGNAL_FW(RCell[7])},
+    {"VOpenCell[7]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 7, CAN_SIGNAL_FW(VOpenCell[7])},
+    {"VCell[8]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 8, CAN_SIGNAL_FW(VCell[8])},
+    {"BBalancingCell[8]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 8, CAN_SIGNAL_FW(BBalancingCell[8])},
+    {"RCell[8]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 8, CAN_SIGNAL_FW(RCell[8])},
+    {"VOpenCell[8]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 8, CAN_SIGNAL_FW(VOpenCell[8])},
+    {"VCell[9]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 9, CAN_SIGNAL_FW(VCell[9])},
+    {"BBalancingCell[9]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 9, CAN_SIGNAL_FW(BBalancingCell[9])},
+    {"RCell[9]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 9, CAN_SIGNAL_FW(RCell[9])},
+    {"VOpenCell[9]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 9, CAN_SIGNAL_FW(VOpenCell[9])},
+    {"VCell[10]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 10, CAN_SIGNAL_FW(VCell[10])},
+    {"BBalancingCell[10]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 10, CAN_SIGNAL_FW(BBalancingCell[10])},
+    {"RCell[10]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 10, CAN_SIGNAL_FW(RCell[10])},
+    {"VOpenCell[10]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 10, CAN_SIGNAL_FW(VOpenCell[10])},
+    {"VCell[11]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 11, CAN_SIGNAL_FW(VCell[11])},
+    {"BBalancingCell[11]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 11, CAN_SIGNAL_FW(BBalancingCell[11])},
+    {"RCell[11]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 11, CAN_SIGNAL_FW(RCell[11])},
+    {"VOpenCell[11]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 11, CAN_SIGNAL_FW(VOpenCell[11])},
+    {"VCell[12]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 12, CAN_SIGNAL_FW(VCell[12])},
+    {"BBalancingCell[12]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 12, CAN_SIGNAL_FW(BBalancingCell[12])},
+    {"RCell[12]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 12, CAN_SIGNAL_FW(RCell[12])},
+    {"VOpenCell[12]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 12, CAN_SIGNAL_FW(VOpenCell[12])},
+    {"VCell[13]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 13, CAN_SIGNAL_FW(VCell[13])},
+    {"BBalancingCell[13]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 13, CAN_SIGNAL_FW(BBalancingCell[13])},
+    {"RCell[13]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 13, CAN_SIGNAL_FW(RCell[13])},
+    {"VOpenCell[13]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 13, CAN_SIGNAL_FW(VOpenCell[13])},
+    {"VCell[14]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 14, CAN_SIGNAL_FW(VCell[14])},
+    {"BBalancingCell[14]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 14, CAN_SIGNAL_FW(BBalancingCell[14])},
+    {"RCell[14]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 14, CAN_SIGNAL_FW(RCell[14])},
+    {"VOpenCell[14]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 14, CAN_SIGNAL_FW(VOpenCell[14])},
+    {"VCell[15]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 15, CAN_SIGNAL_FW(VCell[15])},
+    {"BBalancingCell[15]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 15, CAN_SIGNAL_FW(BBalancingCell[15])},
+    {"RCell[15]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 15, CAN_SIGNAL_FW(RCell[15])},
+    {"VOpenCell[15]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 15, CAN_SIGNAL_FW(VOpenCell[15])},
+    {"VCell[16]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 16, CAN_SIGNAL_FW(VCell[16])},
+    {"BBalancingCell[16]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 16, CAN_SIGNAL_FW(BBalancingCell[16])},
+    {"RCell[16]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 16, CAN_SIGNAL_FW(RCell[16])},
+    {"VOpenCell[16]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 16, CAN_SIGNAL_FW(VOpenCell[16])},
+    {"VCell[17]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 17, CAN_SIGNAL_FW(VCell[17])},
+    {"BBalancingCell[17]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 17, CAN_SIGNAL_FW(BBalancingCell[17])},
+    {"RCell[17]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 17, CAN_SIGNAL_FW(RCell[17])},
+    {"VOpenCell[17]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 17, CAN_SIGNAL_FW(VOpenCell[17])},
+    {"VCell[18]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 18, CAN_SIGNAL_FW(VCell[18])},
+    {"BBalancingCell[18]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 18, CAN_SIGNAL_FW(BBalancingCell[18])},
+    {"RCell[18]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 18, CAN_SIGNAL_FW(RCell[18])},
+    {"VOpenCell[18]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 18, CAN_SIGNAL_FW(VOpenCell[18])},
+    {"VCell[19]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 19, CAN_SIGNAL_FW(VCell[19])},
+    {"BBalancingCell[19]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 19, CAN_SIGNAL_FW(BBalancingCell[19])},
+    {"RCell[19]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 19, CAN_SIGNAL_FW(RCell[19])},
+    {"VOpenCell[19]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 19, CAN_SIGNAL_FW(VOpenCell[19])},
+    {"VCell[20]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 20, CAN_SIGNAL_FW(VCell[20])},
+    {"BBalancingCell[20]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 20, CAN_SIGNAL_FW(BBalancingCell[20])},
+    {"RCell[20]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 20, CAN_SIGNAL_FW(RCell[20])},
+    {"VOpenCell[20]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 20, CAN_SIGNAL_FW(VOpenCell[20])},
+    {"VCell[21]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 21, CAN_SIGNAL_FW(VCell[21])},
+    {"BBalancingCell[21]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 21, CAN_SIGNAL_FW(BBalancingCell[21])},
+    {"RCell[21]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 21, CAN_SIGNAL_FW(RCell[21])},
+    {"VOpenCell[21]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 21, CAN_SIGNAL_FW(VOpenCell[21])},
+    {"VCell[22]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 22, CAN_SIGNAL_FW(VCell[22])},
+    {"BBalancingCell[22]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 22, CAN_SIGNAL_FW(BBalancingCell[22])},
+    {"RCell[22]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 22, CAN_SIGNAL_FW(RCell[22])},
+    {"VOpenCell[22]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 22, CAN_SIGNAL_FW(VOpenCell[22])},
+    {"VCell[23]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 23, CAN_SIGNAL_FW(VCell[23])},
+    {"BBalancingCell[23]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 23, CAN_SIGNAL_FW(BBalancingCell[23])},
+    {"RCell[23]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 23, CAN_SIGNAL_FW(RCell[23])},
+    {"VOpenCell[23]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 23, CAN_SIGNAL_FW(VOpenCell[23])},
+    {"VCell[24]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 24, CAN_SIGNAL_FW(VCell[24])},
+    {"BBalancingCell[24]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 24, CAN_SIGNAL_FW(BBalancingCell[24])},
+    {"RCell[24]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 24, CAN_SIGNAL_FW(RCell[24])},
+    {"VOpenCell[24]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 24, CAN_SIGNAL_FW(VOpenCell[24])},
+    {"VCell[25]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 25, CAN_SIGNAL_FW(VCell[25])},
+    {"BBalancingCell[25]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 25, CAN_SIGNAL_FW(BBalancingCell[25])},
+    {"RCell[25]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 25, CAN_SIGNAL_FW(RCell[25])},
+    {"VOpenCell[25]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 25, CAN_SIGNAL_FW(VOpenCell[25])},
+    {"VCell[26]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 26, CAN_SIGNAL_FW(VCell[26])},
+    {"BBalancingCell[26]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 26, CAN_SIGNAL_FW(BBalancingCell[26])},
+    {"RCell[26]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 26, CAN_SIGNAL_FW(RCell[26])},
+    {"VOpenCell[26]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 26, CAN_SIGNAL_FW(VOpenCell[26])},
+    {"VCell[27]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 27, CAN_SIGNAL_FW(VCell[27])},
+    {"BBalancingCell[27]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 27, CAN_SIGNAL_FW(BBalancingCell[27])},
+    {"RCell[27]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 27, CAN_SIGNAL_FW(RCell[27])},
+    {"VOpenCell[27]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 27, CAN_SIGNAL_FW(VOpenCell[27])},
+    {"VCell[28]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 28, CAN_SIGNAL_FW(VCell[28])},
+    {"BBalancingCell[28]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 28, CAN_SIGNAL_FW(BBalancingCell[28])},
+    {"RCell[28]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 28, CAN_SIGNAL_FW(RCell[28])},
+    {"VOpenCell[28]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 28, CAN_SIGNAL_FW(VOpenCell[28])},
+    {"VCell[29]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 29, CAN_SIGNAL_FW(VCell[29])},
+    {"BBalancingCell[29]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 29, CAN_SIGNAL_FW(BBalancingCell[29])},
+    {"RCell[29]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 29, CAN_SIGNAL_FW(RCell[29])},
+    {"VOpenCell[29]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 29, CAN_SIGNAL_FW(VOpenCell[29])},
+    {"VCell[30]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 30, CAN_SIGNAL_FW(VCell[30])},
+    {"BBalancingCell[30]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 30, CAN_SIGNAL_FW(BBalancingCell[30])},
+    {"RCell[30]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 30, CAN_SIGNAL_FW(RCell[30])},
+    {"VOpenCell[30]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 30, CAN_SIGNAL_FW(VOpenCell[30])},
+    {"VCell[31]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 31, CAN_SIGNAL_FW(VCell[31])},
+    {"BBalancingCell[31]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 31, CAN_SIGNAL_FW(BBalancingCell[31])},
+    {"RCell[31]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 31, CAN_SIGNAL_FW(RCell[31])},
+    {"VOpenCell[31]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 31, CAN_SIGNAL_FW(VOpenCell[31])},
+    {"VCell[32]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 32, CAN_SIGNAL_FW(VCell[32])},
+    {"BBalancingCell[32]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 32, CAN_SIGNAL_FW(BBalancingCell[32])},
+    {"RCell[32]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 32, CAN_SIGNAL_FW(RCell[32])},
+    {"VOpenCell[32]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 32, CAN_SIGNAL_FW(VOpenCell[32])},
+    {"VCell[33]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 33, CAN_SIGNAL_FW(VCell[33])},
+    {"BBalancingCell[33]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 33, CAN_SIGNAL_FW(BBalancingCell[33])},
+    {"RCell[33]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 33, CAN_SIGNAL_FW(RCell[33])},
+    {"VOpenCell[33]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 33, CAN_SIGNAL_FW(VOpenCell[33])},
+    {"VCell[34]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 34, CAN_SIGNAL_FW(VCell[34])},
+    {"BBalancingCell[34]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 34, CAN_SIGNAL_FW(BBalancingCell[34])},
+    {"RCell[34]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 34, CAN_SIGNAL_FW(RCell[34])},
+    {"VOpenCell[34]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 34, CAN_SIGNAL_FW(VOpenCell[34])},
+    {"VCell[35]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 35, CAN_SIGNAL_FW(VCell[35])},
+    {"BBalancingCell[35]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 35, CAN_SIGNAL_FW(BBalancingCell[35])},
+    {"RCell[35]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 35, CAN_SIGNAL_FW(RCell[35])},
+    {"VOpenCell[35]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 35, CAN_SIGNAL_FW(VOpenCell[35])},
+    {"VCell[36]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 36, CAN_SIGNAL_FW(VCell[36])},
+    {"BBalancingCell[36]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 36, CAN_SIGNAL_FW(BBalancingCell[36])},
+    {"RCell[36]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 36, CAN_SIGNAL_FW(RCell[36])},
+    {"VOpenCell[36]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 36, CAN_SIGNAL_FW(VOpenCell[36])},
+    {"VCell[37]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 37, CAN_SIGNAL_FW(VCell[37])},
+    {"BBalancingCell[37]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 37, CAN_SIGNAL_FW(BBalancingCell[37])},
+    {"RCell[37]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 37, CAN_SIGNAL_FW(RCell[37])},
+    {"VOpenCell[37]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 37, CAN_SIGNAL_FW(VOpenCell[37])},
+    {"VCell[38]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 38, CAN_SIGNAL_FW(VCell[38])},
+    {"BBalancingCell[38]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 38, CAN_SIGNAL_FW(BBalancingCell[38])},
+    {"RCell[38]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 38, CAN_SIGNAL_FW(RCell[38])},
+    {"VOpenCell[38]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 38, CAN_SIGNAL_FW(VOpenCell[38])},
+    {"VCell[39]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 39, CAN_SIGNAL_FW(VCell[39])},
+    {"BBalancingCell[39]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 39, CAN_SIGNAL_FW(BBalancingCell[39])},
+    {"RCell[39]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 39, CAN_SIGNAL_FW(RCell[39])},
+    {"VOpenCell[39]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 39, CAN_SIGNAL_FW(VOpenCell[39])},
+    {"VCell[40]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 40, CAN_SIGNAL_FW(VCell[40])},
+    {"BBalancingCell[40]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 40, CAN_SIGNAL_FW(BBalancingCell[40])},
+    {"RCell[40]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 40, CAN_SIGNAL_FW(RCell[40])},
+    {"VOpenCell[40]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 40, CAN_SIGNAL_FW(VOpenCell[40])},
+    {"VCell[41]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 41, CAN_SIGNAL_FW(VCell[41])},
+    {"BBalancingCell[41]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 41, CAN_SIGNAL_FW(BBalancingCell[41])},
+    {"RCell[41]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 41, CAN_SIGNAL_FW(RCell[41])},
+    {"VOpenCell[41]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 41, CAN_SIGNAL_FW(VOpenCell[41])},
+    {"VCell[42]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 42, CAN_SIGNAL_FW(VCell[42])},
+    {"BBalancingCell[42]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 42, CAN_SIGNAL_FW(BBalancingCell[42])},
+    {"RCell[42]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 42, CAN_SIGNAL_FW(RCell[42])},
+    {"VOpenCell[42]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 42, CAN_SIGNAL_FW(VOpenCell[42])},
+    {"VCell[43]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 43, CAN_SIGNAL_FW(VCell[43])},
+    {"BBalancingCell[43]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 43, CAN_SIGNAL_FW(BBalancingCell[43])},
+    {"RCell[43]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 43, CAN_SIGNAL_FW(RCell[43])},
+    {"VOpenCell[43]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 43, CAN_SIGNAL_FW(VOpenCell[43])},
+    {"VCell[44]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 44, CAN_SIGNAL_FW(VCell[44])},
+    {"BBalancingCell[44]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 44, CAN_SIGNAL_FW(BBalancingCell[44])},
+    {"RCell[44]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 44, CAN_SIGNAL_FW(RCell[44])},
+    {"VOpenCell[44]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 44, CAN_SIGNAL_FW(VOpenCell[44])},
+    {"VCell[45]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 45, CAN_SIGNAL_FW(VCell[45])},
+    {"BBalancingCell[45]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 45, CAN_SIGNAL_FW(BBalancingCell[45])},
+    {"RCell[45]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 45, CAN_SIGNAL_FW(RCell[45])},
+    {"VOpenCell[45]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 45, CAN_SIGNAL_FW(VOpenCell[45])},
+    {"VCell[46]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 46, CAN_SIGNAL_FW(VCell[46])},
+    {"BBalancingCell[46]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 46, CAN_SIGNAL_FW(BBalancingCell[46])},
+    {"RCell[46]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 46, CAN_SIGNAL_FW(RCell[46])},
+    {"VOpenCell[46]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 46, CAN_SIGNAL_FW(VOpenCell[46])},
+    {"VCell[47]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 47, CAN_SIGNAL_FW(VCell[47])},
+    {"BBalancingCell[47]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 47, CAN_SIGNAL_FW(BBalancingCell[47])},
+    {"RCell[47]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 47, CAN_SIGNAL_FW(RCell[47])},
+    {"VOpenCell[47]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 47, CAN_SIGNAL_FW(VOpenCell[47])},
+    {"VCell[48]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 48, CAN_SIGNAL_FW(VCell[48])},
+    {"BBalancingCell[48]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 48, CAN_SIGNAL_FW(BBalancingCell[48])},
+    {"RCell[48]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 48, CAN_SIGNAL_FW(RCell[48])},
+    {"VOpenCell[48]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 48, CAN_SIGNAL_FW(VOpenCell[48])},
+    {"VCell[49]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 49, CAN_SIGNAL_FW(VCell[49])},
+    {"BBalancingCell[49]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 49, CAN_SIGNAL_FW(BBalancingCell[49])},
+    {"RCell[49]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 49, CAN_SIGNAL_FW(RCell[49])},
+    {"VOpenCell[49]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 49, CAN_SIGNAL_FW(VOpenCell[49])},
+    {"VCell[50]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 50, CAN_SIGNAL_FW(VCell[50])},
+    {"BBalancingCell[50]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 50, CAN_SIGNAL_FW(BBalancingCell[50])},
+    {"RCell[50]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 50, CAN_SIGNAL_FW(RCell[50])},
+    {"VOpenCell[50]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 50, CAN_SIGNAL_FW(VOpenCell[50])},
+    {"VCell[51]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 51, CAN_SIGNAL_FW(VCell[51])},
+    {"BBalancingCell[51]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 51, CAN_SIGNAL_FW(BBalancingCell[51])},
+    {"RCell[51]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 51, CAN_SIGNAL_FW(RCell[51])},
+    {"VOpenCell[51]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 51, CAN_SIGNAL_FW(VOpenCell[51])},
+    {"VCell[52]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 52, CAN_SIGNAL_FW(VCell[52])},
+    {"BBalancingCell[52]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 52, CAN_SIGNAL_FW(BBalancingCell[52])},
+    {"RCell[52]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 52, CAN_SIGNAL_FW(RCell[52])},
+    {"VOpenCell[52]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 52, CAN_SIGNAL_FW(VOpenCell[52])},
+    {"VCell[53]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 53, CAN_SIGNAL_FW(VCell[53])},
+    {"BBalancingCell[53]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 53, CAN_SIGNAL_FW(BBalancingCell[53])},
+    {"RCell[53]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 53, CAN_SIGNAL_FW(RCell[53])},
+    {"VOpenCell[53]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 53, CAN_SIGNAL_FW(VOpenCell[53])},
+    {"VCell[54]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 54, CAN_SIGNAL_FW(VCell[54])},
+    {"BBalancingCell[54]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 54, CAN_SIGNAL_FW(BBalancingCell[54])},
+    {"RCell[54]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 54, CAN_SIGNAL_FW(RCell[54])},
+    {"VOpenCell[54]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 54, CAN_SIGNAL_FW(VOpenCell[54])},
+    {"VCell[55]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 55, CAN_SIGNAL_FW(VCell[55])},
+    {"BBalancingCell[55]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 55, CAN_SIGNAL_FW(BBalancingCell[55])},
+    {"RCell[55]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 55, CAN_SIGNAL_FW(RCell[55])},
+    {"VOpenCell[55]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 55, CAN_SIGNAL_FW(VOpenCell[55])},
+    {"VCell[56]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 56, CAN_SIGNAL_FW(VCell[56])},
+    {"BBalancingCell[56]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 56, CAN_SIGNAL_FW(BBalancingCell[56])},
+    {"RCell[56]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 56, CAN_SIGNAL_FW(RCell[56])},
+    {"VOpenCell[56]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 56, CAN_SIGNAL_FW(VOpenCell[56])},
+    {"VCell[57]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 57, CAN_SIGNAL_FW(VCell[57])},
+    {"BBalancingCell[57]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 57, CAN_SIGNAL_FW(BBalancingCell[57])},
+    {"RCell[57]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 57, CAN_SIGNAL_FW(RCell[57])},
+    {"VOpenCell[57]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 57, CAN_SIGNAL_FW(VOpenCell[57])},
+    {"VCell[58]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 58, CAN_SIGNAL_FW(VCell[58])},
+    {"BBalancingCell[58]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 58, CAN_SIGNAL_FW(BBalancingCell[58])},
+    {"RCell[58]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 58, CAN_SIGNAL_FW(RCell[58])},
+    {"VOpenCell[58]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 58, CAN_SIGNAL_FW(VOpenCell[58])},
+    {"VCell[59]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 59, CAN_SIGNAL_FW(VCell[59])},
+    {"BBalancingCell[59]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 59, CAN_SIGNAL_FW(BBalancingCell[59])},
+    {"RCell[59]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 59, CAN_SIGNAL_FW(RCell[59])},
+    {"VOpenCell[59]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 59, CAN_SIGNAL_FW(VOpenCell[59])},
+    {"VCell[60]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 60, CAN_SIGNAL_FW(VCell[60])},
+    {"BBalancingCell[60]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 60, CAN_SIGNAL_FW(BBalancingCell[60])},
+    {"RCell[60]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 60, CAN_SIGNAL_FW(RCell[60])},
+    {"VOpenCell[60]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 60, CAN_SIGNAL_FW(VOpenCell[60])},
+    {"VCell[61]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 61, CAN_SIGNAL_FW(VCell[61])},
+    {"BBalancingCell[61]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 61, CAN_SIGNAL_FW(BBalancingCell[61])},
+    {"RCell[61]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 61, CAN_SIGNAL_FW(RCell[61])},
+    {"VOpenCell[61]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 61, CAN_SIGNAL_FW(VOpenCell[61])},
+    {"VCell[62]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 62, CAN_SIGNAL_FW(VCell[62])},
+    {"BBalancingCell[62]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 62, CAN_SIGNAL_FW(BBalancingCell[62])},
+    {"RCell[62]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 62, CAN_SIGNAL_FW(RCell[62])},
+    {"VOpenCell[62]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 62, CAN_SIGNAL_FW(VOpenCell[62])},
+    {"VCell[63]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 63, CAN_SIGNAL_FW(VCell[63])},
+    {"BBalancingCell[63]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 63, CAN_SIGNAL_FW(BBalancingCell[63])},
+    {"RCell[63]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 63, CAN_SIGNAL_FW(RCell[63])},
+    {"VOpenCell[63]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 63, CAN_SIGNAL_FW(VOpenCell[63])},
+    {"VCell[64]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 64, CAN_SIGNAL_FW(VCell[64])},
+    {"BBalancingCell[64]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 64, CAN_SIGNAL_FW(BBalancingCell[64])},
+    {"RCell[64]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 64, CAN_SIGNAL_FW(RCell[64])},
+    {"VOpenCell[64]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 64, CAN_SIGNAL_FW(VOpenCell[64])},
+    {"VCell[65]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 65, CAN_SIGNAL_FW(VCell[65])},
+    {"BBalancingCell[65]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 65, CAN_SIGNAL_FW(BBalancingCell[65])},
+    {"RCell[65]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 65, CAN_SIGNAL_FW(RCell[65])},
+    {"VOpenCell[65]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 65, CAN_SIGNAL_FW(VOpenCell[65])},
+    {"VCell[66]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 66, CAN_SIGNAL_FW(VCell[66])},
+    {"BBalancingCell[66]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 66, CAN_SIGNAL_FW(BBalancingCell[66])},
+    {"RCell[66]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 66, CAN_SIGNAL_FW(RCell[66])},
+    {"VOpenCell[66]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 66, CAN_SIGNAL_FW(VOpenCell[66])},
+    {"VCell[67]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 67, CAN_SIGNAL_FW(VCell[67])},
+    {"BBalancingCell[67]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 67, CAN_SIGNAL_FW(BBalancingCell[67])},
+    {"RCell[67]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 67, CAN_SIGNAL_FW(RCell[67])},
+    {"VOpenCell[67]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 67, CAN_SIGNAL_FW(VOpenCell[67])},
+    {"VCell[68]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 68, CAN_SIGNAL_FW(VCell[68])},
+    {"BBalancingCell[68]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 68, CAN_SIGNAL_FW(BBalancingCell[68])},
+    {"RCell[68]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 68, CAN_SIGNAL_FW(RCell[68])},
+    {"VOpenCell[68]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 68, CAN_SIGNAL_FW(VOpenCell[68])},
+    {"VCell[69]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 69, CAN_SIGNAL_FW(VCell[69])},
+    {"BBalancingCell[69]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 69, CAN_SIGNAL_FW(BBalancingCell[69])},
+    {"RCell[69]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 69, CAN_SIGNAL_FW(RCell[69])},
+    {"VOpenCell[69]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 69, CAN_SIGNAL_FW(VOpenCell[69])},
+    {"VCell[70]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 70, CAN_SIGNAL_FW(VCell[70])},
+    {"BBalancingCell[70]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 70, CAN_SIGNAL_FW(BBalancingCell[70])},
+    {"RCell[70]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 70, CAN_SIGNAL_FW(RCell[70])},
+    {"VOpenCell[70]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 70, CAN_SIGNAL_FW(VOpenCell[70])},
+    {"VCell[71]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 71, CAN_SIGNAL_FW(VCell[71])},
+    {"BBalancingCell[71]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 71, CAN_SIGNAL_FW(BBalancingCell[71])},
+    {"RCell[71]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 71, CAN_SIGNAL_FW(RCell[71])},
+    {"VOpenCell[71]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 71, CAN_SIGNAL_FW(VOpenCell[71])},
+    {"VCell[72]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 72, CAN_SIGNAL_FW(VCell[72])},
+    {"BBalancingCell[72]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 72, CAN_SIGNAL_FW(BBalancingCell[72])},
+    {"RCell[72]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 72, CAN_SIGNAL_FW(RCell[72])},
+    {"VOpenCell[72]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 72, CAN_SIGNAL_FW(VOpenCell[72])},
+    {"VCell[73]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 73, CAN_SIGNAL_FW(VCell[73])},
+    {"BBalancingCell[73]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 73, CAN_SIGNAL_FW(BBalancingCell[73])},
+    {"RCell[73]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 73, CAN_SIGNAL_FW(RCell[73])},
+    {"VOpenCell[73]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 73, CAN_SIGNAL_FW(VOpenCell[73])},
+    {"VCell[74]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 74, CAN_SIGNAL_FW(VCell[74])},
+    {"BBalancingCell[74]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 74, CAN_SIGNAL_FW(BBalancingCell[74])},
+    {"RCell[74]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 74, CAN_SIGNAL_FW(RCell[74])},
+    {"VOpenCell[74]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 74, CAN_SIGNAL_FW(VOpenCell[74])},
+    {"VCell[75]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 75, CAN_SIGNAL_FW(VCell[75])},
+    {"BBalancingCell[75]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 75, CAN_SIGNAL_FW(BBalancingCell[75])},
+    {"RCell[75]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 75, CAN_SIGNAL_FW(RCell[75])},
+    {"VOpenCell[75]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 75, CAN_SIGNAL_FW(VOpenCell[75])},
+    {"VCell[76]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 76, CAN_SIGNAL_FW(VCell[76])},
+    {"BBalancingCell[76]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 76, CAN_SIGNAL_FW(BBalancingCell[76])},
+    {"RCell[76]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 76, CAN_SIGNAL_FW(RCell[76])},
+    {"VOpenCell[76]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 76, CAN_SIGNAL_FW(VOpenCell[76])},
+    {"VCell[77]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 77, CAN_SIGNAL_FW(VCell[77])},
+    {"BBalancingCell[77]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 77, CAN_SIGNAL_FW(BBalancingCell[77])},
+    {"RCell[77]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 77, CAN_SIGNAL_FW(RCell[77])},
+    {"VOpenCell[77]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 77, CAN_SIGNAL_FW(VOpenCell[77])},
+    {"VCell[78]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 78, CAN_SIGNAL_FW(VCell[78])},
+    {"BBalancingCell[78]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 78, CAN_SIGNAL_FW(BBalancingCell[78])},
+    {"RCell[78]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 78, CAN_SIGNAL_FW(RCell[78])},
+    {"VOpenCell[78]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 78, CAN_SIGNAL_FW(VOpenCell[78])},
+    {"VCell[79]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 79, CAN_SIGNAL_FW(VCell[79])},
+    {"BBalancingCell[79]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 79, CAN_SIGNAL_FW(BBalancingCell[79])},
+    {"RCell[79]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 79, CAN_SIGNAL_FW(RCell[79])},
+    {"VOpenCell[79]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 79, CAN_SIGNAL_FW(VOpenCell[79])},
+    {"VCell[80]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 80, CAN_SIGNAL_FW(VCell[80])},
+    {"BBalancingCell[80]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 80, CAN_SIGNAL_FW(BBalancingCell[80])},
+    {"RCell[80]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 80, CAN_SIGNAL_FW(RCell[80])},
+    {"VOpenCell[80]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 80, CAN_SIGNAL_FW(VOpenCell[80])},
+    {"VCell[81]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 81, CAN_SIGNAL_FW(VCell[81])},
+    {"BBalancingCell[81]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 81, CAN_SIGNAL_FW(BBalancingCell[81])},
+    {"RCell[81]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 81, CAN_SIGNAL_FW(RCell[81])},
+    {"VOpenCell[81]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 81, CAN_SIGNAL_FW(VOpenCell[81])},
+    {"VCell[82]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 82, CAN_SIGNAL_FW(VCell[82])},
+    {"BBalancingCell[82]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 82, CAN_SIGNAL_FW(BBalancingCell[82])},
+    {"RCell[82]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 82, CAN_SIGNAL_FW(RCell[82])},
+    {"VOpenCell[82]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 82, CAN_SIGNAL_FW(VOpenCell[82])},
+    {"VCell[83]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 83, CAN_SIGNAL_FW(VCell[83])},
+    {"BBalancingCell[83]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 83, CAN_SIGNAL_FW(BBalancingCell[83])},
+    {"RCell[83]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 83, CAN_SIGNAL_FW(RCell[83])},
+    {"VOpenCell[83]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 83, CAN_SIGNAL_FW(VOpenCell[83])},
+    {"VCell[84]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 84, CAN_SIGNAL_FW(VCell[84])},
+    {"BBalancingCell[84]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 84, CAN_SIGNAL_FW(BBalancingCell[84])},
+    {"RCell[84]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 84, CAN_SIGNAL_FW(RCell[84])},
+    {"VOpenCell[84]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 84, CAN_SIGNAL_FW(VOpenCell[84])},
+    {"VCell[85]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 85, CAN_SIGNAL_FW(VCell[85])},
+    {"BBalancingCell[85]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 85, CAN_SIGNAL_FW(BBalancingCell[85])},
+    {"RCell[85]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 85, CAN_SIGNAL_FW(RCell[85])},
+    {"VOpenCell[85]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 85, CAN_SIGNAL_FW(VOpenCell[85])},
+    {"VCell[86]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 86, CAN_SIGNAL_FW(VCell[86])},
+    {"BBalancingCell[86]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 86, CAN_SIGNAL_FW(BBalancingCell[86])},
+    {"RCell[86]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 86, CAN_SIGNAL_FW(RCell[86])},
+    {"VOpenCell[86]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 86, CAN_SIGNAL_FW(VOpenCell[86])},
+    {"VCell[87]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 87, CAN_SIGNAL_FW(VCell[87])},
+    {"BBalancingCell[87]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 87, CAN_SIGNAL_FW(BBalancingCell[87])},
+    {"RCell[87]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 87, CAN_SIGNAL_FW(RCell[87])},
+    {"VOpenCell[87]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 87, CAN_SIGNAL_FW(VOpenCell[87])},
+    {"VCell[88]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 88, CAN_SIGNAL_FW(VCell[88])},
+    {"BBalancingCell[88]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 88, CAN_SIGNAL_FW(BBalancingCell[88])},
+    {"RCell[88]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 88, CAN_SIGNAL_FW(RCell[88])},
+    {"VOpenCell[88]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 88, CAN_SIGNAL_FW(VOpenCell[88])},
+    {"VCell[89]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 89, CAN_SIGNAL_FW(VCell[89])},
+    {"BBalancingCell[89]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 89, CAN_SIGNAL_FW(BBalancingCell[89])},
+    {"RCell[89]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 89, CAN_SIGNAL_FW(RCell[89])},
+    {"VOpenCell[89]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 89, CAN_SIGNAL_FW(VOpenCell[89])},
+    {"VCell[90]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 90, CAN_SIGNAL_FW(VCell[90])},
+    {"BBalancingCell[90]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 90, CAN_SIGNAL_FW(BBalancingCell[90])},
+    {"RCell[90]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 90, CAN_SIGNAL_FW(RCell[90])},
+    {"VOpenCell[90]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 90, CAN_SIGNAL_FW(VOpenCell[90])},
+    {"VCell[91]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 91, CAN_SIGNAL_FW(VCell[91])},
+    {"BBalancingCell[91]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 91, CAN_SIGNAL_FW(BBalancingCell[91])},
+    {"RCell[91]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 91, CAN_SIGNAL_FW(RCell[91])},
+    {"VOpenCell[91]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 91, CAN_SIGNAL_FW(VOpenCell[91])},
+    {"VCell[92]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 92, CAN_SIGNAL_FW(VCell[92])},
+    {"BBalancingCell[92]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 92, CAN_SIGNAL_FW(BBalancingCell[92])},
+    {"RCell[92]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 92, CAN_SIGNAL_FW(RCell[92])},
+    {"VOpenCell[92]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 92, CAN_SIGNAL_FW(VOpenCell[92])},
+    {"VCell[93]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 93, CAN_SIGNAL_FW(VCell[93])},
+    {"BBalancingCell[93]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 93, CAN_SIGNAL_FW(BBalancingCell[93])},
+    {"RCell[93]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 93, CAN_SIGNAL_FW(RCell[93])},
+    {"VOpenCell[93]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 93, CAN_SIGNAL_FW(VOpenCell[93])},
+    {"VCell[94]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 94, CAN_SIGNAL_FW(VCell[94])},
+    {"BBalancingCell[94]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 94, CAN_SIGNAL_FW(BBalancingCell[94])},
+    {"RCell[94]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 94, CAN_SIGNAL_FW(RCell[94])},
+    {"VOpenCell[94]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 94, CAN_SIGNAL_FW(VOpenCell[94])},
+    {"VCell[95]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 95, CAN_SIGNAL_FW(VCell[95])},
+    {"BBalancingCell[95]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 95, CAN_SIGNAL_FW(BBalancingCell[95])},
+    {"RCell[95]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 95, CAN_SIGNAL_FW(RCell[95])},
+    {"VOpenCell[95]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 95, CAN_SIGNAL_FW(VOpenCell[95])},
+    {"VCell[96]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 96, CAN_SIGNAL_FW(VCell[96])},
+    {"BBalancingCell[96]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 96, CAN_SIGNAL_FW(BBalancingCell[96])},
+    {"RCell[96]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 96, CAN_SIGNAL_FW(RCell[96])},
+    {"VOpenCell[96]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 96, CAN_SIGNAL_FW(VOpenCell[96])},
+    {"VCell[97]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 97, CAN_SIGNAL_FW(VCell[97])},
+    {"BBalancingCell[97]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 97, CAN_SIGNAL_FW(BBalancingCell[97])},
+    {"RCell[97]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 97, CAN_SIGNAL_FW(RCell[97])},
+    {"VOpenCell[97]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 97, CAN_SIGNAL_FW(VOpenCell[97])},
+    {"VCell[98]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 98, CAN_SIGNAL_FW(VCell[98])},
+    {"BBalancingCell[98]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 98, CAN_SIGNAL_FW(BBalancingCell[98])},
+    {"RCell[98]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 98, CAN_SIGNAL_FW(RCell[98])},
+    {"VOpenCell[98]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 98, CAN_SIGNAL_FW(VOpenCell[98])},
+    {"VCell[99]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 99, CAN_SIGNAL_FW(VCell[99])},
+    {"BBalancingCell[99]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 99, CAN_SIGNAL_FW(BBalancingCell[99])},
+    {"RCell[99]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 99, CAN_SIGNAL_FW(RCell[99])},
+    {"VOpenCell[99]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 99, CAN_SIGNAL_FW(VOpenCell[99])},
+    {"VCell[100]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 100, CAN_SIGNAL_FW(VCell[100])},
+    {"BBalancingCell[100]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 100, CAN_SIGNAL_FW(BBalancingCell[100])},
+    {"RCell[100]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 100, CAN_SIGNAL_FW(RCell[100])},
+    {"VOpenCell[100]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 100, CAN_SIGNAL_FW(VOpenCell[100])},
+    {"VCell[101]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 101, CAN_SIGNAL_FW(VCell[101])},
+    {"BBalancingCell[101]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 101, CAN_SIGNAL_FW(BBalancingCell[101])},
+    {"RCell[101]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 101, CAN_SIGNAL_FW(RCell[101])},
+    {"VOpenCell[101]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 101, CAN_SIGNAL_FW(VOpenCell[101])},
+    {"VCell[102]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 102, CAN_SIGNAL_FW(VCell[102])},
+    {"BBalancingCell[102]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 102, CAN_SIGNAL_FW(BBalancingCell[102])},
+    {"RCell[102]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 102, CAN_SIGNAL_FW(RCell[102])},
+    {"VOpenCell[102]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 102, CAN_SIGNAL_FW(VOpenCell[102])},
+    {"VCell[103]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 103, CAN_SIGNAL_FW(VCell[103])},
+    {"BBalancingCell[103]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 103, CAN_SIGNAL_FW(BBalancingCell[103])},
+    {"RCell[103]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 103, CAN_SIGNAL_FW(RCell[103])},
+    {"VOpenCell[103]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 103, CAN_SIGNAL_FW(VOpenCell[103])},
+    {"VCell[104]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 104, CAN_SIGNAL_FW(VCell[104])},
+    {"BBalancingCell[104]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 104, CAN_SIGNAL_FW(BBalancingCell[104])},
+    {"RCell[104]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 104, CAN_SIGNAL_FW(RCell[104])},
+    {"VOpenCell[104]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 104, CAN_SIGNAL_FW(VOpenCell[104])},
+    {"VCell[105]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 105, CAN_SIGNAL_FW(VCell[105])},
+    {"BBalancingCell[105]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 105, CAN_SIGNAL_FW(BBalancingCell[105])},
+    {"RCell[105]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 105, CAN_SIGNAL_FW(RCell[105])},
+    {"VOpenCell[105]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 105, CAN_SIGNAL_FW(VOpenCell[105])},
+    {"VCell[106]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 106, CAN_SIGNAL_FW(VCell[106])},
+    {"BBalancingCell[106]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 106, CAN_SIGNAL_FW(BBalancingCell[106])},
+    {"RCell[106]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 106, CAN_SIGNAL_FW(RCell[106])},
+    {"VOpenCell[106]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 106, CAN_SIGNAL_FW(VOpenCell[106])},
+    {"VCell[107]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 107, CAN_SIGNAL_FW(VCell[107])},
+    {"BBalancingCell[107]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 107, CAN_SIGNAL_FW(BBalancingCell[107])},
+    {"RCell[107]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 107, CAN_SIGNAL_FW(RCell[107])},
+    {"VOpenCell[107]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 107, CAN_SIGNAL_FW(VOpenCell[107])},
+    {"VCell[108]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 108, CAN_SIGNAL_FW(VCell[108])},
+    {"BBalancingCell[108]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 108, CAN_SIGNAL_FW(BBalancingCell[108])},
+    {"RCell[108]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 108, CAN_SIGNAL_FW(RCell[108])},
+    {"VOpenCell[108]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 108, CAN_SIGNAL_FW(VOpenCell[108])},
+    {"VCell[109]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 109, CAN_SIGNAL_FW(VCell[109])},
+    {"BBalancingCell[109]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 109, CAN_SIGNAL_FW(BBalancingCell[109])},
+    {"RCell[109]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 109, CAN_SIGNAL_FW(RCell[109])},
+    {"VOpenCell[109]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 109, CAN_SIGNAL_FW(VOpenCell[109])},
+    {"VCell[110]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 110, CAN_SIGNAL_FW(VCell[110])},
+    {"BBalancingCell[110]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 110, CAN_SIGNAL_FW(BBalancingCell[110])},
+    {"RCell[110]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 110, CAN_SIGNAL_FW(RCell[110])},
+    {"VOpenCell[110]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 110, CAN_SIGNAL_FW(VOpenCell[110])},
+    {"VCell[111]", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 111, CAN_SIGNAL_FW(VCell[111])},
+    {"BBalancingCell[111]", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 111, CAN_SIGNAL_FW(BBalancingCell[111])},
+    {"RCell[111]", 30, 15, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, 111, CAN_SIGNAL_FW(RCell[111])},
+    {"VOpenCell[111]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 111, CAN_SIGNAL_FW(VOpenCell[111])},
+    /* IMDData (0x40) */
+    {"BIMDOff", 7, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BIMDOff)},
+    {"BIMDUnderVoltage", 6, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BIMDUnderVoltage)},
+    {"BIMDStarting", 5, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BIMDStarting)},
+    {"BIMDSSTGood", 4, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BIMDSSTGood)},
+    {"BIMDDeviceError", 3, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BIMDDeviceError)},
+    {"BIMDGroundConnectionFault", 2, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BIMDGroundConnectionFault)},
+    {"BIMDInvalidState", 1, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BIMDInvalidState)},
+    {"RIsolation", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 200.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(RIsolation)},
+    {"fIMDPWM", 24, 8, FALSE, eCAN_SIGNAL_FLOAT, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(fIMDPWM)},
+    {"rIMDPWM", 32, 8, FALSE, eCAN_SIGNAL_FLOAT, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(rIMDPWM)},
+    /* SetBrakeCurrent (0x44) */
+    {"CMD_TargetBrakeCurrent", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(CMD_TargetBrakeCurrent)},
+    /* SetERPM (0x64) */
+    {"CMD_TargetSpeed", 7, 32, TRUE, eCAN_SIGNAL_FLOAT, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(CMD_TargetSpeed)},
+    /* StatusAPPSSensor (0x81) */
+    {"rAPPs[0]", 0, 8, FALSE, eCAN_SIGNAL_FLOAT, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(rAPPs[0])},
+    {"rAPPs[1]", 8, 8, FALSE, eCAN_SIGNAL_FLOAT, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(rAPPs[1])},
+    {"rAPPsFinal", 16, 8, FALSE, eCAN_SIGNAL_FLOAT, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(rAPPsFinal)},
+    {"BThrottleOK", 27, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BThrottleOK)},
+    {"BAPPSFail[0]", 26, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BAPPSFail[0])},
+    {"BAPPSFail[1]", 25, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BAPPSFail[1])},
+    {"BAPPSDrift", 24, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BAPPSDrift)},
+    /* SetPosition (0x84) */
+    {"CMD_TargetPosition", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(CMD_TargetPosition)},
+    /* DynoPressuresRaw (0x90) */
+    {"VDynoPressureRaw[0]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(VDynoPressureRaw[0])},
+    {"VDynoPressureRaw[1]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(VDynoPressureRaw[1])},
+    {"VDynoPressureRaw[2]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(VDynoPressureRaw[2])},
+    {"VDynoCoolantFlowRaw", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(VDynoCoolantFlowRaw)},
+    /* DynoTempsRaw (0x91) */
+    {"VDynoTempRaw[0]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(VDynoTempRaw[0])},
+    {"VDynoTempRaw[1]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(VDynoTempRaw[1])},
+    {"VDynoTempRaw[2]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(VDynoTempRaw[2])},
+    /* DynoPressures (0x92) */
+    {"pDynoPressure[0]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0005f, -6.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(pDynoPressure[0])},
+    {"pDynoPressure[1]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0005f, -6.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(pDynoPressure[1])},
+    {"pDynoPressure[2]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0005f, -6.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(pDynoPressure[2])},
+    {"VDynoCoolantFlow", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 1e-05f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(VDynoCoolantFlow)},
+    /* DynoTemps (0x93) */
+    {"TDynoTemp[0]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.005f, -30.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TDynoTemp[0])},
+    {"TDynoTemp[1]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.005f, -30.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TDynoTemp[1])},
+    {"TDynoTemp[2]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.005f, -30.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TDynoTemp[2])},
+    /* DynoCooling (0x94) */
+    {"rDynoFanDutyManual", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.002f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(rDynoFanDutyManual)},
+    {"rDynoPumpDutyManual", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.002f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(rDynoPumpDutyManual)},
+    {"NDynoFanMode", 36, 4, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NDynoFanMode)},
+    {"NDynoPumpMode", 32, 4, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NDynoPumpMode)},
+    /* SetRelCurrent (0xA4) */
+    {"CMD_TargetRelativeCurrent", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(CMD_TargetRelativeCurrent)},
+    /* PDUStats1 (0xB0) */
+    {"rRadFanDuty", 0, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(rRadFanDuty)},
+    {"NRadFanMode", 12, 4, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NRadFanMode)},
+    {"IRadFan", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.001f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(IRadFan)},
+    {"rPumpDuty[0]", 27, 8, TRUE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(rPumpDuty[0])},
+    {"NPumpMode[0]", 32, 4, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NPumpMode[0])},
+    {"IPump[0]", 47, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.001f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(IPump[0])},
+    {"rPumpDuty[1]", 56, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(rPumpDuty[1])},
+    /* PDUStats2 (0xB1) */
+    {"NPumpMode[1]", 4, 4, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NPumpMode[1])},
+    {"IPump[1]", 3, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.001f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(IPump[1])},
+    {"rAccuFanDuty[0]", 19, 8, TRUE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(rAccuFanDuty[0])},
+    {"NAccuFanMode[0]", 24, 4, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NAccuFanMode[0])},
+    {"IAccuFan[0]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.001f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(IAccuFan[0])},
+    {"rAccuFanDuty[1]", 48, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(rAccuFanDuty[1])},
+    {"NAccuFanMode[1]", 60, 4, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NAccuFanMode[1])},
+    /* PDUStats3 (0xB2) */
+    {"IAccuFan[1]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.001f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(IAccuFan[1])},
+    {"IHorn", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.001f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(IHorn)},
+    /* SetRelBrakeCurrent (0xC4) */
+    {"CMD_TargeRelativeBrakeCurrent", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(CMD_TargeRelativeBrakeCurrent)},
+    /* SetDigOutput (0xE4) */
+    {"CMD_SetDigOutput[3]", 3, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(CMD_SetDigOutput[3])},
+    {"CMD_SetDigOutput[2]", 2, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(CMD_SetDigOutput[2])},
+    {"CMD_SetDigOutput[1]", 1, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(CMD_SetDigOutput[1])},
+    {"CMD_SetDigOutput[0]", 0, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(CMD_SetDigOutput[0])},
+    /* SetMaxAcCurrent (0x104) */
+    {"CMD_MaxAcCurrent", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(CMD_MaxAcCurrent)},
+    /* SetMaxAcBrakeCurrent (0x124) */
+    {"CMD_MaxAcBrakeCurrent", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(CMD_MaxAcBrakeCurrent)},
+    /* SetMaxDcCurrent (0x144) */
+    {"CMD_MaxDcCurrent", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(CMD_MaxDcCurrent)},
+    /* SetMaxDcBrakeCurrent (0x164) */
+    {"CMD_MaxDcBrakeCurrent", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(CMD_MaxDcBrakeCurrent)},
+    /* SetDriveEnable (0x184) */
+    {"CMD_DriveEnable", 0, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(CMD_DriveEnable)},
+    /* FRTireTemp1 (0x200) */
+    {"TFRTireChannel[0]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFRTireChannel[0])},
+    {"TFRTireChannel[1]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFRTireChannel[1])},
+    {"TFRTireChannel[2]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFRTireChannel[2])},
+    {"TFRTireChannel[3]", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFRTireChannel[3])},
+    /* FRTireTemp2 (0x201) */
+    {"TFRTireChannel[4]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFRTireChannel[4])},
+    {"TFRTireChannel[5]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFRTireChannel[5])},
+    {"TFRTireChannel[6]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFRTireChannel[6])},
+    {"TFRTireChannel[7]", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFRTireChannel[7])},
+    /* FRTireTemp3 (0x202) */
+    {"TFRTireChannel[8]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFRTireChannel[8])},
+    {"TFRTireChannel[9]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFRTireChannel[9])},
+    {"TFRTireChannel[10]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFRTireChannel[10])},
+    {"TFRTireChannel[11]", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFRTireChannel[11])},
+    /* FRTireTemp4 (0x203) */
+    {"TFRTireChannel[12]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFRTireChannel[12])},
+    {"TFRTireChannel[13]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFRTireChannel[13])},
+    {"TFRTireChannel[14]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFRTireChannel[14])},
+    {"TFRTireChannel[15]", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFRTireChannel[15])},
+    /* FLTireTemp1 (0x204) */
+    {"TFLTireChannel[0]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFLTireChannel[0])},
+    {"TFLTireChannel[1]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFLTireChannel[1])},
+    {"TFLTireChannel[2]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFLTireChannel[2])},
+    {"TFLTireChannel[3]", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFLTireChannel[3])},
+    /* FLTireTemp2 (0x205) */
+    {"TFLTireChannel[4]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFLTireChannel[4])},
+    {"TFLTireChannel[5]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFLTireChannel[5])},
+    {"TFLTireChannel[6]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFLTireChannel[6])},
+    {"TFLTireChannel[7]", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFLTireChannel[7])},
+    /* FLTireTemp3 (0x206) */
+    {"TFLTireChannel[8]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFLTireChannel[8])},
+    {"TFLTireChannel[9]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFLTireChannel[9])},
+    {"TFLTireChannel[10]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFLTireChannel[10])},
+    {"TFLTireChannel[11]", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFLTireChannel[11])},
+    /* FLTireTemp4 (0x207) */
+    {"TFLTireChannel[12]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFLTireChannel[12])},
+    {"TFLTireChannel[13]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFLTireChannel[13])},
+    {"TFLTireChannel[14]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFLTireChannel[14])},
+    {"TFLTireChannel[15]", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TFLTireChannel[15])},
+    /* RRTireTemp1 (0x208) */
+    {"TRRTireChannel[0]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRRTireChannel[0])},
+    {"TRRTireChannel[1]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRRTireChannel[1])},
+    {"TRRTireChannel[2]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRRTireChannel[2])},
+    {"TRRTireChannel[3]", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRRTireChannel[3])},
+    /* RRTireTemp2 (0x209) */
+    {"TRRTireChannel[4]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRRTireChannel[4])},
+    {"TRRTireChannel[5]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRRTireChannel[5])},
+    {"TRRTireChannel[6]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRRTireChannel[6])},
+    {"TRRTireChannel[7]", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRRTireChannel[7])},
+    /* RRTireTemp3 (0x20A) */
+    {"TRRTireChannel[8]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRRTireChannel[8])},
+    {"TRRTireChannel[9]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRRTireChannel[9])},
+    {"TRRTireChannel[10]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRRTireChannel[10])},
+    {"TRRTireChannel[11]", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRRTireChannel[11])},
+    /* RRTireTemp4 (0x20B) */
+    {"TRRTireChannel[12]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRRTireChannel[12])},
+    {"TRRTireChannel[13]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRRTireChannel[13])},
+    {"TRRTireChannel[14]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRRTireChannel[14])},
+    {"TRRTireChannel[15]", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRRTireChannel[15])},
+    /* RLTireTemp1 (0x20C) */
+    {"TRLTireChannel[0]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRLTireChannel[0])},
+    {"TRLTireChannel[1]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRLTireChannel[1])},
+    {"TRLTireChannel[2]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRLTireChannel[2])},
+    {"TRLTireChannel[3]", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRLTireChannel[3])},
+    /* RLTireTemp2 (0x20D) */
+    {"TRLTireChannel[4]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRLTireChannel[4])},
+    {"TRLTireChannel[5]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRLTireChannel[5])},
+    {"TRLTireChannel[6]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRLTireChannel[6])},
+    {"TRLTireChannel[7]", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRLTireChannel[7])},
+    /* RLTireTemp3 (0x20E) */
+    {"TRLTireChannel[8]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRLTireChannel[8])},
+    {"TRLTireChannel[9]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRLTireChannel[9])},
+    {"TRLTireChannel[10]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRLTireChannel[10])},
+    {"TRLTireChannel[11]", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRLTireChannel[11])},
+    /* RLTireTemp4 (0x20F) */
+    {"TRLTireChannel[12]", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRLTireChannel[12])},
+    {"TRLTireChannel[13]", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRLTireChannel[13])},
+    {"TRLTireChannel[14]", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRLTireChannel[14])},
+    {"TRLTireChannel[15]", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, -100.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TRLTireChannel[15])},
+    /* TargetIqInfo (0x3E4) */
+    {"ControlMode", 0, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(ControlMode)},
+    {"TargetIq", 15, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TargetIq)},
+    {"MotorPosition", 31, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(MotorPosition)},
+    {"isMotorStill", 40, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(isMotorStill)},
+    /* ERPM_DUTY_VOLTAGE (0x404) */
+    {"Actual_ERPM", 7, 32, TRUE, eCAN_SIGNAL_FLOAT, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Actual_ERPM)},
+    {"Actual_Duty", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Actual_Duty)},
+    {"Actual_InputVoltage", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Actual_InputVoltage)},
+    /* AC_DC_current (0x424) */
+    {"Actual_ACCurrent", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Actual_ACCurrent)},
+    {"Actual_DCCurrent", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Actual_DCCurrent)},
+    /* Temperatures (0x444) */
+    {"Actual_TempController", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Actual_TempController)},
+    {"Actual_TempMotor", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Actual_TempMotor)},
+    {"Actual_FaultCode", 32, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Actual_FaultCode)},
+    /* FOC (0x464) */
+    {"Actual_FOC_id", 7, 32, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Actual_FOC_id)},
+    {"Actual_FOC_iq", 39, 32, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Actual_FOC_iq)},
+    /* Inverter_MISC (0x484) */
+    {"Actual_Throttle", 0, 8, FALSE, eCAN_SIGNAL_FLOAT, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Actual_Throttle)},
+    {"Actual_Brake", 8, 8, FALSE, eCAN_SIGNAL_FLOAT, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Actual_Brake)},
+    {"Digital_output_[3]", 23, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Digital_output_[3])},
+    {"Digital_output_[2]", 22, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Digital_output_[2])},
+    {"Digital_output_[1]", 21, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Digital_output_[1])},
+    {"Digital_output_[0]", 20, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Digital_output_[0])},
+    {"Digital_input_[3]", 19, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Digital_input_[3])},
+    {"Digital_input_[2]", 18, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Digital_input_[2])},
+    {"Digital_input_[1]", 17, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Digital_input_[1])},
+    {"Digital_input_[0]", 16, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Digital_input_[0])},
+    {"Drive_enable", 24, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Drive_enable)},
+    {"Motor_temp_limit", 39, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Motor_temp_limit)},
+    {"Motor_accel_limit", 38, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Motor_accel_limit)},
+    {"Input_voltage_limit", 37, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Input_voltage_limit)},
+    {"IGBT_temp_limit", 36, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(IGBT_temp_limit)},
+    {"IGBT_accel_limit", 35, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(IGBT_accel_limit)},
+    {"Drive_enable_limit", 34, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Drive_enable_limit)},
+    {"DC_current_limit", 33, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(DC_current_limit)},
+    {"Capacitor_temp_limit", 32, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Capacitor_temp_limit)},
+    {"Power_limit", 47, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Power_limit)},
+    {"RPM_max_limit", 46, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(RPM_max_limit)},
+    {"RPM_min_limit", 45, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(RPM_min_limit)},
+    {"CAN_map_version", 44, 8, TRUE, eCAN_SIGNAL_UINT8, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(CAN_map_version)},
+    /* MinMaxAcCurrent (0x4A4) */
+    {"MaxAcCurrent", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(MaxAcCurrent)},
+    {"AvailableMaxAcCurrent", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(AvailableMaxAcCurrent)},
+    {"MinAcCurrent", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(MinAcCurrent)},
+    {"AvailableMinAcCurrent", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(AvailableMinAcCurrent)},
+    /* MinMaxDcCurrent (0x4C4) */
+    {"MaxDcCurrent", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(MaxDcCurrent)},
+    {"AvailableMaxDcCurrent", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(AvailableMaxDcCurrent)},
+    {"MinDcCurrent", 39, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(MinDcCurrent)},
+    {"AvailableMinDcCurrent", 55, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(AvailableMinDcCurrent)},
+    /* CellTempStats (0x6A0) */
+    {"rTHealthStack[0]", 27, 8, TRUE, eCAN_SIGNAL_FLOAT, 0.5f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(rTHealthStack[0])},
+    {"rTHealthStack[1]", 35, 8, TRUE, eCAN_SIGNAL_FLOAT, 0.5f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(rTHealthStack[1])},
+    {"rTHealthStack[2]", 43, 8, TRUE, eCAN_SIGNAL_FLOAT, 0.5f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(rTHealthStack[2])},
+    {"rTHealthStack[3]", 51, 8, TRUE, eCAN_SIGNAL_FLOAT, 0.5f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(rTHealthStack[3])},
+    {"CellID_Temp", 0, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(CellID_Temp)},
+    {"VTADCCell[0]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 1, CAN_SIGNAL_FW(VTADCCell[0])},
+    {"NTConversionMethodCell[0]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 1, CAN_SIGNAL_FW(NTConversionMethodCell[0])},
+    {"BTCellSimulated[0]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 1, CAN_SIGNAL_FW(BTCellSimulated[0])},
+    {"BTCellInError[0]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 1, CAN_SIGNAL_FW(BTCellInError[0])},
+    {"VTADCCell[1]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 2, CAN_SIGNAL_FW(VTADCCell[1])},
+    {"NTConversionMethodCell[1]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 2, CAN_SIGNAL_FW(NTConversionMethodCell[1])},
+    {"BTCellSimulated[1]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 2, CAN_SIGNAL_FW(BTCellSimulated[1])},
+    {"BTCellInError[1]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 2, CAN_SIGNAL_FW(BTCellInError[1])},
+    {"VTADCCell[2]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 3, CAN_SIGNAL_FW(VTADCCell[2])},
+    {"NTConversionMethodCell[2]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 3, CAN_SIGNAL_FW(NTConversionMethodCell[2])},
+    {"BTCellSimulated[2]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 3, CAN_SIGNAL_FW(BTCellSimulated[2])},
+    {"BTCellInError[2]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 3, CAN_SIGNAL_FW(BTCellInError[2])},
+    {"VTADCCell[3]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 4, CAN_SIGNAL_FW(VTADCCell[3])},
+    {"NTConversionMethodCell[3]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 4, CAN_SIGNAL_FW(NTConversionMethodCell[3])},
+    {"BTCellSimulated[3]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 4, CAN_SIGNAL_FW(BTCellSimulated[3])},
+    {"BTCellInError[3]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 4, CAN_SIGNAL_FW(BTCellInError[3])},
+    {"VTADCCell[4]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 5, CAN_SIGNAL_FW(VTADCCell[4])},
+    {"NTConversionMethodCell[4]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 5, CAN_SIGNAL_FW(NTConversionMethodCell[4])},
+    {"BTCellSimulated[4]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 5, CAN_SIGNAL_FW(BTCellSimulated[4])},
+    {"BTCellInError[4]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 5, CAN_SIGNAL_FW(BTCellInError[4])},
+    {"VTADCCell[5]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 6, CAN_SIGNAL_FW(VTADCCell[5])},
+    {"NTConversionMethodCell[5]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 6, CAN_SIGNAL_FW(NTConversionMethodCell[5])},
+    {"BTCellSimulated[5]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 6, CAN_SIGNAL_FW(BTCellSimulated[5])},
+    {"BTCellInError[5]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 6, CAN_SIGNAL_FW(BTCellInError[5])},
+    {"VTADCCell[6]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 7, CAN_SIGNAL_FW(VTADCCell[6])},
+    {"NTConversionMethodCell[6]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 7, CAN_SIGNAL_FW(NTConversionMethodCell[6])},
+    {"BTCellSimulated[6]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 7, CAN_SIGNAL_FW(BTCellSimulated[6])},
+    {"BTCellInError[6]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 7, CAN_SIGNAL_FW(BTCellInError[6])},
+    {"VTADCCell[7]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 8, CAN_SIGNAL_FW(VTADCCell[7])},
+    {"NTConversionMethodCell[7]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 8, CAN_SIGNAL_FW(NTConversionMethodCell[7])},
+    {"BTCellSimulated[7]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 8, CAN_SIGNAL_FW(BTCellSimulated[7])},
+    {"BTCellInError[7]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 8, CAN_SIGNAL_FW(BTCellInError[7])},
+    {"VTADCCell[8]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 9, CAN_SIGNAL_FW(VTADCCell[8])},
+    {"NTConversionMethodCell[8]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 9, CAN_SIGNAL_FW(NTConversionMethodCell[8])},
+    {"BTCellSimulated[8]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 9, CAN_SIGNAL_FW(BTCellSimulated[8])},
+    {"BTCellInError[8]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 9, CAN_SIGNAL_FW(BTCellInError[8])},
+    {"VTADCCell[9]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 10, CAN_SIGNAL_FW(VTADCCell[9])},
+    {"NTConversionMethodCell[9]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 10, CAN_SIGNAL_FW(NTConversionMethodCell[9])},
+    {"BTCellSimulated[9]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 10, CAN_SIGNAL_FW(BTCellSimulated[9])},
+    {"BTCellInError[9]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 10, CAN_SIGNAL_FW(BTCellInError[9])},
+    {"VTADCCell[10]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 11, CAN_SIGNAL_FW(VTADCCell[10])},
+    {"NTConversionMethodCell[10]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 11, CAN_SIGNAL_FW(NTConversionMethodCell[10])},
+    {"BTCellSimulated[10]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 11, CAN_SIGNAL_FW(BTCellSimulated[10])},
+    {"BTCellInError[10]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 11, CAN_SIGNAL_FW(BTCellInError[10])},
+    {"VTADCCell[11]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 12, CAN_SIGNAL_FW(VTADCCell[11])},
+    {"NTConversionMethodCell[11]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 12, CAN_SIGNAL_FW(NTConversionMethodCell[11])},
+    {"BTCellSimulated[11]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 12, CAN_SIGNAL_FW(BTCellSimulated[11])},
+    {"BTCellInError[11]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 12, CAN_SIGNAL_FW(BTCellInError[11])},
+    {"VTADCCell[12]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 13, CAN_SIGNAL_FW(VTADCCell[12])},
+    {"NTConversionMethodCell[12]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 13, CAN_SIGNAL_FW(NTConversionMethodCell[12])},
+    {"BTCellSimulated[12]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 13, CAN_SIGNAL_FW(BTCellSimulated[12])},
+    {"BTCellInError[12]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 13, CAN_SIGNAL_FW(BTCellInError[12])},
+    {"VTADCCell[13]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 14, CAN_SIGNAL_FW(VTADCCell[13])},
+    {"NTConversionMethodCell[13]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 14, CAN_SIGNAL_FW(NTConversionMethodCell[13])},
+    {"BTCellSimulated[13]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 14, CAN_SIGNAL_FW(BTCellSimulated[13])},
+    {"BTCellInError[13]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 14, CAN_SIGNAL_FW(BTCellInError[13])},
+    {"VTADCCell[14]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 15, CAN_SIGNAL_FW(VTADCCell[14])},
+    {"NTConversionMethodCell[14]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 15, CAN_SIGNAL_FW(NTConversionMethodCell[14])},
+    {"BTCellSimulated[14]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 15, CAN_SIGNAL_FW(BTCellSimulated[14])},
+    {"BTCellInError[14]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 15, CAN_SIGNAL_FW(BTCellInError[14])},
+    {"VTADCCell[15]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 16, CAN_SIGNAL_FW(VTADCCell[15])},
+    {"NTConversionMethodCell[15]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 16, CAN_SIGNAL_FW(NTConversionMethodCell[15])},
+    {"BTCellSimulated[15]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 16, CAN_SIGNAL_FW(BTCellSimulated[15])},
+    {"BTCellInError[15]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 16, CAN_SIGNAL_FW(BTCellInError[15])},
+    {"VTADCCell[16]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 17, CAN_SIGNAL_FW(VTADCCell[16])},
+    {"NTConversionMethodCell[16]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 17, CAN_SIGNAL_FW(NTConversionMethodCell[16])},
+    {"BTCellSimulated[16]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 17, CAN_SIGNAL_FW(BTCellSimulated[16])},
+    {"BTCellInError[16]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 17, CAN_SIGNAL_FW(BTCellInError[16])},
+    {"VTADCCell[17]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 18, CAN_SIGNAL_FW(VTADCCell[17])},
+    {"NTConversionMethodCell[17]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 18, CAN_SIGNAL_FW(NTConversionMethodCell[17])},
+    {"BTCellSimulated[17]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 18, CAN_SIGNAL_FW(BTCellSimulated[17])},
+    {"BTCellInError[17]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 18, CAN_SIGNAL_FW(BTCellInError[17])},
+    {"VTADCCell[18]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 19, CAN_SIGNAL_FW(VTADCCell[18])},
+    {"NTConversionMethodCell[18]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 19, CAN_SIGNAL_FW(NTConversionMethodCell[18])},
+    {"BTCellSimulated[18]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 19, CAN_SIGNAL_FW(BTCellSimulated[18])},
+    {"BTCellInError[18]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 19, CAN_SIGNAL_FW(BTCellInError[18])},
+    {"VTADCCell[19]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 20, CAN_SIGNAL_FW(VTADCCell[19])},
+    {"NTConversionMethodCell[19]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 20, CAN_SIGNAL_FW(NTConversionMethodCell[19])},
+    {"BTCellSimulated[19]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 20, CAN_SIGNAL_FW(BTCellSimulated[19])},
+    {"BTCellInError[19]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 20, CAN_SIGNAL_FW(BTCellInError[19])},
+    {"VTADCCell[20]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 21, CAN_SIGNAL_FW(VTADCCell[20])},
+    {"NTConversionMethodCell[20]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 21, CAN_SIGNAL_FW(NTConversionMethodCell[20])},
+    {"BTCellSimulated[20]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 21, CAN_SIGNAL_FW(BTCellSimulated[20])},
+    {"BTCellInError[20]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 21, CAN_SIGNAL_FW(BTCellInError[20])},
+    {"VTADCCell[21]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 22, CAN_SIGNAL_FW(VTADCCell[21])},
+    {"NTConversionMethodCell[21]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 22, CAN_SIGNAL_FW(NTConversionMethodCell[21])},
+    {"BTCellSimulated[21]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 22, CAN_SIGNAL_FW(BTCellSimulated[21])},
+    {"BTCellInError[21]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 22, CAN_SIGNAL_FW(BTCellInError[21])},
+    {"VTADCCell[22]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 23, CAN_SIGNAL_FW(VTADCCell[22])},
+    {"NTConversionMethodCell[22]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 23, CAN_SIGNAL_FW(NTConversionMethodCell[22])},
+    {"BTCellSimulated[22]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 23, CAN_SIGNAL_FW(BTCellSimulated[22])},
+    {"BTCellInError[22]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 23, CAN_SIGNAL_FW(BTCellInError[22])},
+    {"VTADCCell[23]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 24, CAN_SIGNAL_FW(VTADCCell[23])},
+    {"NTConversionMethodCell[23]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 24, CAN_SIGNAL_FW(NTConversionMethodCell[23])},
+    {"BTCellSimulated[23]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 24, CAN_SIGNAL_FW(BTCellSimulated[23])},
+    {"BTCellInError[23]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 24, CAN_SIGNAL_FW(BTCellInError[23])},
+    {"VTADCCell[24]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 25, CAN_SIGNAL_FW(VTADCCell[24])},
+    {"NTConversionMethodCell[24]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 25, CAN_SIGNAL_FW(NTConversionMethodCell[24])},
+    {"BTCellSimulated[24]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 25, CAN_SIGNAL_FW(BTCellSimulated[24])},
+    {"BTCellInError[24]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 25, CAN_SIGNAL_FW(BTCellInError[24])},
+    {"VTADCCell[25]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 26, CAN_SIGNAL_FW(VTADCCell[25])},
+    {"NTConversionMethodCell[25]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 26, CAN_SIGNAL_FW(NTConversionMethodCell[25])},
+    {"BTCellSimulated[25]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 26, CAN_SIGNAL_FW(BTCellSimulated[25])},
+    {"BTCellInError[25]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 26, CAN_SIGNAL_FW(BTCellInError[25])},
+    {"VTADCCell[26]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 27, CAN_SIGNAL_FW(VTADCCell[26])},
+    {"NTConversionMethodCell[26]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 27, CAN_SIGNAL_FW(NTConversionMethodCell[26])},
+    {"BTCellSimulated[26]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 27, CAN_SIGNAL_FW(BTCellSimulated[26])},
+    {"BTCellInError[26]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 27, CAN_SIGNAL_FW(BTCellInError[26])},
+    {"VTADCCell[27]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 28, CAN_SIGNAL_FW(VTADCCell[27])},
+    {"NTConversionMethodCell[27]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 28, CAN_SIGNAL_FW(NTConversionMethodCell[27])},
+    {"BTCellSimulated[27]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 28, CAN_SIGNAL_FW(BTCellSimulated[27])},
+    {"BTCellInError[27]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 28, CAN_SIGNAL_FW(BTCellInError[27])},
+    {"VTADCCell[28]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 29, CAN_SIGNAL_FW(VTADCCell[28])},
+    {"NTConversionMethodCell[28]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 29, CAN_SIGNAL_FW(NTConversionMethodCell[28])},
+    {"BTCellSimulated[28]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 29, CAN_SIGNAL_FW(BTCellSimulated[28])},
+    {"BTCellInError[28]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 29, CAN_SIGNAL_FW(BTCellInError[28])},
+    {"VTADCCell[29]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 30, CAN_SIGNAL_FW(VTADCCell[29])},
+    {"NTConversionMethodCell[29]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 30, CAN_SIGNAL_FW(NTConversionMethodCell[29])},
+    {"BTCellSimulated[29]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 30, CAN_SIGNAL_FW(BTCellSimulated[29])},
+    {"BTCellInError[29]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 30, CAN_SIGNAL_FW(BTCellInError[29])},
+    {"VTADCCell[30]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 31, CAN_SIGNAL_FW(VTADCCell[30])},
+    {"NTConversionMethodCell[30]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 31, CAN_SIGNAL_FW(NTConversionMethodCell[30])},
+    {"BTCellSimulated[30]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 31, CAN_SIGNAL_FW(BTCellSimulated[30])},
+    {"BTCellInError[30]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 31, CAN_SIGNAL_FW(BTCellInError[30])},
+    {"VTADCCell[31]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 32, CAN_SIGNAL_FW(VTADCCell[31])},
+    {"NTConversionMethodCell[31]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 32, CAN_SIGNAL_FW(NTConversionMethodCell[31])},
+    {"BTCellSimulated[31]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 32, CAN_SIGNAL_FW(BTCellSimulated[31])},
+    {"BTCellInError[31]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 32, CAN_SIGNAL_FW(BTCellInError[31])},
+    {"VTADCCell[32]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 33, CAN_SIGNAL_FW(VTADCCell[32])},
+    {"NTConversionMethodCell[32]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 33, CAN_SIGNAL_FW(NTConversionMethodCell[32])},
+    {"BTCellSimulated[32]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 33, CAN_SIGNAL_FW(BTCellSimulated[32])},
+    {"BTCellInError[32]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 33, CAN_SIGNAL_FW(BTCellInError[32])},
+    {"VTADCCell[33]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 34, CAN_SIGNAL_FW(VTADCCell[33])},
+    {"NTConversionMethodCell[33]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 34, CAN_SIGNAL_FW(NTConversionMethodCell[33])},
+    {"BTCellSimulated[33]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 34, CAN_SIGNAL_FW(BTCellSimulated[33])},
+    {"BTCellInError[33]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 34, CAN_SIGNAL_FW(BTCellInError[33])},
+    {"VTADCCell[34]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 35, CAN_SIGNAL_FW(VTADCCell[34])},
+    {"NTConversionMethodCell[34]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 35, CAN_SIGNAL_FW(NTConversionMethodCell[34])},
+    {"BTCellSimulated[34]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 35, CAN_SIGNAL_FW(BTCellSimulated[34])},
+    {"BTCellInError[34]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 35, CAN_SIGNAL_FW(BTCellInError[34])},
+    {"VTADCCell[35]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 36, CAN_SIGNAL_FW(VTADCCell[35])},
+    {"NTConversionMethodCell[35]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 36, CAN_SIGNAL_FW(NTConversionMethodCell[35])},
+    {"BTCellSimulated[35]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 36, CAN_SIGNAL_FW(BTCellSimulated[35])},
+    {"BTCellInError[35]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 36, CAN_SIGNAL_FW(BTCellInError[35])},
+    {"VTADCCell[36]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 37, CAN_SIGNAL_FW(VTADCCell[36])},
+    {"NTConversionMethodCell[36]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 37, CAN_SIGNAL_FW(NTConversionMethodCell[36])},
+    {"BTCellSimulated[36]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 37, CAN_SIGNAL_FW(BTCellSimulated[36])},
+    {"BTCellInError[36]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 37, CAN_SIGNAL_FW(BTCellInError[36])},
+    {"VTADCCell[37]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 38, CAN_SIGNAL_FW(VTADCCell[37])},
+    {"NTConversionMethodCell[37]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 38, CAN_SIGNAL_FW(NTConversionMethodCell[37])},
+    {"BTCellSimulated[37]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 38, CAN_SIGNAL_FW(BTCellSimulated[37])},
+    {"BTCellInError[37]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 38, CAN_SIGNAL_FW(BTCellInError[37])},
+    {"VTADCCell[38]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 39, CAN_SIGNAL_FW(VTADCCell[38])},
+    {"NTConversionMethodCell[38]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 39, CAN_SIGNAL_FW(NTConversionMethodCell[38])},
+    {"BTCellSimulated[38]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 39, CAN_SIGNAL_FW(BTCellSimulated[38])},
+    {"BTCellInError[38]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 39, CAN_SIGNAL_FW(BTCellInError[38])},
+    {"VTADCCell[39]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 40, CAN_SIGNAL_FW(VTADCCell[39])},
+    {"NTConversionMethodCell[39]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 40, CAN_SIGNAL_FW(NTConversionMethodCell[39])},
+    {"BTCellSimulated[39]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 40, CAN_SIGNAL_FW(BTCellSimulated[39])},
+    {"BTCellInError[39]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 40, CAN_SIGNAL_FW(BTCellInError[39])},
+    {"VTADCCell[40]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 41, CAN_SIGNAL_FW(VTADCCell[40])},
+    {"NTConversionMethodCell[40]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 41, CAN_SIGNAL_FW(NTConversionMethodCell[40])},
+    {"BTCellSimulated[40]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 41, CAN_SIGNAL_FW(BTCellSimulated[40])},
+    {"BTCellInError[40]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 41, CAN_SIGNAL_FW(BTCellInError[40])},
+    {"VTADCCell[41]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 42, CAN_SIGNAL_FW(VTADCCell[41])},
+    {"NTConversionMethodCell[41]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 42, CAN_SIGNAL_FW(NTConversionMethodCell[41])},
+    {"BTCellSimulated[41]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 42, CAN_SIGNAL_FW(BTCellSimulated[41])},
+    {"BTCellInError[41]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 42, CAN_SIGNAL_FW(BTCellInError[41])},
+    {"VTADCCell[42]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 43, CAN_SIGNAL_FW(VTADCCell[42])},
+    {"NTConversionMethodCell[42]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 43, CAN_SIGNAL_FW(NTConversionMethodCell[42])},
+    {"BTCellSimulated[42]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 43, CAN_SIGNAL_FW(BTCellSimulated[42])},
+    {"BTCellInError[42]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 43, CAN_SIGNAL_FW(BTCellInError[42])},
+    {"VTADCCell[43]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 44, CAN_SIGNAL_FW(VTADCCell[43])},
+    {"NTConversionMethodCell[43]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 44, CAN_SIGNAL_FW(NTConversionMethodCell[43])},
+    {"BTCellSimulated[43]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 44, CAN_SIGNAL_FW(BTCellSimulated[43])},
+    {"BTCellInError[43]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 44, CAN_SIGNAL_FW(BTCellInError[43])},
+    {"VTADCCell[44]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 45, CAN_SIGNAL_FW(VTADCCell[44])},
+    {"NTConversionMethodCell[44]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 45, CAN_SIGNAL_FW(NTConversionMethodCell[44])},
+    {"BTCellSimulated[44]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 45, CAN_SIGNAL_FW(BTCellSimulated[44])},
+    {"BTCellInError[44]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 45, CAN_SIGNAL_FW(BTCellInError[44])},
+    {"VTADCCell[45]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 46, CAN_SIGNAL_FW(VTADCCell[45])},
+    {"NTConversionMethodCell[45]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 46, CAN_SIGNAL_FW(NTConversionMethodCell[45])},
+    {"BTCellSimulated[45]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 46, CAN_SIGNAL_FW(BTCellSimulated[45])},
+    {"BTCellInError[45]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 46, CAN_SIGNAL_FW(BTCellInError[45])},
+    {"VTADCCell[46]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 47, CAN_SIGNAL_FW(VTADCCell[46])},
+    {"NTConversionMethodCell[46]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 47, CAN_SIGNAL_FW(NTConversionMethodCell[46])},
+    {"BTCellSimulated[46]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 47, CAN_SIGNAL_FW(BTCellSimulated[46])},
+    {"BTCellInError[46]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 47, CAN_SIGNAL_FW(BTCellInError[46])},
+    {"VTADCCell[47]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 48, CAN_SIGNAL_FW(VTADCCell[47])},
+    {"NTConversionMethodCell[47]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 48, CAN_SIGNAL_FW(NTConversionMethodCell[47])},
+    {"BTCellSimulated[47]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 48, CAN_SIGNAL_FW(BTCellSimulated[47])},
+    {"BTCellInError[47]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 48, CAN_SIGNAL_FW(BTCellInError[47])},
+    {"VTADCCell[48]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 49, CAN_SIGNAL_FW(VTADCCell[48])},
+    {"NTConversionMethodCell[48]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 49, CAN_SIGNAL_FW(NTConversionMethodCell[48])},
+    {"BTCellSimulated[48]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 49, CAN_SIGNAL_FW(BTCellSimulated[48])},
+    {"BTCellInError[48]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 49, CAN_SIGNAL_FW(BTCellInError[48])},
+    {"VTADCCell[49]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 50, CAN_SIGNAL_FW(VTADCCell[49])},
+    {"NTConversionMethodCell[49]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 50, CAN_SIGNAL_FW(NTConversionMethodCell[49])},
+    {"BTCellSimulated[49]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 50, CAN_SIGNAL_FW(BTCellSimulated[49])},
+    {"BTCellInError[49]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 50, CAN_SIGNAL_FW(BTCellInError[49])},
+    {"VTADCCell[50]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 51, CAN_SIGNAL_FW(VTADCCell[50])},
+    {"NTConversionMethodCell[50]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 51, CAN_SIGNAL_FW(NTConversionMethodCell[50])},
+    {"BTCellSimulated[50]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 51, CAN_SIGNAL_FW(BTCellSimulated[50])},
+    {"BTCellInError[50]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 51, CAN_SIGNAL_FW(BTCellInError[50])},
+    {"VTADCCell[51]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 52, CAN_SIGNAL_FW(VTADCCell[51])},
+    {"NTConversionMethodCell[51]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 52, CAN_SIGNAL_FW(NTConversionMethodCell[51])},
+    {"BTCellSimulated[51]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 52, CAN_SIGNAL_FW(BTCellSimulated[51])},
+    {"BTCellInError[51]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 52, CAN_SIGNAL_FW(BTCellInError[51])},
+    {"VTADCCell[52]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 53, CAN_SIGNAL_FW(VTADCCell[52])},
+    {"NTConversionMethodCell[52]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 53, CAN_SIGNAL_FW(NTConversionMethodCell[52])},
+    {"BTCellSimulated[52]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 53, CAN_SIGNAL_FW(BTCellSimulated[52])},
+    {"BTCellInError[52]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 53, CAN_SIGNAL_FW(BTCellInError[52])},
+    {"VTADCCell[53]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 54, CAN_SIGNAL_FW(VTADCCell[53])},
+    {"NTConversionMethodCell[53]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 54, CAN_SIGNAL_FW(NTConversionMethodCell[53])},
+    {"BTCellSimulated[53]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 54, CAN_SIGNAL_FW(BTCellSimulated[53])},
+    {"BTCellInError[53]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 54, CAN_SIGNAL_FW(BTCellInError[53])},
+    {"VTADCCell[54]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 55, CAN_SIGNAL_FW(VTADCCell[54])},
+    {"NTConversionMethodCell[54]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 55, CAN_SIGNAL_FW(NTConversionMethodCell[54])},
+    {"BTCellSimulated[54]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 55, CAN_SIGNAL_FW(BTCellSimulated[54])},
+    {"BTCellInError[54]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 55, CAN_SIGNAL_FW(BTCellInError[54])},
+    {"VTADCCell[55]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 56, CAN_SIGNAL_FW(VTADCCell[55])},
+    {"NTConversionMethodCell[55]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 56, CAN_SIGNAL_FW(NTConversionMethodCell[55])},
+    {"BTCellSimulated[55]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 56, CAN_SIGNAL_FW(BTCellSimulated[55])},
+    {"BTCellInError[55]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 56, CAN_SIGNAL_FW(BTCellInError[55])},
+    {"VTADCCell[56]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 57, CAN_SIGNAL_FW(VTADCCell[56])},
+    {"NTConversionMethodCell[56]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 57, CAN_SIGNAL_FW(NTConversionMethodCell[56])},
+    {"BTCellSimulated[56]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 57, CAN_SIGNAL_FW(BTCellSimulated[56])},
+    {"BTCellInError[56]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 57, CAN_SIGNAL_FW(BTCellInError[56])},
+    {"VTADCCell[57]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 58, CAN_SIGNAL_FW(VTADCCell[57])},
+    {"NTConversionMethodCell[57]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 58, CAN_SIGNAL_FW(NTConversionMethodCell[57])},
+    {"BTCellSimulated[57]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 58, CAN_SIGNAL_FW(BTCellSimulated[57])},
+    {"BTCellInError[57]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 58, CAN_SIGNAL_FW(BTCellInError[57])},
+    {"VTADCCell[58]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 59, CAN_SIGNAL_FW(VTADCCell[58])},
+    {"NTConversionMethodCell[58]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 59, CAN_SIGNAL_FW(NTConversionMethodCell[58])},
+    {"BTCellSimulated[58]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 59, CAN_SIGNAL_FW(BTCellSimulated[58])},
+    {"BTCellInError[58]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 59, CAN_SIGNAL_FW(BTCellInError[58])},
+    {"VTADCCell[59]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 60, CAN_SIGNAL_FW(VTADCCell[59])},
+    {"NTConversionMethodCell[59]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 60, CAN_SIGNAL_FW(NTConversionMethodCell[59])},
+    {"BTCellSimulated[59]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 60, CAN_SIGNAL_FW(BTCellSimulated[59])},
+    {"BTCellInError[59]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 60, CAN_SIGNAL_FW(BTCellInError[59])},
+    {"VTADCCell[60]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 61, CAN_SIGNAL_FW(VTADCCell[60])},
+    {"NTConversionMethodCell[60]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 61, CAN_SIGNAL_FW(NTConversionMethodCell[60])},
+    {"BTCellSimulated[60]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 61, CAN_SIGNAL_FW(BTCellSimulated[60])},
+    {"BTCellInError[60]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 61, CAN_SIGNAL_FW(BTCellInError[60])},
+    {"VTADCCell[61]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 62, CAN_SIGNAL_FW(VTADCCell[61])},
+    {"NTConversionMethodCell[61]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 62, CAN_SIGNAL_FW(NTConversionMethodCell[61])},
+    {"BTCellSimulated[61]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 62, CAN_SIGNAL_FW(BTCellSimulated[61])},
+    {"BTCellInError[61]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 62, CAN_SIGNAL_FW(BTCellInError[61])},
+    {"VTADCCell[62]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 63, CAN_SIGNAL_FW(VTADCCell[62])},
+    {"NTConversionMethodCell[62]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 63, CAN_SIGNAL_FW(NTConversionMethodCell[62])},
+    {"BTCellSimulated[62]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 63, CAN_SIGNAL_FW(BTCellSimulated[62])},
+    {"BTCellInError[62]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 63, CAN_SIGNAL_FW(BTCellInError[62])},
+    {"VTADCCell[63]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 64, CAN_SIGNAL_FW(VTADCCell[63])},
+    {"NTConversionMethodCell[63]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 64, CAN_SIGNAL_FW(NTConversionMethodCell[63])},
+    {"BTCellSimulated[63]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 64, CAN_SIGNAL_FW(BTCellSimulated[63])},
+    {"BTCellInError[63]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 64, CAN_SIGNAL_FW(BTCellInError[63])},
+    {"VTADCCell[64]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 65, CAN_SIGNAL_FW(VTADCCell[64])},
+    {"NTConversionMethodCell[64]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 65, CAN_SIGNAL_FW(NTConversionMethodCell[64])},
+    {"BTCellSimulated[64]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 65, CAN_SIGNAL_FW(BTCellSimulated[64])},
+    {"BTCellInError[64]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 65, CAN_SIGNAL_FW(BTCellInError[64])},
+    {"VTADCCell[65]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 66, CAN_SIGNAL_FW(VTADCCell[65])},
+    {"NTConversionMethodCell[65]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 66, CAN_SIGNAL_FW(NTConversionMethodCell[65])},
+    {"BTCellSimulated[65]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 66, CAN_SIGNAL_FW(BTCellSimulated[65])},
+    {"BTCellInError[65]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 66, CAN_SIGNAL_FW(BTCellInError[65])},
+    {"VTADCCell[66]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 67, CAN_SIGNAL_FW(VTADCCell[66])},
+    {"NTConversionMethodCell[66]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 67, CAN_SIGNAL_FW(NTConversionMethodCell[66])},
+    {"BTCellSimulated[66]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 67, CAN_SIGNAL_FW(BTCellSimulated[66])},
+    {"BTCellInError[66]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 67, CAN_SIGNAL_FW(BTCellInError[66])},
+    {"VTADCCell[67]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 68, CAN_SIGNAL_FW(VTADCCell[67])},
+    {"NTConversionMethodCell[67]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 68, CAN_SIGNAL_FW(NTConversionMethodCell[67])},
+    {"BTCellSimulated[67]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 68, CAN_SIGNAL_FW(BTCellSimulated[67])},
+    {"BTCellInError[67]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 68, CAN_SIGNAL_FW(BTCellInError[67])},
+    {"VTADCCell[68]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 69, CAN_SIGNAL_FW(VTADCCell[68])},
+    {"NTConversionMethodCell[68]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 69, CAN_SIGNAL_FW(NTConversionMethodCell[68])},
+    {"BTCellSimulated[68]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 69, CAN_SIGNAL_FW(BTCellSimulated[68])},
+    {"BTCellInError[68]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 69, CAN_SIGNAL_FW(BTCellInError[68])},
+    {"VTADCCell[69]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 70, CAN_SIGNAL_FW(VTADCCell[69])},
+    {"NTConversionMethodCell[69]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 70, CAN_SIGNAL_FW(NTConversionMethodCell[69])},
+    {"BTCellSimulated[69]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 70, CAN_SIGNAL_FW(BTCellSimulated[69])},
+    {"BTCellInError[69]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 70, CAN_SIGNAL_FW(BTCellInError[69])},
+    {"VTADCCell[70]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 71, CAN_SIGNAL_FW(VTADCCell[70])},
+    {"NTConversionMethodCell[70]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 71, CAN_SIGNAL_FW(NTConversionMethodCell[70])},
+    {"BTCellSimulated[70]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 71, CAN_SIGNAL_FW(BTCellSimulated[70])},
+    {"BTCellInError[70]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 71, CAN_SIGNAL_FW(BTCellInError[70])},
+    {"VTADCCell[71]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 72, CAN_SIGNAL_FW(VTADCCell[71])},
+    {"NTConversionMethodCell[71]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 72, CAN_SIGNAL_FW(NTConversionMethodCell[71])},
+    {"BTCellSimulated[71]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 72, CAN_SIGNAL_FW(BTCellSimulated[71])},
+    {"BTCellInError[71]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 72, CAN_SIGNAL_FW(BTCellInError[71])},
+    {"VTADCCell[72]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 73, CAN_SIGNAL_FW(VTADCCell[72])},
+    {"NTConversionMethodCell[72]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 73, CAN_SIGNAL_FW(NTConversionMethodCell[72])},
+    {"BTCellSimulated[72]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 73, CAN_SIGNAL_FW(BTCellSimulated[72])},
+    {"BTCellInError[72]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 73, CAN_SIGNAL_FW(BTCellInError[72])},
+    {"VTADCCell[73]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 74, CAN_SIGNAL_FW(VTADCCell[73])},
+    {"NTConversionMethodCell[73]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 74, CAN_SIGNAL_FW(NTConversionMethodCell[73])},
+    {"BTCellSimulated[73]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 74, CAN_SIGNAL_FW(BTCellSimulated[73])},
+    {"BTCellInError[73]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 74, CAN_SIGNAL_FW(BTCellInError[73])},
+    {"VTADCCell[74]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 75, CAN_SIGNAL_FW(VTADCCell[74])},
+    {"NTConversionMethodCell[74]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 75, CAN_SIGNAL_FW(NTConversionMethodCell[74])},
+    {"BTCellSimulated[74]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 75, CAN_SIGNAL_FW(BTCellSimulated[74])},
+    {"BTCellInError[74]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 75, CAN_SIGNAL_FW(BTCellInError[74])},
+    {"VTADCCell[75]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 76, CAN_SIGNAL_FW(VTADCCell[75])},
+    {"NTConversionMethodCell[75]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 76, CAN_SIGNAL_FW(NTConversionMethodCell[75])},
+    {"BTCellSimulated[75]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 76, CAN_SIGNAL_FW(BTCellSimulated[75])},
+    {"BTCellInError[75]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 76, CAN_SIGNAL_FW(BTCellInError[75])},
+    {"VTADCCell[76]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 77, CAN_SIGNAL_FW(VTADCCell[76])},
+    {"NTConversionMethodCell[76]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 77, CAN_SIGNAL_FW(NTConversionMethodCell[76])},
+    {"BTCellSimulated[76]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 77, CAN_SIGNAL_FW(BTCellSimulated[76])},
+    {"BTCellInError[76]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 77, CAN_SIGNAL_FW(BTCellInError[76])},
+    {"VTADCCell[77]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 78, CAN_SIGNAL_FW(VTADCCell[77])},
+    {"NTConversionMethodCell[77]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 78, CAN_SIGNAL_FW(NTConversionMethodCell[77])},
+    {"BTCellSimulated[77]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 78, CAN_SIGNAL_FW(BTCellSimulated[77])},
+    {"BTCellInError[77]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 78, CAN_SIGNAL_FW(BTCellInError[77])},
+    {"VTADCCell[78]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 79, CAN_SIGNAL_FW(VTADCCell[78])},
+    {"NTConversionMethodCell[78]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 79, CAN_SIGNAL_FW(NTConversionMethodCell[78])},
+    {"BTCellSimulated[78]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 79, CAN_SIGNAL_FW(BTCellSimulated[78])},
+    {"BTCellInError[78]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 79, CAN_SIGNAL_FW(BTCellInError[78])},
+    {"VTADCCell[79]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 80, CAN_SIGNAL_FW(VTADCCell[79])},
+    {"NTConversionMethodCell[79]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 80, CAN_SIGNAL_FW(NTConversionMethodCell[79])},
+    {"BTCellSimulated[79]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 80, CAN_SIGNAL_FW(BTCellSimulated[79])},
+    {"BTCellInError[79]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 80, CAN_SIGNAL_FW(BTCellInError[79])},
+    {"VTADCCell[80]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 81, CAN_SIGNAL_FW(VTADCCell[80])},
+    {"NTConversionMethodCell[80]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 81, CAN_SIGNAL_FW(NTConversionMethodCell[80])},
+    {"BTCellSimulated[80]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 81, CAN_SIGNAL_FW(BTCellSimulated[80])},
+    {"BTCellInError[80]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 81, CAN_SIGNAL_FW(BTCellInError[80])},
+    {"VTADCCell[81]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 82, CAN_SIGNAL_FW(VTADCCell[81])},
+    {"NTConversionMethodCell[81]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 82, CAN_SIGNAL_FW(NTConversionMethodCell[81])},
+    {"BTCellSimulated[81]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 82, CAN_SIGNAL_FW(BTCellSimulated[81])},
+    {"BTCellInError[81]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 82, CAN_SIGNAL_FW(BTCellInError[81])},
+    {"VTADCCell[82]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 83, CAN_SIGNAL_FW(VTADCCell[82])},
+    {"NTConversionMethodCell[82]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 83, CAN_SIGNAL_FW(NTConversionMethodCell[82])},
+    {"BTCellSimulated[82]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 83, CAN_SIGNAL_FW(BTCellSimulated[82])},
+    {"BTCellInError[82]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 83, CAN_SIGNAL_FW(BTCellInError[82])},
+    {"VTADCCell[83]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 84, CAN_SIGNAL_FW(VTADCCell[83])},
+    {"NTConversionMethodCell[83]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 84, CAN_SIGNAL_FW(NTConversionMethodCell[83])},
+    {"BTCellSimulated[83]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 84, CAN_SIGNAL_FW(BTCellSimulated[83])},
+    {"BTCellInError[83]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 84, CAN_SIGNAL_FW(BTCellInError[83])},
+    {"VTADCCell[84]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 85, CAN_SIGNAL_FW(VTADCCell[84])},
+    {"NTConversionMethodCell[84]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 85, CAN_SIGNAL_FW(NTConversionMethodCell[84])},
+    {"BTCellSimulated[84]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 85, CAN_SIGNAL_FW(BTCellSimulated[84])},
+    {"BTCellInError[84]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 85, CAN_SIGNAL_FW(BTCellInError[84])},
+    {"VTADCCell[85]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 86, CAN_SIGNAL_FW(VTADCCell[85])},
+    {"NTConversionMethodCell[85]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 86, CAN_SIGNAL_FW(NTConversionMethodCell[85])},
+    {"BTCellSimulated[85]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 86, CAN_SIGNAL_FW(BTCellSimulated[85])},
+    {"BTCellInError[85]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 86, CAN_SIGNAL_FW(BTCellInError[85])},
+    {"VTADCCell[86]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 87, CAN_SIGNAL_FW(VTADCCell[86])},
+    {"NTConversionMethodCell[86]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 87, CAN_SIGNAL_FW(NTConversionMethodCell[86])},
+    {"BTCellSimulated[86]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 87, CAN_SIGNAL_FW(BTCellSimulated[86])},
+    {"BTCellInError[86]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 87, CAN_SIGNAL_FW(BTCellInError[86])},
+    {"VTADCCell[87]", 11, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, 88, CAN_SIGNAL_FW(VTADCCell[87])},
+    {"NTConversionMethodCell[87]", 12, 2, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, 88, CAN_SIGNAL_FW(NTConversionMethodCell[87])},
+    {"BTCellSimulated[87]", 14, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 88, CAN_SIGNAL_FW(BTCellSimulated[87])},
+    {"BTCellInError[87]", 15, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, 88, CAN_SIGNAL_FW(BTCellInError[87])},
+    /* CellStats1 (0x6B0) */
+    {"IPack", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(IPack)},
+    {"VPackInstant", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(VPackInstant)},
+    {"rSOC", 32, 8, FALSE, eCAN_SIGNAL_FLOAT, 0.5f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(rSOC)},
+    {"BP0A1FInternalCellCommunicationFault", 47, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0A1FInternalCellCommunicationFault)},
+    {"BP0A12CellBalancingStuckOffFault", 46, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0A12CellBalancingStuckOffFault)},
+    {"BP0A80WeakCellFault", 45, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0A80WeakCellFault)},
+    {"BP0AFALowCellVoltageFault", 44, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0AFALowCellVoltageFault)},
+    {"BP0A04CellOpenWiringFault", 43, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0A04CellOpenWiringFault)},
+    {"BP0AC0CurrentSensorFault", 42, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0AC0CurrentSensorFault)},
+    {"BP0A0DCellVoltageOver5VFault", 41, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0A0DCellVoltageOver5VFault)},
+    {"BP0A0FCellBankFault", 40, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0A0FCellBankFault)},
+    {"BP0A02WeakPackFault", 55, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0A02WeakPackFault)},
+    {"BU0100CANCommunicationFault", 54, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BU0100CANCommunicationFault)},
+    {"BP0A9CThermistorFault", 53, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0A9CThermistorFault)},
+    {"BP0AA6HighVoltageIsolationFault", 52, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0AA6HighVoltageIsolationFault)},
+    {"BP0A06ChargeEnableRelayFault", 51, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0A06ChargeEnableRelayFault)},
+    {"BP0A07DischargeEnableRelayFault", 50, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0A07DischargeEnableRelayFault)},
+    {"BP0A08ChargerSafetyRelayFault", 49, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0A08ChargerSafetyRelayFault)},
+    {"BP0A05InvalidInputSupplyVoltageFault", 48, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0A05InvalidInputSupplyVoltageFault)},
+    /* CellStats2 (0x6B1) */
+    {"IDischargeLimit", 0, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(IDischargeLimit)},
+    {"RPack", 8, 8, FALSE, eCAN_SIGNAL_FLOAT, 0.001f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(RPack)},
+    {"VPackTotal", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.01f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(VPackTotal)},
+    {"TCellMax_BMS", 32, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TCellMax_BMS)},
+    {"TCellMin_BMS", 40, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TCellMin_BMS)},
+    {"NFailsafeStatus", 48, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NFailsafeStatus)},
+    /* CellStats3 (0x6B2) */
+    {"VCellMin", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(VCellMin)},
+    {"VCellMax", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(VCellMax)},
+    {"NVCellMinID", 32, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NVCellMinID)},
+    {"NVCellMaxID", 40, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NVCellMaxID)},
+    {"BP0A10PackTooHotFault", 55, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0A10PackTooHotFault)},
+    {"BP0A95HighVoltageInterlockSignalFault", 54, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0A95HighVoltageInterlockSignalFault)},
+    {"BP0A0BInternalLogicFault", 53, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0A0BInternalLogicFault)},
+    {"BP0A0AInternalHeatsinkThermistorFault", 52, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0A0AInternalHeatsinkThermistorFault)},
+    {"BP0A11AbnormalStateofChargeBehavior", 51, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(BP0A11AbnormalStateofChargeBehavior)},
+    /* CellStats4 (0x6B3) */
+    {"VCellAvg", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.0001f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(VCellAvg)},
+    {"VIPackSensor[0]", 23, 16, TRUE, eCAN_SIGNAL_UINT16, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(VIPackSensor[0])},
+    {"VIPackSensor[1]", 39, 16, TRUE, eCAN_SIGNAL_UINT16, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(VIPackSensor[1])},
+    /* ElconInterface2 (0x1806E5F4) */
+    {"Maximum_Cell_Voltage", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Maximum_Cell_Voltage)},
+    {"Pack_CCL", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Pack_CCL)},
+    {"DTC_P0A08_Charger_Safety_Relay_Fault", 39, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(DTC_P0A08_Charger_Safety_Relay_Fault)},
+    /* ElconInterface1 (0x1806E7F4) */
+    {"Maximum_Pack_Voltage", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Maximum_Pack_Voltage)},
+    {"Pack_CCL", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Pack_CCL)},
+    {"DTC_P0A08_Charger_Safety_Relay_Fault", 39, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(DTC_P0A08_Charger_Safety_Relay_Fault)},
+    /* ElconInterface3 (0x1806E9F4) */
+    {"Maximum_Cell_Voltage", 7, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Maximum_Cell_Voltage)},
+    {"Pack_CCL", 23, 16, TRUE, eCAN_SIGNAL_FLOAT, 0.1f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(Pack_CCL)},
+    {"DTC_P0A08_Charger_Safety_Relay_Fault", 39, 1, FALSE, eCAN_SIGNAL_BOOL, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(DTC_P0A08_Charger_Safety_Relay_Fault)},
+    /* CellTempGeneral (0x1838F380) */
+    {"TCellMin", 32, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TCellMin)},
+    {"TCellMax", 40, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TCellMax)},
+    {"NTCellMaxID", 48, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NTCellMaxID)},
+    {"NTCellMinID", 56, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NTCellMinID)},
+    {"NTCellID", 7, 16, TRUE, eCAN_SIGNAL_UINT16, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NTCellID)},
+    {"TCell[0]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 0, CAN_SIGNAL_FW(TCell[0])},
+    {"TCell[1]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 1, CAN_SIGNAL_FW(TCell[1])},
+    {"TCell[2]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 2, CAN_SIGNAL_FW(TCell[2])},
+    {"TCell[3]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 3, CAN_SIGNAL_FW(TCell[3])},
+    {"TCell[4]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 4, CAN_SIGNAL_FW(TCell[4])},
+    {"TCell[5]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 5, CAN_SIGNAL_FW(TCell[5])},
+    {"TCell[6]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 6, CAN_SIGNAL_FW(TCell[6])},
+    {"TCell[7]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 7, CAN_SIGNAL_FW(TCell[7])},
+    {"TCell[8]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 8, CAN_SIGNAL_FW(TCell[8])},
+    {"TCell[9]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 9, CAN_SIGNAL_FW(TCell[9])},
+    {"TCell[10]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 10, CAN_SIGNAL_FW(TCell[10])},
+    {"TCell[11]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 11, CAN_SIGNAL_FW(TCell[11])},
+    {"TCell[12]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 12, CAN_SIGNAL_FW(TCell[12])},
+    {"TCell[13]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 13, CAN_SIGNAL_FW(TCell[13])},
+    {"TCell[14]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 14, CAN_SIGNAL_FW(TCell[14])},
+    {"TCell[15]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 15, CAN_SIGNAL_FW(TCell[15])},
+    {"TCell[16]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 16, CAN_SIGNAL_FW(TCell[16])},
+    {"TCell[17]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 17, CAN_SIGNAL_FW(TCell[17])},
+    {"TCell[18]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 18, CAN_SIGNAL_FW(TCell[18])},
+    {"TCell[19]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 19, CAN_SIGNAL_FW(TCell[19])},
+    {"TCell[20]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 20, CAN_SIGNAL_FW(TCell[20])},
+    {"TCell[21]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 21, CAN_SIGNAL_FW(TCell[21])},
+    {"TCell[22]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 22, CAN_SIGNAL_FW(TCell[22])},
+    {"TCell[23]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 23, CAN_SIGNAL_FW(TCell[23])},
+    {"TCell[24]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 24, CAN_SIGNAL_FW(TCell[24])},
+    {"TCell[25]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 25, CAN_SIGNAL_FW(TCell[25])},
+    {"TCell[26]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 26, CAN_SIGNAL_FW(TCell[26])},
+    {"TCell[27]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 27, CAN_SIGNAL_FW(TCell[27])},
+    {"TCell[28]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 28, CAN_SIGNAL_FW(TCell[28])},
+    {"TCell[29]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 29, CAN_SIGNAL_FW(TCell[29])},
+    {"TCell[30]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 30, CAN_SIGNAL_FW(TCell[30])},
+    {"TCell[31]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 31, CAN_SIGNAL_FW(TCell[31])},
+    {"TCell[32]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 32, CAN_SIGNAL_FW(TCell[32])},
+    {"TCell[33]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 33, CAN_SIGNAL_FW(TCell[33])},
+    {"TCell[34]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 34, CAN_SIGNAL_FW(TCell[34])},
+    {"TCell[35]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 35, CAN_SIGNAL_FW(TCell[35])},
+    {"TCell[36]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 36, CAN_SIGNAL_FW(TCell[36])},
+    {"TCell[37]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 37, CAN_SIGNAL_FW(TCell[37])},
+    {"TCell[38]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 38, CAN_SIGNAL_FW(TCell[38])},
+    {"TCell[39]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 39, CAN_SIGNAL_FW(TCell[39])},
+    {"TCell[40]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 40, CAN_SIGNAL_FW(TCell[40])},
+    {"TCell[41]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 41, CAN_SIGNAL_FW(TCell[41])},
+    {"TCell[42]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 42, CAN_SIGNAL_FW(TCell[42])},
+    {"TCell[43]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 43, CAN_SIGNAL_FW(TCell[43])},
+    {"TCell[44]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 44, CAN_SIGNAL_FW(TCell[44])},
+    {"TCell[45]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 45, CAN_SIGNAL_FW(TCell[45])},
+    {"TCell[46]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 46, CAN_SIGNAL_FW(TCell[46])},
+    {"TCell[47]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 47, CAN_SIGNAL_FW(TCell[47])},
+    {"TCell[48]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 48, CAN_SIGNAL_FW(TCell[48])},
+    {"TCell[49]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 49, CAN_SIGNAL_FW(TCell[49])},
+    {"TCell[50]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 50, CAN_SIGNAL_FW(TCell[50])},
+    {"TCell[51]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 51, CAN_SIGNAL_FW(TCell[51])},
+    {"TCell[52]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 52, CAN_SIGNAL_FW(TCell[52])},
+    {"TCell[53]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 53, CAN_SIGNAL_FW(TCell[53])},
+    {"TCell[54]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 54, CAN_SIGNAL_FW(TCell[54])},
+    {"TCell[55]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 55, CAN_SIGNAL_FW(TCell[55])},
+    {"TCell[56]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 56, CAN_SIGNAL_FW(TCell[56])},
+    {"TCell[57]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 57, CAN_SIGNAL_FW(TCell[57])},
+    {"TCell[58]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 58, CAN_SIGNAL_FW(TCell[58])},
+    {"TCell[59]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 59, CAN_SIGNAL_FW(TCell[59])},
+    {"TCell[60]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 60, CAN_SIGNAL_FW(TCell[60])},
+    {"TCell[61]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 61, CAN_SIGNAL_FW(TCell[61])},
+    {"TCell[62]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 62, CAN_SIGNAL_FW(TCell[62])},
+    {"TCell[63]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 63, CAN_SIGNAL_FW(TCell[63])},
+    {"TCell[64]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 64, CAN_SIGNAL_FW(TCell[64])},
+    {"TCell[65]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 65, CAN_SIGNAL_FW(TCell[65])},
+    {"TCell[66]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 66, CAN_SIGNAL_FW(TCell[66])},
+    {"TCell[67]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 67, CAN_SIGNAL_FW(TCell[67])},
+    {"TCell[68]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 68, CAN_SIGNAL_FW(TCell[68])},
+    {"TCell[69]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 69, CAN_SIGNAL_FW(TCell[69])},
+    {"TCell[70]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 70, CAN_SIGNAL_FW(TCell[70])},
+    {"TCell[71]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 71, CAN_SIGNAL_FW(TCell[71])},
+    {"TCell[72]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 72, CAN_SIGNAL_FW(TCell[72])},
+    {"TCell[73]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 73, CAN_SIGNAL_FW(TCell[73])},
+    {"TCell[74]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 74, CAN_SIGNAL_FW(TCell[74])},
+    {"TCell[75]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 75, CAN_SIGNAL_FW(TCell[75])},
+    {"TCell[76]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 76, CAN_SIGNAL_FW(TCell[76])},
+    {"TCell[77]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 77, CAN_SIGNAL_FW(TCell[77])},
+    {"TCell[78]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 78, CAN_SIGNAL_FW(TCell[78])},
+    {"TCell[79]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 79, CAN_SIGNAL_FW(TCell[79])},
+    {"TCell[80]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 80, CAN_SIGNAL_FW(TCell[80])},
+    {"TCell[81]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 81, CAN_SIGNAL_FW(TCell[81])},
+    {"TCell[82]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 82, CAN_SIGNAL_FW(TCell[82])},
+    {"TCell[83]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 83, CAN_SIGNAL_FW(TCell[83])},
+    {"TCell[84]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 84, CAN_SIGNAL_FW(TCell[84])},
+    {"TCell[85]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 85, CAN_SIGNAL_FW(TCell[85])},
+    {"TCell[86]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 86, CAN_SIGNAL_FW(TCell[86])},
+    {"TCell[87]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 87, CAN_SIGNAL_FW(TCell[87])},
+    {"TCell[88]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 88, CAN_SIGNAL_FW(TCell[88])},
+    {"TCell[89]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 89, CAN_SIGNAL_FW(TCell[89])},
+    {"TCell[90]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 90, CAN_SIGNAL_FW(TCell[90])},
+    {"TCell[91]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 91, CAN_SIGNAL_FW(TCell[91])},
+    {"TCell[92]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 92, CAN_SIGNAL_FW(TCell[92])},
+    {"TCell[93]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 93, CAN_SIGNAL_FW(TCell[93])},
+    {"TCell[94]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 94, CAN_SIGNAL_FW(TCell[94])},
+    {"TCell[95]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 95, CAN_SIGNAL_FW(TCell[95])},
+    {"TCell[96]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 96, CAN_SIGNAL_FW(TCell[96])},
+    {"TCell[97]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 97, CAN_SIGNAL_FW(TCell[97])},
+    {"TCell[98]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 98, CAN_SIGNAL_FW(TCell[98])},
+    {"TCell[99]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 99, CAN_SIGNAL_FW(TCell[99])},
+    {"TCell[100]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 100, CAN_SIGNAL_FW(TCell[100])},
+    {"TCell[101]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 101, CAN_SIGNAL_FW(TCell[101])},
+    {"TCell[102]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 102, CAN_SIGNAL_FW(TCell[102])},
+    {"TCell[103]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 103, CAN_SIGNAL_FW(TCell[103])},
+    {"TCell[104]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 104, CAN_SIGNAL_FW(TCell[104])},
+    {"TCell[105]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 105, CAN_SIGNAL_FW(TCell[105])},
+    {"TCell[106]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 106, CAN_SIGNAL_FW(TCell[106])},
+    {"TCell[107]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 107, CAN_SIGNAL_FW(TCell[107])},
+    {"TCell[108]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 108, CAN_SIGNAL_FW(TCell[108])},
+    {"TCell[109]", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, 109, CAN_SIGNAL_FW(TCell[109])},
+    /* BMSCellTemp (0x1839F380) */
+    {"NTempMonNumber", 0, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NTempMonNumber)},
+    {"TCellMin", 8, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TCellMin)},
+    {"TCellMax", 16, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TCellMax)},
+    {"TCellAvg", 24, 8, FALSE, eCAN_SIGNAL_INT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(TCellAvg)},
+    {"NCellTemps", 32, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NCellTemps)},
+    {"NTCellMaxID", 40, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NTCellMaxID)},
+    {"NTCellMinID", 48, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NTCellMinID)},
+    /* TempMonAddressCast (0x18EEFF80) */
+    {"NTempMonJ1939Address", 7, 24, TRUE, eCAN_SIGNAL_UINT32, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NTempMonJ1939Address)},
+    {"NTempMonTargetAddress", 24, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NTempMonTargetAddress)},
+    {"NTempMonNumber", 32, 8, FALSE, eCAN_SIGNAL_UINT8, 1.0f, 0.0f, CAN_SIGNAL_NO_MUX, CAN_SIGNAL_FW(NTempMonNumber)},
+};
+
+const stCANMessage_t astCANMessages[] = {
+    {0x10, "ESPControl", 0, 6, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(ESPControlRx)},
+    {0x11, "MCUStatusTelemCar", 6, 8, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(MCUStatusTelemCarRx)},
+    {0x12, "MCUStatusTelemPits", 14, 8, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(MCUStatusTelemPitsRx)},
+    {0x13, "MCUStatusIMDMonitor", 22, 8, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(MCUStatusIMDMonitorRx)},
+    {0x14, "MCUStatusLogger", 30, 8, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(MCUStatusLoggerRx)},
+    {0x15, "MCUStatusPDU", 38, 8, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(MCUStatusPDURx)},
+    {0x16, "StatusAPPS", 46, 8, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(StatusAPPSRx)},
+    {0x17, "MCUStatusScreen", 54, 8, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(MCUStatusScreenRx)},
+    {0x18, "MCUStatusDash", 62, 8, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(MCUStatusDashRx)},
+    {0x19, "MCUStatusDyno", 70, 8, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(MCUStatusDynoRx)},
+    {0x1A, "MCUStatusTempMon", 78, 8, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(MCUStatusTempMonRx)},
+    {0x24, "SetAcCurrent", 86, 1, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(SetAcCurrentRx)},
+    {0x36, "CellVoltages", 87, 449, 0, 0, 0, CAN_SIGNAL_RX(CellVoltagesRx)},
+    {0x40, "IMDData", 536, 10, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(IMDDataRx)},
+    {0x44, "SetBrakeCurrent", 546, 1, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(SetBrakeCurrentRx)},
+    {0x64, "SetERPM", 547, 1, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(SetERPMRx)},
+    {0x81, "StatusAPPSSensor", 548, 7, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(StatusAPPSSensorRx)},
+    {0x84, "SetPosition", 555, 1, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(SetPositionRx)},
+    {0x90, "DynoPressuresRaw", 556, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(DynoPressuresRawRx)},
+    {0x91, "DynoTempsRaw", 560, 3, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(DynoTempsRawRx)},
+    {0x92, "DynoPressures", 563, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(DynoPressuresRx)},
+    {0x93, "DynoTemps", 567, 3, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(DynoTempsRx)},
+    {0x94, "DynoCooling", 570, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(DynoCoolingRx)},
+    {0xA4, "SetRelCurrent", 574, 1, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(SetRelCurrentRx)},
+    {0xB0, "PDUStats1", 575, 7, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(PDUStats1Rx)},
+    {0xB1, "PDUStats2", 582, 7, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(PDUStats2Rx)},
+    {0xB2, "PDUStats3", 589, 2, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(PDUStats3Rx)},
+    {0xC4, "SetRelBrakeCurrent", 591, 1, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(SetRelBrakeCurrentRx)},
+    {0xE4, "SetDigOutput", 592, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(SetDigOutputRx)},
+    {0x104, "SetMaxAcCurrent", 596, 1, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(SetMaxAcCurrentRx)},
+    {0x124, "SetMaxAcBrakeCurrent", 597, 1, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(SetMaxAcBrakeCurrentRx)},
+    {0x144, "SetMaxDcCurrent", 598, 1, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(SetMaxDcCurrentRx)},
+    {0x164, "SetMaxDcBrakeCurrent", 599, 1, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(SetMaxDcBrakeCurrentRx)},
+    {0x184, "SetDriveEnable", 600, 1, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(SetDriveEnableRx)},
+    {0x200, "FRTireTemp1", 601, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(FRTireTemp1Rx)},
+    {0x201, "FRTireTemp2", 605, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(FRTireTemp2Rx)},
+    {0x202, "FRTireTemp3", 609, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(FRTireTemp3Rx)},
+    {0x203, "FRTireTemp4", 613, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(FRTireTemp4Rx)},
+    {0x204, "FLTireTemp1", 617, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(FLTireTemp1Rx)},
+    {0x205, "FLTireTemp2", 621, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(FLTireTemp2Rx)},
+    {0x206, "FLTireTemp3", 625, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(FLTireTemp3Rx)},
+    {0x207, "FLTireTemp4", 629, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(FLTireTemp4Rx)},
+    {0x208, "RRTireTemp1", 633, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(RRTireTemp1Rx)},
+    {0x209, "RRTireTemp2", 637, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(RRTireTemp2Rx)},
+    {0x20A, "RRTireTemp3", 641, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(RRTireTemp3Rx)},
+    {0x20B, "RRTireTemp4", 645, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(RRTireTemp4Rx)},
+    {0x20C, "RLTireTemp1", 649, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(RLTireTemp1Rx)},
+    {0x20D, "RLTireTemp2", 653, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(RLTireTemp2Rx)},
+    {0x20E, "RLTireTemp3", 657, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(RLTireTemp3Rx)},
+    {0x20F, "RLTireTemp4", 661, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(RLTireTemp4Rx)},
+    {0x3E4, "TargetIqInfo", 665, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(TargetIqInfoRx)},
+    {0x404, "ERPM_DUTY_VOLTAGE", 669, 3, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(ERPM_DUTY_VOLTAGERx)},
+    {0x424, "AC_DC_current", 672, 2, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(AC_DC_currentRx)},
+    {0x444, "Temperatures", 674, 3, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(TemperaturesRx)},
+    {0x464, "FOC", 677, 2, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(FOCRx)},
+    {0x484, "Inverter_MISC", 679, 23, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(Inverter_MISCRx)},
+    {0x4A4, "MinMaxAcCurrent", 702, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(MinMaxAcCurrentRx)},
+    {0x4C4, "MinMaxDcCurrent", 706, 4, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(MinMaxDcCurrentRx)},
+    {0x6A0, "CellTempStats", 710, 357, 4, 0, 0, CAN_SIGNAL_RX(CellTempStatsRx)},
+    {0x6B0, "CellStats1", 1067, 19, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(CellStats1Rx)},
+    {0x6B1, "CellStats2", 1086, 6, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(CellStats2Rx)},
+    {0x6B2, "CellStats3", 1092, 9, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(CellStats3Rx)},
+    {0x6B3, "CellStats4", 1101, 3, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(CellStats4Rx)},
+    {0x1806E5F4, "ElconInterface2", 1104, 3, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(ElconInterface2Rx)},
+    {0x1806E7F4, "ElconInterface1", 1107, 3, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(ElconInterface1Rx)},
+    {0x1806E9F4, "ElconInterface3", 1110, 3, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(ElconInterface3Rx)},
+    {0x1838F380, "CellTempGeneral", 1113, 115, 4, 0, 0, CAN_SIGNAL_RX(CellTempGeneralRx)},
+    {0x1839F380, "BMSCellTemp", 1228, 7, CAN_SIGNAL_NO_MUX, 1, 7, CAN_SIGNAL_RX(BMSCellTempRx)},
+    {0x18EEFF80, "TempMonAddressCast", 1235, 3, CAN_SIGNAL_NO_MUX, 0, 0, CAN_SIGNAL_RX(TempMonAddressCastRx)},
+};
+
+const word wNCANSignals = 1238;
+const word wNCANMessages = 69;
@@ -0,0 +1,2136 @@
+/*
+sdlog_decode.c
+Decodes the v2 logs main/sdcard.c writes into the values of every signal, through the table
+decodeCAN.py writes to canSignalsAuto.c so each comes out as the firmware's Rx function would
+have it, see canSignals.h. Each signal is written on its own as time and value columns:
+    - csv: <out>/<Message>.<Signal>.csv, "time_s,<Signal>" then a row per time it was received.
+    - mf4: <out>/signals.mf4, ASAM MDF 4.1 with a channel group per signal, time the master.
+With -r the signals are instead held from one value to the next (zero order hold) and sampled at
+that rate into one table, <out>/resampled.csv or <out>/resampled.mf4, empty or NaN until a signal
+is first received. Parquet is not written, it needs a library this tool does without, convert the
+MF4 with asammdf if it is wanted.
+
+Logs are read the same way util/sdlog.py read_v2 does: any good block up to the file's valid
+bytes, past them only blocks that carry straight on from the one before, a bad one skipped a
+sector at a time. Frames blocks and frames lz blocks are decoded, the rest only counted. The files
+are taken as one recording in the order given.
+
+Each file is memory mapped and its block headers walked on the main thread, taking each one to be
+good. Worker threads then take the blocks in turn, check their CRC, decompress and decode them and
+group the values by signal, formatting them too for CSV. The main thread takes the blocks back in
+order, writing each one out as soon as it and the ones before it are done, and walks the file again
+itself from any block that turned out to be bad. The workers only get SD_DECODE_AHEAD blocks a
+thread in front of it, so memory does not grow with the log.
+
+Build:  gcc -O2 -pthread -o sdlog_decode sdlog_decode.c canSignals.c canSignalsAuto.c
+Usage:  sdlog_decode [-j threads] [-f csv|mf4] [-r Hz] [-s signal]... -o out log.bin...
+        -j defaults to the number of CPUs, -s takes "Signal", "Message.Signal" or an array's
+        name for all of it and can be given more than once, every signal is written without it.
+
+Written for Sheffield Formula Racing 2026
+*/
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include "canSignals.h"
+
+/* --------------------------- Definitions ----------------------------- */
+#define SD_LOG_FILE_VERSION     2
+#define SD_LOG_BLOCK_MAGIC      0x42524653  // "SFRB"
+#define SD_LOG_BLOCK_SIZE       16384       // Until the file block says otherwise
+#define SD_SECTOR_SIZE          512
+#define SD_LOG_RAW_LENGTH_SIZE  2
+#define SD_LOG_CRC_SIZE         4
+#define SD_LOG_EXTENDED         0x80        // Record header bits, see espnow.h
+#define SD_LOG_DLC_SHIFT        3
+#define SD_LOG_STD_ID_MASK      0x07
+#define SD_LOG_EXT_ID_MASK      0x1FFFFFFF
+#define SD_LOG_MAX_DLC          8
+
+#define SD_DECODE_AHEAD         8           // Blocks a thread past the last one written out
+#define SD_DECODE_LZ_SIZE       65536       // Most a frames lz block's raw length can say
+#define SD_DECODE_CSV_ROW       64          // Longest "time,value\n" row
+#define SD_DECODE_CSV_BUFFER    32768       // stdio buffer per signal's file
+#define SD_DECODE_DECIMALS      6           // Most a float is written with before printf
+#define SD_DECODE_FIXED_MAX     1e12        // Largest float written without printf
+#define SD_DECODE_MF4_FLUSH     65536       // Bytes of a signal's records per DT block
+#define SD_DECODE_MF4_ROWS      1048576     // Bytes of resampled records per DT block
+#define SD_DECODE_MAX_PATH      4096
+#define SD_DECODE_CRC_POLY      0xEDB88320
+
+#define MF4_ID_SIZE             64
+#define MF4_HEADER_SIZE         24
+#define MF4_VERSION             410
+#define MF4_HD_LINKS            6
+#define MF4_HD_DATA             32
+#define MF4_CN_LINKS            8
+#define MF4_CN_DATA             72
+#define MF4_CG_LINKS            6
+#define MF4_CG_DATA             32
+#define MF4_DG_LINKS            4
+#define MF4_DG_DATA             8
+#define MF4_FH_DATA             16
+#define MF4_CN_MASTER           2
+#define MF4_CN_SYNC_TIME        1
+#define MF4_CN_REAL_LE          4
+
+/* --------------------------- Local Types ----------------------------- */
+typedef enum {
+    eSD_BLOCK_FILE = 1,
+    eSD_BLOCK_FRAMES,
+    eSD_BLOCK_INDEX,
+    eSD_BLOCK_FOOTER,
+    eSD_BLOCK_TRIGGER,
+    eSD_BLOCK_FRAMES_LZ,
+} eSDLogBlock_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t dwMagic;
+    uint8_t  byType;
+    uint8_t  byReserved;
+    uint16_t wLength;
+    uint16_t wNFrames;
+    uint16_t wReserved;
+    uint32_t dwSequence;
+    uint64_t qwtBaseus;
+    uint32_t dwCRC;
+} stSDLogBlockHeader_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t  byVersion;
+    uint8_t  byReserved;
+    uint16_t wSectorSize;
+    uint16_t wBlockSize;
+    uint16_t wDeviceID;
+    uint64_t qwtOpenus;
+    uint8_t  abyClock[7];
+    uint8_t  byReserved2;
+    uint32_t dwFileID;
+    uint32_t dwReserved;
+    uint64_t qwValidBytes;
+    uint64_t qwFileBytes;
+} stSDLogFileHeader_t;
+
+#define SD_LOG_FILE_HEADER_OLD  offsetof(stSDLogFileHeader_t, dwFileID)    // Before the file ID and valid bytes
+
+typedef enum {
+    eDECODE_NO_MAGIC = 0,
+    eDECODE_BAD,                // Runs off the file, too long or a bad CRC
+    eDECODE_GOOD,
+} eDecodeState_t;
+
+typedef enum {
+    eFORMAT_CSV = 0,
+    eFORMAT_MF4,
+} eFormat_t;
+
+typedef struct {
+    qword qwtus;
+    double fValue;
+    word wSignal;
+} stSample_t;
+
+typedef struct {
+    const char *pszPath;
+    const byte *abyLog;
+    qword qwSize;
+    dword dwSectorSize;
+    dword dwBlockSize;
+    uint32_t dwFileID;
+    boolean BValid;             // FALSE for an old file block without the valid bytes
+    qword qwValidBytes;
+    dword dwFirstBlock;         // Its blocks in the walk
+    dword dwNBlocks;
+} stLogFile_t;
+
+typedef struct {
+    dword dwFile;
+    qword qwOffset;
+    volatile boolean BDone;
+    eDecodeState_t eState;
+    stSDLogBlockHeader_t stHeader;
+    boolean BShort;             // Records ran out part way or the frame count is wrong
+    dword dwNFrames;
+    dword dwNRefused;           // Frames of a message its Rx function would not take
+    dword dwNSamples;           // In frame order, or grouped by signal if astGroups is set
+    dword dwSampleSize;
+    stSample_t *astSamples;
+    dword dwNGroups;            // Signals with values in the block
+    word *awGroups;
+    dword *adwGroupStart;       // Each one's first sample, or first byte of pszText
+    char *pszText;
+} stBlock_t;
+
+typedef struct {
+    void *pvDecoder;
+    dword *adwCounts;           // Per signal, zeroed after each block
+    byte *abyRaw;               // Decompressed records
+    word *awSignals;            // One frame's values
+    double *afValues;
+    stSample_t *astSorted;
+    dword dwSortedSize;
+} stScratch_t;
+
+typedef struct {
+    byte *abyBuffer;
+    dword dwNBuffered;
+    qword qwNRecords;
+    qword *aqwBlocks;           // DT blocks written so far and the record bytes before each
+    qword *aqwBlockStart;
+    dword dwNBlocks;
+    dword dwBlocksSize;
+} stMF4Channel_t;
+
+typedef struct {
+    /* Options */
+    dword dwNThreads;
+    eFormat_t eFormat;
+    double fResampleHz;
+    const char *pszOut;
+    boolean *aBWanted;
+    boolean *aBMessageWanted;
+
+    /* Logs and the blocks the workers decode */
+    stLogFile_t *astFiles;
+    dword dwNFiles;
+    stBlock_t *astBlocks;
+    dword dwNBlocks;
+    dword dwBlocksSize;
+    dword dwNextBlock;
+    dword dwNWritten;
+    dword dwAhead;
+    pthread_mutex_t stLock;
+    pthread_cond_t stDone;
+    pthread_cond_t stSpace;
+
+    /* Counts */
+    qword qwNBlocks;
+    qword qwNFrameBlocks;
+    qword qwNLZBlocks;
+    qword qwNCorrupt;
+    qword qwNMissing;
+    qword qwNUnsynced;
+    qword qwNFrames;
+    qword qwNSamples;
+    qword qwNRefused;           // Frames an Rx function took but would have refused
+
+    /* Output */
+    FILE **apstCSV;
+    FILE *pstMF4;
+    stMF4Channel_t *astChannels;
+    dword dwNSignalsOut;
+
+    /* Resampling */
+    int32_t *anColumn;          // Per signal, -1 if not resampled
+    word *awColumns;
+    dword dwNColumns;
+    double *afHeld;
+    boolean BStarted;
+    qword qwtStartus;
+    qword qwNRows;
+    byte *abyRows;
+    dword dwNRowBytes;
+    qword *aqwRowBlocks;
+    qword *aqwRowBlockStart;
+    dword dwNRowBlocks;
+    dword dwRowBlocksSize;
+} stDecoder_t;
+
+/* --------------------------- Local Variables ------------------------ */
+static uint32_t adwCRCTable[8][256];
+
+/* --------------------------- Function prototypes --------------------- */
+static void SD_decode_crc_init(void);
+static uint32_t SD_decode_crc(uint32_t dwCRC, const byte *abyData, size_t length);
+static long SD_decode_lz(const byte *abySource, dword dwLength, byte *abyDest, dword dwDestSize);
+static boolean SD_decode_open(stDecoder_t *pstDecoder, const char *pszPath);
+static boolean SD_decode_walk(stDecoder_t *pstDecoder, dword dwFile);
+static void SD_decode_block(stDecoder_t *pstDecoder, stBlock_t *pstBlock, stScratch_t *pstScratch);
+static boolean SD_decode_frames(stDecoder_t *pstDecoder, stBlock_t *pstBlock, stScratch_t *pstScratch,
+                                const byte *abyRecords, dword dwLength);
+static void SD_decode_group(stDecoder_t *pstDecoder, stBlock_t *pstBlock, stScratch_t *pstScratch);
+static char *SD_decode_put_row(char *pszOut, qword qwtus, double fValue, eCANSignalType_t eType);
+static void *SD_decode_worker(void *pvArg);
+static stBlock_t *SD_decode_wait(stDecoder_t *pstDecoder, dword dwBlock);
+static void SD_decode_release(stDecoder_t *pstDecoder, dword dwBlock);
+static void SD_decode_free(stBlock_t *pstBlock);
+static void SD_decode_merge(stDecoder_t *pstDecoder, dword dwFile, stScratch_t *pstScratch);
+static void SD_decode_output(stDecoder_t *pstDecoder, stBlock_t *pstBlock);
+static boolean SD_decode_output_open(stDecoder_t *pstDecoder);
+static void SD_decode_output_close(stDecoder_t *pstDecoder);
+static void SD_decode_csv_signal(stDecoder_t *pstDecoder, word wSignal, const char *pszText, dword dwLength);
+static void SD_decode_mf4_signal(stDecoder_t *pstDecoder, word wSignal, const stSample_t *astSamples, dword dwN);
+static void SD_decode_resample(stDecoder_t *pstDecoder, const stSample_t *astSamples, dword dwN, boolean BLast);
+static void SD_decode_resample_row(stDecoder_t *pstDecoder, qword qwtus);
+static qword SD_decode_mf4_block(FILE *pstFile, const char *pszID, dword dwNLinks, const qword *aqwLinks,
+                                 const void *pvData, qword qwLength);
+static qword SD_decode_mf4_text(FILE *pstFile, const char *pszID, const char *pszText);
+static qword SD_decode_mf4_data(FILE *pstFile, const qword *aqwBlocks, const qword *aqwStart, dword dwNBlocks);
+static qword SD_decode_mf4_group(FILE *pstFile, qword qwNextGroup, const char *pszName, qword qwData,
+                                 qword qwNRecords, const word *awSignals, dword dwNSignals, boolean BFullNames);
+static void SD_decode_mf4_header(FILE *pstFile, qword qwFirstGroup, qword qwHistory);
+static void SD_decode_put(byte *abyData, dword dwAt, qword qwValue, dword dwSize);
+static const char *SD_decode_message_name(word wSignal);
+static boolean SD_decode_select(stDecoder_t *pstDecoder, const char *pszName);
+static double SD_decode_seconds(void);
+
+/* --------------------------- Functions ----------------------------- */
+int main(int argc, char **argv)
+{
+    /*
+    *===========================================================================
+    *   main
+    *   Takes:   argc, argv - see the top of the file
+    *
+    *   Returns: 0, 1 on bad arguments or if nothing could be read or written.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    stDecoder_t stDecoder;
+    stScratch_t stScratch;
+    pthread_t *astThreads;
+    stScratch_t *astScratch;
+    boolean BSelected = FALSE;
+    struct rlimit stLimit;
+    double fStart;
+    double fSeconds;
+    dword dwFile;
+    dword dwThread;
+    dword dwSignal;
+    int nOption;
+
+    memset(&stDecoder, 0, sizeof(stDecoder));
+    stDecoder.dwNThreads = (dword)sysconf(_SC_NPROCESSORS_ONLN);
+    if (!CAN_signals_init())
+    {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    stDecoder.aBWanted = calloc(wNCANSignals, sizeof(boolean));
+    stDecoder.aBMessageWanted = calloc(wNCANMessages, sizeof(boolean));
+    stDecoder.astFiles = calloc((size_t)argc, sizeof(stLogFile_t));
+
+    while ((nOption = getopt(argc, argv, "j:f:r:s:o:")) != -1)
+    {
+        switch (nOption)
+        {
+            case 'j':
+                stDecoder.dwNThreads = (dword)strtoul(optarg, NULL, 0);
+                break;
+            case 'f':
+                if (strcmp(optarg, "csv") == 0)
+                {
+                    stDecoder.eFormat = eFORMAT_CSV;
+                } else if (strcmp(optarg, "mf4") == 0)
+                {
+                    stDecoder.eFormat = eFORMAT_MF4;
+                } else
+                {
+                    fprintf(stderr, "Unknown format %s, csv or mf4\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'r':
+                stDecoder.fResampleHz = strtod(optarg, NULL);
+                break;
+            case 's':
+                if (!SD_decode_select(&stDecoder, optarg))
+                {
+                    fprintf(stderr, "No signal %s\n", optarg);
+                    return 1;
+                }
+                BSelected = TRUE;
+                break;
+            case 'o':
+                stDecoder.pszOut = optarg;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-j threads] [-f csv|mf4] [-r Hz] [-s signal]... -o out log.bin...\n", argv[0]);
+                return 1;
+        }
+    }
+    if (stDecoder.pszOut == NULL || optind >= argc || stDecoder.dwNThreads == 0 || stDecoder.fResampleHz < 0)
+    {
+        fprintf(stderr, "Usage: %s [-j threads] [-f csv|mf4] [-r Hz] [-s signal]... -o out log.bin...\n", argv[0]);
+        return 1;
+    }
+    for (dwSignal = 0; dwSignal < wNCANSignals; dwSignal++)
+    {
+        stDecoder.aBWanted[dwSignal] = stDecoder.aBWanted[dwSignal] || !BSelected;
+    }
+    for (dwFile = 0; dwFile < wNCANMessages; dwFile++)
+    {
+        for (dwSignal = 0; dwSignal < astCANMessages[dwFile].wNSignals; dwSignal++)
+        {
+            stDecoder.aBMessageWanted[dwFile] |= stDecoder.aBWanted[astCANMessages[dwFile].wFirstSignal + dwSignal];
+        }
+    }
+
+    /* A file open per signal for CSV */
+    if (getrlimit(RLIMIT_NOFILE, &stLimit) == 0)
+    {
+        stLimit.rlim_cur = stLimit.rlim_max;
+        (void)setrlimit(RLIMIT_NOFILE, &stLimit);
+    }
+
+    fStart = SD_decode_seconds();
+    SD_decode_crc_init();
+    for (; optind < argc; optind++)
+    {
+        if (SD_decode_open(&stDecoder, argv[optind]) && !SD_decode_walk(&stDecoder, stDecoder.dwNFiles - 1))
+        {
+            fprintf(stderr, "Out of memory\n");
+            return 1;
+        }
+    }
+    if (stDecoder.dwNFiles == 0 || !SD_decode_output_open(&stDecoder))
+    {
+        return 1;
+    }
+
+    /* Workers decode ahead while this thread writes out */
+    stDecoder.dwAhead = SD_DECODE_AHEAD * stDecoder.dwNThreads;
+    pthread_mutex_init(&stDecoder.stLock, NULL);
+    pthread_cond_init(&stDecoder.stDone, NULL);
+    pthread_cond_init(&stDecoder.stSpace, NULL);
+    astThreads = calloc(stDecoder.dwNThreads, sizeof(pthread_t));
+    astScratch = calloc(stDecoder.dwNThreads + 1, sizeof(stScratch_t));
+    for (dwThread = 0; dwThread <= stDecoder.dwNThreads; dwThread++)
+    {
+        astScratch[dwThread].adwCounts = calloc(wNCANSignals, sizeof(dword));
+        astScratch[dwThread].abyRaw = malloc(SD_DECODE_LZ_SIZE);
+        astScratch[dwThread].awSignals = malloc(wNCANSignals * sizeof(word));
+        astScratch[dwThread].afValues = malloc(wNCANSignals * sizeof(double));
+    }
+    for (dwThread = 0; dwThread < stDecoder.dwNThreads; dwThread++)
+    {
+        astScratch[dwThread].pvDecoder = &stDecoder;
+        pthread_create(&astThreads[dwThread], NULL, SD_decode_worker, &astScratch[dwThread]);
+    }
+
+    stScratch = astScratch[stDecoder.dwNThreads];
+    for (dwFile = 0; dwFile < stDecoder.dwNFiles; dwFile++)
+    {
+        SD_decode_merge(&stDecoder, dwFile, &stScratch);
+    }
+    for (dwThread = 0; dwThread < stDecoder.dwNThreads; dwThread++)
+    {
+        pthread_join(astThreads[dwThread], NULL);
+    }
+    SD_decode_output_close(&stDecoder);
+    fSeconds = SD_decode_seconds() - fStart;
+
+    printf("%lu files, %llu blocks, %llu frame blocks (%llu lz), %llu corrupt, %llu missing, %llu unsynced\n",
+           stDecoder.dwNFiles, stDecoder.qwNBlocks, stDecoder.qwNFrameBlocks, stDecoder.qwNLZBlocks,
+           stDecoder.qwNCorrupt, stDecoder.qwNMissing, stDecoder.qwNUnsynced);
+    printf("%llu frames, %llu values of %lu signals, %llu refused by their Rx function\n",
+           stDecoder.qwNFrames, stDecoder.qwNSamples, stDecoder.dwNSignalsOut, stDecoder.qwNRefused);
+    printf("%.3f s, %.0f frames/s on %lu threads\n", fSeconds, stDecoder.qwNFrames / fSeconds, stDecoder.dwNThreads);
+    return 0;
+}
+
+static void SD_decode_crc_init(void)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_crc_init
+    *   Takes:   None
+    *
+    *   Returns: Nothing.
+    *
+    *   Fills the tables SD_decode_crc takes 8 bytes at a time with.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    uint32_t dwCRC;
+    dword dwByte;
+    dword dwBit;
+    dword dwTable;
+
+    for (dwByte = 0; dwByte < 256; dwByte++)
+    {
+        dwCRC = (uint32_t)dwByte;
+        for (dwBit = 0; dwBit < 8; dwBit++)
+        {
+            dwCRC = (dwCRC & 1) ? (dwCRC >> 1) ^ SD_DECODE_CRC_POLY : dwCRC >> 1;
+        }
+        adwCRCTable[0][dwByte] = dwCRC;
+    }
+    for (dwByte = 0; dwByte < 256; dwByte++)
+    {
+        for (dwTable = 1; dwTable < 8; dwTable++)
+        {
+            dwCRC = adwCRCTable[dwTable - 1][dwByte];
+            adwCRCTable[dwTable][dwByte] = (dwCRC >> 8) ^ adwCRCTable[0][dwCRC & 0xFF];
+        }
+    }
+}
+
+static uint32_t SD_decode_crc(uint32_t dwCRC, const byte *abyData, size_t length)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_crc
+    *   Takes:   dwCRC - CRC so far, as zlib.crc32's second argument
+    *            abyData - bytes to add
+    *            length - how many
+    *
+    *   Returns: The CRC32, the same as esp_crc32_le and zlib.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    uint32_t dwLow;
+    uint32_t dwHigh;
+
+    dwCRC = ~dwCRC;
+    while (length >= 8)
+    {
+        memcpy(&dwLow, abyData, 4);
+        memcpy(&dwHigh, abyData + 4, 4);
+        dwLow ^= dwCRC;
+        dwCRC = adwCRCTable[7][dwLow & 0xFF] ^ adwCRCTable[6][(dwLow >> 8) & 0xFF] ^
+                adwCRCTable[5][(dwLow >> 16) & 0xFF] ^ adwCRCTable[4][dwLow >> 24] ^
+                adwCRCTable[3][dwHigh & 0xFF] ^ adwCRCTable[2][(dwHigh >> 8) & 0xFF] ^
+                adwCRCTable[1][(dwHigh >> 16) & 0xFF] ^ adwCRCTable[0][dwHigh >> 24];
+        abyData += 8;
+        length -= 8;
+    }
+    while (length-- > 0)
+    {
+        dwCRC = adwCRCTable[0][(dwCRC ^ *abyData++) & 0xFF] ^ (dwCRC >> 8);
+    }
+    return ~dwCRC;
+}
+
+static long SD_decode_lz(const byte *abySource, dword dwLength, byte *abyDest, dword dwDestSize)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_lz
+    *   Takes:   abySource - a frames lz block's records
+    *            dwLength - how many bytes
+    *            abyDest - where the frames block's records go
+    *            dwDestSize - its size
+    *
+    *   Returns: Their length, -1 if they do not decode to the raw length
+    *            given. Mirror of sdlog.py's lz_decompress.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    dword dwRawLength;
+    dword dwIn = SD_LOG_RAW_LENGTH_SIZE;
+    dword dwOut = 0;
+    dword dwCount;
+    dword dwOffset;
+    byte byToken;
+    byte byMore;
+
+    if (dwLength < SD_LOG_RAW_LENGTH_SIZE)
+    {
+        return -1;
+    }
+    dwRawLength = (dword)(abySource[0] | (abySource[1] << 8));
+    while (dwIn < dwLength)
+    {
+        byToken = abySource[dwIn++];
+        dwCount = byToken >> 4;
+        if (dwCount == 15)
+        {
+            do
+            {
+                if (dwIn >= dwLength)
+                {
+                    return -1;
+                }
+                byMore = abySource[dwIn++];
+                dwCount += byMore;
+            } while (byMore == 255);
+        }
+        if (dwIn + dwCount > dwLength || dwOut + dwCount > dwDestSize)
+        {
+            return -1;
+        }
+        memcpy(&abyDest[dwOut], &abySource[dwIn], dwCount);
+        dwIn += dwCount;
+        dwOut += dwCount;
+        if (dwIn >= dwLength)
+        {
+            break;
+        }
+
+        if (dwIn + 2 > dwLength)
+        {
+            return -1;
+        }
+        dwOffset = (dword)(abySource[dwIn] | (abySource[dwIn + 1] << 8));
+        dwIn += 2;
+        dwCount = (byToken & 0x0F) + 4;
+        if (dwCount == 19)
+        {
+            do
+            {
+                if (dwIn >= dwLength)
+                {
+                    return -1;
+                }
+                byMore = abySource[dwIn++];
+                dwCount += byMore;
+            } while (byMore == 255);
+        }
+        if (dwOffset == 0 || dwOffset > dwOut || dwOut + dwCount > dwDestSize)
+        {
+            return -1;
+        }
+        /* A match may overlap what it writes, a byte at a time copies the run */
+        for (; dwCount > 0; dwCount--, dwOut++)
+        {
+            abyDest[dwOut] = abyDest[dwOut - dwOffset];
+        }
+    }
+    return dwOut == dwRawLength ? (long)dwOut : -1;
+}
+
+static boolean SD_decode_open(stDecoder_t *pstDecoder, const char *pszPath)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_open
+    *   Takes:   pstDecoder - the decoder
+    *            pszPath - a log
+    *
+    *   Returns: FALSE if it cannot be read, which is reported.
+    *
+    *   Maps the log and reads its file block for the sector and block sizes,
+    *   the file ID every other block's CRC starts from and the valid bytes.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    stLogFile_t *pstFile = &pstDecoder->astFiles[pstDecoder->dwNFiles];
+    stSDLogBlockHeader_t stHeader;
+    stSDLogFileHeader_t stFileHeader;
+    struct stat stStat;
+    const byte *abyRecords;
+    int nFile;
+
+    nFile = open(pszPath, O_RDONLY);
+    if (nFile < 0 || fstat(nFile, &stStat) != 0)
+    {
+        fprintf(stderr, "%s: %s\n", pszPath, strerror(errno));
+        if (nFile >= 0)
+        {
+            close(nFile);
+        }
+        return FALSE;
+    }
+    memset(pstFile, 0, sizeof(*pstFile));
+    pstFile->pszPath = pszPath;
+    pstFile->qwSize = (qword)stStat.st_size;
+    pstFile->dwSectorSize = SD_SECTOR_SIZE;
+    pstFile->dwBlockSize = SD_LOG_BLOCK_SIZE;
+    if (pstFile->qwSize < sizeof(stSDLogBlockHeader_t))
+    {
+        fprintf(stderr, "%s: not a v2 log\n", pszPath);
+        close(nFile);
+        return FALSE;
+    }
+    pstFile->abyLog = mmap(NULL, pstFile->qwSize, PROT_READ, MAP_PRIVATE, nFile, 0);
+    close(nFile);
+    if (pstFile->abyLog == MAP_FAILED)
+    {
+        fprintf(stderr, "%s: %s\n", pszPath, strerror(errno));
+        return FALSE;
+    }
+    (void)madvise((void *)pstFile->abyLog, pstFile->qwSize, MADV_SEQUENTIAL);
+
+    memcpy(&stHeader, pstFile->abyLog, sizeof(stHeader));
+    if (stHeader.dwMagic != SD_LOG_BLOCK_MAGIC)
+    {
+        fprintf(stderr, "%s: not a v2 log, sdlog.py convert reads v1\n", pszPath);
+        munmap((void *)pstFile->abyLog, pstFile->qwSize);
+        return FALSE;
+    }
+
+    /* The file block's CRC starts from 0, as read_v2 a bad one leaves the defaults */
+    abyRecords = pstFile->abyLog + sizeof(stHeader);
+    if (stHeader.byType == eSD_BLOCK_FILE && stHeader.wLength >= SD_LOG_FILE_HEADER_OLD &&
+        stHeader.wLength <= SD_LOG_BLOCK_SIZE && sizeof(stHeader) + stHeader.wLength <= pstFile->qwSize &&
+        SD_decode_crc(SD_decode_crc(0, pstFile->abyLog, sizeof(stHeader) - SD_LOG_CRC_SIZE), abyRecords,
+                      stHeader.wLength) == stHeader.dwCRC)
+    {
+        memset(&stFileHeader, 0, sizeof(stFileHeader));
+        memcpy(&stFileHeader, abyRecords,
+               stHeader.wLength < sizeof(stFileHeader) ? stHeader.wLength : sizeof(stFileHeader));
+        pstFile->dwSectorSize = stFileHeader.wSectorSize > 0 ? stFileHeader.wSectorSize : SD_SECTOR_SIZE;
+        pstFile->dwBlockSize = stFileHeader.wBlockSize;
+        pstFile->dwFileID = stFileHeader.dwFileID;
+        pstFile->BValid = stHeader.wLength >= sizeof(stFileHeader);
+        pstFile->qwValidBytes = stFileHeader.qwValidBytes;
+    }
+    pstDecoder->dwNFiles++;
+    return TRUE;
+}
+
+static boolean SD_decode_walk(stDecoder_t *pstDecoder, dword dwFile)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_walk
+    *   Takes:   pstDecoder - the decoder
+    *            dwFile - a log SD_decode_open has read
+    *
+    *   Returns: FALSE if out of memory.
+    *
+    *   Adds each block to the workers' list, taking it to be as long as its
+    *   header says without checking its CRC. SD_decode_merge takes over where
+    *   that turns out to be wrong.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    stLogFile_t *pstFile = &pstDecoder->astFiles[dwFile];
+    stSDLogBlockHeader_t stHeader;
+    qword qwOffset = 0;
+    qword qwLength;
+    boolean BTrusted;
+    stBlock_t *astGrown;
+
+    pstFile->dwFirstBlock = pstDecoder->dwNBlocks;
+    while (qwOffset + sizeof(stHeader) <= pstFile->qwSize)
+    {
+        BTrusted = qwOffset == 0 || !pstFile->BValid || qwOffset < pstFile->qwValidBytes;
+        memcpy(&stHeader, pstFile->abyLog + qwOffset, sizeof(stHeader));
+        if (stHeader.dwMagic != SD_LOG_BLOCK_MAGIC || stHeader.wLength > pstFile->dwBlockSize ||
+            qwOffset + sizeof(stHeader) + stHeader.wLength > pstFile->qwSize)
+        {
+            if (!BTrusted)
+            {
+                break;
+            }
+            qwOffset += pstFile->dwSectorSize;
+            continue;
+        }
+
+        if (pstDecoder->dwNBlocks == pstDecoder->dwBlocksSize)
+        {
+            pstDecoder->dwBlocksSize = pstDecoder->dwBlocksSize ? 2 * pstDecoder->dwBlocksSize : 1024;
+            astGrown = realloc(pstDecoder->astBlocks, pstDecoder->dwBlocksSize * sizeof(stBlock_t));
+            if (astGrown == NULL)
+            {
+                return FALSE;
+            }
+            pstDecoder->astBlocks = astGrown;
+        }
+        memset(&pstDecoder->astBlocks[pstDecoder->dwNBlocks], 0, sizeof(stBlock_t));
+        pstDecoder->astBlocks[pstDecoder->dwNBlocks].dwFile = dwFile;
+        pstDecoder->astBlocks[pstDecoder->dwNBlocks].qwOffset = qwOffset;
+        pstDecoder->dwNBlocks++;
+
+        qwLength = sizeof(stHeader) + stHeader.wLength;
+        qwOffset += (qwLength + pstFile->dwSectorSize - 1) / pstFile->dwSectorSize * pstFile->dwSectorSize;
+    }
+    pstFile->dwNBlocks = pstDecoder->dwNBlocks - pstFile->dwFirstBlock;
+    return TRUE;
+}
+
+static void SD_decode_block(stDecoder_t *pstDecoder, stBlock_t *pstBlock, stScratch_t *pstScratch)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_block
+    *   Takes:   pstDecoder - the decoder
+    *            pstBlock - file and offset of a block
+    *            pstScratch - the calling thread's
+    *
+    *   Returns: Nothing.
+    *
+    *   Checks the block at the offset as read_v2 would and decodes its frames
+    *   if it is a frames or frames lz block, grouping the values by signal
+    *   unless resampling.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    const stLogFile_t *pstFile = &pstDecoder->astFiles[pstBlock->dwFile];
+    const byte *abyBlock = pstFile->abyLog + pstBlock->qwOffset;
+    const byte *abyRecords = abyBlock + sizeof(stSDLogBlockHeader_t);
+    stSDLogBlockHeader_t *pstHeader = &pstBlock->stHeader;
+    uint32_t dwCRC;
+    long nRawLength;
+
+    memcpy(pstHeader, abyBlock, sizeof(*pstHeader));
+    if (pstHeader->dwMagic != SD_LOG_BLOCK_MAGIC)
+    {
+        pstBlock->eState = eDECODE_NO_MAGIC;
+        return;
+    }
+    dwCRC = SD_decode_crc(pstBlock->qwOffset ? pstFile->dwFileID : 0, abyBlock,
+                          sizeof(*pstHeader) - SD_LOG_CRC_SIZE);
+    if (pstBlock->qwOffset + sizeof(*pstHeader) + pstHeader->wLength > pstFile->qwSize ||
+        pstHeader->wLength > pstFile->dwBlockSize ||
+        SD_decode_crc(dwCRC, abyRecords, pstHeader->wLength) != pstHeader->dwCRC)
+    {
+        pstBlock->eState = eDECODE_BAD;
+        return;
+    }
+    pstBlock->eState = eDECODE_GOOD;
+
+    if (pstHeader->byType == eSD_BLOCK_FRAMES)
+    {
+        pstBlock->BShort = SD_decode_frames(pstDecoder, pstBlock, pstScratch, abyRecords, pstHeader->wLength);
+    } else if (pstHeader->byType == eSD_BLOCK_FRAMES_LZ)
+    {
+        nRawLength = SD_decode_lz(abyRecords, pstHeader->wLength, pstScratch->abyRaw, SD_DECODE_LZ_SIZE);
+        pstBlock->BShort = nRawLength < 0 ||
+                           SD_decode_frames(pstDecoder, pstBlock, pstScratch, pstScratch->abyRaw, (dword)nRawLength);
+    } else
+    {
+        return;
+    }
+    pstBlock->BShort = pstBlock->BShort || pstBlock->dwNFrames != pstHeader->wNFrames;
+    if (pstDecoder->fResampleHz == 0)
+    {
+        SD_decode_group(pstDecoder, pstBlock, pstScratch);
+    }
+}
+
+static boolean SD_decode_frames(stDecoder_t *pstDecoder, stBlock_t *pstBlock, stScratch_t *pstScratch,
+                                const byte *abyRecords, dword dwLength)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_frames
+    *   Takes:   pstDecoder - the decoder
+    *            pstBlock - a frames block
+    *            pstScratch - the calling thread's
+    *            abyRecords - its records, decompressed
+    *            dwLength - how many bytes
+    *
+    *   Returns: TRUE if the records ran out part way through a frame.
+    *
+    *   Mirror of sdlog.py's decode_records, each frame an Rx function takes
+    *   decoded through the signal table into the block's values.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    const stCANSignalMessage_t *pstMessage;
+    qword qwtus = pstBlock->stHeader.qwtBaseus;
+    qword qwDelta;
+    dword dwOffset = 0;
+    dword dwHeader;
+    dword dwShift;
+    dword dwID;
+    dword dwValue;
+    byte byDLC;
+    word wN;
+    stSample_t *astGrown;
+
+    while (dwOffset < dwLength)
+    {
+        dwHeader = (abyRecords[dwOffset] & SD_LOG_EXTENDED) ? 5 : 2;
+        byDLC = (byte)((abyRecords[dwOffset] >> SD_LOG_DLC_SHIFT) & 0x0F);
+        if (dwLength - dwOffset < dwHeader || byDLC > SD_LOG_MAX_DLC)
+        {
+            return TRUE;
+        }
+        if (dwHeader == 5)
+        {
+            dwID = ((dword)abyRecords[dwOffset + 1] << 24 | (dword)abyRecords[dwOffset + 2] << 16 |
+                    (dword)abyRecords[dwOffset + 3] << 8 | abyRecords[dwOffset + 4]) & SD_LOG_EXT_ID_MASK;
+        } else
+        {
+            dwID = (dword)(abyRecords[dwOffset] & SD_LOG_STD_ID_MASK) << 8 | abyRecords[dwOffset + 1];
+        }
+        dwOffset += dwHeader;
+        qwDelta = 0;
+        dwShift = 0;
+        do
+        {
+            if (dwOffset >= dwLength)
+            {
+                return TRUE;
+            }
+            if (dwShift < 64)
+            {
+                qwDelta |= (qword)(abyRecords[dwOffset] & 0x7F) << dwShift;
+            }
+            dwShift += 7;
+        } while (abyRecords[dwOffset++] & 0x80);
+        if (dwLength - dwOffset < byDLC)
+        {
+            return TRUE;
+        }
+        qwtus += qwDelta;
+        pstBlock->dwNFrames++;
+
+        pstMessage = CAN_signals_find((uint32_t)dwID);
+        if (pstMessage != NULL && pstDecoder->aBMessageWanted[pstMessage->pstMessage - astCANMessages])
+        {
+            wN = CAN_signals_decode(pstMessage, &abyRecords[dwOffset], byDLC, pstScratch->awSignals,
+                                    pstScratch->afValues);
+            pstBlock->dwNRefused += wN == 0;
+            if (pstBlock->dwNSamples + wN > pstBlock->dwSampleSize)
+            {
+                pstBlock->dwSampleSize = 2 * pstBlock->dwSampleSize + wN + 1024;
+                astGrown = realloc(pstBlock->astSamples, pstBlock->dwSampleSize * sizeof(stSample_t));
+                if (astGrown == NULL)
+                {
+                    fprintf(stderr, "Out of memory\n");
+                    exit(1);
+                }
+                pstBlock->astSamples = astGrown;
+            }
+            for (dwValue = 0; dwValue < wN; dwValue++)
+            {
+                if (pstDecoder->aBWanted[pstScratch->awSignals[dwValue]])
+                {
+                    pstBlock->astSamples[pstBlock->dwNSamples].qwtus = qwtus;
+                    pstBlock->astSamples[pstBlock->dwNSamples].fValue = pstScratch->afValues[dwValue];
+                    pstBlock->astSamples[pstBlock->dwNSamples].wSignal = pstScratch->awSignals[dwValue];
+                    pstBlock->dwNSamples++;
+                }
+            }
+        }
+        dwOffset += byDLC;
+    }
+    return FALSE;
+}
+
+static void SD_decode_group(stDecoder_t *pstDecoder, stBlock_t *pstBlock, stScratch_t *pstScratch)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_group
+    *   Takes:   pstDecoder - the decoder
+    *            pstBlock - a decoded frames block
+    *            pstScratch - the calling thread's
+    *
+    *   Returns: Nothing.
+    *
+    *   Sorts the block's values by signal, keeping their order, so each
+    *   signal's are written out in one go. For CSV they are formatted here
+    *   too, where it is spread over the threads.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    dword *adwCounts = pstScratch->adwCounts;
+    const stSample_t *pstSample;
+    dword dwSample;
+    dword dwGroup;
+    dword dwStart = 0;
+    word wSignal;
+    char *pszOut;
+
+    if (pstBlock->dwNSamples == 0)
+    {
+        return;
+    }
+    pstBlock->awGroups = malloc(pstBlock->dwNSamples * sizeof(word));
+    pstBlock->adwGroupStart = malloc((pstBlock->dwNSamples + 1) * sizeof(dword));
+    if (pstScratch->dwSortedSize < pstBlock->dwNSamples)
+    {
+        free(pstScratch->astSorted);
+        pstScratch->dwSortedSize = pstBlock->dwNSamples;
+        pstScratch->astSorted = malloc(pstScratch->dwSortedSize * sizeof(stSample_t));
+    }
+    if (pstBlock->awGroups == NULL || pstBlock->adwGroupStart == NULL || pstScratch->astSorted == NULL)
+    {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+
+    /* Count each signal's values, then each one's start in the sorted copy */
+    for (dwSample = 0; dwSample < pstBlock->dwNSamples; dwSample++)
+    {
+        wSignal = pstBlock->astSamples[dwSample].wSignal;
+        if (adwCounts[wSignal]++ == 0)
+        {
+            pstBlock->awGroups[pstBlock->dwNGroups++] = wSignal;
+        }
+    }
+    for (dwGroup = 0; dwGroup < pstBlock->dwNGroups; dwGroup++)
+    {
+        wSignal = pstBlock->awGroups[dwGroup];
+        pstBlock->adwGroupStart[dwGroup] = dwStart;
+        dwStart += adwCounts[wSignal];
+        adwCounts[wSignal] = pstBlock->adwGroupStart[dwGroup];
+    }
+    pstBlock->adwGroupStart[pstBlock->dwNGroups] = dwStart;
+    for (dwSample = 0; dwSample < pstBlock->dwNSamples; dwSample++)
+    {
+        pstSample = &pstBlock->astSamples[dwSample];
+        pstScratch->astSorted[adwCounts[pstSample->wSignal]++] = *pstSample;
+    }
+    for (dwGroup = 0; dwGroup < pstBlock->dwNGroups; dwGroup++)
+    {
+        adwCounts[pstBlock->awGroups[dwGroup]] = 0;
+    }
+
+    if (pstDecoder->eFormat != eFORMAT_CSV)
+    {
+        memcpy(pstBlock->astSamples, pstScratch->astSorted, pstBlock->dwNSamples * sizeof(stSample_t));
+        return;
+    }
+    pstBlock->pszText = malloc((size_t)pstBlock->dwNSamples * SD_DECODE_CSV_ROW);
+    if (pstBlock->pszText == NULL)
+    {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    pszOut = pstBlock->pszText;
+    for (dwGroup = 0; dwGroup < pstBlock->dwNGroups; dwGroup++)
+    {
+        wSignal = pstBlock->awGroups[dwGroup];
+        dwStart = pstBlock->adwGroupStart[dwGroup];
+        pstBlock->adwGroupStart[dwGroup] = (dword)(pszOut - pstBlock->pszText);
+        for (dwSample = dwStart; dwSample < pstBlock->adwGroupStart[dwGroup + 1]; dwSample++)
+        {
+            pszOut = SD_decode_put_row(pszOut, pstScratch->astSorted[dwSample].qwtus,
+                                       pstScratch->astSorted[dwSample].fValue, astCANSignals[wSignal].eType);
+        }
+    }
+    pstBlock->adwGroupStart[pstBlock->dwNGroups] = (dword)(pszOut - pstBlock->pszText);
+    free(pstBlock->astSamples);
+    pstBlock->astSamples = NULL;
+}
+
+static char *SD_decode_put_row(char *pszOut, qword qwtus, double fValue, eCANSignalType_t eType)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_put_row
+    *   Takes:   pszOut - where the row goes, SD_DECODE_CSV_ROW bytes
+    *            qwtus - time, us since power up
+    *            fValue - value
+    *            eType - its type, only a float has anything after the point
+    *
+    *   Returns: The end of the row.
+    *
+    *   Writes "seconds,value\n", the time to the us. A float is written
+    *   with the fewest decimals it reads back from, only going through
+    *   printf if that is more than SD_DECODE_DECIMALS, as printf is most of
+    *   the cost of writing CSV.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    static const double afPowers[SD_DECODE_DECIMALS + 1] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6};
+    char szDigits[24];
+    dword dwN = 0;
+    dword dwDigit;
+    dword dwDecimals = 0;
+    qword qwWhole = qwtus / 1000000;
+    dword dwFraction = (dword)(qwtus % 1000000);
+    int64_t nValue;
+
+    do
+    {
+        szDigits[dwN++] = (char)('0' + qwWhole % 10);
+        qwWhole /= 10;
+    } while (qwWhole > 0);
+    while (dwN > 0)
+    {
+        *pszOut++ = szDigits[--dwN];
+    }
+    *pszOut++ = '.';
+    for (dwDigit = 6; dwDigit-- > 0;)
+    {
+        pszOut[dwDigit] = (char)('0' + dwFraction % 10);
+        dwFraction /= 10;
+    }
+    pszOut += 6;
+    *pszOut++ = ',';
+
+    if (eType == eCAN_SIGNAL_FLOAT)
+    {
+        /* The fewest decimals that read back as the same float, printf if it needs more */
+        for (dwDecimals = 0; dwDecimals <= SD_DECODE_DECIMALS && fabs(fValue) < SD_DECODE_FIXED_MAX; dwDecimals++)
+        {
+            nValue = llround(fValue * afPowers[dwDecimals]);
+            if ((float)((double)nValue / afPowers[dwDecimals]) == (float)fValue)
+            {
+                break;
+            }
+        }
+        if (dwDecimals > SD_DECODE_DECIMALS || fabs(fValue) >= SD_DECODE_FIXED_MAX)
+        {
+            return pszOut + snprintf(pszOut, SD_DECODE_CSV_ROW - 32, "%.9g\n", fValue);
+        }
+    } else
+    {
+        nValue = (int64_t)fValue;
+    }
+    if (nValue < 0)
+    {
+        *pszOut++ = '-';
+        nValue = -nValue;
+    }
+    do
+    {
+        szDigits[dwN++] = (char)('0' + nValue % 10);
+        nValue /= 10;
+    } while (nValue > 0 || dwN <= dwDecimals);
+    while (dwN > 0)
+    {
+        *pszOut++ = szDigits[--dwN];
+        if (dwN == dwDecimals && dwN > 0)
+        {
+            *pszOut++ = '.';
+        }
+    }
+    *pszOut++ = '\n';
+    return pszOut;
+}
+
+static void *SD_decode_worker(void *pvArg)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_worker
+    *   Takes:   pvArg - the thread's stScratch_t
+    *
+    *   Returns: NULL once every block has been taken.
+    *
+    *   Takes the next block no more than dwAhead past the last one written
+    *   out and decodes it.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    stScratch_t *pstScratch = pvArg;
+    stDecoder_t *pstDecoder = pstScratch->pvDecoder;
+    dword dwBlock;
+
+    pthread_mutex_lock(&pstDecoder->stLock);
+    while (TRUE)
+    {
+        while (pstDecoder->dwNextBlock < pstDecoder->dwNBlocks &&
+               pstDecoder->dwNextBlock >= pstDecoder->dwNWritten + pstDecoder->dwAhead)
+        {
+            pthread_cond_wait(&pstDecoder->stSpace, &pstDecoder->stLock);
+        }
+        if (pstDecoder->dwNextBlock >= pstDecoder->dwNBlocks)
+        {
+            break;
+        }
+        dwBlock = pstDecoder->dwNextBlock++;
+        pthread_mutex_unlock(&pstDecoder->stLock);
+
+        SD_decode_block(pstDecoder, &pstDecoder->astBlocks[dwBlock], pstScratch);
+
+        pthread_mutex_lock(&pstDecoder->stLock);
+        pstDecoder->astBlocks[dwBlock].BDone = TRUE;
+        pthread_cond_broadcast(&pstDecoder->stDone);
+    }
+    pthread_mutex_unlock(&pstDecoder->stLock);
+    return NULL;
+}
+
+static stBlock_t *SD_decode_wait(stDecoder_t *pstDecoder, dword dwBlock)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_wait
+    *   Takes:   pstDecoder - the decoder
+    *            dwBlock - the next block to write out
+    *
+    *   Returns: It, once a worker has decoded it.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    pthread_mutex_lock(&pstDecoder->stLock);
+    while (!pstDecoder->astBlocks[dwBlock].BDone)
+    {
+        pthread_cond_wait(&pstDecoder->stDone, &pstDecoder->stLock);
+    }
+    pthread_mutex_unlock(&pstDecoder->stLock);
+    return &pstDecoder->astBlocks[dwBlock];
+}
+
+static void SD_decode_release(stDecoder_t *pstDecoder, dword dwBlock)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_release
+    *   Takes:   pstDecoder - the decoder
+    *            dwBlock - block SD_decode_wait returned, finished with
+    *
+    *   Returns: Nothing.
+    *
+    *   Frees it and lets the workers a block further on.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    SD_decode_free(&pstDecoder->astBlocks[dwBlock]);
+    pthread_mutex_lock(&pstDecoder->stLock);
+    pstDecoder->dwNWritten = dwBlock + 1;
+    pthread_cond_broadcast(&pstDecoder->stSpace);
+    pthread_mutex_unlock(&pstDecoder->stLock);
+}
+
+static void SD_decode_free(stBlock_t *pstBlock)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_free
+    *   Takes:   pstBlock - a decoded block
+    *
+    *   Returns: Nothing.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    free(pstBlock->astSamples);
+    free(pstBlock->awGroups);
+    free(pstBlock->adwGroupStart);
+    free(pstBlock->pszText);
+    pstBlock->astSamples = NULL;
+    pstBlock->awGroups = NULL;
+    pstBlock->adwGroupStart = NULL;
+    pstBlock->pszText = NULL;
+}
+
+static void SD_decode_merge(stDecoder_t *pstDecoder, dword dwFile, stScratch_t *pstScratch)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_merge
+    *   Takes:   pstDecoder - the decoder
+    *            dwFile - a log SD_decode_walk has added
+    *            pstScratch - this thread's
+    *
+    *   Returns: Nothing.
+    *
+    *   Mirror of read_v2 through the log, taking each block the workers have
+    *   decoded where the walk found one and decoding any other itself, which
+    *   only happens after a bad block. Good frame blocks are written out.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    stLogFile_t *pstFile = &pstDecoder->astFiles[dwFile];
+    dword dwNext = pstFile->dwFirstBlock;
+    dword dwEnd = pstFile->dwFirstBlock + pstFile->dwNBlocks;
+    qword qwOffset = 0;
+    qword qwExpected = 0;
+    qword qwLength;
+    boolean BTrusted;
+    boolean BWalked;
+    boolean BEnd = FALSE;
+    stBlock_t stInline;
+    stBlock_t *pstBlock;
+
+    while (!BEnd && qwOffset + sizeof(stSDLogBlockHeader_t) <= pstFile->qwSize)
+    {
+        BTrusted = qwOffset == 0 || !pstFile->BValid || qwOffset < pstFile->qwValidBytes;
+        while (dwNext < dwEnd && pstDecoder->astBlocks[dwNext].qwOffset < qwOffset)
+        {
+            (void)SD_decode_wait(pstDecoder, dwNext);
+            SD_decode_release(pstDecoder, dwNext++);
+        }
+        BWalked = dwNext < dwEnd && pstDecoder->astBlocks[dwNext].qwOffset == qwOffset;
+        if (BWalked)
+        {
+            pstBlock = SD_decode_wait(pstDecoder, dwNext);
+        } else
+        {
+            memset(&stInline, 0, sizeof(stInline));
+            stInline.dwFile = dwFile;
+            stInline.qwOffset = qwOffset;
+            SD_decode_block(pstDecoder, &stInline, pstScratch);
+            pstBlock = &stInline;
+        }
+
+        if (pstBlock->eState != eDECODE_GOOD)
+        {
+            BEnd = !BTrusted;
+            pstDecoder->qwNCorrupt += pstBlock->eState == eDECODE_BAD && BTrusted;
+            qwOffset += pstFile->dwSectorSize;
+        } else if (!BTrusted && pstBlock->stHeader.dwSequence != qwExpected)
+        {
+            BEnd = TRUE;
+        } else
+        {
+            if (pstBlock->stHeader.byType == eSD_BLOCK_FRAMES || pstBlock->stHeader.byType == eSD_BLOCK_FRAMES_LZ)
+            {
+                pstDecoder->qwNFrameBlocks++;
+                pstDecoder->qwNLZBlocks += pstBlock->stHeader.byType == eSD_BLOCK_FRAMES_LZ;
+                pstDecoder->qwNCorrupt += pstBlock->BShort;
+                pstDecoder->qwNFrames += pstBlock->dwNFrames;
+                pstDecoder->qwNRefused += pstBlock->dwNRefused;
+                SD_decode_output(pstDecoder, pstBlock);
+            }
+            pstDecoder->qwNMissing += pstBlock->stHeader.dwSequence > qwExpected ?
+                                      pstBlock->stHeader.dwSequence - qwExpected : 0;
+            pstDecoder->qwNUnsynced += !BTrusted;
+            pstDecoder->qwNBlocks++;
+            qwExpected = (qword)pstBlock->stHeader.dwSequence + 1;
+            qwLength = sizeof(stSDLogBlockHeader_t) + pstBlock->stHeader.wLength;
+            qwOffset += (qwLength + pstFile->dwSectorSize - 1) / pstFile->dwSectorSize * pstFile->dwSectorSize;
+        }
+
+        if (BWalked)
+        {
+            SD_decode_release(pstDecoder, dwNext++);
+        } else
+        {
+            SD_decode_free(&stInline);
+        }
+    }
+
+    /* Blocks the walk found past where the log really ends */
+    for (; dwNext < dwEnd; dwNext++)
+    {
+        (void)SD_decode_wait(pstDecoder, dwNext);
+        SD_decode_release(pstDecoder, dwNext);
+    }
+    munmap((void *)pstFile->abyLog, pstFile->qwSize);
+}
+
+static void SD_decode_output(stDecoder_t *pstDecoder, stBlock_t *pstBlock)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_output
+    *   Takes:   pstDecoder - the decoder
+    *            pstBlock - a good frames block, in order
+    *
+    *   Returns: Nothing.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    dword dwGroup;
+    dword dwStart;
+    dword dwEnd;
+
+    pstDecoder->qwNSamples += pstBlock->dwNSamples;
+    if (pstDecoder->fResampleHz > 0)
+    {
+        SD_decode_resample(pstDecoder, pstBlock->astSamples, pstBlock->dwNSamples, FALSE);
+        return;
+    }
+    for (dwGroup = 0; dwGroup < pstBlock->dwNGroups; dwGroup++)
+    {
+        dwStart = pstBlock->adwGroupStart[dwGroup];
+        dwEnd = pstBlock->adwGroupStart[dwGroup + 1];
+        if (pstDecoder->eFormat == eFORMAT_CSV)
+        {
+            SD_decode_csv_signal(pstDecoder, pstBlock->awGroups[dwGroup], &pstBlock->pszText[dwStart], dwEnd - dwStart);
+        } else
+        {
+            SD_decode_mf4_signal(pstDecoder, pstBlock->awGroups[dwGroup], &pstBlock->astSamples[dwStart], dwEnd - dwStart);
+        }
+    }
+}
+
+static boolean SD_decode_output_open(stDecoder_t *pstDecoder)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_output_open
+    *   Takes:   pstDecoder - the decoder, options set
+    *
+    *   Returns: FALSE if the output cannot be written, which is reported.
+    *
+    *   Makes the output directory and opens what is written to as one file
+    *   from the start. A signal's own CSV is opened with its first value.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    char szPath[SD_DECODE_MAX_PATH];
+    const char *pszName;
+    FILE *pstFile;
+    dword dwSignal;
+
+    if (mkdir(pstDecoder->pszOut, 0777) != 0 && errno != EEXIST)
+    {
+        fprintf(stderr, "%s: %s\n", pstDecoder->pszOut, strerror(errno));
+        return FALSE;
+    }
+
+    if (pstDecoder->fResampleHz > 0)
+    {
+        pstDecoder->anColumn = malloc(wNCANSignals * sizeof(int32_t));
+        pstDecoder->awColumns = malloc(wNCANSignals * sizeof(word));
+        pstDecoder->afHeld = malloc(wNCANSignals * sizeof(double));
+        pstDecoder->abyRows = malloc(SD_DECODE_MF4_ROWS + (wNCANSignals + 1) * sizeof(double));
+        for (dwSignal = 0; dwSignal < wNCANSignals; dwSignal++)
+        {
+            pstDecoder->anColumn[dwSignal] = pstDecoder->aBWanted[dwSignal] ? (int32_t)pstDecoder->dwNColumns : -1;
+            if (pstDecoder->aBWanted[dwSignal])
+            {
+                pstDecoder->afHeld[pstDecoder->dwNColumns] = NAN;
+                pstDecoder->awColumns[pstDecoder->dwNColumns++] = (word)dwSignal;
+            }
+        }
+        pstDecoder->dwNSignalsOut = pstDecoder->dwNColumns;
+    } else if (pstDecoder->eFormat == eFORMAT_CSV)
+    {
+        pstDecoder->apstCSV = calloc(wNCANSignals, sizeof(FILE *));
+        return pstDecoder->apstCSV != NULL;
+    } else
+    {
+        pstDecoder->astChannels = calloc(wNCANSignals, sizeof(stMF4Channel_t));
+    }
+
+    snprintf(szPath, sizeof(szPath), "%s/%s.%s", pstDecoder->pszOut,
+             pstDecoder->fResampleHz > 0 ? "resampled" : "signals", pstDecoder->eFormat == eFORMAT_CSV ? "csv" : "mf4");
+    pstFile = fopen(szPath, "wb");
+    if (pstFile == NULL)
+    {
+        fprintf(stderr, "%s: %s\n", szPath, strerror(errno));
+        return FALSE;
+    }
+    if (pstDecoder->eFormat == eFORMAT_CSV)
+    {
+        /* Resampled, a column per signal */
+        fputs("time_s", pstFile);
+        for (dwSignal = 0; dwSignal < pstDecoder->dwNColumns; dwSignal++)
+        {
+            pszName = astCANSignals[pstDecoder->awColumns[dwSignal]].pszName;
+            fprintf(pstFile, ",%s.%s", SD_decode_message_name(pstDecoder->awColumns[dwSignal]), pszName);
+        }
+        fputc('\n', pstFile);
+        pstDecoder->apstCSV = calloc(1, sizeof(FILE *));
+        pstDecoder->apstCSV[0] = pstFile;
+    } else
+    {
+        /* Identification block, then the header block filled in at the end */
+        byte abyID[MF4_ID_SIZE] = {0};
+
+        memcpy(&abyID[0], "MDF     ", 8);
+        memcpy(&abyID[8], "4.10    ", 8);
+        memcpy(&abyID[16], "SFRdcode", 8);
+        SD_decode_put(abyID, 28, MF4_VERSION, 2);
+        fwrite(abyID, 1, sizeof(abyID), pstFile);
+        SD_decode_mf4_header(pstFile, 0, 0);
+        pstDecoder->pstMF4 = pstFile;
+    }
+    return TRUE;
+}
+
+static void SD_decode_output_close(stDecoder_t *pstDecoder)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_output_close
+    *   Takes:   pstDecoder - the decoder, every block written out
+    *
+    *   Returns: Nothing.
+    *
+    *   Finishes the resampled rows, closes the CSVs or writes the MF4's
+    *   channel groups, a data group each, and its header block.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    stMF4Channel_t *pstChannel;
+    qword qwGroup = 0;
+    qword qwData;
+    qword qwHistory;
+    qword aqwLinks[2] = {0, 0};
+    byte abyHistory[MF4_FH_DATA] = {0};
+    struct timespec stNow;
+    dword dwSignal;
+    word wSignal;
+    static const char szComment[] = "<FHcomment>\n<TX>Decoded from SFR SD card logs</TX>\n"
+                                    "<tool_id>sdlog_decode</tool_id>\n<tool_vendor>Sheffield Formula Racing</tool_vendor>\n"
+                                    "<tool_version>1</tool_version>\n</FHcomment>";
+
+    if (pstDecoder->fResampleHz > 0)
+    {
+        SD_decode_resample(pstDecoder, NULL, 0, TRUE);
+    }
+    if (pstDecoder->eFormat == eFORMAT_CSV)
+    {
+        for (dwSignal = 0; dwSignal < (pstDecoder->fResampleHz > 0 ? 1 : wNCANSignals); dwSignal++)
+        {
+            if (pstDecoder->apstCSV[dwSignal] != NULL)
+            {
+                fclose(pstDecoder->apstCSV[dwSignal]);
+            }
+        }
+        return;
+    }
+
+    if (pstDecoder->fResampleHz > 0)
+    {
+        if (pstDecoder->dwNRowBytes > 0)
+        {
+            pstDecoder->aqwRowBlocks[pstDecoder->dwNRowBlocks - 1] =
+                SD_decode_mf4_block(pstDecoder->pstMF4, "##DT", 0, NULL, pstDecoder->abyRows, pstDecoder->dwNRowBytes);
+        }
+        qwData = SD_decode_mf4_data(pstDecoder->pstMF4, pstDecoder->aqwRowBlocks, pstDecoder->aqwRowBlockStart,
+                                    pstDecoder->dwNRowBlocks);
+        qwGroup = SD_decode_mf4_group(pstDecoder->pstMF4, 0, "resampled", qwData, pstDecoder->qwNRows,
+                                      pstDecoder->awColumns, pstDecoder->dwNColumns, TRUE);
+    } else
+    {
+        /* Last signal first so each group can link to the next */
+        for (dwSignal = wNCANSignals; dwSignal-- > 0;)
+        {
+            pstChannel = &pstDecoder->astChannels[dwSignal];
+            if (pstChannel->qwNRecords == 0)
+            {
+                continue;
+            }
+            if (pstChannel->dwNBuffered > 0)
+            {
+                pstChannel->aqwBlocks[pstChannel->dwNBlocks - 1] =
+                    SD_decode_mf4_block(pstDecoder->pstMF4, "##DT", 0, NULL, pstChannel->abyBuffer, pstChannel->dwNBuffered);
+            }
+            qwData = SD_decode_mf4_data(pstDecoder->pstMF4, pstChannel->aqwBlocks, pstChannel->aqwBlockStart,
+                                        pstChannel->dwNBlocks);
+            wSignal = (word)dwSignal;
+            qwGroup = SD_decode_mf4_group(pstDecoder->pstMF4, qwGroup, SD_decode_message_name(wSignal), qwData,
+                                          pstChannel->qwNRecords, &wSignal, 1, FALSE);
+        }
+    }
+
+    /* File history, when it was written and by what */
+    clock_gettime(CLOCK_REALTIME, &stNow);
+    aqwLinks[1] = SD_decode_mf4_text(pstDecoder->pstMF4, "##MD", szComment);
+    SD_decode_put(abyHistory, 0, (qword)stNow.tv_sec * 1000000000ull + (qword)stNow.tv_nsec, 8);
+    qwHistory = SD_decode_mf4_block(pstDecoder->pstMF4, "##FH", 2, aqwLinks, abyHistory, sizeof(abyHistory));
+    fseeko(pstDecoder->pstMF4, MF4_ID_SIZE, SEEK_SET);
+    SD_decode_mf4_header(pstDecoder->pstMF4, qwGroup, qwHistory);
+    fclose(pstDecoder->pstMF4);
+}
+
+static void SD_decode_csv_signal(stDecoder_t *pstDecoder, word wSignal, const char *pszText, dword dwLength)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_csv_signal
+    *   Takes:   pstDecoder - the decoder
+    *            wSignal - row of astCANSignals
+    *            pszText - rows of its values
+    *            dwLength - how many bytes
+    *
+    *   Returns: Nothing, exits if its file cannot be written.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    char szPath[SD_DECODE_MAX_PATH];
+    FILE *pstFile = pstDecoder->apstCSV[wSignal];
+
+    if (pstFile == NULL)
+    {
+        snprintf(szPath, sizeof(szPath), "%s/%s.%s.csv", pstDecoder->pszOut, SD_decode_message_name(wSignal),
+                 astCANSignals[wSignal].pszName);
+        pstFile = fopen(szPath, "wb");
+        if (pstFile == NULL)
+        {
+            fprintf(stderr, "%s: %s\n", szPath, strerror(errno));
+            exit(1);
+        }
+        setvbuf(pstFile, NULL, _IOFBF, SD_DECODE_CSV_BUFFER);
+        fprintf(pstFile, "time_s,%s\n", astCANSignals[wSignal].pszName);
+        pstDecoder->apstCSV[wSignal] = pstFile;
+        pstDecoder->dwNSignalsOut++;
+    }
+    fwrite(pszText, 1, dwLength, pstFile);
+}
+
+static void SD_decode_mf4_signal(stDecoder_t *pstDecoder, word wSignal, const stSample_t *astSamples, dword dwN)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_mf4_signal
+    *   Takes:   pstDecoder - the decoder
+    *            wSignal - row of astCANSignals
+    *            astSamples - its values
+    *            dwN - how many
+    *
+    *   Returns: Nothing.
+    *
+    *   Adds [time s, value] records to the signal's buffer, writing it out as
+    *   a DT block each time it fills.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    stMF4Channel_t *pstChannel = &pstDecoder->astChannels[wSignal];
+    double afRecord[2];
+    dword dwSample;
+
+    if (pstChannel->abyBuffer == NULL)
+    {
+        pstChannel->abyBuffer = malloc(SD_DECODE_MF4_FLUSH);
+        pstDecoder->dwNSignalsOut++;
+    }
+    for (dwSample = 0; dwSample < dwN; dwSample++)
+    {
+        if (pstChannel->dwNBuffered == 0)
+        {
+            /* A DT block starts, its offset once it is written */
+            if (pstChannel->dwNBlocks == pstChannel->dwBlocksSize)
+            {
+                pstChannel->dwBlocksSize = pstChannel->dwBlocksSize ? 2 * pstChannel->dwBlocksSize : 16;
+                pstChannel->aqwBlocks = realloc(pstChannel->aqwBlocks, pstChannel->dwBlocksSize * sizeof(qword));
+                pstChannel->aqwBlockStart = realloc(pstChannel->aqwBlockStart, pstChannel->dwBlocksSize * sizeof(qword));
+            }
+            pstChannel->aqwBlockStart[pstChannel->dwNBlocks++] = pstChannel->qwNRecords * sizeof(afRecord);
+        }
+        afRecord[0] = (double)astSamples[dwSample].qwtus / 1e6;
+        afRecord[1] = astSamples[dwSample].fValue;
+        memcpy(&pstChannel->abyBuffer[pstChannel->dwNBuffered], afRecord, sizeof(afRecord));
+        pstChannel->dwNBuffered += sizeof(afRecord);
+        pstChannel->qwNRecords++;
+        if (pstChannel->dwNBuffered + sizeof(afRecord) > SD_DECODE_MF4_FLUSH)
+        {
+            pstChannel->aqwBlocks[pstChannel->dwNBlocks - 1] =
+                SD_decode_mf4_block(pstDecoder->pstMF4, "##DT", 0, NULL, pstChannel->abyBuffer, pstChannel->dwNBuffered);
+            pstChannel->dwNBuffered = 0;
+        }
+    }
+}
+
+static void SD_decode_resample(stDecoder_t *pstDecoder, const stSample_t *astSamples, dword dwN, boolean BLast)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_resample
+    *   Takes:   pstDecoder - the decoder
+    *            astSamples - a block's values in the order received
+    *            dwN - how many
+    *            BLast - TRUE once there are no more
+    *
+    *   Returns: Nothing.
+    *
+    *   Holds each signal's last value and writes a row for every tick of
+    *   the -r rate from the first value, each row with what was held at its
+    *   time. A row is written once a value after it comes in, the last ones
+    *   up to the last value at the end.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    static qword qwtLastus;
+    qword qwtRowus;
+    dword dwSample;
+    int32_t nColumn;
+
+    for (dwSample = 0; dwSample < dwN; dwSample++)
+    {
+        nColumn = pstDecoder->anColumn[astSamples[dwSample].wSignal];
+        if (nColumn < 0)
+        {
+            continue;
+        }
+        if (!pstDecoder->BStarted)
+        {
+            pstDecoder->BStarted = TRUE;
+            pstDecoder->qwtStartus = astSamples[dwSample].qwtus;
+        }
+        while (TRUE)
+        {
+            qwtRowus = pstDecoder->qwtStartus + (qword)llround((double)pstDecoder->qwNRows * 1e6 / pstDecoder->fResampleHz);
+            if (qwtRowus >= astSamples[dwSample].qwtus)
+            {
+                break;
+            }
+            SD_decode_resample_row(pstDecoder, qwtRowus);
+        }
+        pstDecoder->afHeld[nColumn] = astSamples[dwSample].fValue;
+        qwtLastus = astSamples[dwSample].qwtus;
+    }
+
+    while (BLast && pstDecoder->BStarted)
+    {
+        qwtRowus = pstDecoder->qwtStartus + (qword)llround((double)pstDecoder->qwNRows * 1e6 / pstDecoder->fResampleHz);
+        if (qwtRowus > qwtLastus)
+        {
+            break;
+        }
+        SD_decode_resample_row(pstDecoder, qwtRowus);
+    }
+}
+
+static void SD_decode_resample_row(stDecoder_t *pstDecoder, qword qwtus)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_resample_row
+    *   Takes:   pstDecoder - the decoder
+    *            qwtus - the row's time
+    *
+    *   Returns: Nothing.
+    *
+    *   Writes a row of the held values, a CSV line or an MF4 record of
+    *   doubles, time in s first.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    char szRow[SD_DECODE_CSV_ROW];
+    char *pszValue;
+    dword dwColumn;
+    dword dwRowSize = (pstDecoder->dwNColumns + 1) * sizeof(double);
+    double fTime = (double)qwtus / 1e6;
+    FILE *pstFile;
+
+    pstDecoder->qwNRows++;
+    if (pstDecoder->eFormat == eFORMAT_CSV)
+    {
+        pstFile = pstDecoder->apstCSV[0];
+        pszValue = SD_decode_put_row(szRow, qwtus, 0, eCAN_SIGNAL_UINT8);
+        fwrite(szRow, 1, (size_t)(pszValue - szRow - 3), pstFile);     // Up to the comma
+        for (dwColumn = 0; dwColumn < pstDecoder->dwNColumns; dwColumn++)
+        {
+            fputc(',', pstFile);
+            if (!isnan(pstDecoder->afHeld[dwColumn]))
+            {
+                pszValue = SD_decode_put_row(szRow, 0, pstDecoder->afHeld[dwColumn],
+                                             astCANSignals[pstDecoder->awColumns[dwColumn]].eType);
+                fwrite(&szRow[9], 1, (size_t)(pszValue - szRow - 10), pstFile);    // After "0.000000,", before '\n'
+            }
+        }
+        fputc('\n', pstFile);
+        return;
+    }
+
+    if (pstDecoder->dwNRowBytes == 0)
+    {
+        if (pstDecoder->dwNRowBlocks == pstDecoder->dwRowBlocksSize)
+        {
+            pstDecoder->dwRowBlocksSize = pstDecoder->dwRowBlocksSize ? 2 * pstDecoder->dwRowBlocksSize : 16;
+            pstDecoder->aqwRowBlocks = realloc(pstDecoder->aqwRowBlocks, pstDecoder->dwRowBlocksSize * sizeof(qword));
+            pstDecoder->aqwRowBlockStart = realloc(pstDecoder->aqwRowBlockStart, pstDecoder->dwRowBlocksSize * sizeof(qword));
+        }
+        pstDecoder->aqwRowBlockStart[pstDecoder->dwNRowBlocks++] = (pstDecoder->qwNRows - 1) * dwRowSize;
+    }
+    memcpy(&pstDecoder->abyRows[pstDecoder->dwNRowBytes], &fTime, sizeof(fTime));
+    memcpy(&pstDecoder->abyRows[pstDecoder->dwNRowBytes + sizeof(fTime)], pstDecoder->afHeld,
+           pstDecoder->dwNColumns * sizeof(double));
+    pstDecoder->dwNRowBytes += dwRowSize;
+    if (pstDecoder->dwNRowBytes >= SD_DECODE_MF4_ROWS)
+    {
+        pstDecoder->aqwRowBlocks[pstDecoder->dwNRowBlocks - 1] =
+            SD_decode_mf4_block(pstDecoder->pstMF4, "##DT", 0, NULL, pstDecoder->abyRows, pstDecoder->dwNRowBytes);
+        pstDecoder->dwNRowBytes = 0;
+    }
+}
+
+static qword SD_decode_mf4_block(FILE *pstFile, const char *pszID, dword dwNLinks, const qword *aqwLinks,
+                                 const void *pvData, qword qwLength)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_mf4_block
+    *   Takes:   pstFile - the MF4, at the end
+    *            pszID - block type, "##DT"
+    *            dwNLinks - how many links
+    *            aqwLinks - file offsets of the blocks it links to, 0 for none
+    *            pvData - its data
+    *            qwLength - how many bytes
+    *
+    *   Returns: Its offset.
+    *
+    *   Writes the 24 byte block header, links and data, then pads to the 8
+    *   bytes the next block has to start on.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    static const byte abyPadding[8] = {0};
+    byte abyHeader[MF4_HEADER_SIZE] = {0};
+    qword qwAt = (qword)ftello(pstFile);
+    qword qwBlockLength = MF4_HEADER_SIZE + 8ull * dwNLinks + qwLength;
+    dword dwLink;
+
+    memcpy(abyHeader, pszID, 4);
+    SD_decode_put(abyHeader, 8, qwBlockLength, 8);
+    SD_decode_put(abyHeader, 16, dwNLinks, 8);
+    fwrite(abyHeader, 1, sizeof(abyHeader), pstFile);
+    for (dwLink = 0; dwLink < dwNLinks; dwLink++)
+    {
+        byte abyLink[8];
+
+        SD_decode_put(abyLink, 0, aqwLinks[dwLink], 8);
+        fwrite(abyLink, 1, sizeof(abyLink), pstFile);
+    }
+    fwrite(pvData, 1, qwLength, pstFile);
+    fwrite(abyPadding, 1, (size_t)(-qwBlockLength & 7), pstFile);
+    return qwAt;
+}
+
+static qword SD_decode_mf4_text(FILE *pstFile, const char *pszID, const char *pszText)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_mf4_text
+    *   Takes:   pstFile - the MF4, at the end
+    *            pszID - "##TX" for a name, "##MD" for XML
+    *            pszText - the text
+    *
+    *   Returns: The offset of a block holding it.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    char szText[SD_DECODE_MAX_PATH] = {0};
+    size_t length = strlen(pszText);
+
+    length = length < sizeof(szText) - 1 ? length : sizeof(szText) - 1;
+    memcpy(szText, pszText, length);
+    return SD_decode_mf4_block(pstFile, pszID, 0, NULL, szText, (length + 1 + 7) / 8 * 8);
+}
+
+static qword SD_decode_mf4_data(FILE *pstFile, const qword *aqwBlocks, const qword *aqwStart, dword dwNBlocks)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_mf4_data
+    *   Takes:   pstFile - the MF4, at the end
+    *            aqwBlocks - a data group's DT blocks
+    *            aqwStart - the record bytes before each
+    *            dwNBlocks - how many
+    *
+    *   Returns: The offset of the one DT block or of a DL block listing them.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    qword *aqwLinks;
+    byte *abyData;
+    dword dwBlock;
+    qword qwAt;
+
+    if (dwNBlocks <= 1)
+    {
+        return dwNBlocks ? aqwBlocks[0] : 0;
+    }
+    aqwLinks = calloc(dwNBlocks + 1, sizeof(qword));
+    abyData = calloc(1, 8 + 8ull * dwNBlocks);
+    memcpy(&aqwLinks[1], aqwBlocks, dwNBlocks * sizeof(qword));
+    SD_decode_put(abyData, 4, dwNBlocks, 4);                    // Flags 0, the blocks are not all one length
+    for (dwBlock = 0; dwBlock < dwNBlocks; dwBlock++)
+    {
+        SD_decode_put(abyData, 8 + 8 * dwBlock, aqwStart[dwBlock], 8);
+    }
+    qwAt = SD_decode_mf4_block(pstFile, "##DL", dwNBlocks + 1, aqwLinks, abyData, 8 + 8ull * dwNBlocks);
+    free(aqwLinks);
+    free(abyData);
+    return qwAt;
+}
+
+static qword SD_decode_mf4_group(FILE *pstFile, qword qwNextGroup, const char *pszName, qword qwData,
+                                 qword qwNRecords, const word *awSignals, dword dwNSignals, boolean BFullNames)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_mf4_group
+    *   Takes:   pstFile - the MF4, at the end
+    *            qwNextGroup - data group to link on to, 0 for none
+    *            pszName - the channel group's acquisition name
+    *            qwData - its DT or DL block
+    *            qwNRecords - how many records
+    *            awSignals - the signals after the time in each record
+    *            dwNSignals - how many
+    *            BFullNames - TRUE to name the channels Message.Signal, as
+    *            the resampled ones are, FALSE for the signal's own name
+    *
+    *   Returns: The offset of the data group holding them.
+    *
+    *   Records are doubles, time in s the master channel.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    char szName[SD_DECODE_MAX_PATH];
+    byte abyChannel[MF4_CN_DATA];
+    byte abyGroup[MF4_CG_DATA] = {0};
+    byte abyDataGroup[MF4_DG_DATA] = {0};
+    qword aqwLinks[MF4_CN_LINKS];
+    qword qwNext = 0;
+    qword qwGroup;
+    dword dwSignal;
+
+    /* Value channels last first, each linking to the one after */
+    for (dwSignal = dwNSignals; dwSignal-- > 0;)
+    {
+        if (BFullNames)
+        {
+            snprintf(szName, sizeof(szName), "%s.%s", SD_decode_message_name(awSignals[dwSignal]),
+                     astCANSignals[awSignals[dwSignal]].pszName);
+        } else
+        {
+            snprintf(szName, sizeof(szName), "%s", astCANSignals[awSignals[dwSignal]].pszName);
+        }
+        memset(aqwLinks, 0, sizeof(aqwLinks));
+        memset(abyChannel, 0, sizeof(abyChannel));
+        aqwLinks[0] = qwNext;
+        aqwLinks[2] = SD_decode_mf4_text(pstFile, "##TX", szName);
+        abyChannel[2] = MF4_CN_REAL_LE;
+        SD_decode_put(abyChannel, 4, 8 * (dwSignal + 1), 4);
+        SD_decode_put(abyChannel, 8, 64, 4);
+        qwNext = SD_decode_mf4_block(pstFile, "##CN", MF4_CN_LINKS, aqwLinks, abyChannel, sizeof(abyChannel));
+    }
+
+    memset(aqwLinks, 0, sizeof(aqwLinks));
+    memset(abyChannel, 0, sizeof(abyChannel));
+    aqwLinks[0] = qwNext;
+    aqwLinks[2] = SD_decode_mf4_text(pstFile, "##TX", "t");
+    aqwLinks[6] = SD_decode_mf4_text(pstFile, "##TX", "s");
+    abyChannel[0] = MF4_CN_MASTER;
+    abyChannel[1] = MF4_CN_SYNC_TIME;
+    abyChannel[2] = MF4_CN_REAL_LE;
+    SD_decode_put(abyChannel, 8, 64, 4);
+    qwNext = SD_decode_mf4_block(pstFile, "##CN", MF4_CN_LINKS, aqwLinks, abyChannel, sizeof(abyChannel));
+
+    memset(aqwLinks, 0, sizeof(aqwLinks));
+    aqwLinks[1] = qwNext;
+    aqwLinks[2] = SD_decode_mf4_text(pstFile, "##TX", pszName);
+    SD_decode_put(abyGroup, 8, qwNRecords, 8);
+    SD_decode_put(abyGroup, 24, 8 * (dwNSignals + 1), 4);
+    qwGroup = SD_decode_mf4_block(pstFile, "##CG", MF4_CG_LINKS, aqwLinks, abyGroup, sizeof(abyGroup));
+
+    memset(aqwLinks, 0, sizeof(aqwLinks));
+    aqwLinks[0] = qwNextGroup;
+    aqwLinks[1] = qwGroup;
+    aqwLinks[2] = qwData;
+    return SD_decode_mf4_block(pstFile, "##DG", MF4_DG_LINKS, aqwLinks, abyDataGroup, sizeof(abyDataGroup));
+}
+
+static void SD_decode_mf4_header(FILE *pstFile, qword qwFirstGroup, qword qwHistory)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_mf4_header
+    *   Takes:   pstFile - the MF4, just after the identification block
+    *            qwFirstGroup - first data group, 0 while writing
+    *            qwHistory - file history block, 0 while writing
+    *
+    *   Returns: Nothing.
+    *
+    *   Writes the header block, the same length filled in or not so it can
+    *   go first and be written over at the end.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    qword aqwLinks[MF4_HD_LINKS] = {0};
+    byte abyHeader[MF4_HD_DATA] = {0};
+
+    aqwLinks[0] = qwFirstGroup;
+    aqwLinks[1] = qwHistory;
+    (void)SD_decode_mf4_block(pstFile, "##HD", MF4_HD_LINKS, aqwLinks, abyHeader, sizeof(abyHeader));
+}
+
+static void SD_decode_put(byte *abyData, dword dwAt, qword qwValue, dword dwSize)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_put
+    *   Takes:   abyData - an MF4 block's bytes
+    *            dwAt - where
+    *            qwValue - value
+    *            dwSize - its bytes, little endian
+    *
+    *   Returns: Nothing.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    dword dwByte;
+
+    for (dwByte = 0; dwByte < dwSize; dwByte++)
+    {
+        abyData[dwAt + dwByte] = (byte)(qwValue >> (8 * dwByte));
+    }
+}
+
+static const char *SD_decode_message_name(word wSignal)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_message_name
+    *   Takes:   wSignal - row of astCANSignals
+    *
+    *   Returns: The name of the message it is in.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    dword dwMessage;
+
+    for (dwMessage = 0; dwMessage < wNCANMessages; dwMessage++)
+    {
+        if (wSignal >= astCANMessages[dwMessage].wFirstSignal &&
+            wSignal < astCANMessages[dwMessage].wFirstSignal + astCANMessages[dwMessage].wNSignals)
+        {
+            return astCANMessages[dwMessage].pszName;
+        }
+    }
+    return "";
+}
+
+static boolean SD_decode_select(stDecoder_t *pstDecoder, const char *pszName)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_select
+    *   Takes:   pstDecoder - the decoder
+    *            pszName - "Signal", "Message.Signal" or an array's name
+    *
+    *   Returns: FALSE if no signal has that name.
+    *
+    *   Marks the signals to be written out.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    char szFull[SD_DECODE_MAX_PATH];
+    const char *pszSignal;
+    const char *pszIndex;
+    boolean BFound = FALSE;
+    dword dwSignal;
+
+    for (dwSignal = 0; dwSignal < wNCANSignals; dwSignal++)
+    {
+        pszSignal = astCANSignals[dwSignal].pszName;
+        pszIndex = strchr(pszSignal, '[');
+        snprintf(szFull, sizeof(szFull), "%s.%s", SD_decode_message_name((word)dwSignal), pszSignal);
+        if (strcmp(pszName, pszSignal) == 0 || strcmp(pszName, szFull) == 0 ||
+            (pszIndex != NULL && strlen(pszName) == (size_t)(pszIndex - pszSignal) &&
+             strncmp(pszName, pszSignal, (size_t)(pszIndex - pszSignal)) == 0))
+        {
+            pstDecoder->aBWanted[dwSignal] = TRUE;
+            BFound = TRUE;
+        }
+    }
+    return BFound;
+}
+
+static double SD_decode_seconds(void)
+{
+    /*
+    *===========================================================================
+    *   SD_decode_seconds
+    *   Takes:   None
+    *
+    *   Returns: A monotonic time in s.
+    *
+    *===========================================================================
+    *   Revision History:
+    *   18/10/26 CP Initial Version
+    *
+    *===========================================================================
+    */
+    struct timespec stNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &stNow);
+    return (double)stNow.tv_sec + (double)stNow.tv_nsec / 1e9;
+}